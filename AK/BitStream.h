@@ -214,6 +214,10 @@ public:
         return m_bit_buffer & lsb_mask<T>(min(count, m_bit_count));
     }
 
+    /// The number of bits that can be peeked at without reading from the underlying stream.
+    /// After a peek, this is smaller than the number of peeked bits only if the stream has ended.
+    ALWAYS_INLINE size_t buffered_bit_count() const { return m_bit_count; }
+
     ALWAYS_INLINE void discard_previously_peeked_bits(u8 count)
     {
         // We allow "retrieving" more bits than we can provide, but we need to make sure that we don't underflow the current bit counter.
@@ -255,6 +255,32 @@ ErrorOr<size_t> CircularBuffer::copy_from_seekback(size_t distance, size_t lengt
     if (distance > m_seekback_limit)
         return Error::from_string_literal("Tried a seekback copy beyond the seekback limit");
 
+    // Back-references are usually short and close by. If neither the source nor the destination wrap
+    // around, copy them in place, a word at a time where the copy doesn't overlap itself.
+    auto write_offset = (m_reading_head + m_used_space) % capacity();
+    if (distance > 0 && distance <= write_offset && length <= empty_space() && write_offset + length <= capacity()) {
+        u8* destination = m_buffer.data() + write_offset;
+        u8 const* source = destination - distance;
+
+        size_t offset = 0;
+        if (distance >= sizeof(u64)) {
+            for (; offset + sizeof(u64) <= length; offset += sizeof(u64)) {
+                u64 word;
+                __builtin_memcpy(&word, source + offset, sizeof(word));
+                __builtin_memcpy(destination + offset, &word, sizeof(word));
+            }
+        } else if (distance == 1) {
+            __builtin_memset(destination, *source, length);
+            offset = length;
+        }
+        for (; offset < length; ++offset)
+            destination[offset] = source[offset];
+
+        m_used_space += length;
+        m_seekback_limit = min(m_seekback_limit + length, capacity());
+        return length;
+    }
+
     auto remaining_length = length;
     while (remaining_length > 0) {
         if (empty_space() == 0)
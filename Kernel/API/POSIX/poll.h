@@ -23,6 +23,18 @@ extern "C" {
 #define POLLWRBAND (1u << 12)
 #define POLLRDHUP (1u << 13)
 
+// Requests edge-triggered notification for a poll set watch.
+#define POLLET (1u << 31)
+
+// Flags for create_poll_set()
+#define POLL_SET_CLOEXEC (1u << 0)
+#define POLL_SET_NONBLOCK (1u << 1)
+
+// Operations for poll_set_ctl()
+#define POLL_SET_ADD 1
+#define POLL_SET_MODIFY 2
+#define POLL_SET_REMOVE 3
+
 struct pollfd {
     int fd;
     short events;
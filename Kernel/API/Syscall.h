@@ -64,6 +64,7 @@ enum class NeedsBigProcessLock {
     S(close, NeedsBigProcessLock::No)                      \
     S(connect, NeedsBigProcessLock::No)                    \
     S(create_inode_watcher, NeedsBigProcessLock::No)       \
+    S(create_poll_set, NeedsBigProcessLock::No)            \
     S(create_thread, NeedsBigProcessLock::Yes)             \
     S(dbgputstr, NeedsBigProcessLock::No)                  \
     S(detach_thread, NeedsBigProcessLock::Yes)             \
@@ -139,6 +140,8 @@ enum class NeedsBigProcessLock {
     S(pipe, NeedsBigProcessLock::No)                       \
     S(pledge, NeedsBigProcessLock::No)                     \
     S(poll, NeedsBigProcessLock::No)                       \
+    S(poll_set_ctl, NeedsBigProcessLock::No)               \
+    S(poll_set_wait, NeedsBigProcessLock::No)              \
     S(posix_fallocate, NeedsBigProcessLock::No)            \
     S(prctl, NeedsBigProcessLock::No)                      \
     S(profiling_disable, NeedsBigProcessLock::Yes)         \
@@ -159,6 +162,7 @@ enum class NeedsBigProcessLock {
     S(scheduler_get_parameters, NeedsBigProcessLock::No)   \
     S(scheduler_set_parameters, NeedsBigProcessLock::No)   \
     S(sendfd, NeedsBigProcessLock::No)                     \
+    S(sendfile, NeedsBigProcessLock::Yes)                  \
     S(sendmsg, NeedsBigProcessLock::Yes)                   \
     S(set_mmap_name, NeedsBigProcessLock::No)              \
     S(setegid, NeedsBigProcessLock::No)                    \
@@ -266,6 +270,13 @@ struct SC_poll_params {
     u32 const* sigmask;
 };
 
+struct SC_poll_set_wait_params {
+    int poll_set_fd;
+    struct pollfd* ready;
+    unsigned max_ready;
+    const struct timespec* timeout;
+};
+
 struct SC_clock_nanosleep_params {
     int clock_id;
     int flags;
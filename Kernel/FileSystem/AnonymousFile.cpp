@@ -25,6 +25,16 @@ ErrorOr<NonnullLockRefPtr<Memory::VMObject>> AnonymousFile::vmobject_for_mmap(Pr
     return m_vmobject;
 }
 
+ErrorOr<struct stat> AnonymousFile::stat() const
+{
+    // NOTE: Userspace uses the size to check that a buffer it received is as large as the sender claims.
+    struct stat st = {};
+    st.st_mode = S_IFREG | 0600;
+    st.st_size = m_vmobject->size();
+    st.st_blksize = PAGE_SIZE;
+    return st;
+}
+
 ErrorOr<NonnullOwnPtr<KString>> AnonymousFile::pseudo_path(OpenFileDescription const&) const
 {
     return KString::try_create(":anonymous-file:"sv);
@@ -5,8 +5,10 @@
  */
 
 #include <AK/IntrusiveList.h>
+#include <AK/QuickSort.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Tasks/Process.h>
 
 namespace Kernel {
@@ -16,103 +18,349 @@ struct CacheEntry {
     BlockBasedFileSystem::BlockIndex block_index { 0 };
     u8* data { nullptr };
     bool has_data { false };
+    bool is_dirty { false };
+    // Whether this entry currently holds a block and is reachable through its shard's hash map.
+    bool is_mapped { false };
 };
 
-class DiskCache {
+// Cache entries are allocated in segments, so a shard can grow while there is memory to
+// spare and hand whole segments back to the system once memory gets tight.
+class DiskCacheSegment {
 public:
-    static constexpr size_t EntryCount = 10000;
-    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
-        : m_fs(fs)
-        , m_cached_block_data(move(cached_block_data))
+    static constexpr size_t EntryCount = 256;
+
+    static ErrorOr<NonnullOwnPtr<DiskCacheSegment>> try_create(size_t block_size)
+    {
+        auto cached_block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, EntryCount * block_size));
+        auto entries_buffer = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, EntryCount * sizeof(CacheEntry)));
+        return adopt_nonnull_own_or_enomem(new (nothrow) DiskCacheSegment(block_size, move(cached_block_data), move(entries_buffer)));
+    }
+
+    CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
+
+private:
+    DiskCacheSegment(size_t block_size, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
+        : m_cached_block_data(move(cached_block_data))
         , m_entries(move(entries_buffer))
     {
-        for (size_t i = 0; i < EntryCount; ++i) {
-            entries()[i].data = m_cached_block_data->data() + i * m_fs->logical_block_size();
-            m_clean_list.append(entries()[i]);
-        }
+        for (size_t i = 0; i < EntryCount; ++i)
+            entries()[i].data = m_cached_block_data->data() + i * block_size;
+    }
+
+    NonnullOwnPtr<KBuffer> m_cached_block_data;
+    NonnullOwnPtr<KBuffer> m_entries;
+};
+
+static bool memory_is_under_pressure()
+{
+    auto info = MM.get_system_memory_info();
+    return info.physical_pages_uncommitted < info.physical_pages / 8;
+}
+
+// A shard owns the cache entries for a subset of the block index space. Each shard has its
+// own lock, so accesses to unrelated parts of the disk don't serialize on a single mutex.
+class DiskCacheShard {
+public:
+    static constexpr size_t MaximumWriteBackRunBlocks = 16;
+
+    DiskCacheShard(BlockBasedFileSystem& fs, size_t maximum_segment_count)
+        : m_fs(fs)
+        , m_maximum_segment_count(maximum_segment_count)
+    {
     }
 
-    ~DiskCache() = default;
+    ~DiskCacheShard() = default;
+
+    Mutex& lock() { return m_lock; }
+
+    u64 generation() const { return m_generation.load(AK::MemoryOrder::memory_order_acquire); }
+    void bump_generation() { m_generation.fetch_add(1, AK::MemoryOrder::memory_order_release); }
 
-    bool is_dirty() const { return !m_dirty_list.is_empty(); }
-    bool entry_is_dirty(CacheEntry const& entry) const { return m_dirty_list.contains(entry); }
+    size_t entry_count() const { return m_segments.size() * DiskCacheSegment::EntryCount; }
+    size_t dirty_count() const { return m_dirty_count; }
+    bool is_dirty() const { return m_dirty_count != 0; }
 
-    void mark_all_clean()
+    ErrorOr<void> add_segment()
     {
-        while (auto* entry = m_dirty_list.first())
-            m_clean_list.prepend(*entry);
+        VERIFY(m_lock.is_exclusively_locked_by_current_thread());
+        auto segment = TRY(DiskCacheSegment::try_create(m_fs->logical_block_size()));
+        TRY(m_segments.try_append(move(segment)));
+        // Fresh entries go to the back of the clean list, so they are used before anything gets evicted.
+        auto* entries = m_segments.last()->entries();
+        for (size_t i = 0; i < DiskCacheSegment::EntryCount; ++i)
+            m_clean_list.append(entries[i]);
+        return {};
+    }
+
+    // Gives the most recently added segment back to the system, as long as none of its entries are dirty.
+    bool try_release_segment()
+    {
+        VERIFY(m_lock.is_exclusively_locked_by_current_thread());
+        if (m_segments.size() <= 1)
+            return false;
+
+        auto* entries = m_segments.last()->entries();
+        for (size_t i = 0; i < DiskCacheSegment::EntryCount; ++i) {
+            if (entries[i].is_dirty)
+                return false;
+        }
+        for (size_t i = 0; i < DiskCacheSegment::EntryCount; ++i) {
+            auto& entry = entries[i];
+            if (entry.is_mapped)
+                m_hash.remove(entry.block_index);
+            m_clean_list.remove(entry);
+        }
+        (void)m_segments.take_last();
+        return true;
     }
 
     void mark_dirty(CacheEntry& entry)
     {
+        if (!entry.is_dirty)
+            ++m_dirty_count;
+        entry.is_dirty = true;
         m_dirty_list.prepend(entry);
+        bump_generation();
     }
 
     void mark_clean(CacheEntry& entry)
     {
+        if (entry.is_dirty)
+            --m_dirty_count;
+        entry.is_dirty = false;
         m_clean_list.prepend(entry);
     }
 
-    CacheEntry* get(BlockBasedFileSystem::BlockIndex block_index) const
+    CacheEntry* get(BlockBasedFileSystem::BlockIndex block_index)
     {
         auto it = m_hash.find(block_index);
         if (it == m_hash.end())
             return nullptr;
-        auto& entry = const_cast<CacheEntry&>(*it->value);
+        auto& entry = *it->value;
         VERIFY(entry.block_index == block_index);
-        if (!entry_is_dirty(entry) && (m_clean_list.first() != &entry)) {
+        if (!entry.is_dirty && (m_clean_list.first() != &entry)) {
             // Cache hit! Promote the entry to the front of the list.
             m_clean_list.prepend(entry);
         }
         return &entry;
     }
 
-    ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index) const
+    ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index)
     {
+        VERIFY(m_lock.is_exclusively_locked_by_current_thread());
         if (auto* entry = get(block_index))
             return entry;
 
-        if (m_clean_list.is_empty()) {
-            // Not a single clean entry! Flush writes and try again.
-            // NOTE: We want to make sure we only call FileBackedFileSystem flush here,
-            //       not some FileBackedFileSystem subclass flush!
-            m_fs->flush_writes_impl();
+        // Rather than evicting a cached block, grow the shard while memory allows.
+        auto* new_entry = m_clean_list.last();
+        if ((!new_entry || new_entry->is_mapped) && m_segments.size() < m_maximum_segment_count && !memory_is_under_pressure()) {
+            if (!add_segment().is_error())
+                new_entry = m_clean_list.last();
+        }
+
+        if (!new_entry) {
+            // Not a single clean entry! Write back this shard and try again.
+            write_back_dirty_entries();
             return ensure(block_index);
         }
 
-        VERIFY(m_clean_list.last());
-        auto& new_entry = *m_clean_list.last();
-        m_clean_list.prepend(new_entry);
+        m_clean_list.prepend(*new_entry);
 
-        m_hash.remove(new_entry.block_index);
-        TRY(m_hash.try_set(block_index, &new_entry));
+        if (new_entry->is_mapped) {
+            m_hash.remove(new_entry->block_index);
+            new_entry->is_mapped = false;
+        }
+        TRY(m_hash.try_set(block_index, new_entry));
 
-        new_entry.block_index = block_index;
-        new_entry.has_data = false;
+        new_entry->block_index = block_index;
+        new_entry->has_data = false;
+        new_entry->is_mapped = true;
 
-        return &new_entry;
+        return new_entry;
     }
 
-    CacheEntry const* entries() const { return (CacheEntry const*)m_entries->data(); }
-    CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
+    // Writes all dirty entries of this shard back to the device in block order,
+    // merging runs of adjacent blocks into a single write.
+    size_t write_back_dirty_entries()
+    {
+        VERIFY(m_lock.is_exclusively_locked_by_current_thread());
+        if (!is_dirty())
+            return 0;
+
+        Vector<CacheEntry*> dirty_entries;
+        if (dirty_entries.try_ensure_capacity(m_dirty_count).is_error()) {
+            // Without memory to sort, fall back to writing the entries one by one.
+            for (auto& entry : m_dirty_list) {
+                CacheEntry* entry_pointer = &entry;
+                write_entries({ &entry_pointer, 1 });
+            }
+        } else {
+            append_dirty_entries(dirty_entries);
+            quick_sort(dirty_entries, [](auto* a, auto* b) { return a->block_index < b->block_index; });
+            write_sorted_entries(dirty_entries);
+        }
+        return did_write_back_dirty_entries();
+    }
 
-    template<typename Callback>
-    void for_each_dirty_entry(Callback callback)
+    // The building blocks of write_back_dirty_entries(), for writing back several shards in one pass.
+    void append_dirty_entries(Vector<CacheEntry*>& entries)
     {
+        VERIFY(m_lock.is_exclusively_locked_by_current_thread());
         for (auto& entry : m_dirty_list)
-            callback(entry);
+            entries.unchecked_append(&entry);
+    }
+
+    void write_sorted_entries(Span<CacheEntry*> entries)
+    {
+        VERIFY(m_lock.is_exclusively_locked_by_current_thread());
+        size_t run_start = 0;
+        for (size_t i = 1; i <= entries.size(); ++i) {
+            if (i < entries.size()
+                && i - run_start < MaximumWriteBackRunBlocks
+                && entries[i]->block_index.value() == entries[i - 1]->block_index.value() + 1)
+                continue;
+            write_entries(entries.slice(run_start, i - run_start));
+            run_start = i;
+        }
+    }
+
+    size_t did_write_back_dirty_entries()
+    {
+        VERIFY(m_lock.is_exclusively_locked_by_current_thread());
+        size_t count = m_dirty_count;
+        while (auto* entry = m_dirty_list.first())
+            mark_clean(*entry);
+        // Anything read from the device before this point may predate the blocks we just wrote.
+        bump_generation();
+        return count;
     }
 
 private:
-    mutable NonnullRefPtr<BlockBasedFileSystem> m_fs;
-    NonnullOwnPtr<KBuffer> m_cached_block_data;
+    // Writes a run of entries for consecutive blocks with a single device write if possible.
+    void write_entries(Span<CacheEntry*> entries)
+    {
+        auto block_size = m_fs->logical_block_size();
+        auto base_offset = entries.first()->block_index.value() * block_size;
+        if (entries.size() > 1) {
+            if (!m_write_back_buffer) {
+                auto buffer_or_error = KBuffer::try_create_with_size("BlockBasedFS: Write-back buffer"sv, MaximumWriteBackRunBlocks * block_size);
+                if (!buffer_or_error.is_error())
+                    m_write_back_buffer = buffer_or_error.release_value();
+            }
+            if (m_write_back_buffer) {
+                for (size_t i = 0; i < entries.size(); ++i)
+                    memcpy(m_write_back_buffer->data() + i * block_size, entries[i]->data, block_size);
+                auto data_buffer = UserOrKernelBuffer::for_kernel_buffer(m_write_back_buffer->data());
+                [[maybe_unused]] auto rc = m_fs->file_description().write(base_offset, data_buffer, entries.size() * block_size);
+                return;
+            }
+        }
+        for (auto* entry : entries) {
+            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
+            [[maybe_unused]] auto rc = m_fs->file_description().write(entry->block_index.value() * block_size, entry_data_buffer, block_size);
+        }
+    }
 
-    // NOTE: m_entries must be declared before m_dirty_list and m_clean_list because their entries are allocated from it.
-    // We need to ensure that the destructors of m_dirty_list and m_clean_list are called before m_entries is destroyed.
-    NonnullOwnPtr<KBuffer> m_entries;
-    mutable IntrusiveList<&CacheEntry::list_node> m_dirty_list;
-    mutable IntrusiveList<&CacheEntry::list_node> m_clean_list;
-    mutable HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
+    NonnullRefPtr<BlockBasedFileSystem> m_fs;
+    mutable Mutex m_lock { "DiskCacheShard"sv };
+    Atomic<u64> m_generation { 0 };
+    size_t const m_maximum_segment_count;
+    size_t m_dirty_count { 0 };
+    OwnPtr<KBuffer> m_write_back_buffer;
+
+    // NOTE: m_segments must be declared before m_dirty_list and m_clean_list because their entries are allocated from it.
+    // We need to ensure that the destructors of m_dirty_list and m_clean_list are called before the segments are destroyed.
+    Vector<NonnullOwnPtr<DiskCacheSegment>> m_segments;
+    IntrusiveList<&CacheEntry::list_node> m_dirty_list;
+    IntrusiveList<&CacheEntry::list_node> m_clean_list;
+    HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
+};
+
+class DiskCache {
+public:
+    static constexpr size_t ShardCount = 8;
+    // Consecutive blocks share a shard, so readahead and write-back runs mostly stay within one shard.
+    static constexpr size_t BlocksPerShardStripe = 64;
+    // The cache may use at most 1/MemoryFraction of physical memory.
+    static constexpr size_t MemoryFraction = 16;
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> try_create(BlockBasedFileSystem& fs)
+    {
+        auto physical_memory = MM.get_system_memory_info().physical_pages * PAGE_SIZE;
+        auto segment_size = DiskCacheSegment::EntryCount * fs.logical_block_size();
+        auto maximum_segment_count = max<size_t>(1, physical_memory / MemoryFraction / ShardCount / segment_size);
+
+        auto cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache));
+        for (auto& shard : cache->m_shards) {
+            shard = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCacheShard(fs, maximum_segment_count)));
+            MutexLocker locker(shard->lock());
+            TRY(shard->add_segment());
+        }
+        return cache;
+    }
+
+    DiskCacheShard& shard_for(BlockBasedFileSystem::BlockIndex block_index)
+    {
+        return *m_shards[(block_index.value() / BlocksPerShardStripe) % ShardCount];
+    }
+
+    size_t shard_index_for(BlockBasedFileSystem::BlockIndex block_index) const
+    {
+        return (block_index.value() / BlocksPerShardStripe) % ShardCount;
+    }
+
+    // Writes the dirty blocks of all shards back in a single pass over the device in block order,
+    // rather than shard by shard. All shards stay locked until every block has been written, so
+    // nobody sees some shards written back and others not.
+    size_t write_back_all_dirty_entries(bool should_shrink)
+    {
+        // NOTE: This is the only place that holds more than one shard lock, so there is no
+        //       lock ordering to worry about beyond always taking them in the same order.
+        size_t dirty_count = 0;
+        for (auto& shard : m_shards) {
+            shard->lock().lock();
+            dirty_count += shard->dirty_count();
+        }
+
+        size_t count = 0;
+        Vector<CacheEntry*> dirty_entries;
+        if (dirty_entries.try_ensure_capacity(dirty_count).is_error()) {
+            // Without memory to sort everything, at least keep each shard in order.
+            for (auto& shard : m_shards)
+                count += shard->write_back_dirty_entries();
+        } else {
+            for (auto& shard : m_shards)
+                shard->append_dirty_entries(dirty_entries);
+            quick_sort(dirty_entries, [](auto* a, auto* b) { return a->block_index < b->block_index; });
+
+            // Consecutive blocks only end up in different shards at stripe boundaries, which
+            // is where a run has to be handed over to the next shard anyway.
+            size_t run_start = 0;
+            for (size_t i = 1; i <= dirty_entries.size(); ++i) {
+                auto run_shard_index = shard_index_for(dirty_entries[run_start]->block_index);
+                if (i < dirty_entries.size() && shard_index_for(dirty_entries[i]->block_index) == run_shard_index)
+                    continue;
+                m_shards[run_shard_index]->write_sorted_entries(dirty_entries.span().slice(run_start, i - run_start));
+                run_start = i;
+            }
+            for (auto& shard : m_shards) {
+                if (shard->is_dirty())
+                    count += shard->did_write_back_dirty_entries();
+            }
+        }
+
+        for (auto& shard : m_shards) {
+            if (should_shrink)
+                shard->try_release_segment();
+            shard->lock().unlock();
+        }
+        return count;
+    }
+
+private:
+    DiskCache() = default;
+
+    Array<OwnPtr<DiskCacheShard>, ShardCount> m_shards;
 };
 
 BlockBasedFileSystem::BlockBasedFileSystem(OpenFileDescription& file_description)
@@ -136,9 +384,7 @@ ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
     VERIFY(m_lock.is_locked());
     VERIFY(!is_initialized_while_locked());
     VERIFY(logical_block_size() != 0);
-    auto cached_block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, DiskCache::EntryCount * logical_block_size()));
-    auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, DiskCache::EntryCount * sizeof(CacheEntry)));
-    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data))));
+    auto disk_cache = TRY(DiskCache::try_create(*this));
 
     m_cache.with_exclusive([&](auto& cache) {
         cache = move(disk_cache);
@@ -146,6 +392,18 @@ ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
     return {};
 }
 
+ErrorOr<void> BlockBasedFileSystem::fill_cache_entry(CacheEntry& entry) const
+{
+    if (entry.has_data)
+        return {};
+    auto base_offset = entry.block_index.value() * logical_block_size();
+    auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
+    auto nread = TRY(file_description().read(entry_data_buffer, base_offset, logical_block_size()));
+    VERIFY(nread == logical_block_size());
+    entry.has_data = true;
+    return {};
+}
+
 ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBuffer const& data, size_t count, u64 offset, bool allow_cache)
 {
     VERIFY(m_device_block_size);
@@ -159,24 +417,32 @@ ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBu
 
     TRY(data.read(buffered_data.bytes()));
 
-    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+    return m_cache.with_shared([&](auto& cache) -> ErrorOr<void> {
+        auto& shard = cache->shard_for(index);
+        MutexLocker locker(shard.lock());
+
         if (!allow_cache) {
-            flush_specific_block_if_needed(index);
+            flush_specific_block_if_needed(shard, index);
             u64 base_offset = index.value() * logical_block_size() + offset;
             auto nwritten = TRY(file_description().write(base_offset, data, count));
             VERIFY(nwritten == count);
+            shard.bump_generation();
             return {};
         }
 
-        auto entry = TRY(cache->ensure(index));
+        auto entry = TRY(shard.ensure(index));
         if (count < logical_block_size()) {
             // Fill the cache first.
-            TRY(read_block(index, nullptr, logical_block_size()));
+            TRY(fill_cache_entry(*entry));
         }
         memcpy(entry->data + offset, buffered_data.data(), count);
 
-        cache->mark_dirty(*entry);
+        shard.mark_dirty(*entry);
         entry->has_data = true;
+
+        // Don't let a shard fill up with dirty blocks, or reads would have to wait for write-back.
+        if (shard.dirty_count() > shard.entry_count() / 2)
+            shard.write_back_dirty_entries();
         return {};
     });
 }
@@ -199,21 +465,17 @@ ErrorOr<void> BlockBasedFileSystem::raw_write(BlockIndex index, UserOrKernelBuff
 
 ErrorOr<void> BlockBasedFileSystem::raw_read_blocks(BlockIndex index, size_t count, UserOrKernelBuffer& buffer)
 {
-    auto current = buffer;
-    for (auto block = index.value(); block < (index.value() + count); block++) {
-        TRY(raw_read(BlockIndex { block }, current));
-        current = current.offset(device_block_size());
-    }
+    auto base_offset = index.value() * m_device_block_size;
+    auto nread = TRY(file_description().read(buffer, base_offset, count * m_device_block_size));
+    VERIFY(nread == count * m_device_block_size);
     return {};
 }
 
 ErrorOr<void> BlockBasedFileSystem::raw_write_blocks(BlockIndex index, size_t count, UserOrKernelBuffer const& buffer)
 {
-    auto current = buffer;
-    for (auto block = index.value(); block < (index.value() + count); block++) {
-        TRY(raw_write(block, current));
-        current = current.offset(device_block_size());
-    }
+    auto base_offset = index.value() * m_device_block_size;
+    auto nwritten = TRY(file_description().write(base_offset, buffer, count * m_device_block_size));
+    VERIFY(nwritten == count * m_device_block_size);
     return {};
 }
 
@@ -227,29 +489,91 @@ ErrorOr<void> BlockBasedFileSystem::write_blocks(BlockIndex index, unsigned coun
     return {};
 }
 
+size_t BlockBasedFileSystem::readahead_block_count_for(BlockIndex index) const
+{
+    auto expected_index = m_next_sequential_block_index.exchange(index.value() + 1, AK::MemoryOrder::memory_order_relaxed);
+    if (index.value() + 1 == expected_index) {
+        // Another access to the same block, e.g. a small read() within it.
+        return m_readahead_block_count.load(AK::MemoryOrder::memory_order_relaxed);
+    }
+    if (index.value() != expected_index) {
+        m_readahead_block_count.store(1, AK::MemoryOrder::memory_order_relaxed);
+        return 1;
+    }
+
+    // Sequential access, keep growing the readahead window.
+    auto count = clamp(m_readahead_block_count.load(AK::MemoryOrder::memory_order_relaxed) * 2, initial_readahead_block_count, maximum_readahead_block_count);
+    m_readahead_block_count.store(count, AK::MemoryOrder::memory_order_relaxed);
+    return count;
+}
+
+ErrorOr<void> BlockBasedFileSystem::read_ahead(DiskCache& cache, BlockIndex index, size_t count) const
+{
+    dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::read_ahead {}, count={}", index, count);
+
+    // Remember the shard generations, so that we don't cache stale data for blocks
+    // that are written to (or written back) while we're reading from the device.
+    Array<u64, DiskCache::ShardCount> generations;
+    for (size_t i = 0; i < count; ++i) {
+        BlockIndex block_index { index.value() + i };
+        generations[cache.shard_index_for(block_index)] = cache.shard_for(block_index).generation();
+    }
+
+    auto block_size = logical_block_size();
+    auto data = TRY(ByteBuffer::create_uninitialized(count * block_size));
+    auto data_buffer = UserOrKernelBuffer::for_kernel_buffer(data.data());
+    auto nread = TRY(file_description().read(data_buffer, index.value() * block_size, count * block_size));
+
+    // NOTE: The read may come up short near the end of the device.
+    for (size_t i = 0; i < nread / block_size; ++i) {
+        BlockIndex block_index { index.value() + i };
+        auto& shard = cache.shard_for(block_index);
+        MutexLocker locker(shard.lock());
+        if (shard.generation() != generations[cache.shard_index_for(block_index)])
+            continue;
+        auto* entry = TRY(shard.ensure(block_index));
+        if (entry->has_data)
+            continue;
+        memcpy(entry->data, data.data() + i * block_size, block_size);
+        entry->has_data = true;
+    }
+    return {};
+}
+
 ErrorOr<void> BlockBasedFileSystem::read_block(BlockIndex index, UserOrKernelBuffer* buffer, size_t count, u64 offset, bool allow_cache) const
 {
     VERIFY(m_device_block_size);
     VERIFY(offset + count <= logical_block_size());
     dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::read_block {}", index);
 
-    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+    return m_cache.with_shared([&](auto& cache) -> ErrorOr<void> {
+        auto& shard = cache->shard_for(index);
+
         if (!allow_cache) {
-            const_cast<BlockBasedFileSystem*>(this)->flush_specific_block_if_needed(index);
+            MutexLocker locker(shard.lock());
+            const_cast<BlockBasedFileSystem*>(this)->flush_specific_block_if_needed(shard, index);
             u64 base_offset = index.value() * logical_block_size() + offset;
             auto nread = TRY(file_description().read(*buffer, base_offset, count));
             VERIFY(nread == count);
             return {};
         }
 
-        auto* entry = TRY(cache->ensure(index));
-        if (!entry->has_data) {
-            auto base_offset = index.value() * logical_block_size();
-            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
-            auto nread = TRY(file_description().read(entry_data_buffer, base_offset, logical_block_size()));
-            VERIFY(nread == logical_block_size());
-            entry->has_data = true;
+        auto readahead_block_count = readahead_block_count_for(index);
+        if (readahead_block_count > 1) {
+            bool is_cached = false;
+            {
+                MutexLocker locker(shard.lock());
+                auto* entry = shard.get(index);
+                is_cached = entry && entry->has_data;
+            }
+            // Readahead is only an optimization, the block is read below either way.
+            if (!is_cached)
+                (void)read_ahead(*cache, index, readahead_block_count);
         }
+
+        MutexLocker locker(shard.lock());
+        auto* entry = TRY(shard.ensure(index));
+        TRY(fill_cache_entry(*entry));
         if (buffer)
             TRY(buffer->write(entry->data + offset, count));
         return {};
@@ -272,37 +596,30 @@ ErrorOr<void> BlockBasedFileSystem::read_blocks(BlockIndex index, unsigned count
     return {};
 }
 
-void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
+void BlockBasedFileSystem::flush_specific_block_if_needed(DiskCacheShard& shard, BlockIndex index)
 {
-    m_cache.with_exclusive([&](auto& cache) {
-        if (!cache->is_dirty())
-            return;
-        auto* entry = cache->get(index);
-        if (!entry)
-            return;
-        if (!cache->entry_is_dirty(*entry))
-            return;
-        size_t base_offset = entry->block_index.value() * logical_block_size();
-        auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
-        (void)file_description().write(base_offset, entry_data_buffer, logical_block_size());
-    });
+    VERIFY(shard.lock().is_exclusively_locked_by_current_thread());
+    if (!shard.is_dirty())
+        return;
+    auto* entry = shard.get(index);
+    if (!entry)
+        return;
+    if (!entry->is_dirty)
+        return;
+    size_t base_offset = entry->block_index.value() * logical_block_size();
+    auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
+    (void)file_description().write(base_offset, entry_data_buffer, logical_block_size());
 }
 
 void BlockBasedFileSystem::flush_writes_impl()
 {
     size_t count = 0;
-    m_cache.with_exclusive([&](auto& cache) {
-        if (!cache->is_dirty())
-            return;
-        cache->for_each_dirty_entry([&](CacheEntry& entry) {
-            auto base_offset = entry.block_index.value() * logical_block_size();
-            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
-            [[maybe_unused]] auto rc = file_description().write(base_offset, entry_data_buffer, logical_block_size());
-            ++count;
-        });
-        cache->mark_all_clean();
-        dbgln("{}: Flushed {} blocks to disk", class_name(), count);
+    bool should_shrink = memory_is_under_pressure();
+    m_cache.with_shared([&](auto& cache) {
+        count = cache->write_back_all_dirty_entries(should_shrink);
     });
+    if (count)
+        dbgln("{}: Flushed {} blocks to disk", class_name(), count);
 }
 
 ErrorOr<void> BlockBasedFileSystem::flush_writes()
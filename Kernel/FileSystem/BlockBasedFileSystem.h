@@ -6,11 +6,15 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <Kernel/FileSystem/FileBackedFileSystem.h>
 #include <Kernel/Locking/MutexProtected.h>
 
 namespace Kernel {
 
+class DiskCacheShard;
+struct CacheEntry;
+
 class BlockBasedFileSystem : public FileBackedFileSystem {
 public:
     AK_TYPEDEF_DISTINCT_ORDERED_ID(u64, BlockIndex);
@@ -44,9 +48,20 @@ protected:
     void remove_disk_cache_before_last_unmount();
 
 private:
-    void flush_specific_block_if_needed(BlockIndex index);
+    static constexpr size_t initial_readahead_block_count = 4;
+    static constexpr size_t maximum_readahead_block_count = 32;
+
+    void flush_specific_block_if_needed(DiskCacheShard&, BlockIndex index);
+    ErrorOr<void> fill_cache_entry(CacheEntry&) const;
+
+    size_t readahead_block_count_for(BlockIndex) const;
+    ErrorOr<void> read_ahead(DiskCache&, BlockIndex, size_t count) const;
 
     mutable MutexProtected<OwnPtr<DiskCache>> m_cache;
+
+    // Used to detect sequential reads, which are then served by reading ahead in larger batches.
+    mutable Atomic<u64> m_next_sequential_block_index { 0 };
+    mutable Atomic<size_t> m_readahead_block_count { 0 };
 };
 
 }
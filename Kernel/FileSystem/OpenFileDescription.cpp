@@ -16,6 +16,7 @@
 #include <Kernel/FileSystem/InodeWatcher.h>
 #include <Kernel/FileSystem/MountFile.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/FileSystem/PollSet.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Net/Socket.h>
@@ -61,6 +62,9 @@ OpenFileDescription::~OpenFileDescription()
 
     if (m_inode)
         m_inode->remove_flocks_for_description(*this);
+
+    // Let poll sets that were watching this description know that it went away.
+    evaluate_block_conditions();
 }
 
 ErrorOr<void> OpenFileDescription::attach()
@@ -314,6 +318,25 @@ InodeWatcher* OpenFileDescription::inode_watcher()
     return static_cast<InodeWatcher*>(m_file.ptr());
 }
 
+bool OpenFileDescription::is_poll_set() const
+{
+    return m_file->is_poll_set();
+}
+
+PollSet const* OpenFileDescription::poll_set() const
+{
+    if (!is_poll_set())
+        return nullptr;
+    return static_cast<PollSet const*>(m_file.ptr());
+}
+
+PollSet* OpenFileDescription::poll_set()
+{
+    if (!is_poll_set())
+        return nullptr;
+    return static_cast<PollSet*>(m_file.ptr());
+}
+
 bool OpenFileDescription::is_mount_file() const
 {
     return m_file->is_mount_file();
@@ -15,6 +15,7 @@
 #include <Kernel/FileSystem/InodeMetadata.h>
 #include <Kernel/Forward.h>
 #include <Kernel/Library/KBuffer.h>
+#include <Kernel/Library/LockWeakable.h>
 #include <Kernel/Memory/VirtualAddress.h>
 
 namespace Kernel {
@@ -24,7 +25,9 @@ public:
     virtual ~OpenFileDescriptionData() = default;
 };
 
-class OpenFileDescription final : public AtomicRefCounted<OpenFileDescription> {
+class OpenFileDescription final
+    : public AtomicRefCounted<OpenFileDescription>
+    , public LockWeakable<OpenFileDescription> {
 public:
     static ErrorOr<NonnullRefPtr<OpenFileDescription>> try_create(Custody&);
     static ErrorOr<NonnullRefPtr<OpenFileDescription>> try_create(File&);
@@ -80,6 +83,10 @@ public:
     InodeWatcher const* inode_watcher() const;
     InodeWatcher* inode_watcher();
 
+    bool is_poll_set() const;
+    PollSet const* poll_set() const;
+    PollSet* poll_set();
+
     bool is_mount_file() const;
     MountFile const* mount_file() const;
     MountFile* mount_file();
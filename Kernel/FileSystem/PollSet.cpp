@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/FileSystem/PollSet.h>
+
+namespace Kernel {
+
+ErrorOr<NonnullRefPtr<PollSet>> PollSet::try_create()
+{
+    return adopt_nonnull_ref_or_enomem(new (nothrow) PollSet);
+}
+
+PollSet::~PollSet()
+{
+    (void)close();
+}
+
+bool PollSet::can_read(OpenFileDescription const&, u64) const
+{
+    return m_ready_watches.with([](auto& ready_watches) { return !ready_watches.is_empty(); });
+}
+
+ErrorOr<void> PollSet::close()
+{
+    m_watches.with_exclusive([&](auto& watches) {
+        for (auto& it : watches)
+            detach_watch(*it.value);
+        watches.clear();
+    });
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<KString>> PollSet::pseudo_path(OpenFileDescription const&) const
+{
+    return KString::try_create(":poll-set:"sv);
+}
+
+ErrorOr<void> PollSet::add_watch(int fd, OpenFileDescription& description, BlockFlags flags, bool edge_triggered)
+{
+    // Nesting poll sets would allow cycles between their blocker sets.
+    if (description.is_poll_set())
+        return EINVAL;
+
+    return m_watches.with_exclusive([&](auto& watches) -> ErrorOr<void> {
+        if (auto it = watches.find(fd); it != watches.end()) {
+            // The descriptor may have been closed and reused since it was added. The old
+            // watch is stale then, so replace it rather than failing.
+            if (it->value->is_watching(description))
+                return EEXIST;
+            return replace_watch(it->value, fd, description, flags, edge_triggered);
+        }
+
+        auto watch = TRY(Watch::try_create(*this, fd, description, flags, edge_triggered));
+        auto& watch_ref = *watch;
+        TRY(watches.try_set(fd, move(watch)));
+
+        // Registering evaluates the watch immediately, so the next collect_ready_entries()
+        // reports the description if it is already ready.
+        auto registered = watch_ref.register_with_description();
+        VERIFY(registered);
+        return {};
+    });
+}
+
+ErrorOr<void> PollSet::modify_watch(int fd, OpenFileDescription& description, BlockFlags flags, bool edge_triggered)
+{
+    return m_watches.with_exclusive([&](auto& watches) -> ErrorOr<void> {
+        auto it = watches.find(fd);
+        if (it == watches.end())
+            return ENOENT;
+
+        // The descriptor may have been closed and reused since it was added,
+        // in which case the watch has to move over to the new description.
+        if (!it->value->is_watching(description))
+            return replace_watch(it->value, fd, description, flags, edge_triggered);
+
+        auto& watch = *it->value;
+        watch.set_block_flags(flags, edge_triggered);
+
+        // Re-evaluate right away, the new interest set might already be satisfied.
+        if (description.should_unblock(flags) != BlockFlags::None)
+            mark_ready(watch);
+        return {};
+    });
+}
+
+ErrorOr<void> PollSet::remove_watch(int fd)
+{
+    // Detach while holding the watch map lock, so that a concurrent collect_ready_entries()
+    // can't be looking at the watch while it goes away.
+    return m_watches.with_exclusive([&](auto& watches) -> ErrorOr<void> {
+        auto it = watches.find(fd);
+        if (it == watches.end())
+            return ENOENT;
+        detach_watch(*it->value);
+        watches.remove(it);
+        return {};
+    });
+}
+
+ErrorOr<void> PollSet::replace_watch(NonnullOwnPtr<Watch>& slot, int fd, OpenFileDescription& description, BlockFlags flags, bool edge_triggered)
+{
+    auto new_watch = TRY(Watch::try_create(*this, fd, description, flags, edge_triggered));
+    auto& new_watch_ref = *new_watch;
+    detach_watch(*slot);
+    slot = move(new_watch);
+    auto registered = new_watch_ref.register_with_description();
+    VERIFY(registered);
+    return {};
+}
+
+void PollSet::detach_watch(Watch& watch)
+{
+    // Stop notifications from being queued first. We can't unregister while holding our
+    // own lock, since the description's blocker set calls mark_ready() with its lock held.
+    m_ready_watches.with([&](auto&) { watch.m_is_removed = true; });
+    watch.unregister_from_description();
+
+    // No more notifications can arrive now, so it's safe to unlink the watch.
+    m_ready_watches.with([&](auto& ready_watches) {
+        if (watch.m_ready_list_node.is_in_list())
+            ready_watches.remove(watch);
+    });
+}
+
+void PollSet::mark_ready(Watch& watch)
+{
+    bool did_become_readable = m_ready_watches.with([&](auto& ready_watches) {
+        if (watch.m_is_removed)
+            return false;
+        watch.m_was_notified = true;
+        if (watch.m_ready_list_node.is_in_list())
+            return false;
+        bool was_empty = ready_watches.is_empty();
+        ready_watches.append(watch);
+        return was_empty;
+    });
+
+    if (did_become_readable)
+        evaluate_block_conditions();
+}
+
+ErrorOr<void> PollSet::collect_ready_entries(Vector<ReadyEntry>& entries, size_t max_entries)
+{
+    // Holding the watch map lock keeps every watch in the ready list alive while we
+    // evaluate them outside of the ready list spinlock.
+    return m_watches.with_exclusive([&](auto& watches) -> ErrorOr<void> {
+        Vector<Watch*, 32> candidates;
+        TRY(m_ready_watches.with([&](auto& ready_watches) -> ErrorOr<void> {
+            for (auto& watch : ready_watches) {
+                if (candidates.size() == max_entries)
+                    break;
+                TRY(candidates.try_append(&watch));
+                watch.m_was_notified = false;
+            }
+            return {};
+        }));
+
+        TRY(entries.try_ensure_capacity(candidates.size()));
+        Vector<BlockFlags, 32> unblocked_flags;
+        TRY(unblocked_flags.try_ensure_capacity(candidates.size()));
+        Vector<Watch*, 32> dead_watches;
+        for (auto* watch : candidates) {
+            auto description = watch->description();
+            if (!description) {
+                // The description was closed, so the watch is gone for good.
+                TRY(dead_watches.try_append(watch));
+                unblocked_flags.unchecked_append(BlockFlags::None);
+                continue;
+            }
+            auto flags = watch->block_flags();
+            auto unblocked = description->should_unblock(flags);
+            unblocked_flags.unchecked_append(unblocked);
+            if (unblocked != BlockFlags::None)
+                entries.unchecked_append({ watch->fd(), flags, unblocked });
+        }
+
+        m_ready_watches.with([&](auto& ready_watches) {
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                auto& watch = *candidates[i];
+                // A notification that arrived while we weren't holding the lock must not be lost.
+                if (watch.m_was_notified)
+                    continue;
+                ready_watches.remove(watch);
+                // Level-triggered watches that are still ready go to the back of the list,
+                // so that a busy descriptor can't starve the others when max_entries is small.
+                if (unblocked_flags[i] != BlockFlags::None && !watch.is_edge_triggered())
+                    ready_watches.append(watch);
+            }
+        });
+
+        for (auto* watch : dead_watches) {
+            detach_watch(*watch);
+            watches.remove(watch->fd());
+        }
+        return {};
+    });
+}
+
+ErrorOr<NonnullOwnPtr<PollSet::Watch>> PollSet::Watch::try_create(PollSet& poll_set, int fd, OpenFileDescription& description, BlockFlags flags, bool edge_triggered)
+{
+    auto weak_description = TRY(description.try_make_weak_ptr<OpenFileDescription>());
+    return adopt_nonnull_own_or_enomem(new (nothrow) Watch(poll_set, fd, description.file(), move(weak_description), flags, edge_triggered));
+}
+
+PollSet::Watch::Watch(PollSet& poll_set, int fd, File& file, LockWeakPtr<OpenFileDescription> description, BlockFlags flags, bool edge_triggered)
+    : FileBlocker(NotifyOnlyTag {})
+    , m_poll_set(poll_set)
+    , m_fd(fd)
+    , m_file(file)
+    , m_description(move(description))
+    , m_block_flags(flags)
+    , m_edge_triggered(edge_triggered)
+{
+}
+
+PollSet::Watch::~Watch()
+{
+    VERIFY(!m_ready_list_node.is_in_list());
+}
+
+bool PollSet::Watch::register_with_description()
+{
+    return add_to_blocker_set(m_file->blocker_set());
+}
+
+void PollSet::Watch::unregister_from_description()
+{
+    Thread::FileBlocker::finalize();
+}
+
+bool PollSet::Watch::is_watching(OpenFileDescription const& description) const
+{
+    auto watched_description = m_description.strong_ref();
+    return watched_description.ptr() == &description;
+}
+
+auto PollSet::Watch::block_flags() const -> BlockFlags
+{
+    SpinlockLocker lock(m_lock);
+    return m_block_flags;
+}
+
+bool PollSet::Watch::is_edge_triggered() const
+{
+    SpinlockLocker lock(m_lock);
+    return m_edge_triggered;
+}
+
+void PollSet::Watch::set_block_flags(BlockFlags flags, bool edge_triggered)
+{
+    SpinlockLocker lock(m_lock);
+    m_block_flags = flags;
+    m_edge_triggered = edge_triggered;
+}
+
+bool PollSet::Watch::unblock_if_conditions_are_met(bool, void*)
+{
+    // We're called with the file's blocker set locked, so we mustn't take a reference to the
+    // description here: dropping the last one would close it under that lock. Just queue the
+    // watch, collect_ready_entries() figures out whether it's actually ready (or dead).
+    m_poll_set.mark_ready(*this);
+
+    // Watches stay registered with their description until they are removed.
+    return false;
+}
+
+}
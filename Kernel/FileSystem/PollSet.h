@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Library/LockWeakPtr.h>
+#include <Kernel/Locking/MutexProtected.h>
+#include <Kernel/Locking/SpinlockProtected.h>
+#include <Kernel/Tasks/Thread.h>
+
+namespace Kernel {
+
+// A PollSet is a persistent set of watched file descriptions. Unlike poll(), which
+// registers and unregisters a blocker on every watched description each time it is
+// called, a PollSet keeps one blocker registered per watch and collects the watches
+// that became ready into a ready list. Waiting on a PollSet is therefore proportional
+// to the number of ready descriptions rather than the number of watched ones.
+//
+// NOTE: A watch doesn't keep its description alive. Once the last descriptor referring to
+//       the description is closed, the watch is dropped from the set, just like with epoll.
+class PollSet final : public File {
+public:
+    using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+    struct ReadyEntry {
+        int fd { -1 };
+        BlockFlags flags { BlockFlags::None };
+        BlockFlags unblocked_flags { BlockFlags::None };
+    };
+
+    static ErrorOr<NonnullRefPtr<PollSet>> try_create();
+    virtual ~PollSet() override;
+
+    virtual bool can_read(OpenFileDescription const&, u64) const override;
+    // Poll sets are only accessed through their dedicated syscalls.
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return true; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+    virtual ErrorOr<void> close() override;
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "PollSet"sv; }
+    virtual bool is_poll_set() const override { return true; }
+
+    ErrorOr<void> add_watch(int fd, OpenFileDescription&, BlockFlags, bool edge_triggered);
+    ErrorOr<void> modify_watch(int fd, OpenFileDescription&, BlockFlags, bool edge_triggered);
+    ErrorOr<void> remove_watch(int fd);
+
+    // Fills `entries` with up to `max_entries` ready watches. Level-triggered watches
+    // stay in the ready list for as long as their description remains ready, while
+    // edge-triggered watches are only reported again after their next notification.
+    ErrorOr<void> collect_ready_entries(Vector<ReadyEntry>& entries, size_t max_entries);
+
+private:
+    class Watch final : public Thread::FileBlocker {
+    public:
+        static ErrorOr<NonnullOwnPtr<Watch>> try_create(PollSet&, int fd, OpenFileDescription&, BlockFlags, bool edge_triggered);
+        virtual ~Watch() override;
+
+        virtual StringView state_string() const override { return "PollSet"sv; }
+        virtual bool unblock_if_conditions_are_met(bool, void*) override;
+        // A watch never blocks its thread, it only records readiness.
+        virtual void will_unblock_immediately_without_blocking(UnblockImmediatelyReason) override { }
+
+        bool register_with_description();
+        void unregister_from_description();
+
+        int fd() const { return m_fd; }
+        // Returns null once the description has been destroyed.
+        LockRefPtr<OpenFileDescription> description() const { return m_description.strong_ref(); }
+        bool is_watching(OpenFileDescription const&) const;
+
+        BlockFlags block_flags() const;
+        bool is_edge_triggered() const;
+        void set_block_flags(BlockFlags, bool edge_triggered);
+
+    private:
+        friend class PollSet;
+
+        Watch(PollSet&, int fd, File&, LockWeakPtr<OpenFileDescription>, BlockFlags, bool edge_triggered);
+
+        PollSet& m_poll_set;
+        int const m_fd;
+        // The watch is registered with the file's blocker set, which must outlive it.
+        NonnullRefPtr<File> const m_file;
+        LockWeakPtr<OpenFileDescription> const m_description;
+        BlockFlags m_block_flags { BlockFlags::None };
+        bool m_edge_triggered { false };
+
+        // The fields below are protected by PollSet::m_ready_watches.
+        bool m_is_removed { false };
+        bool m_was_notified { false };
+        IntrusiveListNode<Watch> m_ready_list_node;
+
+    public:
+        using ReadyList = IntrusiveList<&Watch::m_ready_list_node>;
+    };
+
+    PollSet() = default;
+
+    void mark_ready(Watch&);
+    void detach_watch(Watch&);
+    ErrorOr<void> replace_watch(NonnullOwnPtr<Watch>&, int fd, OpenFileDescription&, BlockFlags, bool edge_triggered);
+
+    MutexProtected<HashMap<int, NonnullOwnPtr<Watch>>> m_watches;
+    mutable SpinlockProtected<Watch::ReadyList, LockRank::None> m_ready_watches {};
+};
+
+}
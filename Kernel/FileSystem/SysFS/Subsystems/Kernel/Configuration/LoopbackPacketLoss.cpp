@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Configuration/LoopbackPacketLoss.h>
+#include <Kernel/Net/LoopbackAdapter.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSLoopbackPacketLoss::SysFSLoopbackPacketLoss(SysFSDirectory const& parent_directory)
+    : SysFSSystemStringVariable(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSLoopbackPacketLoss> SysFSLoopbackPacketLoss::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSLoopbackPacketLoss(parent_directory)).release_nonnull();
+}
+
+ErrorOr<NonnullOwnPtr<KString>> SysFSLoopbackPacketLoss::value() const
+{
+    return KString::formatted("{}", LoopbackAdapter::packet_loss_interval());
+}
+
+void SysFSLoopbackPacketLoss::set_value(NonnullOwnPtr<KString> new_value)
+{
+    if (auto interval = new_value->view().to_uint<u32>(); interval.has_value())
+        LoopbackAdapter::set_packet_loss_interval(interval.value());
+}
+
+mode_t SysFSLoopbackPacketLoss::permissions() const
+{
+    // NOTE: Only root may inject packet loss.
+    return S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+}
+
+}
@@ -40,6 +40,7 @@ class Mutex;
 class MasterPTY;
 class Mount;
 class PerformanceEventBuffer;
+class PollSet;
 class ProcFS;
 class ProcFSInode;
 class Process;
@@ -38,7 +38,7 @@ MutexProtected<IPv4Socket::List>& IPv4Socket::all_sockets()
 
 ErrorOr<NonnullOwnPtr<DoubleBuffer>> IPv4Socket::try_create_receive_buffer()
 {
-    return DoubleBuffer::try_create("IPv4Socket: Receive buffer"sv, 256 * KiB);
+    return DoubleBuffer::try_create("IPv4Socket: Receive buffer"sv, receive_buffer_size);
 }
 
 ErrorOr<NonnullRefPtr<Socket>> IPv4Socket::create(int type, int protocol)
@@ -893,6 +893,13 @@ void IPv4Socket::set_can_read(bool value)
         evaluate_block_conditions();
 }
 
+size_t IPv4Socket::receive_buffer_space() const
+{
+    if (!m_receive_buffer)
+        return 0;
+    return m_receive_buffer->space_for_writing();
+}
+
 void IPv4Socket::drop_receive_buffer()
 {
     m_receive_buffer = nullptr;
@@ -4,12 +4,24 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Singleton.h>
 #include <Kernel/Net/LoopbackAdapter.h>
 
 namespace Kernel {
 
 static bool s_loopback_initialized = false;
+static Atomic<u32> s_packet_loss_interval { 0 };
+
+u32 LoopbackAdapter::packet_loss_interval()
+{
+    return s_packet_loss_interval.load();
+}
+
+void LoopbackAdapter::set_packet_loss_interval(u32 interval)
+{
+    s_packet_loss_interval.store(interval);
+}
 
 ErrorOr<NonnullRefPtr<LoopbackAdapter>> LoopbackAdapter::try_create()
 {
@@ -29,6 +41,10 @@ LoopbackAdapter::~LoopbackAdapter() = default;
 
 void LoopbackAdapter::send_raw(ReadonlyBytes payload)
 {
+    if (auto interval = packet_loss_interval(); interval != 0 && (m_packets_sent.fetch_add(1) + 1) % interval == 0) {
+        dbgln_if(LOOPBACK_DEBUG, "LoopbackAdapter: Dropping {} byte(s) to simulate packet loss.", payload.size());
+        return;
+    }
     dbgln_if(LOOPBACK_DEBUG, "LoopbackAdapter: Sending {} byte(s) to myself.", payload.size());
     did_receive(payload);
 }
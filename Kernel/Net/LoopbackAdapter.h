@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <Kernel/Net/NetworkAdapter.h>
 
 namespace Kernel {
@@ -26,6 +27,14 @@ public:
     virtual bool link_up() override { return true; }
     virtual bool link_full_duplex() override { return true; }
     virtual int link_speed() override { return 1000; }
+
+    // Drops every Nth packet sent over the loopback interface, so that the recovery paths of
+    // our protocols can be exercised locally. Zero disables packet loss.
+    static u32 packet_loss_interval();
+    static void set_packet_loss_interval(u32);
+
+private:
+    Atomic<u32> m_packets_sent { 0 };
 };
 
 }
@@ -455,6 +455,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
             auto client = client_or_error.release_value();
             MutexLocker locker(client->mutex());
             dbgln_if(TCP_DEBUG, "handle_tcp: created new client socket with tuple {}", client->tuple().to_string());
+            client->process_syn_options(tcp_packet.parse_options());
             client->set_sequence_number(1000);
             client->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
             [[maybe_unused]] auto rc2 = client->send_tcp_packet(TCPFlags::SYN | TCPFlags::ACK);
@@ -618,8 +619,15 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
         }
 
         if (tcp_packet.sequence_number() != socket->ack_number()) {
-            dbgln_if(TCP_DEBUG, "Discarding out of order packet: seq {} vs. ack {}", tcp_packet.sequence_number(), socket->ack_number());
-            if (socket->duplicate_acks() < TCPSocket::maximum_duplicate_acks) {
+            bool is_ahead_of_hole = payload_size != 0 && !tcp_packet.has_fin() && tcp_sequence_is_after(tcp_packet.sequence_number(), socket->ack_number());
+            if (is_ahead_of_hole) {
+                dbgln_if(TCP_DEBUG, "Queueing out of order packet: seq {} vs. ack {}", tcp_packet.sequence_number(), socket->ack_number());
+                socket->queue_out_of_order_segment(ipv4_packet.source(), tcp_packet.source_port(), { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, tcp_packet, packet_timestamp);
+            } else {
+                dbgln_if(TCP_DEBUG, "Discarding out of order packet: seq {} vs. ack {}", tcp_packet.sequence_number(), socket->ack_number());
+            }
+            // With SACK, every segment beyond a hole is reported to the sender right away (RFC 2018, section 4).
+            if (socket->duplicate_acks() < TCPSocket::maximum_duplicate_acks || (is_ahead_of_hole && socket->is_sack_enabled())) {
                 dbgln_if(TCP_DEBUG, "Sending ACK with same ack number to trigger fast retransmission");
                 socket->set_duplicate_acks(socket->duplicate_acks() + 1);
                 [[maybe_unused]] auto result = socket->send_ack(true);
@@ -645,7 +653,11 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
                 socket->set_ack_number(tcp_packet.sequence_number() + payload_size);
                 dbgln_if(TCP_DEBUG, "Got packet with ack_no={}, seq_no={}, payload_size={}, acking it with new ack_no={}, seq_no={}",
                     tcp_packet.ack_number(), tcp_packet.sequence_number(), payload_size, socket->ack_number(), socket->sequence_number());
-                send_delayed_tcp_ack(*socket);
+                // RFC 5681, section 4.2: an ACK that fills a hole should be sent immediately.
+                if (socket->deliver_out_of_order_segments())
+                    (void)socket->send_ack();
+                else
+                    send_delayed_tcp_ack(*socket);
             }
         }
     }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Optional.h>
+#include <AK/Vector.h>
 #include <Kernel/Net/IPv4.h>
 
 namespace Kernel {
@@ -21,6 +23,22 @@ struct TCPFlags {
     };
 };
 
+enum class TCPOptionKind : u8 {
+    End = 0,
+    NoOperation = 1,
+    MSS = 2,
+    WindowScale = 3,
+    SACKPermitted = 4,
+    SACK = 5,
+    Timestamp = 8,
+};
+
+// Sequence number comparisons that take wrap-around into account (RFC 793, section 3.3).
+inline bool tcp_sequence_is_before(u32 a, u32 b) { return static_cast<i32>(a - b) < 0; }
+inline bool tcp_sequence_is_before_or_equal(u32 a, u32 b) { return static_cast<i32>(a - b) <= 0; }
+inline bool tcp_sequence_is_after(u32 a, u32 b) { return tcp_sequence_is_before(b, a); }
+inline bool tcp_sequence_is_after_or_equal(u32 a, u32 b) { return tcp_sequence_is_before_or_equal(b, a); }
+
 class [[gnu::packed]] TCPOptionMSS {
 public:
     TCPOptionMSS(u16 value)
@@ -38,6 +56,94 @@ private:
 
 static_assert(AssertSize<TCPOptionMSS, 4>());
 
+// RFC 7323, section 2.2
+class [[gnu::packed]] TCPOptionWindowScale {
+public:
+    TCPOptionWindowScale(u8 shift_count)
+        : m_shift_count(shift_count)
+    {
+    }
+
+    u8 shift_count() const { return m_shift_count; }
+
+private:
+    u8 m_padding { to_underlying(TCPOptionKind::NoOperation) };
+    u8 m_option_kind { to_underlying(TCPOptionKind::WindowScale) };
+    u8 m_option_length { sizeof(TCPOptionWindowScale) - 1 };
+    u8 m_shift_count { 0 };
+};
+
+static_assert(AssertSize<TCPOptionWindowScale, 4>());
+
+// RFC 2018, section 2
+class [[gnu::packed]] TCPOptionSACKPermitted {
+private:
+    u8 m_padding[2] { to_underlying(TCPOptionKind::NoOperation), to_underlying(TCPOptionKind::NoOperation) };
+    u8 m_option_kind { to_underlying(TCPOptionKind::SACKPermitted) };
+    u8 m_option_length { sizeof(TCPOptionSACKPermitted) - 2 };
+};
+
+static_assert(AssertSize<TCPOptionSACKPermitted, 4>());
+
+// RFC 7323, section 3.2
+class [[gnu::packed]] TCPOptionTimestamp {
+public:
+    TCPOptionTimestamp(u32 value, u32 echo_reply)
+        : m_value(value)
+        , m_echo_reply(echo_reply)
+    {
+    }
+
+    u32 value() const { return m_value; }
+    u32 echo_reply() const { return m_echo_reply; }
+
+private:
+    u8 m_padding[2] { to_underlying(TCPOptionKind::NoOperation), to_underlying(TCPOptionKind::NoOperation) };
+    u8 m_option_kind { to_underlying(TCPOptionKind::Timestamp) };
+    u8 m_option_length { sizeof(TCPOptionTimestamp) - 2 };
+    NetworkOrdered<u32> m_value;
+    NetworkOrdered<u32> m_echo_reply;
+};
+
+static_assert(AssertSize<TCPOptionTimestamp, 12>());
+
+struct TCPSACKBlock {
+    u32 left_edge { 0 };
+    u32 right_edge { 0 };
+};
+
+// RFC 2018, section 3. The option header is followed by one pair of edges per block.
+class [[gnu::packed]] TCPOptionSACK {
+public:
+    // Three blocks still fit next to the timestamp option, which is what we always send.
+    static constexpr size_t maximum_blocks = 3;
+    static constexpr size_t maximum_received_blocks = 4;
+
+    static constexpr size_t size_for_block_count(size_t count) { return sizeof(TCPOptionSACK) + count * 2 * sizeof(u32); }
+
+    explicit TCPOptionSACK(size_t block_count)
+        : m_option_length(2 + block_count * 2 * sizeof(u32))
+    {
+    }
+
+private:
+    u8 m_padding[2] { to_underlying(TCPOptionKind::NoOperation), to_underlying(TCPOptionKind::NoOperation) };
+    u8 m_option_kind { to_underlying(TCPOptionKind::SACK) };
+    u8 m_option_length { 0 };
+};
+
+static_assert(AssertSize<TCPOptionSACK, 4>());
+
+// The options we care about, as parsed out of an incoming segment.
+struct TCPReceivedOptions {
+    Optional<u16> mss;
+    Optional<u8> window_scale;
+    bool sack_permitted { false };
+    Optional<u32> timestamp_value;
+    u32 timestamp_echo_reply { 0 };
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_received_blocks> sack_blocks;
+};
+
 class [[gnu::packed]] TCPPacket {
 public:
     TCPPacket() = default;
@@ -80,6 +186,9 @@ public:
     void const* payload() const { return ((u8 const*)this) + header_size(); }
     void* payload() { return ((u8*)this) + header_size(); }
 
+    ReadonlyBytes options() const { return { ((u8 const*)this) + sizeof(TCPPacket), header_size() - sizeof(TCPPacket) }; }
+    TCPReceivedOptions parse_options() const;
+
 private:
     NetworkOrdered<u16> m_source_port;
     NetworkOrdered<u16> m_destination_port;
@@ -94,4 +203,57 @@ private:
 
 static_assert(AssertSize<TCPPacket, 20>());
 
+inline TCPReceivedOptions TCPPacket::parse_options() const
+{
+    TCPReceivedOptions received;
+    auto bytes = options();
+    size_t offset = 0;
+    while (offset < bytes.size()) {
+        auto kind = static_cast<TCPOptionKind>(bytes[offset]);
+        if (kind == TCPOptionKind::End)
+            break;
+        if (kind == TCPOptionKind::NoOperation) {
+            ++offset;
+            continue;
+        }
+        if (offset + 1 >= bytes.size())
+            break;
+        size_t length = bytes[offset + 1];
+        if (length < 2 || offset + length > bytes.size())
+            break;
+        auto data = bytes.slice(offset + 2, length - 2);
+        auto read_u32 = [&](size_t index) {
+            return static_cast<u32>(data[index]) << 24 | static_cast<u32>(data[index + 1]) << 16 | static_cast<u32>(data[index + 2]) << 8 | data[index + 3];
+        };
+
+        switch (kind) {
+        case TCPOptionKind::MSS:
+            if (data.size() == 2)
+                received.mss = static_cast<u16>(data[0] << 8 | data[1]);
+            break;
+        case TCPOptionKind::WindowScale:
+            if (data.size() == 1)
+                received.window_scale = data[0];
+            break;
+        case TCPOptionKind::SACKPermitted:
+            received.sack_permitted = data.is_empty();
+            break;
+        case TCPOptionKind::SACK:
+            for (size_t i = 0; i + 8 <= data.size() && received.sack_blocks.size() < TCPOptionSACK::maximum_received_blocks; i += 8)
+                received.sack_blocks.unchecked_append({ read_u32(i), read_u32(i + 4) });
+            break;
+        case TCPOptionKind::Timestamp:
+            if (data.size() == 8) {
+                received.timestamp_value = read_u32(0);
+                received.timestamp_echo_reply = read_u32(4);
+            }
+            break;
+        default:
+            break;
+        }
+        offset += length;
+    }
+    return received;
+}
+
 }
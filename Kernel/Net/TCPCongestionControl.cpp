@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <Kernel/Net/TCP.h>
+#include <Kernel/Net/TCPCongestionControl.h>
+
+namespace Kernel {
+
+static Atomic<u8> s_default_algorithm { to_underlying(TCPCongestionControl::Algorithm::NewReno) };
+
+Optional<TCPCongestionControl::Algorithm> TCPCongestionControl::algorithm_from_name(StringView name)
+{
+    if (name == "newreno"sv)
+        return Algorithm::NewReno;
+    if (name == "cubic"sv)
+        return Algorithm::Cubic;
+    return {};
+}
+
+StringView TCPCongestionControl::name_for_algorithm(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::NewReno:
+        return "newreno"sv;
+    case Algorithm::Cubic:
+        return "cubic"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+TCPCongestionControl::Algorithm TCPCongestionControl::default_algorithm()
+{
+    return static_cast<Algorithm>(s_default_algorithm.load());
+}
+
+void TCPCongestionControl::set_default_algorithm(Algorithm algorithm)
+{
+    s_default_algorithm.store(to_underlying(algorithm));
+}
+
+ErrorOr<NonnullOwnPtr<TCPCongestionControl>> TCPCongestionControl::try_create(Algorithm algorithm, u32 maximum_segment_size)
+{
+    switch (algorithm) {
+    case Algorithm::NewReno:
+        return adopt_nonnull_own_or_enomem<TCPCongestionControl>(new (nothrow) TCPNewRenoCongestionControl(maximum_segment_size));
+    case Algorithm::Cubic:
+        return adopt_nonnull_own_or_enomem<TCPCongestionControl>(new (nothrow) TCPCubicCongestionControl(maximum_segment_size));
+    }
+    VERIFY_NOT_REACHED();
+}
+
+TCPCongestionControl::TCPCongestionControl(u32 maximum_segment_size)
+{
+    set_maximum_segment_size(maximum_segment_size);
+}
+
+void TCPCongestionControl::set_maximum_segment_size(u32 maximum_segment_size)
+{
+    VERIFY(maximum_segment_size > 0);
+    m_maximum_segment_size = maximum_segment_size;
+
+    // RFC 6928: IW = min (10*MSS, max (2*MSS, 14600))
+    m_congestion_window = min(10 * maximum_segment_size, max(2 * maximum_segment_size, 14600u));
+}
+
+void TCPCongestionControl::on_ack(u32 acked_bytes, u32 ack_number, u32 bytes_in_flight, MonotonicTime now, Optional<Duration> round_trip_time)
+{
+    if (m_in_recovery) {
+        if (tcp_sequence_is_after_or_equal(ack_number, m_recovery_point)) {
+            // RFC 6582, section 3.2, step 3, option 1: deflate the window when leaving fast recovery.
+            m_in_recovery = false;
+            m_congestion_window = min(m_slow_start_threshold, max(bytes_in_flight, m_maximum_segment_size) + m_maximum_segment_size);
+            return;
+        }
+
+        // A partial acknowledgment: deflate by the amount of new data acknowledged, and add
+        // back one segment for the retransmission that the caller is about to send.
+        m_congestion_window -= min(acked_bytes, m_congestion_window);
+        if (acked_bytes >= m_maximum_segment_size)
+            m_congestion_window += m_maximum_segment_size;
+        m_congestion_window = max(m_congestion_window, m_maximum_segment_size);
+        return;
+    }
+
+    if (m_congestion_window < m_slow_start_threshold) {
+        // RFC 5681, section 3.1: grow by at most one segment per ACK during slow start.
+        m_congestion_window += min(acked_bytes, m_maximum_segment_size);
+        return;
+    }
+
+    grow_in_congestion_avoidance(acked_bytes, now, round_trip_time);
+}
+
+void TCPCongestionControl::on_duplicate_ack()
+{
+    // RFC 5681, section 3.2, step 4: every further duplicate ACK means another segment has left the network.
+    if (m_in_recovery)
+        m_congestion_window += m_maximum_segment_size;
+}
+
+void TCPCongestionControl::on_enter_fast_recovery(u32 bytes_in_flight, u32 send_next, MonotonicTime now)
+{
+    // RFC 6582, section 3.2, step 2: don't react to losses from the window we are already recovering from.
+    if (m_in_recovery)
+        return;
+
+    m_slow_start_threshold = slow_start_threshold_after_loss(bytes_in_flight, now);
+    m_congestion_window = m_slow_start_threshold + 3 * m_maximum_segment_size;
+    m_recovery_point = send_next;
+    m_in_recovery = true;
+}
+
+void TCPCongestionControl::on_retransmit_timeout(u32 bytes_in_flight, u32 send_next, MonotonicTime now)
+{
+    // RFC 5681, section 3.1: after a timeout the window collapses to the loss window of a single segment.
+    m_slow_start_threshold = slow_start_threshold_after_loss(bytes_in_flight, now);
+    m_congestion_window = m_maximum_segment_size;
+    m_recovery_point = send_next;
+    m_in_recovery = false;
+    did_time_out();
+}
+
+void TCPNewRenoCongestionControl::grow_in_congestion_avoidance(u32 acked_bytes, MonotonicTime, Optional<Duration>)
+{
+    // RFC 5681, section 3.1: appropriate byte counting, one segment per window's worth of acknowledged data.
+    m_bytes_acked_in_avoidance += acked_bytes;
+    if (m_bytes_acked_in_avoidance >= m_congestion_window) {
+        m_bytes_acked_in_avoidance -= m_congestion_window;
+        m_congestion_window += m_maximum_segment_size;
+    }
+}
+
+u32 TCPNewRenoCongestionControl::slow_start_threshold_after_loss(u32 bytes_in_flight, MonotonicTime)
+{
+    // RFC 5681, equation (4)
+    m_bytes_acked_in_avoidance = 0;
+    return max(bytes_in_flight / 2, 2 * m_maximum_segment_size);
+}
+
+// RFC 8312, section 5: C = 0.4 and beta_cubic = 0.7, expressed as fractions below.
+static constexpr u64 cubic_c_numerator = 4;
+static constexpr u64 cubic_c_denominator = 10;
+static constexpr u64 cubic_beta_numerator = 7;
+static constexpr u64 cubic_beta_denominator = 10;
+
+static u64 integer_cube_root(u64 value)
+{
+    u64 low = 0;
+    u64 high = 2642245; // The cube root of 2^64, rounded down.
+    while (low < high) {
+        u64 middle = (low + high + 1) / 2;
+        if (middle * middle * middle <= value)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+    return low;
+}
+
+void TCPCubicCongestionControl::grow_in_congestion_avoidance(u32 acked_bytes, MonotonicTime now, Optional<Duration> round_trip_time)
+{
+    if (round_trip_time.has_value() && (!m_minimum_round_trip_time.has_value() || *round_trip_time < *m_minimum_round_trip_time))
+        m_minimum_round_trip_time = round_trip_time;
+
+    u64 const mss = m_maximum_segment_size;
+    u64 const cwnd = m_congestion_window;
+
+    if (!m_epoch_start.has_value()) {
+        m_epoch_start = now;
+        if (cwnd < m_window_max) {
+            // K = cubic_root((W_max - cwnd) / C), in seconds with the window counted in segments.
+            u64 segments_to_recover = (m_window_max - cwnd) / mss;
+            m_k_milliseconds = integer_cube_root(segments_to_recover * cubic_c_denominator * 1'000'000'000 / cubic_c_numerator);
+            m_origin_point = m_window_max;
+        } else {
+            m_k_milliseconds = 0;
+            m_origin_point = cwnd;
+        }
+        m_tcp_friendly_window = cwnd;
+    }
+
+    // RFC 8312, section 4.1: aim for the window one round trip from now.
+    i64 elapsed_milliseconds = (now - *m_epoch_start).to_milliseconds();
+    if (m_minimum_round_trip_time.has_value())
+        elapsed_milliseconds += m_minimum_round_trip_time->to_milliseconds();
+
+    // Clamp the offset so that its cube comfortably fits into 64 bits.
+    i64 offset_milliseconds = clamp(elapsed_milliseconds - static_cast<i64>(m_k_milliseconds), -100'000, 100'000);
+    u64 offset_cubed = static_cast<u64>(offset_milliseconds < 0 ? -offset_milliseconds : offset_milliseconds);
+    offset_cubed = offset_cubed * offset_cubed * offset_cubed;
+
+    // W_cubic(t) = C * (t - K)^3 + W_max, converted from segments and seconds to bytes and milliseconds.
+    u64 delta = (offset_cubed * cubic_c_numerator / cubic_c_denominator / 1000) * mss / 1'000'000;
+    u64 target = offset_milliseconds < 0
+        ? (delta < m_origin_point ? m_origin_point - delta : 0)
+        : m_origin_point + delta;
+    target = clamp(target, cwnd, cwnd + cwnd / 2);
+
+    // RFC 8312, section 4.2: never grow slower than standard TCP would.
+    // alpha = 3 * (1 - beta) / (1 + beta), which is 9/17 for beta = 0.7.
+    m_tcp_friendly_window += 9 * static_cast<u64>(acked_bytes) * mss / (17 * cwnd);
+    if (m_tcp_friendly_window > target)
+        target = m_tcp_friendly_window;
+
+    u64 increment;
+    if (target > cwnd)
+        increment = (target - cwnd) * acked_bytes / cwnd;
+    else
+        increment = mss * acked_bytes / (100 * cwnd);
+
+    m_congestion_window = min<u64>(cwnd + max<u64>(increment, 1), NumericLimits<u32>::max() / 2);
+}
+
+u32 TCPCubicCongestionControl::slow_start_threshold_after_loss(u32, MonotonicTime)
+{
+    m_epoch_start.clear();
+
+    // RFC 8312, section 4.6: fast convergence releases bandwidth to newer flows.
+    u64 cwnd = m_congestion_window;
+    if (cwnd < m_window_max)
+        m_window_max = cwnd * (cubic_beta_denominator + cubic_beta_numerator) / (2 * cubic_beta_denominator);
+    else
+        m_window_max = cwnd;
+
+    return max<u32>(cwnd * cubic_beta_numerator / cubic_beta_denominator, 2 * m_maximum_segment_size);
+}
+
+void TCPCubicCongestionControl::did_time_out()
+{
+    m_epoch_start.clear();
+    m_tcp_friendly_window = 0;
+}
+
+}
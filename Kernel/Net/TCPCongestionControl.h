@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+
+namespace Kernel {
+
+// Tracks the congestion window of a single TCP connection.
+//
+// The parts that every algorithm shares live in this base class: slow start (RFC 5681),
+// and fast recovery with the NewReno modification for partial acknowledgments (RFC 6582).
+// Subclasses decide how the window grows during congestion avoidance and how far it is
+// reduced when a loss is detected.
+class TCPCongestionControl {
+public:
+    enum class Algorithm : u8 {
+        NewReno,
+        Cubic,
+    };
+
+    static Optional<Algorithm> algorithm_from_name(StringView);
+    static StringView name_for_algorithm(Algorithm);
+
+    // The algorithm used by newly created sockets, configurable through /sys/kernel/conf/tcp_congestion_control.
+    static Algorithm default_algorithm();
+    static void set_default_algorithm(Algorithm);
+
+    static ErrorOr<NonnullOwnPtr<TCPCongestionControl>> try_create(Algorithm, u32 maximum_segment_size);
+    virtual ~TCPCongestionControl() = default;
+
+    virtual Algorithm algorithm() const = 0;
+
+    u32 congestion_window() const { return m_congestion_window; }
+    u32 slow_start_threshold() const { return m_slow_start_threshold; }
+    bool is_in_recovery() const { return m_in_recovery; }
+
+    // Resets the initial window (RFC 6928) once the connection has settled on a segment size.
+    void set_maximum_segment_size(u32);
+
+    // Called for every ACK that moves the left edge of the send window forward.
+    void on_ack(u32 acked_bytes, u32 ack_number, u32 bytes_in_flight, MonotonicTime now, Optional<Duration> round_trip_time);
+
+    // Called for each further duplicate ACK while in fast recovery.
+    void on_duplicate_ack();
+
+    // Called when loss is inferred from duplicate ACKs. `send_next` is the first sequence number that has not been sent yet.
+    void on_enter_fast_recovery(u32 bytes_in_flight, u32 send_next, MonotonicTime now);
+
+    void on_retransmit_timeout(u32 bytes_in_flight, u32 send_next, MonotonicTime now);
+
+protected:
+    explicit TCPCongestionControl(u32 maximum_segment_size);
+
+    virtual void grow_in_congestion_avoidance(u32 acked_bytes, MonotonicTime now, Optional<Duration> round_trip_time) = 0;
+    virtual u32 slow_start_threshold_after_loss(u32 bytes_in_flight, MonotonicTime now) = 0;
+    virtual void did_time_out() { }
+
+    u32 m_maximum_segment_size { 0 };
+    u32 m_congestion_window { 0 };
+    u32 m_slow_start_threshold { NumericLimits<u32>::max() };
+
+private:
+    bool m_in_recovery { false };
+    u32 m_recovery_point { 0 };
+};
+
+// RFC 5681 congestion avoidance: one segment per round trip, halve the window on loss.
+class TCPNewRenoCongestionControl final : public TCPCongestionControl {
+public:
+    explicit TCPNewRenoCongestionControl(u32 maximum_segment_size)
+        : TCPCongestionControl(maximum_segment_size)
+    {
+    }
+
+    virtual Algorithm algorithm() const override { return Algorithm::NewReno; }
+
+private:
+    virtual void grow_in_congestion_avoidance(u32 acked_bytes, MonotonicTime, Optional<Duration>) override;
+    virtual u32 slow_start_threshold_after_loss(u32 bytes_in_flight, MonotonicTime) override;
+
+    u32 m_bytes_acked_in_avoidance { 0 };
+};
+
+// RFC 8312: the window follows a cubic function of the time since the last loss,
+// which lets it recover quickly on paths with a large bandwidth-delay product.
+class TCPCubicCongestionControl final : public TCPCongestionControl {
+public:
+    explicit TCPCubicCongestionControl(u32 maximum_segment_size)
+        : TCPCongestionControl(maximum_segment_size)
+    {
+    }
+
+    virtual Algorithm algorithm() const override { return Algorithm::Cubic; }
+
+private:
+    virtual void grow_in_congestion_avoidance(u32 acked_bytes, MonotonicTime, Optional<Duration>) override;
+    virtual u32 slow_start_threshold_after_loss(u32 bytes_in_flight, MonotonicTime) override;
+    virtual void did_time_out() override;
+
+    u32 m_window_max { 0 };
+    u32 m_origin_point { 0 };
+    u64 m_k_milliseconds { 0 };
+    Optional<MonotonicTime> m_epoch_start;
+    u64 m_tcp_friendly_window { 0 };
+    Optional<Duration> m_minimum_round_trip_time;
+};
+
+}
@@ -23,6 +23,12 @@
 
 namespace Kernel {
 
+// RFC 7323, section 5.4: a millisecond clock is well within the recommended range.
+static u32 tcp_timestamp_now()
+{
+    return static_cast<u32>(TimeManagement::the().monotonic_time().milliseconds());
+}
+
 void TCPSocket::for_each(Function<void(TCPSocket const&)> callback)
 {
     sockets_by_tuple().for_each_shared([&](auto const& it) {
@@ -74,6 +80,8 @@ void TCPSocket::set_state(State new_state)
         // are packets on the way which we wouldn't want a new socket to get hit
         // with, so there's no point in keeping the receive buffer around.
         drop_receive_buffer();
+        m_out_of_order_segments.clear();
+        m_out_of_order_bytes = 0;
     }
 
     if (new_state == State::Closed) {
@@ -164,11 +172,15 @@ void TCPSocket::release_for_accept(NonnullRefPtr<TCPSocket> socket)
     [[maybe_unused]] auto rc = queue_connection_from(move(socket));
 }
 
-TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer)
+TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullOwnPtr<TCPCongestionControl> congestion_control)
     : IPv4Socket(SOCK_STREAM, protocol, move(receive_buffer), move(scratch_buffer))
+    , m_congestion_control(move(congestion_control))
     , m_last_ack_sent_time(TimeManagement::the().monotonic_time())
     , m_last_retransmit_time(TimeManagement::the().monotonic_time())
 {
+    // RFC 7323, section 2.3: use the smallest shift that still lets us advertise the whole receive buffer.
+    while ((receive_buffer_size >> m_receive_window_scale) > NumericLimits<u16>::max())
+        ++m_receive_window_scale;
 }
 
 TCPSocket::~TCPSocket()
@@ -182,7 +194,8 @@ ErrorOr<NonnullRefPtr<TCPSocket>> TCPSocket::try_create(int protocol, NonnullOwn
 {
     // Note: Scratch buffer is only used for SOCK_STREAM sockets.
     auto scratch_buffer = TRY(KBuffer::try_create_with_size("TCPSocket: Scratch buffer"sv, 65536));
-    return adopt_nonnull_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer)));
+    auto congestion_control = TRY(TCPCongestionControl::try_create(TCPCongestionControl::default_algorithm(), default_maximum_segment_size));
+    return adopt_nonnull_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer), move(congestion_control)));
 }
 
 ErrorOr<size_t> TCPSocket::protocol_size(ReadonlyBytes raw_ipv4_packet)
@@ -209,7 +222,7 @@ ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
     RoutingDecision routing_decision = route_to(peer_address(), local_address(), adapter);
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
-    size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+    size_t mss = maximum_segment_size_for(*routing_decision.adapter);
 
     // RFC 896 (Nagle’s algorithm): https://www.ietf.org/rfc/rfc0896
     // "The solution is to inhibit the sending of new TCP  segments when
@@ -222,7 +235,11 @@ ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
     if (has_unacked_data && data_length < mss)
         return 0;
 
-    data_length = min(data_length, mss);
+    auto available_window = m_unacked_packets.with_shared([&](auto const& unacked_packets) { return send_window_available(unacked_packets); });
+    if (available_window == 0)
+        return EAGAIN;
+
+    data_length = min(data_length, min(mss, available_window));
     TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, &data, data_length, &routing_decision));
     return data_length;
 }
@@ -243,8 +260,26 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     auto ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
 
-    bool const has_mss_option = flags == TCPFlags::SYN;
-    const size_t options_size = has_mss_option ? sizeof(TCPOptionMSS) : 0;
+    bool const is_syn = flags & TCPFlags::SYN;
+
+    // Only pure ACKs carry SACK blocks, so that data segments never outgrow the MSS.
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_blocks> sack_blocks;
+    if (m_sack_enabled && !is_syn && (flags & TCPFlags::ACK) && payload_size == 0)
+        sack_blocks = sack_blocks_to_send();
+
+    size_t options_size = 0;
+    if (is_syn) {
+        options_size += sizeof(TCPOptionMSS);
+        if (m_window_scaling_enabled)
+            options_size += sizeof(TCPOptionWindowScale);
+        if (m_sack_enabled)
+            options_size += sizeof(TCPOptionSACKPermitted);
+    }
+    if (m_timestamps_enabled)
+        options_size += sizeof(TCPOptionTimestamp);
+    if (!sack_blocks.is_empty())
+        options_size += TCPOptionSACK::size_for_block_count(sack_blocks.size());
+
     const size_t tcp_header_size = sizeof(TCPPacket) + options_size;
     const size_t buffer_size = ipv4_payload_offset + tcp_header_size + payload_size;
     auto packet = routing_decision.adapter->acquire_packet_buffer(buffer_size);
@@ -258,11 +293,35 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     VERIFY(local_port());
     tcp_packet.set_source_port(local_port());
     tcp_packet.set_destination_port(peer_port());
-    tcp_packet.set_window_size(NumericLimits<u16>::max());
+    tcp_packet.set_window_size(advertised_window_size(is_syn));
     tcp_packet.set_sequence_number(m_sequence_number);
     tcp_packet.set_data_offset(tcp_header_size / sizeof(u32));
     tcp_packet.set_flags(flags);
 
+    auto* options = packet->buffer->data() + ipv4_payload_offset + sizeof(TCPPacket);
+    auto append_option = [&](auto const& option) {
+        memcpy(options, &option, sizeof(option));
+        options += sizeof(option);
+    };
+    if (is_syn) {
+        u16 mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+        append_option(TCPOptionMSS { mss });
+        if (m_window_scaling_enabled)
+            append_option(TCPOptionWindowScale { m_receive_window_scale });
+        if (m_sack_enabled)
+            append_option(TCPOptionSACKPermitted {});
+    }
+    if (m_timestamps_enabled)
+        append_option(TCPOptionTimestamp { tcp_timestamp_now(), m_timestamp_recent });
+    if (!sack_blocks.is_empty()) {
+        append_option(TCPOptionSACK { sack_blocks.size() });
+        for (auto const& block : sack_blocks) {
+            append_option(NetworkOrdered<u32> { block.left_edge });
+            append_option(NetworkOrdered<u32> { block.right_edge });
+        }
+    }
+    VERIFY(options == (u8*)tcp_packet.payload());
+
     if (payload) {
         if (auto result = payload->read(tcp_packet.payload(), payload_size); result.is_error()) {
             routing_decision.adapter->release_packet_buffer(*packet);
@@ -276,26 +335,24 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
         tcp_packet.set_ack_number(m_ack_number);
     }
 
+    u32 const sequence_number = m_sequence_number;
     if (flags & TCPFlags::SYN) {
         ++m_sequence_number;
     } else {
         m_sequence_number += payload_size;
     }
 
-    if (has_mss_option) {
-        u16 mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
-        TCPOptionMSS mss_option { mss };
-        VERIFY(packet->buffer->size() >= ipv4_payload_offset + sizeof(TCPPacket) + sizeof(mss_option));
-        memcpy(packet->buffer->data() + ipv4_payload_offset + sizeof(TCPPacket), &mss_option, sizeof(mss_option));
-    }
-
     tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
 
     bool expect_ack { tcp_packet.has_syn() || payload_size > 0 };
     if (expect_ack) {
         bool append_failed { false };
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter });
+            auto now = TimeManagement::the().monotonic_time();
+            // Start the retransmission timer when the first segment goes out (RFC 6298, section 5.1).
+            if (unacked_packets.packets.is_empty())
+                m_last_retransmit_time = now;
+            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter, 0, sequence_number, static_cast<u32>(payload_size), now });
             if (result.is_error()) {
                 dbgln("TCPSocket: Dropped outbound packet because try_append() failed");
                 append_failed = true;
@@ -319,47 +376,359 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
 void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
 {
-    if (packet.has_ack()) {
-        u32 ack_number = packet.ack_number();
+    auto options = packet.parse_options();
 
-        dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
+    // A listening socket applies the options of an incoming SYN to the client socket it creates instead.
+    if (packet.has_syn() && m_state != State::Listen)
+        process_syn_options(options);
 
-        int removed = 0;
-        m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            while (!unacked_packets.packets.is_empty()) {
-                auto& packet = unacked_packets.packets.first();
-
-                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", packet.ack_number);
-
-                if (packet.ack_number <= ack_number) {
-                    auto old_adapter = packet.adapter.strong_ref();
-                    if (old_adapter)
-                        old_adapter->release_packet_buffer(*packet.buffer);
-                    TCPPacket& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                    if (m_send_window_size != tcp_packet.window_size()) {
-                        m_send_window_size = tcp_packet.window_size();
-                    }
-                    auto payload_size = packet.buffer->buffer->data() + packet.buffer->buffer->size() - (u8*)tcp_packet.payload();
-                    unacked_packets.size -= payload_size;
-                    evaluate_block_conditions();
-                    unacked_packets.packets.take_first();
-                    removed++;
-                } else {
-                    break;
-                }
+    // RFC 7323, section 4.3
+    if (m_timestamps_enabled && options.timestamp_value.has_value() && tcp_sequence_is_before_or_equal(packet.sequence_number(), m_last_ack_number_sent))
+        m_timestamp_recent = options.timestamp_value.value();
+
+    if (packet.has_ack())
+        process_ack(packet, options, size - packet.header_size());
+
+    m_packets_in++;
+    m_bytes_in += packet.header_size() + size;
+}
+
+void TCPSocket::process_syn_options(TCPReceivedOptions const& options)
+{
+    m_peer_maximum_segment_size = options.mss.value_or(default_maximum_segment_size);
+
+    if (options.window_scale.has_value()) {
+        // RFC 7323, section 2.3: shift counts above 14 must be treated as 14.
+        m_send_window_scale = min(options.window_scale.value(), 14);
+    } else {
+        m_window_scaling_enabled = false;
+        m_send_window_scale = 0;
+        m_receive_window_scale = 0;
+    }
+
+    m_sack_enabled = options.sack_permitted;
+
+    m_timestamps_enabled = options.timestamp_value.has_value();
+    if (m_timestamps_enabled)
+        m_timestamp_recent = options.timestamp_value.value();
+
+    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
+    auto routing_decision = route_to(peer_address(), local_address(), adapter);
+    if (!routing_decision.is_zero())
+        m_congestion_control->set_maximum_segment_size(maximum_segment_size_for(*routing_decision.adapter));
+
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) negotiated mss={}, window_scale={}/{}, sack={}, timestamps={}",
+        this, m_peer_maximum_segment_size, m_send_window_scale, m_receive_window_scale, m_sack_enabled, m_timestamps_enabled);
+}
+
+void TCPSocket::process_ack(TCPPacket const& packet, TCPReceivedOptions const& options, size_t payload_size)
+{
+    u32 ack_number = packet.ack_number();
+    auto now = TimeManagement::the().monotonic_time();
+
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
+
+    bool writability_may_have_changed = false;
+    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        size_t bytes_in_flight_before_ack = unacked_packets.bytes_in_flight();
+        u32 acked_bytes = 0;
+        size_t removed = 0;
+        Optional<Duration> round_trip_time;
+
+        while (!unacked_packets.packets.is_empty()) {
+            auto& outgoing_packet = unacked_packets.packets.first();
+
+            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", outgoing_packet.ack_number);
+
+            if (!tcp_sequence_is_before_or_equal(outgoing_packet.ack_number, ack_number))
+                break;
+
+            auto old_adapter = outgoing_packet.adapter.strong_ref();
+            if (old_adapter)
+                old_adapter->release_packet_buffer(*outgoing_packet.buffer);
+
+            // Karn's algorithm: only segments that were sent exactly once give an unambiguous sample.
+            if (outgoing_packet.tx_counter == 0)
+                round_trip_time = now - outgoing_packet.sent_time;
+
+            unacked_packets.size -= outgoing_packet.payload_size;
+            if (outgoing_packet.sacked)
+                unacked_packets.sacked_size -= outgoing_packet.payload_size;
+            if (outgoing_packet.lost)
+                unacked_packets.lost_size -= outgoing_packet.payload_size;
+            acked_bytes += outgoing_packet.payload_size;
+            unacked_packets.packets.take_first();
+            removed++;
+        }
+
+        dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
+
+        // RFC 7323, section 4.1: timestamps give a sample even for retransmitted segments.
+        if (removed > 0 && m_timestamps_enabled && options.timestamp_value.has_value() && options.timestamp_echo_reply != 0)
+            round_trip_time = Duration::from_milliseconds(static_cast<u32>(tcp_timestamp_now() - options.timestamp_echo_reply));
+
+        if (m_sack_enabled)
+            mark_sacked_packets(unacked_packets, options);
+
+        // RFC 7323, section 2.2: the window field in SYN segments is never scaled.
+        auto previous_send_window_size = m_send_window_size;
+        m_send_window_size = static_cast<u32>(packet.window_size()) << (packet.has_syn() ? 0 : m_send_window_scale);
+        if (m_send_window_size > previous_send_window_size)
+            writability_may_have_changed = true;
+
+        bool is_new_loss = false;
+        if (removed > 0) {
+            writability_may_have_changed = true;
+            if (round_trip_time.has_value())
+                update_round_trip_time(round_trip_time.value());
+
+            // RFC 6298, section 5.3: restart the timer whenever new data is acknowledged.
+            m_retransmit_attempts = 0;
+            m_last_retransmit_time = now;
+            m_received_duplicate_acks = 0;
+            m_last_ack_number_received = ack_number;
+
+            m_congestion_control->on_ack(acked_bytes, ack_number, unacked_packets.bytes_in_flight(), now, round_trip_time);
+
+            // RFC 6582, section 3.2, step 3: a partial acknowledgment means the next segment was lost too.
+            if (m_congestion_control->is_in_recovery())
+                mark_lost_packets(unacked_packets, true);
+        } else if (payload_size == 0 && !packet.has_syn() && !packet.has_fin() && !unacked_packets.packets.is_empty() && ack_number == m_last_ack_number_received) {
+            ++m_received_duplicate_acks;
+            if (m_received_duplicate_acks == duplicate_ack_threshold && !m_congestion_control->is_in_recovery()) {
+                // RFC 5681, section 3.2: fast retransmit.
+                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) entering fast recovery at {}", this, ack_number);
+                m_congestion_control->on_enter_fast_recovery(bytes_in_flight_before_ack, m_sequence_number, now);
+                mark_lost_packets(unacked_packets, true);
+                is_new_loss = true;
+            } else if (m_received_duplicate_acks > duplicate_ack_threshold) {
+                m_congestion_control->on_duplicate_ack();
+                mark_lost_packets(unacked_packets, false);
             }
+        }
+
+        if (unacked_packets.lost_size > 0 || is_new_loss) {
+            send_lost_packets(unacked_packets, is_new_loss);
+            writability_may_have_changed = true;
+        }
+
+        if (unacked_packets.packets.is_empty()) {
+            m_retransmit_attempts = 0;
+            dequeue_for_retransmit();
+        }
+    });
+
+    if (writability_may_have_changed)
+        evaluate_block_conditions();
+}
 
-            if (unacked_packets.packets.is_empty()) {
-                m_retransmit_attempts = 0;
-                dequeue_for_retransmit();
+void TCPSocket::mark_sacked_packets(UnackedPackets& unacked_packets, TCPReceivedOptions const& options)
+{
+    for (auto const& block : options.sack_blocks) {
+        for (auto& outgoing_packet : unacked_packets.packets) {
+            if (outgoing_packet.sacked || outgoing_packet.payload_size == 0)
+                continue;
+            if (tcp_sequence_is_before(outgoing_packet.sequence_number, block.left_edge))
+                continue;
+            if (tcp_sequence_is_after(outgoing_packet.ack_number, block.right_edge))
+                break;
+            outgoing_packet.sacked = true;
+            unacked_packets.sacked_size += outgoing_packet.payload_size;
+            if (outgoing_packet.lost) {
+                outgoing_packet.lost = false;
+                unacked_packets.lost_size -= outgoing_packet.payload_size;
             }
+        }
+    }
+}
 
-            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
-        });
+void TCPSocket::mark_lost_packets(UnackedPackets& unacked_packets, bool including_first)
+{
+    auto mark_lost = [&](OutgoingPacket& outgoing_packet) {
+        if (outgoing_packet.sacked || outgoing_packet.lost)
+            return;
+        outgoing_packet.lost = true;
+        unacked_packets.lost_size += outgoing_packet.payload_size;
+    };
+
+    if (including_first && !unacked_packets.packets.is_empty())
+        mark_lost(unacked_packets.packets.first());
+
+    if (!m_sack_enabled || unacked_packets.sacked_size == 0)
+        return;
+
+    // RFC 6675, section 4: a segment that hasn't been SACKed while later ones have is considered lost.
+    // We only do this for segments we haven't resent yet, a resent segment is left to the retransmission timer.
+    size_t last_sacked_index = 0;
+    size_t index = 0;
+    for (auto const& outgoing_packet : unacked_packets.packets) {
+        if (outgoing_packet.sacked)
+            last_sacked_index = index;
+        ++index;
     }
+    index = 0;
+    for (auto& outgoing_packet : unacked_packets.packets) {
+        if (index++ == last_sacked_index)
+            break;
+        if (outgoing_packet.tx_counter == 0)
+            mark_lost(outgoing_packet);
+    }
+}
 
-    m_packets_in++;
-    m_bytes_in += packet.header_size() + size;
+void TCPSocket::send_lost_packets(UnackedPackets& unacked_packets, bool allow_exceeding_window)
+{
+    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
+    auto routing_decision = route_to(peer_address(), local_address(), adapter);
+    if (routing_decision.is_zero())
+        return;
+
+    auto congestion_window = m_congestion_control->congestion_window();
+    for (auto& outgoing_packet : unacked_packets.packets) {
+        if (!outgoing_packet.lost)
+            continue;
+        // A fast retransmit and the first segment after a timeout go out regardless of the window.
+        if (!allow_exceeding_window && unacked_packets.bytes_in_flight() + outgoing_packet.payload_size > congestion_window)
+            break;
+        allow_exceeding_window = false;
+        outgoing_packet.lost = false;
+        unacked_packets.lost_size -= outgoing_packet.payload_size;
+        transmit_outgoing_packet(outgoing_packet, routing_decision);
+    }
+}
+
+size_t TCPSocket::maximum_segment_size_for(NetworkAdapter const& adapter) const
+{
+    size_t mss = min<size_t>(adapter.mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket), m_peer_maximum_segment_size);
+    if (m_timestamps_enabled)
+        mss -= sizeof(TCPOptionTimestamp);
+    return mss;
+}
+
+size_t TCPSocket::send_window_available(UnackedPackets const& unacked_packets) const
+{
+    // Retransmissions take precedence over new data.
+    if (unacked_packets.lost_size > 0)
+        return 0;
+
+    // We don't send zero window probes (RFC 9293, section 3.8.6.1), so always allow a segment's
+    // worth of data into a closed window and let the retransmission timer act as the persist timer.
+    size_t send_window = max<size_t>(m_send_window_size, m_peer_maximum_segment_size);
+    size_t congestion_window = m_congestion_control->congestion_window();
+    if (unacked_packets.size >= send_window || unacked_packets.bytes_in_flight() >= congestion_window)
+        return 0;
+    return min(send_window - unacked_packets.size, congestion_window - unacked_packets.bytes_in_flight());
+}
+
+u16 TCPSocket::advertised_window_size(bool is_syn) const
+{
+    // Every segment takes up room in the receive buffer for its headers too.
+    size_t space = receive_buffer_space();
+    size_t header_overhead = sizeof(IPv4Packet) + 15 * sizeof(u32);
+    space = space > header_overhead ? space - header_overhead : 0;
+    if (!is_syn)
+        space >>= m_receive_window_scale;
+    return min<size_t>(space, NumericLimits<u16>::max());
+}
+
+void TCPSocket::update_round_trip_time(Duration sample)
+{
+    // RFC 6298, section 2
+    i64 sample_ms = sample.to_milliseconds();
+    if (!m_smoothed_round_trip_time.has_value()) {
+        m_smoothed_round_trip_time = sample;
+        m_round_trip_time_variance = Duration::from_milliseconds(sample_ms / 2);
+    } else {
+        i64 smoothed_ms = m_smoothed_round_trip_time->to_milliseconds();
+        i64 difference_ms = smoothed_ms > sample_ms ? smoothed_ms - sample_ms : sample_ms - smoothed_ms;
+        m_round_trip_time_variance = Duration::from_milliseconds((3 * m_round_trip_time_variance.to_milliseconds() + difference_ms) / 4);
+        m_smoothed_round_trip_time = Duration::from_milliseconds((7 * smoothed_ms + sample_ms) / 8);
+    }
+
+    // Our retransmission timer is only checked every 500 milliseconds, so that's our clock granularity.
+    i64 timeout_ms = m_smoothed_round_trip_time->to_milliseconds() + max<i64>(500, 4 * m_round_trip_time_variance.to_milliseconds());
+    m_retransmit_timeout = Duration::from_milliseconds(clamp<i64>(timeout_ms, 1000, 60'000));
+}
+
+void TCPSocket::queue_out_of_order_segment(IPv4Address const& source_address, u16 source_port, ReadonlyBytes raw_ipv4_packet, TCPPacket const& packet, UnixDateTime const& packet_timestamp)
+{
+    u32 sequence_number = packet.sequence_number();
+    u32 payload_size = raw_ipv4_packet.size() - sizeof(IPv4Packet) - packet.header_size();
+    if (payload_size == 0 || m_out_of_order_bytes + payload_size > maximum_out_of_order_bytes)
+        return;
+    if (sequence_number - m_ack_number >= receive_buffer_size)
+        return;
+
+    size_t index = 0;
+    for (; index < m_out_of_order_segments.size(); ++index) {
+        auto const& segment = m_out_of_order_segments[index];
+        if (segment.sequence_number == sequence_number)
+            return;
+        if (tcp_sequence_is_after(segment.sequence_number, sequence_number))
+            break;
+    }
+
+    auto buffer_or_error = KBuffer::try_create_with_bytes("TCPSocket: Out of order segment"sv, raw_ipv4_packet);
+    if (buffer_or_error.is_error()) {
+        dbgln("TCPSocket: Dropped out of order segment because we couldn't allocate a buffer for it");
+        return;
+    }
+    if (m_out_of_order_segments.try_insert(index, { sequence_number, payload_size, source_address, source_port, packet_timestamp, buffer_or_error.release_value() }).is_error()) {
+        dbgln("TCPSocket: Dropped out of order segment because try_insert() failed");
+        return;
+    }
+    m_out_of_order_bytes += payload_size;
+    m_last_out_of_order_sequence_number = sequence_number;
+}
+
+bool TCPSocket::deliver_out_of_order_segments()
+{
+    bool delivered_any = false;
+    while (!m_out_of_order_segments.is_empty()) {
+        auto& segment = m_out_of_order_segments.first();
+        if (tcp_sequence_is_after(segment.sequence_number, m_ack_number))
+            break;
+        // Segments that start before the next expected byte overlap with data we already have, so we drop them.
+        if (segment.sequence_number == m_ack_number) {
+            if (!did_receive(segment.source_address, segment.source_port, segment.raw_ipv4_packet->bytes(), segment.timestamp))
+                break;
+            m_ack_number += segment.payload_size;
+            delivered_any = true;
+        }
+        m_out_of_order_bytes -= segment.payload_size;
+        m_out_of_order_segments.remove(0);
+    }
+    return delivered_any;
+}
+
+Vector<TCPSACKBlock, TCPOptionSACK::maximum_blocks> TCPSocket::sack_blocks_to_send() const
+{
+    // RFC 2018, section 4: the first block must describe the most recently received segment,
+    // the rest describe other contiguous ranges we're holding on to.
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_blocks> blocks;
+    Optional<TCPSACKBlock> most_recent_block;
+    auto add_block = [&](TCPSACKBlock const& block) {
+        if (tcp_sequence_is_before_or_equal(block.left_edge, m_last_out_of_order_sequence_number) && tcp_sequence_is_before(m_last_out_of_order_sequence_number, block.right_edge))
+            most_recent_block = block;
+        else if (blocks.size() < TCPOptionSACK::maximum_blocks - 1)
+            blocks.unchecked_append(block);
+    };
+
+    Optional<TCPSACKBlock> current_block;
+    for (auto const& segment : m_out_of_order_segments) {
+        if (current_block.has_value() && current_block->right_edge == segment.sequence_number) {
+            current_block->right_edge += segment.payload_size;
+            continue;
+        }
+        if (current_block.has_value())
+            add_block(current_block.value());
+        current_block = TCPSACKBlock { segment.sequence_number, segment.sequence_number + segment.payload_size };
+    }
+    if (current_block.has_value())
+        add_block(current_block.value());
+
+    if (most_recent_block.has_value())
+        MUST(blocks.try_insert(0, most_recent_block.release_value()));
+    return blocks;
 }
 
 bool TCPSocket::should_delay_next_ack() const
@@ -603,11 +972,9 @@ void TCPSocket::retransmit_packets()
 
     // RFC6298 says we should have at least one second between retransmits. According to
     // RFC1122 we must do exponential backoff - even for SYN packets.
-    i64 retransmit_interval = 1;
-    for (decltype(m_retransmit_attempts) i = 0; i < m_retransmit_attempts; i++)
-        retransmit_interval *= 2;
+    auto retransmit_interval = Duration::from_milliseconds(m_retransmit_timeout.to_milliseconds() << m_retransmit_attempts);
 
-    if (m_last_retransmit_time > now - Duration::from_seconds(retransmit_interval))
+    if (m_last_retransmit_time > now - retransmit_interval)
         return;
 
     dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) handling retransmit", this);
@@ -622,47 +989,65 @@ void TCPSocket::retransmit_packets()
         return;
     }
 
-    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
-    auto routing_decision = route_to(peer_address(), local_address(), adapter);
-    if (routing_decision.is_zero())
-        return;
-
     m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-        for (auto& packet : unacked_packets.packets) {
-            packet.tx_counter++;
-
-            if constexpr (TCP_SOCKET_DEBUG) {
-                auto& tcp_packet = *(const TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
-                    local_address(), local_port(),
-                    peer_address(), peer_port(),
-                    (tcp_packet.has_syn() ? "SYN " : ""),
-                    (tcp_packet.has_ack() ? "ACK " : ""),
-                    (tcp_packet.has_fin() ? "FIN " : ""),
-                    (tcp_packet.has_rst() ? "RST " : ""),
-                    tcp_packet.sequence_number(),
-                    tcp_packet.ack_number(),
-                    packet.tx_counter);
+        if (unacked_packets.packets.is_empty())
+            return;
+
+        m_congestion_control->on_retransmit_timeout(unacked_packets.bytes_in_flight(), m_sequence_number, now);
+        m_received_duplicate_acks = 0;
+
+        // RFC 6675, section 5.1: after a timeout, everything that hasn't been SACKed is considered lost.
+        // Should a second timeout follow, the peer may have discarded the SACKed data, so we resend that too (RFC 2018, section 8).
+        bool forget_sacks = m_retransmit_attempts > 1;
+        for (auto& outgoing_packet : unacked_packets.packets) {
+            if (outgoing_packet.sacked && forget_sacks) {
+                outgoing_packet.sacked = false;
+                unacked_packets.sacked_size -= outgoing_packet.payload_size;
             }
+            if (outgoing_packet.sacked || outgoing_packet.lost)
+                continue;
+            outgoing_packet.lost = true;
+            unacked_packets.lost_size += outgoing_packet.payload_size;
+        }
 
-            size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
-            if (ipv4_payload_offset != packet.ipv4_payload_offset) {
-                // FIXME: Add support for this. This can happen if after a route change
-                // we ended up on another adapter which doesn't have the same layer 2 type
-                // like the previous adapter.
-                VERIFY_NOT_REACHED();
-            }
+        send_lost_packets(unacked_packets, true);
+    });
+}
 
-            auto packet_buffer = packet.buffer->bytes();
+void TCPSocket::transmit_outgoing_packet(OutgoingPacket& packet, RoutingDecision const& routing_decision)
+{
+    packet.tx_counter++;
+
+    if constexpr (TCP_SOCKET_DEBUG) {
+        auto& tcp_packet = *(const TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+        dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
+            local_address(), local_port(),
+            peer_address(), peer_port(),
+            (tcp_packet.has_syn() ? "SYN " : ""),
+            (tcp_packet.has_ack() ? "ACK " : ""),
+            (tcp_packet.has_fin() ? "FIN " : ""),
+            (tcp_packet.has_rst() ? "RST " : ""),
+            tcp_packet.sequence_number(),
+            tcp_packet.ack_number(),
+            packet.tx_counter);
+    }
 
-            routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
-                local_address(), routing_decision.next_hop, peer_address(),
-                IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
-            routing_decision.adapter->send_packet(packet_buffer);
-            m_packets_out++;
-            m_bytes_out += packet_buffer.size();
-        }
-    });
+    size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
+    if (ipv4_payload_offset != packet.ipv4_payload_offset) {
+        // FIXME: Add support for this. This can happen if after a route change
+        // we ended up on another adapter which doesn't have the same layer 2 type
+        // like the previous adapter.
+        VERIFY_NOT_REACHED();
+    }
+
+    auto packet_buffer = packet.buffer->bytes();
+
+    routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
+        local_address(), routing_decision.next_hop, peer_address(),
+        IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
+    routing_decision.adapter->send_packet(packet_buffer);
+    m_packets_out++;
+    m_bytes_out += packet_buffer.size();
 }
 
 bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size) const
@@ -673,11 +1058,8 @@ bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size)
     if (m_state == State::SynSent || m_state == State::SynReceived)
         return false;
 
-    if (!file_description.is_blocking())
-        return true;
-
     return m_unacked_packets.with_shared([&](auto& unacked_packets) {
-        return unacked_packets.size + size <= m_send_window_size;
+        return send_window_available(unacked_packets) > 0;
     });
 }
 }
@@ -14,6 +14,8 @@
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IPv4Socket.h>
+#include <Kernel/Net/TCP.h>
+#include <Kernel/Net/TCPCongestionControl.h>
 
 namespace Kernel {
 
@@ -140,9 +142,17 @@ public:
     void set_duplicate_acks(u32 acks) { m_duplicate_acks = acks; }
     u32 duplicate_acks() const { return m_duplicate_acks; }
 
+    bool is_sack_enabled() const { return m_sack_enabled; }
+    TCPCongestionControl const& congestion_control() const { return *m_congestion_control; }
+
     ErrorOr<void> send_ack(bool allow_duplicate = false);
     ErrorOr<void> send_tcp_packet(u16 flags, UserOrKernelBuffer const* = nullptr, size_t = 0, RoutingDecision* = nullptr);
     void receive_tcp_packet(TCPPacket const&, u16 size);
+    void process_syn_options(TCPReceivedOptions const&);
+
+    // Segments that arrive ahead of a hole are held back until the hole is filled.
+    void queue_out_of_order_segment(IPv4Address const& source_address, u16 source_port, ReadonlyBytes raw_ipv4_packet, TCPPacket const&, UnixDateTime const& packet_timestamp);
+    bool deliver_out_of_order_segments();
 
     bool should_delay_next_ack() const;
 
@@ -169,7 +179,7 @@ protected:
     void set_direction(Direction direction) { m_direction = direction; }
 
 private:
-    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer);
+    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullOwnPtr<TCPCongestionControl>);
     virtual StringView class_name() const override { return "TCPSocket"sv; }
 
     virtual void shut_down_for_writing() override;
@@ -185,6 +195,11 @@ private:
     void enqueue_for_retransmit();
     void dequeue_for_retransmit();
 
+    size_t maximum_segment_size_for(NetworkAdapter const&) const;
+    u16 advertised_window_size(bool is_syn) const;
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_blocks> sack_blocks_to_send() const;
+    void update_round_trip_time(Duration sample);
+
     LockWeakPtr<TCPSocket> m_originator;
     HashMap<IPv4SocketTuple, NonnullRefPtr<TCPSocket>> m_pending_release_for_accept;
     Direction m_direction { Direction::Unspecified };
@@ -204,17 +219,73 @@ private:
         size_t ipv4_payload_offset;
         LockWeakPtr<NetworkAdapter> adapter;
         int tx_counter { 0 };
+        u32 sequence_number { 0 };
+        u32 payload_size { 0 };
+        MonotonicTime sent_time;
+        // The peer told us it has this segment (RFC 2018).
+        bool sacked { false };
+        // We consider this segment lost and will send it again as soon as the congestion window allows.
+        bool lost { false };
     };
 
     struct UnackedPackets {
         SinglyLinkedList<OutgoingPacket> packets;
         size_t size { 0 };
+        size_t sacked_size { 0 };
+        size_t lost_size { 0 };
+
+        // RFC 6675 calls this the "pipe": data that is still believed to be in the network.
+        size_t bytes_in_flight() const { return size - sacked_size - lost_size; }
     };
 
+    size_t send_window_available(UnackedPackets const&) const;
+    void process_ack(TCPPacket const&, TCPReceivedOptions const&, size_t payload_size);
+    void mark_sacked_packets(UnackedPackets&, TCPReceivedOptions const&);
+    void mark_lost_packets(UnackedPackets&, bool including_first);
+    void send_lost_packets(UnackedPackets&, bool allow_exceeding_window);
+    void transmit_outgoing_packet(OutgoingPacket&, RoutingDecision const&);
+
     MutexProtected<UnackedPackets> m_unacked_packets;
 
     u32 m_duplicate_acks { 0 };
 
+    // Duplicate ACKs received from the peer, as opposed to m_duplicate_acks which counts those we sent.
+    static constexpr u32 duplicate_ack_threshold = 3;
+    u32 m_received_duplicate_acks { 0 };
+    u32 m_last_ack_number_received { 0 };
+
+    NonnullOwnPtr<TCPCongestionControl> m_congestion_control;
+
+    // RFC 9293, section 3.7.1: the MSS to assume when the peer doesn't send the option.
+    static constexpr u16 default_maximum_segment_size = 536;
+
+    // Negotiated in the SYN exchange. We offer everything, and turn off whatever the peer doesn't support.
+    u16 m_peer_maximum_segment_size { default_maximum_segment_size };
+    bool m_window_scaling_enabled { true };
+    u8 m_send_window_scale { 0 };
+    u8 m_receive_window_scale { 0 };
+    bool m_sack_enabled { true };
+    bool m_timestamps_enabled { true };
+    u32 m_timestamp_recent { 0 };
+
+    struct OutOfOrderSegment {
+        u32 sequence_number { 0 };
+        u32 payload_size { 0 };
+        IPv4Address source_address;
+        u16 source_port { 0 };
+        UnixDateTime timestamp;
+        NonnullOwnPtr<KBuffer> raw_ipv4_packet;
+    };
+    static constexpr size_t maximum_out_of_order_bytes = 256 * KiB;
+    Vector<OutOfOrderSegment> m_out_of_order_segments;
+    size_t m_out_of_order_bytes { 0 };
+    u32 m_last_out_of_order_sequence_number { 0 };
+
+    // RFC 6298 round-trip time estimation.
+    Optional<Duration> m_smoothed_round_trip_time;
+    Duration m_round_trip_time_variance;
+    Duration m_retransmit_timeout { Duration::from_seconds(1) };
+
     u32 m_last_ack_number_sent { 0 };
     MonotonicTime m_last_ack_sent_time;
 
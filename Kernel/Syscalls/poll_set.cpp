@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/FileSystem/PollSet.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+static BlockFlags block_flags_for_poll_events(u32 events)
+{
+    BlockFlags block_flags = BlockFlags::WriteError | BlockFlags::WriteHangUp;
+    if (events & POLLIN)
+        block_flags |= BlockFlags::Read;
+    if (events & POLLOUT)
+        block_flags |= BlockFlags::Write;
+    if (events & POLLPRI)
+        block_flags |= BlockFlags::ReadPriority;
+    if (events & POLLWRBAND)
+        block_flags |= BlockFlags::WritePriority;
+    if (events & POLLRDHUP)
+        block_flags |= BlockFlags::ReadHangUp;
+    return block_flags;
+}
+
+static short poll_events_for_block_flags(BlockFlags block_flags)
+{
+    short events = 0;
+    if (has_flag(block_flags, BlockFlags::Read))
+        events |= POLLIN;
+    if (has_flag(block_flags, BlockFlags::Write))
+        events |= POLLOUT;
+    if (has_flag(block_flags, BlockFlags::ReadPriority))
+        events |= POLLPRI;
+    if (has_flag(block_flags, BlockFlags::WritePriority))
+        events |= POLLWRBAND;
+    if (has_flag(block_flags, BlockFlags::ReadHangUp))
+        events |= POLLRDHUP;
+    return events;
+}
+
+static short poll_revents_for_unblocked_flags(BlockFlags unblocked_flags)
+{
+    short revents = 0;
+    if (has_flag(unblocked_flags, BlockFlags::WriteHangUp))
+        revents |= POLLHUP;
+    if (has_flag(unblocked_flags, BlockFlags::WriteError))
+        return revents | POLLERR;
+    if (has_flag(unblocked_flags, BlockFlags::WriteHangUp))
+        unblocked_flags &= ~BlockFlags::Write;
+    return revents | poll_events_for_block_flags(unblocked_flags);
+}
+
+ErrorOr<FlatPtr> Process::sys$create_poll_set(u32 flags)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto poll_set = TRY(PollSet::try_create());
+    auto description = TRY(OpenFileDescription::try_create(move(poll_set)));
+
+    description->set_readable(true);
+    if (flags & POLL_SET_NONBLOCK)
+        description->set_blocking(false);
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        fds[fd_allocation.fd].set(move(description));
+
+        if (flags & POLL_SET_CLOEXEC)
+            fds[fd_allocation.fd].set_flags(fds[fd_allocation.fd].flags() | FD_CLOEXEC);
+
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$poll_set_ctl(int poll_set_fd, int operation, int fd, u32 events)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto poll_set_description = TRY(open_file_description(poll_set_fd));
+    if (!poll_set_description->is_poll_set())
+        return EBADF;
+    auto& poll_set = *poll_set_description->poll_set();
+
+    bool edge_triggered = events & POLLET;
+    switch (operation) {
+    case POLL_SET_ADD: {
+        auto description = TRY(open_file_description(fd));
+        if (description.ptr() == poll_set_description.ptr())
+            return EINVAL;
+        TRY(poll_set.add_watch(fd, *description, block_flags_for_poll_events(events), edge_triggered));
+        return 0;
+    }
+    case POLL_SET_MODIFY: {
+        auto description = TRY(open_file_description(fd));
+        TRY(poll_set.modify_watch(fd, *description, block_flags_for_poll_events(events), edge_triggered));
+        return 0;
+    }
+    case POLL_SET_REMOVE:
+        TRY(poll_set.remove_watch(fd));
+        return 0;
+    default:
+        return EINVAL;
+    }
+}
+
+ErrorOr<FlatPtr> Process::sys$poll_set_wait(Userspace<Syscall::SC_poll_set_wait_params const*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto params = TRY(copy_typed_from_user(user_params));
+    if (params.max_ready == 0 || params.max_ready > OpenFileDescriptions::max_open())
+        return EINVAL;
+
+    auto description = TRY(open_file_description(params.poll_set_fd));
+    if (!description->is_poll_set())
+        return EBADF;
+    auto& poll_set = *description->poll_set();
+
+    Thread::BlockTimeout timeout;
+    bool should_block = description->is_blocking();
+    if (params.timeout) {
+        auto timeout_time = TRY(copy_time_from_user(params.timeout));
+        if (timeout_time.is_zero())
+            should_block = false;
+        timeout = Thread::BlockTimeout(false, &timeout_time);
+    }
+
+    Vector<PollSet::ReadyEntry> entries;
+    for (;;) {
+        TRY(poll_set.collect_ready_entries(entries, params.max_ready));
+        if (!entries.is_empty() || !should_block)
+            break;
+
+        auto unblock_flags = BlockFlags::None;
+        auto result = Thread::current()->block<Thread::ReadBlocker>(timeout, *description, unblock_flags);
+        if (result.was_interrupted())
+            return EINTR;
+        if (result == Thread::BlockResult::InterruptedByTimeout)
+            should_block = false;
+    }
+
+    Vector<pollfd, 32> ready;
+    TRY(ready.try_ensure_capacity(entries.size()));
+    for (auto& entry : entries)
+        ready.unchecked_append({ entry.fd, poll_events_for_block_flags(entry.flags), poll_revents_for_unblocked_flags(entry.unblocked_flags) });
+
+    if (!ready.is_empty())
+        TRY(copy_n_to_user(params.ready, ready.data(), ready.size()));
+    return ready.size();
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Library/KBuffer.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+// Large enough to fill a socket's send window in a couple of iterations,
+// small enough that every sendfile() call can afford its own buffer.
+static constexpr size_t sendfile_chunk_size = 64 * KiB;
+
+ErrorOr<FlatPtr> Process::sys$sendfile(int out_fd, int in_fd, Userspace<off_t*> user_offset, size_t count)
+{
+    // NOTE: This goes through the same read and write paths as sys$read() and sys$write(), which still rely on the big lock.
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    if (count > NumericLimits<ssize_t>::max())
+        return EINVAL;
+
+    auto in_description = TRY(open_file_description(in_fd));
+    auto out_description = TRY(open_file_description(out_fd));
+    if (!in_description->is_readable() || !out_description->is_writable())
+        return EBADF;
+
+    // Only regular files can be read at arbitrary offsets without consuming anything.
+    auto* inode = in_description->inode();
+    if (!inode || !inode->metadata().is_regular_file())
+        return EINVAL;
+
+    off_t start_offset;
+    if (user_offset) {
+        TRY(copy_from_user(&start_offset, user_offset));
+        if (start_offset < 0)
+            return EINVAL;
+    } else {
+        start_offset = in_description->offset();
+    }
+
+    if (count == 0)
+        return 0;
+
+    // NOTE: This is not zero-copy. Each chunk is read from the file into a kernel buffer, just like read() would,
+    //       and the output file then copies it into its own buffers (e.g. a socket's outgoing packets).
+    //       What we save is copying the data out to userspace and back in again.
+    auto chunk_buffer = TRY(KBuffer::try_create_with_size("sendfile"sv, min(count, sendfile_chunk_size)));
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(chunk_buffer->data());
+
+    size_t total_sent = 0;
+    Optional<Error> error;
+    while (total_sent < count) {
+        auto chunk_size = min(count - total_sent, chunk_buffer->size());
+        auto nread_or_error = in_description->read(kernel_buffer, start_offset + total_sent, chunk_size);
+        if (nread_or_error.is_error()) {
+            error = nread_or_error.release_error();
+            break;
+        }
+        auto nread = nread_or_error.release_value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = do_write(*out_description, kernel_buffer, nread);
+        if (nwritten_or_error.is_error()) {
+            error = nwritten_or_error.release_error();
+            break;
+        }
+        auto nwritten = nwritten_or_error.release_value();
+        total_sent += nwritten;
+        // A short write means the output would block (or hit its end), so report what we have.
+        if (nwritten < nread)
+            break;
+    }
+
+    if (total_sent == 0 && error.has_value())
+        return error.release_value();
+
+    off_t end_offset = start_offset + total_sent;
+    if (user_offset)
+        TRY(copy_to_user(user_offset, &end_offset));
+    else
+        TRY(in_description->seek(end_offset, SEEK_SET));
+
+    return total_sent;
+}
+
+}
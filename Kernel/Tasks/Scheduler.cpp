@@ -5,6 +5,7 @@
  */
 
 #include <AK/BuiltinWrappers.h>
+#include <AK/NumericLimits.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Singleton.h>
 #include <AK/Time.h>
@@ -44,9 +45,25 @@ struct ThreadReadyQueues {
     u32 mask {};
     static constexpr size_t count = sizeof(mask) * 8;
     Array<ThreadReadyQueue, count> queues;
+
+    Thread* first_runnable_thread(u32 affinity_mask);
+    void append(Thread&, u32 priority);
+    void remove(Thread&);
 };
 
-static Singleton<SpinlockProtected<ThreadReadyQueues, LockRank::None>> g_ready_queues;
+// Every processor owns its own set of ready queues. Picking the next thread only
+// has to look at the queues of the processor doing the picking, and processors
+// that run out of work steal runnable threads from their busiest peers.
+using ProcessorReadyQueues = SpinlockProtected<ThreadReadyQueues, LockRank::None>;
+static Singleton<Array<ProcessorReadyQueues, MAX_CPU_COUNT>> g_ready_queues;
+
+// Number of threads in each processor's ready queues. This is only used as a hint
+// for placement and work stealing, so it is read without holding the queue lock.
+static Array<Atomic<u32, AK::MemoryOrder::memory_order_relaxed>, MAX_CPU_COUNT> s_ready_thread_counts;
+
+// How many more threads the processor a thread last ran on may have queued than the
+// least loaded processor before we give up on its warm caches and migrate the thread.
+static constexpr u32 migration_imbalance_threshold = 1;
 
 static SpinlockProtected<TotalTimeScheduled, LockRank::None> g_total_time_scheduled {};
 
@@ -64,74 +81,198 @@ static inline u32 thread_priority_to_priority_index(u32 thread_priority)
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+static inline u32 scheduling_processor_count()
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    // NOTE: Processor::count() is not maintained on every architecture yet, so make sure we
+    //       always consider at least the bootstrap processor.
+    return clamp(Processor::count(), 1u, static_cast<u32>(MAX_CPU_COUNT));
+}
+
+Thread* ThreadReadyQueues::first_runnable_thread(u32 affinity_mask)
+{
+    auto priority_mask = mask;
+    while (priority_mask != 0) {
+        auto priority = bit_scan_forward(priority_mask);
+        VERIFY(priority > 0);
+        auto& ready_queue = queues[--priority];
+        for (auto& thread : ready_queue.thread_list) {
+            VERIFY(thread.m_runnable_priority == (int)priority);
+            if (thread.is_active())
+                continue;
+            if (!(thread.affinity() & affinity_mask))
+                continue;
+            return &thread;
+        }
+        priority_mask &= ~(1u << priority);
+    }
+    return nullptr;
+}
+
+void ThreadReadyQueues::append(Thread& thread, u32 priority)
+{
+    VERIFY(thread.m_runnable_priority < 0);
+    thread.m_runnable_priority = (int)priority;
+    VERIFY(!thread.m_ready_queue_node.is_in_list());
+    auto& ready_queue = queues[priority];
+    bool was_empty = ready_queue.thread_list.is_empty();
+    ready_queue.thread_list.append(thread);
+    if (was_empty)
+        mask |= (1u << priority);
+    s_ready_thread_counts[thread.m_runnable_cpu]++;
+}
+
+void ThreadReadyQueues::remove(Thread& thread)
+{
+    auto priority = thread.m_runnable_priority;
+    VERIFY(priority >= 0);
+    VERIFY(mask & (1u << priority));
+    auto& ready_queue = queues[priority];
+    thread.m_runnable_priority = -1;
+    ready_queue.thread_list.remove(thread);
+    if (ready_queue.thread_list.is_empty())
+        mask &= ~(1u << priority);
+    s_ready_thread_counts[thread.m_runnable_cpu]--;
+}
+
+static u32 select_processor_for(Thread const& thread)
+{
+    auto processor_count = scheduling_processor_count();
+    auto affinity = thread.affinity();
+
+    u32 least_loaded_cpu = NumericLimits<u32>::max();
+    u32 least_load = NumericLimits<u32>::max();
+    for (u32 cpu = 0; cpu < processor_count; ++cpu) {
+        if (!(affinity & (1u << cpu)))
+            continue;
+        auto load = s_ready_thread_counts[cpu].load();
+        if (load < least_load) {
+            least_load = load;
+            least_loaded_cpu = cpu;
+        }
+    }
+
+    // The affinity mask doesn't allow any online processor. The thread will never
+    // be picked, but it still needs a home.
+    if (least_loaded_cpu == NumericLimits<u32>::max())
+        return Processor::current_id();
+
+    // Prefer the processor the thread last ran on, as its caches are most likely still
+    // warm, unless that processor is noticeably busier than the least loaded one.
+    auto last_cpu = thread.cpu();
+    if (last_cpu < processor_count && (affinity & (1u << last_cpu))) {
+        if (s_ready_thread_counts[last_cpu].load() <= least_load + migration_imbalance_threshold)
+            return last_cpu;
+    }
+    return least_loaded_cpu;
+}
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread& {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                thread.m_runnable_priority = -1;
-                ready_queue.thread_list.remove(thread);
-                if (ready_queue.thread_list.is_empty())
-                    ready_queues.mask &= ~(1u << priority);
-                // Mark it as active because we are using this thread. This is similar
-                // to comparing it with Processor::current_thread, but when there are
-                // multiple processors there's no easy way to check whether the thread
-                // is actually still needed. This prevents accidental finalization when
-                // a thread is no longer in Running state, but running on another core.
-
-                // We need to mark it active here so that this thread won't be
-                // scheduled on another core if it were to be queued before actually
-                // switching to it.
-                // FIXME: Figure out a better way maybe?
-                thread.set_active(true);
-                return thread;
+// Iterates over all other processors that have threads queued, busiest first.
+template<typename Callback>
+static void for_each_steal_victim(u32 current_cpu, Callback callback)
+{
+    auto processor_count = scheduling_processor_count();
+    u64 tried_mask = 1ull << current_cpu;
+    for (;;) {
+        u32 victim = NumericLimits<u32>::max();
+        u32 victim_load = 0;
+        for (u32 cpu = 0; cpu < processor_count; ++cpu) {
+            if (tried_mask & (1ull << cpu))
+                continue;
+            auto load = s_ready_thread_counts[cpu].load();
+            if (load > victim_load) {
+                victim_load = load;
+                victim = cpu;
             }
-            priority_mask &= ~(1u << priority);
         }
+        if (victim == NumericLimits<u32>::max())
+            return;
+        tried_mask |= 1ull << victim;
+        if (callback(victim) == IterationDecision::Break)
+            return;
+    }
+}
 
-        auto* idle_thread = Processor::idle_thread();
-        idle_thread->set_active(true);
-        return *idle_thread;
+static Thread* take_runnable_thread(u32 cpu)
+{
+    auto affinity_mask = 1u << Processor::current_id();
+    return g_ready_queues->at(cpu).with([&](auto& ready_queues) -> Thread* {
+        auto* thread = ready_queues.first_runnable_thread(affinity_mask);
+        if (!thread)
+            return nullptr;
+        ready_queues.remove(*thread);
+        // Mark it as active because we are using this thread. This is similar
+        // to comparing it with Processor::current_thread, but when there are
+        // multiple processors there's no easy way to check whether the thread
+        // is actually still needed. This prevents accidental finalization when
+        // a thread is no longer in Running state, but running on another core.
+
+        // We need to mark it active here so that this thread won't be
+        // scheduled on another core if it were to be queued before actually
+        // switching to it.
+        // FIXME: Figure out a better way maybe?
+        thread->set_active(true);
+        return thread;
     });
 }
 
+Thread& Scheduler::pull_next_runnable_thread(Thread* local_thread)
+{
+    VERIFY(g_scheduler_lock.is_locked_by_current_processor());
+    auto current_cpu = Processor::current_id();
+
+    // The thread from our own queues was taken before we acquired the scheduler lock,
+    // so it may have been stopped or killed in the meantime. Its state change couldn't
+    // dequeue it, so drop it here and let the next state change requeue it.
+    if (local_thread) {
+        if (local_thread->state() == Thread::State::Runnable)
+            return *local_thread;
+        local_thread->set_active(false);
+        if (local_thread->state() == Thread::State::Dying)
+            notify_finalizer();
+    }
+
+    if (auto* thread = take_runnable_thread(current_cpu))
+        return *thread;
+
+    Thread* stolen_thread = nullptr;
+    for_each_steal_victim(current_cpu, [&](u32 victim) {
+        stolen_thread = take_runnable_thread(victim);
+        if (!stolen_thread)
+            return IterationDecision::Continue;
+        dbgln_if(SCHEDULER_DEBUG, "Scheduler[{}]: Stole {} from processor {}", current_cpu, *stolen_thread, victim);
+        return IterationDecision::Break;
+    });
+    if (stolen_thread)
+        return *stolen_thread;
+
+    auto* idle_thread = Processor::idle_thread();
+    idle_thread->set_active(true);
+    return *idle_thread;
+}
+
 Thread* Scheduler::peek_next_runnable_thread()
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    auto current_cpu = Processor::current_id();
+    auto affinity_mask = 1u << current_cpu;
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread* {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                return &thread;
-            }
-            priority_mask &= ~(1u << priority);
-        }
+    auto peek_runnable_thread = [&](u32 cpu) -> Thread* {
+        return g_ready_queues->at(cpu).with([&](auto& ready_queues) {
+            return ready_queues.first_runnable_thread(affinity_mask);
+        });
+    };
+
+    if (auto* thread = peek_runnable_thread(current_cpu))
+        return thread;
 
-        // Unlike in pull_next_runnable_thread() we don't want to fall back to
-        // the idle thread. We just want to see if we have any other thread ready
-        // to be scheduled.
-        return nullptr;
+    // Unlike in pull_next_runnable_thread() we don't want to fall back to
+    // the idle thread. We just want to see if we have any other thread ready
+    // to be scheduled, which includes threads we could steal.
+    Thread* thread_to_steal = nullptr;
+    for_each_steal_victim(current_cpu, [&](u32 victim) {
+        thread_to_steal = peek_runnable_thread(victim);
+        return thread_to_steal ? IterationDecision::Break : IterationDecision::Continue;
     });
+    return thread_to_steal;
 }
 
 bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
@@ -139,9 +280,11 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
     if (thread.is_idle_thread())
         return true;
 
-    return g_ready_queues->with([&](auto& ready_queues) {
-        auto priority = thread.m_runnable_priority;
-        if (priority < 0) {
+    // NOTE: m_runnable_cpu only changes while holding g_scheduler_lock, so it
+    //       is safe to look up the queue before taking its lock.
+    VERIFY(g_scheduler_lock.is_locked_by_current_processor());
+    return g_ready_queues->at(thread.m_runnable_cpu).with([&](auto& ready_queues) {
+        if (thread.m_runnable_priority < 0) {
             VERIFY(!thread.m_ready_queue_node.is_in_list());
             return false;
         }
@@ -149,12 +292,7 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
         if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
             return false;
 
-        VERIFY(ready_queues.mask & (1u << priority));
-        auto& ready_queue = ready_queues.queues[priority];
-        thread.m_runnable_priority = -1;
-        ready_queue.thread_list.remove(thread);
-        if (ready_queue.thread_list.is_empty())
-            ready_queues.mask &= ~(1u << priority);
+        ready_queues.remove(thread);
         return true;
     });
 }
@@ -165,16 +303,11 @@ void Scheduler::enqueue_runnable_thread(Thread& thread)
     if (thread.is_idle_thread())
         return;
     auto priority = thread_priority_to_priority_index(thread.priority());
+    auto cpu = select_processor_for(thread);
 
-    g_ready_queues->with([&](auto& ready_queues) {
-        VERIFY(thread.m_runnable_priority < 0);
-        thread.m_runnable_priority = (int)priority;
-        VERIFY(!thread.m_ready_queue_node.is_in_list());
-        auto& ready_queue = ready_queues.queues[priority];
-        bool was_empty = ready_queue.thread_list.is_empty();
-        ready_queue.thread_list.append(thread);
-        if (was_empty)
-            ready_queues.mask |= (1u << priority);
+    g_ready_queues->at(cpu).with([&](auto& ready_queues) {
+        thread.m_runnable_cpu = cpu;
+        ready_queues.append(thread, priority);
     });
 }
 
@@ -217,13 +350,19 @@ void Scheduler::pick_next()
             Processor::set_current_in_scheduler(false);
         });
 
+    // Taking a thread off our own ready queues only needs their lock, so we do that before
+    // acquiring the scheduler lock to keep the queue scan out of it. The scheduler lock is
+    // still needed to steal from other processors, and for the context switch itself, as it
+    // protects the thread state transitions.
+    auto* local_thread = take_runnable_thread(Processor::current_id());
+
     SpinlockLocker lock(g_scheduler_lock);
 
     if constexpr (SCHEDULER_RUNNABLE_DEBUG) {
         dump_thread_list();
     }
 
-    auto& thread_to_schedule = pull_next_runnable_thread();
+    auto& thread_to_schedule = pull_next_runnable_thread(local_thread);
     if constexpr (SCHEDULER_DEBUG) {
         dbgln("Scheduler[{}]: Switch to {} @ {:p}",
             Processor::current_id(),
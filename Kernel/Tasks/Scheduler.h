@@ -47,7 +47,7 @@ public:
     static void idle_loop(void*);
     static void invoke_async();
     static void notify_finalizer();
-    static Thread& pull_next_runnable_thread();
+    static Thread& pull_next_runnable_thread(Thread* local_thread);
     static Thread* peek_next_runnable_thread();
     static bool dequeue_runnable_thread(Thread&, bool = false);
     static void enqueue_runnable_thread(Thread&);
@@ -61,6 +61,7 @@ class Thread
     friend class Process;
     friend class Scheduler;
     friend struct ThreadReadyQueue;
+    friend struct ThreadReadyQueues;
 
 public:
     static Thread* current()
@@ -205,7 +206,11 @@ public:
         virtual bool setup_blocker();
         virtual void finalize();
 
-        Thread& thread() { return m_thread; }
+        Thread& thread()
+        {
+            VERIFY(m_thread);
+            return *m_thread;
+        }
 
         enum class UnblockImmediatelyReason {
             UnblockConditionAlreadyMet,
@@ -257,6 +262,13 @@ public:
         {
         }
 
+        // For blockers that are only added to a BlockerSet to get notified of changes, and never block a thread.
+        // Those can outlive the thread that created them, so they don't keep it alive.
+        struct NotifyOnlyTag { };
+        explicit Blocker(NotifyOnlyTag)
+        {
+        }
+
         void do_set_interrupted_by_death()
         {
             m_was_interrupted_by_death = true;
@@ -298,7 +310,7 @@ public:
 
     private:
         BlockerSet* m_blocker_set { nullptr };
-        NonnullRefPtr<Thread> const m_thread;
+        RefPtr<Thread> const m_thread;
         u8 m_was_interrupted_by_signal { 0 };
         bool m_is_blocking { false };
         bool m_was_interrupted_by_death { false };
@@ -509,6 +521,13 @@ public:
         virtual Type blocker_type() const override { return Type::File; }
 
         virtual bool unblock_if_conditions_are_met(bool, void*) = 0;
+
+    protected:
+        FileBlocker() = default;
+        explicit FileBlocker(NotifyOnlyTag tag)
+            : Blocker(tag)
+        {
+        }
     };
 
     class OpenFileDescriptionBlocker : public FileBlocker {
@@ -1093,6 +1112,7 @@ private:
 
     IntrusiveListNode<Thread> m_process_thread_list_node;
     int m_runnable_priority { -1 };
+    u32 m_runnable_cpu { 0 };
 
     friend class WaitQueue;
 
@@ -393,6 +393,9 @@
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump All Resolved Styles"
                                                 action:@selector(dumpAllResolvedStyles:)
                                          keyEquivalent:@""]];
+    [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Style Recalc Statistics"
+                                                action:@selector(dumpStyleRecalcStatistics:)
+                                         keyEquivalent:@""]];
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump History"
                                                 action:@selector(dumpHistory:)
                                          keyEquivalent:@""]];
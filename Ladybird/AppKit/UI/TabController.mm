@@ -283,6 +283,11 @@ enum class IsHistoryNavigation {
     [self debugRequest:"dump-all-resolved-styles" argument:""];
 }
 
+- (void)dumpStyleRecalcStatistics:(id)sender
+{
+    [self debugRequest:"dump-style-recalc-statistics" argument:""];
+}
+
 - (void)dumpHistory:(id)sender
 {
     [self debugRequest:"dump-history" argument:""];
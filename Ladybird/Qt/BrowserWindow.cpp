@@ -41,11 +41,12 @@ static QIcon const& app_icon()
     return icon;
 }
 
-BrowserWindow::BrowserWindow(Vector<URL> const& initial_urls, WebView::CookieJar& cookie_jar, StringView webdriver_content_ipc_path, WebView::EnableCallgrindProfiling enable_callgrind_profiling, UseLagomNetworking use_lagom_networking)
+BrowserWindow::BrowserWindow(Vector<URL> const& initial_urls, WebView::CookieJar& cookie_jar, StringView webdriver_content_ipc_path, WebView::EnableCallgrindProfiling enable_callgrind_profiling, UseLagomNetworking use_lagom_networking, StringView bytecode_cache_directory)
     : m_cookie_jar(cookie_jar)
     , m_webdriver_content_ipc_path(webdriver_content_ipc_path)
     , m_enable_callgrind_profiling(enable_callgrind_profiling)
     , m_use_lagom_networking(use_lagom_networking)
+    , m_bytecode_cache_directory(bytecode_cache_directory)
 {
     setWindowIcon(app_icon());
     m_tabs_container = new QTabWidget(this);
@@ -244,6 +245,13 @@ BrowserWindow::BrowserWindow(Vector<URL> const& initial_urls, WebView::CookieJar
         debug_request("dump-all-resolved-styles");
     });
 
+    auto* dump_style_recalc_statistics_action = new QAction("Dump Style &Recalc Statistics", this);
+    dump_style_recalc_statistics_action->setIcon(QIcon(QString("%1/res/icons/16x16/filetype-css.png").arg(s_serenity_resource_root.characters())));
+    debug_menu->addAction(dump_style_recalc_statistics_action);
+    QObject::connect(dump_style_recalc_statistics_action, &QAction::triggered, this, [this] {
+        debug_request("dump-style-recalc-statistics");
+    });
+
     auto* dump_history_action = new QAction("Dump &History", this);
     dump_history_action->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_H));
     dump_history_action->setIcon(QIcon(QString("%1/res/icons/16x16/history.png").arg(s_serenity_resource_root.characters())));
@@ -462,7 +470,7 @@ Tab& BrowserWindow::new_tab(StringView html, Web::HTML::ActivateTab activate_tab
 
 Tab& BrowserWindow::create_new_tab(Web::HTML::ActivateTab activate_tab)
 {
-    auto tab = make<Tab>(this, m_webdriver_content_ipc_path, m_enable_callgrind_profiling, m_use_lagom_networking);
+    auto tab = make<Tab>(this, m_webdriver_content_ipc_path, m_enable_callgrind_profiling, m_use_lagom_networking, m_bytecode_cache_directory);
     auto tab_ptr = tab.ptr();
     m_tabs.append(std::move(tab));
 
@@ -42,7 +42,7 @@ class WebContentView final
     , public WebView::ViewImplementation {
     Q_OBJECT
 public:
-    explicit WebContentView(StringView webdriver_content_ipc_path, WebView::EnableCallgrindProfiling, UseLagomNetworking);
+    explicit WebContentView(StringView webdriver_content_ipc_path, WebView::EnableCallgrindProfiling, UseLagomNetworking, StringView bytecode_cache_directory);
     virtual ~WebContentView() override;
 
     Function<String(const AK::URL&, Web::HTML::ActivateTab)> on_tab_open_request;
@@ -97,6 +97,7 @@ private:
     Gfx::IntRect m_viewport_rect;
 
     StringView m_webdriver_content_ipc_path;
+    StringView m_bytecode_cache_directory;
 };
 
 }
@@ -11,11 +11,13 @@
 #include <Ladybird/Utilities.h>
 #include <LibAudio/Loader.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/Directory.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/System.h>
 #include <LibCore/SystemServerTakeover.h>
 #include <LibIPC/ConnectionFromClient.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibMain/Main.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -73,13 +75,20 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     int webcontent_fd_passing_socket { -1 };
     bool is_layout_test_mode = false;
     bool use_lagom_networking = false;
+    StringView bytecode_cache_directory;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(webcontent_fd_passing_socket, "File descriptor of the passing socket for the WebContent connection", "webcontent-fd-passing-socket", 'c', "webcontent_fd_passing_socket");
     args_parser.add_option(is_layout_test_mode, "Is layout test mode", "layout-test-mode", 0);
     args_parser.add_option(use_lagom_networking, "Enable Lagom servers for networking", "use-lagom-networking", 0);
+    args_parser.add_option(bytecode_cache_directory, "Cache generated JavaScript bytecode in this directory", "bytecode-cache", 0, "directory");
     args_parser.parse(arguments);
 
+    if (!bytecode_cache_directory.is_empty()) {
+        (void)TRY(Core::Directory::create(bytecode_cache_directory, Core::Directory::CreateDirectories::Yes));
+        JS::Bytecode::ExecutableCache::set_directory(bytecode_cache_directory);
+    }
+
 #if defined(HAVE_QT)
     if (!use_lagom_networking) {
         Web::ResourceLoader::initialize(Ladybird::RequestManagerQt::create());
@@ -183,6 +183,7 @@ set(TERMCAP_DEBUG ON)
 set(TERMINAL_DEBUG ON)
 set(TEXTEDITOR_DEBUG ON)
 set(THREAD_DEBUG ON)
+set(TILED_PAINTING_DEBUG ON)
 set(TIME_ZONE_DEBUG ON)
 set(TLS_DEBUG ON)
 set(TLS_SSL_KEYLOG_DEBUG ON)
@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+
+# Times the control flow kernels from Meta/generate-libwasm-control-flow-kernels.py with the wasm utility,
+# and prints the fastest of several runs of each kernel.
+
+set -eo pipefail
+
+if [ $# -lt 1 ] || [ $# -gt 2 ]; then
+    echo "Usage: $0 <path to the wasm utility> [runs]"
+    exit 1
+fi
+
+WASM="$1"
+RUNS="${2:-5}"
+
+script_path=$(cd -P -- "$(dirname -- "$0")" && pwd -P)
+KERNELS="${script_path}/../Userland/Libraries/LibWasm/Tests/Fixtures/Modules/control-flow.wasm"
+
+kernels=(
+    "fib 25"
+    "loop_sum 1000000"
+    "sieve 100000"
+    "dispatch 1000000"
+    "branch_out_of_if_else 2000"
+    "harmonic 1000000"
+)
+
+for kernel in "${kernels[@]}"; do
+    read -r name argument <<< "${kernel}"
+    best=""
+    for _ in $(seq "${RUNS}"); do
+        start=$(date +%s%N)
+        "${WASM}" --execute "${name}" --arg "${argument}" "${KERNELS}" > /dev/null 2>&1
+        end=$(date +%s%N)
+        elapsed=$(( (end - start) / 1000000 ))
+        if [ -z "${best}" ] || [ "${elapsed}" -lt "${best}" ]; then
+            best="${elapsed}"
+        fi
+    done
+    printf "%-24s %10s %6d ms\n" "${name}" "${argument}" "${best}"
+done
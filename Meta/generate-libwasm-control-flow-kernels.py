@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+# Generates the control flow kernels that LibWasm's interpreter tests and benchmarks run:
+#   - control-flow.wasm, with calls, nested blocks, loops, if/else, br, br_if, br_table and return.
+#   - block-type-index.wasm, with a block whose type is given by a type index.
+# Run Meta/benchmark-libwasm-kernels.sh to time them with the wasm utility.
+
+import struct
+from argparse import ArgumentParser
+from os import path
+
+I32, F64 = 0x7f, 0x7c
+EMPTY_BLOCK_TYPE = 0x40
+
+OPCODES = {
+    'block': 0x02, 'loop': 0x03, 'if': 0x04, 'else': 0x05, 'end': 0x0b,
+    'br': 0x0c, 'br_if': 0x0d, 'br_table': 0x0e, 'return': 0x0f, 'call': 0x10,
+    'local.get': 0x20, 'local.set': 0x21,
+    'i32.load8_u': 0x2d, 'i32.store8': 0x3a,
+    'i32.const': 0x41, 'f64.const': 0x44,
+    'i32.eqz': 0x45, 'i32.eq': 0x46, 'i32.lt_s': 0x48, 'i32.ge_u': 0x4f,
+    'i32.add': 0x6a, 'i32.sub': 0x6b, 'i32.mul': 0x6c, 'i32.rem_u': 0x70, 'i32.and': 0x71, 'i32.xor': 0x73,
+    'f64.add': 0xa0, 'f64.mul': 0xa2, 'f64.div': 0xa3,
+    'i32.trunc_f64_s': 0xaa, 'f64.convert_i32_s': 0xb7,
+}
+
+# Function types: (i32) -> i32 and (i32, i32) -> i32.
+TYPES = [([I32], [I32]), ([I32, I32], [I32])]
+UNARY_TYPE_INDEX = 0
+
+
+def uleb(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value == 0:
+            out.append(byte)
+            return bytes(out)
+        out.append(byte | 0x80)
+
+
+def sleb(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if (value == 0 and not byte & 0x40) or (value == -1 and byte & 0x40):
+            out.append(byte)
+            return bytes(out)
+        out.append(byte | 0x80)
+
+
+def vector(items):
+    return uleb(len(items)) + b''.join(items)
+
+
+def section(section_id, payload):
+    return bytes([section_id]) + uleb(len(payload)) + payload
+
+
+def encode(*instructions):
+    out = bytearray()
+    for instruction in instructions:
+        if isinstance(instruction, str):
+            instruction = (instruction,)
+        opcode, *immediates = instruction
+        out.append(OPCODES[opcode])
+        if opcode in ('block', 'loop', 'if'):
+            block_type = immediates[0] if immediates else EMPTY_BLOCK_TYPE
+            if isinstance(block_type, tuple):
+                # ('type', index)
+                out += sleb(block_type[1])
+            else:
+                out.append(block_type)
+        elif opcode in ('br', 'br_if', 'call', 'local.get', 'local.set'):
+            out += uleb(immediates[0])
+        elif opcode == 'br_table':
+            out += vector([uleb(label) for label in immediates[0]]) + uleb(immediates[1])
+        elif opcode == 'i32.const':
+            out += sleb(immediates[0])
+        elif opcode == 'f64.const':
+            out += struct.pack('<d', immediates[0])
+        elif opcode in ('i32.load8_u', 'i32.store8'):
+            # Alignment and offset.
+            out += uleb(0) + uleb(0)
+    return bytes(out)
+
+
+def module(functions, exports, memory_pages=None):
+    # functions: list of (type index, [(count, type)] locals, body)
+    out = b'\0asm' + struct.pack('<I', 1)
+    out += section(1, vector([b'\x60' + vector([bytes([parameter]) for parameter in parameters])
+                              + vector([bytes([result]) for result in results]) for parameters, results in TYPES]))
+    out += section(3, vector([uleb(type_index) for type_index, _, _ in functions]))
+    if memory_pages is not None:
+        out += section(5, vector([b'\x00' + uleb(memory_pages)]))
+    out += section(7, vector([uleb(len(name)) + name.encode() + b'\x00' + uleb(index) for name, index in exports]))
+    bodies = []
+    for _, locals_, body in functions:
+        encoded = vector([uleb(count) + bytes([local_type]) for count, local_type in locals_]) + body + b'\x0b'
+        bodies.append(uleb(len(encoded)) + encoded)
+    out += section(10, vector(bodies))
+    return out
+
+
+def get(index):
+    return ('local.get', index)
+
+
+def put(index):
+    return ('local.set', index)
+
+
+def const(value):
+    return ('i32.const', value)
+
+
+# fib(n): Naive recursion.
+fib = encode(
+    get(0), const(2), 'i32.lt_s', ('if', I32),
+    get(0),
+    'else',
+    get(0), const(1), 'i32.sub', ('call', 0), get(0), const(2), 'i32.sub', ('call', 0), 'i32.add',
+    'end')
+
+# loop_sum(n): A tight loop with br_if and br.
+loop_sum = encode(
+    'block', 'loop',
+    get(1), get(0), 'i32.ge_u', ('br_if', 1),
+    get(2), get(1), get(1), 'i32.mul', get(1), 'i32.xor', 'i32.add', put(2),
+    get(1), const(1), 'i32.add', put(1), ('br', 0),
+    'end', 'end', get(2))
+
+# sieve(n): Counts the primes below n with nested loops and memory accesses.
+sieve = encode(
+    const(0), put(1),
+    'block', 'loop',
+    get(1), get(0), 'i32.ge_u', ('br_if', 1),
+    get(1), const(0), 'i32.store8',
+    get(1), const(1), 'i32.add', put(1), ('br', 0),
+    'end', 'end',
+    const(2), put(1),
+    'block', 'loop',
+    get(1), get(0), 'i32.ge_u', ('br_if', 1),
+    get(1), 'i32.load8_u', 'i32.eqz', 'if',
+    get(3), const(1), 'i32.add', put(3),
+    get(1), get(1), 'i32.add', put(2),
+    'block', 'loop',
+    get(2), get(0), 'i32.ge_u', ('br_if', 1),
+    get(2), const(1), 'i32.store8',
+    get(2), get(1), 'i32.add', put(2), ('br', 0),
+    'end', 'end',
+    'end',
+    get(1), const(1), 'i32.add', put(1), ('br', 0),
+    'end', 'end', get(3))
+
+# dispatch(n): A br_table out of nested blocks on every iteration.
+dispatch = encode(
+    'block', 'loop',
+    get(1), get(0), 'i32.ge_u', ('br_if', 1),
+    'block', 'block', 'block', 'block', 'block',
+    get(2), const(3), 'i32.and', ('br_table', [0, 1, 2], 3),
+    'end', get(3), const(1), 'i32.add', put(3), ('br', 3),
+    'end', get(3), const(3), 'i32.mul', put(3), ('br', 2),
+    'end', get(3), get(1), 'i32.xor', put(3), ('br', 1),
+    'end', get(3), const(7), 'i32.sub', put(3),
+    'end',
+    get(2), const(1), 'i32.add', get(3), const(1), 'i32.and', 'i32.add', put(2),
+    get(1), const(1), 'i32.add', put(1), ('br', 0),
+    'end', 'end', get(3))
+
+
+# Branches out of a block with a result, out of an if/else, and returns from inside a loop.
+# With a type index, the block takes its operand as a parameter instead of pushing it itself.
+def branch_out_of_if_else(block_takes_a_parameter):
+    if block_takes_a_parameter:
+        block_start = [get(2), ('block', ('type', UNARY_TYPE_INDEX))]
+    else:
+        block_start = [('block', I32), get(2)]
+    return encode(
+        'block', 'loop',
+        get(1), get(0), 'i32.ge_u', ('br_if', 1),
+        *block_start, const(3), 'i32.add', get(1), const(1), 'i32.and', ('br_if', 0), const(5), 'i32.mul', 'end', put(2),
+        get(1), const(3), 'i32.rem_u', 'i32.eqz', ('if', I32), const(10), ('br', 0), 'else', const(20), 'end',
+        get(2), 'i32.add', put(2),
+        get(1), const(1000), 'i32.eq', 'if', get(2), 'return', 'end',
+        get(1), const(1), 'i32.add', put(1), ('br', 0),
+        'end', 'end', get(2), const(1), 'i32.add')
+
+
+# harmonic(n): Floating point arithmetic, returns 1000 times the nth harmonic number.
+harmonic = encode(
+    'block', 'loop',
+    get(1), get(0), 'i32.ge_u', ('br_if', 1),
+    get(2), ('f64.const', 1.0), get(1), const(1), 'i32.add', 'f64.convert_i32_s', 'f64.div', 'f64.add', put(2),
+    get(1), const(1), 'i32.add', put(1), ('br', 0),
+    'end', 'end', get(2), ('f64.const', 1000.0), 'f64.mul', 'i32.trunc_f64_s')
+
+
+def main():
+    parser = ArgumentParser(description='Generate the LibWasm control flow kernels')
+    default_output = path.join(path.dirname(__file__), '..', 'Userland', 'Libraries', 'LibWasm', 'Tests', 'Fixtures',
+                               'Modules')
+    parser.add_argument('output_directory', nargs='?', default=default_output)
+    args = parser.parse_args()
+
+    functions = [
+        (UNARY_TYPE_INDEX, [], fib),
+        (UNARY_TYPE_INDEX, [(2, I32)], loop_sum),
+        (UNARY_TYPE_INDEX, [(3, I32)], sieve),
+        (UNARY_TYPE_INDEX, [(3, I32)], dispatch),
+        (UNARY_TYPE_INDEX, [(2, I32)], branch_out_of_if_else(False)),
+        (UNARY_TYPE_INDEX, [(1, I32), (1, F64)], harmonic),
+    ]
+    exports = [('fib', 0), ('loop_sum', 1), ('sieve', 2), ('dispatch', 3), ('branch_out_of_if_else', 4),
+               ('harmonic', 5)]
+    with open(path.join(args.output_directory, 'control-flow.wasm'), 'wb') as file:
+        file.write(module(functions, exports, memory_pages=2))
+
+    functions = [(UNARY_TYPE_INDEX, [(2, I32)], branch_out_of_if_else(True))]
+    with open(path.join(args.output_directory, 'block-type-index.wasm'), 'wb') as file:
+        file.write(module(functions, [('block_params', 0)]))
+
+
+if __name__ == '__main__':
+    main()
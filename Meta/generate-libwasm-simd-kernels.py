@@ -0,0 +1,600 @@
+#!/usr/bin/env python3
+# Generates the v128 modules that LibWasm's interpreter tests and benchmarks run:
+#   - simd-operators.wasm, with one function per v128 operator (named after the opcode) that applies it to
+#     constant operands. Vector results are stored at address 0 and read back through the exported `byte`.
+#   - simd-benchmark.wasm, with small kernels in both vector and scalar form, which must agree.
+# Pass --expectations to print the expected results that Tests/Interpreter/test-simd.js checks against.
+
+import json
+import math
+import re
+import struct
+from argparse import ArgumentParser
+from os import path
+
+I32, I64, F32, F64, V128 = 0x7f, 0x7e, 0x7d, 0x7c, 0x7b
+EMPTY_BLOCK_TYPE = 0x40
+
+OPCODES = {
+    'block': 0x02, 'loop': 0x03, 'end': 0x0b, 'br': 0x0c, 'br_if': 0x0d,
+    'select': 0x1b, 'local.get': 0x20, 'local.set': 0x21, 'local.tee': 0x22,
+    'f32.load': 0x2a, 'i32.load8_u': 0x2d, 'f32.store': 0x38, 'i32.store8': 0x3a,
+    'i32.const': 0x41, 'i64.const': 0x42, 'f32.const': 0x43, 'f64.const': 0x44,
+    'i32.lt_u': 0x49, 'i32.ge_u': 0x4f,
+    'i32.add': 0x6a, 'i32.mul': 0x6c, 'i32.rem_u': 0x70, 'i32.shr_u': 0x76,
+    'f32.add': 0x92, 'f32.mul': 0x94,
+    'i32.trunc_f32_s': 0xa8, 'f32.convert_i32_s': 0xb2,
+}
+
+SIMD_PREFIX = 0xfd
+
+
+def read_simd_opcodes():
+    # The v128 opcodes are numerous enough that we take them from LibWasm itself rather than repeating them here.
+    opcode_header = path.join(path.dirname(__file__), '..', 'Userland', 'Libraries', 'LibWasm', 'Opcode.h')
+    with open(opcode_header) as file:
+        return {name: int(value, 16) for name, value in re.findall(r'M\((\w+), 0xfd([0-9a-f]+)ull\)', file.read())}
+
+
+SIMD_OPCODES = read_simd_opcodes()
+
+
+def uleb(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value == 0:
+            out.append(byte)
+            return bytes(out)
+        out.append(byte | 0x80)
+
+
+def sleb(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if (value == 0 and not byte & 0x40) or (value == -1 and byte & 0x40):
+            out.append(byte)
+            return bytes(out)
+        out.append(byte | 0x80)
+
+
+def vector(items):
+    return uleb(len(items)) + b''.join(items)
+
+
+def section(section_id, payload):
+    return bytes([section_id]) + uleb(len(payload)) + payload
+
+
+def memarg(offset=0, alignment=0):
+    return uleb(alignment) + uleb(offset)
+
+
+def simd(opcode, *immediates):
+    return bytes([SIMD_PREFIX]) + uleb(SIMD_OPCODES[opcode]) + b''.join(immediates)
+
+
+def v128_const(value):
+    assert len(value) == 16
+    return simd('v128_const', bytes(value))
+
+
+def encode(*instructions):
+    out = bytearray()
+    for instruction in instructions:
+        # v128 instructions are encoded by simd() already.
+        if isinstance(instruction, bytes):
+            out += instruction
+            continue
+        if isinstance(instruction, str):
+            instruction = (instruction,)
+        opcode, *immediates = instruction
+        out.append(OPCODES[opcode])
+        if opcode in ('block', 'loop'):
+            out.append(EMPTY_BLOCK_TYPE)
+        elif opcode in ('br', 'br_if', 'local.get', 'local.set', 'local.tee'):
+            out += uleb(immediates[0])
+        elif opcode in ('i32.const', 'i64.const'):
+            out += sleb(immediates[0])
+        elif opcode == 'f32.const':
+            out += struct.pack('<f', immediates[0])
+        elif opcode == 'f64.const':
+            out += struct.pack('<d', immediates[0])
+        elif opcode in ('f32.load', 'i32.load8_u', 'f32.store', 'i32.store8'):
+            # Alignment and offset.
+            out += uleb(immediates[0]) + uleb(immediates[1])
+    return bytes(out)
+
+
+def module(types, functions, exports):
+    # functions: list of (type index, [(count, type)] locals, body)
+    out = b'\0asm' + struct.pack('<I', 1)
+    out += section(1, vector([b'\x60' + vector([bytes([parameter]) for parameter in parameters])
+                              + vector([bytes([result]) for result in results]) for parameters, results in types]))
+    out += section(3, vector([uleb(type_index) for type_index, _, _ in functions]))
+    out += section(5, vector([b'\x00' + uleb(1)]))
+    out += section(7, vector([uleb(len(name)) + name.encode() + b'\x00' + uleb(index) for name, index in exports]))
+    bodies = []
+    for _, locals_, body in functions:
+        encoded = vector([uleb(count) + bytes([local_type]) for count, local_type in locals_]) + body + b'\x0b'
+        bodies.append(uleb(len(encoded)) + encoded)
+    out += section(10, vector(bodies))
+    return out
+
+
+# Lanes are described by struct format characters, keyed by the lane type of the operator names.
+LANE_FORMATS = {
+    'i8': 'b', 'u8': 'B', 'i16': 'h', 'u16': 'H', 'i32': 'i', 'u32': 'I', 'i64': 'q', 'u64': 'Q',
+    'f32': 'f', 'f64': 'd',
+}
+
+
+def pack(lane_type, lanes):
+    return struct.pack('<%d%s' % (len(lanes), LANE_FORMATS[lane_type]), *lanes)
+
+
+def unpack(lane_type, value):
+    lane_format = LANE_FORMATS[lane_type]
+    return list(struct.unpack('<%d%s' % (16 // struct.calcsize(lane_format), lane_format), value))
+
+
+def lane_bits(lane_type):
+    return int(lane_type[1:])
+
+
+def unsigned(lane_type):
+    return 'u' + lane_type[1:]
+
+
+def lane_type_of(shape):
+    return shape[:shape.index('x')]
+
+
+def wrap(lane_type, value):
+    bits = lane_bits(lane_type)
+    value &= (1 << bits) - 1
+    if lane_type[0] == 'i' and value >> (bits - 1):
+        value -= 1 << bits
+    return value
+
+
+def saturate(lane_type, value):
+    bits = lane_bits(lane_type)
+    if lane_type[0] == 'i':
+        low, high = -(1 << (bits - 1)), (1 << (bits - 1)) - 1
+    else:
+        low, high = 0, (1 << bits) - 1
+    return max(low, min(high, value))
+
+
+def round_to_f32(value):
+    return struct.unpack('<f', struct.pack('<f', value))[0]
+
+
+def all_ones_if(condition):
+    return -1 if condition else 0
+
+
+def lanewise(lane_type, operation, *operands, result_type=None):
+    lanes = [unpack(lane_type, operand) for operand in operands]
+    return pack(result_type or lane_type, [operation(*lane) for lane in zip(*lanes)])
+
+
+# The operands are picked to hit the interesting cases of each operator: sign boundaries, saturation and NaN.
+I8_A = pack('i8', [0, 1, -1, 127, -128, 100, -100, 50, 2, -2, 3, 64, -64, 10, 20, 30])
+I8_B = pack('i8', [0, -1, 1, 1, -1, 100, -100, -50, 16, 15, 31, -56, 5, 0, -20, 30])
+I16_A = pack('i16', [0, 1, -1, 32767, -32768, 1000, -1000, 20000])
+I16_B = pack('i16', [0, -1, 1, 1, -1, 30000, -30000, 20000])
+I32_A = pack('i32', [0, -1, 2147483647, -2147483648])
+I32_B = pack('i32', [5, -1, 1, -1])
+I64_A = pack('i64', [-1, 1 << 62])
+I64_B = pack('i64', [1, -(1 << 63)])
+F32_A = pack('f32', [1.5, -2.5, 0.5, 16.0])
+F32_B = pack('f32', [2.0, -0.25, 3.0, -16.0])
+F32_WITH_NAN = pack('f32', [float('nan'), 1.0, -1.0, 2.0])
+F64_A = pack('f64', [2.25, -2.5])
+F64_B = pack('f64', [0.25, 4.0])
+F32_TO_ROUND = pack('f32', [2.5, -2.5, 0.5, -1.75])
+F64_TO_ROUND = pack('f64', [2.5, -1.5])
+F32_TO_TRUNCATE = pack('f32', [float('nan'), 3e9, -3e9, -1.75])
+F64_TO_TRUNCATE = pack('f64', [5e9, -7.9])
+BITSELECT_MASK = pack('u64', [0xff00ff00ff00ff00, 0x0f0f0f0f0f0f0f0f])
+DOT_MINIMUM = pack('i16', [-32768] * 8)
+SWIZZLE_INDICES = pack('u8', [15, 0, 16, 255, 3, 3, 7, 1, 128, 14, 2, 5, 31, 9, 10, 4])
+SHUFFLE_INDICES = [0, 16, 1, 17, 31, 15, 8, 24, 2, 2, 2, 2, 30, 29, 28, 27]
+
+COMPARISONS = {
+    'eq': lambda x, y: x == y, 'ne': lambda x, y: x != y, 'lt': lambda x, y: x < y,
+    'gt': lambda x, y: x > y, 'le': lambda x, y: x <= y, 'ge': lambda x, y: x >= y,
+}
+
+
+def binary_operator_tests():
+    # (operator, first operand, second operand, expected result)
+    tests = []
+
+    def lanewise_test(operator, lane_type, operation, a, b, result_type=None):
+        tests.append((operator, a, b, lanewise(lane_type, operation, a, b, result_type=result_type)))
+
+    for shape, a, b in [('i8x16', I8_A, I8_B), ('i16x8', I16_A, I16_B), ('i32x4', I32_A, I32_B)]:
+        lane_type = lane_type_of(shape)
+        for comparison, compare in COMPARISONS.items():
+            if comparison in ('eq', 'ne'):
+                lanewise_test(f'{shape}_{comparison}', lane_type, lambda x, y, f=compare: all_ones_if(f(x, y)), a, b)
+                continue
+            lanewise_test(f'{shape}_{comparison}_s', lane_type, lambda x, y, f=compare: all_ones_if(f(x, y)), a, b)
+            all_ones = (1 << lane_bits(lane_type)) - 1
+            lanewise_test(f'{shape}_{comparison}_u', unsigned(lane_type),
+                          lambda x, y, f=compare, all_ones=all_ones: all_ones if f(x, y) else 0, a, b)
+    for comparison, compare in COMPARISONS.items():
+        operator = f'i64x2_{comparison}' if comparison in ('eq', 'ne') else f'i64x2_{comparison}_s'
+        lanewise_test(operator, 'i64', lambda x, y, f=compare: all_ones_if(f(x, y)), I64_A, I64_B)
+    for shape, a, b in [('f32x4', F32_WITH_NAN, F32_A), ('f64x2', F64_A, F64_B)]:
+        lane_type = lane_type_of(shape)
+        for comparison, compare in COMPARISONS.items():
+            lanewise_test(f'{shape}_{comparison}', lane_type, lambda x, y, f=compare: all_ones_if(f(x, y)), a, b,
+                          result_type='i' + lane_type[1:])
+
+    for shape, a, b in [('i8x16', I8_A, I8_B), ('i16x8', I16_A, I16_B), ('i32x4', I32_A, I32_B),
+                        ('i64x2', I64_A, I64_B)]:
+        lane_type = lane_type_of(shape)
+        unsigned_type = unsigned(lane_type)
+        lanewise_test(f'{shape}_add', lane_type, lambda x, y, t=lane_type: wrap(t, x + y), a, b)
+        lanewise_test(f'{shape}_sub', lane_type, lambda x, y, t=lane_type: wrap(t, x - y), a, b)
+        if shape != 'i8x16':
+            lanewise_test(f'{shape}_mul', lane_type, lambda x, y, t=lane_type: wrap(t, x * y), a, b)
+        if shape in ('i8x16', 'i16x8'):
+            lanewise_test(f'{shape}_add_sat_s', lane_type, lambda x, y, t=lane_type: saturate(t, x + y), a, b)
+            lanewise_test(f'{shape}_add_sat_u', unsigned_type, lambda x, y, t=unsigned_type: saturate(t, x + y), a, b)
+            lanewise_test(f'{shape}_sub_sat_s', lane_type, lambda x, y, t=lane_type: saturate(t, x - y), a, b)
+            lanewise_test(f'{shape}_sub_sat_u', unsigned_type, lambda x, y, t=unsigned_type: saturate(t, x - y), a, b)
+            lanewise_test(f'{shape}_avgr_u', unsigned_type, lambda x, y: (x + y + 1) // 2, a, b)
+        if shape != 'i64x2':
+            lanewise_test(f'{shape}_min_s', lane_type, min, a, b)
+            lanewise_test(f'{shape}_min_u', unsigned_type, min, a, b)
+            lanewise_test(f'{shape}_max_s', lane_type, max, a, b)
+            lanewise_test(f'{shape}_max_u', unsigned_type, max, a, b)
+
+    lanewise_test('v128_and', 'u64', lambda x, y: x & y, I8_A, I8_B)
+    lanewise_test('v128_andnot', 'u64', lambda x, y: x & ~y & (2**64 - 1), I8_A, I8_B)
+    lanewise_test('v128_or', 'u64', lambda x, y: x | y, I8_A, I8_B)
+    lanewise_test('v128_xor', 'u64', lambda x, y: x ^ y, I8_A, I8_B)
+
+    def narrow(a, b, lane_type, result_type):
+        return pack(result_type, [saturate(result_type, x) for x in unpack(lane_type, a) + unpack(lane_type, b)])
+
+    tests.append(('i8x16_narrow_i16x8_s', I16_A, I16_B, narrow(I16_A, I16_B, 'i16', 'i8')))
+    tests.append(('i8x16_narrow_i16x8_u', I16_A, I16_B, narrow(I16_A, I16_B, 'i16', 'u8')))
+    tests.append(('i16x8_narrow_i32x4_s', I32_A, I32_B, narrow(I32_A, I32_B, 'i32', 'i16')))
+    tests.append(('i16x8_narrow_i32x4_u', I32_A, I32_B, narrow(I32_A, I32_B, 'i32', 'u16')))
+    tests.append(('i16x8_q15mulr_sat_s', I16_A, I16_B,
+                  lanewise('i16', lambda x, y: saturate('i16', (x * y + 0x4000) >> 15), I16_A, I16_B)))
+
+    def dot(a, b):
+        x, y = unpack('i16', a), unpack('i16', b)
+        return pack('i32', [wrap('i32', x[2 * i] * y[2 * i] + x[2 * i + 1] * y[2 * i + 1]) for i in range(4)])
+
+    tests.append(('i32x4_dot_i16x8_s', I16_A, I16_B, dot(I16_A, I16_B)))
+    tests.append(('i32x4_dot_i16x8_s', DOT_MINIMUM, DOT_MINIMUM, dot(DOT_MINIMUM, DOT_MINIMUM)))
+
+    def extmul(a, b, lane_type, result_type, high):
+        x, y = unpack(lane_type, a), unpack(lane_type, b)
+        count = len(x) // 2
+        first = count if high else 0
+        return pack(result_type, [x[first + i] * y[first + i] for i in range(count)])
+
+    for shape, lane_type, a, b in [('i16x8', 'i8', I8_A, I8_B), ('i32x4', 'i16', I16_A, I16_B),
+                                   ('i64x2', 'i32', I32_A, I32_B)]:
+        result_type = lane_type_of(shape)
+        source_shape = f'{lane_type}x{128 // lane_bits(lane_type)}'
+        for half in ('low', 'high'):
+            high = half == 'high'
+            tests.append((f'{shape}_extmul_{half}_{source_shape}_s', a, b, extmul(a, b, lane_type, result_type, high)))
+            tests.append((f'{shape}_extmul_{half}_{source_shape}_u', a, b,
+                          extmul(a, b, unsigned(lane_type), unsigned(result_type), high)))
+
+    tests.append(('i8x16_swizzle', I8_A, SWIZZLE_INDICES, bytes(I8_A[i] if i < 16 else 0 for i in SWIZZLE_INDICES)))
+
+    for shape, a, b in [('f32x4', F32_A, F32_B), ('f64x2', F64_A, F64_B)]:
+        lane_type = lane_type_of(shape)
+        rounded = round_to_f32 if lane_type == 'f32' else (lambda value: value)
+        lanewise_test(f'{shape}_add', lane_type, lambda x, y, r=rounded: r(x + y), a, b)
+        lanewise_test(f'{shape}_sub', lane_type, lambda x, y, r=rounded: r(x - y), a, b)
+        lanewise_test(f'{shape}_mul', lane_type, lambda x, y, r=rounded: r(x * y), a, b)
+        lanewise_test(f'{shape}_div', lane_type, lambda x, y, r=rounded: r(x / y), a, b)
+        lanewise_test(f'{shape}_min', lane_type, min, a, b)
+        lanewise_test(f'{shape}_max', lane_type, max, a, b)
+        lanewise_test(f'{shape}_pmin', lane_type, lambda x, y: y if y < x else x, a, b)
+        lanewise_test(f'{shape}_pmax', lane_type, lambda x, y: y if x < y else x, a, b)
+    return tests
+
+
+def truncate_saturating(value, result_type):
+    if value != value:
+        return 0
+    if abs(value) == float('inf'):
+        return saturate(result_type, int(math.copysign(1 << 70, value)))
+    return saturate(result_type, math.trunc(value))
+
+
+def unary_operator_tests():
+    # (operator, operand, expected result)
+    tests = []
+
+    def lanewise_test(operator, lane_type, operation, a):
+        tests.append((operator, a, lanewise(lane_type, operation, a)))
+
+    for shape, a in [('i8x16', I8_A), ('i16x8', I16_A), ('i32x4', I32_A), ('i64x2', I64_A)]:
+        lane_type = lane_type_of(shape)
+        lanewise_test(f'{shape}_abs', lane_type, lambda x, t=lane_type: wrap(t, abs(x)), a)
+        lanewise_test(f'{shape}_neg', lane_type, lambda x, t=lane_type: wrap(t, -x), a)
+    lanewise_test('i8x16_popcnt', 'u8', lambda x: bin(x).count('1'), I8_A)
+    lanewise_test('v128_not', 'u64', lambda x: ~x & (2**64 - 1), I8_A)
+
+    def extend(a, lane_type, result_type, high):
+        lanes = unpack(lane_type, a)
+        count = len(lanes) // 2
+        first = count if high else 0
+        return pack(result_type, lanes[first:first + count])
+
+    def extadd(a, lane_type, result_type):
+        lanes = unpack(lane_type, a)
+        return pack(result_type, [lanes[2 * i] + lanes[2 * i + 1] for i in range(len(lanes) // 2)])
+
+    for shape, lane_type, a in [('i16x8', 'i8', I8_A), ('i32x4', 'i16', I16_A), ('i64x2', 'i32', I32_A)]:
+        result_type = lane_type_of(shape)
+        source_shape = f'{lane_type}x{128 // lane_bits(lane_type)}'
+        for half in ('low', 'high'):
+            high = half == 'high'
+            tests.append((f'{shape}_extend_{half}_{source_shape}_s', a, extend(a, lane_type, result_type, high)))
+            tests.append((f'{shape}_extend_{half}_{source_shape}_u', a,
+                          extend(a, unsigned(lane_type), unsigned(result_type), high)))
+        if shape != 'i64x2':
+            tests.append((f'{shape}_extadd_pairwise_{source_shape}_s', a, extadd(a, lane_type, result_type)))
+            tests.append((f'{shape}_extadd_pairwise_{source_shape}_u', a,
+                          extadd(a, unsigned(lane_type), unsigned(result_type))))
+
+    for shape, a, to_round in [('f32x4', F32_B, F32_TO_ROUND), ('f64x2', F64_A, F64_TO_ROUND)]:
+        lane_type = lane_type_of(shape)
+        lanewise_test(f'{shape}_abs', lane_type, abs, a)
+        lanewise_test(f'{shape}_neg', lane_type, lambda x: -x, a)
+        lanewise_test(f'{shape}_sqrt', lane_type, lambda x: math.sqrt(abs(x)),
+                      pack(lane_type, [abs(x) for x in unpack(lane_type, a)]))
+        lanewise_test(f'{shape}_ceil', lane_type, math.ceil, to_round)
+        lanewise_test(f'{shape}_floor', lane_type, math.floor, to_round)
+        lanewise_test(f'{shape}_trunc', lane_type, math.trunc, to_round)
+        # Python rounds halfway cases to even, just like wasm's nearest.
+        lanewise_test(f'{shape}_nearest', lane_type, round, to_round)
+
+    def truncated(lane_type, a, result_type, lane_count=None):
+        lanes = [truncate_saturating(x, result_type) for x in unpack(lane_type, a)]
+        return pack(result_type, lanes + [0] * ((lane_count or len(lanes)) - len(lanes)))
+
+    tests.append(('i32x4_trunc_sat_f32x4_s', F32_TO_TRUNCATE, truncated('f32', F32_TO_TRUNCATE, 'i32')))
+    tests.append(('i32x4_trunc_sat_f32x4_u', F32_TO_TRUNCATE, truncated('f32', F32_TO_TRUNCATE, 'u32')))
+    tests.append(('i32x4_trunc_sat_f64x2_s_zero', F64_TO_TRUNCATE, truncated('f64', F64_TO_TRUNCATE, 'i32', 4)))
+    tests.append(('i32x4_trunc_sat_f64x2_u_zero', F64_TO_TRUNCATE, truncated('f64', F64_TO_TRUNCATE, 'u32', 4)))
+    tests.append(('f32x4_convert_i32x4_s', I32_A, pack('f32', [float(x) for x in unpack('i32', I32_A)])))
+    tests.append(('f32x4_convert_i32x4_u', I32_A, pack('f32', [float(x) for x in unpack('u32', I32_A)])))
+    tests.append(('f64x2_convert_low_i32x4_s', I32_A, pack('f64', [float(x) for x in unpack('i32', I32_A)[:2]])))
+    tests.append(('f64x2_convert_low_i32x4_u', I32_A, pack('f64', [float(x) for x in unpack('u32', I32_A)[:2]])))
+    tests.append(('f32x4_demote_f64x2_zero', F64_A, pack('f32', unpack('f64', F64_A) + [0.0, 0.0])))
+    tests.append(('f64x2_promote_low_f32x4', F32_A, pack('f64', unpack('f32', F32_A)[:2])))
+    return tests
+
+
+def other_vector_tests():
+    # Operators with immediates or more than two operands. (operator, body, expected result)
+    shuffled = bytes((I8_A + I8_B)[i] for i in SHUFFLE_INDICES)
+    selected = bytes((x & m) | (y & ~m & 0xff) for x, y, m in zip(I8_A, I8_B, BITSELECT_MASK))
+    return [
+        ('i8x16_shuffle', [v128_const(I8_A), v128_const(I8_B), simd('i8x16_shuffle', bytes(SHUFFLE_INDICES))],
+         shuffled),
+        ('v128_bitselect', [v128_const(I8_A), v128_const(I8_B), v128_const(BITSELECT_MASK), simd('v128_bitselect')],
+         selected),
+        ('i8x16_replace_lane', [v128_const(I8_A), ('i32.const', 0x1234), simd('i8x16_replace_lane', bytes([5]))],
+         I8_A[:5] + b'\x34' + I8_A[6:]),
+        ('i64x2_replace_lane', [v128_const(I64_A), ('i64.const', -5), simd('i64x2_replace_lane', bytes([1]))],
+         I64_A[:8] + pack('i64', [-5, 0])[:8]),
+        ('i16x8_splat', [('i32.const', 0x12345), simd('i16x8_splat')], pack('i16', [0x2345] * 8)),
+        ('i8x16_shr_s', [v128_const(I8_A), ('i32.const', 9), simd('i8x16_shr_s')],
+         pack('i8', [x >> 1 for x in unpack('i8', I8_A)])),
+    ]
+
+
+def scalar_result_tests():
+    # Operators that produce an i32. (operator, body, expected result)
+    tests = []
+    for shape, a in [('i8x16', I8_A), ('i16x8', I16_A), ('i32x4', I32_A), ('i64x2', I64_A)]:
+        lane_type = lane_type_of(shape)
+        lanes = unpack(lane_type, a)
+        tests.append((f'{shape}_bitmask', [v128_const(a), simd(f'{shape}_bitmask')],
+                      sum(1 << i for i, x in enumerate(lanes) if x < 0)))
+        tests.append((f'{shape}_all_true', [v128_const(a), simd(f'{shape}_all_true')], int(all(lanes))))
+        no_zero_lanes = pack(lane_type, [x or 1 for x in lanes])
+        tests.append((f'{shape}_all_true', [v128_const(no_zero_lanes), simd(f'{shape}_all_true')], 1))
+    tests.append(('v128_any_true', [v128_const(bytes(16)), simd('v128_any_true')], 0))
+    tests.append(('v128_any_true', [v128_const(bytes(15) + b'\x80'), simd('v128_any_true')], 1))
+    for shape, a, lane in [('i8x16', I8_A, 4), ('i16x8', I16_A, 4)]:
+        lane_type = lane_type_of(shape)
+        tests.append((f'{shape}_extract_lane_s', [v128_const(a), simd(f'{shape}_extract_lane_s', bytes([lane]))],
+                      unpack(lane_type, a)[lane]))
+        tests.append((f'{shape}_extract_lane_u', [v128_const(a), simd(f'{shape}_extract_lane_u', bytes([lane]))],
+                      unpack(unsigned(lane_type), a)[lane]))
+    tests.append(('i32x4_extract_lane', [v128_const(I32_A), simd('i32x4_extract_lane', bytes([3]))],
+                  unpack('i32', I32_A)[3]))
+    return tests
+
+
+def operators_module():
+    # Types: () -> (), () -> i32 and (i32) -> i32.
+    types = [([], []), ([], [I32]), ([I32], [I32])]
+    functions, exports, expectations = [], [], []
+
+    def add_test(operator, body, expected, returns_i32):
+        index = len(functions)
+        if returns_i32:
+            functions.append((1, [], encode(*body)))
+        else:
+            functions.append((0, [], encode(('i32.const', 0), *body, simd('v128_store', memarg()))))
+        # Operators that are tested more than once get a numbered export for each additional test.
+        export = operator
+        suffix = 2
+        while any(name == export for name, _ in exports):
+            export = f'{operator}_{suffix}'
+            suffix += 1
+        exports.append((export, index))
+        expectations.append((export, expected if returns_i32 else list(expected)))
+
+    for operator, a, b, expected in binary_operator_tests():
+        add_test(operator, [v128_const(a), v128_const(b), simd(operator)], expected, False)
+    for operator, a, expected in unary_operator_tests():
+        add_test(operator, [v128_const(a), simd(operator)], expected, False)
+    for operator, body, expected in other_vector_tests():
+        add_test(operator, body, expected, False)
+    for operator, body, expected in scalar_result_tests():
+        add_test(operator, body, expected, True)
+
+    # byte(i): Reads back a byte of the result.
+    functions.append((2, [], encode(('local.get', 0), ('i32.load8_u', 0, 0))))
+    exports.append(('byte', len(functions) - 1))
+    return module(types, functions, exports), expectations
+
+
+def get(index):
+    return ('local.get', index)
+
+
+def put(index):
+    return ('local.set', index)
+
+
+def tee(index):
+    return ('local.tee', index)
+
+
+def const(value):
+    return ('i32.const', value)
+
+
+# Every kernel takes the number of iterations as local 0. Locals 1, 2 and 3 are the iteration,
+# the offset into memory and the accumulator.
+def for_each_iteration(*body):
+    return [const(0), put(1), 'block', 'loop', get(1), get(0), 'i32.ge_u', ('br_if', 1),
+            *body,
+            get(1), const(1), 'i32.add', put(1), ('br', 0), 'end', 'end']
+
+
+def for_each_offset(step, end, *body):
+    return [const(0), put(2), 'block', 'loop', get(2), const(end), 'i32.ge_u', ('br_if', 1),
+            *body,
+            get(2), const(step), 'i32.add', put(2), ('br', 0), 'end', 'end']
+
+
+# memory[i] = i * 37 + 11 for the first 2048 bytes.
+def fill_bytes():
+    return for_each_offset(1, 2048, get(2), get(2), const(37), 'i32.mul', const(11), 'i32.add', ('i32.store8', 0, 0))
+
+
+# 256 floats at 4096, f[i] = (i % 17) * 0.25.
+def fill_floats():
+    return for_each_offset(1, 256, get(2), const(4), 'i32.mul', get(2), const(17), 'i32.rem_u', 'f32.convert_i32_s',
+                           ('f32.const', 0.25), 'f32.mul', ('f32.store', 2, 4096))
+
+
+def sum_of_lanes(index, lane_type, add):
+    extract_lane = f'{lane_type}_extract_lane'
+    return [get(index), simd(extract_lane, b'\x00'), get(index), simd(extract_lane, b'\x01'), add,
+            get(index), simd(extract_lane, b'\x02'), add, get(index), simd(extract_lane, b'\x03'), add]
+
+
+# blend(n): r = avgr_u(add_sat_u(a, b), min_u(a, b)) over 1024 bytes, a is overwritten with r and the sum of r is
+# accumulated. Extra locals: 4 = a, 5 = b, 6 = r (v128).
+blend = encode(
+    *fill_bytes(), *for_each_iteration(*for_each_offset(
+        16, 1024,
+        get(2), simd('v128_load', memarg()), put(4),
+        get(2), simd('v128_load', memarg(1024)), put(5),
+        get(2),
+        get(4), get(5), simd('i8x16_add_sat_u'), get(4), get(5), simd('i8x16_min_u'), simd('i8x16_avgr_u'), tee(6),
+        simd('v128_store', memarg()),
+        get(3), get(6), simd('i16x8_extadd_pairwise_i8x16_u'), simd('i32x4_extadd_pairwise_i16x8_u'),
+        simd('i32x4_add'), put(3))),
+    *sum_of_lanes(3, 'i32x4', 'i32.add'))
+
+# blend_scalar(n): The same computation, one byte at a time. Extra locals: 4 = a, 5 = b, 6 = r.
+blend_scalar = encode(
+    *fill_bytes(), *for_each_iteration(*for_each_offset(
+        1, 1024,
+        get(2), ('i32.load8_u', 0, 0), put(4),
+        get(2), ('i32.load8_u', 0, 1024), put(5),
+        get(2),
+        get(4), get(5), 'i32.add', tee(6), const(255), get(6), const(255), 'i32.lt_u', 'select',
+        get(4), get(5), get(4), get(5), 'i32.lt_u', 'select',
+        'i32.add', const(1), 'i32.add', const(1), 'i32.shr_u', tee(6),
+        ('i32.store8', 0, 0),
+        get(3), get(6), 'i32.add', put(3))),
+    get(3))
+
+# sum_squares(n): The sum of f[i] * f[i] over the floats, n times. Extra locals: 4 = f (v128).
+sum_squares = encode(
+    *fill_floats(), *for_each_iteration(*for_each_offset(
+        16, 1024,
+        get(3), get(2), simd('v128_load', memarg(4096)), tee(4), get(4), simd('f32x4_mul'), simd('f32x4_add'),
+        put(3))),
+    *sum_of_lanes(3, 'f32x4', 'f32.add'), 'i32.trunc_f32_s')
+
+# sum_squares_scalar(n): The same computation, one float at a time. Extra locals: 4 = f, 5 = the accumulator.
+sum_squares_scalar = encode(
+    *fill_floats(), *for_each_iteration(*for_each_offset(
+        4, 1024,
+        get(5), get(2), ('f32.load', 2, 4096), tee(4), get(4), 'f32.mul', 'f32.add', put(5))),
+    get(5), 'i32.trunc_f32_s')
+
+
+def benchmark_module():
+    # Type: (i32) -> i32.
+    types = [([I32], [I32])]
+    functions = [
+        (0, [(2, I32), (4, V128)], blend),
+        (0, [(6, I32)], blend_scalar),
+        (0, [(2, I32), (2, V128)], sum_squares),
+        # The v128 local is unused, it keeps the local indices in line with the vector version.
+        (0, [(2, I32), (1, V128), (1, F32), (1, F32)], sum_squares_scalar),
+    ]
+    exports = [('blend', 0), ('blend_scalar', 1), ('sum_squares', 2), ('sum_squares_scalar', 3)]
+    return module(types, functions, exports)
+
+
+def main():
+    parser = ArgumentParser(description='Generate the LibWasm SIMD test and benchmark modules')
+    default_output = path.join(path.dirname(__file__), '..', 'Userland', 'Libraries', 'LibWasm', 'Tests', 'Fixtures',
+                               'Modules')
+    parser.add_argument('output_directory', nargs='?', default=default_output)
+    parser.add_argument('--expectations', action='store_true',
+                        help='Print the expected results of simd-operators.wasm as JavaScript')
+    args = parser.parse_args()
+
+    operators, expectations = operators_module()
+    with open(path.join(args.output_directory, 'simd-operators.wasm'), 'wb') as file:
+        file.write(operators)
+    with open(path.join(args.output_directory, 'simd-benchmark.wasm'), 'wb') as file:
+        file.write(benchmark_module())
+
+    if args.expectations:
+        print('// Expected results; arrays are the 16 result bytes of a v128, numbers are scalar (i32) results.')
+        print('const expectations = {')
+        for export, expected in expectations:
+            line = f'    {export}: {json.dumps(expected)},'
+            if len(line) > 100:
+                # Wrap arrays that don't fit prettier's print width the way it would.
+                line = f'    {export}: [\n        {", ".join(str(byte) for byte in expected)},\n    ],'
+            print(line)
+        print('};')
+
+
+if __name__ == '__main__':
+    main()
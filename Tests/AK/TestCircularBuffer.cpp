@@ -441,3 +441,32 @@ BENCHMARK_CASE(looping_copy_from_seekback)
         EXPECT_EQ(copied_bytes, 15 * MiB);
     }
 }
+
+TEST_CASE(copy_from_seekback_overlapping)
+{
+    auto buffer = MUST(CircularBuffer::create_empty(64));
+    EXPECT_EQ(buffer.write("abcdefghij"sv.bytes()), 10ul);
+
+    // Copies that overlap themselves repeat the bytes they start from.
+    EXPECT_EQ(MUST(buffer.copy_from_seekback(1, 3)), 3ul);
+    EXPECT_EQ(MUST(buffer.copy_from_seekback(4, 6)), 6ul);
+    EXPECT_EQ(MUST(buffer.copy_from_seekback(12, 16)), 16ul);
+
+    Array<u8, 35> result;
+    EXPECT_EQ(buffer.read(result).size(), result.size());
+    EXPECT_EQ(StringView { result.span() }, "abcdefghijjjjjjjjjjhijjjjjjjjjjhijj"sv);
+}
+
+TEST_CASE(copy_from_seekback_wrapping_around)
+{
+    auto buffer = MUST(CircularBuffer::create_empty(16));
+    EXPECT_EQ(buffer.write("0123456789abcd"sv.bytes()), 14ul);
+    MUST(buffer.discard(14));
+
+    // The source is right before the end of the buffer, and the copy wraps around to the start.
+    EXPECT_EQ(MUST(buffer.copy_from_seekback(10, 10)), 10ul);
+
+    Array<u8, 10> result;
+    EXPECT_EQ(buffer.read(result).size(), result.size());
+    EXPECT_EQ(StringView { result.span() }, "456789abcd"sv);
+}
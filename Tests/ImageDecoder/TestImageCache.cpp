@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <ImageDecoder/ImageCache.h>
+#include <LibGfx/Bitmap.h>
+#include <LibTest/TestCase.h>
+
+// A 1x1 QOI image with a single red pixel. It's small enough to be stored inline in a ByteBuffer, and QOI images are
+// only decoded when their first frame is requested.
+static constexpr Array<u8, 26> tiny_qoi {
+    'q', 'o', 'i', 'f', 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x00,
+    0xfe, 0xff, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+};
+
+[[gnu::noinline]] static ErrorOr<NonnullRefPtr<ImageDecoder::CachedImage>> create_image(ReadonlyBytes data)
+{
+    // The inline storage of this ByteBuffer is gone once we return.
+    auto encoded_data = TRY(ByteBuffer::copy(data));
+    return ImageDecoder::CachedImage::create(ImageDecoder::CachedImage::hash_content(data), move(encoded_data), {});
+}
+
+[[gnu::noinline]] static void overwrite_stack()
+{
+    volatile u8 garbage[4096];
+    for (size_t i = 0; i < sizeof(garbage); ++i)
+        garbage[i] = 0xa5;
+}
+
+TEST_CASE(decode_image_stored_inline)
+{
+    auto image = TRY_OR_FAIL(create_image(tiny_qoi));
+    overwrite_stack();
+
+    EXPECT_EQ(image->frame_count(), 1u);
+
+    auto frame = image->decode_frame(0);
+    if (!frame.bitmap.is_valid()) {
+        FAIL("Could not decode the image");
+        return;
+    }
+    EXPECT_EQ(frame.bitmap.bitmap()->size(), Gfx::IntSize(1, 1));
+    EXPECT_EQ(frame.bitmap.bitmap()->get_pixel(0, 0), Color(255, 0, 0));
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static timespec const s_no_wait {};
+
+TEST_CASE(level_triggered_readiness)
+{
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    int poll_set_fd = create_poll_set(POLL_SET_CLOEXEC);
+    EXPECT(poll_set_fd >= 0);
+    EXPECT_EQ(poll_set_ctl(poll_set_fd, POLL_SET_ADD, pipe_fds[0], POLLIN), 0);
+
+    pollfd ready[4] {};
+    EXPECT_EQ(poll_set_wait(poll_set_fd, ready, 4, &s_no_wait), 0);
+
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    EXPECT_EQ(poll_set_wait(poll_set_fd, ready, 4, &s_no_wait), 1);
+    EXPECT_EQ(ready[0].fd, pipe_fds[0]);
+    EXPECT(ready[0].revents & POLLIN);
+
+    // The pipe is still readable, so it keeps being reported.
+    EXPECT_EQ(poll_set_wait(poll_set_fd, ready, 4, &s_no_wait), 1);
+
+    char byte;
+    EXPECT_EQ(read(pipe_fds[0], &byte, 1), 1);
+    EXPECT_EQ(poll_set_wait(poll_set_fd, ready, 4, &s_no_wait), 0);
+
+    close(poll_set_fd);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
+
+TEST_CASE(edge_triggered_readiness)
+{
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    int poll_set_fd = create_poll_set(POLL_SET_CLOEXEC);
+    EXPECT(poll_set_fd >= 0);
+    EXPECT_EQ(poll_set_ctl(poll_set_fd, POLL_SET_ADD, pipe_fds[0], POLLIN | POLLET), 0);
+
+    pollfd ready[4] {};
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    EXPECT_EQ(poll_set_wait(poll_set_fd, ready, 4, &s_no_wait), 1);
+
+    // Nothing new happened since the last report.
+    EXPECT_EQ(poll_set_wait(poll_set_fd, ready, 4, &s_no_wait), 0);
+
+    EXPECT_EQ(write(pipe_fds[1], "y", 1), 1);
+    EXPECT_EQ(poll_set_wait(poll_set_fd, ready, 4, &s_no_wait), 1);
+
+    close(poll_set_fd);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
+
+TEST_CASE(blocking_wait_is_woken_by_write)
+{
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    int poll_set_fd = create_poll_set(POLL_SET_CLOEXEC);
+    EXPECT(poll_set_fd >= 0);
+    EXPECT_EQ(poll_set_ctl(poll_set_fd, POLL_SET_ADD, pipe_fds[0], POLLIN), 0);
+
+    pid_t pid = fork();
+    EXPECT(pid >= 0);
+    if (pid == 0) {
+        usleep(10'000);
+        (void)write(pipe_fds[1], "x", 1);
+        _exit(0);
+    }
+
+    pollfd ready[4] {};
+    EXPECT_EQ(poll_set_wait(poll_set_fd, ready, 4, nullptr), 1);
+    EXPECT_EQ(ready[0].fd, pipe_fds[0]);
+    EXPECT_EQ(waitpid(pid, nullptr, 0), pid);
+
+    close(poll_set_fd);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
+
+TEST_CASE(invalid_operations)
+{
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    int poll_set_fd = create_poll_set(POLL_SET_CLOEXEC);
+    EXPECT(poll_set_fd >= 0);
+
+    EXPECT_EQ(poll_set_ctl(poll_set_fd, POLL_SET_MODIFY, pipe_fds[0], POLLIN), -1);
+    EXPECT_EQ(errno, ENOENT);
+    EXPECT_EQ(poll_set_ctl(poll_set_fd, POLL_SET_REMOVE, pipe_fds[0], 0), -1);
+    EXPECT_EQ(errno, ENOENT);
+
+    EXPECT_EQ(poll_set_ctl(poll_set_fd, POLL_SET_ADD, pipe_fds[0], POLLIN), 0);
+    EXPECT_EQ(poll_set_ctl(poll_set_fd, POLL_SET_ADD, pipe_fds[0], POLLIN), -1);
+    EXPECT_EQ(errno, EEXIST);
+
+    EXPECT_EQ(poll_set_ctl(poll_set_fd, POLL_SET_ADD, poll_set_fd, POLLIN), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    EXPECT_EQ(poll_set_ctl(pipe_fds[0], POLL_SET_ADD, pipe_fds[1], POLLOUT), -1);
+    EXPECT_EQ(errno, EBADF);
+
+    EXPECT_EQ(poll_set_ctl(poll_set_fd, POLL_SET_REMOVE, pipe_fds[0], 0), 0);
+
+    close(poll_set_fd);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
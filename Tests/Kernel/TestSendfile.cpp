@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static constexpr size_t file_size = 200 * 1024;
+
+static int create_test_file()
+{
+    char path[] = "/tmp/sendfile.XXXXXX";
+    int fd = mkstemp(path);
+    VERIFY(fd >= 0);
+    unlink(path);
+
+    u8 buffer[4096];
+    for (size_t offset = 0; offset < file_size; offset += sizeof(buffer)) {
+        for (size_t i = 0; i < sizeof(buffer); ++i)
+            buffer[i] = static_cast<u8>((offset + i) % 251);
+        VERIFY(write(fd, buffer, sizeof(buffer)) == sizeof(buffer));
+    }
+    VERIFY(lseek(fd, 0, SEEK_SET) == 0);
+    return fd;
+}
+
+static bool read_matches_pattern(int fd, size_t start, size_t count)
+{
+    u8 buffer[4096];
+    size_t total = 0;
+    while (total < count) {
+        auto nread = read(fd, buffer, min(sizeof(buffer), count - total));
+        if (nread <= 0)
+            return false;
+        for (ssize_t i = 0; i < nread; ++i) {
+            if (buffer[i] != static_cast<u8>((start + total + i) % 251))
+                return false;
+        }
+        total += nread;
+    }
+    return true;
+}
+
+TEST_CASE(sendfile_with_explicit_offset)
+{
+    int file_fd = create_test_file();
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    off_t offset = 1000;
+    EXPECT_EQ(sendfile(pipe_fds[1], file_fd, &offset, 3000), 3000);
+    EXPECT_EQ(offset, 4000);
+    EXPECT(read_matches_pattern(pipe_fds[0], 1000, 3000));
+
+    // The file offset itself is left alone.
+    EXPECT_EQ(lseek(file_fd, 0, SEEK_CUR), 0);
+
+    close(file_fd);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
+
+TEST_CASE(sendfile_to_socket_advances_file_offset)
+{
+    int file_fd = create_test_file();
+    int socket_fds[2];
+    EXPECT_EQ(socketpair(AF_LOCAL, SOCK_STREAM, 0, socket_fds), 0);
+
+    pid_t pid = fork();
+    EXPECT(pid >= 0);
+    if (pid == 0) {
+        close(socket_fds[0]);
+        size_t remaining = file_size;
+        while (remaining > 0) {
+            auto nsent = sendfile(socket_fds[1], file_fd, nullptr, remaining);
+            if (nsent <= 0)
+                _exit(1);
+            remaining -= nsent;
+        }
+        _exit(lseek(file_fd, 0, SEEK_CUR) == static_cast<off_t>(file_size) ? 0 : 1);
+    }
+
+    close(socket_fds[1]);
+    EXPECT(read_matches_pattern(socket_fds[0], 0, file_size));
+
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    close(file_fd);
+    close(socket_fds[0]);
+}
+
+TEST_CASE(sendfile_stops_at_end_of_file)
+{
+    int file_fd = create_test_file();
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    off_t offset = file_size - 100;
+    EXPECT_EQ(sendfile(pipe_fds[1], file_fd, &offset, 1000), 100);
+    EXPECT_EQ(offset, static_cast<off_t>(file_size));
+    EXPECT_EQ(sendfile(pipe_fds[1], file_fd, &offset, 1000), 0);
+
+    close(file_fd);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
+
+TEST_CASE(sendfile_invalid_arguments)
+{
+    int file_fd = create_test_file();
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    // The input has to be a regular file.
+    EXPECT_EQ(sendfile(file_fd, pipe_fds[0], nullptr, 1), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    off_t offset = -1;
+    EXPECT_EQ(sendfile(pipe_fds[1], file_fd, &offset, 1), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    // The output has to be writable.
+    EXPECT_EQ(sendfile(pipe_fds[0], file_fd, nullptr, 1), -1);
+    EXPECT_EQ(errno, EBADF);
+
+    EXPECT_EQ(sendfile(pipe_fds[1], -1, nullptr, 1), -1);
+    EXPECT_EQ(errno, EBADF);
+
+    close(file_fd);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
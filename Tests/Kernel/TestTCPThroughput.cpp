@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/DeprecatedString.h>
+#include <AK/StringView.h>
+#include <LibTest/TestCase.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+static constexpr size_t transfer_size = 16 * MiB;
+static constexpr size_t chunk_size = 64 * KiB;
+
+// Sets a variable in /sys/kernel/conf/ for the lifetime of the object.
+class ScopedKernelVariable {
+public:
+    ScopedKernelVariable(StringView name, StringView value)
+        : m_path(DeprecatedString::formatted("/sys/kernel/conf/{}", name))
+    {
+        char old_value[64] {};
+        int fd = open(m_path.characters(), O_RDONLY);
+        if (fd < 0)
+            return;
+        auto nread = read(fd, old_value, sizeof(old_value) - 1);
+        close(fd);
+        if (nread <= 0)
+            return;
+        m_old_value = StringView { old_value, static_cast<size_t>(nread) }.trim_whitespace();
+        m_is_set = write_value(value);
+    }
+
+    ~ScopedKernelVariable()
+    {
+        if (m_is_set)
+            (void)write_value(m_old_value);
+    }
+
+    bool is_set() const { return m_is_set; }
+
+private:
+    bool write_value(StringView value)
+    {
+        int fd = open(m_path.characters(), O_WRONLY | O_TRUNC);
+        if (fd < 0)
+            return false;
+        auto nwritten = write(fd, value.characters_without_null_termination(), value.length());
+        close(fd);
+        return nwritten == static_cast<ssize_t>(value.length());
+    }
+
+    DeprecatedString m_path;
+    DeprecatedString m_old_value;
+    bool m_is_set { false };
+};
+
+static u8 pattern_byte(size_t offset)
+{
+    return static_cast<u8>((offset * 31) ^ (offset >> 12));
+}
+
+static void send_pattern(u16 port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        _exit(1);
+
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+        _exit(1);
+
+    static u8 buffer[chunk_size];
+    for (size_t offset = 0; offset < transfer_size; offset += chunk_size) {
+        for (size_t i = 0; i < chunk_size; ++i)
+            buffer[i] = pattern_byte(offset + i);
+        size_t nsent = 0;
+        while (nsent < chunk_size) {
+            auto rc = write(fd, buffer + nsent, chunk_size - nsent);
+            if (rc <= 0)
+                _exit(1);
+            nsent += rc;
+        }
+    }
+    close(fd);
+    _exit(0);
+}
+
+static void run_bulk_transfer(StringView algorithm, StringView packet_loss_interval)
+{
+    ScopedKernelVariable congestion_control("tcp_congestion_control"sv, algorithm);
+    ScopedKernelVariable packet_loss("loopback_packet_loss"sv, packet_loss_interval);
+    if (!congestion_control.is_set() || !packet_loss.is_set()) {
+        warnln("Skipping, setting /sys/kernel/conf variables requires root");
+        return;
+    }
+
+    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(listen_fd >= 0);
+
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = 0;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    EXPECT_EQ(bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    EXPECT_EQ(listen(listen_fd, 1), 0);
+
+    socklen_t address_length = sizeof(address);
+    EXPECT_EQ(getsockname(listen_fd, reinterpret_cast<sockaddr*>(&address), &address_length), 0);
+
+    pid_t pid = fork();
+    EXPECT(pid >= 0);
+    if (pid == 0)
+        send_pattern(ntohs(address.sin_port));
+
+    int fd = accept(listen_fd, nullptr, nullptr);
+    EXPECT(fd >= 0);
+
+    timespec start {};
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    static u8 buffer[chunk_size];
+    size_t total_received = 0;
+    bool pattern_matches = true;
+    for (;;) {
+        auto nread = read(fd, buffer, sizeof(buffer));
+        if (nread <= 0)
+            break;
+        for (ssize_t i = 0; i < nread && pattern_matches; ++i)
+            pattern_matches = buffer[i] == pattern_byte(total_received + i);
+        total_received += nread;
+    }
+
+    timespec end {};
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    EXPECT_EQ(total_received, transfer_size);
+    EXPECT(pattern_matches);
+
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    auto elapsed_ms = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1'000'000;
+    outln("{} with 1/{} packet loss: {} KiB in {} ms ({} KiB/s)", algorithm, packet_loss_interval,
+        total_received / KiB, elapsed_ms, elapsed_ms > 0 ? total_received / KiB * 1000 / elapsed_ms : 0);
+
+    close(fd);
+    close(listen_fd);
+}
+
+TEST_CASE(bulk_transfer_without_loss)
+{
+    run_bulk_transfer("newreno"sv, "0"sv);
+}
+
+TEST_CASE(bulk_transfer_with_newreno_and_loss)
+{
+    run_bulk_transfer("newreno"sv, "20"sv);
+}
+
+TEST_CASE(bulk_transfer_with_cubic_and_loss)
+{
+    run_bulk_transfer("cubic"sv, "20"sv);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// Measures how many context switches per second the scheduler can sustain as more
+// processors get involved. Each pair of threads ping-pongs a single byte through
+// two pipes, so every round trip forces two context switches.
+
+struct PingPongPair {
+    int ping_fds[2] { -1, -1 };
+    int pong_fds[2] { -1, -1 };
+    pthread_t ping_thread {};
+    pthread_t pong_thread {};
+    u64 round_trips { 0 };
+};
+
+static Atomic<bool> s_should_stop { false };
+
+static void* ping_main(void* context)
+{
+    auto& pair = *static_cast<PingPongPair*>(context);
+    char byte = 'x';
+    while (!s_should_stop.load(AK::MemoryOrder::memory_order_relaxed)) {
+        if (write(pair.ping_fds[1], &byte, 1) != 1)
+            break;
+        if (read(pair.pong_fds[0], &byte, 1) != 1)
+            break;
+        ++pair.round_trips;
+    }
+    close(pair.ping_fds[1]);
+    return nullptr;
+}
+
+static void* pong_main(void* context)
+{
+    auto& pair = *static_cast<PingPongPair*>(context);
+    char byte;
+    while (read(pair.ping_fds[0], &byte, 1) == 1) {
+        if (write(pair.pong_fds[1], &byte, 1) != 1)
+            break;
+    }
+    close(pair.pong_fds[1]);
+    return nullptr;
+}
+
+static bool run_pairs(size_t pair_count, int duration_ms, u64& context_switches, i64& elapsed_ms)
+{
+    Vector<PingPongPair> pairs;
+    pairs.resize(pair_count);
+
+    for (auto& pair : pairs) {
+        if (pipe(pair.ping_fds) < 0 || pipe(pair.pong_fds) < 0) {
+            perror("pipe");
+            return false;
+        }
+    }
+
+    s_should_stop.store(false);
+    auto timer = Core::ElapsedTimer::start_new();
+
+    for (auto& pair : pairs) {
+        if (pthread_create(&pair.pong_thread, nullptr, pong_main, &pair) != 0 || pthread_create(&pair.ping_thread, nullptr, ping_main, &pair) != 0) {
+            perror("pthread_create");
+            return false;
+        }
+    }
+
+    usleep(duration_ms * 1000);
+    s_should_stop.store(true);
+
+    context_switches = 0;
+    for (auto& pair : pairs) {
+        pthread_join(pair.ping_thread, nullptr);
+        pthread_join(pair.pong_thread, nullptr);
+        context_switches += pair.round_trips * 2;
+        close(pair.ping_fds[0]);
+        close(pair.pong_fds[0]);
+    }
+    elapsed_ms = timer.elapsed_milliseconds();
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Vector<StringView> arguments;
+    arguments.ensure_capacity(argc);
+    for (auto i = 0; i < argc; ++i)
+        arguments.append({ argv[i], strlen(argv[i]) });
+
+    int max_pairs = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+    int duration_ms = 2000;
+
+    Core::ArgsParser args_parser;
+    args_parser.add_option(max_pairs, "Maximum number of ping-pong thread pairs (defaults to the number of processors)", "pairs", 'p', "number");
+    args_parser.add_option(duration_ms, "Duration of each run in milliseconds", "duration", 'd', "ms");
+    args_parser.parse(arguments);
+
+    if (max_pairs < 1)
+        max_pairs = 1;
+
+    outln("{:>8} {:>16} {:>16}", "pairs", "switches", "switches/sec");
+    for (int pair_count = 1;;) {
+        u64 context_switches = 0;
+        i64 elapsed_ms = 0;
+        if (!run_pairs(pair_count, duration_ms, context_switches, elapsed_ms))
+            return EXIT_FAILURE;
+        u64 per_second = elapsed_ms > 0 ? context_switches * 1000 / elapsed_ms : 0;
+        outln("{:>8} {:>16} {:>16}", pair_count, context_switches, per_second);
+
+        if (pair_count == max_pairs)
+            break;
+        pair_count = min(pair_count * 2, max_pairs);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -6,9 +6,13 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/Array.h>
+#include <AK/Vector.h>
 #include <errno.h>
 #include <mallocdefs.h>
+#include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
 
 TEST_CASE(malloc_limits)
 {
@@ -38,3 +42,69 @@ TEST_CASE(malloc_limits)
         return Test::Crash::Failure::DidNotCrash;
     });
 }
+
+static void* allocate_for_other_thread(void*)
+{
+    auto* ptr = malloc(64);
+    memset(ptr, 0x42, 64);
+    return ptr;
+}
+
+TEST_CASE(free_in_other_thread)
+{
+    // Chunks allocated from one thread's cache must be freeable from any other thread.
+    for (size_t i = 0; i < 1000; ++i) {
+        pthread_t thread;
+        EXPECT_EQ(pthread_create(&thread, nullptr, allocate_for_other_thread, nullptr), 0);
+        void* ptr = nullptr;
+        EXPECT_EQ(pthread_join(thread, &ptr), 0);
+        EXPECT_NE(ptr, nullptr);
+        EXPECT_EQ(static_cast<u8*>(ptr)[63], 0x42);
+        free(ptr);
+    }
+}
+
+static void* malloc_free_worker(void*)
+{
+    static constexpr Array<size_t, 6> sizes { 8, 24, 48, 100, 200, 900 };
+    Array<void*, 64> live {};
+
+    for (size_t iteration = 0; iteration < 200'000; ++iteration) {
+        auto& slot = live[iteration % live.size()];
+        free(slot);
+        slot = malloc(sizes[iteration % sizes.size()]);
+    }
+    for (auto* ptr : live)
+        free(ptr);
+    return nullptr;
+}
+
+static void run_malloc_free_workers(size_t thread_count)
+{
+    Vector<pthread_t> threads;
+    threads.resize(thread_count);
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_create(&thread, nullptr, malloc_free_worker, nullptr), 0);
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+}
+
+BENCHMARK_CASE(malloc_free_1_thread)
+{
+    run_malloc_free_workers(1);
+}
+
+BENCHMARK_CASE(malloc_free_2_threads)
+{
+    run_malloc_free_workers(2);
+}
+
+BENCHMARK_CASE(malloc_free_4_threads)
+{
+    run_malloc_free_workers(4);
+}
+
+BENCHMARK_CASE(malloc_free_8_threads)
+{
+    run_malloc_free_workers(8);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCompress/Deflate.h>
+#include <LibCompress/Gzip.h>
+#include <LibCompress/Zlib.h>
+#include <LibTest/TestCase.h>
+
+// A deterministic corpus that mixes the kinds of data DEFLATE usually sees in the wild:
+// natural-language-like text, structured records, smooth image rows, and incompressible noise.
+static ByteBuffer generate_corpus()
+{
+    constexpr size_t section_size = 1 * MiB;
+    ByteBuffer corpus;
+    u32 seed = 0x12345678;
+    auto next_random = [&] {
+        seed = seed * 1103515245 + 12345;
+        return seed >> 8;
+    };
+
+    // Words are picked with a roughly Zipfian distribution.
+    constexpr StringView words[] = { "the"sv, "of"sv, "and"sv, "to"sv, "in"sv, "a"sv, "is"sv, "that"sv, "for"sv, "it"sv,
+        "compression"sv, "window"sv, "literal"sv, "distance"sv, "symbol"sv, "serenity"sv, "browser"sv, "kernel"sv };
+    while (corpus.size() < section_size) {
+        auto rank = next_random() % 1000;
+        size_t index = 0;
+        for (size_t threshold = 500; rank >= threshold && index < array_size(words) - 1; threshold += (1000 - threshold) / 2)
+            ++index;
+        corpus.append(words[index].bytes());
+        corpus.append(next_random() % 12 == 0 ? '\n' : ' ');
+    }
+
+    for (size_t record = 0; corpus.size() < 2 * section_size; ++record) {
+        auto line = DeprecatedString::formatted("{{\"id\": {}, \"name\": \"user{}\", \"score\": {}, \"active\": {}}}\n",
+            record, next_random() % 5000, next_random() % 100, record % 3 == 0 ? "true" : "false");
+        corpus.append(line.bytes());
+    }
+
+    for (size_t row = 0; corpus.size() < 3 * section_size; ++row) {
+        for (size_t column = 0; column < 1024; ++column)
+            corpus.append(static_cast<u8>((row + column / 4 + (next_random() % 3)) & 0xff));
+    }
+
+    while (corpus.size() < 4 * section_size)
+        corpus.append(static_cast<u8>(next_random()));
+
+    return corpus;
+}
+
+static auto corpus = generate_corpus();
+static auto deflate_data = Compress::DeflateCompressor::compress_all(corpus).release_value();
+static auto zlib_data = Compress::ZlibCompressor::compress_all(corpus).release_value();
+static auto gzip_data = Compress::GzipCompressor::compress_all(corpus).release_value();
+
+BENCHMARK_CASE(deflate_decompress)
+{
+    auto decompressed = MUST(Compress::DeflateDecompressor::decompress_all(deflate_data));
+    EXPECT_EQ(decompressed.size(), corpus.size());
+}
+
+BENCHMARK_CASE(zlib_decompress)
+{
+    auto stream = make<FixedMemoryStream>(zlib_data.bytes());
+    auto decompressor = MUST(Compress::ZlibDecompressor::create(move(stream)));
+    auto decompressed = MUST(decompressor->read_until_eof());
+    EXPECT_EQ(decompressed.size(), corpus.size());
+}
+
+BENCHMARK_CASE(gzip_decompress)
+{
+    auto decompressed = MUST(Compress::GzipDecompressor::decompress_all(gzip_data));
+    EXPECT_EQ(decompressed.size(), corpus.size());
+}
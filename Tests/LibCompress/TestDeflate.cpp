@@ -149,6 +149,17 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(deflate_round_trip_compress_parallel)
+{
+    // Not a multiple of the chunk size, so the last chunk is a short one.
+    auto size = Compress::DeflateCompressor::parallel_chunk_size * 3 + 1234;
+    auto original = ByteBuffer::create_zeroed(size).release_value();
+    fill_with_random(original.bytes().trim(size / 2)); // the second half is all 0s, so there are back references as well
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::FAST, 2));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Checksum/CRC32.h>
 #include <LibTest/TestCase.h>
@@ -22,6 +23,27 @@ TEST_CASE(test_adler32)
     do_test(DeprecatedString("abcdefghijklmnopqrstuvwxyz").bytes(), 0x90860b20);
 }
 
+TEST_CASE(test_adler32_large_input)
+{
+    // Long enough to need multiple deferred modulo reductions, and with a tail that isn't a whole block.
+    auto input = MUST(ByteBuffer::create_uninitialized(20011));
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] = 0xff - (i % 7);
+
+    u32 a = 1;
+    u32 b = 0;
+    for (auto byte : input.bytes()) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    EXPECT_EQ(Crypto::Checksum::Adler32(input).digest(), (b << 16) | a);
+
+    Crypto::Checksum::Adler32 incremental;
+    incremental.update(input.span().trim(13));
+    incremental.update(input.span().slice(13));
+    EXPECT_EQ(incremental.digest(), (b << 16) | a);
+}
+
 TEST_CASE(test_crc32)
 {
     auto do_test = [](ReadonlyBytes input, u32 expected_result) {
@@ -33,3 +55,32 @@ TEST_CASE(test_crc32)
     do_test(DeprecatedString("The quick brown fox jumps over the lazy dog").bytes(), 0x414FA339);
     do_test(DeprecatedString("various CRC algorithms input data").bytes(), 0x9BD366AE);
 }
+
+TEST_CASE(test_crc32_large_input)
+{
+    // Large inputs may take a different code path than short ones, so compare against a byte-at-a-time update.
+    auto input = MUST(ByteBuffer::create_uninitialized(4099));
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] = static_cast<u8>(i * 31 + (i >> 5));
+
+    for (size_t size : Array<size_t, 8> { 63, 64, 65, 80, 127, 128, 1000, 4099 }) {
+        auto data = input.span().trim(size);
+        Crypto::Checksum::CRC32 bytewise;
+        for (size_t i = 0; i < data.size(); ++i)
+            bytewise.update(data.slice(i, 1));
+        EXPECT_EQ(Crypto::Checksum::CRC32(data).digest(), bytewise.digest());
+    }
+
+    EXPECT_EQ(Crypto::Checksum::CRC32(input.span().trim(1000)).digest(), 0xef3c853au);
+}
+
+TEST_CASE(test_crc32_combine)
+{
+    auto data = "The quick brown fox jumps over the lazy dog"sv.bytes();
+    auto expected = Crypto::Checksum::CRC32(data).digest();
+    for (size_t split = 0; split <= data.size(); ++split) {
+        auto first = Crypto::Checksum::CRC32(data.trim(split)).digest();
+        auto second = Crypto::Checksum::CRC32(data.slice(split)).digest();
+        EXPECT_EQ(Crypto::Checksum::CRC32::combine(first, second, data.size() - split), expected);
+    }
+}
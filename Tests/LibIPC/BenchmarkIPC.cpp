@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/ConnectionFromClient.h>
+#include <LibIPC/ConnectionToServer.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+#include <Tests/LibIPC/BenchmarkClientEndpoint.h>
+#include <Tests/LibIPC/BenchmarkServerEndpoint.h>
+#include <sys/socket.h>
+
+class BenchmarkServerConnection final : public IPC::ConnectionFromClient<BenchmarkClientEndpoint, BenchmarkServerEndpoint> {
+    C_OBJECT(BenchmarkServerConnection);
+
+public:
+    virtual void die() override { Core::EventLoop::current().quit(0); }
+
+private:
+    explicit BenchmarkServerConnection(NonnullOwnPtr<Core::LocalSocket> socket)
+        : IPC::ConnectionFromClient<BenchmarkClientEndpoint, BenchmarkServerEndpoint>(*this, move(socket), 1)
+    {
+    }
+
+    virtual void ping() override { }
+    virtual Messages::BenchmarkServer::ConsumeResponse consume(ByteBuffer const& data) override { return data.size(); }
+    virtual Messages::BenchmarkServer::EchoResponse echo(ByteBuffer const& data) override { return data; }
+
+    virtual Messages::BenchmarkServer::SumResponse sum(Vector<u32> const& values) override
+    {
+        u64 sum = 0;
+        for (auto value : values)
+            sum += value;
+        return sum;
+    }
+
+    virtual void send_notifications(u32 count) override
+    {
+        for (u32 i = 0; i < count; ++i)
+            async_notification(i);
+    }
+};
+
+class BenchmarkClientConnection final : public IPC::ConnectionToServer<BenchmarkClientEndpoint, BenchmarkServerEndpoint> {
+    C_OBJECT(BenchmarkClientConnection);
+
+public:
+    virtual void die() override { }
+
+private:
+    explicit BenchmarkClientConnection(NonnullOwnPtr<Core::LocalSocket> socket)
+        : IPC::ConnectionToServer<BenchmarkClientEndpoint, BenchmarkServerEndpoint>(*this, move(socket))
+    {
+    }
+
+    virtual void notification(u32) override { }
+};
+
+// Runs a BenchmarkServer on its own thread and event loop, connected to a client on the calling thread.
+// Like a real client, the client socket blocks while the server's doesn't, and file descriptors are passed
+// over a separate socket.
+class BenchmarkSession {
+public:
+    BenchmarkSession()
+    {
+        int client_fds[2];
+        int fd_passing_fds[2];
+        MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, client_fds));
+        MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fd_passing_fds));
+
+        m_server_thread = Threading::Thread::construct([fd = client_fds[1], fd_passing_fd = fd_passing_fds[1]]() -> intptr_t {
+            Core::EventLoop event_loop;
+            auto socket = MUST(Core::LocalSocket::adopt_fd(fd));
+            MUST(socket->set_blocking(false));
+            auto connection = BenchmarkServerConnection::construct(move(socket));
+            connection->set_fd_passing_socket(MUST(Core::LocalSocket::adopt_fd(fd_passing_fd)));
+            return event_loop.exec();
+        });
+        m_server_thread->start();
+
+        auto socket = MUST(Core::LocalSocket::adopt_fd(client_fds[0]));
+        MUST(socket->set_blocking(true));
+        m_client = BenchmarkClientConnection::construct(move(socket));
+        m_client->set_fd_passing_socket(MUST(Core::LocalSocket::adopt_fd(fd_passing_fds[0])));
+    }
+
+    ~BenchmarkSession()
+    {
+        m_client->shutdown();
+        (void)m_server_thread->join();
+    }
+
+    BenchmarkClientConnection& client() { return *m_client; }
+
+private:
+    // The client connection defers some work to the event loop, even though it never runs.
+    Core::EventLoop m_event_loop;
+    RefPtr<Threading::Thread> m_server_thread;
+    RefPtr<BenchmarkClientConnection> m_client;
+};
+
+static ByteBuffer make_payload(size_t size)
+{
+    auto payload = MUST(ByteBuffer::create_uninitialized(size));
+    for (size_t i = 0; i < size; ++i)
+        payload[i] = static_cast<u8>(i * 31);
+    return payload;
+}
+
+static void consume(size_t size, size_t count)
+{
+    BenchmarkSession session;
+    auto payload = make_payload(size);
+    for (size_t i = 0; i < count; ++i)
+        EXPECT_EQ(session.client().consume(payload), size);
+}
+
+BENCHMARK_CASE(round_trip)
+{
+    BenchmarkSession session;
+    for (size_t i = 0; i < 20000; ++i)
+        session.client().ping();
+}
+
+BENCHMARK_CASE(bandwidth_16kib)
+{
+    consume(16 * KiB, 10000);
+}
+
+BENCHMARK_CASE(bandwidth_256kib)
+{
+    consume(256 * KiB, 1000);
+}
+
+BENCHMARK_CASE(bandwidth_4mib)
+{
+    consume(4 * MiB, 100);
+}
+
+BENCHMARK_CASE(echo_1mib)
+{
+    BenchmarkSession session;
+    auto payload = make_payload(1 * MiB);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(session.client().echo(payload).size(), payload.size());
+}
+
+BENCHMARK_CASE(u32_vector)
+{
+    BenchmarkSession session;
+    Vector<u32> values;
+    for (u32 i = 0; i < 16 * KiB; ++i)
+        values.append(i);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(session.client().sum(values), 16 * KiB * (16 * KiB - 1) / 2);
+}
+
+BENCHMARK_CASE(notification_burst)
+{
+    BenchmarkSession session;
+    constexpr u32 notification_count = 500;
+    for (size_t i = 0; i < 100; ++i) {
+        session.client().send_notifications(notification_count);
+        for (u32 j = 0; j < notification_count; ++j)
+            EXPECT(session.client().wait_for_specific_message<Messages::BenchmarkClient::Notification>());
+    }
+}
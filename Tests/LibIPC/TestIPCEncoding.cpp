@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonValue.h>
+#include <AK/MemoryStream.h>
+#include <AK/String.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibTest/TestCase.h>
+#include <sys/socket.h>
+
+// File descriptors are passed over a socket pair, while the message data is decoded straight from memory.
+struct FileDescriptorChannel {
+    NonnullOwnPtr<Core::LocalSocket> sender;
+    NonnullOwnPtr<Core::LocalSocket> receiver;
+};
+
+static FileDescriptorChannel make_file_descriptor_channel()
+{
+    int fds[2];
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+    return { MUST(Core::LocalSocket::adopt_fd(fds[0])), MUST(Core::LocalSocket::adopt_fd(fds[1])) };
+}
+
+template<typename T>
+static IPC::MessageBuffer encode(T const& value)
+{
+    IPC::MessageBuffer buffer;
+    IPC::Encoder encoder { buffer };
+    MUST(encoder.encode(value));
+    return buffer;
+}
+
+template<typename T>
+static T decode(FileDescriptorChannel& channel, IPC::MessageBuffer const& buffer)
+{
+    for (auto const& fd : buffer.fds)
+        MUST(channel.sender->send_fd(fd->value()));
+
+    FixedMemoryStream stream { buffer.data.span() };
+    IPC::Decoder decoder { stream, *channel.receiver };
+    auto value = MUST(decoder.decode<T>());
+    EXPECT(stream.is_eof());
+    return value;
+}
+
+static ByteBuffer make_payload(size_t size)
+{
+    auto payload = MUST(ByteBuffer::create_uninitialized(size));
+    for (size_t i = 0; i < size; ++i)
+        payload[i] = static_cast<u8>('a' + i % 26);
+    return payload;
+}
+
+TEST_CASE(arithmetic_vectors)
+{
+    auto channel = make_file_descriptor_channel();
+
+    Vector<u32> integers;
+    for (u32 i = 0; i < 1000; ++i)
+        integers.append(i * 2654435761u);
+    auto buffer = encode(integers);
+    EXPECT_EQ(buffer.data.size(), sizeof(u32) + integers.size() * sizeof(u32));
+    EXPECT_EQ(decode<Vector<u32>>(channel, buffer), integers);
+
+    Vector<double> doubles { 0.5, -1.25, 1e300, -0.0 };
+    EXPECT_EQ(decode<Vector<double>>(channel, encode(doubles)), doubles);
+
+    Vector<i16> shorts { -32768, -1, 0, 32767, 7 };
+    EXPECT_EQ(decode<Vector<i16>>(channel, encode(shorts)), shorts);
+
+    Vector<bool> booleans { true, false, true };
+    EXPECT_EQ(decode<Vector<bool>>(channel, encode(booleans)), booleans);
+
+    EXPECT(decode<Vector<u64>>(channel, encode(Vector<u64> {})).is_empty());
+}
+
+TEST_CASE(small_payloads_are_sent_inline)
+{
+    auto channel = make_file_descriptor_channel();
+
+    auto payload = make_payload(IPC::shared_memory_payload_threshold - 1);
+    auto buffer = encode(payload);
+    EXPECT(buffer.fds.is_empty());
+    EXPECT_EQ(buffer.data.size(), sizeof(u32) + payload.size());
+    EXPECT_EQ(decode<ByteBuffer>(channel, buffer), payload);
+
+    auto string = MUST(String::from_utf8("Well hello friends!"sv));
+    buffer = encode(string);
+    EXPECT(buffer.fds.is_empty());
+    EXPECT_EQ(decode<String>(channel, buffer), string);
+
+    EXPECT(decode<ByteBuffer>(channel, encode(ByteBuffer {})).is_empty());
+}
+
+TEST_CASE(large_payloads_are_sent_through_shared_memory)
+{
+    auto channel = make_file_descriptor_channel();
+
+    auto payload = make_payload(IPC::shared_memory_payload_threshold);
+    auto buffer = encode(payload);
+    EXPECT_EQ(buffer.fds.size(), 1u);
+    EXPECT_EQ(buffer.data.size(), sizeof(u32));
+    EXPECT_EQ(decode<ByteBuffer>(channel, buffer), payload);
+
+    auto string_payload = make_payload(1 * MiB);
+    auto string = MUST(String::from_utf8(StringView { string_payload }));
+    buffer = encode(string);
+    EXPECT_EQ(buffer.fds.size(), 1u);
+    EXPECT_EQ(decode<String>(channel, buffer), string);
+
+    JsonArray array;
+    for (size_t i = 0; i < 20000; ++i)
+        MUST(array.append(i));
+    buffer = encode(JsonValue { array });
+    EXPECT_EQ(buffer.fds.size(), 1u);
+    auto json = decode<JsonValue>(channel, buffer);
+    EXPECT(json.is_array());
+    EXPECT_EQ(json.as_array().size(), 20000u);
+    EXPECT_EQ(json.as_array().at(12345).to_u32(), 12345u);
+}
+
+TEST_CASE(multiple_shared_memory_payloads)
+{
+    auto channel = make_file_descriptor_channel();
+
+    Vector<ByteBuffer> payloads;
+    payloads.append(make_payload(IPC::shared_memory_payload_threshold));
+    payloads.append(make_payload(16));
+    payloads.append(make_payload(IPC::shared_memory_payload_threshold * 3 + 17));
+
+    auto buffer = encode(payloads);
+    EXPECT_EQ(buffer.fds.size(), 2u);
+    EXPECT_EQ(decode<Vector<ByteBuffer>>(channel, buffer), payloads);
+}
+
+TEST_CASE(shared_memory_payloads_must_fit_in_their_buffer)
+{
+    auto channel = make_file_descriptor_channel();
+
+    auto buffer = encode(make_payload(IPC::shared_memory_payload_threshold));
+    EXPECT_EQ(buffer.fds.size(), 1u);
+
+    // Claim that the payload is larger than the buffer that was sent along with it.
+    u32 claimed_size = IPC::shared_memory_payload_threshold * 16;
+    __builtin_memcpy(buffer.data.data(), &claimed_size, sizeof(claimed_size));
+    MUST(channel.sender->send_fd(buffer.fds[0]->value()));
+
+    FixedMemoryStream stream { buffer.data.span() };
+    IPC::Decoder decoder { stream, *channel.receiver };
+    EXPECT(decoder.decode<ByteBuffer>().is_error());
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <AK/StringBuilder.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/IdentifierTable.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+// Exercises everything that needs special care when (de)serializing: closures, classes, generators, regular
+// expressions, bigints, exception handling, block scopes and labelled jumps.
+static constexpr auto test_script = R"~~~(
+    function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+    const add = a => b => a + b;
+    class Animal {
+        #name;
+        constructor(name) { this.#name = name; }
+        get name() { return this.#name; }
+        speak() { return `${this.name} speaks`; }
+        static create(name) { return new this(name); }
+    }
+    class Dog extends Animal { speak() { return super.speak() + " woof"; } }
+    function* counter() { let i = 0; while (i < 3) yield i++; }
+
+    const out = [];
+    out.push(fib(15));
+    out.push(add(2)(3));
+    out.push(Dog.create("rex").speak());
+    out.push([...counter()].join(","));
+    out.push(/a(b+)c/gi.exec("xxABBBc")[1]);
+    out.push((12345678901234567890n * 3n).toString());
+    try { throw new Error("boom"); } catch (e) { out.push(e.message); } finally { out.push("finally"); }
+    { let x = 5; function inner() { return x; } out.push(inner()); }
+    for (const [key, value] of Object.entries({ a: 1, b: 2 })) out.push(key + value);
+    outer: for (let i = 0; i < 3; i++) {
+        for (let j = 0; j < 3; j++) {
+            if (j == 1) continue outer;
+            if (i == 2) break outer;
+            out.push(i * 10 + j);
+        }
+    }
+    out.join("|");
+)~~~"sv;
+
+static constexpr auto expected_result = "610|5|rex speaks woof|0,1,2|BBB|37037036703703703670|boom|finally|5|a1|b2|0|10"sv;
+
+class TemporaryCacheDirectory {
+public:
+    TemporaryCacheDirectory()
+    {
+        char pattern[] = "/tmp/test-bytecode-cache.XXXXXX";
+        m_path = MUST(Core::System::mkdtemp(pattern)).to_deprecated_string();
+        JS::Bytecode::ExecutableCache::set_directory(m_path);
+        JS::Bytecode::ExecutableCache::reset_statistics();
+    }
+
+    ~TemporaryCacheDirectory()
+    {
+        JS::Bytecode::ExecutableCache::set_directory({});
+        MUST(FileSystem::remove(m_path, FileSystem::RecursionMode::Allowed));
+    }
+
+    DeprecatedString const& path() const { return m_path; }
+
+private:
+    DeprecatedString m_path;
+};
+
+static DeprecatedString run(StringView source)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+
+    auto script = JS::Script::parse(source, realm, "test-bytecode-cache"sv);
+    VERIFY(!script.is_error());
+    auto result = vm->bytecode_interpreter().run(*script.value());
+    if (result.is_error())
+        return "<exception>";
+    return result.value().to_string_without_side_effects().to_deprecated_string();
+}
+
+TEST_CASE(warm_run_uses_cached_bytecode)
+{
+    TemporaryCacheDirectory cache_directory;
+
+    EXPECT_EQ(run(test_script), expected_result);
+    auto cold_statistics = JS::Bytecode::ExecutableCache::statistics();
+    EXPECT_EQ(cold_statistics.hits, 0u);
+    EXPECT(cold_statistics.stores > 0);
+
+    JS::Bytecode::ExecutableCache::reset_statistics();
+    EXPECT_EQ(run(test_script), expected_result);
+    auto warm_statistics = JS::Bytecode::ExecutableCache::statistics();
+    EXPECT_EQ(warm_statistics.hits, cold_statistics.stores);
+    EXPECT_EQ(warm_statistics.misses, cold_statistics.misses - cold_statistics.stores);
+}
+
+TEST_CASE(changed_source_does_not_use_cached_bytecode)
+{
+    TemporaryCacheDirectory cache_directory;
+
+    EXPECT_EQ(run(test_script), expected_result);
+
+    JS::Bytecode::ExecutableCache::reset_statistics();
+    auto changed_script = DeprecatedString::formatted("{}\n\"changed\";", test_script);
+    EXPECT_EQ(run(changed_script), "changed"sv);
+    EXPECT_EQ(JS::Bytecode::ExecutableCache::statistics().hits, 0u);
+}
+
+TEST_CASE(corrupted_cache_files_are_ignored)
+{
+    TemporaryCacheDirectory cache_directory;
+
+    EXPECT_EQ(run(test_script), expected_result);
+
+    Core::DirIterator iterator(cache_directory.path(), Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto path = iterator.next_full_path();
+        auto file = MUST(Core::File::open(path, Core::File::OpenMode::ReadWrite));
+        auto data = MUST(file->read_until_eof());
+        data[data.size() / 2] ^= 0xff;
+        MUST(file->seek(0, SeekMode::SetPosition));
+        MUST(file->write_until_depleted(data));
+    }
+
+    JS::Bytecode::ExecutableCache::reset_statistics();
+    EXPECT_EQ(run(test_script), expected_result);
+    EXPECT_EQ(JS::Bytecode::ExecutableCache::statistics().hits, 0u);
+}
+
+TEST_CASE(cache_files_from_a_different_build_are_ignored)
+{
+    TemporaryCacheDirectory cache_directory;
+    EXPECT(!JS::Bytecode::ExecutableCache::build_id().is_empty());
+
+    EXPECT_EQ(run(test_script), expected_result);
+
+    // A different build can generate different bytecode from the same instructions, e.g. if an optimization pass changed.
+    auto build_id = MUST(ByteBuffer::copy(JS::Bytecode::ExecutableCache::build_id()));
+    ScopeGuard restore_build_id = [&] { JS::Bytecode::ExecutableCache::set_build_id(move(build_id)); };
+    JS::Bytecode::ExecutableCache::set_build_id(MUST(ByteBuffer::copy("a different build"sv.bytes())));
+
+    JS::Bytecode::ExecutableCache::reset_statistics();
+    EXPECT_EQ(run(test_script), expected_result);
+    EXPECT_EQ(JS::Bytecode::ExecutableCache::statistics().hits, 0u);
+}
+
+// Cache files with a valid checksum can still be crafted, so everything that instructions refer to has to be validated.
+TEST_CASE(cache_files_with_out_of_range_operands_are_rejected)
+{
+    TemporaryCacheDirectory cache_directory;
+    auto program = JS::Parser { JS::Lexer { test_script } }.parse_program();
+
+    auto serialize_tampered = [&](Function<void(JS::Bytecode::Executable&)> tamper) {
+        auto executable = MUST(JS::Bytecode::Generator::generate(*program));
+        tamper(*executable);
+        return MUST(JS::Bytecode::ExecutableCache::serialize(*executable, *program, *program, JS::FunctionKind::Normal));
+    };
+    auto deserializes = [&](ByteBuffer const& data) {
+        return !JS::Bytecode::ExecutableCache::deserialize(data, *program, *program, JS::FunctionKind::Normal).is_error();
+    };
+
+    EXPECT(deserializes(serialize_tampered([](auto&) {})));
+    EXPECT(!deserializes(serialize_tampered([](auto& executable) { executable.number_of_registers = 1; })));
+    EXPECT(!deserializes(serialize_tampered([](auto& executable) { executable.identifier_table = make<JS::Bytecode::IdentifierTable>(); })));
+    EXPECT(!deserializes(serialize_tampered([](auto& executable) { executable.property_lookup_caches.clear(); })));
+    EXPECT(!deserializes(serialize_tampered([](auto& executable) { executable.global_variable_caches.clear(); })));
+}
+
+TEST_CASE(nodes_are_only_kept_for_the_cache_while_it_is_enabled)
+{
+    auto parse = [] { return JS::Parser { JS::Lexer { test_script } }.parse_program(); };
+    EXPECT(parse()->nodes_referenceable_from_bytecode().is_empty());
+
+    TemporaryCacheDirectory cache_directory;
+    EXPECT(!parse()->nodes_referenceable_from_bytecode().is_empty());
+}
+
+// A script with lots of functions that all get called once, so startup time is dominated by bytecode generation.
+static DeprecatedString make_startup_benchmark_script()
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 2000; ++i) {
+        builder.appendff(R"~~~(
+            function f{}(a, b) {{
+                let result = 0;
+                for (let i = 0; i < a; ++i) {{
+                    if (i % 3 === 0) result += b[i % b.length];
+                    else if (i % 3 === 1) result -= i;
+                    else result = result * 2 + 1;
+                }}
+                try {{ result += a.length; }} catch {{ result = -1; }}
+                return {{ result, name: "f{}" }};
+            }}
+            f{}(3, [1, 2, 3]);
+        )~~~",
+            i, i, i);
+    }
+    return builder.to_deprecated_string();
+}
+
+BENCHMARK_CASE(startup_time_cold_vs_warm)
+{
+    TemporaryCacheDirectory cache_directory;
+    auto source = make_startup_benchmark_script();
+
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    run(source);
+    auto cold = timer.elapsed_time();
+
+    timer.start();
+    run(source);
+    auto warm = timer.elapsed_time();
+
+    outln("startup_time_cold_vs_warm: cold {} ms, warm {} ms", cold.to_milliseconds(), warm.to_milliseconds());
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static void run_and_report_pauses(StringView name, StringView source)
+{
+    Vector<Duration> pauses;
+    {
+        auto vm = MUST(JS::VM::create());
+        vm->heap().on_garbage_collection_pause = [&](Duration pause) {
+            pauses.append(pause);
+        };
+
+        auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+        auto& realm = *root_execution_context->realm;
+        auto script = JS::Script::parse(source, realm, name);
+        EXPECT(!script.is_error());
+        if (script.is_error())
+            return;
+        auto result = vm->bytecode_interpreter().run(*script.value());
+        EXPECT(!result.is_error());
+
+        vm->heap().on_garbage_collection_pause = nullptr;
+    }
+
+    EXPECT(!pauses.is_empty());
+    if (pauses.is_empty())
+        return;
+
+    quick_sort(pauses);
+    auto percentile = [&](size_t percent) {
+        return pauses[min(pauses.size() - 1, pauses.size() * percent / 100)].to_microseconds();
+    };
+    Duration total;
+    for (auto pause : pauses)
+        total += pause;
+
+    outln("{}: {} collections, {} ms total, p50 {} us, p90 {} us, p99 {} us, max {} us",
+        name, pauses.size(), total.to_milliseconds(), percentile(50), percentile(90), percentile(99), pauses.last().to_microseconds());
+}
+
+// Lots of short-lived garbage next to a small set of live objects.
+BENCHMARK_CASE(short_lived_objects)
+{
+    run_and_report_pauses("short_lived_objects"sv, R"~~~(
+        for (let i = 0; i < 2000000; ++i) {
+            let temporary = { index: i, values: [i, i + 1, i + 2] };
+        }
+    )~~~"sv);
+}
+
+// The same churn on top of a large, long-lived heap, which young generation collections shouldn't have to look at.
+BENCHMARK_CASE(short_lived_objects_with_large_live_heap)
+{
+    run_and_report_pauses("short_lived_objects_with_large_live_heap"sv, R"~~~(
+        var retained = [];
+        for (let i = 0; i < 200000; ++i)
+            retained.push({ index: i, name: "object" + i });
+        for (let i = 0; i < 2000000; ++i) {
+            let temporary = { index: i, values: [i, i + 1, i + 2] };
+        }
+    )~~~"sv);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/ElapsedTimer.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static constexpr size_t iterations = 2'000'000;
+
+// Runs `source`, which is expected to perform the operation being measured `iterations` times, and reports the time per operation.
+static void run_and_report_time_per_operation(StringView name, StringView source)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+
+    auto full_source = DeprecatedString::formatted("const iterations = {};\n{}", iterations, source);
+    auto script = JS::Script::parse(full_source, realm, name);
+    EXPECT(!script.is_error());
+    if (script.is_error())
+        return;
+
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    auto result = vm->bytecode_interpreter().run(*script.value());
+    auto elapsed = timer.elapsed_time();
+    EXPECT(!result.is_error());
+
+    outln("{}: {} ns per operation", name, elapsed.to_nanoseconds() / static_cast<i64>(iterations));
+}
+
+BENCHMARK_CASE(get_by_id_monomorphic)
+{
+    run_and_report_time_per_operation("get_by_id_monomorphic"sv, R"~~~(
+        const object = { a: 1, b: 2, c: 3 };
+        let sum = 0;
+        for (let i = 0; i < iterations; ++i)
+            sum += object.c;
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(get_by_id_polymorphic)
+{
+    run_and_report_time_per_operation("get_by_id_polymorphic"sv, R"~~~(
+        const objects = [{ c: 1 }, { a: 1, c: 2 }, { a: 1, b: 2, c: 3 }, { b: 1, c: 4 }];
+        let sum = 0;
+        for (let i = 0; i < iterations; ++i)
+            sum += objects[i & 3].c;
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(put_by_id_existing_property)
+{
+    run_and_report_time_per_operation("put_by_id_existing_property"sv, R"~~~(
+        const object = { a: 1, b: 2, c: 3 };
+        for (let i = 0; i < iterations; ++i)
+            object.c = i;
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(put_by_id_polymorphic)
+{
+    run_and_report_time_per_operation("put_by_id_polymorphic"sv, R"~~~(
+        const objects = [{ c: 1 }, { a: 1, c: 2 }, { a: 1, b: 2, c: 3 }, { b: 1, c: 4 }];
+        for (let i = 0; i < iterations; ++i)
+            objects[i & 3].c = i;
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(put_by_id_in_constructor)
+{
+    run_and_report_time_per_operation("put_by_id_in_constructor"sv, R"~~~(
+        function Point(x, y, z) {
+            this.x = x;
+            this.y = y;
+            this.z = z;
+        }
+        for (let i = 0; i < iterations / 3; ++i)
+            new Point(i, i, i);
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(object_literal_construction)
+{
+    run_and_report_time_per_operation("object_literal_construction"sv, R"~~~(
+        for (let i = 0; i < iterations / 3; ++i)
+            ({ x: i, y: i, z: i });
+    )~~~"sv);
+}
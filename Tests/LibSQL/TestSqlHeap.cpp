@@ -6,11 +6,14 @@
 
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibSQL/Heap.h>
 #include <LibTest/TestCase.h>
 
 static constexpr auto db_path = "/tmp/test.db"sv;
+static constexpr auto crashed_db_path = "/tmp/test-crashed.db"sv;
+static constexpr auto crashed_wal_path = "/tmp/test-crashed.db-wal"sv;
 
 static NonnullRefPtr<SQL::Heap> create_heap()
 {
@@ -192,3 +195,108 @@ TEST_CASE(heap_free_storage)
     auto new_heap_size = MUST(heap->file_size_in_bytes());
     EXPECT(new_heap_size <= heap_size);
 }
+
+// Copies the database and its write-ahead log as they are right now, as if the process had crashed.
+static void copy_database_files_to_crashed_path(ByteBuffer const& trailing_garbage = {})
+{
+    auto copy_file = [](StringView from, StringView to, ReadonlyBytes extra_bytes) {
+        auto contents = MUST(MUST(Core::File::open(from, Core::File::OpenMode::Read))->read_until_eof());
+        auto file = MUST(Core::File::open(to, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        MUST(file->write_until_depleted(contents));
+        MUST(file->write_until_depleted(extra_bytes));
+    };
+    copy_file(db_path, crashed_db_path, {});
+    copy_file(DeprecatedString::formatted("{}-wal", db_path), crashed_wal_path, trailing_garbage);
+}
+
+TEST_CASE(heap_recover_committed_storage_after_crash)
+{
+    ScopeGuard guard([]() {
+        MUST(Core::System::unlink(db_path));
+        MUST(Core::System::unlink(crashed_db_path));
+    });
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    auto long_string = builder.string_view();
+
+    SQL::Block::Index storage_block_id;
+    {
+        auto heap = create_heap();
+        storage_block_id = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+        MUST(heap->flush());
+
+        // Neither this write nor the garbage after the last commit frame should be recovered
+        TRY_OR_FAIL(heap->write_storage(storage_block_id, "uncommitted"sv.bytes()));
+        auto garbage = MUST(ByteBuffer::create_zeroed(SQL::Block::SIZE + 100));
+        garbage.bytes().fill('g');
+        copy_database_files_to_crashed_path(garbage);
+    }
+
+    // Opening the copy recovers the log and checkpoints it into the database file
+    {
+        auto heap = MUST(SQL::Heap::create(crashed_db_path));
+        MUST(heap->open());
+        auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+        EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    }
+    EXPECT(Core::System::stat(crashed_wal_path).is_error());
+}
+
+TEST_CASE(heap_checkpoint)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    auto storage_block_id = heap->request_new_block_index();
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    auto long_string = builder.string_view();
+    TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+    MUST(heap->flush());
+
+    // Committed blocks live in the log until the next checkpoint
+    EXPECT_EQ(MUST(Core::System::stat(db_path)).st_size, 0);
+    MUST(heap->checkpoint());
+    EXPECT_EQ(static_cast<size_t>(MUST(Core::System::stat(db_path)).st_size), MUST(heap->file_size_in_bytes()));
+
+    auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+}
+
+TEST_CASE(heap_group_commit)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    heap->set_group_commit(true);
+
+    for (size_t i = 0; i < 10; ++i) {
+        auto storage_block_id = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(storage_block_id, "hello"sv.bytes()));
+        MUST(heap->flush());
+        EXPECT(heap->has_unsynced_commits());
+    }
+
+    MUST(heap->sync());
+    EXPECT(!heap->has_unsynced_commits());
+}
+
+TEST_CASE(heap_open_corrupt_file)
+{
+    ScopeGuard guard([]() {
+        MUST(Core::System::unlink(db_path));
+        (void)Core::System::unlink(DeprecatedString::formatted("{}-wal", db_path));
+    });
+
+    {
+        auto file = MUST(Core::File::open(db_path, Core::File::OpenMode::Write));
+        auto garbage = MUST(ByteBuffer::create_zeroed(SQL::Block::SIZE));
+        garbage.bytes().fill('g');
+        MUST(file->write_until_depleted(garbage));
+    }
+
+    // Destroying the heap must not try to checkpoint into the file it failed to open
+    auto heap = MUST(SQL::Heap::create(db_path));
+    EXPECT(heap->open().is_error());
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ThreadPool.h>
+#include <unistd.h>
+
+TEST_CASE(runs_all_submitted_work)
+{
+    auto pool = MUST(Threading::ThreadPool::create("Test pool"sv, 4));
+    EXPECT_EQ(pool->thread_count(), 4u);
+
+    Atomic<u32> sum = 0;
+    for (u32 i = 1; i <= 1000; ++i)
+        pool->submit([&sum, i] { sum += i; });
+    pool->wait_for_all();
+
+    EXPECT_EQ(sum.load(), 500500u);
+}
+
+TEST_CASE(work_runs_concurrently)
+{
+    auto pool = MUST(Threading::ThreadPool::create("Test pool"sv, 2));
+
+    // Each piece of work waits for the other one to start, so this only finishes if both run at once.
+    Atomic<u32> started = 0;
+    Atomic<bool> timed_out = false;
+    for (size_t i = 0; i < 2; ++i) {
+        pool->submit([&] {
+            ++started;
+            for (size_t attempt = 0; started.load() < 2; ++attempt) {
+                if (attempt == 1000) {
+                    timed_out = true;
+                    return;
+                }
+                usleep(1000);
+            }
+        });
+    }
+    pool->wait_for_all();
+
+    EXPECT(!timed_out.load());
+}
+
+TEST_CASE(destruction_finishes_queued_work)
+{
+    Atomic<u32> finished = 0;
+    {
+        auto pool = MUST(Threading::ThreadPool::create("Test pool"sv, 1));
+        for (size_t i = 0; i < 10; ++i) {
+            pool->submit([&finished] {
+                usleep(1000);
+                ++finished;
+            });
+        }
+    }
+    EXPECT_EQ(finished.load(), 10u);
+}
+
+TEST_CASE(wait_for_all_without_work)
+{
+    auto pool = MUST(Threading::ThreadPool::create("Test pool"sv));
+    EXPECT(pool->thread_count() >= 1);
+    pool->wait_for_all();
+}
@@ -4,13 +4,135 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <LibTest/TestCase.h>
 
 #include <LibVideo/Containers/Matroska/Reader.h>
 #include <LibVideo/VP9/Decoder.h>
+#include <LibVideo/VideoFrame.h>
 
-static void decode_video(StringView path, size_t expected_frame_count)
+// FNV-1a hashes of the Y, U and V planes of every decoded frame. Any change to the output of the decoder will show up
+// here, so only update these if the new output has been verified to be correct.
+static constexpr Array<u64, 25> vp9_in_webm_checksums {
+    0xc4a40d16d2ae5d17, 0x45264430ff8c6def, 0x6ebe34cf43d7f73d, 0x79f427071967e9f5,
+    0xb8b586da5fcba451, 0x101f7ecc4229d3b2, 0xa53fe88114842fe0, 0xf2f5c0f088c8c31f,
+    0x815ad844f8a673b3, 0x32d0a537d5d9bc61, 0x972e90f53e6cdf8d, 0xb95e7d1130ee3b76,
+    0xa792771adfdd87fd, 0x72f280521e2a273f, 0x853cfd26317bcaea, 0xf9087944ffee72a7,
+    0x0196734e91a9095f, 0x10e56206ec308ff5, 0x575ffe271a202624, 0x8310e9f4f43eeb3c,
+    0xcda15d2c154c41b8, 0xed0d0c8938930782, 0xb6f5cf207992296d, 0xc6a9b3f3878252d5,
+    0x6f85e5cf25b85fd1,
+};
+
+static constexpr Array<u64, 240> vp9_oob_blocks_checksums {
+    0x4315c176601f45df, 0x24404d1e5e94bec7, 0x10c5b957d6e13007, 0x10c5b957d6e13007,
+    0xa43c8e2b31f9dfd4, 0xa43c8e2b31f9dfd4, 0xa43c8e2b31f9dfd4, 0xa43c8e2b31f9dfd4,
+    0x7c7cfc638700732e, 0x7c7cfc638700732e, 0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9,
+    0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9,
+    0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9,
+    0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9,
+    0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9, 0x1e3696f6f42a52d9,
+    0xec815f60609b59f5, 0xac540ae22d7edbf9, 0x10c361adfef750ce, 0xf71c59d79c1995c2,
+    0xb243b63767b3b023, 0xc95b8c19693eb1c3, 0x65aa8bfb171d1d6d, 0x90aca3ea6522ca25,
+    0x2072ed1120184faf, 0x539decb2babb42f4, 0xcd73cce1cd671db8, 0x133f5e326af60124,
+    0x6ec1e2ab52c14a27, 0x58742f91300e266e, 0xb28806561bff2cbc, 0xbcb8229dc818ee81,
+    0x2ebcf9d94c1bfe6e, 0x2ebcf9d94c1bfe6e, 0x3d881c3e95df6eb2, 0x6eb17ca88e61bc75,
+    0x3c853cc58920b97e, 0xeb99585c7b157de2, 0xbb1afd837c768775, 0xabec254a327c84fd,
+    0x182758d52f206c9c, 0x182758d52f206c9c, 0x182758d52f206c9c, 0x182758d52f206c9c,
+    0x174bfb3a73d20723, 0x174bfb3a73d20723, 0xf1ebf0744e98ddab, 0xf1ebf0744e98ddab,
+    0x2a4302be64a7b5a4, 0x2a4302be64a7b5a4, 0x2a4302be64a7b5a4, 0x2a4302be64a7b5a4,
+    0xe06939dcbe511fb1, 0xe06939dcbe511fb1, 0x9686eaa59b06eee5, 0x9f6109ab7688e349,
+    0x15d3351db8ee9f64, 0x15d3351db8ee9f64, 0xe55813d47a1db600, 0x098a381233bf15e3,
+    0xdd51208edc6e0924, 0x8d107252f9fef9cd, 0xc5e8ed2d4bff77b9, 0x0fd742d1612c6923,
+    0x04a74b8e7ba28076, 0x8fb9346a7c96771c, 0x999972acbb6839e5, 0x4a963c527cd8309b,
+    0x0d70c025dd0c43f6, 0x0d70c025dd0c43f6, 0x0d70c025dd0c43f6, 0x0d70c025dd0c43f6,
+    0x0d70c025dd0c43f6, 0x0d70c025dd0c43f6, 0x0d70c025dd0c43f6, 0x0d70c025dd0c43f6,
+    0xb7fd8e1f47ad65d4, 0xbe442b1f8e6a18b0, 0x9e4d8862372e9ab9, 0xc55ecb6a16072b8f,
+    0x32f75e49740bc1c4, 0x32f75e49740bc1c4, 0x32f75e49740bc1c4, 0x32f75e49740bc1c4,
+    0x4f0fd1e0e7c6c90f, 0xa4d137001bd52c51, 0xad0f15b856723a09, 0xad0f15b856723a09,
+    0xf8cc7f0acecca02a, 0xf8cc7f0acecca02a, 0xf8cc7f0acecca02a, 0x9e6870200a154d7f,
+    0xce26b811400076da, 0x2abc14abd0e49b53, 0xf6458f536b997952, 0xd7873c3ddc69b2af,
+    0x5e6a56e216831c0e, 0xf6c4116f906d90de, 0xe414993345e8f119, 0x4067a6ac625487d8,
+    0xbc42ad9da37d7bf5, 0x0702607135dc6a2e, 0xc2d489116134c32f, 0xc1b93ad2e7bf0fd9,
+    0xc1b93ad2e7bf0fd9, 0xc1b93ad2e7bf0fd9, 0xc1b93ad2e7bf0fd9, 0xc1b93ad2e7bf0fd9,
+    0x777a27189e9465a5, 0x777a27189e9465a5, 0x777a27189e9465a5, 0x777a27189e9465a5,
+    0x777a27189e9465a5, 0x777a27189e9465a5, 0x777a27189e9465a5, 0x777a27189e9465a5,
+    0x1af94e2a32cdbb15, 0x1af94e2a32cdbb15, 0xa95cfdf7ed3a7108, 0x598dfcc11b25715d,
+    0xd2f94c9bb3481800, 0xa00739cdbde0b615, 0xbc330a56baa5a578, 0xbc330a56baa5a578,
+    0x7bb05ea616200ccd, 0x72b7a59b3ace3919, 0x302b5700b67f3c75, 0xfe3e453ebd3ff483,
+    0x6a2b2aacc73e0dca, 0xc474f114f595a47c, 0x41d954cbcc7eb118, 0x54bcb2bbdac4a149,
+    0x2f8a95e8ef2cd0cb, 0x145c357c08e7af4d, 0xc117f6ce06a6c261, 0x2d50953c79ee7539,
+    0x193ad4f123503b8d, 0x193ad4f123503b8d, 0xa4bbd7af81d8e400, 0x40895d6df54877e5,
+    0x40895d6df54877e5, 0x9b7fceacfa10f7de, 0x9b7fceacfa10f7de, 0x9b7fceacfa10f7de,
+    0x99bbfb57ee4711e9, 0x99bbfb57ee4711e9, 0x2ebe5f791ad819c1, 0x2ebe5f791ad819c1,
+    0xde648ea9d594937d, 0xde648ea9d594937d, 0xde648ea9d594937d, 0xde648ea9d594937d,
+    0xde648ea9d594937d, 0xde648ea9d594937d, 0xde648ea9d594937d, 0xde648ea9d594937d,
+    0xde648ea9d594937d, 0xde648ea9d594937d, 0xde648ea9d594937d, 0xde648ea9d594937d,
+    0xde648ea9d594937d, 0xde648ea9d594937d, 0x193c0627483c2515, 0x193c0627483c2515,
+    0x193c0627483c2515, 0x193c0627483c2515, 0x193c0627483c2515, 0x193c0627483c2515,
+    0x2a3f5c10e0a284f8, 0x2a3f5c10e0a284f8, 0x2a3f5c10e0a284f8, 0x2a3f5c10e0a284f8,
+    0xa46e400a912cf048, 0xa46e400a912cf048, 0xa46e400a912cf048, 0xa46e400a912cf048,
+    0xa46e400a912cf048, 0xa46e400a912cf048, 0xa46e400a912cf048, 0xa46e400a912cf048,
+    0xa46e400a912cf048, 0xa46e400a912cf048, 0xa46e400a912cf048, 0xa46e400a912cf048,
+    0xa46e400a912cf048, 0xe3579ee5f66610fd, 0xe3579ee5f66610fd, 0xe3579ee5f66610fd,
+    0xe3579ee5f66610fd, 0xe3579ee5f66610fd, 0xe3579ee5f66610fd, 0x1235ad6f0085bba5,
+    0xe4df75d26ded57a5, 0xe4df75d26ded57a5, 0xe4df75d26ded57a5, 0xe4df75d26ded57a5,
+    0x8c2cde3740837446, 0x8c2cde3740837446, 0x8c2cde3740837446, 0x8c2cde3740837446,
+    0x8c2cde3740837446, 0x8c2cde3740837446, 0x3b0b55ab82debe29, 0x24601d5cac5f8337,
+    0x72a359a4d6d92c5f, 0x8729204a54f2bb8a, 0x75e378369957e117, 0xd882022ce1d9fc8a,
+    0x036d61373135d90e, 0x036d61373135d90e, 0x036d61373135d90e, 0x036d61373135d90e,
+    0x24cf207060b17bf3, 0x24cf207060b17bf3, 0x24cf207060b17bf3, 0x24cf207060b17bf3,
+    0xbcd6d5872ac39f89, 0xbcd6d5872ac39f89, 0xbcd6d5872ac39f89, 0xbcd6d5872ac39f89,
+    0x5a224a1785b071e3, 0x5a224a1785b071e3, 0x5a224a1785b071e3, 0x5a224a1785b071e3,
+    0x5a224a1785b071e3, 0x5a224a1785b071e3, 0xa576d4a5fa9c760b, 0xa576d4a5fa9c760b,
+};
+
+static constexpr Array<u64, 2> vp9_4k_checksums {
+    0x3d88896aeedef147, 0x62036bff7074ec16,
+};
+
+static constexpr Array<u64, 92> vp9_clamp_reference_mvs_checksums {
+    0x2b0d056acc544bbd, 0x721c8e827f3164f4, 0xa2f995dbde89dbec, 0x949fd65b5a69dc83,
+    0x903055a5ad3ab909, 0x32e9ea33a493951e, 0x6185a7f1fd7fc9ca, 0x430dd0cdcbc995be,
+    0xe3a5fc63c949595d, 0x4f894ac3328f8b5c, 0x483f69d702cb8745, 0x5f2eb8d837f3457c,
+    0x82731d64cb263ff3, 0x74068320e57ec851, 0xfbf6f79df1e1a612, 0x9102af987c4fe7c0,
+    0x71c0edaf36234840, 0xc2df318b19baf212, 0xf3c7e7a972d92371, 0x935a6125a47ae8b9,
+    0x40573feadb61db8e, 0x072de26e80af8f1a, 0x11aaba3e10d25c42, 0x0ebedd0fe52304c2,
+    0x6259296f553b9a07, 0x46968f30e51d30ee, 0x174134c50a59aba6, 0x174134c50a59aba6,
+    0x36d42c80d7aba291, 0xfe34d29ca7d43c86, 0x63b1d2fefc6a34b8, 0x9d8ab99be91a58fb,
+    0xe762f54154f55a0a, 0x98ecbee4d345884e, 0xb3e1ad4a87e7d387, 0x0cd23f5b7ef986f8,
+    0x6efed5d632e2746a, 0x79ed39df95a0c2c9, 0x85062c0d6ecf7265, 0x6a638fd458ad0683,
+    0x647e532ef010525b, 0x319c22b6606eae00, 0x09879131143cd619, 0xf12e3a2576c2b416,
+    0x5c796715f4dc943b, 0xd6240478433a710c, 0x2e8066d36fa01ae0, 0x27ef7df20ebe90f3,
+    0x5d5d82a2417144ff, 0x05143dd798245a50, 0x615185bafdd91789, 0xee0abf9218d8734d,
+    0xbbabcc3099034b70, 0x93796e47a2b852c7, 0x649e393f50d9f992, 0x88f4269549797306,
+    0x3b7ac62d39a26f5f, 0xb0a097a6585e417b, 0xd1bdd7854ae47a2c, 0x71bdcd11dcd72e62,
+    0xe05d0f162b8d258a, 0x955daf0cd33f17fe, 0xf8cc1a91078ff7fa, 0x6bfbc695b4bf4855,
+    0x9f8eec7802190fef, 0x6b8d59c2b546d613, 0x0226de436a044e91, 0xf6378908d5ab238c,
+    0x036bf20c78be85ca, 0x0c99a35b18078f07, 0x6db0cd3ee7c8fefe, 0x5829a6b387b81c21,
+    0xd0ab32777acfd0aa, 0x989da9415b71ecef, 0xc78b6d18be3f2b1d, 0xfa36f1f360bddcc1,
+    0x741a89fc60196653, 0x6433527327979b90, 0xf4b73c82b7987615, 0xc40ffd14e62939b7,
+    0x7fd3d04db840a3d5, 0x12b3b797a80c61aa, 0xc4bc7a96dba95f4b, 0xa76a5ab571c4d506,
+    0xef4f04555f5370ee, 0xc74e0281dc2453ec, 0x6a8a0f246f1a0f2e, 0x8f1723b57fa70f97,
+    0xd211d6a5372c07da, 0x8f166e28bfe2e83f, 0xf76bfb428ace13d0, 0x71ee2ae80a58d6e9,
+};
+
+static u64 checksum_frame(Video::VideoFrame const& frame)
+{
+    auto const& yuv_frame = static_cast<Video::SubsampledYUVFrame const&>(frame);
+    u64 hash = 14695981039346656037ull;
+    for (auto plane : { yuv_frame.plane_y(), yuv_frame.plane_u(), yuv_frame.plane_v() }) {
+        for (auto sample : plane) {
+            hash ^= sample;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+static void decode_video(StringView path, ReadonlySpan<u64> expected_frame_checksums)
 {
+    auto expected_frame_count = expected_frame_checksums.size();
+
     auto matroska_reader = MUST(Video::Matroska::Reader::from_file(path));
     u64 video_track = 0;
     MUST(matroska_reader.for_each_track_of_type(Video::Matroska::TrackEntry::TrackType::Video, [&](Video::Matroska::TrackEntry const& track_entry) -> Video::DecoderErrorOr<IterationDecision> {
@@ -21,12 +143,14 @@ static void decode_video(StringView path, size_t expected_frame_count)
 
     auto iterator = MUST(matroska_reader.create_sample_iterator(video_track));
     size_t frame_count = 0;
+    size_t decoded_frame_count = 0;
     Video::VP9::Decoder vp9_decoder;
 
     while (frame_count <= expected_frame_count) {
         auto block_result = iterator.next_block();
         if (block_result.is_error() && block_result.error().category() == Video::DecoderErrorCategory::EndOfStream) {
             VERIFY(frame_count == expected_frame_count);
+            EXPECT_EQ(decoded_frame_count, expected_frame_count);
             return;
         }
 
@@ -41,6 +165,13 @@ static void decode_video(StringView path, size_t expected_frame_count)
                     }
                     VERIFY_NOT_REACHED();
                 }
+
+                if (decoded_frame_count < expected_frame_count) {
+                    auto checksum = checksum_frame(*frame_result.value());
+                    if (checksum != expected_frame_checksums[decoded_frame_count])
+                        FAIL(DeprecatedString::formatted("Frame {} of {} has checksum {:#016x}, expected {:#016x}", decoded_frame_count, path, checksum, expected_frame_checksums[decoded_frame_count]));
+                }
+                decoded_frame_count++;
             }
             frame_count++;
         }
@@ -51,20 +182,20 @@ static void decode_video(StringView path, size_t expected_frame_count)
 
 TEST_CASE(webm_in_vp9)
 {
-    decode_video("./vp9_in_webm.webm"sv, 25);
+    decode_video("./vp9_in_webm.webm"sv, vp9_in_webm_checksums);
 }
 
 TEST_CASE(vp9_oob_blocks)
 {
-    decode_video("./vp9_oob_blocks.webm"sv, 240);
+    decode_video("./vp9_oob_blocks.webm"sv, vp9_oob_blocks_checksums);
 }
 
 BENCHMARK_CASE(vp9_4k)
 {
-    decode_video("./vp9_4k.webm"sv, 2);
+    decode_video("./vp9_4k.webm"sv, vp9_4k_checksums);
 }
 
 BENCHMARK_CASE(vp9_clamp_reference_mvs)
 {
-    decode_video("./vp9_clamp_reference_mvs.webm"sv, 92);
+    decode_video("./vp9_clamp_reference_mvs.webm"sv, vp9_clamp_reference_mvs_checksums);
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/CSS/CountingBloomFilter.h>
+#include <LibWeb/CSS/Selector.h>
+
+namespace Web::CSS {
+
+static Selector::CompoundSelector compound(Selector::Combinator combinator, Selector::SimpleSelector::Type type, StringView name)
+{
+    Selector::SimpleSelector simple_selector { .type = type };
+    if (type == Selector::SimpleSelector::Type::TagName)
+        simple_selector.value = Selector::SimpleSelector::QualifiedName { .name = MUST(FlyString::from_utf8(name)) };
+    else
+        simple_selector.value = Selector::SimpleSelector::Name { MUST(FlyString::from_utf8(name)) };
+    return { combinator, { move(simple_selector) } };
+}
+
+TEST_CASE(counting_bloom_filter)
+{
+    CountingBloomFilter<u8, 12> filter;
+    EXPECT(!filter.may_contain(0x12345678));
+
+    filter.increment(0x12345678);
+    filter.increment(0x12345678);
+    EXPECT(filter.may_contain(0x12345678));
+
+    filter.decrement(0x12345678);
+    EXPECT(filter.may_contain(0x12345678));
+    filter.decrement(0x12345678);
+    EXPECT(!filter.may_contain(0x12345678));
+}
+
+TEST_CASE(counting_bloom_filter_saturates)
+{
+    CountingBloomFilter<u8, 12> filter;
+    for (size_t i = 0; i < 300; ++i)
+        filter.increment(42);
+    for (size_t i = 0; i < 300; ++i)
+        filter.decrement(42);
+
+    // A saturated counter no longer knows how many keys it holds, so it must stay set.
+    EXPECT(filter.may_contain(42));
+}
+
+TEST_CASE(ancestor_hashes_of_descendant_and_child_combinators)
+{
+    // div #bar span
+    auto selector = Selector::create({
+        compound(Selector::Combinator::None, Selector::SimpleSelector::Type::TagName, "div"sv),
+        compound(Selector::Combinator::Descendant, Selector::SimpleSelector::Type::Id, "bar"sv),
+        compound(Selector::Combinator::Descendant, Selector::SimpleSelector::Type::TagName, "span"sv),
+    });
+
+    auto const& hashes = selector->ancestor_hashes();
+    EXPECT_EQ(hashes[0], ancestor_filter_hash(AncestorFilterHashType::Id, "bar"sv));
+    EXPECT_EQ(hashes[1], ancestor_filter_hash(AncestorFilterHashType::TagName, "div"sv));
+    EXPECT_EQ(hashes[2], 0u);
+}
+
+TEST_CASE(ancestor_hashes_skip_sibling_compounds)
+{
+    // .a .b + span
+    auto selector = Selector::create({
+        compound(Selector::Combinator::None, Selector::SimpleSelector::Type::Class, "a"sv),
+        compound(Selector::Combinator::Descendant, Selector::SimpleSelector::Type::Class, "b"sv),
+        compound(Selector::Combinator::NextSibling, Selector::SimpleSelector::Type::TagName, "span"sv),
+    });
+
+    // .b is a sibling of the subject, but .a is still one of its ancestors.
+    auto const& hashes = selector->ancestor_hashes();
+    EXPECT_EQ(hashes[0], ancestor_filter_hash(AncestorFilterHashType::Class, "a"sv));
+    EXPECT_EQ(hashes[1], 0u);
+}
+
+TEST_CASE(ancestor_filter_hash_is_case_insensitive)
+{
+    EXPECT_EQ(ancestor_filter_hash(AncestorFilterHashType::TagName, "DIV"sv), ancestor_filter_hash(AncestorFilterHashType::TagName, "div"sv));
+    EXPECT_NE(ancestor_filter_hash(AncestorFilterHashType::TagName, "foo"sv), ancestor_filter_hash(AncestorFilterHashType::Class, "foo"sv));
+}
+
+}
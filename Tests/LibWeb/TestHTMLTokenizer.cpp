@@ -86,6 +86,40 @@ static Vector<Token> run_tokenizer(StringView input)
     return tokens;
 }
 
+// Feeds the input to the tokenizer in chunks of (about) chunk_size bytes, tokenizing what's there after each one.
+static void tokenize_incrementally(StringView input, size_t chunk_size, Function<void(Token)> const& callback)
+{
+    Tokenizer tokenizer;
+    tokenizer.open_input_stream();
+    auto tokenize_available_input = [&] {
+        while (true) {
+            auto maybe_token = tokenizer.next_token();
+            if (!maybe_token.has_value())
+                break;
+            callback(maybe_token.release_value());
+        }
+    };
+    for (size_t offset = 0; offset < input.length();) {
+        auto chunk_end = min(offset + chunk_size, input.length());
+        while (chunk_end < input.length() && (static_cast<u8>(input[chunk_end]) & 0xC0) == 0x80)
+            ++chunk_end;
+        tokenizer.append_to_input_stream(input.substring_view(offset, chunk_end - offset));
+        tokenize_available_input();
+        offset = chunk_end;
+    }
+    tokenizer.close_input_stream();
+    tokenize_available_input();
+}
+
+static Vector<Token> run_tokenizer_incrementally(StringView input, size_t chunk_size)
+{
+    Vector<Token> tokens;
+    tokenize_incrementally(input, chunk_size, [&](Token token) {
+        tokens.append(move(token));
+    });
+    return tokens;
+}
+
 // FIXME: It's not very nice to rely on the format of HTMLToken::to_string() to stay the same.
 static u32 hash_tokens(Vector<Token> const& tokens)
 {
@@ -210,6 +244,36 @@ TEST_CASE(comment)
     END_ENUMERATION();
 }
 
+TEST_CASE(long_runs_of_characters)
+{
+    auto tokens = run_tokenizer("<p title=\"a long attribute value &amp; more\r\n\">Some text that is long enough\r\nto span a few blocks &lt;\0 \xc3\xa9t\xc3\xa9</p>"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 1u);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(title, "a long attribute value & more\n", 3u, 8u, 9u, 1u);
+    EXPECT_CHARACTER_TOKENS(Some text that is long enough);
+    EXPECT_CHARACTER_TOKEN('\n');
+    EXPECT_CHARACTER_TOKENS(to span a few blocks);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKEN('<');
+    EXPECT_CHARACTER_TOKEN(0);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKEN(0xE9);
+    EXPECT_CHARACTER_TOKEN('t');
+    EXPECT_CHARACTER_TOKEN(0xE9);
+    EXPECT_END_TAG_TOKEN(p, 32u, 33u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(incremental_input)
+{
+    auto input = "<!DOCTYPE html>\r\n<html><!-- comment -->\r<body class='a b'>Text &CounterClockwiseContourIntegral; &amp &notit; \xc3\xa9\r\n"
+                 "<a href=\"?x=1&y=2\">link</a><script>if (a < b) document.write('</p>');</script><![CDATA[x]]></body></html>"sv;
+    auto expected_hash = hash_tokens(run_tokenizer(input));
+    for (size_t chunk_size = 1; chunk_size <= 64; ++chunk_size)
+        EXPECT_EQ(hash_tokens(run_tokenizer_incrementally(input, chunk_size)), expected_hash);
+}
+
 TEST_CASE(doctype)
 {
     auto tokens = run_tokenizer("<!DOCTYPE html><html></html>"sv);
@@ -239,3 +303,36 @@ TEST_CASE(regression)
     u32 hash = hash_tokens(tokens);
     EXPECT_EQ(hash, 3657343287u);
 }
+
+static DeprecatedString make_large_document()
+{
+    StringBuilder builder;
+    builder.append("<!DOCTYPE html><html><head><title>Tokenizer benchmark</title></head><body>\n"sv);
+    for (size_t i = 0; builder.length() < 8 * MiB; ++i) {
+        builder.appendff("<div class=\"item item-{}\" data-index=\"{}\"><p>Paragraph number {}, which contains some text, "
+                         "a <a href=\"/items/{}?sort=name&amp;order=asc\">link</a> and a few &quot;entities&quot;.</p></div>\n",
+            i % 10, i, i, i);
+    }
+    builder.append("</body></html>\n"sv);
+    return builder.to_deprecated_string();
+}
+
+BENCHMARK_CASE(tokenize_large_document)
+{
+    auto input = make_large_document();
+    size_t token_count = 0;
+    Tokenizer tokenizer { input, "UTF-8"sv };
+    while (tokenizer.next_token().has_value())
+        ++token_count;
+    EXPECT_NE(token_count, 0u);
+}
+
+BENCHMARK_CASE(tokenize_large_document_incrementally)
+{
+    auto input = make_large_document();
+    size_t token_count = 0;
+    tokenize_incrementally(input, 64 * KiB, [&](Token) {
+        ++token_count;
+    });
+    EXPECT_NE(token_count, 0u);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Path.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+
+namespace Web::Painting {
+
+// Not a multiple of the tile size, so the last row and column of tiles are partial.
+static constexpr Gfx::IntSize target_size { 700, 600 };
+
+static void record_scene(RecordingPainter& painter, Color accent)
+{
+    painter.clear_rect({ {}, target_size }, Color::White);
+
+    // Everything below straddles at least one tile edge.
+    painter.fill_rect({ 200, 200, 120, 120 }, accent);
+    painter.draw_rect({ 240, 10, 40, 500 }, Color::Blue);
+    painter.fill_rect_with_rounded_corners({ 230, 230, 80, 90 }, Color::Green, 10, 20, 30, 15);
+    painter.fill_ellipse({ 480, 220, 100, 80 }, Color::Magenta);
+    painter.draw_ellipse({ 100, 400, 300, 150 }, Color::Black, 3);
+
+    painter.draw_line({ 0, 0 }, { 699, 599 }, Color::Black);
+    painter.draw_line({ 10, 590 }, { 690, 20 }, Color::Red, 5);
+    painter.draw_line({ 5, 256 }, { 695, 256 }, Color::Cyan, 3, Gfx::Painter::LineStyle::Dashed);
+    painter.draw_line({ 250, 5 }, { 250, 595 }, Color::DarkGray, 2, Gfx::Painter::LineStyle::Dotted);
+    painter.draw_triangle_wave({ 20, 520 }, { 680, 520 }, Color::Red, 3, 1);
+
+    Gfx::Path path;
+    path.move_to({ 150, 150 });
+    path.line_to({ 400, 180 });
+    path.quadratic_bezier_curve_to({ 450, 400 }, { 300, 420 });
+    path.close();
+    painter.fill_path({ .path = path, .color = Color::Yellow, .winding_rule = Gfx::Painter::WindingRule::EvenOdd });
+    painter.stroke_path({ .path = path, .color = Color::Black, .thickness = 2.5f });
+
+    painter.save();
+    painter.add_clip_rect({ 500, 400, 150, 150 });
+    painter.translate(20, 30);
+    painter.fill_rect({ 450, 350, 200, 200 }, Color::from_rgb(0x336699));
+    painter.restore();
+
+    // A translucent stacking context is painted into its own bitmap and blended back in every tile it touches.
+    Gfx::FloatRect stacking_context_rect { 180, 60, 200, 240 };
+    painter.push_stacking_context({
+        .semitransparent_or_has_non_identity_transform = true,
+        .has_fixed_position = false,
+        .opacity = 0.5f,
+        .source_rect = stacking_context_rect,
+        .transformed_destination_rect = stacking_context_rect,
+        .painter_location = { 180, 60 },
+    });
+    painter.fill_rect({ 0, 0, 200, 240 }, Color::Red);
+    painter.fill_rect_with_rounded_corners({ 20, 20, 160, 200 }, accent, 40);
+    painter.pop_stacking_context({
+        .semitransparent_or_has_non_identity_transform = true,
+        .scaling_mode = Gfx::Painter::ScalingMode::NearestNeighbor,
+    });
+}
+
+static NonnullRefPtr<Gfx::Bitmap> paint_serially(Color accent)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, target_size));
+    RecordingPainter painter;
+    record_scene(painter, accent);
+    painter.execute(*bitmap);
+    return bitmap;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> paint_in_tiles(TiledCommandExecutor& executor, Color accent)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, target_size));
+    RecordingPainter painter;
+    record_scene(painter, accent);
+    painter.execute_tiled(*bitmap, executor);
+    return bitmap;
+}
+
+static void expect_identical(Gfx::Bitmap const& expected, Gfx::Bitmap const& actual)
+{
+    for (int y = 0; y < target_size.height(); ++y) {
+        for (int x = 0; x < target_size.width(); ++x) {
+            if (expected.scanline(y)[x] != actual.scanline(y)[x]) {
+                FAIL(DeprecatedString::formatted("Pixel at {},{} is {:08x} when painted in tiles, but {:08x} when painted serially",
+                    x, y, actual.scanline(y)[x], expected.scanline(y)[x]));
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(tiled_painting_matches_serial_painting)
+{
+    auto executor = MUST(TiledCommandExecutor::create(4));
+    auto serial = paint_serially(Color::from_rgb(0xff8800));
+    auto tiled = paint_in_tiles(*executor, Color::from_rgb(0xff8800));
+
+    EXPECT(!executor->statistics().painted_without_tiles);
+    EXPECT_EQ(executor->statistics().retained_tiles, 0u);
+    expect_identical(*serial, *tiled);
+}
+
+TEST_CASE(retained_tiles_match_serial_painting)
+{
+    auto executor = MUST(TiledCommandExecutor::create(4));
+    (void)paint_in_tiles(*executor, Color::from_rgb(0xff8800));
+
+    // Only the tiles under the accent colored shapes have changed, the rest are reused from the previous frame.
+    auto serial = paint_serially(Color::from_rgb(0x0088ff));
+    auto tiled = paint_in_tiles(*executor, Color::from_rgb(0x0088ff));
+
+    EXPECT(!executor->statistics().painted_without_tiles);
+    EXPECT(executor->statistics().retained_tiles > 0);
+    EXPECT(executor->statistics().painted_tiles > 0);
+    expect_identical(*serial, *tiled);
+}
+
+TEST_CASE(single_threaded_tiled_painting_matches_serial_painting)
+{
+    auto executor = MUST(TiledCommandExecutor::create(1));
+    auto serial = paint_serially(Color::from_rgb(0xff8800));
+    auto tiled = paint_in_tiles(*executor, Color::from_rgb(0xff8800));
+
+    EXPECT(!executor->statistics().painted_without_tiles);
+    expect_identical(*serial, *tiled);
+}
+
+}
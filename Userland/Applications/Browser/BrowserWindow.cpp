@@ -372,6 +372,11 @@ void BrowserWindow::build_menus()
             active_tab().view().debug_request("dump-all-resolved-styles");
         },
         this));
+    debug_menu->add_action(GUI::Action::create(
+        "Dump Style &Recalc Statistics", g_icon_bag.filetype_css, [this](auto&) {
+            active_tab().view().debug_request("dump-style-recalc-statistics");
+        },
+        this));
     debug_menu->add_action(GUI::Action::create("Dump &History", { Mod_Ctrl, Key_H }, g_icon_bag.history, [this](auto&) {
         active_tab().m_history.dump();
     }));
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/BuiltinWrappers.h>
 #include <AK/Debug.h>
 #include <AK/ScopedValueRollback.h>
@@ -93,8 +94,12 @@ struct MemoryAuditingSuppressor {
     }
 };
 
+// NOTE: Some counters are bumped without holding s_malloc_mutex (on the thread cache paths, or
+//       before we know whether we need the lock), so those have to be atomic.
+using LocklessMallocStat = Atomic<size_t, AK::MemoryOrder::memory_order_relaxed>;
+
 struct MallocStats {
-    size_t number_of_malloc_calls;
+    LocklessMallocStat number_of_malloc_calls;
 
     size_t number_of_big_allocator_hits;
     size_t number_of_big_allocator_purge_hits;
@@ -106,7 +111,7 @@ struct MallocStats {
     size_t number_of_block_allocs;
     size_t number_of_blocks_full;
 
-    size_t number_of_free_calls;
+    LocklessMallocStat number_of_free_calls;
 
     size_t number_of_big_allocator_keeps;
     size_t number_of_big_allocator_frees;
@@ -115,6 +120,11 @@ struct MallocStats {
     size_t number_of_hot_keeps;
     size_t number_of_cold_keeps;
     size_t number_of_frees;
+
+    LocklessMallocStat number_of_thread_cache_hits;
+    size_t number_of_thread_cache_refills;
+    LocklessMallocStat number_of_thread_cache_keeps;
+    size_t number_of_thread_cache_flushes;
 };
 static MallocStats g_malloc_stats = {};
 
@@ -293,6 +303,217 @@ enum class CallerWillInitializeMemory {
 __thread bool s_allocation_enabled = true;
 #endif
 
+static ErrorOr<void*> allocate_chunk(Allocator& allocator, size_t good_size, size_t align)
+{
+    ChunkedBlock* block = nullptr;
+    void* ptr = nullptr;
+    for (auto& current : allocator.usable_blocks) {
+        if (current.free_chunks()) {
+            ptr = try_allocate_chunk_aligned(align, current);
+            if (ptr) {
+                block = &current;
+                break;
+            }
+        }
+    }
+
+    if (!block && s_hot_empty_block_count) {
+        g_malloc_stats.number_of_hot_empty_block_hits++;
+        block = s_hot_empty_blocks[--s_hot_empty_block_count];
+        if (block->m_size != good_size) {
+            new (block) ChunkedBlock(good_size);
+            ue_notify_chunk_size_changed(block, good_size);
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
+            set_mmap_name(block, ChunkedBlock::block_size, buffer);
+        }
+        allocator.usable_blocks.append(*block);
+    }
+
+    if (!block && s_cold_empty_block_count) {
+        g_malloc_stats.number_of_cold_empty_block_hits++;
+        block = s_cold_empty_blocks[--s_cold_empty_block_count];
+        int rc = madvise(block, ChunkedBlock::block_size, MADV_SET_NONVOLATILE);
+        bool this_block_was_purged = rc == 1;
+        if (rc < 0) {
+            perror("madvise");
+            VERIFY_NOT_REACHED();
+        }
+        rc = mprotect(block, ChunkedBlock::block_size, PROT_READ | PROT_WRITE);
+        if (rc < 0) {
+            perror("mprotect");
+            VERIFY_NOT_REACHED();
+        }
+        if (this_block_was_purged || block->m_size != good_size) {
+            if (this_block_was_purged)
+                g_malloc_stats.number_of_cold_empty_block_purge_hits++;
+            new (block) ChunkedBlock(good_size);
+            ue_notify_chunk_size_changed(block, good_size);
+        }
+        allocator.usable_blocks.append(*block);
+    }
+
+    if (!block) {
+        g_malloc_stats.number_of_block_allocs++;
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
+        block = (ChunkedBlock*)TRY(os_alloc(ChunkedBlock::block_size, buffer));
+        new (block) ChunkedBlock(good_size);
+        allocator.usable_blocks.append(*block);
+        ++allocator.block_count;
+    }
+
+    if (!ptr) {
+        ptr = try_allocate_chunk_aligned(align, *block);
+    }
+
+    VERIFY(ptr);
+    if (block->is_full()) {
+        g_malloc_stats.number_of_blocks_full++;
+        dbgln_if(MALLOC_DEBUG, "Block {:p} is now full in size class {}", block, good_size);
+        allocator.usable_blocks.remove(*block);
+        allocator.full_blocks.append(*block);
+    }
+    return ptr;
+}
+
+static void free_chunk(ChunkedBlock* block, void* ptr)
+{
+    auto* entry = (FreelistEntry*)ptr;
+    entry->next = block->m_freelist;
+    block->m_freelist = entry;
+
+    if (block->is_full()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block->m_size, good_size);
+        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", block, good_size);
+        g_malloc_stats.number_of_freed_full_blocks++;
+        allocator->full_blocks.remove(*block);
+        allocator->usable_blocks.prepend(*block);
+    }
+
+    ++block->m_free_chunks;
+
+    if (!block->used_chunks()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block->m_size, good_size);
+        if (s_hot_empty_block_count < number_of_hot_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", block);
+            g_malloc_stats.number_of_hot_keeps++;
+            allocator->usable_blocks.remove(*block);
+            s_hot_empty_blocks[s_hot_empty_block_count++] = block;
+            return;
+        }
+        if (s_cold_empty_block_count < number_of_cold_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", block);
+            g_malloc_stats.number_of_cold_keeps++;
+            allocator->usable_blocks.remove(*block);
+            s_cold_empty_blocks[s_cold_empty_block_count++] = block;
+            mprotect(block, ChunkedBlock::block_size, PROT_NONE);
+            madvise(block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
+            return;
+        }
+        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", block, good_size);
+        g_malloc_stats.number_of_frees++;
+        allocator->usable_blocks.remove(*block);
+        --allocator->block_count;
+        os_free(block, ChunkedBlock::block_size);
+    }
+}
+
+#ifndef NO_TLS
+// Each thread keeps a small cache of free chunks for the smallest size classes,
+// so that the common malloc() and free() paths don't have to take s_malloc_mutex.
+// Chunks sitting in a thread cache are still accounted as used by their block.
+// Caches are refilled from and returned to the shared allocators in batches.
+static constexpr size_t number_of_thread_cached_size_classes = 7; // Up to 1008 byte chunks.
+static constexpr size_t thread_cache_capacity = 32;
+static constexpr size_t thread_cache_batch_size = thread_cache_capacity / 2;
+static_assert(number_of_thread_cached_size_classes <= num_size_classes);
+
+static bool s_thread_cache_enabled = true;
+
+struct ThreadCacheBin {
+    FreelistEntry* chunks;
+    size_t count;
+};
+
+static __thread ThreadCacheBin s_thread_cache_bins[number_of_thread_cached_size_classes];
+
+static inline ThreadCacheBin* thread_cache_bin_for_chunk_size(size_t bytes_per_chunk)
+{
+    if (!s_thread_cache_enabled)
+        return nullptr;
+    for (size_t i = 0; i < number_of_thread_cached_size_classes; ++i) {
+        if (size_classes[i] == bytes_per_chunk)
+            return &s_thread_cache_bins[i];
+    }
+    return nullptr;
+}
+
+static ErrorOr<void*> thread_cache_allocate(ThreadCacheBin& bin, Allocator& allocator)
+{
+    if (!bin.count) {
+        PthreadMutexLocker locker(s_malloc_mutex);
+        g_malloc_stats.number_of_thread_cache_refills++;
+        for (size_t i = 0; i < thread_cache_batch_size; ++i) {
+            auto ptr_or_error = allocate_chunk(allocator, allocator.size, 16);
+            if (ptr_or_error.is_error()) {
+                if (!bin.count)
+                    return ptr_or_error.release_error();
+                break;
+            }
+            auto* entry = (FreelistEntry*)ptr_or_error.value();
+            entry->next = bin.chunks;
+            bin.chunks = entry;
+            ++bin.count;
+        }
+    } else {
+        g_malloc_stats.number_of_thread_cache_hits++;
+    }
+
+    auto* entry = bin.chunks;
+    bin.chunks = entry->next;
+    --bin.count;
+    return entry;
+}
+
+// Returns the oldest `count` chunks of the bin to their blocks. Must be called with s_malloc_mutex held.
+static void thread_cache_flush(ThreadCacheBin& bin, size_t count)
+{
+    VERIFY(count <= bin.count);
+    auto** entry = &bin.chunks;
+    for (size_t i = count; i < bin.count; ++i)
+        entry = &(*entry)->next;
+
+    auto* chunk = *entry;
+    *entry = nullptr;
+    bin.count -= count;
+
+    while (chunk) {
+        auto* next = chunk->next;
+        auto* block = (ChunkedBlock*)((FlatPtr)chunk & ChunkedBlock::block_mask);
+        free_chunk(block, chunk);
+        chunk = next;
+    }
+}
+
+static void thread_cache_deallocate(ThreadCacheBin& bin, void* ptr)
+{
+    auto* entry = (FreelistEntry*)ptr;
+    entry->next = bin.chunks;
+    bin.chunks = entry;
+    ++bin.count;
+    g_malloc_stats.number_of_thread_cache_keeps++;
+
+    if (bin.count > thread_cache_capacity) {
+        PthreadMutexLocker locker(s_malloc_mutex);
+        g_malloc_stats.number_of_thread_cache_flushes++;
+        thread_cache_flush(bin, thread_cache_batch_size);
+    }
+}
+#endif
+
 static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializeMemory caller_will_initialize_memory)
 {
 #ifndef NO_TLS
@@ -321,6 +542,22 @@ static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializ
     size_t good_size;
     auto* allocator = allocator_for_size(size, good_size, align);
 
+#ifndef NO_TLS
+    // Every chunk of a standard size class is 16-byte aligned.
+    if (allocator && align <= 16) {
+        if (auto* bin = thread_cache_bin_for_chunk_size(good_size)) {
+            auto* ptr = TRY(thread_cache_allocate(*bin, *allocator));
+            dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} from thread cache (size {})", ptr, good_size);
+
+            if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
+                memset(ptr, MALLOC_SCRUB_BYTE, good_size);
+
+            ue_notify_malloc(ptr, size);
+            return ptr;
+        }
+    }
+#endif
+
     PthreadMutexLocker locker(s_malloc_mutex);
 
     if (!allocator) {
@@ -365,75 +602,8 @@ static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializ
         return ptr;
     }
 
-    ChunkedBlock* block = nullptr;
-    void* ptr = nullptr;
-    for (auto& current : allocator->usable_blocks) {
-        if (current.free_chunks()) {
-            ptr = try_allocate_chunk_aligned(align, current);
-            if (ptr) {
-                block = &current;
-                break;
-            }
-        }
-    }
-
-    if (!block && s_hot_empty_block_count) {
-        g_malloc_stats.number_of_hot_empty_block_hits++;
-        block = s_hot_empty_blocks[--s_hot_empty_block_count];
-        if (block->m_size != good_size) {
-            new (block) ChunkedBlock(good_size);
-            ue_notify_chunk_size_changed(block, good_size);
-            char buffer[64];
-            snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
-            set_mmap_name(block, ChunkedBlock::block_size, buffer);
-        }
-        allocator->usable_blocks.append(*block);
-    }
-
-    if (!block && s_cold_empty_block_count) {
-        g_malloc_stats.number_of_cold_empty_block_hits++;
-        block = s_cold_empty_blocks[--s_cold_empty_block_count];
-        int rc = madvise(block, ChunkedBlock::block_size, MADV_SET_NONVOLATILE);
-        bool this_block_was_purged = rc == 1;
-        if (rc < 0) {
-            perror("madvise");
-            VERIFY_NOT_REACHED();
-        }
-        rc = mprotect(block, ChunkedBlock::block_size, PROT_READ | PROT_WRITE);
-        if (rc < 0) {
-            perror("mprotect");
-            VERIFY_NOT_REACHED();
-        }
-        if (this_block_was_purged || block->m_size != good_size) {
-            if (this_block_was_purged)
-                g_malloc_stats.number_of_cold_empty_block_purge_hits++;
-            new (block) ChunkedBlock(good_size);
-            ue_notify_chunk_size_changed(block, good_size);
-        }
-        allocator->usable_blocks.append(*block);
-    }
-
-    if (!block) {
-        g_malloc_stats.number_of_block_allocs++;
-        char buffer[64];
-        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
-        block = (ChunkedBlock*)TRY(os_alloc(ChunkedBlock::block_size, buffer));
-        new (block) ChunkedBlock(good_size);
-        allocator->usable_blocks.append(*block);
-        ++allocator->block_count;
-    }
-
-    if (!ptr) {
-        ptr = try_allocate_chunk_aligned(align, *block);
-    }
-
-    VERIFY(ptr);
-    if (block->is_full()) {
-        g_malloc_stats.number_of_blocks_full++;
-        dbgln_if(MALLOC_DEBUG, "Block {:p} is now full in size class {}", block, good_size);
-        allocator->usable_blocks.remove(*block);
-        allocator->full_blocks.append(*block);
-    }
+    auto* ptr = TRY(allocate_chunk(*allocator, good_size, align));
+    auto* block = (ChunkedBlock*)((FlatPtr)ptr & ChunkedBlock::block_mask);
     dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} (chunk in block {:p}, size {})", ptr, block, block->bytes_per_chunk());
 
     if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
@@ -459,6 +629,21 @@ static void free_impl(void* ptr)
     void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::ChunkedBlock::block_mask);
     size_t magic = *(size_t*)block_base;
 
+#ifndef NO_TLS
+    if (magic == MAGIC_PAGE_HEADER) {
+        // NOTE: A block can't change its chunk size while one of its chunks is still in use,
+        //       so it's safe to look at it without holding the lock.
+        auto* block = (ChunkedBlock*)block_base;
+        if (auto* bin = thread_cache_bin_for_chunk_size(block->bytes_per_chunk())) {
+            dbgln_if(MALLOC_DEBUG, "LibC: freeing {:p} into thread cache (size={})", ptr, block->bytes_per_chunk());
+            if (s_scrub_free)
+                memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
+            thread_cache_deallocate(*bin, ptr);
+            return;
+        }
+    }
+#endif
+
     PthreadMutexLocker locker(s_malloc_mutex);
 
     if (magic == MAGIC_BIGALLOC_HEADER) {
@@ -494,46 +679,7 @@ static void free_impl(void* ptr)
     if (s_scrub_free)
         memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
 
-    auto* entry = (FreelistEntry*)ptr;
-    entry->next = block->m_freelist;
-    block->m_freelist = entry;
-
-    if (block->is_full()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", block, good_size);
-        g_malloc_stats.number_of_freed_full_blocks++;
-        allocator->full_blocks.remove(*block);
-        allocator->usable_blocks.prepend(*block);
-    }
-
-    ++block->m_free_chunks;
-
-    if (!block->used_chunks()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        if (s_hot_empty_block_count < number_of_hot_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", block);
-            g_malloc_stats.number_of_hot_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_hot_empty_blocks[s_hot_empty_block_count++] = block;
-            return;
-        }
-        if (s_cold_empty_block_count < number_of_cold_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", block);
-            g_malloc_stats.number_of_cold_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_cold_empty_blocks[s_cold_empty_block_count++] = block;
-            mprotect(block, ChunkedBlock::block_size, PROT_NONE);
-            madvise(block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
-            return;
-        }
-        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", block, good_size);
-        g_malloc_stats.number_of_frees++;
-        allocator->usable_blocks.remove(*block);
-        --allocator->block_count;
-        os_free(block, ChunkedBlock::block_size);
-    }
+    free_chunk(block, ptr);
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/malloc.html
@@ -663,6 +809,10 @@ void __malloc_init()
         // keeps track of heap memory anyway.
         s_scrub_malloc = false;
         s_scrub_free = false;
+#ifndef NO_TLS
+        // UE audits chunk state through the block headers, so don't hide freed chunks from it.
+        s_thread_cache_enabled = false;
+#endif
     }
 
     if (secure_getenv("LIBC_NOSCRUB_MALLOC"))
@@ -682,9 +832,18 @@ void __malloc_init()
     new (&big_allocators()[0])(BigAllocator);
 }
 
+void __malloc_thread_exit()
+{
+#ifndef NO_TLS
+    PthreadMutexLocker locker(s_malloc_mutex);
+    for (auto& bin : s_thread_cache_bins)
+        thread_cache_flush(bin, bin.count);
+#endif
+}
+
 void serenity_dump_malloc_stats()
 {
-    dbgln("# malloc() calls: {}", g_malloc_stats.number_of_malloc_calls);
+    dbgln("# malloc() calls: {}", g_malloc_stats.number_of_malloc_calls.load());
     dbgln();
     dbgln("big alloc hits: {}", g_malloc_stats.number_of_big_allocator_hits);
     dbgln("big alloc hits that were purged: {}", g_malloc_stats.number_of_big_allocator_purge_hits);
@@ -696,7 +855,7 @@ void serenity_dump_malloc_stats()
     dbgln("block allocs: {}", g_malloc_stats.number_of_block_allocs);
     dbgln("filled blocks: {}", g_malloc_stats.number_of_blocks_full);
     dbgln();
-    dbgln("# free() calls: {}", g_malloc_stats.number_of_free_calls);
+    dbgln("# free() calls: {}", g_malloc_stats.number_of_free_calls.load());
     dbgln();
     dbgln("big alloc keeps: {}", g_malloc_stats.number_of_big_allocator_keeps);
     dbgln("big alloc frees: {}", g_malloc_stats.number_of_big_allocator_frees);
@@ -705,5 +864,10 @@ void serenity_dump_malloc_stats()
     dbgln("number of hot keeps: {}", g_malloc_stats.number_of_hot_keeps);
     dbgln("number of cold keeps: {}", g_malloc_stats.number_of_cold_keeps);
     dbgln("number of frees: {}", g_malloc_stats.number_of_frees);
+    dbgln();
+    dbgln("thread cache hits: {}", g_malloc_stats.number_of_thread_cache_hits.load());
+    dbgln("thread cache refills: {}", g_malloc_stats.number_of_thread_cache_refills);
+    dbgln("thread cache keeps: {}", g_malloc_stats.number_of_thread_cache_keeps.load());
+    dbgln("thread cache flushes: {}", g_malloc_stats.number_of_thread_cache_flushes);
 }
 }
@@ -32,4 +32,25 @@ int ppoll(pollfd* fds, nfds_t nfds, timespec const* timeout, sigset_t const* sig
     int rc = syscall(SC_poll, &params);
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
+
+int create_poll_set(unsigned flags)
+{
+    int rc = syscall(SC_create_poll_set, flags);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int poll_set_ctl(int poll_set_fd, int operation, int fd, unsigned events)
+{
+    int rc = syscall(SC_poll_set_ctl, poll_set_fd, operation, fd, events);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int poll_set_wait(int poll_set_fd, pollfd* ready, nfds_t max_ready, timespec const* timeout)
+{
+    __pthread_maybe_cancel();
+
+    Syscall::SC_poll_set_wait_params params { poll_set_fd, ready, max_ready, timeout };
+    int rc = syscall(SC_poll_set_wait, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
 }
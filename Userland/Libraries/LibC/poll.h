@@ -15,4 +15,8 @@ __BEGIN_DECLS
 int poll(struct pollfd* fds, nfds_t nfds, int timeout);
 int ppoll(struct pollfd* fds, nfds_t nfds, const struct timespec* timeout, sigset_t const* sigmask);
 
+int create_poll_set(unsigned flags);
+int poll_set_ctl(int poll_set_fd, int operation, int fd, unsigned events);
+int poll_set_wait(int poll_set_fd, struct pollfd* ready, nfds_t max_ready, const struct timespec* timeout);
+
 __END_DECLS
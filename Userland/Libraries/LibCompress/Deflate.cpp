@@ -14,6 +14,7 @@
 #include <string.h>
 
 #include <LibCompress/Deflate.h>
+#include <LibThreading/WorkerThread.h>
 
 namespace Compress {
 
@@ -65,7 +66,7 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     }
 
     if (non_zero_symbols == 1) { // special case - only 1 symbol
-        code.m_prefix_table[0] = PrefixTableEntry { static_cast<u16>(last_non_zero), 1u };
+        code.m_prefix_table[0] = PrefixTableEntry { static_cast<u16>(last_non_zero), 1u, 0, 0 };
         code.m_prefix_table[1] = code.m_prefix_table[0];
         code.m_max_prefixed_code_length = 1;
 
@@ -137,10 +138,27 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
 
         for (size_t j = 0; j < (1u << shift); ++j) {
             auto index = fast_reverse16(symbol_code + j, code.m_max_prefixed_code_length);
-            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length };
+            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, static_cast<u8>(code_length), 0, 0 };
         }
     }
 
+    // Codes are read lsb-first, so the bits following a code are the upper bits of the table index.
+    // If they contain a complete code for another literal, that one can be decoded right away as well.
+    for (size_t index = 0; index < (1u << code.m_max_prefixed_code_length); ++index) {
+        auto& entry = code.m_prefix_table[index];
+        if (entry.code_length == 0 || entry.symbol_value >= 256)
+            continue;
+
+        auto const& next_entry = code.m_prefix_table[index >> entry.code_length];
+        if (next_entry.code_length == 0 || next_entry.symbol_value >= 256)
+            continue;
+        if (entry.code_length + next_entry.code_length > code.m_max_prefixed_code_length)
+            continue;
+
+        entry.second_literal = next_entry.symbol_value;
+        entry.pair_code_length = entry.code_length + next_entry.code_length;
+    }
+
     return code;
 }
 
@@ -148,11 +166,39 @@ ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) cons
 {
     auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
 
-    if (auto [symbol_value, code_length] = m_prefix_table[prefix]; code_length != 0) {
-        stream.discard_previously_peeked_bits(code_length);
-        return symbol_value;
+    if (auto const& entry = m_prefix_table[prefix]; entry.code_length != 0) {
+        stream.discard_previously_peeked_bits(entry.code_length);
+        return entry.symbol_value;
+    }
+
+    return read_long_symbol(stream);
+}
+
+ErrorOr<size_t> CanonicalCode::read_symbols(LittleEndianInputBitStream& stream, Array<u32, 2>& symbols) const
+{
+    auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
+
+    auto const& entry = m_prefix_table[prefix];
+    if (entry.code_length == 0) {
+        symbols[0] = TRY(read_long_symbol(stream));
+        return 1;
+    }
+
+    symbols[0] = entry.symbol_value;
+
+    // Near the end of the input, the upper bits of the prefix might just be padding.
+    if (entry.pair_code_length != 0 && entry.pair_code_length <= stream.buffered_bit_count()) {
+        stream.discard_previously_peeked_bits(entry.pair_code_length);
+        symbols[1] = entry.second_literal;
+        return 2;
     }
 
+    stream.discard_previously_peeked_bits(entry.code_length);
+    return 1;
+}
+
+ErrorOr<u32> CanonicalCode::read_long_symbol(LittleEndianInputBitStream& stream) const
+{
     auto code_bits = TRY(stream.read_bits<u16>(m_max_prefixed_code_length));
     code_bits = fast_reverse16(code_bits, m_max_prefixed_code_length);
     code_bits |= 1 << m_max_prefixed_code_length;
@@ -188,36 +234,48 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
     if (m_eof == true)
         return false;
 
-    auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
+    auto& input_stream = *m_decompressor.m_input_stream;
+    auto& output_buffer = m_decompressor.m_output_buffer;
 
-    if (symbol >= 286)
-        return Error::from_string_literal("Invalid deflate literal/length symbol");
+    // Decode symbols for as long as even the longest back-reference is guaranteed to fit into the output buffer,
+    // instead of returning to the caller after every single symbol.
+    constexpr size_t max_back_reference_length = 258;
+    size_t decoded_symbols = 0;
+    while (output_buffer.empty_space() >= max_back_reference_length) {
+        Array<u32, 2> symbols;
+        auto symbol_count = TRY(m_literal_codes.read_symbols(input_stream, symbols));
+        auto const symbol = symbols[0];
 
-    if (symbol < 256) {
-        u8 byte_symbol = symbol;
-        m_decompressor.m_output_buffer.write({ &byte_symbol, sizeof(byte_symbol) });
-        return true;
-    }
+        if (symbol >= 286)
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
 
-    if (symbol == 256) {
-        m_eof = true;
-        return false;
-    }
+        ++decoded_symbols;
+
+        if (symbol < 256) {
+            u8 literals[2] = { static_cast<u8>(symbol), static_cast<u8>(symbols[1]) };
+            output_buffer.write({ literals, symbol_count });
+            continue;
+        }
 
-    if (!m_distance_codes.has_value())
-        return Error::from_string_literal("Distance codes have not been initialized");
+        if (symbol == 256) {
+            m_eof = true;
+            // Let the caller read what was decoded before the end of the block first.
+            return decoded_symbols > 1;
+        }
 
-    auto const length = TRY(m_decompressor.decode_length(symbol));
-    auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(*m_decompressor.m_input_stream));
-    if (distance_symbol >= 30)
-        return Error::from_string_literal("Invalid deflate distance symbol");
+        if (!m_distance_codes.has_value())
+            return Error::from_string_literal("Distance codes have not been initialized");
 
-    auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
+        auto const length = TRY(m_decompressor.decode_length(symbol));
+        auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(input_stream));
+        if (distance_symbol >= 30)
+            return Error::from_string_literal("Invalid deflate distance symbol");
 
-    auto copied_length = TRY(m_decompressor.m_output_buffer.copy_from_seekback(distance, length));
+        auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
 
-    // TODO: What should we do if the output buffer is full?
-    VERIFY(copied_length == length);
+        auto copied_length = TRY(output_buffer.copy_from_seekback(distance, length));
+        VERIFY(copied_length == length);
+    }
 
     return true;
 }
@@ -1057,8 +1115,92 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
-ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
+ErrorOr<void> DeflateCompressor::final_flush_without_final_block()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size > 0)
+        TRY(flush());
+    m_finished = true;
+
+    // An empty stored block: BFINAL=0, BTYPE=00, padding, LEN=0 and NLEN=~0.
+    TRY(m_output_stream->write_bits(0b000u, 3));
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xffff));
+    TRY(m_output_stream->flush_buffer_to_stream());
+    return {};
+}
+
+ErrorOr<ByteBuffer> DeflateCompressor::compress_all_in_parallel(ReadonlyBytes bytes, CompressionLevel compression_level, size_t thread_count, ChunkCallback const& on_chunk)
 {
+    auto chunk_count = ceil_div(bytes.size(), parallel_chunk_size);
+    thread_count = min(thread_count, chunk_count);
+
+    Vector<ByteBuffer> compressed_chunks;
+    TRY(compressed_chunks.try_resize(chunk_count));
+
+    Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> workers;
+    TRY(workers.try_ensure_capacity(thread_count));
+    for (size_t i = 0; i < thread_count; ++i)
+        workers.unchecked_append(TRY(Threading::WorkerThread<Error>::create("Deflate Worker"sv)));
+
+    // Chunks are handed out round-robin, one wave at a time. Every chunk takes roughly
+    // the same amount of work, so this keeps all the workers busy without a shared queue.
+    for (size_t first_chunk = 0; first_chunk < chunk_count; first_chunk += thread_count) {
+        auto wave_size = min(thread_count, chunk_count - first_chunk);
+        for (size_t i = 0; i < wave_size; ++i) {
+            auto chunk_index = first_chunk + i;
+            auto started = workers[i]->start_task([&, chunk_index]() -> ErrorOr<void> {
+                auto chunk = bytes.slice(chunk_index * parallel_chunk_size, min(parallel_chunk_size, bytes.size() - chunk_index * parallel_chunk_size));
+                if (on_chunk)
+                    on_chunk(chunk_index, chunk);
+
+                AllocatingMemoryStream output_stream;
+                auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(output_stream), compression_level));
+                TRY(deflate_stream->write_until_depleted(chunk));
+                if (chunk_index == chunk_count - 1)
+                    TRY(deflate_stream->final_flush());
+                else
+                    TRY(deflate_stream->final_flush_without_final_block());
+
+                compressed_chunks[chunk_index] = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+                TRY(output_stream.read_until_filled(compressed_chunks[chunk_index]));
+                return {};
+            });
+            VERIFY(started);
+        }
+
+        Optional<Error> error;
+        for (size_t i = 0; i < wave_size; ++i) {
+            auto result = workers[i]->wait_until_task_is_finished();
+            if (result.is_error() && !error.has_value())
+                error = result.release_error();
+        }
+        if (error.has_value())
+            return error.release_value();
+    }
+
+    size_t output_size = 0;
+    for (auto const& chunk : compressed_chunks)
+        output_size += chunk.size();
+
+    auto output = TRY(ByteBuffer::create_uninitialized(output_size));
+    size_t offset = 0;
+    for (auto const& chunk : compressed_chunks) {
+        output.overwrite(offset, chunk.data(), chunk.size());
+        offset += chunk.size();
+    }
+    return output;
+}
+
+ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level, size_t thread_count, ChunkCallback const& on_chunk)
+{
+    if (thread_count > 1 && bytes.size() > parallel_chunk_size)
+        return compress_all_in_parallel(bytes, compression_level, thread_count, on_chunk);
+
+    if (on_chunk)
+        on_chunk(0, bytes);
+
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
     auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), compression_level));
 
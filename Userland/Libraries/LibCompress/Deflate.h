@@ -11,6 +11,7 @@
 #include <AK/CircularBuffer.h>
 #include <AK/Endian.h>
 #include <AK/Forward.h>
+#include <AK/Function.h>
 #include <AK/MaybeOwned.h>
 #include <AK/Stream.h>
 #include <AK/Vector.h>
@@ -24,19 +25,29 @@ public:
     ErrorOr<u32> read_symbol(LittleEndianInputBitStream&) const;
     ErrorOr<void> write_symbol(LittleEndianOutputBitStream&, u32) const;
 
+    // Like read_symbol(), but if the symbol is a DEFLATE literal (i.e. below 256) and the code of another literal
+    // follows it within the same table lookup, both are read at once. Returns the number of symbols read.
+    ErrorOr<size_t> read_symbols(LittleEndianInputBitStream&, Array<u32, 2>& symbols) const;
+
     static CanonicalCode const& fixed_literal_codes();
     static CanonicalCode const& fixed_distance_codes();
 
     static ErrorOr<CanonicalCode> from_bytes(ReadonlyBytes);
 
 private:
-    static constexpr size_t max_allowed_prefixed_code_length = 8;
+    static constexpr size_t max_allowed_prefixed_code_length = 9;
 
     struct PrefixTableEntry {
         u16 symbol_value { 0 };
-        u16 code_length { 0 };
+        u8 code_length { 0 };
+
+        // The second literal of a pair, see read_symbols(). The pair code length is 0 if there is none.
+        u8 second_literal { 0 };
+        u8 pair_code_length { 0 };
     };
 
+    ErrorOr<u32> read_long_symbol(LittleEndianInputBitStream&) const;
+
     // Decompression - indexed by code
     Vector<u16, 286> m_symbol_codes;
     Vector<u16, 286> m_symbol_values;
@@ -165,11 +176,22 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
+    // With more than one thread, the input is split into chunks of parallel_chunk_size bytes that are compressed
+    // independently on a pool of worker threads, and then joined into a single deflate stream.
+    // If given, on_chunk is called on the worker thread for every chunk, e.g. to calculate a checksum in parallel.
+    static constexpr size_t parallel_chunk_size = 1 * MiB;
+    using ChunkCallback = Function<void(size_t chunk_index, ReadonlyBytes chunk)>;
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD, size_t thread_count = 1, ChunkCallback const& on_chunk = {});
 
 private:
     DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>, CompressionLevel = CompressionLevel::GOOD);
 
+    static ErrorOr<ByteBuffer> compress_all_in_parallel(ReadonlyBytes bytes, CompressionLevel, size_t thread_count, ChunkCallback const& on_chunk);
+
+    // Like final_flush(), but the last block is not marked as final. Instead, the output is padded to a byte boundary
+    // with an empty stored block, so that another deflate stream's blocks can follow it directly.
+    ErrorOr<void> final_flush_without_final_block();
+
     Bytes pending_block() { return { m_rolling_window + block_size, block_size }; }
 
     // LZ77 Compression
@@ -215,7 +215,7 @@ ErrorOr<Bytes> GzipCompressor::read_some(Bytes)
     return Error::from_errno(EBADF);
 }
 
-ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
+ErrorOr<void> GzipCompressor::write_header(Stream& stream)
 {
     BlockHeader header;
     header.identification_1 = 0x1f;
@@ -225,7 +225,13 @@ ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
     header.modification_time = 0;
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
-    TRY(m_output_stream->write_until_depleted({ &header, sizeof(header) }));
+    TRY(stream.write_until_depleted({ &header, sizeof(header) }));
+    return {};
+}
+
+ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
+{
+    TRY(write_header(*m_output_stream));
     auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
     TRY(compressed_stream->write_until_depleted(bytes));
     TRY(compressed_stream->final_flush());
@@ -250,19 +256,39 @@ void GzipCompressor::close()
 {
 }
 
-ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
+ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes, size_t thread_count)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
-    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream) };
 
-    TRY(gzip_stream.write_until_depleted(bytes));
+    if (thread_count <= 1) {
+        GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream) };
+        TRY(gzip_stream.write_until_depleted(bytes));
+    } else {
+        // Every worker checksums its own chunk, and the results are stitched together afterwards.
+        Vector<u32> chunk_digests;
+        TRY(chunk_digests.try_resize(max<size_t>(ceil_div(bytes.size(), DeflateCompressor::parallel_chunk_size), 1)));
+        auto compressed = TRY(DeflateCompressor::compress_all(bytes, DeflateCompressor::CompressionLevel::GOOD, thread_count, [&](size_t chunk_index, ReadonlyBytes chunk) {
+            chunk_digests[chunk_index] = Crypto::Checksum::CRC32(chunk).digest();
+        }));
+
+        u32 digest = chunk_digests[0];
+        for (size_t i = 1; i < chunk_digests.size(); ++i) {
+            auto chunk_size = min(DeflateCompressor::parallel_chunk_size, bytes.size() - i * DeflateCompressor::parallel_chunk_size);
+            digest = Crypto::Checksum::CRC32::combine(digest, chunk_digests[i], chunk_size);
+        }
+
+        TRY(write_header(*output_stream));
+        TRY(output_stream->write_until_depleted(compressed));
+        TRY(output_stream->write_value<LittleEndian<u32>>(digest));
+        TRY(output_stream->write_value<LittleEndian<u32>>(bytes.size()));
+    }
 
     auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
     TRY(output_stream->read_until_filled(buffer.bytes()));
     return buffer;
 }
 
-ErrorOr<void> GzipCompressor::compress_file(StringView input_filename, NonnullOwnPtr<Stream> output_stream)
+ErrorOr<void> GzipCompressor::compress_file(StringView input_filename, NonnullOwnPtr<Stream> output_stream, size_t thread_count)
 {
     // We map the whole file instead of streaming to reduce size overhead (gzip header) and increase the deflate block size (better compression)
     // TODO: automatically fallback to buffered streaming for very large files
@@ -274,7 +300,7 @@ ErrorOr<void> GzipCompressor::compress_file(StringView input_filename, NonnullOw
         input_bytes = file->bytes();
     }
 
-    auto output_bytes = TRY(Compress::GzipCompressor::compress_all(input_bytes));
+    auto output_bytes = TRY(Compress::GzipCompressor::compress_all(input_bytes, thread_count));
     TRY(output_stream->write_until_depleted(output_bytes));
 
     return {};
@@ -92,10 +92,13 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes);
-    static ErrorOr<void> compress_file(StringView input_file, NonnullOwnPtr<Stream> output_stream);
+    // With more than one thread, the member is compressed in parallel (see DeflateCompressor::compress_all()).
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, size_t thread_count = 1);
+    static ErrorOr<void> compress_file(StringView input_file, NonnullOwnPtr<Stream> output_stream, size_t thread_count = 1);
 
 private:
+    static ErrorOr<void> write_header(Stream&);
+
     MaybeOwned<Stream> m_output_stream;
 };
 
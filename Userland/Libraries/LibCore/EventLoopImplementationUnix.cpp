@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
+#include <AK/Array.h>
 #include <AK/IDAllocator.h>
 #include <AK/Singleton.h>
 #include <AK/TemporaryChange.h>
@@ -19,6 +21,10 @@
 #include <sys/select.h>
 #include <unistd.h>
 
+#ifdef AK_OS_SERENITY
+#    include <poll.h>
+#endif
+
 namespace Core {
 
 struct ThreadData;
@@ -53,6 +59,9 @@ struct ThreadData {
     {
         pid = getpid();
         initialize_wake_pipe();
+#ifdef AK_OS_SERENITY
+        initialize_poll_set();
+#endif
     }
 
     void initialize_wake_pipe()
@@ -73,6 +82,103 @@ struct ThreadData {
         VERIFY(rc == 0);
     }
 
+#ifdef AK_OS_SERENITY
+    // On Serenity, notifiers are kept in a kernel poll set, so waiting for events doesn't
+    // have to hand every watched file descriptor to the kernel again on each iteration.
+    void initialize_poll_set()
+    {
+        if (poll_set_fd != -1)
+            close(poll_set_fd);
+        notifiers_by_fd.clear();
+
+        poll_set_fd = create_poll_set(POLL_SET_CLOEXEC);
+        VERIFY(poll_set_fd >= 0);
+        update_poll_set(POLL_SET_ADD, wake_pipe_fds[0], POLLIN);
+    }
+
+    void update_poll_set(int operation, int fd, unsigned events)
+    {
+        if (poll_set_ctl(poll_set_fd, operation, fd, events) == 0)
+            return;
+
+        // The kernel drops a watch once its file description is closed, and the fd number may
+        // have been reused since, so our view of the poll set can be out of date.
+        switch (errno) {
+        case EEXIST:
+            // The fd was closed and reopened without us noticing, the old watch is still around.
+            if (operation == POLL_SET_ADD && poll_set_ctl(poll_set_fd, POLL_SET_MODIFY, fd, events) == 0)
+                return;
+            break;
+        case ENOENT:
+            // The watch went away together with the description it was watching.
+            if (operation == POLL_SET_REMOVE)
+                return;
+            if (operation == POLL_SET_MODIFY && poll_set_ctl(poll_set_fd, POLL_SET_ADD, fd, events) == 0)
+                return;
+            break;
+        case EBADF:
+            // The fd is already closed, so there's nothing left to watch (or unwatch).
+            return;
+        default:
+            break;
+        }
+
+        perror("EventLoopImplementationUnix: poll_set_ctl");
+        VERIFY_NOT_REACHED();
+    }
+
+    static unsigned poll_events_for_notifier(Notifier const& notifier)
+    {
+        switch (notifier.type()) {
+        case Notifier::Type::Read:
+            return POLLIN;
+        case Notifier::Type::Write:
+            return POLLOUT;
+        case Notifier::Type::Exceptional:
+            return POLLPRI;
+        case Notifier::Type::None:
+            return 0;
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    unsigned poll_events_for_fd(int fd) const
+    {
+        unsigned events = 0;
+        if (auto it = notifiers_by_fd.find(fd); it != notifiers_by_fd.end()) {
+            for (auto* notifier : it->value)
+                events |= poll_events_for_notifier(*notifier);
+        }
+        return events;
+    }
+
+    void add_notifier_to_poll_set(Notifier& notifier)
+    {
+        auto& notifiers_for_fd = notifiers_by_fd.ensure(notifier.fd());
+        if (notifiers_for_fd.contains_slow(&notifier))
+            return;
+        bool is_new_fd = notifiers_for_fd.is_empty();
+        notifiers_for_fd.append(&notifier);
+        update_poll_set(is_new_fd ? POLL_SET_ADD : POLL_SET_MODIFY, notifier.fd(), poll_events_for_fd(notifier.fd()));
+    }
+
+    void remove_notifier_from_poll_set(Notifier& notifier)
+    {
+        auto it = notifiers_by_fd.find(notifier.fd());
+        if (it == notifiers_by_fd.end() || !it->value.remove_first_matching([&](auto* other) { return other == &notifier; }))
+            return;
+        if (it->value.is_empty()) {
+            notifiers_by_fd.remove(it);
+            update_poll_set(POLL_SET_REMOVE, notifier.fd(), 0);
+        } else {
+            update_poll_set(POLL_SET_MODIFY, notifier.fd(), poll_events_for_fd(notifier.fd()));
+        }
+    }
+
+    int poll_set_fd { -1 };
+    HashMap<int, Vector<Notifier*, 1>> notifiers_by_fd;
+#endif
+
     // Each thread has its own timers, notifiers and a wake pipe.
     HashMap<int, NonnullOwnPtr<EventLoopTimer>> timers;
     HashTable<Notifier*> notifiers;
@@ -143,9 +249,12 @@ void EventLoopManagerUnix::wait_for_events(EventLoopImplementation::PumpMode mod
 {
     auto& thread_data = ThreadData::the();
 
+#ifndef AK_OS_SERENITY
     fd_set read_fds {};
     fd_set write_fds {};
+#endif
 retry:
+#ifndef AK_OS_SERENITY
     int max_fd = 0;
     auto add_fd_to_set = [&max_fd](int fd, fd_set& set) {
         FD_SET(fd, &set);
@@ -164,6 +273,7 @@ retry:
         if (notifier->type() == Notifier::Type::Exceptional)
             TODO();
     }
+#endif
 
     bool has_pending_events = ThreadEventQueue::current().has_pending_events();
 
@@ -184,9 +294,20 @@ retry:
         }
     }
 
+#ifdef AK_OS_SERENITY
+    // The poll set only reports descriptors that are actually ready. Anything that doesn't fit
+    // into this batch stays ready in the kernel and is picked up on the next iteration.
+    Array<pollfd, 64> ready_fds;
+    timespec timeout_spec {};
+    timeval_to_timespec(timeout, timeout_spec);
+try_select_again:
+    // Wait for file system events, calls to wake(), POSIX signals, or timer expirations.
+    int marked_fd_count = poll_set_wait(thread_data.poll_set_fd, ready_fds.data(), ready_fds.size(), should_wait_forever ? nullptr : &timeout_spec);
+#else
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
     int marked_fd_count = select(max_fd + 1, &read_fds, &write_fds, nullptr, should_wait_forever ? nullptr : &timeout);
+#endif
     // Because POSIX, we might spuriously return from select() with EINTR; just select again.
     if (marked_fd_count < 0) {
         int saved_errno = errno;
@@ -196,9 +317,16 @@ try_select_again:
         VERIFY_NOT_REACHED();
     }
 
+#ifdef AK_OS_SERENITY
+    auto ready_fd_span = ready_fds.span().trim(marked_fd_count);
+    bool wake_pipe_is_readable = any_of(ready_fd_span, [&](auto& ready_fd) { return ready_fd.fd == thread_data.wake_pipe_fds[0]; });
+#else
+    bool wake_pipe_is_readable = FD_ISSET(thread_data.wake_pipe_fds[0], &read_fds);
+#endif
+
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (FD_ISSET(thread_data.wake_pipe_fds[0], &read_fds)) {
+    if (wake_pipe_is_readable) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -256,6 +384,18 @@ try_select_again:
         return;
 
     // Handle file system notifiers by making them normal events.
+#ifdef AK_OS_SERENITY
+    for (auto& ready_fd : ready_fd_span) {
+        auto it = thread_data.notifiers_by_fd.find(ready_fd.fd);
+        if (it == thread_data.notifiers_by_fd.end())
+            continue;
+        for (auto* notifier : it->value) {
+            // Like select(), treat errors and hang-ups as activations so the owner gets to see them.
+            if (ready_fd.revents & (ThreadData::poll_events_for_notifier(*notifier) | POLLERR | POLLHUP))
+                ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd()));
+        }
+    }
+#else
     for (auto& notifier : thread_data.notifiers) {
         if (notifier->type() == Notifier::Type::Read && FD_ISSET(notifier->fd(), &read_fds)) {
             ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd()));
@@ -264,6 +404,7 @@ try_select_again:
             ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd()));
         }
     }
+#endif
 }
 
 class SignalHandlers : public RefCounted<SignalHandlers> {
@@ -339,6 +480,9 @@ void EventLoopImplementationUnix::notify_forked_and_in_child()
     thread_data.timers.clear();
     thread_data.notifiers.clear();
     thread_data.initialize_wake_pipe();
+#ifdef AK_OS_SERENITY
+    thread_data.initialize_poll_set();
+#endif
     if (auto* info = signals_info<false>()) {
         info->signal_handlers.clear();
         info->next_signal_id = 0;
@@ -505,12 +649,20 @@ bool EventLoopManagerUnix::unregister_timer(int timer_id)
 
 void EventLoopManagerUnix::register_notifier(Notifier& notifier)
 {
-    ThreadData::the().notifiers.set(&notifier);
+    auto& thread_data = ThreadData::the();
+    thread_data.notifiers.set(&notifier);
+#ifdef AK_OS_SERENITY
+    thread_data.add_notifier_to_poll_set(notifier);
+#endif
 }
 
 void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
 {
-    ThreadData::the().notifiers.remove(&notifier);
+    auto& thread_data = ThreadData::the();
+    thread_data.notifiers.remove(&notifier);
+#ifdef AK_OS_SERENITY
+    thread_data.remove_notifier_from_poll_set(notifier);
+#endif
 }
 
 void EventLoopManagerUnix::did_post_event()
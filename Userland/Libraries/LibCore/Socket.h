@@ -191,6 +191,13 @@ public:
     ErrorOr<void> set_blocking(bool enabled) override { return m_helper.set_blocking(enabled); }
     ErrorOr<void> set_close_on_exec(bool enabled) override { return m_helper.set_close_on_exec(enabled); }
 
+    Optional<int> fd() const
+    {
+        if (!is_open())
+            return {};
+        return m_helper.fd();
+    }
+
     virtual ~TCPSocket() override { close(); }
 
 private:
@@ -412,6 +419,9 @@ public:
     virtual ErrorOr<void> set_close_on_exec(bool enabled) override { return m_helper.stream().set_close_on_exec(enabled); }
     virtual void set_notifications_enabled(bool enabled) override { m_helper.stream().set_notifications_enabled(enabled); }
 
+    // Only meant for handing the socket to syscalls like sendfile(); reading from the fd directly would bypass the buffer.
+    Optional<int> fd() const { return m_helper.stream().fd(); }
+
     virtual ErrorOr<StringView> read_line(Bytes buffer) override { return m_helper.read_line(move(buffer)); }
     virtual ErrorOr<Bytes> read_until(Bytes buffer, StringView candidate) override { return m_helper.read_until(move(buffer), move(candidate)); }
     template<size_t N>
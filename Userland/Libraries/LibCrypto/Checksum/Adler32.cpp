@@ -4,18 +4,75 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/SIMD.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/Adler32.h>
 
 namespace Crypto::Checksum {
 
+using namespace AK::SIMD;
+
+static constexpr u32 adler_modulus = 65521;
+
+// The largest number of bytes that can be summed before the second sum could overflow 32 bits,
+// which means the expensive modulo only has to be taken once per this many bytes.
+static constexpr size_t adler_chunk_size = 5552;
+
+static constexpr size_t adler_block_size = 16;
+
+static ALWAYS_INLINE u32 horizontal_sum(u32x4 vector)
+{
+    return vector[0] + vector[1] + vector[2] + vector[3];
+}
+
 void Adler32::update(ReadonlyBytes data)
 {
-    for (size_t i = 0; i < data.size(); i++) {
-        m_state_a = (m_state_a + data.at(i)) % 65521;
-        m_state_b = (m_state_b + m_state_a) % 65521;
+    u32 a = m_state_a;
+    u32 b = m_state_b;
+
+    while (!data.is_empty()) {
+        auto chunk = data.trim(adler_chunk_size);
+        data = data.slice(chunk.size());
+
+        // Sum whole 16-byte blocks in vectors. Within a block, byte i adds (16 - i) times its value to b,
+        // and every block adds 16 times the running value of a (from before that block) to b.
+        size_t block_count = chunk.size() / adler_block_size;
+        if (block_count > 0) {
+            constexpr u32x4 weights[4] = { { 16, 15, 14, 13 }, { 12, 11, 10, 9 }, { 8, 7, 6, 5 }, { 4, 3, 2, 1 } };
+            u32x4 byte_sums {};
+            u32x4 previous_byte_sums {};
+            u32x4 weighted_sums {};
+
+            auto const* bytes = chunk.data();
+            for (size_t block = 0; block < block_count; ++block, bytes += adler_block_size) {
+                previous_byte_sums += byte_sums;
+                for (size_t i = 0; i < 4; ++i) {
+                    u8x4 quad;
+                    __builtin_memcpy(&quad, bytes + i * 4, sizeof(quad));
+                    auto widened = __builtin_convertvector(quad, u32x4);
+                    byte_sums += widened;
+                    weighted_sums += widened * weights[i];
+                }
+            }
+
+            u64 new_b = b + static_cast<u64>(a) * adler_block_size * block_count
+                + static_cast<u64>(horizontal_sum(previous_byte_sums)) * adler_block_size
+                + horizontal_sum(weighted_sums);
+            a = (a + horizontal_sum(byte_sums)) % adler_modulus;
+            b = new_b % adler_modulus;
+        }
+
+        for (auto byte : chunk.slice(block_count * adler_block_size)) {
+            a += byte;
+            b += a;
+        }
+        a %= adler_modulus;
+        b %= adler_modulus;
     }
+
+    m_state_a = a;
+    m_state_b = b;
 }
 
 u32 Adler32::digest()
@@ -10,6 +10,11 @@
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/CRC32.h>
 
+#if ARCH(X86_64)
+#    include <cpuid.h>
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Checksum {
 
 #if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
@@ -43,8 +48,6 @@ void CRC32::update(ReadonlyBytes span)
     }
 }
 
-// FIXME: On Intel, use _mm_crc32_u8 / _mm_crc32_u64 if available (SSE 4.2).
-
 #else
 
 static constexpr size_t ethernet_polynomial = 0xEDB88320;
@@ -101,8 +104,107 @@ static constexpr u32 single_byte_crc(u32 crc, u8 byte)
     return (crc >> 8) ^ table[0][(crc & 0xff) ^ byte];
 }
 
+#        if ARCH(X86_64)
+
+// Note that the SSE 4.2 crc32 instruction can't be used here, as it implements the Castagnoli polynomial.
+// Instead, this folds the input 64 bytes at a time with carry-less multiplications, and then reduces the
+// result with a Barrett reduction, as described in Intel's "Fast CRC Computation for Generic Polynomials
+// Using PCLMULQDQ Instruction". The constants are the bit-reflected ones for the ethernet polynomial.
+static constexpr size_t pclmul_minimum_size = 64;
+
+static bool cpu_supports_pclmul()
+{
+    static bool const supported = [] {
+        u32 eax, ebx, ecx, edx;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+            return false;
+        return (ecx & bit_PCLMUL) != 0 && (ecx & bit_SSE4_1) != 0;
+    }();
+    return supported;
+}
+
+[[gnu::target("pclmul,sse4.1")]] static ALWAYS_INLINE __m128i fold(__m128i value, __m128i constants, __m128i next)
+{
+    auto low = _mm_clmulepi64_si128(value, constants, 0x00);
+    auto high = _mm_clmulepi64_si128(value, constants, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(high, low), next);
+}
+
+[[gnu::target("pclmul,sse4.1")]] static u32 pclmul_crc(u32 crc, ReadonlyBytes data)
+{
+    VERIFY(data.size() >= pclmul_minimum_size && data.size() % 16 == 0);
+
+    alignas(16) static constexpr u64 k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+    alignas(16) static constexpr u64 k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+    alignas(16) static constexpr u64 k5k0[] = { 0x0163cd6124, 0x0000000000 };
+    alignas(16) static constexpr u64 poly[] = { 0x01db710641, 0x01f7011641 };
+
+    auto const* bytes = data.data();
+    auto size = data.size();
+    auto load = [&](size_t offset) { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes + offset)); };
+
+    auto x1 = _mm_xor_si128(load(0x00), _mm_cvtsi32_si128(static_cast<int>(crc)));
+    auto x2 = load(0x10);
+    auto x3 = load(0x20);
+    auto x4 = load(0x30);
+    bytes += 64;
+    size -= 64;
+
+    // Fold four 128-bit lanes in parallel.
+    auto x0 = _mm_load_si128(reinterpret_cast<__m128i const*>(k1k2));
+    while (size >= 64) {
+        x1 = fold(x1, x0, load(0x00));
+        x2 = fold(x2, x0, load(0x10));
+        x3 = fold(x3, x0, load(0x20));
+        x4 = fold(x4, x0, load(0x30));
+        bytes += 64;
+        size -= 64;
+    }
+
+    // Fold the four lanes into one, then fold in the remaining 16-byte blocks.
+    x0 = _mm_load_si128(reinterpret_cast<__m128i const*>(k3k4));
+    x1 = fold(x1, x0, x2);
+    x1 = fold(x1, x0, x3);
+    x1 = fold(x1, x0, x4);
+    while (size >= 16) {
+        x1 = fold(x1, x0, load(0));
+        bytes += 16;
+        size -= 16;
+    }
+
+    // Fold 128 bits down to 64 bits.
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x0 = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x00), x2);
+
+    // Barrett reduction down to 32 bits.
+    x0 = _mm_load_si128(reinterpret_cast<__m128i const*>(poly));
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<u32>(_mm_extract_epi32(x1, 1));
+}
+
+#        endif
+
 void CRC32::update(ReadonlyBytes data)
 {
+#        if ARCH(X86_64)
+    if (data.size() >= pclmul_minimum_size && cpu_supports_pclmul()) {
+        auto folded_size = data.size() & ~static_cast<size_t>(15);
+        m_state = pclmul_crc(m_state, data.trim(folded_size));
+        data = data.slice(folded_size);
+    }
+#        endif
+
     // The provided data may not be aligned to a 4-byte boundary, required to reinterpret its address
     // into a u32 in the loop below. So we split the bytes into two segments: the misaligned bytes
     // (which undergo the standard 1-byte-at-a-time algorithm) and remaining aligned bytes.
@@ -171,4 +273,63 @@ u32 CRC32::digest()
     return ~m_state;
 }
 
+// Appending N zero bits to the input is a linear operation on the CRC register, so it can be
+// expressed as a 32x32 matrix over GF(2). Squaring the matrix for one zero bit repeatedly gives
+// the operators for 2^n zero bits, which lets us "shift" the first CRC past the second input in
+// O(log n) steps. This is the same approach as zlib's crc32_combine().
+using GF2Matrix = Array<u32, 32>;
+
+static u32 gf2_matrix_times(GF2Matrix const& matrix, u32 vector)
+{
+    u32 sum = 0;
+    for (size_t i = 0; vector != 0; ++i, vector >>= 1) {
+        if (vector & 1)
+            sum ^= matrix[i];
+    }
+    return sum;
+}
+
+static void gf2_matrix_square(GF2Matrix& square, GF2Matrix const& matrix)
+{
+    for (size_t i = 0; i < 32; ++i)
+        square[i] = gf2_matrix_times(matrix, matrix[i]);
+}
+
+u32 CRC32::combine(u32 first_digest, u32 second_digest, u64 second_length)
+{
+    if (second_length == 0)
+        return first_digest;
+
+    GF2Matrix even;
+    GF2Matrix odd;
+
+    // The operator for a single zero bit.
+    odd[0] = 0xEDB88320;
+    for (size_t i = 1; i < 32; ++i)
+        odd[i] = 1u << (i - 1);
+
+    gf2_matrix_square(even, odd); // two zero bits
+    gf2_matrix_square(odd, even); // four zero bits
+
+    // The first squaring below turns this into the operator for one zero byte.
+    auto crc = first_digest;
+    while (true) {
+        gf2_matrix_square(even, odd);
+        if (second_length & 1)
+            crc = gf2_matrix_times(even, crc);
+        second_length >>= 1;
+        if (second_length == 0)
+            break;
+
+        gf2_matrix_square(odd, even);
+        if (second_length & 1)
+            crc = gf2_matrix_times(odd, crc);
+        second_length >>= 1;
+        if (second_length == 0)
+            break;
+    }
+
+    return crc ^ second_digest;
+}
+
 }
@@ -70,6 +70,8 @@ public:
         {
             return { 0, 0, horizontal_radius, vertical_radius };
         }
+
+        bool operator==(CornerRadius const&) const = default;
     };
 
     void fill_rect_with_rounded_corners(IntRect const&, Color, CornerRadius top_left, CornerRadius top_right, CornerRadius bottom_right, CornerRadius bottom_left, BlendMode blend_mode = BlendMode::Normal);
@@ -686,6 +686,7 @@ float Font::glyphs_horizontal_kerning(u32 left_glyph_id, u32 right_glyph_id, flo
 
     // NOTE: OpenType glyph IDs are 16-bit, so this is safe.
     auto cache_key = (left_glyph_id << 16) | right_glyph_id;
+    Threading::MutexLocker locker(m_cache_mutex);
     if (auto it = m_kerning_cache.find(cache_key); it != m_kerning_cache.end()) {
         return it->value * x_scale;
     }
@@ -900,6 +901,7 @@ u32 Font::glyph_id_for_code_point(u32 code_point) const
 
 Font::GlyphPage const& Font::glyph_page(size_t page_index) const
 {
+    Threading::MutexLocker locker(m_cache_mutex);
     if (page_index == 0) {
         if (!m_glyph_page_zero) {
             m_glyph_page_zero = make<GlyphPage>();
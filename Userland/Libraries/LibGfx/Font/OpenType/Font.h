@@ -17,6 +17,7 @@
 #include <LibGfx/Font/OpenType/Glyf.h>
 #include <LibGfx/Font/OpenType/Tables.h>
 #include <LibGfx/Font/VectorFont.h>
+#include <LibThreading/Mutex.h>
 
 namespace OpenType {
 
@@ -143,6 +144,9 @@ private:
 
     mutable HashMap<u32, i16> m_kerning_cache;
 
+    // Glyphs may be rasterized on several threads at once, so the caches above are only touched with this held.
+    mutable Threading::Mutex m_cache_mutex;
+
     GlyphPage const& glyph_page(size_t page_index) const;
     void populate_glyph_page(GlyphPage&, size_t page_index) const;
 };
@@ -74,6 +74,7 @@ ALWAYS_INLINE float ScaledFont::unicode_view_width(T const& view) const
 RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id, GlyphSubpixelOffset subpixel_offset) const
 {
     GlyphIndexWithSubpixelOffset index { glyph_id, subpixel_offset };
+    Threading::MutexLocker locker(m_cached_glyph_bitmaps_mutex);
     auto glyph_iterator = m_cached_glyph_bitmaps.find(index);
     if (glyph_iterator != m_cached_glyph_bitmaps.end())
         return glyph_iterator->value;
@@ -1985,31 +1985,40 @@ void Painter::draw_line(IntPoint a_p1, IntPoint a_p2, Color color, int thickness
 
     auto alternate_color_is_transparent = alternate_color == Color::Transparent;
 
+    // Patterns start at the beginning of the line and pixels are only dropped when they're entirely clipped, so that
+    // the pixels inside the clip rect are the same no matter where it is. This lets a line be painted in pieces.
+    auto draw_clipped_physical_pixel = [&](IntPoint physical_position, Color color) {
+        if (clip_rect.intersects(IntRect { physical_position, { thickness, thickness } }))
+            draw_physical_pixel(physical_position, color, thickness);
+    };
+    auto pattern_period = thickness * (style == LineStyle::Dotted ? 2 : 6);
+
     // Special case: vertical line.
     if (point1.x() == point2.x()) {
         int const x = point1.x();
-        if (x < clip_rect.left() || x >= clip_rect.right())
+        if (x + thickness <= clip_rect.left() || x >= clip_rect.right())
             return;
         if (point1.y() > point2.y())
             swap(point1, point2);
         if (point1.y() >= clip_rect.bottom())
             return;
-        if (point2.y() < clip_rect.top())
+        if (point2.y() + thickness <= clip_rect.top())
             return;
-        int min_y = max(point1.y(), clip_rect.top());
+        int min_y = max(point1.y(), clip_rect.top() - (thickness - 1));
         int max_y = min(point2.y(), clip_rect.bottom() - 1);
+        int first_pattern_y = point1.y() + (min_y - point1.y()) / pattern_period * pattern_period;
         if (style == LineStyle::Dotted) {
-            for (int y = min_y; y <= max_y; y += thickness * 2)
-                draw_physical_pixel({ x, y }, color, thickness);
+            for (int y = first_pattern_y; y <= max_y; y += pattern_period)
+                draw_clipped_physical_pixel({ x, y }, color);
         } else if (style == LineStyle::Dashed) {
-            for (int y = min_y; y <= max_y; y += thickness * 6) {
-                draw_physical_pixel({ x, y }, color, thickness);
-                draw_physical_pixel({ x, min(y + thickness, max_y) }, color, thickness);
-                draw_physical_pixel({ x, min(y + thickness * 2, max_y) }, color, thickness);
+            for (int y = first_pattern_y; y <= max_y; y += pattern_period) {
+                draw_clipped_physical_pixel({ x, y }, color);
+                draw_clipped_physical_pixel({ x, min(y + thickness, point2.y()) }, color);
+                draw_clipped_physical_pixel({ x, min(y + thickness * 2, point2.y()) }, color);
                 if (!alternate_color_is_transparent) {
-                    draw_physical_pixel({ x, min(y + thickness * 3, max_y) }, alternate_color, thickness);
-                    draw_physical_pixel({ x, min(y + thickness * 4, max_y) }, alternate_color, thickness);
-                    draw_physical_pixel({ x, min(y + thickness * 5, max_y) }, alternate_color, thickness);
+                    draw_clipped_physical_pixel({ x, min(y + thickness * 3, point2.y()) }, alternate_color);
+                    draw_clipped_physical_pixel({ x, min(y + thickness * 4, point2.y()) }, alternate_color);
+                    draw_clipped_physical_pixel({ x, min(y + thickness * 5, point2.y()) }, alternate_color);
                 }
             }
         } else {
@@ -2023,28 +2032,29 @@ void Painter::draw_line(IntPoint a_p1, IntPoint a_p2, Color color, int thickness
     // Special case: horizontal line.
     if (point1.y() == point2.y()) {
         int const y = point1.y();
-        if (y < clip_rect.top() || y >= clip_rect.bottom())
+        if (y + thickness <= clip_rect.top() || y >= clip_rect.bottom())
             return;
         if (point1.x() > point2.x())
             swap(point1, point2);
         if (point1.x() >= clip_rect.right())
             return;
-        if (point2.x() < clip_rect.left())
+        if (point2.x() + thickness <= clip_rect.left())
             return;
-        int min_x = max(point1.x(), clip_rect.left());
+        int min_x = max(point1.x(), clip_rect.left() - (thickness - 1));
         int max_x = min(point2.x(), clip_rect.right() - 1);
+        int first_pattern_x = point1.x() + (min_x - point1.x()) / pattern_period * pattern_period;
         if (style == LineStyle::Dotted) {
-            for (int x = min_x; x <= max_x; x += thickness * 2)
-                draw_physical_pixel({ x, y }, color, thickness);
+            for (int x = first_pattern_x; x <= max_x; x += pattern_period)
+                draw_clipped_physical_pixel({ x, y }, color);
         } else if (style == LineStyle::Dashed) {
-            for (int x = min_x; x <= max_x; x += thickness * 6) {
-                draw_physical_pixel({ x, y }, color, thickness);
-                draw_physical_pixel({ min(x + thickness, max_x), y }, color, thickness);
-                draw_physical_pixel({ min(x + thickness * 2, max_x), y }, color, thickness);
+            for (int x = first_pattern_x; x <= max_x; x += pattern_period) {
+                draw_clipped_physical_pixel({ x, y }, color);
+                draw_clipped_physical_pixel({ min(x + thickness, point2.x()), y }, color);
+                draw_clipped_physical_pixel({ min(x + thickness * 2, point2.x()), y }, color);
                 if (!alternate_color_is_transparent) {
-                    draw_physical_pixel({ min(x + thickness * 3, max_x), y }, alternate_color, thickness);
-                    draw_physical_pixel({ min(x + thickness * 4, max_x), y }, alternate_color, thickness);
-                    draw_physical_pixel({ min(x + thickness * 5, max_x), y }, alternate_color, thickness);
+                    draw_clipped_physical_pixel({ min(x + thickness * 3, point2.x()), y }, alternate_color);
+                    draw_clipped_physical_pixel({ min(x + thickness * 4, point2.x()), y }, alternate_color);
+                    draw_clipped_physical_pixel({ min(x + thickness * 5, point2.x()), y }, alternate_color);
                 }
             }
         } else {
@@ -2080,9 +2090,9 @@ void Painter::draw_line(IntPoint a_p1, IntPoint a_p2, Color color, int thickness
             should_draw_line = false;
 
         if (should_draw_line)
-            draw_physical_pixel({ x, y }, color, thickness);
+            draw_clipped_physical_pixel({ x, y }, color);
         else if (!alternate_color_is_transparent)
-            draw_physical_pixel({ x, y }, alternate_color, thickness);
+            draw_clipped_physical_pixel({ x, y }, alternate_color);
 
         number_of_pixels_drawn++;
     };
@@ -2092,8 +2102,7 @@ void Painter::draw_line(IntPoint a_p1, IntPoint a_p2, Color color, int thickness
         int const delta_error = 2 * abs(dy);
         int y = point1.y();
         for (int x = point1.x(); x <= point2.x(); ++x) {
-            if (clip_rect.contains(x, y))
-                draw_pixel_in_line(x, y);
+            draw_pixel_in_line(x, y);
             error += delta_error;
             if (error >= dx) {
                 y += y_step;
@@ -2105,8 +2114,7 @@ void Painter::draw_line(IntPoint a_p1, IntPoint a_p2, Color color, int thickness
         int const delta_error = 2 * abs(dx);
         int x = point1.x();
         for (int y = point1.y(); y <= point2.y(); ++y) {
-            if (clip_rect.contains(x, y))
-                draw_pixel_in_line(x, y);
+            draw_pixel_in_line(x, y);
             error += delta_error;
             if (error >= dy) {
                 x += x_step;
@@ -2128,10 +2136,13 @@ void Painter::draw_triangle_wave(IntPoint a_p1, IntPoint a_p2, Color color, int
     auto point2 = to_physical(p2);
 
     auto y = point1.y();
+    auto clip_rect = this->clip_rect() * scale();
 
     for (int x = 0; x <= point2.x() - point1.x(); ++x) {
         auto y_offset = abs(x % (2 * amplitude) - amplitude) - amplitude;
-        draw_physical_pixel({ point1.x() + x, y + y_offset }, color, thickness);
+        IntPoint position { point1.x() + x, y + y_offset };
+        if (clip_rect.intersects(IntRect { position, { thickness, thickness } }))
+            draw_physical_pixel(position, color, thickness);
     }
 }
 
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/TemporaryChange.h>
 #include <LibCore/System.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Stub.h>
@@ -60,10 +61,6 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     if (!m_socket->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
-    // Prepend the message size.
-    uint32_t message_size = buffer.data.size();
-    TRY(buffer.data.try_prepend(reinterpret_cast<u8 const*>(&message_size), sizeof(message_size)));
-
     for (auto& fd : buffer.fds) {
         if (auto result = fd_passing_socket().send_fd(fd->value()); result.is_error()) {
             shutdown_with_error(result.error());
@@ -71,7 +68,41 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
         }
     }
 
-    ReadonlyBytes bytes_to_write { buffer.data.span() };
+    // Prepend the message size.
+    u32 message_size = buffer.data.size();
+    TRY(m_outgoing_bytes.try_append(reinterpret_cast<u8 const*>(&message_size), sizeof(message_size)));
+    TRY(m_outgoing_bytes.try_append(buffer.data.data(), buffer.data.size()));
+
+    // File descriptors are sent right away, but the peer only picks them up once it sees the message they belong to.
+    // Holding back those messages could fill up the peer's descriptor queue and leave both sides waiting on each other.
+    if (m_batching_outgoing_messages && buffer.fds.is_empty()) {
+        // A handler may spin a nested event loop (e.g. while a dialog is open) and wait for the peer to react to
+        // something it has posted, so the messages must go out as soon as any event loop gets to run again.
+        schedule_flush_of_outgoing_messages();
+        return {};
+    }
+    return flush_outgoing_messages();
+}
+
+void ConnectionBase::schedule_flush_of_outgoing_messages()
+{
+    if (m_flush_of_outgoing_messages_scheduled)
+        return;
+    m_flush_of_outgoing_messages_scheduled = true;
+    m_deferred_invoker->schedule([strong_this = NonnullRefPtr(*this)] {
+        strong_this->m_flush_of_outgoing_messages_scheduled = false;
+        if (auto result = strong_this->flush_outgoing_messages(); result.is_error())
+            dbgln("IPC::ConnectionBase::schedule_flush_of_outgoing_messages: {}", result.error());
+    });
+}
+
+ErrorOr<void> ConnectionBase::flush_outgoing_messages()
+{
+    auto outgoing_bytes = move(m_outgoing_bytes);
+    if (outgoing_bytes.is_empty() || !m_socket->is_open())
+        return {};
+
+    ReadonlyBytes bytes_to_write { outgoing_bytes.span() };
     int writes_done = 0;
     size_t initial_size = bytes_to_write.size();
     while (!bytes_to_write.is_empty()) {
@@ -126,19 +157,25 @@ void ConnectionBase::handle_messages()
 {
     auto messages = move(m_unprocessed_messages);
     for (auto& message : messages) {
-        if (message->endpoint_magic() == m_local_endpoint_magic) {
+        if (message->endpoint_magic() != m_local_endpoint_magic)
+            continue;
+
+        // Everything a handler posts goes out together with its response, once the handler is done.
+        {
+            TemporaryChange batching_outgoing_messages { m_batching_outgoing_messages, true };
+
             auto handler_result = m_local_stub.handle(*message);
             if (handler_result.is_error()) {
                 dbgln("IPC::ConnectionBase::handle_messages: {}", handler_result.error());
-                continue;
-            }
-
-            if (auto response = handler_result.release_value()) {
+            } else if (auto response = handler_result.release_value()) {
                 if (auto post_result = post_message(*response); post_result.is_error()) {
                     dbgln("IPC::ConnectionBase::handle_messages: {}", post_result.error());
                 }
             }
         }
+
+        if (auto flush_result = flush_outgoing_messages(); flush_result.is_error())
+            dbgln("IPC::ConnectionBase::handle_messages: {}", flush_result.error());
     }
 }
 
@@ -239,6 +276,10 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 
 OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id)
 {
+    // The peer can't respond to messages that are still queued up on our side.
+    if (flush_outgoing_messages().is_error())
+        return {};
+
     for (;;) {
         // Double check we don't already have the event waiting for us.
         // Otherwise we might end up blocked for a while for no reason.
@@ -65,6 +65,8 @@ protected:
     ErrorOr<void> drain_messages_from_peer();
 
     ErrorOr<void> post_message(MessageBuffer);
+    ErrorOr<void> flush_outgoing_messages();
+    void schedule_flush_of_outgoing_messages();
     void handle_messages();
 
     IPC::Stub& m_local_stub;
@@ -77,6 +79,12 @@ protected:
     Vector<NonnullOwnPtr<Message>> m_unprocessed_messages;
     ByteBuffer m_unprocessed_bytes;
 
+    // While handling an incoming message, outgoing ones (including the response) are queued here and written to
+    // the socket together afterwards, before we block waiting for the peer, or when the event loop runs again.
+    Vector<u8> m_outgoing_bytes;
+    bool m_batching_outgoing_messages { false };
+    bool m_flush_of_outgoing_messages_scheduled { false };
+
     u32 m_local_endpoint_magic { 0 };
 
     NonnullOwnPtr<DeferredInvoker> m_deferred_invoker;
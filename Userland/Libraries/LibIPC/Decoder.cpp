@@ -12,9 +12,11 @@
 #include <LibCore/DateTime.h>
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibIPC/Decoder.h>
 #include <LibIPC/File.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 
 namespace IPC {
 
@@ -23,10 +25,39 @@ ErrorOr<size_t> Decoder::decode_size()
     return static_cast<size_t>(TRY(decode<u32>()));
 }
 
+// Mapping more of a file than it holds would crash us with SIGBUS on the first access beyond its end.
+static ErrorOr<void> verify_shared_memory_size(IPC::File const& file, size_t size)
+{
+    auto stat = TRY(Core::System::fstat(file.fd()));
+    if (stat.st_size < 0 || static_cast<u64>(stat.st_size) < size)
+        return Error::from_string_literal("Shared memory buffer is smaller than its claimed size");
+    return {};
+}
+
+ErrorOr<void> Decoder::decode_shared_memory_payload(Bytes bytes)
+{
+    auto anon_file = TRY(decode<IPC::File>());
+    TRY(verify_shared_memory_size(anon_file, bytes.size()));
+
+    // The sender can still write to the buffer, so we only ever look at a private copy of the payload.
+    // Otherwise, it could change the payload after we've validated it.
+    auto* data = TRY(Core::System::mmap(nullptr, bytes.size(), PROT_READ, MAP_SHARED, anon_file.fd(), 0));
+    ReadonlyBytes { data, bytes.size() }.copy_to(bytes);
+    TRY(Core::System::munmap(data, bytes.size()));
+    return {};
+}
+
 template<>
 ErrorOr<String> decode(Decoder& decoder)
 {
     auto length = TRY(decoder.decode_size());
+
+    if (length >= shared_memory_payload_threshold) {
+        auto payload = TRY(ByteBuffer::create_uninitialized(length));
+        TRY(decoder.decode_shared_memory_payload(payload.bytes()));
+        return String::from_utf8(StringView { payload });
+    }
+
     return String::from_stream(decoder.stream(), length);
 }
 
@@ -58,6 +89,11 @@ ErrorOr<ByteBuffer> decode(Decoder& decoder)
     auto buffer = TRY(ByteBuffer::create_uninitialized(length));
     auto bytes = buffer.bytes();
 
+    if (length >= shared_memory_payload_threshold) {
+        TRY(decoder.decode_shared_memory_payload(bytes));
+        return buffer;
+    }
+
     TRY(decoder.decode_into(bytes));
     return buffer;
 }
@@ -65,7 +101,13 @@ ErrorOr<ByteBuffer> decode(Decoder& decoder)
 template<>
 ErrorOr<JsonValue> decode(Decoder& decoder)
 {
-    auto json = TRY(decoder.decode<DeprecatedString>());
+    auto length = TRY(decoder.decode_size());
+
+    auto json = TRY(ByteBuffer::create_uninitialized(length));
+    if (length >= shared_memory_payload_threshold)
+        TRY(decoder.decode_shared_memory_payload(json.bytes()));
+    else
+        TRY(decoder.decode_into(json.bytes()));
     return JsonValue::from_string(json);
 }
 
@@ -111,6 +153,7 @@ ErrorOr<Core::AnonymousBuffer> decode(Decoder& decoder)
 
     auto size = TRY(decoder.decode_size());
     auto anon_file = TRY(decoder.decode<IPC::File>());
+    TRY(verify_shared_memory_size(anon_file, size));
 
     return Core::AnonymousBuffer::create_from_anon_fd(anon_file.take_fd(), size);
 }
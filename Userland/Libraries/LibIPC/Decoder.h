@@ -58,6 +58,9 @@ public:
 
     ErrorOr<size_t> decode_size();
 
+    // Copies a payload out of the shared memory buffer that Encoder::encode_bytes() put it in.
+    ErrorOr<void> decode_shared_memory_payload(Bytes);
+
     Stream& stream() { return m_stream; }
     Core::LocalSocket& socket() { return m_socket; }
 
@@ -114,10 +117,18 @@ ErrorOr<T> decode(Decoder& decoder)
     T vector;
 
     auto size = TRY(decoder.decode_size());
+
+    using ValueType = typename T::ValueType;
+    if constexpr (Arithmetic<ValueType> && !IsSame<ValueType, bool>) {
+        TRY(vector.try_resize(size));
+        TRY(decoder.decode_into(Bytes { reinterpret_cast<u8*>(vector.data()), size * sizeof(ValueType) }));
+        return vector;
+    }
+
     TRY(vector.try_ensure_capacity(size));
 
     for (size_t i = 0; i < size; ++i) {
-        auto value = TRY(decoder.decode<typename T::ValueType>());
+        auto value = TRY(decoder.decode<ValueType>());
         vector.template unchecked_append(move(value));
     }
 
@@ -31,6 +31,18 @@ ErrorOr<void> Encoder::encode_size(size_t size)
     return encode(static_cast<u32>(size));
 }
 
+ErrorOr<void> Encoder::encode_bytes(ReadonlyBytes bytes)
+{
+    TRY(encode_size(bytes.size()));
+
+    if (bytes.size() < shared_memory_payload_threshold)
+        return append(bytes.data(), bytes.size());
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(bytes.size()));
+    bytes.copy_to({ buffer.data<u8>(), buffer.size() });
+    return encode(IPC::File { buffer.fd() });
+}
+
 template<>
 ErrorOr<void> encode(Encoder& encoder, float const& value)
 {
@@ -46,10 +58,7 @@ ErrorOr<void> encode(Encoder& encoder, double const& value)
 template<>
 ErrorOr<void> encode(Encoder& encoder, String const& value)
 {
-    auto bytes = value.bytes();
-    TRY(encoder.encode_size(bytes.size()));
-    TRY(encoder.append(bytes.data(), bytes.size()));
-    return {};
+    return encoder.encode_bytes(value.bytes());
 }
 
 template<>
@@ -73,15 +82,14 @@ ErrorOr<void> encode(Encoder& encoder, DeprecatedString const& value)
 template<>
 ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& value)
 {
-    TRY(encoder.encode_size(value.size()));
-    TRY(encoder.append(value.data(), value.size()));
-    return {};
+    return encoder.encode_bytes(value.bytes());
 }
 
 template<>
 ErrorOr<void> encode(Encoder& encoder, JsonValue const& value)
 {
-    return encoder.encode(value.serialized<StringBuilder>());
+    auto serialized = value.serialized<StringBuilder>();
+    return encoder.encode_bytes(serialized.bytes());
 }
 
 template<>
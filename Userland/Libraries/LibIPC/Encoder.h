@@ -60,6 +60,10 @@ public:
 
     ErrorOr<void> encode_size(size_t size);
 
+    // Encodes the size of the payload, followed by either the payload itself or, if it is at least
+    // shared_memory_payload_threshold bytes long, a shared memory buffer holding it.
+    ErrorOr<void> encode_bytes(ReadonlyBytes);
+
 private:
     MessageBuffer& m_buffer;
 };
@@ -143,6 +147,12 @@ ErrorOr<void> encode(Encoder& encoder, T const& vector)
     // NOTE: Do not change this encoding without also updating LibC/netdb.cpp.
     TRY(encoder.encode_size(vector.size()));
 
+    using ValueType = typename T::ValueType;
+    if constexpr (Arithmetic<ValueType> && !IsSame<ValueType, bool>) {
+        // The elements are laid out exactly as they would be encoded one by one, so copy them all at once.
+        return encoder.append(reinterpret_cast<u8 const*>(vector.data()), vector.size() * sizeof(ValueType));
+    }
+
     for (auto const& value : vector)
         TRY(encoder.encode(value));
 
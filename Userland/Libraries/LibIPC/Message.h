@@ -33,6 +33,12 @@ private:
     int m_fd;
 };
 
+// Byte payloads (ByteBuffer, String and serialized JSON) at least this large are not copied into the
+// message itself. They are written to an anonymous shared memory buffer instead, and only its file
+// descriptor travels over the socket. This matches the size of a local socket's buffer, beyond which
+// a message could not be written in one go anyway.
+constexpr size_t shared_memory_payload_threshold = 64 * KiB;
+
 struct MessageBuffer {
     Vector<u8, 1024> data;
     Vector<NonnullRefPtr<AutoCloseFileDescriptor>, 1> fds;
@@ -5,6 +5,7 @@
  */
 
 #include <LibCore/AnonymousBuffer.h>
+#include <LibGfx/Bitmap.h>
 #include <LibImageDecoderClient/Client.h>
 
 namespace ImageDecoderClient {
@@ -16,23 +17,35 @@ Client::Client(NonnullOwnPtr<Core::LocalSocket> socket)
 
 void Client::die()
 {
+    auto pending_images = move(m_pending_images);
+    for (auto& it : pending_images) {
+        if (it.value->callbacks.on_error)
+            it.value->callbacks.on_error();
+    }
+
     if (on_death)
         on_death();
 }
 
+static ErrorOr<Core::AnonymousBuffer> copy_to_anonymous_buffer(ReadonlyBytes encoded_data)
+{
+    auto encoded_buffer = TRY(Core::AnonymousBuffer::create_with_size(encoded_data.size()));
+    memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
+    return encoded_buffer;
+}
+
 Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data, Optional<DeprecatedString> mime_type)
 {
     if (encoded_data.is_empty())
         return {};
 
-    auto encoded_buffer_or_error = Core::AnonymousBuffer::create_with_size(encoded_data.size());
+    auto encoded_buffer_or_error = copy_to_anonymous_buffer(encoded_data);
     if (encoded_buffer_or_error.is_error()) {
         dbgln("Could not allocate encoded buffer");
         return {};
     }
     auto encoded_buffer = encoded_buffer_or_error.release_value();
 
-    memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
     auto response_or_error = try_decode_image(move(encoded_buffer), mime_type);
 
     if (response_or_error.is_error()) {
@@ -59,4 +72,70 @@ Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data, Optional
     return image;
 }
 
+ErrorOr<i64> Client::start_decoding_image(ReadonlyBytes encoded_data, Optional<DeprecatedString> mime_type, ImageCallbacks callbacks)
+{
+    if (encoded_data.is_empty())
+        return Error::from_string_literal("No image data to decode");
+
+    auto encoded_buffer = TRY(copy_to_anonymous_buffer(encoded_data));
+    auto pending_image = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) PendingImage(move(callbacks))));
+
+    auto image_id = m_next_image_id++;
+    TRY(m_pending_images.try_set(image_id, move(pending_image)));
+    if (auto result = post_message(Messages::ImageDecoderServer::StartDecodingImage(image_id, move(encoded_buffer), move(mime_type))); result.is_error()) {
+        m_pending_images.remove(image_id);
+        return result.release_error();
+    }
+    return image_id;
+}
+
+void Client::decode_frames(i64 image_id, u32 first_frame_index, u32 frame_count)
+{
+    async_decode_frames(image_id, first_frame_index, frame_count);
+}
+
+void Client::release_image(i64 image_id)
+{
+    if (m_pending_images.remove(image_id))
+        async_release_image(image_id);
+}
+
+void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count)
+{
+    auto pending_image = m_pending_images.get(image_id);
+    if (!pending_image.has_value())
+        return;
+
+    // Keep the callbacks alive in case they release the image.
+    NonnullRefPtr image = *pending_image.value();
+    if (image->callbacks.on_decoded)
+        image->callbacks.on_decoded({ is_animated, loop_count, frame_count });
+}
+
+void Client::did_decode_frame(i64 image_id, u32 frame_index, Gfx::ShareableBitmap const& bitmap, u32 duration)
+{
+    auto pending_image = m_pending_images.get(image_id);
+    if (!pending_image.has_value())
+        return;
+
+    NonnullRefPtr image = *pending_image.value();
+    if (!bitmap.is_valid()) {
+        m_pending_images.remove(image_id);
+        async_release_image(image_id);
+        if (image->callbacks.on_error)
+            image->callbacks.on_error();
+        return;
+    }
+
+    if (image->callbacks.on_frame_decoded)
+        image->callbacks.on_frame_decoded(frame_index, { *bitmap.bitmap(), duration });
+}
+
+void Client::did_fail_to_decode_image(i64 image_id)
+{
+    auto pending_image = m_pending_images.take(image_id);
+    if (pending_image.has_value() && pending_image.value()->callbacks.on_error)
+        pending_image.value()->callbacks.on_error();
+}
+
 }
@@ -24,6 +24,19 @@ struct DecodedImage {
     Vector<Frame> frames;
 };
 
+struct ImageInfo {
+    bool is_animated { false };
+    u32 loop_count { 0 };
+    u32 frame_count { 0 };
+};
+
+struct ImageCallbacks {
+    Function<void(ImageInfo const&)> on_decoded;
+    Function<void(u32 frame_index, Frame const&)> on_frame_decoded;
+    // Called if the image or one of its frames can't be decoded, or if the ImageDecoder goes away.
+    Function<void()> on_error;
+};
+
 class Client final
     : public IPC::ConnectionToServer<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>
     , public ImageDecoderClientEndpoint {
@@ -32,12 +45,36 @@ class Client final
 public:
     Optional<DecodedImage> decode_image(ReadonlyBytes, Optional<DeprecatedString> mime_type = {});
 
+    // Decodes the image on the ImageDecoder's worker threads without blocking. Once the image's details are known,
+    // on_decoded is called, followed by on_frame_decoded for the first frame. Further frames are only decoded once
+    // they are requested with decode_frames(). The frames are shared with the ImageDecoder's cache, so they must not
+    // be modified. No callbacks are called after the image has been released.
+    ErrorOr<i64> start_decoding_image(ReadonlyBytes, Optional<DeprecatedString> mime_type, ImageCallbacks);
+    void decode_frames(i64 image_id, u32 first_frame_index, u32 frame_count);
+    void release_image(i64 image_id);
+
     Function<void()> on_death;
 
 private:
     Client(NonnullOwnPtr<Core::LocalSocket>);
 
     virtual void die() override;
+
+    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count) override;
+    virtual void did_decode_frame(i64 image_id, u32 frame_index, Gfx::ShareableBitmap const&, u32 duration) override;
+    virtual void did_fail_to_decode_image(i64 image_id) override;
+
+    struct PendingImage : public RefCounted<PendingImage> {
+        explicit PendingImage(ImageCallbacks callbacks)
+            : callbacks(move(callbacks))
+        {
+        }
+
+        ImageCallbacks callbacks;
+    };
+
+    HashMap<i64, NonnullRefPtr<PendingImage>> m_pending_images;
+    i64 m_next_image_id { 0 };
 };
 
 }
@@ -544,6 +544,20 @@ public:
 
     ThrowCompletionOr<void> global_declaration_instantiation(VM&, GlobalEnvironment&) const;
 
+    // The nodes that bytecode can refer to (functions, classes, scopes and regular expressions), in the order the
+    // parser created them. Parsing is deterministic, so an index into this list identifies the same node whenever
+    // the same source is parsed again, which is what lets Bytecode::ExecutableCache refer to AST nodes.
+    // Empty unless the cache was enabled when the program was parsed.
+    Vector<NonnullRefPtr<ASTNode const>> const& nodes_referenceable_from_bytecode() const { return m_nodes_referenceable_from_bytecode; }
+    void set_nodes_referenceable_from_bytecode(Badge<Parser>, Vector<NonnullRefPtr<ASTNode const>> nodes) { m_nodes_referenceable_from_bytecode = move(nodes); }
+
+    // Filled in by Bytecode::ExecutableCache the first time it looks at this program.
+    struct BytecodeCacheData {
+        DeprecatedString source_hash;
+        HashMap<ASTNode const*, u32> node_ids;
+    };
+    OwnPtr<BytecodeCacheData>& bytecode_cache_data() const { return m_bytecode_cache_data; }
+
 private:
     virtual bool is_program() const override { return true; }
 
@@ -553,6 +567,9 @@ private:
     Vector<NonnullRefPtr<ImportStatement const>> m_imports;
     Vector<NonnullRefPtr<ExportStatement const>> m_exports;
     bool m_has_top_level_await { false };
+
+    Vector<NonnullRefPtr<ASTNode const>> m_nodes_referenceable_from_bytecode;
+    mutable OwnPtr<BytecodeCacheData> m_bytecode_cache_data;
 };
 
 class BlockStatement final : public ScopeNode {
@@ -38,6 +38,11 @@ public:
 
     void grow(size_t additional_size);
 
+    // Used by optimization passes that build new instruction streams. The instructions are moved along with
+    // the bytes, so whoever takes the stream is responsible for destroying them.
+    Vector<u8> release_instruction_stream() { return move(m_buffer); }
+    void set_instruction_stream(Vector<u8> buffer) { m_buffer = move(buffer); }
+
     void terminate(Badge<Generator>) { m_terminated = true; }
     bool is_terminated() const { return m_terminated; }
 
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/WeakPtr.h>
 #include <LibJS/Bytecode/IdentifierTable.h>
 #include <LibJS/Bytecode/StringTable.h>
@@ -15,13 +17,45 @@
 
 namespace JS::Bytecode {
 
+// The inline cache of a single GetById or PutById instruction. It remembers up to a handful of shapes,
+// so instructions that see objects of a few different shapes (polymorphic sites) keep hitting the cache.
 struct PropertyLookupCache {
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+    static constexpr size_t max_prototype_chain_length = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        u64 unique_shape_serial_number { 0 };
+
+        // Stores that added a new property remember the shape the object transitioned to, and the shapes of
+        // its prototype chain, since a setter or read-only property showing up there changes what the store does.
+        bool is_add_property_transition { false };
+        WeakPtr<Shape> shape_after_transition;
+        u8 prototype_chain_length { 0 };
+        AK::Array<WeakPtr<Shape>, max_prototype_chain_length> prototype_chain_shapes;
+        AK::Array<u64, max_prototype_chain_length> prototype_chain_unique_shape_serial_numbers {};
+    };
+
+    Entry& entry_to_replace()
+    {
+        for (auto& entry : entries) {
+            if (!entry.shape)
+                return entry;
+        }
+        auto& entry = entries[next_entry_to_replace];
+        next_entry_to_replace = (next_entry_to_replace + 1) % max_number_of_shapes_to_remember;
+        return entry;
+    }
+
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+    u8 next_entry_to_replace { 0 };
+};
+
+struct GlobalVariableCache {
     WeakPtr<Shape> shape;
     Optional<u32> property_offset;
     u64 unique_shape_serial_number { 0 };
-};
-
-struct GlobalVariableCache : public PropertyLookupCache {
     u64 environment_serial_number { 0 };
 };
 
@@ -60,6 +94,17 @@ public:
     DeprecatedFlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
     void dump() const;
+
+    // Returns null until the executable has run often enough to be worth compiling to native code.
+    JIT::NativeExecutable const* get_or_create_native_executable();
+
+private:
+    // The number of basic blocks entered before we try compiling the executable with the JIT.
+    static constexpr u32 jit_hotness_threshold = 16;
+
+    u32 m_hotness { 0 };
+    bool m_did_try_jitting { false };
+    OwnPtr<JIT::NativeExecutable> m_native_executable;
 };
 
 }
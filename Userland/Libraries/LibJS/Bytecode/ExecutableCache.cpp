@@ -0,0 +1,777 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/Hex.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Checksum/CRC32.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/SourceCode.h>
+#include <dlfcn.h>
+
+#ifndef AK_OS_MACOS
+#    include <link.h>
+#endif
+
+namespace JS::Bytecode {
+
+static DeprecatedString s_directory;
+static ByteBuffer s_build_id;
+static ExecutableCache::Statistics s_statistics;
+
+static constexpr u32 cache_file_magic = 0x4342534a; // "JSBC"
+static constexpr u32 cache_file_version = 2;
+
+// Labels are stored as block indices inside the instruction stream, which only works if they are pointer-sized.
+static_assert(sizeof(Label) == sizeof(FlatPtr));
+
+#define __BYTECODE_OP(op) +1
+static constexpr size_t number_of_instruction_types = 0 ENUMERATE_BYTECODE_OPS(__BYTECODE_OP);
+#undef __BYTECODE_OP
+
+static size_t minimum_instruction_length(Instruction::Type type)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return sizeof(Op::op);
+
+    switch (type) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
+// Returns the GNU build ID of the loaded object that contains this function, if the linker gave it one.
+static Optional<ByteBuffer> find_gnu_build_id()
+{
+#ifdef AK_OS_MACOS
+    // Mach-O binaries have no GNU build ID notes.
+    return {};
+#else
+    static constexpr u32 gnu_build_id_note_type = 3;
+
+    struct Search {
+        FlatPtr address { 0 };
+        Optional<ByteBuffer> build_id;
+    } search { reinterpret_cast<FlatPtr>(&find_gnu_build_id), {} };
+
+    dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) {
+        auto& search = *static_cast<Search*>(data);
+        auto segments = ReadonlySpan<ElfW(Phdr)> { info->dlpi_phdr, info->dlpi_phnum };
+
+        auto contains_address = any_of(segments, [&](auto const& segment) {
+            auto start = info->dlpi_addr + segment.p_vaddr;
+            return segment.p_type == PT_LOAD && search.address >= start && search.address < start + segment.p_memsz;
+        });
+        if (!contains_address)
+            return 0;
+
+        for (auto const& segment : segments) {
+            if (segment.p_type != PT_NOTE)
+                continue;
+            ReadonlyBytes notes { reinterpret_cast<u8 const*>(info->dlpi_addr + segment.p_vaddr), segment.p_memsz };
+            while (notes.size() >= sizeof(ElfW(Nhdr))) {
+                ElfW(Nhdr) header;
+                __builtin_memcpy(&header, notes.data(), sizeof(header));
+                auto name_offset = sizeof(header);
+                auto description_offset = name_offset + align_up_to(header.n_namesz, 4);
+                auto next_note_offset = description_offset + align_up_to(header.n_descsz, 4);
+                if (next_note_offset > notes.size())
+                    break;
+                if (header.n_type == gnu_build_id_note_type && notes.slice(name_offset, header.n_namesz) == "GNU\0"sv.bytes()) {
+                    if (auto build_id = ByteBuffer::copy(notes.slice(description_offset, header.n_descsz)); !build_id.is_error())
+                        search.build_id = build_id.release_value();
+                    return 1;
+                }
+                notes = notes.slice(next_note_offset);
+            }
+        }
+        return 1;
+    },
+        &search);
+
+    return move(search.build_id);
+#endif
+}
+
+// Cached bytecode is only valid for the exact code that generated it. Any change to code generation, the optimization
+// passes or the layout of instructions can change what a cache file means, so every file is tagged with the build.
+static ErrorOr<ByteBuffer> compute_build_id()
+{
+    if (auto build_id = find_gnu_build_id(); build_id.has_value())
+        return build_id.release_value();
+
+    // Without a build ID note, the contents of the binary identify the build just as well, they just take longer to find.
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void const*>(&compute_build_id), &info) == 0 || !info.dli_fname)
+        return AK::Error::from_string_literal("Could not find the binary that contains LibJS");
+    auto binary = TRY(Core::MappedFile::map({ info.dli_fname, strlen(info.dli_fname) }));
+    auto digest = Crypto::Hash::SHA256::hash(binary->bytes());
+    return ByteBuffer::copy(digest.bytes());
+}
+
+static bool instruction_refers_to_ast_node(Instruction::Type type)
+{
+    return type == Instruction::Type::NewFunction
+        || type == Instruction::Type::NewClass
+        || type == Instruction::Type::BlockDeclarationInstantiation;
+}
+
+static bool instruction_needs_fixup(Instruction::Type type)
+{
+    return instruction_refers_to_ast_node(type) || type == Instruction::Type::NewBigInt;
+}
+
+void ExecutableCache::set_directory(DeprecatedString directory)
+{
+    if (!directory.is_empty() && s_build_id.is_empty()) {
+        auto build_id = compute_build_id();
+        if (build_id.is_error()) {
+            dbgln("Not caching bytecode: {}", build_id.error());
+            return;
+        }
+        s_build_id = build_id.release_value();
+    }
+    s_directory = move(directory);
+}
+
+ReadonlyBytes ExecutableCache::build_id()
+{
+    return s_build_id;
+}
+
+void ExecutableCache::set_build_id(ByteBuffer build_id)
+{
+    s_build_id = move(build_id);
+}
+
+DeprecatedString const& ExecutableCache::directory()
+{
+    return s_directory;
+}
+
+ExecutableCache::Statistics const& ExecutableCache::statistics()
+{
+    return s_statistics;
+}
+
+void ExecutableCache::reset_statistics()
+{
+    s_statistics = {};
+}
+
+static Program::BytecodeCacheData& cache_data_for(Program const& program)
+{
+    auto& data = program.bytecode_cache_data();
+    if (data)
+        return *data;
+
+    data = make<Program::BytecodeCacheData>();
+
+    // The same source text parses differently as a script or a module, or in strict mode.
+    Crypto::Hash::SHA256 sha256;
+    u8 const parse_goal[] = { static_cast<u8>(program.type()), program.is_strict_mode() };
+    sha256.update(parse_goal, sizeof(parse_goal));
+    sha256.update(program.source_code().code().bytes());
+    auto digest = sha256.digest();
+    data->source_hash = encode_hex(digest.bytes());
+
+    // Node ID 0 is the program itself.
+    auto const& nodes = program.nodes_referenceable_from_bytecode();
+    MUST(data->node_ids.try_ensure_capacity(nodes.size() + 1));
+    data->node_ids.set(&program, 0);
+    for (size_t i = 0; i < nodes.size(); ++i)
+        data->node_ids.set(nodes[i].ptr(), i + 1);
+    return *data;
+}
+
+static ErrorOr<u32> id_for_node(Program const& program, ASTNode const& node)
+{
+    auto id = cache_data_for(program).node_ids.get(&node);
+    if (!id.has_value())
+        return AK::Error::from_string_literal("AST node can't be referenced from cached bytecode");
+    return *id;
+}
+
+template<typename NodeType>
+static ErrorOr<NodeType const*> node_for_id(Program const& program, u32 id)
+{
+    ASTNode const* node = nullptr;
+    if (id == 0)
+        node = &program;
+    else if (id <= program.nodes_referenceable_from_bytecode().size())
+        node = program.nodes_referenceable_from_bytecode()[id - 1].ptr();
+    if (!node || !is<NodeType>(*node))
+        return AK::Error::from_string_literal("Cached bytecode refers to an unknown AST node");
+    return static_cast<NodeType const*>(node);
+}
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<u32>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<DeprecatedString> read_string(FixedMemoryStream& stream)
+{
+    auto length = TRY(stream.read_value<u32>());
+    if (length > stream.remaining())
+        return AK::Error::from_string_literal("Truncated string in cached bytecode");
+    auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+    TRY(stream.read_until_filled(buffer));
+    return DeprecatedString { buffer.bytes() };
+}
+
+static ErrorOr<void> write_optional_index(Stream& stream, Optional<u32> index)
+{
+    TRY(stream.write_value<u8>(index.has_value()));
+    TRY(stream.write_value<u32>(index.value_or(0)));
+    return {};
+}
+
+static Optional<u32> to_optional_index(Optional<IdentifierTableIndex> const& index)
+{
+    if (!index.has_value())
+        return {};
+    return index->value();
+}
+
+static Optional<u32> to_optional_index(Optional<Register> const& reg)
+{
+    if (!reg.has_value())
+        return {};
+    return reg->index();
+}
+
+static ErrorOr<Optional<u32>> read_optional_index(FixedMemoryStream& stream, size_t limit)
+{
+    auto has_value = TRY(stream.read_value<u8>());
+    auto value = TRY(stream.read_value<u32>());
+    if (!has_value)
+        return Optional<u32> {};
+    if (value >= limit)
+        return AK::Error::from_string_literal("Out of range index in cached bytecode");
+    return Optional<u32> { value };
+}
+
+ErrorOr<ByteBuffer> ExecutableCache::serialize(Executable const& executable, Program const& program, ASTNode const& node, FunctionKind kind)
+{
+    AllocatingMemoryStream stream;
+
+    TRY(stream.write_value<u32>(cache_file_magic));
+    TRY(stream.write_value<u32>(cache_file_version));
+    TRY(stream.write_value<u8>(s_build_id.size()));
+    TRY(stream.write_until_depleted(s_build_id));
+    TRY(stream.write_value<u32>(TRY(id_for_node(program, node))));
+    TRY(stream.write_value<u32>(node.start_offset()));
+    TRY(stream.write_value<u32>(node.end_offset()));
+    TRY(stream.write_value<u8>(to_underlying(kind)));
+
+    TRY(stream.write_value<u8>(executable.is_strict_mode));
+    TRY(stream.write_value<u32>(executable.number_of_registers));
+    TRY(stream.write_value<u32>(executable.property_lookup_caches.size()));
+    TRY(stream.write_value<u32>(executable.global_variable_caches.size()));
+
+    TRY(stream.write_value<u32>(executable.string_table->size()));
+    for (size_t i = 0; i < executable.string_table->size(); ++i)
+        TRY(write_string(stream, executable.string_table->get(i)));
+
+    TRY(stream.write_value<u32>(executable.identifier_table->size()));
+    for (size_t i = 0; i < executable.identifier_table->size(); ++i)
+        TRY(write_string(stream, executable.identifier_table->get(i)));
+
+    // Parsed regular expressions are recreated from the literal they were generated for.
+    TRY(stream.write_value<u32>(executable.regex_table->size()));
+    for (size_t i = 0; i < executable.regex_table->size(); ++i) {
+        auto const& regex = executable.regex_table->get(i);
+        auto literal = program.nodes_referenceable_from_bytecode().find_if([&](auto const& node) {
+            if (!is<RegExpLiteral>(*node))
+                return false;
+            auto const& literal = static_cast<RegExpLiteral const&>(*node);
+            return literal.parsed_pattern() == regex.pattern && literal.parsed_flags().value() == regex.flags.value();
+        });
+        if (literal.is_end())
+            return AK::Error::from_string_literal("Regular expression literal not found");
+        TRY(stream.write_value<u32>(TRY(id_for_node(program, **literal))));
+    }
+
+    HashMap<BasicBlock const*, FlatPtr> block_indices;
+    for (size_t i = 0; i < executable.basic_blocks.size(); ++i)
+        block_indices.set(executable.basic_blocks[i].ptr(), i);
+
+    TRY(stream.write_value<u32>(executable.basic_blocks.size()));
+    for (auto const& block : executable.basic_blocks) {
+        TRY(write_string(stream, block->name()));
+
+        // Swap the block pointers in all labels for block indices. This is done on a (suitably aligned) copy of the block.
+        Vector<FlatPtr> scratch;
+        TRY(scratch.try_resize(ceil_div(block->size(), sizeof(FlatPtr))));
+        Bytes bytes { scratch.data(), block->size() };
+        block->instruction_stream().copy_to(bytes);
+
+        AllocatingMemoryStream fixups;
+        u32 fixup_count = 0;
+        InstructionStreamIterator it(bytes);
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            switch (instruction.type()) {
+            case Instruction::Type::LoadImmediate:
+                if (static_cast<Op::LoadImmediate const&>(instruction).value().is_cell())
+                    return AK::Error::from_string_literal("Can't cache bytecode that embeds a cell");
+                break;
+            case Instruction::Type::IteratorClose:
+            case Instruction::Type::AsyncIteratorClose: {
+                auto const& completion_value = instruction.type() == Instruction::Type::IteratorClose
+                    ? static_cast<Op::IteratorClose const&>(instruction).completion_value()
+                    : static_cast<Op::AsyncIteratorClose const&>(instruction).completion_value();
+                if (completion_value.has_value() && completion_value->is_cell())
+                    return AK::Error::from_string_literal("Can't cache bytecode that embeds a cell");
+                break;
+            }
+            case Instruction::Type::PushDeclarativeEnvironment:
+                return AK::Error::from_string_literal("Can't cache PushDeclarativeEnvironment");
+            case Instruction::Type::NewFunction: {
+                auto const& new_function = static_cast<Op::NewFunction const&>(instruction);
+                TRY(fixups.write_value<u32>(it.offset()));
+                TRY(fixups.write_value<u32>(TRY(id_for_node(program, new_function.function_node()))));
+                TRY(write_optional_index(fixups, to_optional_index(new_function.lhs_name())));
+                TRY(write_optional_index(fixups, to_optional_index(new_function.home_object())));
+                ++fixup_count;
+                break;
+            }
+            case Instruction::Type::NewClass: {
+                auto const& new_class = static_cast<Op::NewClass const&>(instruction);
+                TRY(fixups.write_value<u32>(it.offset()));
+                TRY(fixups.write_value<u32>(TRY(id_for_node(program, new_class.class_expression()))));
+                TRY(write_optional_index(fixups, to_optional_index(new_class.lhs_name())));
+                ++fixup_count;
+                break;
+            }
+            case Instruction::Type::BlockDeclarationInstantiation: {
+                auto const& instantiation = static_cast<Op::BlockDeclarationInstantiation const&>(instruction);
+                TRY(fixups.write_value<u32>(it.offset()));
+                TRY(fixups.write_value<u32>(TRY(id_for_node(program, instantiation.scope_node()))));
+                ++fixup_count;
+                break;
+            }
+            case Instruction::Type::NewBigInt: {
+                auto const& new_bigint = static_cast<Op::NewBigInt const&>(instruction);
+                TRY(fixups.write_value<u32>(it.offset()));
+                TRY(write_string(fixups, new_bigint.bigint().to_base_deprecated(10)));
+                ++fixup_count;
+                break;
+            }
+            default:
+                break;
+            }
+
+            instruction.visit_labels([&](Label& label) {
+                label.m_block = reinterpret_cast<BasicBlock const*>(block_indices.get(&label.block()).value());
+            });
+            ++it;
+        }
+
+        TRY(stream.write_value<u32>(bytes.size()));
+        TRY(stream.write_until_depleted(bytes));
+        TRY(stream.write_value<u32>(fixup_count));
+        TRY(stream.write_until_depleted(TRY(fixups.read_until_eof())));
+    }
+
+    auto buffer = TRY(stream.read_until_eof());
+    u32 checksum = Crypto::Checksum::CRC32 { buffer.bytes() }.digest();
+    TRY(buffer.try_append(&checksum, sizeof(checksum)));
+    return buffer;
+}
+
+namespace {
+
+struct Fixup {
+    ASTNode const* node { nullptr };
+    Optional<u32> lhs_name;
+    Optional<u32> home_object;
+    DeprecatedString bigint;
+};
+
+struct SerializedBlock {
+    DeprecatedString name;
+    Vector<FlatPtr> scratch;
+    size_t size { 0 };
+    HashMap<u32, Fixup> fixups;
+
+    Bytes bytes() { return { scratch.data(), size }; }
+};
+
+struct OperandLimits {
+    size_t number_of_registers { 0 };
+    size_t identifier_count { 0 };
+    size_t string_count { 0 };
+    size_t regex_count { 0 };
+    size_t property_lookup_cache_count { 0 };
+    size_t global_variable_cache_count { 0 };
+    size_t local_count { 0 };
+};
+
+}
+
+// The checksum only catches accidental corruption, so everything an instruction refers to must be checked before the
+// interpreter gets to see it. Otherwise, a crafted cache file could make it access memory outside of the executable.
+static ErrorOr<void> validate_operands(Instruction& instruction, OperandLimits const& limits)
+{
+    // Variable-width instructions must be long enough for their trailing operands before we can visit them.
+    switch (instruction.type()) {
+    case Instruction::Type::CopyObjectExcludingProperties: {
+        auto const& copy = static_cast<Op::CopyObjectExcludingProperties const&>(instruction);
+        if (copy.excluded_names_count() > limits.number_of_registers || instruction.length() < copy.length_impl(copy.excluded_names_count()))
+            return AK::Error::from_string_literal("Invalid instruction length in cached bytecode");
+        break;
+    }
+    case Instruction::Type::NewArray: {
+        auto const& new_array = static_cast<Op::NewArray const&>(instruction);
+        if (new_array.element_count() == 0)
+            break;
+        if (instruction.length() < new_array.length_impl(new_array.element_count()))
+            return AK::Error::from_string_literal("Invalid instruction length in cached bytecode");
+        if (new_array.start().index() > new_array.end().index() || new_array.end().index() - new_array.start().index() + 1 != new_array.element_count())
+            return AK::Error::from_string_literal("Invalid register range in cached bytecode");
+        break;
+    }
+    case Instruction::Type::Call: {
+        auto const& call = static_cast<Op::Call const&>(instruction);
+        if (call.argument_count() > limits.number_of_registers || call.first_argument().index() > limits.number_of_registers - call.argument_count())
+            return AK::Error::from_string_literal("Invalid register range in cached bytecode");
+        break;
+    }
+    case Instruction::Type::LoadImmediate:
+        if (static_cast<Op::LoadImmediate const&>(instruction).value().is_cell())
+            return AK::Error::from_string_literal("Cached bytecode embeds a cell");
+        break;
+    case Instruction::Type::IteratorClose:
+    case Instruction::Type::AsyncIteratorClose: {
+        auto const& completion_value = instruction.type() == Instruction::Type::IteratorClose
+            ? static_cast<Op::IteratorClose const&>(instruction).completion_value()
+            : static_cast<Op::AsyncIteratorClose const&>(instruction).completion_value();
+        if (completion_value.has_value() && completion_value->is_cell())
+            return AK::Error::from_string_literal("Cached bytecode embeds a cell");
+        break;
+    }
+    default:
+        break;
+    }
+
+    bool has_valid_registers = true;
+    instruction.visit_operands([&](Register& reg) {
+        if (reg.index() >= limits.number_of_registers)
+            has_valid_registers = false;
+    });
+    if (!has_valid_registers)
+        return AK::Error::from_string_literal("Invalid register in cached bytecode");
+
+    bool has_valid_indices = true;
+    instruction.visit_indices([&](Instruction::IndexKind kind, size_t index) {
+        size_t limit = 0;
+        switch (kind) {
+        case Instruction::IndexKind::Identifier:
+            limit = limits.identifier_count;
+            break;
+        case Instruction::IndexKind::String:
+            limit = limits.string_count;
+            break;
+        case Instruction::IndexKind::Regex:
+            limit = limits.regex_count;
+            break;
+        case Instruction::IndexKind::PropertyLookupCache:
+            limit = limits.property_lookup_cache_count;
+            break;
+        case Instruction::IndexKind::GlobalVariableCache:
+            limit = limits.global_variable_cache_count;
+            break;
+        case Instruction::IndexKind::Local:
+            limit = limits.local_count;
+            break;
+        }
+        if (index >= limit)
+            has_valid_indices = false;
+    });
+    if (!has_valid_indices)
+        return AK::Error::from_string_literal("Invalid table index in cached bytecode");
+    return {};
+}
+
+ErrorOr<NonnullRefPtr<Executable>> ExecutableCache::deserialize(ReadonlyBytes data, Program const& program, ASTNode const& node, FunctionKind kind)
+{
+    if (data.size() < sizeof(u32))
+        return AK::Error::from_string_literal("Truncated bytecode cache file");
+    u32 checksum;
+    __builtin_memcpy(&checksum, data.offset_pointer(data.size() - sizeof(u32)), sizeof(u32));
+    data = data.trim(data.size() - sizeof(u32));
+    if (Crypto::Checksum::CRC32 { data }.digest() != checksum)
+        return AK::Error::from_string_literal("Bytecode cache file is corrupted");
+
+    FixedMemoryStream stream { data };
+
+    if (TRY(stream.read_value<u32>()) != cache_file_magic)
+        return AK::Error::from_string_literal("Not a bytecode cache file");
+    if (TRY(stream.read_value<u32>()) != cache_file_version)
+        return AK::Error::from_string_literal("Unsupported bytecode cache file version");
+    auto build_id = TRY(ByteBuffer::create_uninitialized(TRY(stream.read_value<u8>())));
+    TRY(stream.read_until_filled(build_id));
+    if (build_id != s_build_id)
+        return AK::Error::from_string_literal("Bytecode cache file was written by a different build");
+    if (TRY(stream.read_value<u32>()) != TRY(id_for_node(program, node)))
+        return AK::Error::from_string_literal("Bytecode cache file is for a different node");
+    if (TRY(stream.read_value<u32>()) != node.start_offset() || TRY(stream.read_value<u32>()) != node.end_offset())
+        return AK::Error::from_string_literal("Bytecode cache file is for a different source range");
+    if (TRY(stream.read_value<u8>()) != to_underlying(kind))
+        return AK::Error::from_string_literal("Bytecode cache file is for a different function kind");
+
+    bool is_strict_mode = TRY(stream.read_value<u8>());
+    auto number_of_registers = TRY(stream.read_value<u32>());
+    auto number_of_property_lookup_caches = TRY(stream.read_value<u32>());
+    auto number_of_global_variable_caches = TRY(stream.read_value<u32>());
+
+    auto string_table = make<StringTable>();
+    auto string_count = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < string_count; ++i)
+        string_table->insert(TRY(read_string(stream)));
+
+    auto identifier_table = make<IdentifierTable>();
+    auto identifier_count = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < identifier_count; ++i)
+        identifier_table->insert(TRY(read_string(stream)));
+
+    auto regex_table = make<RegexTable>();
+    auto regex_count = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < regex_count; ++i) {
+        auto const* literal = TRY(node_for_id<RegExpLiteral>(program, TRY(stream.read_value<u32>())));
+        regex_table->insert(ParsedRegex {
+            .regex = literal->parsed_regex(),
+            .pattern = literal->parsed_pattern(),
+            .flags = literal->parsed_flags(),
+        });
+    }
+
+    // Read and validate everything before creating any basic blocks. Their destructors run the destructors of all
+    // instructions, so we must not give up halfway through turning the serialized instructions back into real ones.
+    auto block_count = TRY(stream.read_value<u32>());
+    if (block_count == 0)
+        return AK::Error::from_string_literal("Cached bytecode has no basic blocks");
+    Vector<SerializedBlock> serialized_blocks;
+    TRY(serialized_blocks.try_ensure_capacity(block_count));
+    for (u32 i = 0; i < block_count; ++i) {
+        SerializedBlock block;
+        block.name = TRY(read_string(stream));
+        block.size = TRY(stream.read_value<u32>());
+        if (block.size > stream.remaining() || block.size % sizeof(FlatPtr) != 0)
+            return AK::Error::from_string_literal("Truncated basic block in cached bytecode");
+        TRY(block.scratch.try_resize(block.size / sizeof(FlatPtr)));
+        TRY(stream.read_until_filled(block.bytes()));
+
+        auto fixup_count = TRY(stream.read_value<u32>());
+        for (u32 j = 0; j < fixup_count; ++j) {
+            auto offset = TRY(stream.read_value<u32>());
+            if (offset + sizeof(Instruction) > block.size)
+                return AK::Error::from_string_literal("Out of range fixup in cached bytecode");
+            auto type = reinterpret_cast<Instruction const*>(block.bytes().offset_pointer(offset))->type();
+            Fixup fixup;
+            switch (type) {
+            case Instruction::Type::NewFunction:
+                fixup.node = TRY(node_for_id<FunctionExpression>(program, TRY(stream.read_value<u32>())));
+                fixup.lhs_name = TRY(read_optional_index(stream, identifier_count));
+                fixup.home_object = TRY(read_optional_index(stream, number_of_registers));
+                break;
+            case Instruction::Type::NewClass:
+                fixup.node = TRY(node_for_id<ClassExpression>(program, TRY(stream.read_value<u32>())));
+                fixup.lhs_name = TRY(read_optional_index(stream, identifier_count));
+                break;
+            case Instruction::Type::BlockDeclarationInstantiation:
+                fixup.node = TRY(node_for_id<ScopeNode>(program, TRY(stream.read_value<u32>())));
+                break;
+            case Instruction::Type::NewBigInt:
+                fixup.bigint = TRY(read_string(stream));
+                break;
+            default:
+                return AK::Error::from_string_literal("Unexpected fixup in cached bytecode");
+            }
+            block.fixups.set(offset, move(fixup));
+        }
+        serialized_blocks.unchecked_append(move(block));
+    }
+    if (!stream.is_eof())
+        return AK::Error::from_string_literal("Trailing data in cached bytecode");
+
+    OperandLimits limits {
+        .number_of_registers = number_of_registers,
+        .identifier_count = identifier_count,
+        .string_count = string_count,
+        .regex_count = regex_count,
+        .property_lookup_cache_count = number_of_property_lookup_caches,
+        .global_variable_cache_count = number_of_global_variable_caches,
+        .local_count = is<ScopeNode>(node) ? static_cast<ScopeNode const&>(node).local_variables_names().size() : 0,
+    };
+    for (auto& block : serialized_blocks) {
+        size_t offset = 0;
+        while (offset < block.size) {
+            if (offset + sizeof(Instruction) > block.size)
+                return AK::Error::from_string_literal("Truncated instruction in cached bytecode");
+            auto& instruction = *reinterpret_cast<Instruction*>(block.bytes().offset_pointer(offset));
+            if (static_cast<size_t>(to_underlying(instruction.type())) >= number_of_instruction_types)
+                return AK::Error::from_string_literal("Invalid instruction in cached bytecode");
+            if (instruction.length() < minimum_instruction_length(instruction.type()) || instruction.length() % alignof(void*) != 0 || offset + instruction.length() > block.size)
+                return AK::Error::from_string_literal("Invalid instruction length in cached bytecode");
+            if (instruction_needs_fixup(instruction.type()) != block.fixups.contains(offset))
+                return AK::Error::from_string_literal("Missing fixup in cached bytecode");
+
+            bool has_valid_labels = true;
+            instruction.visit_labels([&](Label& label) {
+                if (reinterpret_cast<FlatPtr>(label.m_block) >= block_count)
+                    has_valid_labels = false;
+            });
+            if (!has_valid_labels)
+                return AK::Error::from_string_literal("Invalid jump target in cached bytecode");
+
+            TRY(validate_operands(instruction, limits));
+
+            offset += instruction.length();
+        }
+    }
+
+    // From here on, nothing can fail.
+    Vector<NonnullOwnPtr<BasicBlock>> basic_blocks;
+    TRY(basic_blocks.try_ensure_capacity(block_count));
+    for (auto& serialized_block : serialized_blocks)
+        basic_blocks.unchecked_append(BasicBlock::create(move(serialized_block.name)));
+
+    for (size_t i = 0; i < block_count; ++i) {
+        auto& serialized_block = serialized_blocks[i];
+        auto& block = *basic_blocks[i];
+        block.grow(serialized_block.size);
+        serialized_block.bytes().copy_to({ block.data(), block.size() });
+
+        InstructionStreamIterator it(block.instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) {
+                label.m_block = basic_blocks[reinterpret_cast<FlatPtr>(label.m_block)].ptr();
+            });
+
+            // These instructions hold references to AST nodes or heap memory, so they have to be constructed again.
+            if (auto fixup = serialized_block.fixups.get(it.offset()); fixup.has_value()) {
+                auto source_record = instruction.source_record();
+                auto to_identifier_index = [](Optional<u32> index) -> Optional<IdentifierTableIndex> {
+                    if (!index.has_value())
+                        return {};
+                    return IdentifierTableIndex { *index };
+                };
+                Instruction* reconstructed = nullptr;
+                switch (instruction.type()) {
+                case Instruction::Type::NewFunction: {
+                    Optional<Register> home_object;
+                    if (fixup->home_object.has_value())
+                        home_object = Register { *fixup->home_object };
+                    reconstructed = new (&instruction) Op::NewFunction(static_cast<FunctionExpression const&>(*fixup->node), to_identifier_index(fixup->lhs_name), home_object);
+                    break;
+                }
+                case Instruction::Type::NewClass:
+                    reconstructed = new (&instruction) Op::NewClass(static_cast<ClassExpression const&>(*fixup->node), to_identifier_index(fixup->lhs_name));
+                    break;
+                case Instruction::Type::BlockDeclarationInstantiation:
+                    reconstructed = new (&instruction) Op::BlockDeclarationInstantiation(static_cast<ScopeNode const&>(*fixup->node));
+                    break;
+                case Instruction::Type::NewBigInt:
+                    reconstructed = new (&instruction) Op::NewBigInt(Crypto::SignedBigInteger::from_base(10, fixup->bigint));
+                    break;
+                default:
+                    VERIFY_NOT_REACHED();
+                }
+                reconstructed->set_source_record(source_record);
+            }
+            ++it;
+        }
+    }
+
+    return adopt_ref(*new Executable(
+        move(identifier_table),
+        move(string_table),
+        move(regex_table),
+        node.source_code(),
+        number_of_property_lookup_caches,
+        number_of_global_variable_caches,
+        number_of_registers,
+        move(basic_blocks),
+        is_strict_mode));
+}
+
+static ErrorOr<DeprecatedString> cache_file_path(Program const& program, ASTNode const& node)
+{
+    auto id = TRY(id_for_node(program, node));
+    // Optimized and unoptimized bytecode are kept apart, so that --disable-bytecode-optimizations does what it says.
+    return DeprecatedString::formatted("{}/{}-{}{}", s_directory, cache_data_for(program).source_hash, id, g_optimize_bytecode ? ""sv : "-unoptimized"sv);
+}
+
+static ErrorOr<NonnullRefPtr<Executable>> load(Program const& program, ASTNode const& node, FunctionKind kind)
+{
+    auto path = TRY(cache_file_path(program, node));
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto data = TRY(file->read_until_eof());
+    return ExecutableCache::deserialize(data, program, node, kind);
+}
+
+static ErrorOr<void> store(Executable const& executable, Program const& program, ASTNode const& node, FunctionKind kind)
+{
+    auto path = TRY(cache_file_path(program, node));
+    auto data = TRY(ExecutableCache::serialize(executable, program, node, kind));
+
+    // Write to a temporary file first, so that nobody ever sees a partially written cache file.
+    auto temporary_path = DeprecatedString::formatted("{}.{}.tmp", path, getpid());
+    {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        if (auto result = file->write_until_depleted(data); result.is_error()) {
+            (void)Core::System::unlink(temporary_path);
+            return result.release_error();
+        }
+    }
+    if (auto result = Core::System::rename(temporary_path, path); result.is_error()) {
+        (void)Core::System::unlink(temporary_path);
+        return result.release_error();
+    }
+    return {};
+}
+
+CodeGenerationErrorOr<NonnullRefPtr<Executable>> ExecutableCache::generate(Program const& program, ASTNode const& node, FunctionKind kind)
+{
+    // Nodes that weren't created by the parser (or belong to a different program) have no ID we could use.
+    if (!is_enabled() || !cache_data_for(program).node_ids.contains(&node))
+        return Generator::generate(node, kind);
+
+    if (auto executable = load(program, node, kind); !executable.is_error()) {
+        ++s_statistics.hits;
+        return executable.release_value();
+    }
+    ++s_statistics.misses;
+
+    // Store the executable right away, while its inline caches are still empty.
+    auto executable = TRY(Generator::generate(node, kind));
+    if (!store(*executable, program, node, kind).is_error())
+        ++s_statistics.stores;
+    return executable;
+}
+
+}
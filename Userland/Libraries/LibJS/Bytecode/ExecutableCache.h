@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/DeprecatedString.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibJS/Bytecode/CodeGenerationError.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/FunctionKind.h>
+
+namespace JS::Bytecode {
+
+// Keeps generated bytecode on disk, so that loading the same script or module again can skip code generation.
+//
+// Every executable is stored in its own file, named after a hash of the program's source text and the ID of the
+// node it was generated for (see Program::nodes_referenceable_from_bytecode()). Bytecode still refers to the AST
+// (function objects, declaration instantiation and Function.prototype.toString() all need it), so the program has
+// to be parsed again before its cached executables can be used.
+class ExecutableCache {
+public:
+    // The cache is disabled until a directory is set. Passing an empty string disables it again.
+    static void set_directory(DeprecatedString);
+    static DeprecatedString const& directory();
+    static bool is_enabled() { return !directory().is_empty(); }
+
+    // Cache files are only used by the build that wrote them. The build is identified by the GNU build ID of the
+    // binary that contains LibJS, or by a hash of that binary if it has none. Tests can pretend to be a different build.
+    static ReadonlyBytes build_id();
+    static void set_build_id(ByteBuffer);
+
+    // Loads the executable for `node` (which must be `program` itself or one of its nodes) from the cache, or
+    // generates it and stores it in the cache.
+    static CodeGenerationErrorOr<NonnullRefPtr<Executable>> generate(Program const&, ASTNode const& node, FunctionKind = FunctionKind::Normal);
+
+    // Not every executable can be cached, e.g. ones that embed heap-allocated values. Those fail to serialize.
+    static ErrorOr<ByteBuffer> serialize(Executable const&, Program const&, ASTNode const& node, FunctionKind);
+    static ErrorOr<NonnullRefPtr<Executable>> deserialize(ReadonlyBytes, Program const&, ASTNode const& node, FunctionKind);
+
+    struct Statistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+        size_t stores { 0 };
+    };
+    static Statistics const& statistics();
+    static void reset_statistics();
+};
+
+}
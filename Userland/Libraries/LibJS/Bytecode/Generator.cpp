@@ -9,6 +9,7 @@
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibJS/Bytecode/Register.h>
 
 namespace JS::Bytecode {
@@ -67,6 +68,9 @@ CodeGenerationErrorOr<NonnullRefPtr<Executable>> Generator::generate(ASTNode con
         move(generator.m_root_basic_blocks),
         is_strict_mode));
 
+    if (g_optimize_bytecode)
+        optimization_pipeline().perform(*executable);
+
     return executable;
 }
 
@@ -276,7 +280,7 @@ CodeGenerationErrorOr<void> Generator::emit_store_to_reference(JS::ASTNode const
             } else {
                 // 3. Let propertyKey be StringValue of IdentifierName.
                 auto identifier_table_ref = intern_identifier(verify_cast<Identifier>(expression.property()).string());
-                emit<Bytecode::Op::PutByIdWithThis>(super_reference.base, super_reference.this_value, identifier_table_ref);
+                emit_put_by_id_with_this(super_reference.base, super_reference.this_value, identifier_table_ref);
             }
         } else {
             TRY(expression.object().generate_bytecode(*this));
@@ -293,7 +297,7 @@ CodeGenerationErrorOr<void> Generator::emit_store_to_reference(JS::ASTNode const
             } else if (expression.property().is_identifier()) {
                 emit<Bytecode::Op::Load>(value_reg);
                 auto identifier_table_ref = intern_identifier(verify_cast<Identifier>(expression.property()).string());
-                emit<Bytecode::Op::PutById>(object_reg, identifier_table_ref);
+                emit_put_by_id(object_reg, identifier_table_ref);
             } else if (expression.property().is_private_identifier()) {
                 emit<Bytecode::Op::Load>(value_reg);
                 auto identifier_table_ref = intern_identifier(verify_cast<PrivateIdentifier>(expression.property()).string());
@@ -546,4 +550,14 @@ void Generator::emit_get_by_id_with_this(IdentifierTableIndex id, Register this_
     emit<Op::GetByIdWithThis>(id, this_reg, m_next_property_lookup_cache++);
 }
 
+void Generator::emit_put_by_id(Register base, IdentifierTableIndex id, Op::PropertyKind kind)
+{
+    emit<Op::PutById>(base, id, m_next_property_lookup_cache++, kind);
+}
+
+void Generator::emit_put_by_id_with_this(Register base, Register this_value, IdentifierTableIndex id)
+{
+    emit<Op::PutByIdWithThis>(base, this_value, id, m_next_property_lookup_cache++);
+}
+
 }
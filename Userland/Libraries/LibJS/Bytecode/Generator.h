@@ -205,6 +205,9 @@ public:
     void emit_get_by_id(IdentifierTableIndex);
     void emit_get_by_id_with_this(IdentifierTableIndex, Register);
 
+    void emit_put_by_id(Register base, IdentifierTableIndex, Op::PropertyKind = Op::PropertyKind::KeyValue);
+    void emit_put_by_id_with_this(Register base, Register this_value, IdentifierTableIndex);
+
     [[nodiscard]] size_t next_global_variable_cache() { return m_next_global_variable_cache++; }
 
 private:
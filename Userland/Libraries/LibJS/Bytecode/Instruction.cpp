@@ -26,6 +26,54 @@ void Instruction::destroy(Instruction& instruction)
 #undef __BYTECODE_OP
 }
 
+void Instruction::visit_labels(Function<void(Label&)> const& visitor)
+{
+#define __BYTECODE_OP(op)                                       \
+    case Type::op:                                              \
+        static_cast<Op::op&>(*this).visit_labels_impl(visitor); \
+        return;
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
+void Instruction::visit_operands(Function<void(Register&)> const& visitor)
+{
+#define __BYTECODE_OP(op)                                         \
+    case Type::op:                                                \
+        static_cast<Op::op&>(*this).visit_operands_impl(visitor); \
+        return;
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
+void Instruction::visit_indices(Function<void(IndexKind, size_t)> const& visitor) const
+{
+#define __BYTECODE_OP(op)                                              \
+    case Type::op:                                                     \
+        static_cast<Op::op const&>(*this).visit_indices_impl(visitor); \
+        return;
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
 UnrealizedSourceRange InstructionStreamIterator::source_range() const
 {
     VERIFY(m_executable);
@@ -7,8 +7,11 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/Function.h>
 #include <AK/Span.h>
 #include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Register.h>
 #include <LibJS/Forward.h>
 #include <LibJS/SourceRange.h>
 
@@ -138,11 +141,34 @@ public:
     ThrowCompletionOr<void> execute(Bytecode::Interpreter&) const;
     static void destroy(Instruction&);
 
+    // Calls the visitor for every Label the instruction jumps to.
+    void visit_labels(Function<void(Label&)> const&);
+
+    // Calls the visitor for every Register operand, not including the accumulator.
+    // NOTE: For instructions that take a range of registers (Call and NewArray), only the bounds are visited.
+    void visit_operands(Function<void(Register&)> const&);
+
+    enum class IndexKind {
+        Identifier,
+        String,
+        Regex,
+        PropertyLookupCache,
+        GlobalVariableCache,
+        Local,
+    };
+
+    // Calls the visitor for every index into one of the executable's tables or caches, or into the function's locals.
+    void visit_indices(Function<void(IndexKind, size_t)> const&) const;
+
     // FIXME: Find a better way to organize this information
     void set_source_record(SourceRecord rec) { m_source_record = rec; }
     SourceRecord source_record() const { return m_source_record; }
 
 protected:
+    void visit_labels_impl(Function<void(Label&)> const&) { }
+    void visit_operands_impl(Function<void(Register&)> const&) { }
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const&) const { }
+
     Instruction(Type type, size_t length)
         : m_type(type)
         , m_length(length)
@@ -175,6 +201,14 @@ public:
         m_ptr += dereference().length();
     }
 
+    // Moves the iterator to the instruction at the given offset of another instruction stream.
+    void set_position(ReadonlyBytes bytes, size_t offset)
+    {
+        m_begin = bytes.data();
+        m_end = bytes.data() + bytes.size();
+        m_ptr = m_begin + offset;
+    }
+
     UnrealizedSourceRange source_range() const;
     RefPtr<SourceCode> source_code() const;
 
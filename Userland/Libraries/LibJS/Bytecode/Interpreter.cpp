@@ -9,10 +9,12 @@
 #include <AK/TemporaryChange.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -35,6 +37,7 @@
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_jit_enabled = false;
 
 Interpreter::Interpreter(VM& vm)
     : m_vm(vm)
@@ -101,7 +104,7 @@ ThrowCompletionOr<Value> Interpreter::run(Script& script_record, JS::GCPtr<Envir
 
     // 13. If result.[[Type]] is normal, then
     if (result.type() == Completion::Type::Normal) {
-        auto executable_result = JS::Bytecode::Generator::generate(script);
+        auto executable_result = JS::Bytecode::ExecutableCache::generate(script, script);
 
         if (executable_result.is_error()) {
             if (auto error_string = executable_result.error().to_string(); error_string.is_error())
@@ -192,9 +195,27 @@ void Interpreter::run_bytecode()
 
         ThrowCompletionOr<void> result;
 
+        // Set when native code already executed the instruction at pc, and we only need to handle its result.
+        bool instruction_was_executed_natively = false;
+
+        if (g_jit_enabled) {
+            if (auto const* native_executable = m_current_executable->get_or_create_native_executable()) {
+                auto exit = native_executable->run(*this, *m_current_block, registers, locals);
+                m_current_block = m_current_executable->basic_blocks[exit.block_index];
+                pc.set_position(m_current_block->instruction_stream(), exit.offset);
+                if (exit.reason == JIT::NativeExecutable::ExitReason::Threw) {
+                    result = throw_completion(reg(Register::exception()));
+                    instruction_was_executed_natively = true;
+                }
+            }
+        }
+
         while (!pc.at_end()) {
             auto& instruction = *pc;
 
+            if (exchange(instruction_was_executed_natively, false))
+                goto handle_result;
+
             switch (instruction.type()) {
             case Instruction::Type::GetLocal: {
                 auto& local = locals[static_cast<Op::GetLocal const&>(instruction).index()];
@@ -271,6 +292,7 @@ void Interpreter::run_bytecode()
                 break;
             }
 
+        handle_result:
             if (result.is_error()) [[unlikely]] {
                 reg(Register::exception()) = *result.throw_completion().value();
                 if (unwind_contexts().is_empty())
@@ -333,6 +355,12 @@ void Interpreter::run_bytecode()
     }
 }
 
+void Interpreter::set_current_instruction(BasicBlock const& block, Instruction const& instruction)
+{
+    m_current_block = &block;
+    m_pc->set_position(block.instruction_stream(), reinterpret_cast<u8 const*>(&instruction) - block.data());
+}
+
 Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable& executable, BasicBlock const* entry_point, CallFrame* in_frame)
 {
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter will run unit {:p}", &executable);
@@ -408,9 +436,9 @@ void Interpreter::leave_unwind_context()
     unwind_contexts().take_last();
 }
 
-ThrowCompletionOr<NonnullRefPtr<Bytecode::Executable>> compile(VM& vm, ASTNode const& node, FunctionKind kind, DeprecatedFlyString const& name)
+ThrowCompletionOr<NonnullRefPtr<Bytecode::Executable>> compile(VM& vm, ASTNode const& node, FunctionKind kind, DeprecatedFlyString const& name, Program const* program)
 {
-    auto executable_result = Bytecode::Generator::generate(node, kind);
+    auto executable_result = program ? ExecutableCache::generate(*program, node, kind) : Generator::generate(node, kind);
     if (executable_result.is_error())
         return vm.throw_completion<InternalError>(ErrorType::NotImplemented, TRY_OR_THROW_OOM(vm, executable_result.error().to_string()));
 
@@ -466,8 +494,126 @@ DeprecatedString Instruction::to_deprecated_string(Bytecode::Executable const& e
 
 namespace JS::Bytecode::Op {
 
-static ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value this_value, Value value, PropertyKey name, PropertyKind kind)
+static bool shape_matches_cache_entry(Shape const& shape, PropertyLookupCache::Entry const& entry)
+{
+    // NOTE: Unique shapes don't change identity, so we compare their serial numbers instead.
+    return &shape == entry.shape
+        && (!shape.is_unique() || shape.unique_shape_serial_number() == entry.unique_shape_serial_number);
+}
+
+static bool prototype_chain_matches_cache_entry(Shape const& shape, PropertyLookupCache::Entry const& entry)
+{
+    // NOTE: Each shape knows its prototype, so matching shapes all the way up also means matching prototype objects.
+    auto const* prototype = shape.prototype();
+    for (size_t i = 0; i < entry.prototype_chain_length; ++i) {
+        if (!prototype)
+            return false;
+        auto const& prototype_shape = prototype->shape();
+        if (&prototype_shape != entry.prototype_chain_shapes[i])
+            return false;
+        if (prototype_shape.is_unique() && prototype_shape.unique_shape_serial_number() != entry.prototype_chain_unique_shape_serial_numbers[i])
+            return false;
+        prototype = prototype_shape.prototype();
+    }
+    return !prototype;
+}
+
+// Tries to perform a store using a previously cached shape. Returns true if the store was done.
+static ThrowCompletionOr<bool> try_put_by_id_from_cache(Object& object, Value value, PropertyKind kind, PropertyLookupCache& cache)
+{
+    auto& shape = object.shape();
+    for (auto& entry : cache.entries) {
+        if (!shape_matches_cache_entry(shape, entry))
+            continue;
+
+        if (!entry.is_add_property_transition) {
+            object.put_direct(entry.property_offset.value(), value);
+            return true;
+        }
+
+        if (!entry.shape_after_transition)
+            continue;
+        // Properties can only be added to extensible objects.
+        if (!TRY(object.internal_is_extensible()))
+            continue;
+        // [[Set]] only adds the property if nothing on the prototype chain intercepts the store.
+        if (kind == PropertyKind::KeyValue && !prototype_chain_matches_cache_entry(shape, entry))
+            continue;
+        object.add_direct_property_with_transition(*entry.shape_after_transition, value);
+        return true;
+    }
+    return false;
+}
+
+static void update_put_by_id_cache(Object& object, Shape& shape_before_store, CacheablePropertyMetadata const& metadata, PropertyLookupCache& cache)
+{
+    auto& shape = object.shape();
+
+    if (metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
+        auto& entry = cache.entry_to_replace();
+        entry = {};
+        entry.shape = shape;
+        entry.property_offset = metadata.property_offset.value();
+        entry.unique_shape_serial_number = shape.unique_shape_serial_number();
+        return;
+    }
+
+    if (metadata.type != CacheablePropertyMetadata::Type::AddOwnProperty)
+        return;
+
+    // Only plain transitions can be replayed: unique shapes are modified in place, and the new property must end up last.
+    if (shape_before_store.is_unique() || shape.is_unique())
+        return;
+    if (shape.property_count() != shape_before_store.property_count() + 1 || metadata.property_offset != shape_before_store.property_count())
+        return;
+
+    PropertyLookupCache::Entry new_entry;
+    new_entry.shape = shape_before_store;
+    new_entry.is_add_property_transition = true;
+    new_entry.shape_after_transition = shape;
+    for (auto* prototype = shape_before_store.prototype(); prototype; prototype = prototype->shape().prototype()) {
+        if (new_entry.prototype_chain_length == PropertyLookupCache::max_prototype_chain_length)
+            return;
+        // NOTE: A matching shape means the same prototype object, so it's enough to check for exotic prototypes here.
+        if (prototype->has_exotic_internal_methods())
+            return;
+        auto& prototype_shape = prototype->shape();
+        new_entry.prototype_chain_shapes[new_entry.prototype_chain_length] = prototype_shape;
+        new_entry.prototype_chain_unique_shape_serial_numbers[new_entry.prototype_chain_length] = prototype_shape.unique_shape_serial_number();
+        ++new_entry.prototype_chain_length;
+    }
+    cache.entry_to_replace() = move(new_entry);
+}
+
+static ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value this_value, Value value, PropertyKey name, PropertyKind kind, PropertyLookupCache* cache = nullptr)
 {
+    // OPTIMIZATION: Plain stores to an object that are cached by the instruction can skip the full [[Set]] or [[DefineOwnProperty]].
+    //               This only applies when the receiver is the base object itself (i.e. not for super property stores).
+    //               Exotic objects (arrays, proxies, typed arrays, etc.) are never cached, as their internal methods may do more than a plain store.
+    if (cache && (kind == PropertyKind::KeyValue || kind == PropertyKind::DirectKeyValue) && base.is_object() && this_value.is_object() && &this_value.as_object() == &base.as_object() && !base.as_object().has_exotic_internal_methods()) {
+        auto& object = base.as_object();
+        if (TRY(try_put_by_id_from_cache(object, value, kind, *cache)))
+            return {};
+
+        NonnullGCPtr<Shape> shape_before_store = object.shape();
+        CacheablePropertyMetadata cacheable_metadata;
+        if (kind == PropertyKind::KeyValue) {
+            bool succeeded = TRY(object.internal_set(name, value, this_value, &cacheable_metadata));
+            if (!succeeded && vm.in_strict_mode())
+                return vm.throw_completion<TypeError>(ErrorType::ReferenceNullishSetProperty, name, base.to_string_without_side_effects());
+            if (!succeeded)
+                return {};
+        } else {
+            object.define_direct_property(name, value, Attribute::Enumerable | Attribute::Writable | Attribute::Configurable);
+            if (&object.shape() != shape_before_store.ptr() && !name.is_number()) {
+                if (auto metadata = object.shape().lookup(name.to_string_or_symbol()); metadata.has_value())
+                    cacheable_metadata = { .type = CacheablePropertyMetadata::Type::AddOwnProperty, .property_offset = metadata->offset };
+            }
+        }
+        update_put_by_id_cache(object, *shape_before_store, cacheable_metadata, *cache);
+        return {};
+    }
+
     auto object = TRY(base.to_object(vm));
     if (kind == PropertyKind::Getter || kind == PropertyKind::Setter) {
         // The generator should only pass us functions for getters and setters.
@@ -1053,22 +1199,24 @@ static ThrowCompletionOr<void> get_by_id(Bytecode::Interpreter& interpreter, Ide
 
     auto base_obj = TRY(base_object_for_get(interpreter, base_value));
 
-    // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-    // NOTE: Unique shapes don't change identity, so we compare their serial numbers instead.
+    // OPTIMIZATION: If the object has one of the shapes we've seen here before, we can use the cached property offset.
     auto& shape = base_obj->shape();
-    if (&shape == cache.shape
-        && (!shape.is_unique() || shape.unique_shape_serial_number() == cache.unique_shape_serial_number)) {
-        interpreter.accumulator() = base_obj->get_direct(cache.property_offset.value());
-        return {};
+    for (auto const& entry : cache.entries) {
+        if (shape_matches_cache_entry(shape, entry)) {
+            interpreter.accumulator() = base_obj->get_direct(entry.property_offset.value());
+            return {};
+        }
     }
 
     CacheablePropertyMetadata cacheable_metadata;
     interpreter.accumulator() = TRY(base_obj->internal_get(name, this_value, &cacheable_metadata));
 
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.unique_shape_serial_number = shape.unique_shape_serial_number();
+        auto& entry = cache.entry_to_replace();
+        entry = {};
+        entry.shape = shape;
+        entry.property_offset = cacheable_metadata.property_offset.value();
+        entry.unique_shape_serial_number = shape.unique_shape_serial_number();
     }
 
     return {};
@@ -1118,7 +1266,8 @@ ThrowCompletionOr<void> PutById::execute_impl(Bytecode::Interpreter& interpreter
     auto value = interpreter.accumulator();
     auto base = interpreter.reg(m_base);
     PropertyKey name = interpreter.current_executable().get_identifier(m_property);
-    TRY(put_by_property_key(vm, base, base, value, name, m_kind));
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+    TRY(put_by_property_key(vm, base, base, value, name, m_kind, &cache));
     interpreter.accumulator() = value;
     return {};
 }
@@ -1130,7 +1279,8 @@ ThrowCompletionOr<void> PutByIdWithThis::execute_impl(Bytecode::Interpreter& int
     auto value = interpreter.accumulator();
     auto base = interpreter.reg(m_base);
     PropertyKey name = interpreter.current_executable().get_identifier(m_property);
-    TRY(put_by_property_key(vm, base, interpreter.reg(m_this_value), value, name, m_kind));
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+    TRY(put_by_property_key(vm, base, interpreter.reg(m_this_value), value, name, m_kind, &cache));
     interpreter.accumulator() = value;
     return {};
 }
@@ -1587,12 +1737,13 @@ ThrowCompletionOr<void> PutByValue::execute_impl(Bytecode::Interpreter& interpre
         auto* storage = object.indexed_properties().storage();
         auto index = static_cast<u32>(property_key_value.as_i32());
         if (storage
-            && storage->is_simple_storage()
+            && (storage->is_packed_storage() || storage->is_simple_storage())
             && !object.may_interfere_with_indexed_property_access()
             && storage->has_index(index)) {
             auto existing_value = storage->get(index)->value;
             if (!existing_value.is_accessor()) {
-                storage->put(index, value);
+                // NOTE: This goes through IndexedProperties, as the new value may not fit into packed storage.
+                object.indexed_properties().put(index, value);
                 interpreter.accumulator() = value;
                 return {};
             }
@@ -78,6 +78,10 @@ public:
     BasicBlock const& current_block() const { return *m_current_block; }
     auto& instruction_stream_iterator() const { return m_pc; }
 
+    // Native code calls into instruction implementations directly, so it uses this to keep the current
+    // block and instruction (which error messages and stack traces are based on) up to date.
+    void set_current_instruction(BasicBlock const&, Instruction const&);
+
     void visit_edges(Cell::Visitor&);
 
 private:
@@ -109,7 +113,9 @@ private:
 };
 
 extern bool g_dump_bytecode;
+extern bool g_jit_enabled;
 
-ThrowCompletionOr<NonnullRefPtr<Bytecode::Executable>> compile(VM&, ASTNode const& no, JS::FunctionKind kind, DeprecatedFlyString const& name);
+// If `program` is given, the bytecode may come from (and will be stored in) the ExecutableCache.
+ThrowCompletionOr<NonnullRefPtr<Bytecode::Executable>> compile(VM&, ASTNode const& no, JS::FunctionKind kind, DeprecatedFlyString const& name, Program const* program = nullptr);
 
 }
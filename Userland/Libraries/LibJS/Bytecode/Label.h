@@ -21,6 +21,9 @@ public:
     auto& block() const { return *m_block; }
 
 private:
+    // ExecutableCache temporarily stores block indices in here while (de)serializing.
+    friend class ExecutableCache;
+
     BasicBlock const* m_block { nullptr };
 };
 
@@ -40,6 +40,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_src); }
+
     Register src() const { return m_src; }
 
 private:
@@ -74,6 +76,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_dst); }
+
     Register dst() const { return m_dst; }
 
 private:
@@ -116,6 +120,13 @@ private:
         ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;            \
         DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const; \
                                                                                        \
+        Register lhs() const { return m_lhs_reg; }                                     \
+                                                                                       \
+        void visit_operands_impl(Function<void(Register&)> const& visitor)             \
+        {                                                                              \
+            visitor(m_lhs_reg);                                                        \
+        }                                                                              \
+                                                                                       \
     private:                                                                           \
         Register m_lhs_reg;                                                            \
     };
@@ -156,6 +167,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::String, m_string.value()); }
+
 private:
     StringTableIndex m_string;
 };
@@ -184,6 +197,13 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        visitor(IndexKind::String, m_source_index.value());
+        visitor(IndexKind::String, m_flags_index.value());
+        visitor(IndexKind::Regex, m_regex_index.value());
+    }
+
 private:
     StringTableIndex m_source_index;
     StringTableIndex m_flags_index;
@@ -193,20 +213,25 @@ private:
 #define JS_ENUMERATE_NEW_BUILTIN_ERROR_OPS(O) \
     O(TypeError)
 
-#define JS_DECLARE_NEW_BUILTIN_ERROR_OP(ErrorName)                                     \
-    class New##ErrorName final : public Instruction {                                  \
-    public:                                                                            \
-        explicit New##ErrorName(StringTableIndex error_string)                         \
-            : Instruction(Type::New##ErrorName, sizeof(*this))                         \
-            , m_error_string(error_string)                                             \
-        {                                                                              \
-        }                                                                              \
-                                                                                       \
-        ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;            \
-        DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const; \
-                                                                                       \
-    private:                                                                           \
-        StringTableIndex m_error_string;                                               \
+#define JS_DECLARE_NEW_BUILTIN_ERROR_OP(ErrorName)                                      \
+    class New##ErrorName final : public Instruction {                                   \
+    public:                                                                             \
+        explicit New##ErrorName(StringTableIndex error_string)                          \
+            : Instruction(Type::New##ErrorName, sizeof(*this))                          \
+            , m_error_string(error_string)                                              \
+        {                                                                               \
+        }                                                                               \
+                                                                                        \
+        ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;             \
+        DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;  \
+                                                                                        \
+        void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const \
+        {                                                                               \
+            visitor(IndexKind::String, m_error_string.value());                         \
+        }                                                                               \
+                                                                                        \
+    private:                                                                            \
+        StringTableIndex m_error_string;                                                \
     };
 
 JS_ENUMERATE_NEW_BUILTIN_ERROR_OPS(JS_DECLARE_NEW_BUILTIN_ERROR_OP)
@@ -227,11 +252,20 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_from_object);
+        for (size_t i = 0; i < m_excluded_names_count; i++)
+            visitor(m_excluded_names[i]);
+    }
+
     size_t length_impl(size_t excluded_names_count) const
     {
         return round_up_to_power_of_two(alignof(void*), sizeof(*this) + sizeof(Register) * excluded_names_count);
     }
 
+    size_t excluded_names_count() const { return m_excluded_names_count; }
+
 private:
     Register m_from_object;
     size_t m_excluded_names_count { 0 };
@@ -249,6 +283,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    Crypto::SignedBigInteger const& bigint() const { return m_bigint; }
+
 private:
     Crypto::SignedBigInteger m_bigint;
 };
@@ -273,6 +309,14 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        if (m_element_count == 0)
+            return;
+        visitor(m_elements[0]);
+        visitor(m_elements[1]);
+    }
+
     size_t length_impl(size_t element_count) const
     {
         return round_up_to_power_of_two(alignof(void*), sizeof(*this) + sizeof(Register) * (element_count == 0 ? 0 : 2));
@@ -309,6 +353,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_lhs); }
+
 private:
     Register m_lhs;
     bool m_is_spread = false;
@@ -326,6 +372,12 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_specifier);
+        visitor(m_options);
+    }
+
 private:
     Register m_specifier;
     Register m_options;
@@ -353,6 +405,10 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_lhs); }
+
+    Register lhs() const { return m_lhs; }
+
 private:
     Register m_lhs;
 };
@@ -399,6 +455,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_identifier.value()); }
+
 private:
     IdentifierTableIndex m_identifier;
     EnvironmentMode m_mode;
@@ -426,6 +484,8 @@ public:
 
     IdentifierTableIndex identifier() const { return m_identifier; }
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_identifier.value()); }
+
 private:
     IdentifierTableIndex m_identifier;
     EnvironmentMode m_mode;
@@ -445,6 +505,8 @@ public:
 
     size_t index() const { return m_index; }
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Local, m_index); }
+
 private:
     size_t m_index;
 };
@@ -462,7 +524,17 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_callee_reg);
+        visitor(m_this_reg);
+    }
+
     IdentifierTableIndex identifier() const { return m_identifier; }
+    Register callee() const { return m_callee_reg; }
+    Register this_value() const { return m_this_reg; }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_identifier.value()); }
 
 private:
     IdentifierTableIndex m_identifier;
@@ -485,6 +557,8 @@ public:
 
     IdentifierTableIndex identifier() const { return m_identifier; }
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_identifier.value()); }
+
 private:
     IdentifierTableIndex m_identifier;
 
@@ -503,6 +577,12 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        visitor(IndexKind::Identifier, m_identifier.value());
+        visitor(IndexKind::GlobalVariableCache, m_cache_index);
+    }
+
 private:
     IdentifierTableIndex m_identifier;
     u32 m_cache_index { 0 };
@@ -521,6 +601,8 @@ public:
 
     size_t index() const { return m_index; }
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Local, m_index); }
+
 private:
     size_t m_index;
 };
@@ -538,6 +620,8 @@ public:
 
     IdentifierTableIndex identifier() const { return m_identifier; }
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_identifier.value()); }
+
 private:
     IdentifierTableIndex m_identifier;
 };
@@ -554,6 +638,12 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        visitor(IndexKind::Identifier, m_property.value());
+        visitor(IndexKind::PropertyLookupCache, m_cache_index);
+    }
+
 private:
     IdentifierTableIndex m_property;
     u32 m_cache_index { 0 };
@@ -572,6 +662,14 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_this_value); }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        visitor(IndexKind::Identifier, m_property.value());
+        visitor(IndexKind::PropertyLookupCache, m_cache_index);
+    }
+
 private:
     IdentifierTableIndex m_property;
     Register m_this_value;
@@ -589,6 +687,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_property.value()); }
+
 private:
     IdentifierTableIndex m_property;
 };
@@ -604,6 +704,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_property.value()); }
+
 private:
     IdentifierTableIndex m_property;
 };
@@ -619,42 +721,66 @@ enum class PropertyKind {
 
 class PutById final : public Instruction {
 public:
-    explicit PutById(Register base, IdentifierTableIndex property, PropertyKind kind = PropertyKind::KeyValue)
+    PutById(Register base, IdentifierTableIndex property, u32 cache_index, PropertyKind kind = PropertyKind::KeyValue)
         : Instruction(Type::PutById, sizeof(*this))
         , m_base(base)
         , m_property(property)
         , m_kind(kind)
+        , m_cache_index(cache_index)
     {
     }
 
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_base); }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        visitor(IndexKind::Identifier, m_property.value());
+        visitor(IndexKind::PropertyLookupCache, m_cache_index);
+    }
+
 private:
     Register m_base;
     IdentifierTableIndex m_property;
     PropertyKind m_kind;
+    u32 m_cache_index { 0 };
 };
 
 class PutByIdWithThis final : public Instruction {
 public:
-    PutByIdWithThis(Register base, Register this_value, IdentifierTableIndex property, PropertyKind kind = PropertyKind::KeyValue)
+    PutByIdWithThis(Register base, Register this_value, IdentifierTableIndex property, u32 cache_index, PropertyKind kind = PropertyKind::KeyValue)
         : Instruction(Type::PutByIdWithThis, sizeof(*this))
         , m_base(base)
         , m_this_value(this_value)
         , m_property(property)
         , m_kind(kind)
+        , m_cache_index(cache_index)
     {
     }
 
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_base);
+        visitor(m_this_value);
+    }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        visitor(IndexKind::Identifier, m_property.value());
+        visitor(IndexKind::PropertyLookupCache, m_cache_index);
+    }
+
 private:
     Register m_base;
     Register m_this_value;
     IdentifierTableIndex m_property;
     PropertyKind m_kind;
+    u32 m_cache_index { 0 };
 };
 
 class PutPrivateById final : public Instruction {
@@ -670,6 +796,10 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_base); }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_property.value()); }
+
 private:
     Register m_base;
     IdentifierTableIndex m_property;
@@ -687,6 +817,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_property.value()); }
+
 private:
     IdentifierTableIndex m_property;
 };
@@ -703,6 +835,10 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_this_value); }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_property.value()); }
+
 private:
     Register m_this_value;
     IdentifierTableIndex m_property;
@@ -719,6 +855,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_base); }
+
 private:
     Register m_base;
 };
@@ -735,6 +873,12 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_base);
+        visitor(m_this_value);
+    }
+
 private:
     Register m_base;
     Register m_this_value;
@@ -753,6 +897,12 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_base);
+        visitor(m_property);
+    }
+
 private:
     Register m_base;
     Register m_property;
@@ -773,6 +923,13 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_base);
+        visitor(m_property);
+        visitor(m_this_value);
+    }
+
 private:
     Register m_base;
     Register m_property;
@@ -791,6 +948,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor) { visitor(m_base); }
+
 private:
     Register m_base;
 };
@@ -807,6 +966,12 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_base);
+        visitor(m_this_value);
+    }
+
 private:
     Register m_base;
     Register m_this_value;
@@ -836,6 +1001,14 @@ public:
     auto& true_target() const { return m_true_target; }
     auto& false_target() const { return m_false_target; }
 
+    void visit_labels_impl(Function<void(Label&)> const& visitor)
+    {
+        if (m_true_target.has_value())
+            visitor(*m_true_target);
+        if (m_false_target.has_value())
+            visitor(*m_false_target);
+    }
+
 protected:
     Optional<Label> m_true_target;
     Optional<Label> m_false_target;
@@ -904,6 +1077,19 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_callee);
+        visitor(m_this_value);
+        visitor(m_first_argument);
+    }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        if (m_expression_string.has_value())
+            visitor(IndexKind::String, m_expression_string->value());
+    }
+
 private:
     Register m_callee;
     Register m_this_value;
@@ -932,6 +1118,18 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        visitor(m_callee);
+        visitor(m_this_value);
+    }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        if (m_expression_string.has_value())
+            visitor(IndexKind::String, m_expression_string->value());
+    }
+
 private:
     Register m_callee;
     Register m_this_value;
@@ -966,6 +1164,15 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    ClassExpression const& class_expression() const { return m_class_expression; }
+    Optional<IdentifierTableIndex> const& lhs_name() const { return m_lhs_name; }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        if (m_lhs_name.has_value())
+            visitor(IndexKind::Identifier, m_lhs_name->value());
+    }
+
 private:
     ClassExpression const& m_class_expression;
     Optional<IdentifierTableIndex> m_lhs_name;
@@ -984,6 +1191,22 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_operands_impl(Function<void(Register&)> const& visitor)
+    {
+        if (m_home_object.has_value())
+            visitor(*m_home_object);
+    }
+
+    FunctionExpression const& function_node() const { return m_function_node; }
+    Optional<IdentifierTableIndex> const& lhs_name() const { return m_lhs_name; }
+    Optional<Register> const& home_object() const { return m_home_object; }
+
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const
+    {
+        if (m_lhs_name.has_value())
+            visitor(IndexKind::Identifier, m_lhs_name->value());
+    }
+
 private:
     FunctionExpression const& m_function_node;
     Optional<IdentifierTableIndex> m_lhs_name;
@@ -1001,6 +1224,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    ScopeNode const& scope_node() const { return m_scope_node; }
+
 private:
     ScopeNode const& m_scope_node;
 };
@@ -1105,6 +1330,15 @@ public:
     auto& handler_target() const { return m_handler_target; }
     auto& finalizer_target() const { return m_finalizer_target; }
 
+    void visit_labels_impl(Function<void(Label&)> const& visitor)
+    {
+        visitor(m_entry_point);
+        if (m_handler_target.has_value())
+            visitor(*m_handler_target);
+        if (m_finalizer_target.has_value())
+            visitor(*m_finalizer_target);
+    }
+
 private:
     Label m_entry_point;
     Optional<Label> m_handler_target;
@@ -1132,6 +1366,8 @@ public:
 
     Label target() const { return m_target; }
 
+    void visit_labels_impl(Function<void(Label&)> const& visitor) { visitor(m_target); }
+
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
@@ -1176,6 +1412,8 @@ public:
 
     auto& resume_target() const { return m_resume_target; }
 
+    void visit_labels_impl(Function<void(Label&)> const& visitor) { visitor(m_resume_target); }
+
 private:
     Label m_resume_target;
 };
@@ -1200,6 +1438,12 @@ public:
 
     auto& continuation() const { return m_continuation_label; }
 
+    void visit_labels_impl(Function<void(Label&)> const& visitor)
+    {
+        if (m_continuation_label.has_value())
+            visitor(*m_continuation_label);
+    }
+
 private:
     Optional<Label> m_continuation_label;
 };
@@ -1219,6 +1463,8 @@ public:
 
     auto& continuation() const { return m_continuation_label; }
 
+    void visit_labels_impl(Function<void(Label&)> const& visitor) { visitor(m_continuation_label); }
+
 private:
     Label m_continuation_label;
 };
@@ -1264,6 +1510,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_property.value()); }
+
 private:
     IdentifierTableIndex m_property;
 };
@@ -1291,6 +1539,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    Optional<Value> const& completion_value() const { return m_completion_value; }
+
 private:
     Completion::Type m_completion_type { Completion::Type::Normal };
     Optional<Value> m_completion_value;
@@ -1308,6 +1558,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    Optional<Value> const& completion_value() const { return m_completion_value; }
+
 private:
     Completion::Type m_completion_type { Completion::Type::Normal };
     Optional<Value> m_completion_value;
@@ -1401,6 +1653,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Identifier, m_identifier.value()); }
+
 private:
     IdentifierTableIndex m_identifier;
 };
@@ -1416,6 +1670,8 @@ public:
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     DeprecatedString to_deprecated_string_impl(Bytecode::Executable const&) const;
 
+    void visit_indices_impl(Function<void(IndexKind, size_t)> const& visitor) const { visitor(IndexKind::Local, m_index); }
+
 private:
     size_t m_index;
 };
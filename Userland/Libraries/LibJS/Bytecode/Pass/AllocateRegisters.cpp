@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Pass/Liveness.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// A run of registers that has to stay contiguous (the arguments of a Call, or the elements of a NewArray),
+// or a single register. Each unit gets its slots in the call frame as a whole.
+struct Unit {
+    u32 first_register { 0 };
+    u32 width { 1 };
+    bool is_used { false };
+    bool is_pinned { false };
+    Optional<u32> first_slot;
+    HashTable<u32> interferes_with;
+};
+
+bool AllocateRegisters::perform(Executable& executable)
+{
+    auto register_count = static_cast<u32>(executable.number_of_registers);
+    if (register_count <= Register::reserved_register_count)
+        return false;
+
+    Liveness liveness { executable };
+
+    // Registers that are accessed as a range must keep their relative order. Overlapping ranges are merged.
+    struct Range {
+        u32 first;
+        u32 last;
+    };
+    Vector<Range> ranges;
+    for (auto& block : executable.basic_blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            auto const& instruction = *it;
+            if (instruction.type() == Instruction::Type::Call) {
+                auto const& call = static_cast<Op::Call const&>(instruction);
+                if (call.argument_count() > 1)
+                    ranges.append({ call.first_argument().index(), call.first_argument().index() + call.argument_count() - 1 });
+            } else if (instruction.type() == Instruction::Type::NewArray) {
+                auto const& new_array = static_cast<Op::NewArray const&>(instruction);
+                if (new_array.element_count() > 1)
+                    ranges.append({ new_array.start().index(), new_array.end().index() });
+            }
+        }
+    }
+    quick_sort(ranges, [](auto& a, auto& b) { return a.first < b.first; });
+
+    Vector<Unit> units;
+    Vector<u32> unit_of_register;
+    unit_of_register.resize(register_count);
+    size_t next_range = 0;
+    for (u32 index = Register::reserved_register_count; index < register_count;) {
+        Unit unit { .first_register = index };
+        if (next_range < ranges.size() && ranges[next_range].first == index) {
+            u32 last = ranges[next_range].last;
+            while (next_range < ranges.size() && ranges[next_range].first <= last)
+                last = max(last, ranges[next_range++].last);
+            unit.width = last - index + 1;
+        }
+        for (u32 i = 0; i < unit.width; ++i)
+            unit_of_register[index + i] = units.size();
+        index += unit.width;
+        units.append(move(unit));
+    }
+
+    // Pinned registers get slots of their own anyway, so there's no need to track what they interfere with.
+    auto add_interference = [&](u32 a, u32 b) {
+        if (liveness.pinned.contains(a) || liveness.pinned.contains(b))
+            return;
+        auto unit_a = unit_of_register[a];
+        auto unit_b = unit_of_register[b];
+        if (unit_a == unit_b)
+            return;
+        units[unit_a].interferes_with.set(unit_b);
+        units[unit_b].interferes_with.set(unit_a);
+    };
+
+    for (size_t block_index = 0; block_index < executable.basic_blocks.size(); ++block_index) {
+        auto& block = *executable.basic_blocks[block_index];
+
+        Vector<Instruction const*> instructions;
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it)
+            instructions.append(&*it);
+
+        // A register that is written interferes with everything that is live right after the write,
+        // and with the other registers written by the same instruction.
+        auto live = liveness.live_out[block_index];
+        for (size_t i = instructions.size(); i-- > 0;) {
+            auto const& instruction = *instructions[i];
+            Vector<u32, 2> written;
+            for_each_register_written(instruction, [&](u32 index) {
+                units[unit_of_register[index]].is_used = true;
+                for (auto other : written)
+                    add_interference(index, other);
+                written.append(index);
+                // Registers of the same unit are next to each other, so this skips most of the work for big ranges.
+                Optional<u32> previous_unit;
+                live.for_each([&](u32 live_index) {
+                    auto unit = unit_of_register[live_index];
+                    if (unit == previous_unit)
+                        return;
+                    previous_unit = unit;
+                    add_interference(index, live_index);
+                });
+            });
+            for (auto index : written)
+                live.clear(index);
+            for_each_register_read(instruction, [&](u32 index) {
+                units[unit_of_register[index]].is_used = true;
+                live.set(index);
+            });
+        }
+    }
+
+    liveness.pinned.for_each([&](u32 index) { units[unit_of_register[index]].is_pinned = true; });
+
+    // Registers that are live across an implicit edge get slots of their own, everything else is packed greedily
+    // into the lowest slots that aren't taken by an interfering unit.
+    u32 next_free_slot = Register::reserved_register_count;
+    for (auto& unit : units) {
+        if (!unit.is_used || !unit.is_pinned)
+            continue;
+        unit.first_slot = next_free_slot;
+        next_free_slot += unit.width;
+    }
+
+    u32 first_shared_slot = next_free_slot;
+    Vector<Range> taken;
+    for (auto& unit : units) {
+        if (!unit.is_used || unit.is_pinned)
+            continue;
+
+        taken.clear_with_capacity();
+        for (auto other_index : unit.interferes_with) {
+            auto const& other = units[other_index];
+            if (other.first_slot.has_value() && !other.is_pinned)
+                taken.append({ *other.first_slot, *other.first_slot + other.width - 1 });
+        }
+        quick_sort(taken, [](auto& a, auto& b) { return a.first < b.first; });
+
+        u32 slot = first_shared_slot;
+        for (auto const& range : taken) {
+            if (slot + unit.width <= range.first)
+                break;
+            slot = max(slot, range.last + 1);
+        }
+        unit.first_slot = slot;
+        next_free_slot = max(next_free_slot, slot + unit.width);
+    }
+
+    bool changed = next_free_slot != register_count;
+    for (auto& block : executable.basic_blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_operands([&](Register& reg) {
+                if (reg.index() < Register::reserved_register_count)
+                    return;
+                auto const& unit = units[unit_of_register[reg.index()]];
+                // Operands that are never accessed (like the first argument of a call without arguments) can point anywhere.
+                auto new_index = unit.first_slot.has_value() ? *unit.first_slot + (reg.index() - unit.first_register) : Register::accumulator_index;
+                if (new_index != reg.index()) {
+                    reg = Register { new_index };
+                    changed = true;
+                }
+            });
+        }
+    }
+    executable.number_of_registers = next_free_slot;
+    return changed;
+}
+
+}
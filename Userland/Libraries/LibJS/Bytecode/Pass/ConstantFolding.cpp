@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Pass/Liveness.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS::Bytecode::Passes {
+
+// Only values that don't live on the heap can be embedded in a LoadImmediate, and only operations on them are
+// guaranteed to be free of side effects (no valueOf(), toString() or Symbol.toPrimitive calls).
+static bool is_foldable(Value value)
+{
+    return value.is_number() || value.is_boolean() || value.is_null() || value.is_undefined();
+}
+
+static bool is_loosely_equal_primitive(Value lhs, Value rhs)
+{
+    if (lhs.is_nullish() || rhs.is_nullish())
+        return lhs.is_nullish() && rhs.is_nullish();
+    auto to_number = [](Value value) { return value.is_boolean() ? (value.as_bool() ? 1.0 : 0.0) : value.as_double(); };
+    return to_number(lhs) == to_number(rhs);
+}
+
+static Optional<Value> fold_binary_op(Instruction::Type type, Value lhs, Value rhs)
+{
+    switch (type) {
+    case Instruction::Type::StrictlyEquals:
+        return Value(is_strictly_equal(lhs, rhs));
+    case Instruction::Type::StrictlyInequals:
+        return Value(!is_strictly_equal(lhs, rhs));
+    case Instruction::Type::LooselyEquals:
+        return Value(is_loosely_equal_primitive(lhs, rhs));
+    case Instruction::Type::LooselyInequals:
+        return Value(!is_loosely_equal_primitive(lhs, rhs));
+    default:
+        break;
+    }
+
+    if (lhs.is_int32() && rhs.is_int32()) {
+        auto left = lhs.as_i32();
+        auto right = rhs.as_i32();
+        auto shift_count = static_cast<u32>(right) % 32;
+        switch (type) {
+        case Instruction::Type::BitwiseAnd:
+            return Value(left & right);
+        case Instruction::Type::BitwiseOr:
+            return Value(left | right);
+        case Instruction::Type::BitwiseXor:
+            return Value(left ^ right);
+        case Instruction::Type::LeftShift:
+            return Value(static_cast<i32>(static_cast<u32>(left) << shift_count));
+        case Instruction::Type::RightShift:
+            return Value(left >> shift_count);
+        case Instruction::Type::UnsignedRightShift:
+            return Value(static_cast<double>(static_cast<u32>(left) >> shift_count));
+        default:
+            break;
+        }
+    }
+
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+
+    auto left = lhs.as_double();
+    auto right = rhs.as_double();
+    switch (type) {
+    case Instruction::Type::Add:
+        return Value(left + right);
+    case Instruction::Type::Sub:
+        return Value(left - right);
+    case Instruction::Type::Mul:
+        return Value(left * right);
+    case Instruction::Type::Div:
+        return Value(left / right);
+    case Instruction::Type::Mod:
+        return Value(fmod(left, right));
+    case Instruction::Type::LessThan:
+        return Value(left < right);
+    case Instruction::Type::LessThanEquals:
+        return Value(left <= right);
+    case Instruction::Type::GreaterThan:
+        return Value(left > right);
+    case Instruction::Type::GreaterThanEquals:
+        return Value(left >= right);
+    default:
+        return {};
+    }
+}
+
+static Optional<Value> fold_unary_op(Instruction::Type type, Value value)
+{
+    switch (type) {
+    case Instruction::Type::Not:
+        return Value(!value.to_boolean());
+    case Instruction::Type::BitwiseNot:
+        if (value.is_int32())
+            return Value(~value.as_i32());
+        return {};
+    case Instruction::Type::UnaryMinus:
+        if (value.is_number())
+            return Value(-value.as_double());
+        return {};
+    case Instruction::Type::UnaryPlus:
+    case Instruction::Type::ToNumeric:
+        if (value.is_number())
+            return value;
+        return {};
+    case Instruction::Type::Increment:
+        if (value.is_number())
+            return Value(value.as_double() + 1);
+        return {};
+    case Instruction::Type::Decrement:
+        if (value.is_number())
+            return Value(value.as_double() - 1);
+        return {};
+    default:
+        return {};
+    }
+}
+
+static bool is_binary_op(Instruction::Type type)
+{
+    switch (type) {
+#define __BYTECODE_OP(op, _) case Instruction::Type::op:
+        JS_ENUMERATE_COMMON_BINARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        return true;
+    default:
+        return false;
+    }
+}
+
+static Register binary_op_lhs(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+#define __BYTECODE_OP(op, _)        \
+    case Instruction::Type::op:     \
+        return static_cast<Op::op const&>(instruction).lhs();
+        JS_ENUMERATE_COMMON_BINARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+static bool perform_on_block(BasicBlock& block)
+{
+    // What we know about the accumulator and registers at the current point in the block.
+    Optional<Value> accumulator;
+    HashMap<u32, Value> registers;
+
+    auto known_register = [&](Register reg) -> Optional<Value> {
+        if (reg.index() < Register::reserved_register_count)
+            return {};
+        return registers.get(reg.index());
+    };
+
+    InstructionStreamBuilder builder;
+    Vector<Instruction*> replaced_instructions;
+
+    for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+        auto& instruction = const_cast<Instruction&>(*it);
+        auto type = instruction.type();
+        auto source_record = instruction.source_record();
+
+        auto replace_with_immediate = [&](Value value) {
+            builder.emit<Op::LoadImmediate>(source_record, value);
+            replaced_instructions.append(&instruction);
+            accumulator = value;
+        };
+
+        if (type == Instruction::Type::LoadImmediate) {
+            auto value = static_cast<Op::LoadImmediate const&>(instruction).value();
+            accumulator = is_foldable(value) ? value : Optional<Value> {};
+            builder.append(instruction);
+            continue;
+        }
+
+        if (type == Instruction::Type::Load) {
+            if (auto value = known_register(static_cast<Op::Load const&>(instruction).src()); value.has_value()) {
+                replace_with_immediate(*value);
+                continue;
+            }
+            accumulator = {};
+            builder.append(instruction);
+            continue;
+        }
+
+        if (type == Instruction::Type::Store) {
+            auto dst = static_cast<Op::Store const&>(instruction).dst();
+            if (accumulator.has_value())
+                registers.set(dst.index(), *accumulator);
+            else
+                registers.remove(dst.index());
+            builder.append(instruction);
+            continue;
+        }
+
+        if (accumulator.has_value() && is_binary_op(type)) {
+            if (auto lhs = known_register(binary_op_lhs(instruction)); lhs.has_value()) {
+                if (auto result = fold_binary_op(type, *lhs, *accumulator); result.has_value()) {
+                    replace_with_immediate(*result);
+                    continue;
+                }
+            }
+        }
+
+        if (accumulator.has_value()) {
+            if (auto result = fold_unary_op(type, *accumulator); result.has_value()) {
+                replace_with_immediate(*result);
+                continue;
+            }
+        }
+
+        if (accumulator.has_value() && (type == Instruction::Type::JumpConditional || type == Instruction::Type::JumpNullish || type == Instruction::Type::JumpUndefined)) {
+            auto const& jump = static_cast<Op::Jump const&>(instruction);
+            bool condition = false;
+            if (type == Instruction::Type::JumpConditional)
+                condition = accumulator->to_boolean();
+            else if (type == Instruction::Type::JumpNullish)
+                condition = accumulator->is_nullish();
+            else
+                condition = accumulator->is_undefined();
+            auto target = condition ? *jump.true_target() : *jump.false_target();
+            builder.emit<Op::Jump>(source_record, target);
+            replaced_instructions.append(&instruction);
+            continue;
+        }
+
+        for_each_register_written(instruction, [&](u32 index) { registers.remove(index); });
+        if (type != Instruction::Type::SetLocal)
+            accumulator = {};
+        builder.append(instruction);
+    }
+
+    if (replaced_instructions.is_empty())
+        return false;
+
+    // The remaining instructions now live in the new stream, so the old one must not destroy them again.
+    for (auto* instruction : replaced_instructions)
+        Instruction::destroy(*instruction);
+    (void)block.release_instruction_stream();
+    block.set_instruction_stream(builder.release());
+    return true;
+}
+
+bool ConstantFolding::perform(Executable& executable)
+{
+    bool changed = false;
+    for (auto& block : executable.basic_blocks)
+        changed |= perform_on_block(*block);
+    return changed;
+}
+
+}
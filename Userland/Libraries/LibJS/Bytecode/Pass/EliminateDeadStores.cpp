@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Pass/Liveness.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Instructions that overwrite the accumulator without reading it, and have no other effects.
+static bool is_accumulator_load(Instruction::Type type)
+{
+    return type == Instruction::Type::LoadImmediate || type == Instruction::Type::Load;
+}
+
+bool EliminateDeadStores::perform(Executable& executable)
+{
+    if (executable.number_of_registers <= Register::reserved_register_count)
+        return false;
+
+    Liveness liveness { executable };
+    bool changed = false;
+
+    for (size_t block_index = 0; block_index < executable.basic_blocks.size(); ++block_index) {
+        auto& block = *executable.basic_blocks[block_index];
+
+        Vector<Instruction*> instructions;
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it)
+            instructions.append(const_cast<Instruction*>(&*it));
+
+        HashTable<Instruction*> dead_instructions;
+        auto live = liveness.live_out[block_index];
+        for (size_t i = instructions.size(); i-- > 0;) {
+            auto& instruction = *instructions[i];
+            if (instruction.type() == Instruction::Type::Store) {
+                auto dst = static_cast<Op::Store const&>(instruction).dst().index();
+                if (dst >= Register::reserved_register_count && !live.contains(dst) && !liveness.pinned.contains(dst)) {
+                    dead_instructions.set(&instruction);
+                    continue;
+                }
+            }
+            for_each_register_written(instruction, [&](u32 index) { live.clear(index); });
+            for_each_register_read(instruction, [&](u32 index) { live.set(index); });
+        }
+
+        // Loading a value into the accumulator is pointless if the next instruction replaces it without looking at it.
+        Instruction* previous_load = nullptr;
+        for (auto* instruction : instructions) {
+            if (dead_instructions.contains(instruction))
+                continue;
+            bool is_load = is_accumulator_load(instruction->type());
+            if (previous_load && is_load)
+                dead_instructions.set(previous_load);
+            previous_load = is_load ? instruction : nullptr;
+        }
+
+        if (dead_instructions.is_empty())
+            continue;
+
+        InstructionStreamBuilder builder;
+        for (auto* instruction : instructions) {
+            if (dead_instructions.contains(instruction))
+                Instruction::destroy(*instruction);
+            else
+                builder.append(*instruction);
+        }
+        (void)block.release_instruction_stream();
+        block.set_instruction_stream(builder.release());
+        changed = true;
+    }
+
+    return changed;
+}
+
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Pass/Liveness.h>
+
+namespace JS::Bytecode::Passes {
+
+static bool is_reserved(Register reg)
+{
+    return reg.index() < Register::reserved_register_count;
+}
+
+void for_each_register_read(Instruction const& instruction, Function<void(u32)> const& callback)
+{
+    auto visit = [&](Register reg) {
+        if (!is_reserved(reg))
+            callback(reg.index());
+    };
+
+    switch (instruction.type()) {
+    case Instruction::Type::Store:
+    case Instruction::Type::GetCalleeAndThisFromEnvironment:
+        return;
+    case Instruction::Type::Call: {
+        auto const& call = static_cast<Op::Call const&>(instruction);
+        visit(call.callee());
+        visit(call.this_value());
+        for (u32 i = 0; i < call.argument_count(); ++i)
+            visit(Register { call.first_argument().index() + i });
+        return;
+    }
+    case Instruction::Type::NewArray: {
+        auto const& new_array = static_cast<Op::NewArray const&>(instruction);
+        if (new_array.element_count() == 0)
+            return;
+        for (u32 i = new_array.start().index(); i <= new_array.end().index(); ++i)
+            visit(Register { i });
+        return;
+    }
+    default:
+        const_cast<Instruction&>(instruction).visit_operands([&](Register& reg) { visit(reg); });
+        return;
+    }
+}
+
+void for_each_register_written(Instruction const& instruction, Function<void(u32)> const& callback)
+{
+    auto visit = [&](Register reg) {
+        if (!is_reserved(reg))
+            callback(reg.index());
+    };
+
+    switch (instruction.type()) {
+    case Instruction::Type::Store:
+        visit(static_cast<Op::Store const&>(instruction).dst());
+        return;
+    case Instruction::Type::GetCalleeAndThisFromEnvironment:
+        visit(static_cast<Op::GetCalleeAndThisFromEnvironment const&>(instruction).callee());
+        visit(static_cast<Op::GetCalleeAndThisFromEnvironment const&>(instruction).this_value());
+        return;
+    case Instruction::Type::ConcatString:
+        visit(static_cast<Op::ConcatString const&>(instruction).lhs());
+        return;
+    default:
+        return;
+    }
+}
+
+Liveness::Liveness(Executable const& executable)
+{
+    auto block_count = executable.basic_blocks.size();
+    for (size_t i = 0; i < block_count; ++i)
+        block_indices.set(executable.basic_blocks[i].ptr(), i);
+
+    // Registers read before being written (uses) and registers written (defs) by each block on its own.
+    Vector<RegisterSet> uses;
+    Vector<RegisterSet> defs;
+    Vector<size_t> implicit_entry_points { 0 };
+    successors.resize(block_count);
+
+    for (size_t i = 0; i < block_count; ++i) {
+        auto& block = *executable.basic_blocks[i];
+        RegisterSet block_uses { executable.number_of_registers };
+        RegisterSet block_defs { executable.number_of_registers };
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            for_each_register_read(instruction, [&](u32 index) {
+                if (!block_defs.contains(index))
+                    block_uses.set(index);
+            });
+            for_each_register_written(instruction, [&](u32 index) { block_defs.set(index); });
+
+            instruction.visit_labels([&](Label& label) {
+                auto index = block_indices.get(&label.block()).value();
+                if (!successors[i].contains_slow(index))
+                    successors[i].append(index);
+            });
+
+            if (instruction.type() == Instruction::Type::EnterUnwindContext) {
+                auto const& enter = static_cast<Op::EnterUnwindContext const&>(instruction);
+                if (enter.handler_target().has_value())
+                    implicit_entry_points.append(block_indices.get(&enter.handler_target()->block()).value());
+                if (enter.finalizer_target().has_value())
+                    implicit_entry_points.append(block_indices.get(&enter.finalizer_target()->block()).value());
+            } else if (instruction.type() == Instruction::Type::ScheduleJump) {
+                implicit_entry_points.append(block_indices.get(&static_cast<Op::ScheduleJump const&>(instruction).target().block()).value());
+            }
+        }
+        uses.append(move(block_uses));
+        defs.append(move(block_defs));
+    }
+
+    for (size_t i = 0; i < block_count; ++i) {
+        live_in.empend(executable.number_of_registers);
+        live_out.empend(executable.number_of_registers);
+    }
+
+    // live_out(B) = union of live_in(S) for all successors S, live_in(B) = uses(B) + (live_out(B) - defs(B)).
+    // Iterate backwards, since most edges go forwards.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = block_count; i-- > 0;) {
+            for (auto successor : successors[i])
+                live_out[i].merge(live_in[successor]);
+
+            RegisterSet new_live_in = uses[i];
+            live_out[i].for_each([&](u32 index) {
+                if (!defs[i].contains(index))
+                    new_live_in.set(index);
+            });
+            changed |= live_in[i].merge(new_live_in);
+        }
+    }
+
+    pinned = RegisterSet { executable.number_of_registers };
+    for (auto index : implicit_entry_points)
+        pinned.merge(live_in[index]);
+}
+
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/HashMap.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Instruction.h>
+
+namespace JS::Bytecode::Passes {
+
+class RegisterSet {
+public:
+    RegisterSet() = default;
+    explicit RegisterSet(size_t register_count)
+    {
+        m_words.resize(ceil_div(register_count, bits_per_word));
+    }
+
+    bool contains(u32 index) const { return m_words[index / bits_per_word] & (1ull << (index % bits_per_word)); }
+    void set(u32 index) { m_words[index / bits_per_word] |= 1ull << (index % bits_per_word); }
+    void clear(u32 index) { m_words[index / bits_per_word] &= ~(1ull << (index % bits_per_word)); }
+
+    // Returns whether any new registers were added.
+    bool merge(RegisterSet const& other)
+    {
+        bool changed = false;
+        for (size_t i = 0; i < m_words.size(); ++i) {
+            auto merged = m_words[i] | other.m_words[i];
+            changed |= merged != m_words[i];
+            m_words[i] = merged;
+        }
+        return changed;
+    }
+
+    template<typename Callback>
+    void for_each(Callback callback) const
+    {
+        for (size_t i = 0; i < m_words.size(); ++i) {
+            for (auto word = m_words[i]; word != 0; word &= word - 1)
+                callback(static_cast<u32>(i * bits_per_word + count_trailing_zeroes(word)));
+        }
+    }
+
+private:
+    static constexpr size_t bits_per_word = 64;
+    Vector<u64> m_words;
+};
+
+// Calls the callback for every register the instruction reads, expanding the argument ranges of Call and NewArray.
+// The accumulator and the other reserved registers are not included.
+void for_each_register_read(Instruction const&, Function<void(u32)> const&);
+
+// Calls the callback for every register the instruction writes. The accumulator and the other reserved registers are
+// not included.
+void for_each_register_written(Instruction const&, Function<void(u32)> const&);
+
+// Which registers hold a value that may still be read, at the start and the end of each basic block.
+struct Liveness {
+    explicit Liveness(Executable const&);
+
+    HashMap<BasicBlock const*, size_t> block_indices;
+    Vector<Vector<size_t>> successors;
+    Vector<RegisterSet> live_in;
+    Vector<RegisterSet> live_out;
+
+    // Registers that are live when control enters a block in a way the control flow graph doesn't show: exception
+    // handlers and finalizers, and the targets of jumps scheduled across a finalizer. Registers that are live on
+    // entry to the executable are included too, since reading them must still produce an empty value.
+    // These must not share a slot with other registers, and stores to them must never be removed.
+    RegisterSet pinned;
+};
+
+}
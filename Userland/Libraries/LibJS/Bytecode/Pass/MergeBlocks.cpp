@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static Instruction const* last_instruction(BasicBlock const& block)
+{
+    Instruction const* last = nullptr;
+    for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it)
+        last = &*it;
+    return last;
+}
+
+bool MergeBlocks::perform(Executable& executable)
+{
+    HashMap<BasicBlock const*, size_t> reference_counts;
+    for (auto& block : executable.basic_blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                reference_counts.ensure(&label.block(), [] { return 0; })++;
+            });
+        }
+    }
+
+    HashTable<BasicBlock const*> merged_blocks;
+    for (auto& block : executable.basic_blocks) {
+        if (merged_blocks.contains(block.ptr()))
+            continue;
+
+        // Keep appending successors for as long as the block ends in a jump to a block nobody else jumps to.
+        for (;;) {
+            auto const* last = last_instruction(*block);
+            if (!last || last->type() != Instruction::Type::Jump)
+                break;
+            auto const& successor = static_cast<Op::Jump const*>(last)->true_target()->block();
+            if (&successor == block.ptr() || &successor == executable.basic_blocks.first().ptr())
+                break;
+            if (reference_counts.get(&successor).value() != 1)
+                break;
+
+            auto& mutable_successor = const_cast<BasicBlock&>(successor);
+            auto stream = block->release_instruction_stream();
+            auto jump_offset = reinterpret_cast<u8 const*>(last) - stream.data();
+            Instruction::destroy(*reinterpret_cast<Instruction*>(stream.data() + jump_offset));
+            stream.resize(jump_offset);
+            auto successor_stream = mutable_successor.release_instruction_stream();
+            stream.append(successor_stream.data(), successor_stream.size());
+            block->set_instruction_stream(move(stream));
+            merged_blocks.set(&successor);
+        }
+    }
+
+    if (merged_blocks.is_empty())
+        return false;
+
+    executable.basic_blocks.remove_all_matching([&](auto& block) {
+        return merged_blocks.contains(block.ptr());
+    });
+    return true;
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+bool RemoveUnreachableBlocks::perform(Executable& executable)
+{
+    // Execution always starts in the first block; everything else has to be reached through a label.
+    HashTable<BasicBlock const*> reachable;
+    Vector<BasicBlock const*> worklist;
+    reachable.set(executable.basic_blocks.first().ptr());
+    worklist.append(executable.basic_blocks.first().ptr());
+
+    while (!worklist.is_empty()) {
+        auto const& block = *worklist.take_last();
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                if (reachable.set(&label.block()) == HashSetResult::InsertedNewEntry)
+                    worklist.append(&label.block());
+            });
+        }
+    }
+
+    if (reachable.size() == executable.basic_blocks.size())
+        return false;
+
+    executable.basic_blocks.remove_all_matching([&](auto& block) {
+        return !reachable.contains(block.ptr());
+    });
+    return true;
+}
+
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// If the block consists of a single unconditional jump, returns the block it jumps to.
+static BasicBlock const* forwarding_target(BasicBlock const& block)
+{
+    if (block.size() == 0)
+        return nullptr;
+    auto const& instruction = *reinterpret_cast<Instruction const*>(block.data());
+    if (instruction.type() != Instruction::Type::Jump || instruction.length() != block.size())
+        return nullptr;
+    return &static_cast<Op::Jump const&>(instruction).true_target()->block();
+}
+
+bool ThreadJumps::perform(Executable& executable)
+{
+    bool changed = false;
+    for (auto& block : executable.basic_blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                HashTable<BasicBlock const*> seen;
+                auto const* target = &label.block();
+                while (auto const* next = forwarding_target(*target)) {
+                    // An empty infinite loop; leave it alone.
+                    if (seen.set(target) != HashSetResult::InsertedNewEntry)
+                        return;
+                    target = next;
+                }
+                if (target != &label.block()) {
+                    label = Label { *target };
+                    changed = true;
+                }
+            });
+        }
+    }
+    return changed;
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode {
+
+bool g_optimize_bytecode = true;
+bool g_dump_bytecode_passes = false;
+
+static size_t count_instructions(Executable const& executable)
+{
+    size_t count = 0;
+    for (auto& block : executable.basic_blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it)
+            ++count;
+    }
+    return count;
+}
+
+void PassManager::perform(Executable& executable)
+{
+    m_instructions_before += count_instructions(executable);
+    m_registers_before += executable.number_of_registers;
+
+    if (g_dump_bytecode_passes) {
+        warnln("\033[34;1mBefore optimization\033[0m");
+        executable.dump();
+    }
+
+    for (auto& entry : m_passes) {
+        auto start = MonotonicTime::now();
+        bool changed = entry.pass->perform(executable);
+        auto elapsed = MonotonicTime::now() - start;
+        entry.time += elapsed;
+
+        if (g_dump_bytecode_passes) {
+            warnln("\033[34;1mAfter {}\033[0m ({}us{})", entry.pass->name(), elapsed.to_microseconds(), changed ? "" : ", no changes");
+            if (changed)
+                executable.dump();
+        }
+    }
+
+    m_instructions_after += count_instructions(executable);
+    m_registers_after += executable.number_of_registers;
+}
+
+void PassManager::dump_statistics() const
+{
+    Duration total;
+    for (auto const& entry : m_passes) {
+        warnln("{:>24}: {}us", entry.pass->name(), entry.time.to_microseconds());
+        total += entry.time;
+    }
+    warnln("{:>24}: {}us", "Total"sv, total.to_microseconds());
+    warnln("Instructions: {} -> {}", m_instructions_before, m_instructions_after);
+    warnln("Registers: {} -> {}", m_registers_before, m_registers_after);
+}
+
+PassManager& optimization_pipeline()
+{
+    static OwnPtr<PassManager> s_pipeline;
+    if (!s_pipeline) {
+        s_pipeline = make<PassManager>();
+        s_pipeline->add<Passes::RemoveUnreachableBlocks>();
+        s_pipeline->add<Passes::MergeBlocks>();
+        s_pipeline->add<Passes::ConstantFolding>();
+        s_pipeline->add<Passes::ThreadJumps>();
+        s_pipeline->add<Passes::RemoveUnreachableBlocks>();
+        s_pipeline->add<Passes::MergeBlocks>();
+        s_pipeline->add<Passes::EliminateDeadStores>();
+        s_pipeline->add<Passes::AllocateRegisters>();
+    }
+    return *s_pipeline;
+}
+
+}
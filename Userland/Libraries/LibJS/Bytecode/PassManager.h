@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Instruction.h>
+
+namespace JS::Bytecode {
+
+class Pass {
+public:
+    Pass() = default;
+    virtual ~Pass() = default;
+
+    virtual StringView name() const = 0;
+
+    // Returns whether the executable was changed.
+    virtual bool perform(Executable&) = 0;
+};
+
+// Runs a sequence of passes over executables, and keeps track of how long each of them took.
+class PassManager {
+public:
+    template<typename PassType, typename... Args>
+    void add(Args&&... args)
+    {
+        m_passes.append({ make<PassType>(forward<Args>(args)...), {} });
+    }
+
+    void perform(Executable&);
+
+    // Prints the time spent in each pass, and how much smaller the executables got.
+    void dump_statistics() const;
+
+private:
+    struct PassAndTime {
+        NonnullOwnPtr<Pass> pass;
+        Duration time;
+    };
+    Vector<PassAndTime> m_passes;
+
+    size_t m_instructions_before { 0 };
+    size_t m_instructions_after { 0 };
+    size_t m_registers_before { 0 };
+    size_t m_registers_after { 0 };
+};
+
+// The passes that Generator::generate() runs on every executable.
+PassManager& optimization_pipeline();
+
+extern bool g_optimize_bytecode;
+extern bool g_dump_bytecode_passes;
+
+// Builds a new instruction stream for a basic block out of newly emitted and existing instructions.
+// Existing instructions are moved into the new stream, not copied.
+class InstructionStreamBuilder {
+public:
+    void append(Instruction const& instruction)
+    {
+        auto offset = m_buffer.size();
+        grow(instruction.length());
+        __builtin_memcpy(m_buffer.data() + offset, &instruction, instruction.length());
+    }
+
+    template<typename OpType, typename... Args>
+    void emit(SourceRecord source_record, Args&&... args)
+    {
+        static_assert(sizeof(OpType) % alignof(void*) == 0);
+        auto offset = m_buffer.size();
+        grow(sizeof(OpType));
+        auto* instruction = new (m_buffer.data() + offset) OpType(forward<Args>(args)...);
+        instruction->set_source_record(source_record);
+    }
+
+    Vector<u8> release() { return move(m_buffer); }
+
+private:
+    void grow(size_t additional_size)
+    {
+        m_buffer.grow_capacity(m_buffer.size() + additional_size);
+        m_buffer.resize(m_buffer.size() + additional_size);
+    }
+
+    Vector<u8> m_buffer;
+};
+
+namespace Passes {
+
+// Evaluates arithmetic, comparisons and conditional jumps whose operands are known constants,
+// tracking the values of the accumulator and registers within each basic block.
+class ConstantFolding final : public Pass {
+public:
+    virtual StringView name() const override { return "ConstantFolding"sv; }
+    virtual bool perform(Executable&) override;
+};
+
+// Makes jumps to blocks that consist of nothing but another jump go to the final destination directly.
+class ThreadJumps final : public Pass {
+public:
+    virtual StringView name() const override { return "ThreadJumps"sv; }
+    virtual bool perform(Executable&) override;
+};
+
+class RemoveUnreachableBlocks final : public Pass {
+public:
+    virtual StringView name() const override { return "RemoveUnreachableBlocks"sv; }
+    virtual bool perform(Executable&) override;
+};
+
+// Appends blocks that are only ever reached by an unconditional jump to the block that jumps to them.
+class MergeBlocks final : public Pass {
+public:
+    virtual StringView name() const override { return "MergeBlocks"sv; }
+    virtual bool perform(Executable&) override;
+};
+
+// Removes stores to registers that are never read afterwards, and loads into the accumulator that are overwritten
+// right away.
+class EliminateDeadStores final : public Pass {
+public:
+    virtual StringView name() const override { return "EliminateDeadStores"sv; }
+    virtual bool perform(Executable&) override;
+};
+
+// Renumbers registers so that registers which are never live at the same time share a slot in the call frame.
+class AllocateRegisters final : public Pass {
+public:
+    virtual StringView name() const override { return "AllocateRegisters"sv; }
+    virtual bool perform(Executable&) override;
+};
+
+}
+
+}
@@ -32,6 +32,7 @@ public:
     ParsedRegex const& get(RegexTableIndex) const;
     void dump() const;
     bool is_empty() const { return m_regexes.is_empty(); }
+    size_t size() const { return m_regexes.size(); }
 
 private:
     Vector<ParsedRegex> m_regexes;
@@ -310,4 +310,8 @@ class RegexTable;
 class Register;
 }
 
+namespace JIT {
+class NativeExecutable;
+}
+
 }
@@ -6,6 +6,7 @@
 
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Heap/Heap.h>
+#include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Runtime/Completion.h>
 #include <LibJS/Runtime/Value.h>
 
@@ -15,6 +16,18 @@ void JS::Cell::initialize(JS::Realm&)
 {
 }
 
+void JS::Cell::set_overrides_must_survive_garbage_collection(bool b)
+{
+    m_overrides_must_survive_garbage_collection = b;
+    if (b)
+        heap().did_create_cell_that_overrides_must_survive_garbage_collection({});
+}
+
+void JS::Cell::did_store_cell_reference() const
+{
+    HeapBlock::from_cell(this)->did_store_cell_reference(this);
+}
+
 void JS::Cell::Visitor::visit(JS::Value value)
 {
     if (value.is_cell())
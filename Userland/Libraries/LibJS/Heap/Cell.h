@@ -34,9 +34,6 @@ public:
     virtual void initialize(Realm&);
     virtual ~Cell() = default;
 
-    bool is_marked() const { return m_mark; }
-    void set_marked(bool b) { m_mark = b; }
-
     enum class State {
         Live,
         Dead,
@@ -107,14 +104,23 @@ public:
 protected:
     Cell() = default;
 
-    void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
+    void set_overrides_must_survive_garbage_collection(bool);
+
+    // The write barrier. Cell types that opt into cell_has_write_barriers must call this whenever they store a reference
+    // to another cell, so that the next young generation collection looks at them again.
+    void did_store_cell_reference() const;
 
 private:
-    bool m_mark : 1 { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
     State m_state : 1 { State::Live };
 };
 
+// Whether every store of a cell reference into a T goes through Cell::did_store_cell_reference().
+// Only the exact type counts, since a subclass may hold references of its own. Old cells of types
+// without write barriers are rescanned by every young generation collection instead.
+template<typename T>
+inline constexpr bool cell_has_write_barriers = false;
+
 }
 
 template<>
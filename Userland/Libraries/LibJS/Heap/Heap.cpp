@@ -80,19 +80,22 @@ ALWAYS_INLINE CellAllocator& Heap::allocator_for_size(size_t cell_size)
     VERIFY_NOT_REACHED();
 }
 
-Cell* Heap::allocate_cell(size_t size)
+Cell* Heap::allocate_cell(size_t size, bool has_write_barriers)
 {
     if (should_collect_on_every_allocation()) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(CollectionType::CollectYoungGeneration);
     } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(CollectionType::CollectYoungGeneration);
     }
 
     m_allocated_bytes_since_last_gc += size;
     auto& allocator = allocator_for_size(size);
-    return allocator.allocate_cell(*this);
+    auto* cell = allocator.allocate_cell(*this);
+    if (has_write_barriers)
+        HeapBlock::from_cell(cell)->set_has_write_barriers(cell);
+    return cell;
 }
 
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
@@ -285,21 +288,38 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     perf_event(PERF_EVENT_SIGNPOST, gc_perf_string_id, global_gc_counter++);
 #endif
 
-    Core::ElapsedTimer collection_measurement_timer;
-    if (print_report)
-        collection_measurement_timer.start();
+    // Pauses are usually well below the resolution of the coarse clock.
+    Core::ElapsedTimer collection_measurement_timer { true };
+    collection_measurement_timer.start();
 
-    if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
-        }
+    if (collection_type != CollectionType::CollectEverything && m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        if (collection_type == CollectionType::CollectGarbage)
+            m_collection_type_when_deferral_ends = CollectionType::CollectGarbage;
+        return;
+    }
+
+    if (collection_type == CollectionType::CollectYoungGeneration && !should_collect_young_generation_only())
+        collection_type = CollectionType::CollectGarbage;
+
+    // Everything starts out unmarked in a full collection, young generation collections keep the marks of old cells.
+    if (collection_type != CollectionType::CollectYoungGeneration) {
+        for_each_block([&](auto& block) {
+            block.clear_all_marks();
+            return IterationDecision::Continue;
+        });
+    }
+
+    if (collection_type != CollectionType::CollectEverything) {
         HashMap<Cell*, HeapRoot> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        mark_live_cells(roots, collection_type);
     }
     finalize_unmarked_cells();
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    sweep_dead_cells(collection_type, print_report, collection_measurement_timer);
+
+    if (on_garbage_collection_pause)
+        on_garbage_collection_pause(collection_measurement_timer.elapsed_time());
 }
 
 void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
@@ -415,11 +435,17 @@ public:
 
     virtual void visit_impl(Cell& cell) override
     {
-        if (cell.is_marked())
+        auto& block = *HeapBlock::from_cell(&cell);
+        if (block.is_marked(&cell))
+            return;
+        // Old cells are only collected by full collections, and may still point at cells that were uprooted or that
+        // died together with them. Marks must never end up on free cells, or they'd be inherited by the next cell
+        // allocated there.
+        if (!block.is_live(&cell))
             return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
-        cell.set_marked(true);
+        block.set_marked(&cell);
         m_work_queue.append(cell);
     }
 
@@ -432,11 +458,12 @@ public:
             add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
 
         for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
-            if (cell->is_marked())
+            auto& block = *HeapBlock::from_cell(cell);
+            if (block.is_marked(cell))
                 return;
             if (cell->state() != Cell::State::Live)
                 return;
-            cell->set_marked(true);
+            block.set_marked(cell);
             m_work_queue.append(*cell);
         });
     }
@@ -456,18 +483,55 @@ private:
     FlatPtr m_max_block_address;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+bool Heap::should_collect_young_generation_only() const
+{
+    // Uprooting a cell can only be honored by a full collection, as old cells aren't revisited otherwise.
+    if (!m_uprooted_cells.is_empty())
+        return false;
+    return m_old_generation_bytes <= m_old_generation_bytes_threshold;
+}
+
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, CollectionType collection_type)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
+    // Old cells are already marked, so marking stops at them. Any of them that may have been made to point at a young
+    // cell since the last collection has to be scanned as if it were a root.
+    Vector<Cell*> old_cells_to_rescan;
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        for_each_block([&](auto& block) {
+            block.for_each_old_cell_that_may_point_to_young_cells([&](Cell* cell) {
+                old_cells_to_rescan.append(cell);
+            });
+            return IterationDecision::Continue;
+        });
+    }
+
     MarkingVisitor visitor(*this, roots);
 
+    for (auto* cell : old_cells_to_rescan)
+        cell->visit_edges(visitor);
+
     vm().bytecode_interpreter().visit_edges(visitor);
 
     visitor.mark_all_live_cells();
 
+    // Cells that must survive keep everything they point to alive as well. Otherwise they'd point at freed cells
+    // once they are old.
+    if (m_may_have_cells_that_must_survive_garbage_collection) {
+        for_each_block([&](auto& block) {
+            block.for_each_unmarked_live_cell([&](Cell* cell) {
+                if (cell_must_survive_garbage_collection(*cell))
+                    visitor.visit(cell);
+            });
+            return IterationDecision::Continue;
+        });
+
+        visitor.mark_all_live_cells();
+    }
+
     for (auto& inverse_root : m_uprooted_cells)
-        inverse_root->set_marked(false);
+        HeapBlock::from_cell(inverse_root.ptr())->clear_marked(inverse_root.ptr());
 
     m_uprooted_cells.clear();
 }
@@ -482,15 +546,18 @@ bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 void Heap::finalize_unmarked_cells()
 {
     for_each_block([&](auto& block) {
-        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
-            if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
+        block.for_each_unmarked_live_cell([&](Cell* cell) {
+            // Cells that choose to survive are treated exactly like marked ones from here on.
+            if (cell_must_survive_garbage_collection(*cell))
+                block.set_marked(cell);
+            else
                 cell->finalize();
         });
         return IterationDecision::Continue;
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
@@ -500,24 +567,24 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     size_t live_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
+    size_t live_cell_without_write_barriers_bytes = 0;
 
     for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
         bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
-                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
-                ++collected_cells;
-                collected_cell_bytes += block.cell_size();
-            } else {
-                cell->set_marked(false);
-                block_has_live_cells = true;
-                ++live_cells;
-                live_cell_bytes += block.cell_size();
-            }
+        // Only the cells that died are visited here, blocks where everything survived aren't touched beyond their header.
+        block.for_each_unmarked_live_cell([&](Cell* cell) {
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            block.deallocate(cell);
+            ++collected_cells;
+            collected_cell_bytes += block.cell_size();
         });
-        if (!block_has_live_cells)
+        // The survivors keep their marks, which is what makes them old.
+        block.forget_remembered_cells();
+        auto block_live_cells = block.marked_cell_count();
+        live_cells += block_live_cells;
+        live_cell_bytes += block_live_cells * block.cell_size();
+        live_cell_without_write_barriers_bytes += block.marked_cell_without_write_barriers_count() * block.cell_size();
+        if (!block_live_cells)
             empty_blocks.append(&block);
         else if (block_was_full != block.is_full())
             full_blocks_that_became_usable.append(&block);
@@ -544,7 +611,13 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         });
     }
 
-    m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+    // Every young generation collection rescans the old cells without write barriers, so allocate at least as much as
+    // those take up in between to keep that work proportional to the allocation rate.
+    m_gc_bytes_threshold = max(live_cell_without_write_barriers_bytes, GC_MIN_BYTES_THRESHOLD);
+
+    m_old_generation_bytes = live_cell_bytes;
+    if (collection_type != CollectionType::CollectYoungGeneration)
+        m_old_generation_bytes_threshold = max(live_cell_bytes * 2, GC_MIN_BYTES_THRESHOLD);
 
     if (print_report) {
         Duration const time_spent = measurement_timer.elapsed_time();
@@ -556,6 +629,7 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
         dbgln("Garbage collection report");
         dbgln("=============================================");
+        dbgln("     Collection: {}", collection_type == CollectionType::CollectYoungGeneration ? "young generation"sv : "full"sv);
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
         dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
@@ -577,8 +651,9 @@ void Heap::undefer_gc()
 
     if (!m_gc_deferrals) {
         if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+            collect_garbage(m_collection_type_when_deferral_ends);
         m_should_gc_when_deferral_ends = false;
+        m_collection_type_when_deferral_ends = CollectionType::CollectYoungGeneration;
     }
 }
 
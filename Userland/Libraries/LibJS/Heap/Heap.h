@@ -7,10 +7,12 @@
 #pragma once
 
 #include <AK/Badge.h>
+#include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -38,7 +40,7 @@ public:
     template<typename T, typename... Args>
     NonnullGCPtr<T> allocate_without_realm(Args&&... args)
     {
-        auto* memory = allocate_cell(sizeof(T));
+        auto* memory = allocate_cell(sizeof(T), cell_has_write_barriers<T>);
         defer_gc();
         new (memory) T(forward<Args>(args)...);
         undefer_gc();
@@ -48,7 +50,7 @@ public:
     template<typename T, typename... Args>
     NonnullGCPtr<T> allocate(Realm& realm, Args&&... args)
     {
-        auto* memory = allocate_cell(sizeof(T));
+        auto* memory = allocate_cell(sizeof(T), cell_has_write_barriers<T>);
         defer_gc();
         new (memory) T(forward<Args>(args)...);
         undefer_gc();
@@ -59,15 +61,23 @@ public:
 
     enum class CollectionType {
         CollectGarbage,
+        CollectYoungGeneration,
         CollectEverything,
     };
 
+    // Cells that survive a collection become old and stay marked. A young generation collection only marks and sweeps
+    // the cells allocated since the last collection. Besides the roots, it rescans the old cells that may point at
+    // young ones: those a write barrier fired on, and all of those whose type has no write barrier.
+    // It turns into a full collection once the old generation has doubled since the last full one.
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
     void dump_graph();
 
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // Called at the end of every collection with how long the mutator was paused for.
+    Function<void(Duration)> on_garbage_collection_pause;
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -81,6 +91,8 @@ public:
 
     void uproot_cell(Cell* cell);
 
+    void did_create_cell_that_overrides_must_survive_garbage_collection(Badge<Cell>) { m_may_have_cells_that_must_survive_garbage_collection = true; }
+
 private:
     friend class MarkingVisitor;
     friend class GraphConstructorVisitor;
@@ -91,15 +103,17 @@ private:
 
     static bool cell_must_survive_garbage_collection(Cell const&);
 
-    Cell* allocate_cell(size_t);
+    Cell* allocate_cell(size_t, bool has_write_barriers);
+
+    bool should_collect_young_generation_only() const;
 
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, CollectionType);
     void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void sweep_dead_cells(CollectionType, bool print_report, Core::ElapsedTimer const&);
 
     CellAllocator& allocator_for_size(size_t);
 
@@ -116,6 +130,9 @@ private:
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
 
+    size_t m_old_generation_bytes { 0 };
+    size_t m_old_generation_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
+
     bool m_should_collect_on_every_allocation { false };
 
     Vector<NonnullOwnPtr<CellAllocator>> m_allocators;
@@ -130,8 +147,11 @@ private:
 
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
+    CollectionType m_collection_type_when_deferral_ends { CollectionType::CollectYoungGeneration };
 
     bool m_collecting_garbage { false };
+
+    bool m_may_have_cells_that_must_survive_garbage_collection { false };
 };
 
 inline void Heap::did_create_handle(Badge<HandleImpl>, HandleImpl& impl)
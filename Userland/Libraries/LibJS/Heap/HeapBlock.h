@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Platform.h>
 #include <AK/StringView.h>
@@ -44,6 +46,7 @@ public:
 
         if (allocated_cell) {
             ASAN_UNPOISON_MEMORY_REGION(allocated_cell, m_cell_size);
+            m_live_cells.set(cell_index(allocated_cell));
         }
         return allocated_cell;
     }
@@ -67,6 +70,65 @@ public:
         });
     }
 
+    // Mark bits live in a bitmap in the block header rather than in the cells themselves,
+    // so that the collector can tell which cells died without touching the ones that didn't.
+    bool is_marked(Cell const* cell) const { return m_marked_cells.get(cell_index(cell)); }
+    void set_marked(Cell const* cell) { m_marked_cells.set(cell_index(cell)); }
+    void clear_marked(Cell const* cell) { m_marked_cells.clear(cell_index(cell)); }
+    void clear_all_marks() { m_marked_cells = {}; }
+
+    size_t live_cell_count() const { return m_live_cells.count(); }
+    size_t marked_cell_count() const { return m_marked_cells.count(); }
+
+    // The callback may deallocate the cell it is given.
+    template<typename Callback>
+    void for_each_unmarked_live_cell(Callback callback)
+    {
+        for_each_cell_in_bitmap([&](size_t word_index) { return m_live_cells.words[word_index] & ~m_marked_cells.words[word_index]; }, callback);
+    }
+
+    bool is_live(Cell const* cell) const { return m_live_cells.get(cell_index(cell)); }
+
+    void set_has_write_barriers(Cell const* cell) { m_cells_with_write_barriers.set(cell_index(cell)); }
+
+    // The write barrier, see Cell::did_store_cell_reference(). The address may point anywhere inside the cell.
+    void did_store_cell_reference(void const* address)
+    {
+        auto index = cell_index(address);
+        // Young cells are marked from scratch by the next collection anyway.
+        if (!m_marked_cells.get(index))
+            return;
+        m_remembered_cells.set(index);
+        m_has_remembered_cells = true;
+    }
+
+    // Old cells that may point at young ones: those the write barrier fired for, and all of those without one.
+    template<typename Callback>
+    void for_each_old_cell_that_may_point_to_young_cells(Callback callback)
+    {
+        if (m_has_remembered_cells) {
+            for_each_cell_in_bitmap([&](size_t word_index) { return m_marked_cells.words[word_index] & (m_remembered_cells.words[word_index] | ~m_cells_with_write_barriers.words[word_index]); }, callback);
+            return;
+        }
+        for_each_cell_in_bitmap([&](size_t word_index) { return m_marked_cells.words[word_index] & ~m_cells_with_write_barriers.words[word_index]; }, callback);
+    }
+
+    void forget_remembered_cells()
+    {
+        if (!m_has_remembered_cells)
+            return;
+        m_remembered_cells = {};
+        m_has_remembered_cells = false;
+    }
+
+    size_t marked_cell_without_write_barriers_count() const
+    {
+        size_t count = 0;
+        for (size_t word_index = 0; word_index < CellBitmap::word_count; ++word_index)
+            count += popcount(m_marked_cells.words[word_index] & ~m_cells_with_write_barriers.words[word_index]);
+        return count;
+    }
+
     static HeapBlock* from_cell(Cell const* cell)
     {
         return static_cast<HeapBlock*>(HeapBlockBase::from_cell(cell));
@@ -106,9 +168,51 @@ private:
         return reinterpret_cast<Cell*>(&m_storage[index * cell_size()]);
     }
 
+    size_t cell_index(void const* cell) const
+    {
+        return (reinterpret_cast<FlatPtr>(cell) - reinterpret_cast<FlatPtr>(m_storage)) / m_cell_size;
+    }
+
+    template<typename GetWord, typename Callback>
+    void for_each_cell_in_bitmap(GetWord get_word, Callback callback)
+    {
+        for (size_t word_index = 0; word_index < CellBitmap::word_count; ++word_index) {
+            u64 word = get_word(word_index);
+            while (word) {
+                auto bit_index = count_trailing_zeroes(word);
+                word &= word - 1;
+                callback(cell(word_index * 64 + bit_index));
+            }
+        }
+    }
+
+    struct CellBitmap {
+        // Enough bits for a block full of the smallest cells we allocate.
+        static constexpr size_t word_count = block_size / 16 / 64;
+
+        bool get(size_t index) const { return words[index / 64] & (1ull << (index % 64)); }
+        void set(size_t index) { words[index / 64] |= 1ull << (index % 64); }
+        void clear(size_t index) { words[index / 64] &= ~(1ull << (index % 64)); }
+
+        size_t count() const
+        {
+            size_t count = 0;
+            for (auto word : words)
+                count += popcount(word);
+            return count;
+        }
+
+        AK::Array<u64, word_count> words {};
+    };
+
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
     GCPtr<FreelistEntry> m_freelist;
+    CellBitmap m_live_cells;
+    CellBitmap m_marked_cells;
+    CellBitmap m_cells_with_write_barriers;
+    CellBitmap m_remembered_cells;
+    bool m_has_remembered_cells { false };
     alignas(__BIGGEST_ALIGNMENT__) u8 m_storage[];
 
 public:
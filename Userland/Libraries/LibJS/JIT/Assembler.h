@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Platform.h>
+#include <AK/Vector.h>
+
+namespace JS::JIT {
+
+// A tiny x86_64 assembler that knows just enough instructions for the baseline JIT.
+// All memory operands are of the form [base + disp32].
+struct Assembler {
+    enum class Reg : u8 {
+        RAX = 0,
+        RCX = 1,
+        RDX = 2,
+        RBX = 3,
+        RSP = 4,
+        RBP = 5,
+        RSI = 6,
+        RDI = 7,
+        R8 = 8,
+        R9 = 9,
+        R10 = 10,
+        R11 = 11,
+        R12 = 12,
+        R13 = 13,
+        R14 = 14,
+        R15 = 15,
+    };
+
+    enum class Condition : u8 {
+        Overflow = 0x0,
+        NotOverflow = 0x1,
+        Below = 0x2,
+        AboveOrEqual = 0x3,
+        Equal = 0x4,
+        NotEqual = 0x5,
+        BelowOrEqual = 0x6,
+        Above = 0x7,
+        Sign = 0x8,
+        NotSign = 0x9,
+        LessThan = 0xC,
+        GreaterThanOrEqual = 0xD,
+        LessThanOrEqual = 0xE,
+        GreaterThan = 0xF,
+    };
+
+    struct Mem {
+        Reg base;
+        i32 offset { 0 };
+    };
+
+    // A jump target. Jumps emitted before the label is bound are patched when it is.
+    struct Label {
+        Optional<size_t> offset;
+        Vector<size_t> pending_jump_slots;
+    };
+
+    explicit Assembler(Vector<u8>& output)
+        : m_output(output)
+    {
+    }
+
+    size_t current_offset() const { return m_output.size(); }
+
+    void bind(Label& label)
+    {
+        VERIFY(!label.offset.has_value());
+        label.offset = current_offset();
+        for (auto slot : label.pending_jump_slots)
+            patch_rel32(slot, current_offset());
+        label.pending_jump_slots.clear();
+    }
+
+    void mov(Reg dst, Reg src)
+    {
+        emit_rex(true, src, dst);
+        emit8(0x89);
+        emit_modrm_reg(src, dst);
+    }
+
+    void mov32(Reg dst, Reg src)
+    {
+        emit_rex(false, src, dst);
+        emit8(0x89);
+        emit_modrm_reg(src, dst);
+    }
+
+    void mov(Reg dst, u64 imm)
+    {
+        if (imm <= NumericLimits<u32>::max()) {
+            // mov r32, imm32 zero-extends into the full register.
+            emit_rex(false, Reg::RAX, dst);
+            emit8(0xB8 | (to_underlying(dst) & 7));
+            emit32(imm);
+            return;
+        }
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0xB8 | (to_underlying(dst) & 7));
+        emit64(imm);
+    }
+
+    void mov(Reg dst, Mem src)
+    {
+        emit_rex(true, dst, src.base);
+        emit8(0x8B);
+        emit_modrm_mem(dst, src);
+    }
+
+    void mov(Mem dst, Reg src)
+    {
+        emit_rex(true, src, dst.base);
+        emit8(0x89);
+        emit_modrm_mem(src, dst);
+    }
+
+    void add32(Reg dst, Reg src) { emit_alu32(0x01, dst, src); }
+    void sub32(Reg dst, Reg src) { emit_alu32(0x29, dst, src); }
+    void and32(Reg dst, Reg src) { emit_alu32(0x21, dst, src); }
+    void or32(Reg dst, Reg src) { emit_alu32(0x09, dst, src); }
+    void xor32(Reg dst, Reg src) { emit_alu32(0x31, dst, src); }
+    void cmp32(Reg lhs, Reg rhs) { emit_alu32(0x39, lhs, rhs); }
+    void test32(Reg lhs, Reg rhs) { emit_alu32(0x85, lhs, rhs); }
+
+    void or_(Reg dst, Reg src)
+    {
+        emit_rex(true, src, dst);
+        emit8(0x09);
+        emit_modrm_reg(src, dst);
+    }
+
+    void cmp(Reg lhs, Reg rhs)
+    {
+        emit_rex(true, rhs, lhs);
+        emit8(0x39);
+        emit_modrm_reg(rhs, lhs);
+    }
+
+    void add32(Reg dst, i32 imm) { emit_alu32_imm(0, dst, imm); }
+    void sub32(Reg dst, i32 imm) { emit_alu32_imm(5, dst, imm); }
+    void cmp32(Reg lhs, i32 imm) { emit_alu32_imm(7, lhs, imm); }
+
+    void shr(Reg dst, u8 amount) { emit_shift(5, dst, amount); }
+    void and_(Reg dst, i32 imm)
+    {
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0x81);
+        emit_modrm_reg(static_cast<Reg>(4), dst);
+        emit32(imm);
+    }
+
+    void jump(Label& label)
+    {
+        emit8(0xE9);
+        emit_rel32_to(label);
+    }
+
+    void jump_if(Condition condition, Label& label)
+    {
+        emit8(0x0F);
+        emit8(0x80 | to_underlying(condition));
+        emit_rel32_to(label);
+    }
+
+    void jump(Reg target)
+    {
+        emit_rex(false, Reg::RAX, target);
+        emit8(0xFF);
+        emit_modrm_reg(static_cast<Reg>(4), target);
+    }
+
+    // NOTE: The caller is responsible for keeping the stack 16-byte aligned.
+    void call(Reg target)
+    {
+        emit_rex(false, Reg::RAX, target);
+        emit8(0xFF);
+        emit_modrm_reg(static_cast<Reg>(2), target);
+    }
+
+    void push(Reg reg)
+    {
+        emit_rex(false, Reg::RAX, reg);
+        emit8(0x50 | (to_underlying(reg) & 7));
+    }
+
+    void pop(Reg reg)
+    {
+        emit_rex(false, Reg::RAX, reg);
+        emit8(0x58 | (to_underlying(reg) & 7));
+    }
+
+    void ret() { emit8(0xC3); }
+
+private:
+    static bool is_extended(Reg reg) { return to_underlying(reg) >= 8; }
+
+    // `reg` goes into ModRM.reg, `rm` into ModRM.rm (or the memory base register).
+    void emit_rex(bool wide, Reg reg, Reg rm)
+    {
+        u8 rex = 0x40;
+        if (wide)
+            rex |= 0x08;
+        if (is_extended(reg))
+            rex |= 0x04;
+        if (is_extended(rm))
+            rex |= 0x01;
+        if (rex != 0x40)
+            emit8(rex);
+    }
+
+    void emit_modrm_reg(Reg reg, Reg rm)
+    {
+        emit8(0xC0 | ((to_underlying(reg) & 7) << 3) | (to_underlying(rm) & 7));
+    }
+
+    void emit_modrm_mem(Reg reg, Mem mem)
+    {
+        // Always use a 32-bit displacement; RBP/R13 can't be encoded without one anyway.
+        emit8(0x80 | ((to_underlying(reg) & 7) << 3) | (to_underlying(mem.base) & 7));
+        // RSP/R12 as a base register need a SIB byte.
+        if ((to_underlying(mem.base) & 7) == 4)
+            emit8(0x24);
+        emit32(mem.offset);
+    }
+
+    void emit_alu32(u8 opcode, Reg dst, Reg src)
+    {
+        emit_rex(false, src, dst);
+        emit8(opcode);
+        emit_modrm_reg(src, dst);
+    }
+
+    void emit_alu32_imm(u8 extension, Reg dst, i32 imm)
+    {
+        emit_rex(false, Reg::RAX, dst);
+        emit8(0x81);
+        emit_modrm_reg(static_cast<Reg>(extension), dst);
+        emit32(imm);
+    }
+
+    void emit_shift(u8 extension, Reg dst, u8 amount)
+    {
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0xC1);
+        emit_modrm_reg(static_cast<Reg>(extension), dst);
+        emit8(amount);
+    }
+
+    void emit_rel32_to(Label& label)
+    {
+        auto slot = current_offset();
+        emit32(0);
+        if (label.offset.has_value())
+            patch_rel32(slot, *label.offset);
+        else
+            label.pending_jump_slots.append(slot);
+    }
+
+    void patch_rel32(size_t slot, size_t target)
+    {
+        i32 displacement = static_cast<i32>(static_cast<i64>(target) - static_cast<i64>(slot + 4));
+        for (size_t i = 0; i < 4; ++i)
+            m_output[slot + i] = static_cast<u8>(displacement >> (i * 8));
+    }
+
+    void emit8(u8 value) { m_output.append(value); }
+
+    void emit32(u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            emit8(static_cast<u8>(value >> (i * 8)));
+    }
+
+    void emit64(u64 value)
+    {
+        for (size_t i = 0; i < 8; ++i)
+            emit8(static_cast<u8>(value >> (i * 8)));
+    }
+
+    Vector<u8>& m_output;
+};
+
+}
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Platform.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS::JIT {
+
+using Condition = Assembler::Condition;
+using ExitReason = NativeExecutable::ExitReason;
+
+// These stay the same for as long as native code runs. All of them are callee-saved.
+static constexpr auto INTERPRETER = Assembler::Reg::RBX;
+static constexpr auto REGISTERS = Assembler::Reg::R12;
+static constexpr auto LOCALS = Assembler::Reg::R13;
+
+static Assembler::Mem register_operand(Bytecode::Register reg)
+{
+    return { REGISTERS, static_cast<i32>(reg.index() * sizeof(Value)) };
+}
+
+static Assembler::Mem accumulator_operand()
+{
+    return register_operand(Bytecode::Register::accumulator());
+}
+
+static Assembler::Mem local_operand(size_t index)
+{
+    return { LOCALS, static_cast<i32>(index * sizeof(Value)) };
+}
+
+// Returns 1 if the instruction threw, leaving the exception in Register::exception().
+template<typename OpType>
+static u64 cxx_execute_instruction(Bytecode::Interpreter& interpreter, Bytecode::BasicBlock const& block, Bytecode::Instruction const& instruction)
+{
+    interpreter.set_current_instruction(block, instruction);
+    auto result = static_cast<OpType const&>(instruction).execute_impl(interpreter);
+    if (result.is_error()) [[unlikely]] {
+        interpreter.reg(Bytecode::Register::exception()) = *result.throw_completion().value();
+        return 1;
+    }
+    return 0;
+}
+
+static FlatPtr implementation_of(Bytecode::Instruction::Type type)
+{
+    switch (type) {
+#define __BYTECODE_OP(op)                 \
+    case Bytecode::Instruction::Type::op: \
+        return reinterpret_cast<FlatPtr>(&cxx_execute_instruction<Bytecode::Op::op>);
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static u64 cxx_accumulator_to_boolean(Bytecode::Interpreter& interpreter)
+{
+    return interpreter.accumulator().to_boolean();
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable const& executable)
+{
+    // NOTE: Serenity never lets memory that has been writable become executable, outside of the dynamic loader and
+    //       mounts with the wxallowed flag, so there is no way for us to create native code there.
+#if ARCH(X86_64) && !defined(AK_OS_SERENITY)
+    Compiler compiler { executable };
+    return compiler.compile_executable();
+#else
+    (void)executable;
+    return nullptr;
+#endif
+}
+
+Compiler::Compiler(Bytecode::Executable const& executable)
+    : m_executable(executable)
+{
+    for (size_t i = 0; i < executable.basic_blocks.size(); ++i)
+        m_block_indices.set(executable.basic_blocks[i].ptr(), i);
+    m_block_labels.resize(executable.basic_blocks.size());
+}
+
+OwnPtr<NativeExecutable> Compiler::compile_executable()
+{
+    // The entry point is called as entry(interpreter, registers, locals, block_entry_address).
+    // Five pushes on top of the return address leave the stack 16-byte aligned for the calls we make.
+    m_assembler.push(Reg::RBP);
+    m_assembler.push(Reg::RBX);
+    m_assembler.push(Reg::R12);
+    m_assembler.push(Reg::R13);
+    m_assembler.push(Reg::R14);
+    m_assembler.mov(INTERPRETER, Reg::RDI);
+    m_assembler.mov(REGISTERS, Reg::RSI);
+    m_assembler.mov(LOCALS, Reg::RDX);
+    m_assembler.jump(Reg::RCX);
+
+    for (auto& block : m_executable.basic_blocks)
+        compile_block(*block);
+
+    // Every exit leaves the encoded NativeExecutable::Exit in RAX.
+    m_assembler.bind(m_exit);
+    m_assembler.pop(Reg::R14);
+    m_assembler.pop(Reg::R13);
+    m_assembler.pop(Reg::R12);
+    m_assembler.pop(Reg::RBX);
+    m_assembler.pop(Reg::RBP);
+    m_assembler.ret();
+
+    HashMap<Bytecode::BasicBlock const*, size_t> block_entry_offsets;
+    for (auto& block : m_executable.basic_blocks)
+        block_entry_offsets.set(block.ptr(), *label_for(*block).offset);
+
+    auto native_executable = NativeExecutable::create(m_output, move(block_entry_offsets));
+    if (native_executable.is_error()) {
+        dbgln_if(JS_BYTECODE_DEBUG, "LibJS: Failed to create native code for {}: {}", m_executable.name, native_executable.error());
+        return nullptr;
+    }
+    return native_executable.release_value();
+}
+
+void Compiler::compile_block(Bytecode::BasicBlock const& block)
+{
+    m_assembler.bind(label_for(block));
+    for (Bytecode::InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it)
+        compile_instruction(block, *it);
+
+    // Falling off the end of a block ends execution, which the interpreter takes care of.
+    exit_to_interpreter(ExitReason::ContinueInInterpreter, block, nullptr);
+}
+
+void Compiler::compile_instruction(Bytecode::BasicBlock const& block, Bytecode::Instruction const& instruction)
+{
+    using Type = Bytecode::Instruction::Type;
+
+    switch (instruction.type()) {
+    case Type::Load:
+        m_assembler.mov(Reg::RAX, register_operand(static_cast<Bytecode::Op::Load const&>(instruction).src()));
+        m_assembler.mov(accumulator_operand(), Reg::RAX);
+        break;
+    case Type::Store:
+        m_assembler.mov(Reg::RAX, accumulator_operand());
+        m_assembler.mov(register_operand(static_cast<Bytecode::Op::Store const&>(instruction).dst()), Reg::RAX);
+        break;
+    case Type::LoadImmediate:
+        m_assembler.mov(Reg::RAX, static_cast<Bytecode::Op::LoadImmediate const&>(instruction).value().encoded());
+        m_assembler.mov(accumulator_operand(), Reg::RAX);
+        break;
+    case Type::GetLocal: {
+        Assembler::Label is_initialized;
+        m_assembler.mov(Reg::RAX, local_operand(static_cast<Bytecode::Op::GetLocal const&>(instruction).index()));
+        m_assembler.mov(Reg::RCX, Value().encoded());
+        m_assembler.cmp(Reg::RAX, Reg::RCX);
+        m_assembler.jump_if(Condition::NotEqual, is_initialized);
+        // Leave throwing the ReferenceError to the interpreter.
+        exit_to_interpreter(ExitReason::ContinueInInterpreter, block, &instruction);
+        m_assembler.bind(is_initialized);
+        m_assembler.mov(accumulator_operand(), Reg::RAX);
+        break;
+    }
+    case Type::SetLocal:
+        m_assembler.mov(Reg::RAX, accumulator_operand());
+        m_assembler.mov(local_operand(static_cast<Bytecode::Op::SetLocal const&>(instruction).index()), Reg::RAX);
+        break;
+    case Type::Jump:
+        m_assembler.jump(label_for(static_cast<Bytecode::Op::Jump const&>(instruction).true_target()->block()));
+        break;
+    case Type::JumpConditional:
+        compile_jump_conditional(static_cast<Bytecode::Op::Jump const&>(instruction));
+        break;
+    case Type::JumpNullish: {
+        auto& jump = static_cast<Bytecode::Op::Jump const&>(instruction);
+        m_assembler.mov(Reg::RAX, accumulator_operand());
+        m_assembler.shr(Reg::RAX, TAG_SHIFT);
+        m_assembler.and_(Reg::RAX, IS_NULLISH_EXTRACT_PATTERN);
+        m_assembler.cmp32(Reg::RAX, IS_NULLISH_PATTERN);
+        m_assembler.jump_if(Condition::Equal, label_for(jump.true_target()->block()));
+        m_assembler.jump(label_for(jump.false_target()->block()));
+        break;
+    }
+    case Type::JumpUndefined: {
+        auto& jump = static_cast<Bytecode::Op::Jump const&>(instruction);
+        m_assembler.mov(Reg::RAX, accumulator_operand());
+        m_assembler.mov(Reg::RCX, js_undefined().encoded());
+        m_assembler.cmp(Reg::RAX, Reg::RCX);
+        m_assembler.jump_if(Condition::Equal, label_for(jump.true_target()->block()));
+        m_assembler.jump(label_for(jump.false_target()->block()));
+        break;
+    }
+
+#define __COMPILE_INT32_BINARY_OP(op)                                                                     \
+    case Type::op:                                                                                        \
+        compile_int32_binary_op(block, instruction, static_cast<Bytecode::Op::op const&>(instruction).lhs()); \
+        break;
+        __COMPILE_INT32_BINARY_OP(Add)
+        __COMPILE_INT32_BINARY_OP(Sub)
+        __COMPILE_INT32_BINARY_OP(BitwiseAnd)
+        __COMPILE_INT32_BINARY_OP(BitwiseOr)
+        __COMPILE_INT32_BINARY_OP(BitwiseXor)
+        __COMPILE_INT32_BINARY_OP(LessThan)
+        __COMPILE_INT32_BINARY_OP(LessThanEquals)
+        __COMPILE_INT32_BINARY_OP(GreaterThan)
+        __COMPILE_INT32_BINARY_OP(GreaterThanEquals)
+        __COMPILE_INT32_BINARY_OP(LooselyEquals)
+        __COMPILE_INT32_BINARY_OP(LooselyInequals)
+        __COMPILE_INT32_BINARY_OP(StrictlyEquals)
+        __COMPILE_INT32_BINARY_OP(StrictlyInequals)
+#undef __COMPILE_INT32_BINARY_OP
+
+    case Type::Increment:
+    case Type::Decrement:
+        compile_int32_increment_or_decrement(block, instruction);
+        break;
+
+    // These manipulate the interpreter's unwind contexts, scheduled jumps and return values, so we let it run them.
+    case Type::Return:
+    case Type::Yield:
+    case Type::Await:
+    case Type::EnterUnwindContext:
+    case Type::ContinuePendingUnwind:
+    case Type::ScheduleJump:
+        exit_to_interpreter(ExitReason::ContinueInInterpreter, block, &instruction);
+        break;
+
+    default:
+        compile_call_to_implementation(block, instruction);
+        break;
+    }
+}
+
+void Compiler::compile_jump_conditional(Bytecode::Op::Jump const& jump)
+{
+    auto& true_label = label_for(jump.true_target()->block());
+    auto& false_label = label_for(jump.false_target()->block());
+
+    Assembler::Label not_boolean;
+    Assembler::Label slow_case;
+
+    // Booleans and int32s are falsy exactly when their low 32 bits are zero.
+    m_assembler.mov(Reg::RAX, accumulator_operand());
+    m_assembler.mov(Reg::RDX, Reg::RAX);
+    m_assembler.shr(Reg::RDX, TAG_SHIFT);
+    m_assembler.cmp32(Reg::RDX, BOOLEAN_TAG);
+    m_assembler.jump_if(Condition::NotEqual, not_boolean);
+    m_assembler.test32(Reg::RAX, Reg::RAX);
+    m_assembler.jump_if(Condition::NotEqual, true_label);
+    m_assembler.jump(false_label);
+
+    m_assembler.bind(not_boolean);
+    m_assembler.cmp32(Reg::RDX, INT32_TAG);
+    m_assembler.jump_if(Condition::NotEqual, slow_case);
+    m_assembler.test32(Reg::RAX, Reg::RAX);
+    m_assembler.jump_if(Condition::NotEqual, true_label);
+    m_assembler.jump(false_label);
+
+    m_assembler.bind(slow_case);
+    m_assembler.mov(Reg::RDI, INTERPRETER);
+    call(reinterpret_cast<FlatPtr>(&cxx_accumulator_to_boolean));
+    m_assembler.test32(Reg::RAX, Reg::RAX);
+    m_assembler.jump_if(Condition::NotEqual, true_label);
+    m_assembler.jump(false_label);
+}
+
+void Compiler::compile_int32_binary_op(Bytecode::BasicBlock const& block, Bytecode::Instruction const& instruction, Bytecode::Register lhs)
+{
+    using Type = Bytecode::Instruction::Type;
+
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    m_assembler.mov(Reg::RAX, register_operand(lhs));
+    m_assembler.mov(Reg::RCX, accumulator_operand());
+    jump_if_not_int32(Reg::RAX, Reg::RDX, slow_case);
+    jump_if_not_int32(Reg::RCX, Reg::RDX, slow_case);
+
+    auto store_int32_result = [&] {
+        // 32-bit operations clear the upper half of the register, so we only need to add the tag.
+        m_assembler.mov(Reg::RDX, SHIFTED_INT32_TAG);
+        m_assembler.or_(Reg::RAX, Reg::RDX);
+        m_assembler.mov(accumulator_operand(), Reg::RAX);
+        m_assembler.jump(done);
+    };
+
+    auto store_comparison_result = [&](Condition condition) {
+        Assembler::Label is_true;
+        m_assembler.cmp32(Reg::RAX, Reg::RCX);
+        m_assembler.jump_if(condition, is_true);
+        m_assembler.mov(Reg::RAX, Value(false).encoded());
+        m_assembler.mov(accumulator_operand(), Reg::RAX);
+        m_assembler.jump(done);
+        m_assembler.bind(is_true);
+        m_assembler.mov(Reg::RAX, Value(true).encoded());
+        m_assembler.mov(accumulator_operand(), Reg::RAX);
+        m_assembler.jump(done);
+    };
+
+    switch (instruction.type()) {
+    case Type::Add:
+        m_assembler.add32(Reg::RAX, Reg::RCX);
+        m_assembler.jump_if(Condition::Overflow, slow_case);
+        store_int32_result();
+        break;
+    case Type::Sub:
+        m_assembler.sub32(Reg::RAX, Reg::RCX);
+        m_assembler.jump_if(Condition::Overflow, slow_case);
+        store_int32_result();
+        break;
+    case Type::BitwiseAnd:
+        m_assembler.and32(Reg::RAX, Reg::RCX);
+        store_int32_result();
+        break;
+    case Type::BitwiseOr:
+        m_assembler.or32(Reg::RAX, Reg::RCX);
+        store_int32_result();
+        break;
+    case Type::BitwiseXor:
+        m_assembler.xor32(Reg::RAX, Reg::RCX);
+        store_int32_result();
+        break;
+    case Type::LessThan:
+        store_comparison_result(Condition::LessThan);
+        break;
+    case Type::LessThanEquals:
+        store_comparison_result(Condition::LessThanOrEqual);
+        break;
+    case Type::GreaterThan:
+        store_comparison_result(Condition::GreaterThan);
+        break;
+    case Type::GreaterThanEquals:
+        store_comparison_result(Condition::GreaterThanOrEqual);
+        break;
+    case Type::LooselyEquals:
+    case Type::StrictlyEquals:
+        store_comparison_result(Condition::Equal);
+        break;
+    case Type::LooselyInequals:
+    case Type::StrictlyInequals:
+        store_comparison_result(Condition::NotEqual);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+    // The operands weren't both int32s, or the result didn't fit into one.
+    m_assembler.bind(slow_case);
+    compile_call_to_implementation(block, instruction);
+    m_assembler.bind(done);
+}
+
+void Compiler::compile_int32_increment_or_decrement(Bytecode::BasicBlock const& block, Bytecode::Instruction const& instruction)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    m_assembler.mov(Reg::RAX, accumulator_operand());
+    jump_if_not_int32(Reg::RAX, Reg::RDX, slow_case);
+    if (instruction.type() == Bytecode::Instruction::Type::Increment)
+        m_assembler.add32(Reg::RAX, 1);
+    else
+        m_assembler.sub32(Reg::RAX, 1);
+    m_assembler.jump_if(Condition::Overflow, slow_case);
+    m_assembler.mov(Reg::RDX, SHIFTED_INT32_TAG);
+    m_assembler.or_(Reg::RAX, Reg::RDX);
+    m_assembler.mov(accumulator_operand(), Reg::RAX);
+    m_assembler.jump(done);
+
+    m_assembler.bind(slow_case);
+    compile_call_to_implementation(block, instruction);
+    m_assembler.bind(done);
+}
+
+void Compiler::compile_call_to_implementation(Bytecode::BasicBlock const& block, Bytecode::Instruction const& instruction)
+{
+    m_assembler.mov(Reg::RDI, INTERPRETER);
+    m_assembler.mov(Reg::RSI, reinterpret_cast<FlatPtr>(&block));
+    m_assembler.mov(Reg::RDX, reinterpret_cast<FlatPtr>(&instruction));
+    call(implementation_of(instruction.type()));
+
+    Assembler::Label did_not_throw;
+    m_assembler.test32(Reg::RAX, Reg::RAX);
+    m_assembler.jump_if(Condition::Equal, did_not_throw);
+    exit_to_interpreter(ExitReason::Threw, block, &instruction);
+    m_assembler.bind(did_not_throw);
+}
+
+void Compiler::exit_to_interpreter(ExitReason reason, Bytecode::BasicBlock const& block, Bytecode::Instruction const* instruction)
+{
+    size_t offset = instruction ? reinterpret_cast<u8 const*>(instruction) - block.data() : block.size();
+    m_assembler.mov(Reg::RAX, NativeExecutable::encode_exit(reason, m_block_indices.get(&block).value(), offset));
+    m_assembler.jump(m_exit);
+}
+
+Assembler::Label& Compiler::label_for(Bytecode::BasicBlock const& block)
+{
+    return m_block_labels[m_block_indices.get(&block).value()];
+}
+
+void Compiler::jump_if_not_int32(Reg value, Reg scratch, Assembler::Label& target)
+{
+    m_assembler.mov(scratch, value);
+    m_assembler.shr(scratch, TAG_SHIFT);
+    m_assembler.cmp32(scratch, INT32_TAG);
+    m_assembler.jump_if(Condition::NotEqual, target);
+}
+
+void Compiler::call(FlatPtr function)
+{
+    m_assembler.mov(Reg::RAX, function);
+    m_assembler.call(Reg::RAX);
+}
+
+}
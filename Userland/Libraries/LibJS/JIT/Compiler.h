@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/JIT/Assembler.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::Bytecode::Op {
+class Jump;
+}
+
+namespace JS::JIT {
+
+// A baseline compiler that translates each bytecode instruction in isolation.
+//
+// Simple register moves, jumps, and int32 arithmetic and comparisons are emitted inline.
+// Everything else calls straight into the instruction's implementation (so e.g. property
+// accesses still go through their inline caches), and the few instructions that change
+// the interpreter's control flow state hand control back to the interpreter.
+class Compiler {
+public:
+    // Returns null if native code can't be created on this platform.
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable const&);
+
+private:
+    explicit Compiler(Bytecode::Executable const&);
+
+    using Reg = Assembler::Reg;
+
+    OwnPtr<NativeExecutable> compile_executable();
+    void compile_block(Bytecode::BasicBlock const&);
+    void compile_instruction(Bytecode::BasicBlock const&, Bytecode::Instruction const&);
+
+    void compile_jump_conditional(Bytecode::Op::Jump const&);
+    void compile_int32_binary_op(Bytecode::BasicBlock const&, Bytecode::Instruction const&, Bytecode::Register lhs);
+    void compile_int32_increment_or_decrement(Bytecode::BasicBlock const&, Bytecode::Instruction const&);
+
+    // Calls the instruction's implementation, and leaves native code if it threw.
+    void compile_call_to_implementation(Bytecode::BasicBlock const&, Bytecode::Instruction const&);
+
+    void exit_to_interpreter(NativeExecutable::ExitReason, Bytecode::BasicBlock const&, Bytecode::Instruction const*);
+    Assembler::Label& label_for(Bytecode::BasicBlock const&);
+    void jump_if_not_int32(Reg value, Reg scratch, Assembler::Label& target);
+    void call(FlatPtr function);
+
+    Bytecode::Executable const& m_executable;
+    Vector<u8> m_output;
+    Assembler m_assembler { m_output };
+    HashMap<Bytecode::BasicBlock const*, size_t> m_block_indices;
+    Vector<Assembler::Label> m_block_labels;
+    Assembler::Label m_exit;
+};
+
+}
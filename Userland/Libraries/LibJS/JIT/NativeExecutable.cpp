@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/JIT/NativeExecutable.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+ErrorOr<NonnullOwnPtr<NativeExecutable>> NativeExecutable::create(ReadonlyBytes code, HashMap<Bytecode::BasicBlock const*, size_t> block_entry_offsets)
+{
+    // NOTE: The code is written while the mapping is writable, and only then made executable,
+    //       so that the pages are never writable and executable at the same time.
+    auto* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        return AK::Error::from_errno(errno);
+
+    memcpy(memory, code.data(), code.size());
+
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        auto error = AK::Error::from_errno(errno);
+        munmap(memory, code.size());
+        return error;
+    }
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) NativeExecutable(memory, code.size(), move(block_entry_offsets)));
+}
+
+NativeExecutable::NativeExecutable(void* code, size_t size, HashMap<Bytecode::BasicBlock const*, size_t> block_entry_offsets)
+    : m_code(code)
+    , m_size(size)
+    , m_block_entry_offsets(move(block_entry_offsets))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    munmap(m_code, m_size);
+}
+
+NativeExecutable::Exit NativeExecutable::run(Bytecode::Interpreter& interpreter, Bytecode::BasicBlock const& block, Value* registers, Value* locals) const
+{
+    // The code starts with a prologue that sets up the callee-saved registers and then jumps to the given address.
+    using EntryPoint = u64 (*)(Bytecode::Interpreter*, Value*, Value*, void const*);
+    auto entry_point = reinterpret_cast<EntryPoint>(m_code);
+    auto const* block_entry = static_cast<u8 const*>(m_code) + m_block_entry_offsets.get(&block).value();
+    return decode_exit(entry_point(&interpreter, registers, locals, block_entry));
+}
+
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// Machine code for a whole Bytecode::Executable, with an entry point for every basic block.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    // Native code returns control to the interpreter with one of these, packed into a u64
+    // together with the basic block and the offset of the instruction within it.
+    enum class ExitReason : u8 {
+        // The interpreter should continue by executing the instruction at the given offset.
+        ContinueInInterpreter = 0,
+        // The instruction at the given offset threw; the exception is in Register::exception().
+        Threw = 1,
+    };
+
+    struct Exit {
+        ExitReason reason;
+        size_t block_index;
+        size_t offset;
+    };
+
+    static constexpr u64 encode_exit(ExitReason reason, size_t block_index, size_t offset)
+    {
+        return (static_cast<u64>(block_index) << 32) | (static_cast<u64>(offset) << 1) | to_underlying(reason);
+    }
+
+    static constexpr Exit decode_exit(u64 encoded)
+    {
+        return {
+            .reason = static_cast<ExitReason>(encoded & 1),
+            .block_index = static_cast<size_t>(encoded >> 32),
+            .offset = static_cast<size_t>((encoded & 0xFFFFFFFF) >> 1),
+        };
+    }
+
+    static ErrorOr<NonnullOwnPtr<NativeExecutable>> create(ReadonlyBytes code, HashMap<Bytecode::BasicBlock const*, size_t> block_entry_offsets);
+    ~NativeExecutable();
+
+    // Runs native code from the start of the given block until it needs the interpreter again.
+    Exit run(Bytecode::Interpreter&, Bytecode::BasicBlock const&, Value* registers, Value* locals) const;
+
+    size_t code_size() const { return m_size; }
+
+private:
+    NativeExecutable(void* code, size_t size, HashMap<Bytecode::BasicBlock const*, size_t> block_entry_offsets);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<Bytecode::BasicBlock const*, size_t> m_block_entry_offsets;
+};
+
+}
@@ -16,6 +16,7 @@
 #include <AK/ScopeGuard.h>
 #include <AK/StdLibExtras.h>
 #include <AK/TemporaryChange.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Runtime/RegExpObject.h>
 #include <LibRegex/Regex.h>
 
@@ -618,6 +619,7 @@ Parser::Parser(Lexer lexer, Program::Type program_type, Optional<EvalInitialStat
     : m_source_code(SourceCode::create(lexer.filename(), String::from_deprecated_string(lexer.source()).release_value_but_fixme_should_propagate_errors()))
     , m_state(move(lexer), program_type)
     , m_program_type(program_type)
+    , m_keeps_nodes_referenceable_from_bytecode(Bytecode::ExecutableCache::is_enabled())
 {
     if (initial_state_for_eval.has_value()) {
         m_state.initiated_by_eval = true;
@@ -710,6 +712,7 @@ NonnullRefPtr<Program> Parser::parse_program(bool starts_in_strict_mode)
         parse_module(program);
 
     program->set_end_offset({}, position().offset);
+    program->set_nodes_referenceable_from_bytecode({}, move(m_nodes_referenceable_from_bytecode));
     return program;
 }
 
@@ -348,6 +348,21 @@ private:
 
     NonnullRefPtr<Identifier const> create_identifier_and_register_in_current_scope(SourceRange range, DeprecatedFlyString string);
 
+    // This shadows JS::create_ast_node() for all nodes the parser creates, so that we can keep track of the ones
+    // bytecode can refer to (see Program::nodes_referenceable_from_bytecode()). That list keeps every one of those
+    // nodes alive for as long as the program is, so it's only kept while the bytecode cache is enabled.
+    template<class T, class... Args>
+    NonnullRefPtr<T> create_ast_node(SourceRange range, Args&&... args)
+    {
+        auto node = JS::create_ast_node<T>(move(range), forward<Args>(args)...);
+        using NodeType = RemoveCV<T>;
+        if constexpr (IsBaseOf<ScopeNode, NodeType> || IsSame<FunctionExpression, NodeType> || IsSame<ClassExpression, NodeType> || IsSame<RegExpLiteral, NodeType>) {
+            if (m_keeps_nodes_referenceable_from_bytecode)
+                m_nodes_referenceable_from_bytecode.append(node);
+        }
+        return node;
+    }
+
     NonnullRefPtr<SourceCode const> m_source_code;
     Vector<Position> m_rule_starts;
     ParserState m_state;
@@ -355,5 +370,7 @@ private:
     Vector<ParserState> m_saved_state;
     HashMap<Position, TokenMemoization, PositionKeyTraits> m_token_memoizations;
     Program::Type m_program_type;
+    bool m_keeps_nodes_referenceable_from_bytecode { false };
+    Vector<NonnullRefPtr<ASTNode const>> m_nodes_referenceable_from_bytecode;
 };
 }
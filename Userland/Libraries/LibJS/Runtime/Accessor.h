@@ -23,10 +23,18 @@ public:
     }
 
     FunctionObject* getter() const { return m_getter; }
-    void set_getter(FunctionObject* getter) { m_getter = getter; }
+    void set_getter(FunctionObject* getter)
+    {
+        did_store_cell_reference();
+        m_getter = getter;
+    }
 
     FunctionObject* setter() const { return m_setter; }
-    void set_setter(FunctionObject* setter) { m_setter = setter; }
+    void set_setter(FunctionObject* setter)
+    {
+        did_store_cell_reference();
+        m_setter = setter;
+    }
 
     void visit_edges(Cell::Visitor& visitor) override
     {
@@ -46,4 +54,7 @@ private:
     GCPtr<FunctionObject> m_setter;
 };
 
+template<>
+inline constexpr bool cell_has_write_barriers<Accessor> = true;
+
 }
@@ -24,10 +24,11 @@ public:
     virtual ThrowCompletionOr<Optional<PropertyDescriptor>> internal_get_own_property(PropertyKey const&) const override;
     virtual ThrowCompletionOr<bool> internal_define_own_property(PropertyKey const&, PropertyDescriptor const&) override;
     virtual ThrowCompletionOr<Value> internal_get(PropertyKey const&, Value receiver, CacheablePropertyMetadata*) const override;
-    virtual ThrowCompletionOr<bool> internal_set(PropertyKey const&, Value value, Value receiver) override;
+    virtual ThrowCompletionOr<bool> internal_set(PropertyKey const&, Value value, Value receiver, CacheablePropertyMetadata* = nullptr) override;
     virtual ThrowCompletionOr<bool> internal_delete(PropertyKey const&) override;
 
     virtual bool may_interfere_with_indexed_property_access() const final { return true; }
+    virtual bool has_exotic_internal_methods() const final { return true; }
 
     // [[ParameterMap]]
     Object& parameter_map() { return *m_parameter_map; }
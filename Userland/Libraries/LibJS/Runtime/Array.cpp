@@ -157,15 +157,32 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     return true;
 }
 
+bool has_packed_elements(Object const& object, size_t length)
+{
+    if (object.may_interfere_with_indexed_property_access())
+        return false;
+    auto const* storage = object.indexed_properties().storage();
+    return storage && storage->is_packed_storage() && length <= storage->size();
+}
+
 // 23.1.3.30.1 SortIndexedProperties ( obj, len, SortCompare, holes ), https://tc39.es/ecma262/#sec-sortindexedproperties
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes)
 {
     // 1. Let items be a new empty List.
     auto items = MarkedVector<Value> { vm.heap() };
 
+    // OPTIMIZATION: Every element of packed storage is present and can be read without side effects.
+    if (has_packed_elements(object, length)) {
+        items.ensure_capacity(length);
+        object.indexed_properties().visit_packed_elements([&](auto elements) {
+            for (size_t k = 0; k < length; ++k)
+                items.unchecked_append(Value(elements[k]));
+        });
+    }
+
     // 2. Let k be 0.
     // 3. Repeat, while k < len,
-    for (size_t k = 0; k < length; ++k) {
+    for (size_t k = items.size(); k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
@@ -44,6 +44,7 @@ public:
     virtual ThrowCompletionOr<bool> internal_define_own_property(PropertyKey const&, PropertyDescriptor const&) override final;
     virtual ThrowCompletionOr<bool> internal_delete(PropertyKey const&) override final;
     virtual ThrowCompletionOr<MarkedVector<Value>> internal_own_property_keys() const override final;
+    virtual bool has_exotic_internal_methods() const override final { return true; }
 
     [[nodiscard]] bool length_is_writable() const { return m_length_writable; }
 
@@ -56,11 +57,18 @@ private:
     bool m_length_writable { true };
 };
 
+template<>
+inline constexpr bool cell_has_write_barriers<Array> = true;
+
 enum class Holes {
     SkipHoles,
     ReadThroughHoles,
 };
 
+// Whether the first `length` elements of the object are all present in packed storage, i.e. they are all numbers and
+// reading them can't have side effects.
+bool has_packed_elements(Object const&, size_t length);
+
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
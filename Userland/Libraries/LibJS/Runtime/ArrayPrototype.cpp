@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -143,6 +144,19 @@ static ThrowCompletionOr<Object*> array_species_create(VM& vm, Object& original_
     return TRY(construct(vm, constructor.as_function(), Value(length))).ptr();
 }
 
+// Whether Set() on indices past the end of the array can neither fail nor run any user code: the array must be
+// extensible, its length must be writable, and nothing on its prototype chain may have indexed properties.
+static ThrowCompletionOr<bool> can_append_elements_directly(Object& object)
+{
+    if (!is<Array>(object) || !static_cast<Array&>(object).length_is_writable() || !TRY(object.is_extensible()))
+        return false;
+    for (auto* prototype = object.shape().prototype(); prototype; prototype = prototype->shape().prototype()) {
+        if (prototype->may_interfere_with_indexed_property_access() || !prototype->indexed_properties().is_empty())
+            return false;
+    }
+    return true;
+}
+
 // 23.1.3.1 Array.prototype.at ( index ), https://tc39.es/ecma262/#sec-array.prototype.at
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::at)
 {
@@ -740,6 +754,22 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Packed storage can only contain numbers, and reading from it can't have side effects.
+    if (has_packed_elements(*this_object, length)) {
+        if (!value_to_find.is_number())
+            return Value(false);
+        auto number_to_find = value_to_find.as_double();
+        return this_object->indexed_properties().visit_packed_elements([&](auto elements) {
+            for (u64 i = from_index; i < length; ++i) {
+                // NOTE: SameValueZero() considers NaN to be equal to itself.
+                if (elements[i] == number_to_find || (elements[i] != elements[i] && number_to_find != number_to_find))
+                    return Value(true);
+            }
+            return Value(false);
+        });
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -793,6 +823,21 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Packed storage can only contain numbers, and none of its elements are holes. Reading them can't have
+    //               side effects, so this is equivalent to the loop below.
+    if (has_packed_elements(*object, length)) {
+        if (!search_element.is_number())
+            return Value(-1);
+        auto search_number = search_element.as_double();
+        return object->indexed_properties().visit_packed_elements([&](auto elements) {
+            for (; k < length; ++k) {
+                if (elements[k] == search_number)
+                    return Value(k);
+            }
+            return Value(-1);
+        });
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -904,6 +949,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
         k = (double)length + n;
     }
 
+    // OPTIMIZATION: See Array.prototype.indexOf().
+    if (has_packed_elements(*object, length)) {
+        if (!search_element.is_number())
+            return Value(-1);
+        auto search_number = search_element.as_double();
+        return object->indexed_properties().visit_packed_elements([&](auto elements) {
+            for (; k >= 0; --k) {
+                if (elements[k] == search_number)
+                    return Value((size_t)k);
+            }
+            return Value(-1);
+        });
+    }
+
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
         auto property_key = PropertyKey { k };
@@ -956,13 +1015,19 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Elements of packed storage are present and can be read without side effects. The callback may
+        //               change the array, so this has to be checked again for every element.
+        Optional<Value> packed_value;
+        if (has_packed_elements(*object, k + 1))
+            packed_value = object->indexed_properties().get(k)->value;
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = packed_value.has_value() || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = packed_value.has_value() ? *packed_value : TRY(object->get(property_key));
 
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
@@ -988,6 +1053,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::pop)
         return js_undefined();
     }
     auto index = length - 1;
+
+    // OPTIMIZATION: The last element of an array with simple or packed storage is a configurable data property, and the
+    //               array's own length is the one being set, so none of the steps below can fail or run any user code.
+    if (is<Array>(*this_object) && static_cast<Array&>(*this_object).length_is_writable() && !this_object->may_interfere_with_indexed_property_access()) {
+        auto& indexed_properties = this_object->indexed_properties();
+        auto const* storage = indexed_properties.storage();
+        if ((storage->is_packed_storage() || storage->is_simple_storage()) && storage->has_index(index)) {
+            auto element = indexed_properties.get(index)->value;
+            indexed_properties.remove(index);
+            indexed_properties.set_array_like_size(index);
+            return element;
+        }
+    }
+
     auto element = TRY(this_object->get(index));
     TRY(this_object->delete_property_or_throw(index));
     TRY(this_object->set(vm.names.length, Value(index), Object::ShouldThrowExceptions::Yes));
@@ -1003,6 +1082,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto new_length = length + argument_count;
     if (new_length > MAX_ARRAY_LIKE_INDEX)
         return vm.throw_completion<TypeError>(ErrorType::ArrayMaxSize);
+
+    // OPTIMIZATION: Append the new elements straight to the storage if nothing could observe the difference.
+    if (new_length <= NumericLimits<u32>::max() && TRY(can_append_elements_directly(*this_object))) {
+        auto& indexed_properties = this_object->indexed_properties();
+        for (size_t i = 0; i < argument_count; ++i)
+            indexed_properties.put(length + i, vm.argument(i));
+        return Value(new_length);
+    }
+
     for (size_t i = 0; i < argument_count; ++i)
         TRY(this_object->set(length + i, vm.argument(i), Object::ShouldThrowExceptions::Yes));
     auto new_length_value = Value(new_length);
@@ -1393,6 +1481,30 @@ ThrowCompletionOr<void> array_merge_sort(VM& vm, Function<ThrowCompletionOr<doub
     return {};
 }
 
+// Sorts numbers the way SortCompare does without a comparison function, i.e. by their string representations.
+template<typename T>
+static void sort_numbers_by_string_representation(Span<T> elements)
+{
+    struct SortKey {
+        DeprecatedString string;
+        T element;
+        size_t index;
+    };
+    Vector<SortKey> keys;
+    keys.ensure_capacity(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i)
+        keys.unchecked_append({ number_to_deprecated_string(elements[i]), elements[i], i });
+
+    // NOTE: The sort must be stable, and different numbers can have the same string representation (0 and -0).
+    quick_sort(keys, [](auto const& a, auto const& b) {
+        auto result = a.string.view().compare(b.string.view());
+        return result < 0 || (result == 0 && a.index < b.index);
+    });
+
+    for (size_t i = 0; i < elements.size(); ++i)
+        elements[i] = keys[i].element;
+}
+
 // 23.1.3.30 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1413,6 +1525,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
         return TRY(compare_array_elements(vm, x, y, comparefn.is_undefined() ? nullptr : &comparefn.as_function()));
     };
 
+    // OPTIMIZATION: Without a comparison function, sorting packed storage can't run any user code or leave holes behind,
+    //               so it can be done in place, converting each number to a string only once.
+    if (comparefn.is_undefined() && has_packed_elements(*object, length)) {
+        object->indexed_properties().visit_packed_elements([&](auto elements) {
+            sort_numbers_by_string_representation(elements.trim(length));
+        });
+        return object;
+    }
+
     // 5. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, skip-holes).
     auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles));
 
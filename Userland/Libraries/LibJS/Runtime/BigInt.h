@@ -33,6 +33,9 @@ private:
     Crypto::SignedBigInteger m_big_integer;
 };
 
+template<>
+inline constexpr bool cell_has_write_barriers<BigInt> = true;
+
 ThrowCompletionOr<BigInt*> number_to_bigint(VM&, Value);
 
 }
@@ -28,6 +28,8 @@
 #include <LibJS/Runtime/PromiseCapability.h>
 #include <LibJS/Runtime/PromiseConstructor.h>
 #include <LibJS/Runtime/Value.h>
+#include <LibJS/Script.h>
+#include <LibJS/SourceTextModule.h>
 
 namespace JS {
 
@@ -1184,8 +1186,17 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
             return declaration_result.release_error();
     }
 
-    if (!m_bytecode_executable)
-        m_bytecode_executable = TRY(Bytecode::compile(vm, *m_ecmascript_code, m_kind, m_name));
+    if (!m_bytecode_executable) {
+        Program const* program = m_script_or_module.visit(
+            [](Empty) -> Program const* { return nullptr; },
+            [](NonnullGCPtr<Script> const& script) -> Program const* { return &script->parse_node(); },
+            [](NonnullGCPtr<Module> const& module) -> Program const* {
+                if (is<SourceTextModule>(*module))
+                    return &static_cast<SourceTextModule const&>(*module).parse_node();
+                return nullptr;
+            });
+        m_bytecode_executable = TRY(Bytecode::compile(vm, *m_ecmascript_code, m_kind, m_name, program));
+    }
 
     if (m_kind == FunctionKind::Async) {
         if (declaration_result.is_throw_completion()) {
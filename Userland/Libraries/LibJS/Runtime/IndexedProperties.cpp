@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/QuickSort.h>
+#include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/IndexedProperties.h>
 
@@ -13,8 +15,86 @@ namespace JS {
 constexpr const size_t SPARSE_ARRAY_HOLE_THRESHOLD = 200;
 constexpr const size_t LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD = 4 * MiB;
 
+template<typename T>
+PackedIndexedPropertyStorage<T>::PackedIndexedPropertyStorage(Vector<T>&& elements, size_t array_like_size)
+    : IndexedPropertyStorage(storage_kind)
+    , m_array_size(array_like_size)
+    , m_elements(move(elements))
+{
+    VERIFY(m_elements.size() <= m_array_size);
+}
+
+template<typename T>
+Optional<ValueAndAttributes> PackedIndexedPropertyStorage<T>::get(u32 index) const
+{
+    if (!has_index(index))
+        return {};
+    return ValueAndAttributes { Value(m_elements[index]), default_attributes };
+}
+
+template<typename T>
+void PackedIndexedPropertyStorage<T>::put(u32 index, Value value, PropertyAttributes attributes)
+{
+    VERIFY(attributes == default_attributes);
+    VERIFY(index <= m_elements.size());
+    VERIFY(can_hold(value));
+
+    T element;
+    if constexpr (IsSame<T, i32>)
+        element = value.as_i32();
+    else
+        element = value.as_double();
+
+    if (index == m_elements.size())
+        m_elements.append(element);
+    else
+        m_elements[index] = element;
+    m_array_size = max(m_array_size, static_cast<size_t>(index) + 1);
+}
+
+template<typename T>
+void PackedIndexedPropertyStorage<T>::remove(u32 index)
+{
+    // Only the last element can be removed, anything else would leave a hole behind.
+    VERIFY(index + 1 == m_elements.size());
+    m_elements.take_last();
+}
+
+template<typename T>
+ValueAndAttributes PackedIndexedPropertyStorage<T>::take_first()
+{
+    VERIFY(m_array_size > 0);
+    m_array_size--;
+    if (m_elements.is_empty())
+        return {};
+    return { Value(m_elements.take_first()), default_attributes };
+}
+
+template<typename T>
+ValueAndAttributes PackedIndexedPropertyStorage<T>::take_last()
+{
+    VERIFY(m_array_size > 0);
+    m_array_size--;
+    if (m_elements.size() <= m_array_size)
+        return {};
+    return { Value(m_elements.take_last()), default_attributes };
+}
+
+template<typename T>
+bool PackedIndexedPropertyStorage<T>::set_array_like_size(size_t new_size)
+{
+    m_array_size = new_size;
+    if (new_size < m_elements.size())
+        m_elements.shrink(new_size);
+    return true;
+}
+
+template class PackedIndexedPropertyStorage<i32>;
+template class PackedIndexedPropertyStorage<double>;
+
 SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initial_values)
-    : m_array_size(initial_values.size())
+    : IndexedPropertyStorage(Kind::Simple)
+    , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
 }
@@ -83,6 +163,7 @@ bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 }
 
 GenericIndexedPropertyStorage::GenericIndexedPropertyStorage(SimpleIndexedPropertyStorage&& storage)
+    : IndexedPropertyStorage(Kind::Generic)
 {
     m_array_size = storage.array_like_size();
     for (size_t i = 0; i < storage.m_packed_elements.size(); ++i) {
@@ -219,6 +300,28 @@ void IndexedPropertyIterator::skip_empty_indices()
     m_index = m_indexed_properties.array_like_size();
 }
 
+IndexedProperties::IndexedProperties(Vector<Value> values)
+{
+    if (values.is_empty())
+        return;
+
+    if (all_of(values, [](auto value) { return value.is_int32(); })) {
+        Vector<i32> elements;
+        elements.ensure_capacity(values.size());
+        for (auto value : values)
+            elements.unchecked_append(value.as_i32());
+        m_storage = make<PackedInt32IndexedPropertyStorage>(move(elements), values.size());
+    } else if (all_of(values, [](auto value) { return value.is_number(); })) {
+        Vector<double> elements;
+        elements.ensure_capacity(values.size());
+        for (auto value : values)
+            elements.unchecked_append(value.as_double());
+        m_storage = make<PackedDoubleIndexedPropertyStorage>(move(elements), values.size());
+    } else {
+        m_storage = make<SimpleIndexedPropertyStorage>(move(values));
+    }
+}
+
 Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
 {
     if (!m_storage)
@@ -229,10 +332,22 @@ Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
 void IndexedProperties::put(u32 index, Value value, PropertyAttributes attributes)
 {
     ensure_storage();
+    if (m_storage->is_packed_storage()) {
+        // Attributes, holes and anything that isn't a number need one of the more general storages.
+        if (attributes != default_attributes || index > m_storage->size() || !value.is_number())
+            switch_to_simple_storage();
+        else if (m_storage->kind() == IndexedPropertyStorage::Kind::PackedInt32 && !value.is_int32())
+            switch_to_packed_double_storage();
+    }
+
     if (m_storage->is_simple_storage() && (attributes != default_attributes || index > (array_like_size() + SPARSE_ARRAY_HOLE_THRESHOLD))) {
         switch_to_generic_storage();
     }
 
+    // We only ever live inside an Object, so this is the write barrier of the object that owns us.
+    if (value.is_cell())
+        HeapBlock::from_cell(reinterpret_cast<Cell const*>(this))->did_store_cell_reference(this);
+
     m_storage->put(index, value, attributes);
 }
 
@@ -240,6 +355,8 @@ void IndexedProperties::remove(u32 index)
 {
     VERIFY(m_storage);
     VERIFY(m_storage->has_index(index));
+    if (m_storage->is_packed_storage() && index + 1 != m_storage->size())
+        switch_to_simple_storage();
     m_storage->remove(index);
 }
 
@@ -251,7 +368,7 @@ bool IndexedProperties::set_array_like_size(size_t new_size)
     // We can't use simple storage for lengths that don't fit in an i32.
     // Also, to avoid gigantic unused storage allocations, let's put an (arbitrary) 4M cap on simple storage here.
     // This prevents something like "a = []; a.length = 0x80000000;" from allocating 2G entries.
-    if (m_storage->is_simple_storage()
+    if (m_storage->kind() != IndexedPropertyStorage::Kind::Generic
         && (new_size > NumericLimits<i32>::max()
             || (current_array_like_size < LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD && new_size > LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD))) {
         switch_to_generic_storage();
@@ -264,6 +381,8 @@ size_t IndexedProperties::real_size() const
 {
     if (!m_storage)
         return 0;
+    if (m_storage->is_packed_storage())
+        return m_storage->size();
     if (m_storage->is_simple_storage()) {
         auto& packed_elements = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).elements();
         size_t size = 0;
@@ -280,6 +399,13 @@ Vector<u32> IndexedProperties::indices() const
 {
     if (!m_storage)
         return {};
+    if (m_storage->is_packed_storage()) {
+        Vector<u32> indices;
+        indices.ensure_capacity(m_storage->size());
+        for (u32 i = 0; i < m_storage->size(); ++i)
+            indices.unchecked_append(i);
+        return indices;
+    }
     if (m_storage->is_simple_storage()) {
         auto const& storage = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage);
         auto const& elements = storage.elements();
@@ -297,12 +423,44 @@ Vector<u32> IndexedProperties::indices() const
     return indices;
 }
 
+void IndexedProperties::switch_to_packed_double_storage()
+{
+    VERIFY(m_storage->kind() == IndexedPropertyStorage::Kind::PackedInt32);
+    auto const& storage = static_cast<PackedInt32IndexedPropertyStorage const&>(*m_storage);
+    Vector<double> elements;
+    elements.ensure_capacity(storage.size());
+    for (auto element : storage.elements())
+        elements.unchecked_append(element);
+    m_storage = make<PackedDoubleIndexedPropertyStorage>(move(elements), storage.array_like_size());
+}
+
+void IndexedProperties::switch_to_simple_storage()
+{
+    VERIFY(m_storage->is_packed_storage());
+    Vector<Value> values;
+    values.ensure_capacity(m_storage->array_like_size());
+    auto append_elements = [&](auto const& elements) {
+        for (auto element : elements)
+            values.unchecked_append(Value(element));
+    };
+    if (m_storage->kind() == IndexedPropertyStorage::Kind::PackedInt32)
+        append_elements(static_cast<PackedInt32IndexedPropertyStorage const&>(*m_storage).elements());
+    else
+        append_elements(static_cast<PackedDoubleIndexedPropertyStorage const&>(*m_storage).elements());
+
+    auto array_like_size = m_storage->array_like_size();
+    m_storage = make<SimpleIndexedPropertyStorage>(move(values));
+    m_storage->set_array_like_size(array_like_size);
+}
+
 void IndexedProperties::switch_to_generic_storage()
 {
     if (!m_storage) {
         m_storage = make<GenericIndexedPropertyStorage>();
         return;
     }
+    if (m_storage->is_packed_storage())
+        switch_to_simple_storage();
     auto& storage = static_cast<SimpleIndexedPropertyStorage&>(*m_storage);
     m_storage = make<GenericIndexedPropertyStorage>(move(storage));
 }
@@ -310,7 +468,7 @@ void IndexedProperties::switch_to_generic_storage()
 void IndexedProperties::ensure_storage()
 {
     if (!m_storage)
-        m_storage = make<SimpleIndexedPropertyStorage>();
+        m_storage = make<PackedInt32IndexedPropertyStorage>();
 }
 
 }
@@ -25,6 +25,14 @@ class GenericIndexedPropertyStorage;
 
 class IndexedPropertyStorage {
 public:
+    // Ordered from the most to the least specialized kind. Storage only ever transitions towards a less specialized kind.
+    enum class Kind : u8 {
+        PackedInt32,
+        PackedDouble,
+        Simple,
+        Generic,
+    };
+
     virtual ~IndexedPropertyStorage() = default;
 
     virtual bool has_index(u32 index) const = 0;
@@ -39,12 +47,70 @@ public:
     virtual size_t array_like_size() const = 0;
     virtual bool set_array_like_size(size_t new_size) = 0;
 
-    virtual bool is_simple_storage() const { return false; }
+    Kind kind() const { return m_kind; }
+    bool is_packed_storage() const { return m_kind == Kind::PackedInt32 || m_kind == Kind::PackedDouble; }
+    bool is_simple_storage() const { return m_kind == Kind::Simple; }
+
+protected:
+    explicit IndexedPropertyStorage(Kind kind)
+        : m_kind(kind)
+    {
+    }
+
+private:
+    Kind m_kind;
+};
+
+// Holds the elements of an array that only contains int32s or only contains numbers, without boxing them into Values.
+// There are no holes, except after the last element. Elements always have the default attributes.
+template<typename T>
+class PackedIndexedPropertyStorage final : public IndexedPropertyStorage {
+public:
+    static constexpr Kind storage_kind = IsSame<T, i32> ? Kind::PackedInt32 : Kind::PackedDouble;
+
+    PackedIndexedPropertyStorage()
+        : IndexedPropertyStorage(storage_kind)
+    {
+    }
+    PackedIndexedPropertyStorage(Vector<T>&& elements, size_t array_like_size);
+
+    static bool can_hold(Value value)
+    {
+        if constexpr (IsSame<T, i32>)
+            return value.is_int32();
+        else
+            return value.is_number();
+    }
+
+    virtual bool has_index(u32 index) const override { return index < m_elements.size(); }
+    virtual Optional<ValueAndAttributes> get(u32 index) const override;
+    virtual void put(u32 index, Value value, PropertyAttributes attributes = default_attributes) override;
+    virtual void remove(u32 index) override;
+
+    virtual ValueAndAttributes take_first() override;
+    virtual ValueAndAttributes take_last() override;
+
+    virtual size_t size() const override { return m_elements.size(); }
+    virtual size_t array_like_size() const override { return m_array_size; }
+    virtual bool set_array_like_size(size_t new_size) override;
+
+    Vector<T> const& elements() const { return m_elements; }
+    Span<T> elements() { return m_elements.span(); }
+
+private:
+    size_t m_array_size { 0 };
+    Vector<T> m_elements;
 };
 
+using PackedInt32IndexedPropertyStorage = PackedIndexedPropertyStorage<i32>;
+using PackedDoubleIndexedPropertyStorage = PackedIndexedPropertyStorage<double>;
+
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
-    SimpleIndexedPropertyStorage() = default;
+    SimpleIndexedPropertyStorage()
+        : IndexedPropertyStorage(Kind::Simple)
+    {
+    }
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
 
     virtual bool has_index(u32 index) const override;
@@ -59,7 +125,6 @@ public:
     virtual size_t array_like_size() const override { return m_array_size; }
     virtual bool set_array_like_size(size_t new_size) override;
 
-    virtual bool is_simple_storage() const override { return true; }
     Vector<Value> const& elements() const { return m_packed_elements; }
 
 private:
@@ -74,7 +139,10 @@ private:
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
     explicit GenericIndexedPropertyStorage(SimpleIndexedPropertyStorage&&);
-    explicit GenericIndexedPropertyStorage() = default;
+    explicit GenericIndexedPropertyStorage()
+        : IndexedPropertyStorage(Kind::Generic)
+    {
+    }
 
     virtual bool has_index(u32 index) const override;
     virtual Optional<ValueAndAttributes> get(u32 index) const override;
@@ -118,11 +186,7 @@ class IndexedProperties {
 public:
     IndexedProperties() = default;
 
-    explicit IndexedProperties(Vector<Value> values)
-    {
-        if (!values.is_empty())
-            m_storage = make<SimpleIndexedPropertyStorage>(move(values));
-    }
+    explicit IndexedProperties(Vector<Value> values);
 
     bool has_index(u32 index) const { return m_storage ? m_storage->has_index(index) : false; }
     Optional<ValueAndAttributes> get(u32 index) const;
@@ -138,7 +202,7 @@ public:
     size_t array_like_size() const { return m_storage ? m_storage->array_like_size() : 0; }
     bool set_array_like_size(size_t);
 
-    IndexedPropertyStorage* storage() { return m_storage; }
+    // NOTE: Writes have to go through put(), which is where the owning object's write barrier is.
     IndexedPropertyStorage const* storage() const { return m_storage; }
 
     size_t real_size() const;
@@ -148,7 +212,8 @@ public:
     template<typename Callback>
     void for_each_value(Callback callback)
     {
-        if (!m_storage)
+        // Packed storage only holds numbers, so there are no values to visit.
+        if (!m_storage || m_storage->is_packed_storage())
             return;
         if (m_storage->is_simple_storage()) {
             for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).elements())
@@ -159,7 +224,28 @@ public:
         }
     }
 
+    // Calls the callback with the elements of packed storage, as a span of either i32 or double.
+    template<typename Callback>
+    decltype(auto) visit_packed_elements(Callback callback)
+    {
+        VERIFY(m_storage && m_storage->is_packed_storage());
+        if (m_storage->kind() == IndexedPropertyStorage::Kind::PackedInt32)
+            return callback(static_cast<PackedInt32IndexedPropertyStorage&>(*m_storage).elements());
+        return callback(static_cast<PackedDoubleIndexedPropertyStorage&>(*m_storage).elements());
+    }
+
+    template<typename Callback>
+    decltype(auto) visit_packed_elements(Callback callback) const
+    {
+        VERIFY(m_storage && m_storage->is_packed_storage());
+        if (m_storage->kind() == IndexedPropertyStorage::Kind::PackedInt32)
+            return callback(static_cast<PackedInt32IndexedPropertyStorage const&>(*m_storage).elements().span());
+        return callback(static_cast<PackedDoubleIndexedPropertyStorage const&>(*m_storage).elements().span());
+    }
+
 private:
+    void switch_to_packed_double_storage();
+    void switch_to_simple_storage();
     void switch_to_generic_storage();
     void ensure_storage();
 
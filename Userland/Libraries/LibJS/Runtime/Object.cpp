@@ -887,7 +887,7 @@ ThrowCompletionOr<Value> Object::internal_get(PropertyKey const& property_key, V
 }
 
 // 10.1.9 [[Set]] ( P, V, Receiver ), https://tc39.es/ecma262/#sec-ordinary-object-internal-methods-and-internal-slots-set-p-v-receiver
-ThrowCompletionOr<bool> Object::internal_set(PropertyKey const& property_key, Value value, Value receiver)
+ThrowCompletionOr<bool> Object::internal_set(PropertyKey const& property_key, Value value, Value receiver, CacheablePropertyMetadata* cacheable_metadata)
 {
     VERIFY(property_key.is_valid());
     VERIFY(!value.is_empty());
@@ -897,11 +897,11 @@ ThrowCompletionOr<bool> Object::internal_set(PropertyKey const& property_key, Va
     auto own_descriptor = TRY(internal_get_own_property(property_key));
 
     // 3. Return ? OrdinarySetWithOwnDescriptor(O, P, V, Receiver, ownDesc).
-    return ordinary_set_with_own_descriptor(property_key, value, receiver, own_descriptor);
+    return ordinary_set_with_own_descriptor(property_key, value, receiver, own_descriptor, cacheable_metadata);
 }
 
 // 10.1.9.2 OrdinarySetWithOwnDescriptor ( O, P, V, Receiver, ownDesc ), https://tc39.es/ecma262/#sec-ordinarysetwithowndescriptor
-ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey const& property_key, Value value, Value receiver, Optional<PropertyDescriptor> own_descriptor)
+ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey const& property_key, Value value, Value receiver, Optional<PropertyDescriptor> own_descriptor, CacheablePropertyMetadata* cacheable_metadata)
 {
     VERIFY(property_key.is_valid());
     VERIFY(!value.is_empty());
@@ -917,7 +917,7 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
         // b. If parent is not null, then
         if (parent) {
             // i. Return ? parent.[[Set]](P, V, Receiver).
-            return TRY(parent->internal_set(property_key, value, receiver));
+            return TRY(parent->internal_set(property_key, value, receiver, cacheable_metadata));
         }
         // c. Else,
         else {
@@ -957,6 +957,14 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
             // iii. Let valueDesc be the PropertyDescriptor { [[Value]]: V }.
             auto value_descriptor = PropertyDescriptor { .value = value };
 
+            // Non-standard: If the caller has requested cacheable metadata and we are overwriting a plain own property, fill it in.
+            if (cacheable_metadata && &receiver.as_object() == this && !m_has_intrinsic_accessors && existing_descriptor->property_offset.has_value()) {
+                *cacheable_metadata = CacheablePropertyMetadata {
+                    .type = CacheablePropertyMetadata::Type::OwnProperty,
+                    .property_offset = existing_descriptor->property_offset.value(),
+                };
+            }
+
             // iv. Return ? Receiver.[[DefineOwnProperty]](P, valueDesc).
             return TRY(receiver.as_object().internal_define_own_property(property_key, value_descriptor));
         }
@@ -966,7 +974,18 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
             VERIFY(!receiver.as_object().storage_has(property_key));
 
             // ii. Return ? CreateDataProperty(Receiver, P, V).
-            return TRY(receiver.as_object().create_data_property(property_key, value));
+            auto created = TRY(receiver.as_object().create_data_property(property_key, value));
+
+            // Non-standard: If the caller has requested cacheable metadata and we added a new named property, fill it in.
+            if (cacheable_metadata && created && !property_key.is_number()) {
+                if (auto metadata = receiver.as_object().shape().lookup(property_key.to_string_or_symbol()); metadata.has_value()) {
+                    *cacheable_metadata = CacheablePropertyMetadata {
+                        .type = CacheablePropertyMetadata::Type::AddOwnProperty,
+                        .property_offset = metadata->offset,
+                    };
+                }
+            }
+            return created;
         }
     }
 
@@ -1099,7 +1118,7 @@ Optional<ValueAndAttributes> Object::storage_get(PropertyKey const& property_key
 
         if (m_has_intrinsic_accessors) {
             if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value())
-                const_cast<Object&>(*this).m_storage[metadata->offset] = (*accessor)(shape().realm());
+                const_cast<Object&>(*this).put_direct(metadata->offset, (*accessor)(shape().realm()));
         }
 
         value = m_storage[metadata->offset];
@@ -1150,6 +1169,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
         else
             set_shape(*m_shape->create_put_transition(property_key_string_or_symbol, attributes));
 
+        did_store_value(value);
         m_storage.append(value);
         return;
     }
@@ -1161,7 +1181,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
             set_shape(*m_shape->create_configure_transition(property_key_string_or_symbol, attributes));
     }
 
-    m_storage[metadata->offset] = value;
+    put_direct(metadata->offset, value);
 }
 
 void Object::storage_delete(PropertyKey const& property_key)
@@ -1194,7 +1214,7 @@ void Object::set_prototype(Object* new_prototype)
     if (shape.is_unique())
         shape.set_prototype_without_transition(new_prototype);
     else
-        m_shape = shape.create_prototype_transition(new_prototype);
+        set_shape(*shape.create_prototype_transition(new_prototype));
 }
 
 void Object::define_native_accessor(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> getter, Function<ThrowCompletionOr<Value>(VM&)> setter, PropertyAttributes attribute)
@@ -1241,7 +1261,7 @@ void Object::ensure_shape_is_unique()
     if (shape().is_unique())
         return;
 
-    m_shape = m_shape->create_unique_clone();
+    set_shape(*m_shape->create_unique_clone());
 }
 
 // Simple side-effect free property lookup, following the prototype chain. Non-standard.
@@ -45,6 +45,7 @@ struct CacheablePropertyMetadata {
     enum class Type {
         NotCacheable,
         OwnProperty,
+        AddOwnProperty,
     };
     Type type { Type::NotCacheable };
     Optional<u32> property_offset;
@@ -131,7 +132,7 @@ public:
     virtual ThrowCompletionOr<bool> internal_define_own_property(PropertyKey const&, PropertyDescriptor const&);
     virtual ThrowCompletionOr<bool> internal_has_property(PropertyKey const&) const;
     virtual ThrowCompletionOr<Value> internal_get(PropertyKey const&, Value receiver, CacheablePropertyMetadata* = nullptr) const;
-    virtual ThrowCompletionOr<bool> internal_set(PropertyKey const&, Value value, Value receiver);
+    virtual ThrowCompletionOr<bool> internal_set(PropertyKey const&, Value value, Value receiver, CacheablePropertyMetadata* = nullptr);
     virtual ThrowCompletionOr<bool> internal_delete(PropertyKey const&);
     virtual ThrowCompletionOr<MarkedVector<Value>> internal_own_property_keys() const;
 
@@ -141,7 +142,12 @@ public:
     //       might not hold when property access behaves differently.
     virtual bool may_interfere_with_indexed_property_access() const { return false; }
 
-    ThrowCompletionOr<bool> ordinary_set_with_own_descriptor(PropertyKey const&, Value, Value, Optional<PropertyDescriptor>);
+    // NOTE: Any subclass of Object that overrides [[GetOwnProperty]], [[DefineOwnProperty]], [[Get]], [[Set]], [[Delete]],
+    //       [[HasProperty]] or the extensibility slots must return true for this, to opt out of inline caches that
+    //       replay property stores without going through those internal methods.
+    virtual bool has_exotic_internal_methods() const { return false; }
+
+    ThrowCompletionOr<bool> ordinary_set_with_own_descriptor(PropertyKey const&, Value, Value, Optional<PropertyDescriptor>, CacheablePropertyMetadata* = nullptr);
 
     // 10.4.7 Immutable Prototype Exotic Objects, https://tc39.es/ecma262/#sec-immutable-prototype-exotic-objects
 
@@ -193,10 +199,27 @@ public:
     virtual void visit_edges(Cell::Visitor&) override;
 
     Value get_direct(size_t index) const { return m_storage[index]; }
+    void put_direct(size_t index, Value value)
+    {
+        did_store_value(value);
+        m_storage[index] = value;
+    }
+
+    // Non-standard: Replays a property addition that an inline cache has seen before on an object of the same shape.
+    void add_direct_property_with_transition(Shape& new_shape, Value value)
+    {
+        set_shape(new_shape);
+        did_store_value(value);
+        m_storage.append(value);
+    }
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
     IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        did_store_cell_reference();
+        m_indexed_properties = IndexedProperties(move(values));
+    }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
@@ -226,7 +249,17 @@ protected:
     bool m_has_parameter_map { false };
 
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape)
+    {
+        did_store_cell_reference();
+        m_shape = &shape;
+    }
+
+    void did_store_value(Value value)
+    {
+        if (value.is_cell())
+            did_store_cell_reference();
+    }
 
     Object* prototype() { return shape().prototype(); }
     Object const* prototype() const { return shape().prototype(); }
@@ -240,4 +273,7 @@ private:
     OwnPtr<Vector<PrivateElement>> m_private_elements; // [[PrivateElements]]
 };
 
+template<>
+inline constexpr bool cell_has_write_barriers<Object> = true;
+
 }
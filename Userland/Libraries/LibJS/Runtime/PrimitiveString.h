@@ -75,4 +75,7 @@ private:
     mutable Optional<Utf16String> m_utf16_string;
 };
 
+template<>
+inline constexpr bool cell_has_write_barriers<PrimitiveString> = true;
+
 }
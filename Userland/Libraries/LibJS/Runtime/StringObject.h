@@ -31,6 +31,7 @@ private:
     virtual ThrowCompletionOr<MarkedVector<Value>> internal_own_property_keys() const override;
 
     virtual bool may_interfere_with_indexed_property_access() const final { return true; }
+    virtual bool has_exotic_internal_methods() const final { return true; }
 
     virtual bool is_string_object() const final { return true; }
     virtual void visit_edges(Visitor&) override;
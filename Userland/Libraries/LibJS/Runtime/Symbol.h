@@ -33,4 +33,7 @@ private:
     bool m_is_global;
 };
 
+template<>
+inline constexpr bool cell_has_write_barriers<Symbol> = true;
+
 }
@@ -314,7 +314,7 @@ public:
     }
 
     // 10.4.5.5 [[Set]] ( P, V, Receiver ), https://tc39.es/ecma262/#sec-integer-indexed-exotic-objects-set-p-v-receiver
-    virtual ThrowCompletionOr<bool> internal_set(PropertyKey const& property_key, Value value, Value receiver) override
+    virtual ThrowCompletionOr<bool> internal_set(PropertyKey const& property_key, Value value, Value receiver, CacheablePropertyMetadata* cacheable_metadata) override
     {
         VERIFY(!value.is_empty());
         VERIFY(!receiver.is_empty());
@@ -347,7 +347,7 @@ public:
         }
 
         // 2. Return ? OrdinarySet(O, P, V, Receiver).
-        return Object::internal_set(property_key, value, receiver);
+        return Object::internal_set(property_key, value, receiver, cacheable_metadata);
     }
 
     // 10.4.5.6 [[Delete]] ( P ), https://tc39.es/ecma262/#sec-integer-indexed-exotic-objects-delete-p
@@ -415,6 +415,7 @@ public:
     }
 
     virtual bool may_interfere_with_indexed_property_access() const final { return true; }
+    virtual bool has_exotic_internal_methods() const final { return true; }
 
     ReadonlySpan<UnderlyingBufferDataType> data() const
     {
@@ -0,0 +1,183 @@
+describe("transitions between element kinds", () => {
+    test("int32 elements becoming doubles", () => {
+        const a = [1, 2, 3];
+        a[1] = 2.5;
+        a.push(-0);
+        expect(a).toEqual([1, 2.5, 3, -0]);
+        expect(Object.is(a[3], -0)).toBeTrue();
+    });
+
+    test("numbers becoming other values", () => {
+        const a = [1, 2.5, 3];
+        a[0] = "foo";
+        a.push(undefined, null);
+        expect(a).toEqual(["foo", 2.5, 3, undefined, null]);
+    });
+
+    test("holes", () => {
+        const a = [1, 2, 3];
+        a[5] = 6;
+        expect(a).toHaveLength(6);
+        expect(3 in a).toBeFalse();
+        expect(a[3]).toBeUndefined();
+        expect(5 in a).toBeTrue();
+
+        const b = [1, 2, 3];
+        delete b[1];
+        expect(b).toHaveLength(3);
+        expect(1 in b).toBeFalse();
+        expect(Object.keys(b)).toEqual(["0", "2"]);
+
+        const c = [1, 2, 3];
+        delete c[2];
+        expect(c).toHaveLength(3);
+        expect(2 in c).toBeFalse();
+        c[2] = 4;
+        expect(c).toEqual([1, 2, 4]);
+    });
+
+    test("length changes", () => {
+        const a = [1, 2, 3];
+        a.length = 5;
+        expect(a).toHaveLength(5);
+        expect(Object.keys(a)).toEqual(["0", "1", "2"]);
+        a.length = 1;
+        expect(a).toEqual([1]);
+        a[1] = 2;
+        expect(a).toEqual([1, 2]);
+
+        const b = new Array(3);
+        b[0] = 1;
+        b[1] = 2;
+        expect(Object.keys(b)).toEqual(["0", "1"]);
+        expect(b).toHaveLength(3);
+    });
+
+    test("attributes", () => {
+        const a = [1, 2, 3];
+        Object.defineProperty(a, 1, { value: 5, writable: false });
+        a[1] = 6;
+        expect(a).toEqual([1, 5, 3]);
+
+        const b = Object.freeze([1, 2, 3]);
+        expect(() => {
+            "use strict";
+            b[0] = 2;
+        }).toThrow(TypeError);
+        expect(b).toEqual([1, 2, 3]);
+    });
+
+    test("inherited elements show through holes", () => {
+        const a = [1, 2, 3];
+        a.length = 4;
+        Object.setPrototypeOf(a, [9, 9, 9, 9]);
+        expect(a[3]).toBe(9);
+        expect(a.indexOf(9)).toBe(3);
+        expect(a.includes(9)).toBeTrue();
+    });
+});
+
+describe("Array.prototype fast paths", () => {
+    test("push", () => {
+        const a = [1, 2];
+        expect(a.push(3, 4.5, "five")).toBe(5);
+        expect(a).toEqual([1, 2, 3, 4.5, "five"]);
+
+        expect(() => Object.freeze([1]).push(2)).toThrow(TypeError);
+        expect(() => Object.seal([1]).push(2)).toThrow(TypeError);
+        expect(() => Object.preventExtensions([1]).push(2)).toThrow(TypeError);
+
+        const b = [1];
+        Object.defineProperty(b, "length", { writable: false });
+        expect(() => b.push(2)).toThrow(TypeError);
+        expect(b).toEqual([1]);
+    });
+
+    test("push calls setters on the prototype chain", () => {
+        const calls = [];
+        const prototype = Object.create(Array.prototype);
+        Object.defineProperty(prototype, 1, {
+            set(value) {
+                calls.push(value);
+            },
+        });
+        const a = [1];
+        Object.setPrototypeOf(a, prototype);
+        a.push(2);
+        expect(calls).toEqual([2]);
+        expect(a).toHaveLength(2);
+        expect(a.hasOwnProperty(1)).toBeFalse();
+    });
+
+    test("pop", () => {
+        const a = [1, 2.5, 3];
+        expect(a.pop()).toBe(3);
+        expect(a.pop()).toBe(2.5);
+        expect(a).toEqual([1]);
+
+        const b = [1, 2];
+        b.length = 3;
+        expect(b.pop()).toBeUndefined();
+        expect(b).toEqual([1, 2]);
+
+        expect(() => Object.freeze([1]).pop()).toThrow(TypeError);
+    });
+
+    test("map", () => {
+        expect([1, 2, 3].map(x => x * 2)).toEqual([2, 4, 6]);
+        expect([1, 2.5].map(x => `${x}`)).toEqual(["1", "2.5"]);
+
+        const a = [1, 2, 3, 4];
+        const result = a.map((x, i) => {
+            if (i === 0) {
+                a[1] = "changed";
+                a.length = 3;
+            }
+            return x;
+        });
+        expect(result).toHaveLength(4);
+        expect(result).toEqual([1, "changed", 3, undefined]);
+        expect(3 in result).toBeFalse();
+    });
+
+    test("indexOf, lastIndexOf and includes", () => {
+        const a = [1, 2, 3, 2, 1];
+        expect(a.indexOf(2)).toBe(1);
+        expect(a.indexOf(2, 2)).toBe(3);
+        expect(a.indexOf(2, -1)).toBe(-1);
+        expect(a.indexOf("2")).toBe(-1);
+        expect(a.indexOf(2.5)).toBe(-1);
+        expect(a.lastIndexOf(2)).toBe(3);
+        expect(a.lastIndexOf(2, 2)).toBe(1);
+        expect(a.lastIndexOf(1, -2)).toBe(0);
+        expect(a.includes(3)).toBeTrue();
+        expect(a.includes(3, 3)).toBeFalse();
+        expect(a.includes({})).toBeFalse();
+
+        const b = [0.5, NaN, -0];
+        expect(b.indexOf(NaN)).toBe(-1);
+        expect(b.lastIndexOf(NaN)).toBe(-1);
+        expect(b.includes(NaN)).toBeTrue();
+        expect(b.indexOf(0)).toBe(2);
+        expect(b.includes(0)).toBeTrue();
+        expect([1, 2].includes(NaN)).toBeFalse();
+    });
+
+    test("sort", () => {
+        expect([10, 9, 1, 100, -1, -20].sort()).toEqual([-1, -20, 1, 10, 100, 9]);
+        expect([1.5, 10, 0.25, 2].sort()).toEqual([0.25, 1.5, 10, 2]);
+        expect([3, 1, 2].sort((a, b) => a - b)).toEqual([1, 2, 3]);
+
+        const zeros = [0, -0, 0, -0].sort();
+        expect(zeros.map(x => Object.is(x, -0))).toEqual([false, true, false, true]);
+
+        const a = [3, 1, 2];
+        a.length = 5;
+        a.sort();
+        expect(a).toHaveLength(5);
+        expect(Object.keys(a)).toEqual(["0", "1", "2"]);
+        expect(a.slice(0, 3)).toEqual([1, 2, 3]);
+
+        expect([3, 1, 2].toSorted()).toEqual([1, 2, 3]);
+    });
+});
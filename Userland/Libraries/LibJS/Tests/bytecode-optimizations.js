@@ -0,0 +1,105 @@
+test("constant arithmetic", () => {
+    expect(1 + 2 * 3).toBe(7);
+    expect(7 / 2).toBe(3.5);
+    expect(1 / 0).toBe(Infinity);
+    expect(0 / 0).toBeNaN();
+    expect(5 % -2).toBe(1);
+    expect(-5 % 2).toBe(-1);
+    expect(Object.is(-4 % 2, -0)).toBeTrue();
+    expect(Object.is(-0, 0)).toBeFalse();
+    expect(0.1 + 0.2).toBe(0.30000000000000004);
+    expect(2147483647 + 1).toBe(2147483648);
+});
+
+test("constant bitwise operations", () => {
+    expect(~5).toBe(-6);
+    expect(6 & 3).toBe(2);
+    expect(6 | 3).toBe(7);
+    expect(6 ^ 3).toBe(5);
+    expect(1 << 31).toBe(-2147483648);
+    expect(1 << 33).toBe(2);
+    expect(-8 >> 1).toBe(-4);
+    expect(-1 >>> 0).toBe(4294967295);
+    expect(-8 >>> 28).toBe(15);
+});
+
+test("constant comparisons", () => {
+    expect(1 < 2).toBeTrue();
+    expect(NaN < 1).toBeFalse();
+    expect(NaN >= NaN).toBeFalse();
+    expect(NaN === NaN).toBeFalse();
+    expect(NaN !== NaN).toBeTrue();
+    expect(0 === -0).toBeTrue();
+    expect(null == undefined).toBeTrue();
+    expect(null == 0).toBeFalse();
+    expect(undefined == false).toBeFalse();
+    expect(true == 1).toBeTrue();
+    expect(false != 0).toBeFalse();
+    expect(null === undefined).toBeFalse();
+});
+
+test("constant conditions", () => {
+    let taken = [];
+    if (1 < 2) taken.push("then");
+    else taken.push("else");
+    if (null ?? false) taken.push("nullish");
+    if (!undefined) taken.push("not");
+    while (false) taken.push("never");
+    expect(taken).toEqual(["then", "not"]);
+});
+
+test("values stay alive across exception handlers and finalizers", () => {
+    function f(shouldThrow) {
+        let before = "before";
+        let log = [];
+        try {
+            let inside = "inside";
+            if (shouldThrow) throw new Error("error");
+            log.push(inside);
+        } catch (e) {
+            log.push(before, e.message);
+        } finally {
+            log.push(before);
+        }
+        return log;
+    }
+    expect(f(false)).toEqual(["inside", "before"]);
+    expect(f(true)).toEqual(["before", "error", "before"]);
+
+    function g() {
+        let result = [];
+        for (let i = 0; i < 5; ++i) {
+            const label = `#${i}`;
+            try {
+                if (i === 1) continue;
+                if (i === 3) break;
+            } finally {
+                result.push(label);
+            }
+        }
+        return result;
+    }
+    expect(g()).toEqual(["#0", "#1", "#2", "#3"]);
+});
+
+test("values stay alive across yield and await", async () => {
+    function* generator() {
+        let a = 1 + 1;
+        let b = yield a;
+        let c = yield a + b;
+        return [a, b, c];
+    }
+    const iterator = generator();
+    expect(iterator.next().value).toBe(2);
+    expect(iterator.next(10).value).toBe(12);
+    expect(iterator.next(20).value).toEqual([2, 10, 20]);
+});
+
+test("many simultaneously live temporaries", () => {
+    function sum(...args) {
+        return args.reduce((a, b) => a + b, 0);
+    }
+    const x = 1;
+    expect(sum(x, x + 1, sum(x, 2, 3), [x, 2, 3].length, sum(...[x, 2]), x * 6)).toBe(21);
+    expect([[x, 2], [3, [4, x + 4]], x + 5]).toEqual([[1, 2], [3, [4, 5]], 6]);
+});
@@ -0,0 +1,68 @@
+// Allocates enough short-lived garbage to trigger young generation collections.
+function churn() {
+    for (let i = 0; i < 100_000; ++i) {
+        let temporary = { index: i, values: [i, i + 1, i + 2] };
+    }
+}
+
+test("young cells stored into old objects survive young generation collections", () => {
+    const old = { named: null };
+    const oldArray = [1, 2, 3];
+    const oldWithPrototype = {};
+    gc();
+
+    // Everything above is old now, and the values stored below are young.
+    old.named = { value: "named" };
+    old["added" + 1] = { value: "added" };
+    oldArray[1] = { value: "indexed" };
+    oldArray.push("pushed" + 1);
+    Object.setPrototypeOf(oldWithPrototype, { inherited: "inherited" + 1 });
+    Object.defineProperty(old, "accessor", {
+        get: () => "getter",
+        configurable: true,
+    });
+
+    churn();
+
+    expect(old.named.value).toBe("named");
+    expect(old.added1.value).toBe("added");
+    expect(oldArray[1].value).toBe("indexed");
+    expect(oldArray[3]).toBe("pushed1");
+    expect(oldWithPrototype.inherited).toBe("inherited1");
+    expect(old.accessor).toBe("getter");
+});
+
+test("accessors of old objects can be replaced with young functions", () => {
+    const old = {};
+    Object.defineProperty(old, "accessor", {
+        get: () => "first",
+        configurable: true,
+    });
+    gc();
+
+    Object.defineProperty(old, "accessor", { get: () => "second" });
+
+    churn();
+
+    expect(old.accessor).toBe("second");
+});
+
+test("young cells reachable only through old cells without write barriers survive", () => {
+    const map = new Map();
+    const environment = (() => {
+        let captured = null;
+        return {
+            set: value => (captured = value),
+            get: () => captured,
+        };
+    })();
+    gc();
+
+    map.set("key", { value: "map" });
+    environment.set({ value: "environment" });
+
+    churn();
+
+    expect(map.get("key").value).toBe("map");
+    expect(environment.get().value).toBe("environment");
+});
@@ -16,3 +16,202 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic property lookups", () => {
+    function ic(o) {
+        return o.x;
+    }
+
+    const objects = [{ x: 1 }, { a: 0, x: 2 }, { b: 0, c: 0, x: 3 }, { d: 0, x: 4 }, { e: 0, f: 0, x: 5 }];
+    for (let i = 0; i < 3; ++i) {
+        expect(objects.map(ic)).toEqual([1, 2, 3, 4, 5]);
+    }
+});
+
+test("Cached property stores", () => {
+    function ic(o, value) {
+        o.x = value;
+    }
+
+    const objects = [{ x: 1 }, { a: 0, x: 2 }, { b: 0, c: 0, x: 3 }, { d: 0, x: 4 }, { e: 0, f: 0, x: 5 }];
+    for (let i = 0; i < 3; ++i) {
+        objects.forEach((o, index) => ic(o, index + i));
+        expect(objects.map(o => o.x)).toEqual([i, i + 1, i + 2, i + 3, i + 4]);
+    }
+});
+
+test("Cached property additions", () => {
+    function Point(x, y) {
+        this.x = x;
+        this.y = y;
+    }
+
+    for (let i = 0; i < 3; ++i) {
+        const point = new Point(i, i + 1);
+        expect(Object.keys(point)).toEqual(["x", "y"]);
+        expect(point.x).toBe(i);
+        expect(point.y).toBe(i + 1);
+    }
+});
+
+test("Inline cache for property addition invalidated by setter on prototype", () => {
+    function Thing(value) {
+        this.value = value;
+    }
+
+    expect(new Thing(1).value).toBe(1);
+    expect(new Thing(2).value).toBe(2);
+
+    let setterValue;
+    Object.defineProperty(Thing.prototype, "value", {
+        set(value) {
+            setterValue = value;
+        },
+        get() {
+            return "from getter";
+        },
+    });
+
+    const thing = new Thing(3);
+    expect(setterValue).toBe(3);
+    expect(Object.hasOwn(thing, "value")).toBeFalse();
+    expect(thing.value).toBe("from getter");
+});
+
+test("Inline cache for property addition invalidated by read-only property further up the prototype chain", () => {
+    function add(o) {
+        "use strict";
+        o.name = "added";
+    }
+
+    const base = {};
+    const derived = Object.create(base);
+    add(Object.create(derived));
+    add(Object.create(derived));
+
+    Object.defineProperty(base, "name", { value: "read-only", writable: false });
+    const object = Object.create(derived);
+    expect(() => add(object)).toThrow(TypeError);
+    expect(object.name).toBe("read-only");
+});
+
+test("Inline cache for property addition respects non-extensible objects", () => {
+    function add(o) {
+        o.added = true;
+    }
+
+    add({});
+    add({});
+
+    const object = Object.preventExtensions({});
+    add(object);
+    expect(Object.hasOwn(object, "added")).toBeFalse();
+});
+
+test("Inline cache for property store respects frozen objects", () => {
+    function store(o, value) {
+        o.x = value;
+    }
+
+    const object = { x: 1 };
+    store(object, 2);
+    store(object, 3);
+    Object.freeze(object);
+    store(object, 4);
+    expect(object.x).toBe(3);
+});
+
+test("Inline cache for property store on unique shape", () => {
+    let o = {};
+    for (let x = 0; x < 1000; ++x) {
+        o["prop" + x] = x;
+    }
+
+    function store(o, value) {
+        o.prop2 = value;
+    }
+
+    store(o, "a");
+    store(o, "b");
+    expect(o.prop2).toBe("b");
+
+    Object.defineProperty(o, "prop2", { writable: false });
+    store(o, "c");
+    expect(o.prop2).toBe("b");
+});
+
+test("Object literals with repeated keys", () => {
+    for (let i = 0; i < 3; ++i) {
+        const object = { a: 1, b: 2, a: i };
+        expect(Object.keys(object)).toEqual(["a", "b"]);
+        expect(object.a).toBe(i);
+    }
+});
+
+test("Inline cache for property addition is not replayed on arrays", () => {
+    function setLength(o) {
+        o.length = 0;
+    }
+
+    const object = Object.create(Array.prototype);
+    setLength(object);
+    setLength(Object.create(Array.prototype));
+    expect(Object.hasOwn(object, "length")).toBeTrue();
+    expect(object.length).toBe(0);
+
+    const array = [1, 2, 3];
+    setLength(array);
+    expect(array).toEqual([]);
+    expect(array.length).toBe(0);
+    expect(Object.getOwnPropertyNames(array)).toEqual(["length"]);
+
+    array.push(4);
+    expect(array.length).toBe(1);
+    expect(array[0]).toBe(4);
+});
+
+test("Inline cache for property addition is not replayed on proxies", () => {
+    function add(o) {
+        o.added = true;
+    }
+
+    add({});
+    add({});
+
+    const target = {};
+    let trapped = false;
+    const proxy = new Proxy(target, {
+        set(target, key, value) {
+            trapped = true;
+            target[key] = "from trap";
+            return true;
+        },
+    });
+    add(proxy);
+    expect(trapped).toBeTrue();
+    expect(target.added).toBe("from trap");
+
+    const inheritsFromProxy = Object.create(proxy);
+    trapped = false;
+    add(inheritsFromProxy);
+    expect(trapped).toBeTrue();
+    expect(Object.hasOwn(inheritsFromProxy, "added")).toBeFalse();
+});
+
+test("Inline cache for property addition respects frozen objects", () => {
+    function add(o) {
+        "use strict";
+        o.added = true;
+    }
+
+    add({});
+    add({});
+
+    const object = Object.freeze({});
+    expect(() => add(object)).toThrow(TypeError);
+    expect(Object.hasOwn(object, "added")).toBeFalse();
+
+    const nonExtensible = Object.preventExtensions({});
+    expect(() => add(nonExtensible)).toThrow(TypeError);
+    expect(Object.hasOwn(nonExtensible, "added")).toBeFalse();
+});
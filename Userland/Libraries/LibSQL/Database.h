@@ -33,6 +33,11 @@ public:
     ErrorOr<void> commit();
     ErrorOr<size_t> file_size_in_bytes() const { return m_heap->file_size_in_bytes(); }
 
+    // See Heap::set_group_commit().
+    void set_group_commit(bool enabled) { m_heap->set_group_commit(enabled); }
+    bool has_unsynced_commits() const { return m_heap->has_unsynced_commits(); }
+    ErrorOr<void> sync() { return m_heap->sync(); }
+
     ResultOr<void> add_schema(SchemaDef const&);
     static Key get_schema_key(DeprecatedString const&);
     ResultOr<NonnullRefPtr<SchemaDef>> get_schema(DeprecatedString const&);
@@ -8,7 +8,9 @@
 #include <AK/DeprecatedString.h>
 #include <AK/Format.h>
 #include <AK/QuickSort.h>
+#include <AK/Random.h>
 #include <LibCore/System.h>
+#include <LibCrypto/Checksum/CRC32.h>
 #include <LibSQL/Heap.h>
 #include <sys/stat.h>
 
@@ -26,10 +28,14 @@ Heap::Heap(DeprecatedString file_name)
 
 Heap::~Heap()
 {
-    if (m_file && !m_write_ahead_log.is_empty()) {
+    if (m_file && !m_uncommitted_blocks.is_empty()) {
         if (auto maybe_error = flush(); maybe_error.is_error())
             warnln("~Heap({}): {}", name(), maybe_error.error());
     }
+    if (m_write_ahead_log) {
+        if (auto maybe_error = close_write_ahead_log(); maybe_error.is_error())
+            warnln("~Heap({}): {}", name(), maybe_error.error());
+    }
 }
 
 ErrorOr<void> Heap::open()
@@ -37,6 +43,7 @@ ErrorOr<void> Heap::open()
     VERIFY(!m_file);
 
     size_t file_size = 0;
+    bool database_exists = false;
     struct stat stat_buffer;
     if (stat(name().characters(), &stat_buffer) != 0) {
         if (errno != ENOENT) {
@@ -47,19 +54,27 @@ ErrorOr<void> Heap::open()
         warnln("Heap::open({}): can only use regular files"sv, name());
         return Error::from_string_literal("Heap::open(): can only use regular files");
     } else {
-        file_size = stat_buffer.st_size;
+        database_exists = true;
     }
+
+    auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
+    m_file_fd = file->fd();
+    m_file = TRY(Core::InputBufferedFile::create(move(file)));
+
+    // Committed transactions that did not make it into the database file yet are recovered first.
+    TRY(open_write_ahead_log(database_exists));
+
+    if (database_exists)
+        file_size = TRY(Core::System::fstat(m_file_fd)).st_size;
     if (file_size > 0) {
         m_next_block = file_size / Block::SIZE;
         m_highest_block_written = m_next_block - 1;
     }
 
-    auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
-    m_file = TRY(Core::InputBufferedFile::create(move(file)));
-
     if (file_size > 0) {
         if (auto error_maybe = read_zero_block(); error_maybe.is_error()) {
             m_file = nullptr;
+            m_write_ahead_log = nullptr;
             return error_maybe.release_error();
         }
     } else {
@@ -70,8 +85,10 @@ ErrorOr<void> Heap::open()
     if (m_version != VERSION) {
         dbgln_if(SQL_DEBUG, "Heap file {} opened has incompatible version {}. Deleting for version {}.", name(), m_version, VERSION);
         m_file = nullptr;
+        m_write_ahead_log = nullptr;
 
         TRY(Core::System::unlink(name()));
+        TRY(Core::System::unlink(write_ahead_log_name()));
         return open();
     }
 
@@ -91,12 +108,17 @@ ErrorOr<void> Heap::open()
 ErrorOr<size_t> Heap::file_size_in_bytes() const
 {
     TRY(m_file->seek(0, SeekMode::FromEndPosition));
-    return TRY(m_file->tell());
+    auto file_size = TRY(m_file->tell());
+
+    // Blocks that are only in the write-ahead log will end up in the file at the next checkpoint.
+    if (m_write_ahead_log_index.is_empty())
+        return file_size;
+    return max(file_size, (static_cast<size_t>(m_highest_block_written) + 1) * Block::SIZE);
 }
 
 bool Heap::has_block(Block::Index index) const
 {
-    return (index <= m_highest_block_written || m_write_ahead_log.contains(index))
+    return (index <= m_highest_block_written || m_uncommitted_blocks.contains(index))
         && !m_free_block_indices.contains_slow(index);
 }
 
@@ -176,8 +198,10 @@ ErrorOr<ByteBuffer> Heap::read_raw_block(Block::Index index)
     VERIFY(m_file);
     VERIFY(index < m_next_block);
 
-    if (auto wal_entry = m_write_ahead_log.get(index); wal_entry.has_value())
-        return wal_entry.value();
+    if (auto uncommitted_block = m_uncommitted_blocks.get(index); uncommitted_block.has_value())
+        return uncommitted_block.value();
+    if (auto frame_offset = m_write_ahead_log_index.get(index); frame_offset.has_value())
+        return read_block_from_write_ahead_log(frame_offset.value());
 
     TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
     auto buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
@@ -213,13 +237,13 @@ ErrorOr<void> Heap::write_raw_block(Block::Index index, ReadonlyBytes data)
     return {};
 }
 
-ErrorOr<void> Heap::write_raw_block_to_wal(Block::Index index, ByteBuffer&& data)
+ErrorOr<void> Heap::write_uncommitted_block(Block::Index index, ByteBuffer&& data)
 {
     dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
     VERIFY(index < m_next_block);
     VERIFY(data.size() == Block::SIZE);
 
-    TRY(m_write_ahead_log.try_set(index, move(data)));
+    TRY(m_uncommitted_blocks.try_set(index, move(data)));
 
     return {};
 }
@@ -241,7 +265,7 @@ ErrorOr<void> Heap::write_block(Block const& block)
 
     block.data().bytes().copy_to(heap_data.bytes().slice(Block::HEADER_SIZE));
 
-    return write_raw_block_to_wal(block.index(), move(heap_data));
+    return write_uncommitted_block(block.index(), move(heap_data));
 }
 
 ErrorOr<void> Heap::free_storage(Block::Index index)
@@ -267,23 +291,218 @@ ErrorOr<void> Heap::free_block(Block const& block)
 
     // Zero out freed blocks to facilitate a free block scan upon opening the database later
     auto zeroed_data = TRY(ByteBuffer::create_zeroed(Block::SIZE));
-    TRY(write_raw_block_to_wal(index, move(zeroed_data)));
+    TRY(write_uncommitted_block(index, move(zeroed_data)));
 
     return m_free_block_indices.try_append(index);
 }
 
+// Every frame in the write-ahead log consists of this header, followed by the raw block.
+struct WriteAheadLogFrameHeader {
+    u32 salt;
+    Block::Index index;
+    u32 is_commit;
+    u32 checksum;
+};
+
+constexpr static auto WAL_FILE_ID = "SerenitySQL WAL "sv;
+constexpr static auto WAL_SALT_OFFSET = WAL_FILE_ID.length();
+constexpr static u64 WAL_HEADER_SIZE = WAL_SALT_OFFSET + sizeof(u32);
+constexpr static u64 WAL_FRAME_SIZE = sizeof(WriteAheadLogFrameHeader) + Block::SIZE;
+
+// About a megabyte of log before its blocks are copied into the database file.
+constexpr static u64 WAL_CHECKPOINT_THRESHOLD = 1024;
+
+// The checksum of a frame covers all previous frames since the last checkpoint as well, so
+// that recovery stops at the first frame that was only partially written.
+static u32 write_ahead_log_frame_checksum(u32 previous_checksum, WriteAheadLogFrameHeader const& header, ReadonlyBytes block)
+{
+    Crypto::Checksum::CRC32 crc32;
+    crc32.update({ &previous_checksum, sizeof(previous_checksum) });
+    crc32.update({ &header.salt, sizeof(header.salt) });
+    crc32.update({ &header.index, sizeof(header.index) });
+    crc32.update({ &header.is_commit, sizeof(header.is_commit) });
+    crc32.update(block);
+    return crc32.digest();
+}
+
 ErrorOr<void> Heap::flush()
 {
     VERIFY(m_file);
-    auto indices = m_write_ahead_log.keys();
+    VERIFY(m_write_ahead_log);
+    if (m_uncommitted_blocks.is_empty())
+        return {};
+
+    auto indices = m_uncommitted_blocks.keys();
+    quick_sort(indices);
+
+    // All frames of the transaction are appended with a single write, followed by a single sync.
+    auto frames = TRY(ByteBuffer::create_uninitialized(indices.size() * WAL_FRAME_SIZE));
+    auto checksum = m_write_ahead_log_checksum;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        auto& data = m_uncommitted_blocks.get(indices[i]).value();
+        WriteAheadLogFrameHeader header { m_write_ahead_log_salt, indices[i], i == indices.size() - 1, 0 };
+        checksum = write_ahead_log_frame_checksum(checksum, header, data);
+        header.checksum = checksum;
+
+        auto frame = frames.bytes().slice(i * WAL_FRAME_SIZE, WAL_FRAME_SIZE);
+        frame.overwrite(0, &header, sizeof(header));
+        frame.overwrite(sizeof(header), data.data(), data.size());
+    }
+
+    TRY(m_write_ahead_log->seek(m_write_ahead_log_size, SeekMode::SetPosition));
+    TRY(m_write_ahead_log->write_until_depleted(frames));
+    if (m_group_commit)
+        m_has_unsynced_commits = true;
+    else
+        TRY(Core::System::fsync(m_write_ahead_log->fd()));
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        TRY(m_write_ahead_log_index.try_set(indices[i], m_write_ahead_log_size + i * WAL_FRAME_SIZE));
+        if (indices[i] > m_highest_block_written)
+            m_highest_block_written = indices[i];
+    }
+    m_write_ahead_log_size += frames.size();
+    m_write_ahead_log_checksum = checksum;
+    m_uncommitted_blocks.clear();
+    dbgln_if(SQL_DEBUG, "Committed {} blocks; new number of blocks = {}", indices.size(), m_highest_block_written);
+
+    if ((m_write_ahead_log_size - WAL_HEADER_SIZE) / WAL_FRAME_SIZE >= WAL_CHECKPOINT_THRESHOLD)
+        TRY(checkpoint());
+    return {};
+}
+
+ErrorOr<void> Heap::sync()
+{
+    VERIFY(m_write_ahead_log);
+    if (!m_has_unsynced_commits)
+        return {};
+    TRY(Core::System::fsync(m_write_ahead_log->fd()));
+    m_has_unsynced_commits = false;
+    return {};
+}
+
+ErrorOr<void> Heap::checkpoint()
+{
+    VERIFY(m_file);
+    VERIFY(m_write_ahead_log);
+    if (m_write_ahead_log_index.is_empty())
+        return {};
+
+    auto indices = m_write_ahead_log_index.keys();
     quick_sort(indices);
     for (auto index : indices) {
-        dbgln_if(SQL_DEBUG, "Flushing block {}", index);
-        auto& data = m_write_ahead_log.get(index).value();
+        dbgln_if(SQL_DEBUG, "Checkpointing block {}", index);
+        auto data = TRY(read_block_from_write_ahead_log(m_write_ahead_log_index.get(index).value()));
         TRY(write_raw_block(index, data));
     }
-    m_write_ahead_log.clear();
-    dbgln_if(SQL_DEBUG, "WAL flushed; new number of blocks = {}", m_highest_block_written);
+
+    // The log can only be started over once the blocks are safely in the database file.
+    TRY(Core::System::fsync(m_file_fd));
+    TRY(reset_write_ahead_log());
+    m_write_ahead_log_index.clear();
+    m_has_unsynced_commits = false;
+    dbgln_if(SQL_DEBUG, "Checkpointed {} blocks; new number of blocks = {}", indices.size(), m_highest_block_written);
+    return {};
+}
+
+DeprecatedString Heap::write_ahead_log_name() const
+{
+    return DeprecatedString::formatted("{}-wal", name());
+}
+
+ErrorOr<void> Heap::open_write_ahead_log(bool database_exists)
+{
+    VERIFY(!m_write_ahead_log);
+    m_write_ahead_log = TRY(Core::File::open(write_ahead_log_name(), Core::File::OpenMode::ReadWrite));
+    m_write_ahead_log_salt = get_random<u32>();
+
+    // A log without its database file is left over from a database that has since been deleted.
+    if (database_exists)
+        TRY(recover_write_ahead_log());
+
+    if (!m_write_ahead_log_index.is_empty())
+        return checkpoint();
+    return reset_write_ahead_log();
+}
+
+ErrorOr<void> Heap::recover_write_ahead_log()
+{
+    auto log_size = TRY(m_write_ahead_log->seek(0, SeekMode::FromEndPosition));
+    if (log_size < WAL_HEADER_SIZE)
+        return {};
+
+    TRY(m_write_ahead_log->seek(0, SeekMode::SetPosition));
+    auto header = TRY(ByteBuffer::create_uninitialized(WAL_HEADER_SIZE));
+    TRY(m_write_ahead_log->read_until_filled(header));
+    if (StringView(header.bytes().trim(WAL_FILE_ID.length())) != WAL_FILE_ID) {
+        warnln("{}: Ignoring corrupt write-ahead log", name());
+        return {};
+    }
+    memcpy(&m_write_ahead_log_salt, header.offset_pointer(WAL_SALT_OFFSET), sizeof(u32));
+
+    // Frames only become visible once the commit frame of their transaction is read.
+    HashMap<Block::Index, u64> transaction;
+    auto checksum = m_write_ahead_log_salt;
+    u64 offset = WAL_HEADER_SIZE;
+    auto frame = TRY(ByteBuffer::create_uninitialized(WAL_FRAME_SIZE));
+    while (offset + WAL_FRAME_SIZE <= log_size) {
+        TRY(m_write_ahead_log->read_until_filled(frame));
+        WriteAheadLogFrameHeader frame_header;
+        memcpy(&frame_header, frame.data(), sizeof(frame_header));
+        if (frame_header.salt != m_write_ahead_log_salt)
+            break;
+
+        auto expected_checksum = write_ahead_log_frame_checksum(checksum, frame_header, frame.bytes().slice(sizeof(frame_header)));
+        if (frame_header.checksum != expected_checksum)
+            break;
+        checksum = expected_checksum;
+
+        TRY(transaction.try_set(frame_header.index, offset));
+        offset += WAL_FRAME_SIZE;
+
+        if (frame_header.is_commit) {
+            for (auto const& it : transaction)
+                TRY(m_write_ahead_log_index.try_set(it.key, it.value));
+            transaction.clear();
+            m_write_ahead_log_size = offset;
+            m_write_ahead_log_checksum = checksum;
+        }
+    }
+
+    dbgln_if(SQL_DEBUG, "Recovered {} blocks from write-ahead log {}", m_write_ahead_log_index.size(), write_ahead_log_name());
+    return {};
+}
+
+ErrorOr<void> Heap::reset_write_ahead_log()
+{
+    // Changing the salt invalidates all existing frames, so the log does not need to be truncated.
+    ++m_write_ahead_log_salt;
+
+    auto header = TRY(ByteBuffer::create_zeroed(WAL_HEADER_SIZE));
+    header.overwrite(0, WAL_FILE_ID.characters_without_null_termination(), WAL_FILE_ID.length());
+    header.overwrite(WAL_SALT_OFFSET, &m_write_ahead_log_salt, sizeof(u32));
+    TRY(m_write_ahead_log->seek(0, SeekMode::SetPosition));
+    TRY(m_write_ahead_log->write_until_depleted(header));
+    TRY(Core::System::fsync(m_write_ahead_log->fd()));
+
+    m_write_ahead_log_size = WAL_HEADER_SIZE;
+    m_write_ahead_log_checksum = m_write_ahead_log_salt;
+    return {};
+}
+
+ErrorOr<ByteBuffer> Heap::read_block_from_write_ahead_log(u64 frame_offset)
+{
+    TRY(m_write_ahead_log->seek(frame_offset + sizeof(WriteAheadLogFrameHeader), SeekMode::SetPosition));
+    auto buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
+    TRY(m_write_ahead_log->read_until_filled(buffer));
+    return buffer;
+}
+
+ErrorOr<void> Heap::close_write_ahead_log()
+{
+    TRY(checkpoint());
+    m_write_ahead_log = nullptr;
+    TRY(Core::System::unlink(write_ahead_log_name()));
     return {};
 }
 
@@ -347,7 +566,7 @@ ErrorOr<void> Heap::update_zero_block()
     buffer_bytes.overwrite(TABLE_COLUMNS_ROOT_OFFSET, &m_table_columns_root, sizeof(u32));
     buffer_bytes.overwrite(USER_VALUES_OFFSET, m_user_values.data(), m_user_values.size() * sizeof(u32));
 
-    return write_raw_block_to_wal(0, move(buffer));
+    return write_uncommitted_block(0, move(buffer));
 }
 
 ErrorOr<void> Heap::initialize_zero_block()
@@ -63,6 +63,20 @@ private:
  *
  * A Heap can be thought of the backing storage of a single database. It's
  * assumed that a single SQL database is backed by a single Heap.
+ *
+ * Modified blocks are kept in memory until the transaction is committed by
+ * calling flush(). Committing appends them to a write-ahead log next to the
+ * database file (`<name>-wal`) as a series of checksummed frames, the last of
+ * which is marked as the commit frame, and then syncs the log once. Reads look
+ * at uncommitted blocks first, then at the most recent committed frame for the
+ * block in the log, and only then at the database file, so they always see the
+ * last committed state. Every so often (and when the Heap is destroyed), a
+ * checkpoint copies the latest version of every logged block into the database
+ * file and starts the log over.
+ *
+ * When the database is opened, only the frames up to the last intact commit
+ * frame are recovered from the log, so a crash in the middle of a commit never
+ * leaves a partial transaction behind.
  */
 class Heap : public RefCounted<Heap> {
 public:
@@ -119,14 +133,31 @@ public:
     ErrorOr<void> write_storage(Block::Index, ReadonlyBytes);
     ErrorOr<void> free_storage(Block::Index);
 
+    // Commits all modified blocks to the write-ahead log.
     ErrorOr<void> flush();
 
+    // Copies all committed blocks from the write-ahead log into the database file.
+    ErrorOr<void> checkpoint();
+
+    // With group commit enabled, flush() does not sync the write-ahead log by itself. Instead, the
+    // caller is expected to call sync() after a batch of commits, so that they share a single sync.
+    void set_group_commit(bool enabled) { m_group_commit = enabled; }
+    [[nodiscard]] bool has_unsynced_commits() const { return m_has_unsynced_commits; }
+    ErrorOr<void> sync();
+
 private:
     explicit Heap(DeprecatedString);
 
+    DeprecatedString write_ahead_log_name() const;
+    ErrorOr<void> open_write_ahead_log(bool database_exists);
+    ErrorOr<void> recover_write_ahead_log();
+    ErrorOr<void> reset_write_ahead_log();
+    ErrorOr<ByteBuffer> read_block_from_write_ahead_log(u64 frame_offset);
+    ErrorOr<void> close_write_ahead_log();
+
     ErrorOr<ByteBuffer> read_raw_block(Block::Index);
     ErrorOr<void> write_raw_block(Block::Index, ReadonlyBytes);
-    ErrorOr<void> write_raw_block_to_wal(Block::Index, ByteBuffer&&);
+    ErrorOr<void> write_uncommitted_block(Block::Index, ByteBuffer&&);
 
     ErrorOr<Block> read_block(Block::Index);
     ErrorOr<void> write_block(Block const&);
@@ -139,6 +170,7 @@ private:
     DeprecatedString m_name;
 
     OwnPtr<Core::InputBufferedFile> m_file;
+    int m_file_fd { -1 };
     Block::Index m_highest_block_written { 0 };
     Block::Index m_next_block { 1 };
     Block::Index m_schemas_root { 0 };
@@ -146,8 +178,17 @@ private:
     Block::Index m_table_columns_root { 0 };
     u32 m_version { VERSION };
     Array<u32, 16> m_user_values { 0 };
-    HashMap<Block::Index, ByteBuffer> m_write_ahead_log;
+    HashMap<Block::Index, ByteBuffer> m_uncommitted_blocks;
     Vector<Block::Index> m_free_block_indices;
+
+    OwnPtr<Core::File> m_write_ahead_log;
+    u32 m_write_ahead_log_salt { 0 };
+    u32 m_write_ahead_log_checksum { 0 };
+    u64 m_write_ahead_log_size { 0 };
+    // The offset of the most recently committed frame of every block in the write-ahead log.
+    HashMap<Block::Index, u64> m_write_ahead_log_index;
+    bool m_group_commit { false };
+    bool m_has_unsynced_commits { false };
 };
 
 }
@@ -8,6 +8,7 @@
 
 #include <LibCore/ArgsParser.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <signal.h>
 #include <stdio.h>
@@ -92,6 +93,8 @@ int main(int argc, char** argv)
 #endif
     bool print_json = false;
     bool per_file = false;
+    bool disable_bytecode_optimizations = false;
+    bool print_bytecode_pass_statistics = false;
     StringView specified_test_root;
     DeprecatedString common_path;
     DeprecatedString test_glob;
@@ -118,6 +121,9 @@ int main(int argc, char** argv)
     args_parser.add_option(per_file, "Show detailed per-file results as JSON (implies -j)", "per-file", 0);
     args_parser.add_option(g_collect_on_every_allocation, "Collect garbage after every allocation", "collect-often", 'g');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_jit_enabled, "Compile hot bytecode to native code", "jit", 0);
+    args_parser.add_option(disable_bytecode_optimizations, "Disable bytecode optimizations", "disable-bytecode-optimizations", 0);
+    args_parser.add_option(print_bytecode_pass_statistics, "Show how much time the bytecode optimization passes took", "bytecode-pass-statistics", 0);
     args_parser.add_option(test_glob, "Only run tests matching the given glob", "filter", 'f', "glob");
     for (auto& entry : g_extra_args)
         args_parser.add_option(*entry.key, entry.value.get<0>().characters(), entry.value.get<1>().characters(), entry.value.get<2>());
@@ -128,6 +134,8 @@ int main(int argc, char** argv)
     if (per_file)
         print_json = true;
 
+    JS::Bytecode::g_optimize_bytecode = !disable_bytecode_optimizations;
+
     test_glob = DeprecatedString::formatted("*{}*", test_glob);
 
     if (getenv("DISABLE_DBG_OUTPUT")) {
@@ -200,6 +208,9 @@ int main(int argc, char** argv)
     Test::JS::TestRunner test_runner(test_root, common_path, print_times, print_progress, print_json, per_file);
     test_runner.run(test_glob);
 
+    if (print_bytecode_pass_statistics)
+        JS::Bytecode::optimization_pipeline().dump_statistics();
+
     g_vm = nullptr;
 
     return test_runner.counts().tests_failed > 0 ? 1 : 0;
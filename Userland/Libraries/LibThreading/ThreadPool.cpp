@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibThreading/ThreadPool.h>
+#include <unistd.h>
+
+namespace Threading {
+
+ErrorOr<NonnullOwnPtr<ThreadPool>> ThreadPool::create(StringView name, size_t thread_count)
+{
+    thread_count = max<size_t>(thread_count, 1);
+
+    auto pool = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ThreadPool()));
+    TRY(pool->m_threads.try_ensure_capacity(thread_count));
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto thread = TRY(Thread::try_create([&pool = *pool] { return pool.run_worker(); }, name));
+        pool->m_threads.unchecked_append(thread);
+        thread->start();
+    }
+
+    return pool;
+}
+
+size_t ThreadPool::default_thread_count()
+{
+    auto processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+    return processor_count > 0 ? static_cast<size_t>(processor_count) : 1;
+}
+
+ThreadPool::ThreadPool() = default;
+
+ThreadPool::~ThreadPool()
+{
+    m_mutex.lock();
+    m_stop = true;
+    m_work_available.broadcast();
+    m_mutex.unlock();
+
+    for (auto& thread : m_threads)
+        (void)thread->join();
+}
+
+void ThreadPool::submit(Work work)
+{
+    MutexLocker locker(m_mutex);
+    VERIFY(!m_stop);
+    m_queued_work.enqueue(move(work));
+    m_work_available.signal();
+}
+
+void ThreadPool::wait_for_all()
+{
+    MutexLocker locker(m_mutex);
+    while (!m_queued_work.is_empty() || m_running_work_count > 0)
+        m_work_finished.wait();
+}
+
+intptr_t ThreadPool::run_worker()
+{
+    m_mutex.lock();
+    while (true) {
+        if (m_queued_work.is_empty()) {
+            // Work that is still queued is finished before the pool stops.
+            if (m_stop)
+                break;
+            m_work_available.wait();
+            continue;
+        }
+
+        auto work = m_queued_work.dequeue();
+        ++m_running_work_count;
+        m_mutex.unlock();
+
+        work();
+        // Destroy anything the work captured before reporting it as finished.
+        work = nullptr;
+
+        m_mutex.lock();
+        --m_running_work_count;
+        if (m_queued_work.is_empty() && m_running_work_count == 0)
+            m_work_finished.broadcast();
+    }
+    m_mutex.unlock();
+    return 0;
+}
+
+}
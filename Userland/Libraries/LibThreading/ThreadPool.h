@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Queue.h>
+#include <AK/Vector.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// A fixed set of threads that run submitted work in the order it was submitted.
+// Work may run concurrently with other work, so it has to do its own synchronization.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    using Work = Function<void()>;
+
+    static ErrorOr<NonnullOwnPtr<ThreadPool>> create(StringView name, size_t thread_count = default_thread_count());
+
+    // One thread for each online processor.
+    static size_t default_thread_count();
+
+    // Waits for all submitted work to finish before stopping the threads.
+    ~ThreadPool();
+
+    size_t thread_count() const { return m_threads.size(); }
+
+    void submit(Work);
+
+    // Blocks until all submitted work has finished running.
+    void wait_for_all();
+
+private:
+    ThreadPool();
+
+    intptr_t run_worker();
+
+    Vector<NonnullRefPtr<Thread>> m_threads;
+    Mutex m_mutex;
+    ConditionVariable m_work_available { m_mutex };
+    ConditionVariable m_work_finished { m_mutex };
+    Queue<Work> m_queued_work;
+    size_t m_running_work_count { 0 };
+    bool m_stop { false };
+};
+
+}
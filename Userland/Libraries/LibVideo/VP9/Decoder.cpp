@@ -6,6 +6,8 @@
  */
 
 #include <AK/IntegralMath.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/TypedTransfer.h>
 #include <LibGfx/Size.h>
 #include <LibVideo/Color/CodingIndependentCodePoints.h>
@@ -214,6 +216,16 @@ static inline i32 rounded_right_shift(T value, u8 bits)
     return static_cast<i32>(value);
 }
 
+ALWAYS_INLINE static AK::SIMD::i32x4 rounded_right_shift(AK::SIMD::i32x4 value, u8 bits)
+{
+    return (value + (1 << (bits - 1))) >> bits;
+}
+
+// (8.7.1.1) The array S used by the inverse ADST needs 24 + BitDepth bits of precision, and the butterfly rotations need
+// as many before rounding. Vectorized transforms are only used for 8-bit video, where 32-bit lanes are enough.
+template<typename T>
+using HighPrecision = Conditional<IsSame<T, i32>, i64, T>;
+
 u8 Decoder::merge_prob(u8 pre_prob, u32 count_0, u32 count_1, u8 count_sat, u8 max_update_factor)
 {
     auto total_decode_count = count_0 + count_1;
@@ -831,6 +843,79 @@ DecoderErrorOr<void> Decoder::prepare_referenced_frame(Gfx::Size<u32> frame_size
     return {};
 }
 
+// The sub-pixel interpolation filters are applied to the 3 samples before and the 4 samples after each sample position.
+static constexpr auto sample_offset = 3;
+
+// The unscaled sub-pixel interpolation filters produce 4 samples at a time, since blocks are always a multiple of 4 samples wide.
+// Products of 8-bit samples and filter taps fit into 16 bits, so those can be multiplied in 16-bit lanes. Higher bit depths
+// need 32-bit products.
+template<typename ProductVector>
+ALWAYS_INLINE static AK::SIMD::i32x4 apply_subpixel_filter(i16 const (&filter)[8], u16 const* source, size_t tap_stride)
+{
+    AK::SIMD::i32x4 accumulated_samples {};
+    for (auto t = 0u; t < 8; t++) {
+        AK::SIMD::u16x4 samples;
+        memcpy(&samples, source + (t * tap_stride), sizeof(samples));
+        accumulated_samples += __builtin_convertvector(filter[t] * __builtin_convertvector(samples, ProductVector), AK::SIMD::i32x4);
+    }
+    return accumulated_samples;
+}
+
+ALWAYS_INLINE static void store_filtered_samples(u8 bit_depth, u16* destination, AK::SIMD::i32x4 accumulated_samples)
+{
+    // Round2( sum, 7 ), followed by Clip1().
+    auto samples = rounded_right_shift(accumulated_samples, 7);
+    AK::SIMD::i32x4 const minimum {};
+    auto const maximum = AK::SIMD::expand4((1 << bit_depth) - 1);
+    samples = samples < minimum ? minimum : samples;
+    samples = samples > maximum ? maximum : samples;
+
+    auto narrowed_samples = __builtin_convertvector(samples, AK::SIMD::u16x4);
+    memcpy(destination, &narrowed_samples, sizeof(narrowed_samples));
+}
+
+template<typename ProductVector>
+static void convolve_horizontal_unscaled(u8 bit_depth, u16* destination, u32 width, u32 height, u16 const* source, size_t source_stride, i16 const (&filter)[8])
+{
+    source -= sample_offset;
+
+    for (auto row = 0u; row < height; row++) {
+        for (auto column = 0u; column < width; column += 4)
+            store_filtered_samples(bit_depth, destination + column, apply_subpixel_filter<ProductVector>(filter, source + column, 1));
+        source += source_stride;
+        destination += width;
+    }
+}
+
+template<typename ProductVector>
+static void convolve_vertical_unscaled(u8 bit_depth, u16* destination, u32 width, u32 height, u16 const* source, size_t source_stride, i16 const (&filter)[8])
+{
+    for (auto row = 0u; row < height; row++) {
+        for (auto column = 0u; column < width; column += 4)
+            store_filtered_samples(bit_depth, destination + column, apply_subpixel_filter<ProductVector>(filter, source + column, source_stride));
+        source += source_stride;
+        destination += width;
+    }
+}
+
+template<typename ProductVector>
+static void predict_unscaled_block(u8 bit_depth, u16* destination, u32 width, u32 height, u16 const* reference_start, size_t reference_stride, Span<u16> intermediate_buffer, u32 intermediate_height, i16 const (&filter_x)[8], i16 const (&filter_y)[8], bool copy_x, bool copy_y)
+{
+    if (copy_y) {
+        convolve_horizontal_unscaled<ProductVector>(bit_depth, destination, width, height, reference_start, reference_stride, filter_x);
+        return;
+    }
+
+    if (copy_x) {
+        convolve_vertical_unscaled<ProductVector>(bit_depth, destination, width, height, reference_start - (sample_offset * reference_stride), reference_stride, filter_y);
+        return;
+    }
+
+    VERIFY(intermediate_buffer.size() >= static_cast<size_t>(width) * intermediate_height);
+    convolve_horizontal_unscaled<ProductVector>(bit_depth, intermediate_buffer.data(), width, intermediate_height, reference_start - (sample_offset * reference_stride), reference_stride, filter_x);
+    convolve_vertical_unscaled<ProductVector>(bit_depth, destination, width, height, intermediate_buffer.data(), width, filter_y);
+}
+
 DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, BlockContext const& block_context, ReferenceIndex reference_index, u32 block_row, u32 block_column, u32 x, u32 y, u32 width, u32 height, u32 block_index, Span<u16> block_buffer)
 {
     VERIFY(width <= maximum_block_dimensions && height <= maximum_block_dimensions);
@@ -921,8 +1006,6 @@ DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, BlockContext const&
     // filtering is equivalent to a straight sample copy.
     // The filtering is applied as follows:
 
-    constexpr auto sample_offset = 3;
-
     auto subpixel_row_from_reference_row = [offset_scaled_block_y](u32 row) {
         return (offset_scaled_block_y >> SUBPEL_BITS) + static_cast<i32>(row);
     };
@@ -959,14 +1042,7 @@ DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, BlockContext const&
     auto const bit_depth = block_context.frame_context.color_config.bit_depth;
     auto const* reference_start = reference_frame_buffer.data() + reference_block_y * reference_frame_width + reference_block_x;
 
-    // FIXME: We are using 16-bit products to vectorize the filter loops, but when filtering in a high bit-depth video, they will truncate.
-    //        Instead of hardcoding them, we should have the bit depth as a template parameter, and the accumulators can select a size based
-    //        on whether the bit depth > 8.
-    //        Note that we only get a benefit from this on the default CPU target. If we enable AVX2 here, we may want to specialize the
-    //        function for the CPU target and remove the cast to i16 so that it doesn't have to truncate on AVX2, where it can do the full
-    //        unrolled 32-bit product loops in one vector.
-
-    if (unscaled_x && unscaled_y && bit_depth == 8) {
+    if (unscaled_x && unscaled_y) {
         if (copy_x && copy_y) {
             // We can memcpy here to avoid doing any real work.
             auto const* reference_scan_line = &reference_frame_buffer[reference_block_y * reference_frame_width + reference_block_x];
@@ -981,64 +1057,16 @@ DecoderErrorOr<void> Decoder::predict_inter_block(u8 plane, BlockContext const&
             return {};
         }
 
-        auto horizontal_convolution_unscaled = [](auto bit_depth, auto* destination, auto width, auto height, auto const* source, auto source_stride, auto filter, auto subpixel_x) {
-            source -= sample_offset;
-            auto const source_end_skip = source_stride - width;
-
-            for (auto row = 0u; row < height; row++) {
-                for (auto column = 0u; column < width; column++) {
-                    i32 accumulated_samples = 0;
-                    for (auto t = 0; t < 8; t++) {
-                        auto sample = source[t];
-                        accumulated_samples += static_cast<i16>(subpel_filters[filter][subpixel_x][t] * sample);
-                    }
-
-                    *destination = clip_1(bit_depth, rounded_right_shift(accumulated_samples, 7));
-                    source++;
-                    destination++;
-                }
-                source += source_end_skip;
-            }
-        };
-
-        if (copy_y) {
-            horizontal_convolution_unscaled(bit_depth, block_buffer.data(), width, height, reference_start, reference_frame_width, block_context.interpolation_filter, reference_subpixel_x);
-            return {};
-        }
-
-        auto vertical_convolution_unscaled = [](auto bit_depth, auto* destination, auto width, auto height, auto const* source, auto source_stride, auto filter, auto subpixel_y) {
-            auto const source_end_skip = source_stride - width;
-
-            for (auto row = 0u; row < height; row++) {
-                for (auto column = 0u; column < width; column++) {
-                    auto const* scan_column = source;
-                    i32 accumulated_samples = 0;
-                    for (auto t = 0; t < 8; t++) {
-                        auto sample = *scan_column;
-                        accumulated_samples += static_cast<i16>(subpel_filters[filter][subpixel_y][t] * sample);
-                        scan_column += source_stride;
-                    }
-                    *destination = clip_1(bit_depth, rounded_right_shift(accumulated_samples, 7));
-                    source++;
-                    destination++;
-                }
-                source += source_end_skip;
-            }
-        };
-
-        if (copy_x) {
-            vertical_convolution_unscaled(bit_depth, block_buffer.data(), width, height, reference_start - (sample_offset * reference_frame_width), reference_frame_width, block_context.interpolation_filter, reference_subpixel_y);
-            return {};
-        }
-
-        horizontal_convolution_unscaled(bit_depth, intermediate_buffer.data(), width, intermediate_height, reference_start - (sample_offset * reference_frame_width), reference_frame_width, block_context.interpolation_filter, reference_subpixel_x);
-        vertical_convolution_unscaled(bit_depth, block_buffer.data(), width, height, intermediate_buffer.data(), width, block_context.interpolation_filter, reference_subpixel_y);
+        VERIFY(width % 4 == 0);
+        auto const& filter_x = subpel_filters[block_context.interpolation_filter][reference_subpixel_x];
+        auto const& filter_y = subpel_filters[block_context.interpolation_filter][reference_subpixel_y];
+        if (bit_depth == 8)
+            predict_unscaled_block<AK::SIMD::i16x4>(bit_depth, block_buffer.data(), width, height, reference_start, reference_frame_width, intermediate_buffer.span(), intermediate_height, filter_x, filter_y, copy_x, copy_y);
+        else
+            predict_unscaled_block<AK::SIMD::i32x4>(bit_depth, block_buffer.data(), width, height, reference_start, reference_frame_width, intermediate_buffer.span(), intermediate_height, filter_x, filter_y, copy_x, copy_y);
         return {};
     }
 
-    // NOTE: Accumulators below are 32-bit to allow high bit-depth videos to decode without overflows.
-    //       These should be changed when the accumulators above are.
-
     auto horizontal_convolution_scaled = [](auto bit_depth, auto* destination, auto width, auto height, auto const* source, auto source_stride, auto filter, auto subpixel_x, auto scale_x) {
         source -= sample_offset;
 
@@ -1342,14 +1370,17 @@ inline i32 Decoder::sin64(u8 angle)
 }
 
 // (8.7.1.1) The function B( a, b, angle, 0 ) performs a butterfly rotation.
-inline void Decoder::butterfly_rotation_in_place(Span<Intermediate> data, size_t index_a, size_t index_b, u8 angle, bool flip)
+template<typename T>
+inline void Decoder::butterfly_rotation_in_place(Span<T> data, size_t index_a, size_t index_b, u8 angle, bool flip)
 {
     auto cos = cos64(angle);
     auto sin = sin64(angle);
+    HighPrecision<T> a = data[index_a];
+    HighPrecision<T> b = data[index_b];
     // 1. The variable x is set equal to T[ a ] * cos64( angle ) - T[ b ] * sin64( angle ).
-    i64 rotated_a = static_cast<i64>(data[index_a]) * cos - static_cast<i64>(data[index_b]) * sin;
+    HighPrecision<T> rotated_a = a * cos - b * sin;
     // 2. The variable y is set equal to T[ a ] * sin64( angle ) + T[ b ] * cos64( angle ).
-    i64 rotated_b = static_cast<i64>(data[index_a]) * sin + static_cast<i64>(data[index_b]) * cos;
+    HighPrecision<T> rotated_b = a * sin + b * cos;
     // 3. T[ a ] is set equal to Round2( x, 14 ).
     data[index_a] = rounded_right_shift(rotated_a, 14);
     // 4. T[ b ] is set equal to Round2( y, 14 ).
@@ -1368,7 +1399,8 @@ inline void Decoder::butterfly_rotation_in_place(Span<Intermediate> data, size_t
 }
 
 // (8.7.1.1) The function H( a, b, 0 ) performs a Hadamard rotation.
-inline void Decoder::hadamard_rotation_in_place(Span<Intermediate> data, size_t index_a, size_t index_b, bool flip)
+template<typename T>
+inline void Decoder::hadamard_rotation_in_place(Span<T> data, size_t index_a, size_t index_b, bool flip)
 {
     // The function H( a, b, 1 ) performs a Hadamard rotation with flipped indices and is specified as follows:
     // 1. The function H( b, a, 0 ) is invoked.
@@ -1392,8 +1424,8 @@ inline void Decoder::hadamard_rotation_in_place(Span<Intermediate> data, size_t
     // to allow these bounds to be violated. Therefore, we can avoid the performance cost here.
 }
 
-template<u8 log2_of_block_size>
-inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_permutation(Span<Intermediate> data)
+template<u8 log2_of_block_size, typename T>
+inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_permutation(Span<T> data)
 {
     static_assert(log2_of_block_size >= 2 && log2_of_block_size <= 5, "Block size out of range.");
 
@@ -1405,8 +1437,8 @@ inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_per
         return DecoderError::corrupted("Block size was out of range"sv);
 
     // 1.1. A temporary array named copyT is set equal to T.
-    Array<Intermediate, block_size> data_copy;
-    AK::TypedTransfer<Intermediate>::copy(data_copy.data(), data.data(), block_size);
+    Array<T, block_size> data_copy;
+    AK::TypedTransfer<T>::copy(data_copy.data(), data.data(), block_size);
 
     // 1.2. T[ i ] is set equal to copyT[ brev( n, i ) ] for i = 0..((1<<n) - 1).
     for (auto i = 0u; i < block_size; i++)
@@ -1415,8 +1447,8 @@ inline DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform_array_per
     return {};
 }
 
-template<u8 log2_of_block_size>
-ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform(Span<Intermediate> data)
+template<u8 log2_of_block_size, typename T>
+ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform(Span<T> data)
 {
     static_assert(log2_of_block_size >= 2 && log2_of_block_size <= 5, "Block size out of range.");
 
@@ -1516,8 +1548,8 @@ ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_discrete_cosine_transform(Sp
     return {};
 }
 
-template<u8 log2_of_block_size>
-inline void Decoder::inverse_asymmetric_discrete_sine_transform_input_array_permutation(Span<Intermediate> data)
+template<u8 log2_of_block_size, typename T>
+inline void Decoder::inverse_asymmetric_discrete_sine_transform_input_array_permutation(Span<T> data)
 {
     // The variable n0 is set equal to 1<<n.
     constexpr auto block_size = 1u << log2_of_block_size;
@@ -1525,8 +1557,8 @@ inline void Decoder::inverse_asymmetric_discrete_sine_transform_input_array_perm
     // We can iterate by 2 at a time instead of taking half block size.
 
     // A temporary array named copyT is set equal to T.
-    Array<Intermediate, block_size> data_copy;
-    AK::TypedTransfer<Intermediate>::copy(data_copy.data(), data.data(), block_size);
+    Array<T, block_size> data_copy;
+    AK::TypedTransfer<T>::copy(data_copy.data(), data.data(), block_size);
 
     // The values at even locations T[ 2 * i ] are set equal to copyT[ n0 - 1 - 2 * i ] for i = 0..(n1-1).
     // The values at odd locations T[ 2 * i + 1 ] are set equal to copyT[ 2 * i ] for i = 0..(n1-1).
@@ -1536,14 +1568,14 @@ inline void Decoder::inverse_asymmetric_discrete_sine_transform_input_array_perm
     }
 }
 
-template<u8 log2_of_block_size>
-inline void Decoder::inverse_asymmetric_discrete_sine_transform_output_array_permutation(Span<Intermediate> data)
+template<u8 log2_of_block_size, typename T>
+inline void Decoder::inverse_asymmetric_discrete_sine_transform_output_array_permutation(Span<T> data)
 {
     auto block_size = 1u << log2_of_block_size;
 
     // A temporary array named copyT is set equal to T.
-    Array<Intermediate, maximum_transform_size> data_copy;
-    AK::TypedTransfer<Intermediate>::copy(data_copy.data(), data.data(), block_size);
+    Array<T, 16> data_copy;
+    AK::TypedTransfer<T>::copy(data_copy.data(), data.data(), block_size);
 
     // The permutation depends on n as follows:
     if (log2_of_block_size == 4) {
@@ -1567,32 +1599,38 @@ inline void Decoder::inverse_asymmetric_discrete_sine_transform_output_array_per
     }
 }
 
-inline void Decoder::inverse_asymmetric_discrete_sine_transform_4(Span<Intermediate> data)
+template<typename T>
+inline void Decoder::inverse_asymmetric_discrete_sine_transform_4(Span<T> data)
 {
     VERIFY(data.size() == 4);
-    const i64 sinpi_1_9 = 5283;
-    const i64 sinpi_2_9 = 9929;
-    const i64 sinpi_3_9 = 13377;
-    const i64 sinpi_4_9 = 15212;
+    const i32 sinpi_1_9 = 5283;
+    const i32 sinpi_2_9 = 9929;
+    const i32 sinpi_3_9 = 13377;
+    const i32 sinpi_4_9 = 15212;
+
+    HighPrecision<T> t0 = data[0];
+    HighPrecision<T> t1 = data[1];
+    HighPrecision<T> t2 = data[2];
+    HighPrecision<T> t3 = data[3];
 
     // Steps are derived from pseudocode in (8.7.1.6):
     // s0 = SINPI_1_9 * T[ 0 ]
-    i64 s0 = sinpi_1_9 * data[0];
+    HighPrecision<T> s0 = sinpi_1_9 * t0;
     // s1 = SINPI_2_9 * T[ 0 ]
-    i64 s1 = sinpi_2_9 * data[0];
+    HighPrecision<T> s1 = sinpi_2_9 * t0;
     // s2 = SINPI_3_9 * T[ 1 ]
-    i64 s2 = sinpi_3_9 * data[1];
+    HighPrecision<T> s2 = sinpi_3_9 * t1;
     // s3 = SINPI_4_9 * T[ 2 ]
-    i64 s3 = sinpi_4_9 * data[2];
+    HighPrecision<T> s3 = sinpi_4_9 * t2;
     // s4 = SINPI_1_9 * T[ 2 ]
-    i64 s4 = sinpi_1_9 * data[2];
+    HighPrecision<T> s4 = sinpi_1_9 * t2;
     // s5 = SINPI_2_9 * T[ 3 ]
-    i64 s5 = sinpi_2_9 * data[3];
+    HighPrecision<T> s5 = sinpi_2_9 * t3;
     // s6 = SINPI_4_9 * T[ 3 ]
-    i64 s6 = sinpi_4_9 * data[3];
+    HighPrecision<T> s6 = sinpi_4_9 * t3;
     // v = T[ 0 ] - T[ 2 ] + T[ 3 ]
     // s7 = SINPI_3_9 * v
-    i64 s7 = sinpi_3_9 * (data[0] - data[2] + data[3]);
+    HighPrecision<T> s7 = sinpi_3_9 * (t0 - t2 + t3);
 
     // x0 = s0 + s3 + s5
     auto x0 = s0 + s3 + s5;
@@ -1665,7 +1703,8 @@ inline void Decoder::hadamard_rotation(Span<S> source, Span<D> destination, size
     destination[index_b] = rounded_right_shift(a - b, 14);
 }
 
-inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_8(Span<Intermediate> data)
+template<typename T>
+inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_8(Span<T> data)
 {
     VERIFY(data.size() == 8);
     // This process does an in-place transform of the array T using:
@@ -1673,7 +1712,7 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_
     // A higher precision array S for intermediate results.
     // (8.7.1.1) NOTE - The values in array S require higher precision to avoid overflow. Using signed integers with
     // 24 + BitDepth bits of precision is enough to avoid overflow.
-    Array<i64, 8> high_precision_temp;
+    Array<HighPrecision<T>, 8> high_precision_temp;
 
     // The following ordered steps apply:
 
@@ -1716,7 +1755,8 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_
     return {};
 }
 
-inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_16(Span<Intermediate> data)
+template<typename T>
+inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_16(Span<T> data)
 {
     VERIFY(data.size() == 16);
     // This process does an in-place transform of the array T using:
@@ -1725,7 +1765,7 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_
     // (8.7.1.1) The inverse asymmetric discrete sine transforms also make use of an intermediate array named S.
     // The values in this array require higher precision to avoid overflow. Using signed integers with 24 +
     // BitDepth bits of precision is enough to avoid overflow.
-    Array<i64, 16> high_precision_temp;
+    Array<HighPrecision<T>, 16> high_precision_temp;
 
     // The following ordered steps apply:
 
@@ -1783,8 +1823,8 @@ inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform_
     return {};
 }
 
-template<u8 log2_of_block_size>
-inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform(Span<Intermediate> data)
+template<u8 log2_of_block_size, typename T>
+inline DecoderErrorOr<void> Decoder::inverse_asymmetric_discrete_sine_transform(Span<T> data)
 {
     // 8.7.1.9 Inverse ADST Process
 
@@ -1817,6 +1857,9 @@ ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_transform_2d(BlockContext co
     // 1. Set the variable n0 (block_size) equal to 1 << n.
     constexpr auto block_size = 1u << log2_of_block_size;
 
+    if (block_context.frame_context.color_config.bit_depth == 8 && !block_context.frame_context.lossless)
+        return inverse_transform_2d_vectorized<log2_of_block_size>(dequantized, transform_set);
+
     Array<Intermediate, block_size * block_size> row_array;
     Span<Intermediate> row = row_array.span().trim(block_size);
 
@@ -1905,6 +1948,64 @@ ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_transform_2d(BlockContext co
     return {};
 }
 
+template<u8 log2_of_block_size, typename T>
+ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_transform_1d(Span<T> data, TransformType transform_type)
+{
+    switch (transform_type) {
+    case TransformType::DCT:
+        TRY(inverse_discrete_cosine_transform_array_permutation<log2_of_block_size>(data));
+        return inverse_discrete_cosine_transform<log2_of_block_size>(data);
+    case TransformType::ADST:
+        return inverse_asymmetric_discrete_sine_transform<log2_of_block_size>(data);
+    default:
+        return DecoderError::corrupted("Unknown tx_type"sv);
+    }
+}
+
+template<u8 log2_of_block_size>
+ALWAYS_INLINE DecoderErrorOr<void> Decoder::inverse_transform_2d_vectorized(Span<Intermediate> dequantized, TransformSet transform_set)
+{
+    // This is the same process as inverse_transform_2d() for lossy frames, but the lanes of each vector in T hold
+    // 4 consecutive rows or columns of Dequant.
+    using Vector = AK::SIMD::i32x4;
+    constexpr auto lane_count = 4u;
+    constexpr auto block_size = 1u << log2_of_block_size;
+
+    Array<Vector, block_size> transform_array;
+    auto transform = transform_array.span();
+
+    // 2. The row transforms with i = 0..(n0-1) are applied as follows:
+    for (auto i = 0u; i < block_size; i += lane_count) {
+        auto const* rows = &dequantized[i * block_size];
+        for (auto j = 0u; j < block_size; j++)
+            transform[j] = Vector { rows[j], rows[block_size + j], rows[2 * block_size + j], rows[3 * block_size + j] };
+
+        TRY(inverse_transform_1d<log2_of_block_size>(transform, transform_set.second_transform));
+
+        for (auto j = 0u; j < block_size; j++) {
+            for (auto lane = 0u; lane < lane_count; lane++)
+                dequantized[(i + lane) * block_size + j] = transform[j][lane];
+        }
+    }
+
+    // 3. The column transforms with j = 0..(n0-1) are applied as follows:
+    for (auto j = 0u; j < block_size; j += lane_count) {
+        for (auto i = 0u; i < block_size; i++)
+            memcpy(&transform[i], &dequantized[i * block_size + j], sizeof(Vector));
+
+        TRY(inverse_transform_1d<log2_of_block_size>(transform, transform_set.first_transform));
+
+        // 6. Otherwise (Lossless is equal to 0), set Dequant[ i ][ j ] equal to Round2( T[ i ], Min( 6, n + 2 ) )
+        //    for i = 0..(n0-1).
+        for (auto i = 0u; i < block_size; i++) {
+            auto rounded = rounded_right_shift(transform[i], min(6, log2_of_block_size + 2));
+            memcpy(&dequantized[i * block_size + j], &rounded, sizeof(Vector));
+        }
+    }
+
+    return {};
+}
+
 DecoderErrorOr<void> Decoder::update_reference_frames(FrameContext const& frame_context)
 {
     // This process is invoked as the final step in decoding a frame.
@@ -87,6 +87,11 @@ private:
     // (8.7) Inverse transform process
     template<u8 log2_of_block_size>
     DecoderErrorOr<void> inverse_transform_2d(BlockContext const&, Span<Intermediate> dequantized, TransformSet);
+    // Transforms 4 rows or columns at a time, one in each lane of a vector. Only usable for lossy 8-bit frames.
+    template<u8 log2_of_block_size>
+    DecoderErrorOr<void> inverse_transform_2d_vectorized(Span<Intermediate> dequantized, TransformSet);
+    template<u8 log2_of_block_size, typename T>
+    DecoderErrorOr<void> inverse_transform_1d(Span<T> data, TransformType);
 
     // (8.7.1) 1D Transforms
     // (8.7.1.1) Butterfly functions
@@ -94,9 +99,11 @@ private:
     inline i32 cos64(u8 angle);
     inline i32 sin64(u8 angle);
     // The function B( a, b, angle, 0 ) performs a butterfly rotation.
-    inline void butterfly_rotation_in_place(Span<Intermediate> data, size_t index_a, size_t index_b, u8 angle, bool flip);
+    template<typename T>
+    inline void butterfly_rotation_in_place(Span<T> data, size_t index_a, size_t index_b, u8 angle, bool flip);
     // The function H( a, b, 0 ) performs a Hadamard rotation.
-    inline void hadamard_rotation_in_place(Span<Intermediate> data, size_t index_a, size_t index_b, bool flip);
+    template<typename T>
+    inline void hadamard_rotation_in_place(Span<T> data, size_t index_a, size_t index_b, bool flip);
     // The function SB( a, b, angle, 0 ) performs a butterfly rotation.
     // Spec defines the source as array T, and the destination array as S.
     template<typename S, typename D>
@@ -110,32 +117,35 @@ private:
     inline DecoderErrorOr<void> inverse_walsh_hadamard_transform(Span<Intermediate> data, u8 log2_of_block_size, u8 shift);
 
     // (8.7.1.2) Inverse DCT array permutation process
-    template<u8 log2_of_block_size>
-    inline DecoderErrorOr<void> inverse_discrete_cosine_transform_array_permutation(Span<Intermediate> data);
+    template<u8 log2_of_block_size, typename T>
+    inline DecoderErrorOr<void> inverse_discrete_cosine_transform_array_permutation(Span<T> data);
     // (8.7.1.3) Inverse DCT process
-    template<u8 log2_of_block_size>
-    inline DecoderErrorOr<void> inverse_discrete_cosine_transform(Span<Intermediate> data);
+    template<u8 log2_of_block_size, typename T>
+    inline DecoderErrorOr<void> inverse_discrete_cosine_transform(Span<T> data);
 
     // (8.7.1.4) This process performs the in-place permutation of the array T of length 2 n which is required as the first step of
     // the inverse ADST.
-    template<u8 log2_of_block_size>
-    inline void inverse_asymmetric_discrete_sine_transform_input_array_permutation(Span<Intermediate> data);
+    template<u8 log2_of_block_size, typename T>
+    inline void inverse_asymmetric_discrete_sine_transform_input_array_permutation(Span<T> data);
     // (8.7.1.5) This process performs the in-place permutation of the array T of length 2 n which is required before the final
     // step of the inverse ADST.
-    template<u8 log2_of_block_size>
-    inline void inverse_asymmetric_discrete_sine_transform_output_array_permutation(Span<Intermediate> data);
+    template<u8 log2_of_block_size, typename T>
+    inline void inverse_asymmetric_discrete_sine_transform_output_array_permutation(Span<T> data);
 
     // (8.7.1.6) This process does an in-place transform of the array T to perform an inverse ADST.
-    inline void inverse_asymmetric_discrete_sine_transform_4(Span<Intermediate> data);
+    template<typename T>
+    inline void inverse_asymmetric_discrete_sine_transform_4(Span<T> data);
     // (8.7.1.7) This process does an in-place transform of the array T using a higher precision array S for intermediate
     // results.
-    inline DecoderErrorOr<void> inverse_asymmetric_discrete_sine_transform_8(Span<Intermediate> data);
+    template<typename T>
+    inline DecoderErrorOr<void> inverse_asymmetric_discrete_sine_transform_8(Span<T> data);
     // (8.7.1.8) This process does an in-place transform of the array T using a higher precision array S for intermediate
     // results.
-    inline DecoderErrorOr<void> inverse_asymmetric_discrete_sine_transform_16(Span<Intermediate> data);
+    template<typename T>
+    inline DecoderErrorOr<void> inverse_asymmetric_discrete_sine_transform_16(Span<T> data);
     // (8.7.1.9) This process performs an in-place inverse ADST process on the array T of size 2 n for 2 ≤ n ≤ 4.
-    template<u8 log2_of_block_size>
-    inline DecoderErrorOr<void> inverse_asymmetric_discrete_sine_transform(Span<Intermediate> data);
+    template<u8 log2_of_block_size, typename T>
+    inline DecoderErrorOr<void> inverse_asymmetric_discrete_sine_transform(Span<T> data);
 
     /* (8.10) Reference Frame Update Process */
     DecoderErrorOr<void> update_reference_frames(FrameContext const&);
@@ -5,10 +5,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/MemoryStream.h>
 #include <LibGfx/Point.h>
 #include <LibGfx/Size.h>
-#include <LibThreading/WorkerThread.h>
+#include <LibThreading/ThreadPool.h>
 
 #include "Context.h"
 #include "Decoder.h"
@@ -941,40 +942,39 @@ DecoderErrorOr<void> Parser::decode_tiles(FrameContext& frame_context)
     };
 
 #ifdef VP9_TILE_THREADING
-    auto const worker_count = tile_cols - 1;
-
-    if (m_worker_threads.size() < worker_count) {
-        m_worker_threads.clear();
-        m_worker_threads.ensure_capacity(worker_count);
-        for (auto i = 0u; i < worker_count; i++)
-            m_worker_threads.append(DECODER_TRY_ALLOC(Threading::WorkerThread<DecoderError>::create("Decoder Worker"sv)));
-    }
-    VERIFY(m_worker_threads.size() >= worker_count);
-
-    // Start tile column decoding tasks in thread workers starting from the second column.
-    for (auto tile_col = 1u; tile_col < tile_cols; tile_col++) {
-        auto& column_workload = tile_workloads[tile_col];
-        m_worker_threads[tile_col - 1]->start_task([&decode_tile_column, &column_workload]() -> DecoderErrorOr<void> {
-            return decode_tile_column(column_workload);
-        });
+    if (tile_cols > 1 && !m_tile_decoder_pool) {
+        // The thread calling into the decoder decodes tile columns as well, so it doesn't need a worker of its own.
+        auto const worker_count = Threading::ThreadPool::default_thread_count() - 1;
+        if (worker_count > 0)
+            m_tile_decoder_pool = DECODER_TRY_ALLOC(Threading::ThreadPool::create("Decoder Worker"sv, worker_count));
     }
+#endif
 
-    // Decode the first column in this thread.
-    auto result = decode_tile_column(tile_workloads[0]);
-
-    for (auto& worker_thread : m_worker_threads) {
-        auto task_result = worker_thread->wait_until_task_is_finished();
-        if (!result.is_error() && task_result.is_error())
-            result = move(task_result);
+    if (m_tile_decoder_pool && tile_cols > 1) {
+        // Each thread takes the next tile column that hasn't been started yet until there are none left, so that frames with
+        // more tile columns than threads keep all of them busy.
+        Atomic<u32> next_tile_column = 0;
+        Vector<DecoderErrorOr<void>, 4> tile_column_results;
+        DECODER_TRY_ALLOC(tile_column_results.try_resize(tile_cols));
+
+        auto decode_remaining_tile_columns = [&] {
+            for (auto tile_col = next_tile_column++; tile_col < tile_cols; tile_col = next_tile_column++)
+                tile_column_results[tile_col] = decode_tile_column(tile_workloads[tile_col]);
+        };
+
+        auto const worker_count = min<size_t>(tile_cols - 1, m_tile_decoder_pool->thread_count());
+        for (size_t i = 0; i < worker_count; i++)
+            m_tile_decoder_pool->submit([&] { decode_remaining_tile_columns(); });
+        decode_remaining_tile_columns();
+        m_tile_decoder_pool->wait_for_all();
+
+        for (auto& result : tile_column_results)
+            TRY(result);
+    } else {
+        for (auto& column_workloads : tile_workloads)
+            TRY(decode_tile_column(column_workloads));
     }
 
-    if (result.is_error())
-        return result;
-#else
-    for (auto& column_workloads : tile_workloads)
-        TRY(decode_tile_column(column_workloads));
-#endif
-
     // Sum up all tile contexts' syntax element counters after all decodes have finished.
     for (auto& tile_contexts : tile_workloads) {
         for (auto& tile_context : tile_contexts) {
@@ -140,7 +140,8 @@ private:
     OwnPtr<ProbabilityTables> m_probability_tables;
     Decoder& m_decoder;
 
-    Vector<NonnullOwnPtr<Threading::WorkerThread<DecoderError>>> m_worker_threads;
+    // Only created when there is more than one processor to decode tile columns on.
+    OwnPtr<Threading::ThreadPool> m_tile_decoder_pool;
 };
 
 }
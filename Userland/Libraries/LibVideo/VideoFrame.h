@@ -74,6 +74,10 @@ public:
 
     DecoderErrorOr<void> output_to_bitmap(Gfx::Bitmap& bitmap) override;
 
+    ReadonlySpan<u16> plane_y() const { return m_plane_y.span(); }
+    ReadonlySpan<u16> plane_u() const { return m_plane_u.span(); }
+    ReadonlySpan<u16> plane_v() const { return m_plane_v.span(); }
+
 protected:
     bool m_subsampling_horizontal;
     bool m_subsampling_vertical;
@@ -13,6 +13,7 @@
 #include <AK/Result.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/AbstractMachine/CompiledExpression.h>
 #include <LibWasm/Types.h>
 
 // NOTE: Special case for Wasm::Result.
@@ -134,6 +135,13 @@ public:
     template<typename T>
     ALWAYS_INLINE Optional<T> to() const
     {
+        // Fast path for the common case of the value being stored as exactly T (or its signed counterpart).
+        if constexpr (IsOneOf<T, i32, u32, i64, u64, float, double, u128>) {
+            using StorageType = Conditional<IsIntegral<T>, MakeSigned<T>, T>;
+            if (auto* value = m_value.get_pointer<StorageType>())
+                return static_cast<T>(*value);
+        }
+
         Optional<T> result;
         m_value.visit(
             [&](auto value) {
@@ -337,17 +345,20 @@ public:
         : m_type(type)
         , m_module(module)
         , m_code(code)
+        , m_compiled_body(CompiledExpression::compile(code.body(), module.types(), type.results().size()))
     {
     }
 
     auto& type() const { return m_type; }
     auto& module() const { return m_module; }
     auto& code() const { return m_code; }
+    auto& compiled_body() const { return m_compiled_body; }
 
 private:
     FunctionType m_type;
     ModuleInstance const& m_module;
     Module::Function const& m_code;
+    NonnullRefPtr<CompiledExpression const> m_compiled_body;
 };
 
 class HostFunction {
@@ -548,18 +559,22 @@ private:
 
 class Label {
 public:
-    explicit Label(size_t arity, InstructionPointer continuation)
+    explicit Label(size_t arity, InstructionPointer continuation, size_t stack_height)
         : m_arity(arity)
         , m_continuation(continuation)
+        , m_stack_height(stack_height)
     {
     }
 
     auto continuation() const { return m_continuation; }
     auto arity() const { return m_arity; }
+    // The size of the value stack when the label was entered, not counting the parameters of its block.
+    auto stack_height() const { return m_stack_height; }
 
 private:
     size_t m_arity { 0 };
     InstructionPointer m_continuation { 0 };
+    size_t m_stack_height { 0 };
 };
 
 class Frame {
@@ -567,7 +582,15 @@ public:
     explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity)
         : m_module(module)
         , m_locals(move(locals))
-        , m_expression(expression)
+        , m_code(CompiledExpression::compile(expression, module.types(), arity))
+        , m_arity(arity)
+    {
+    }
+
+    explicit Frame(ModuleInstance const& module, Vector<Value> locals, NonnullRefPtr<CompiledExpression const> code, size_t arity)
+        : m_module(module)
+        , m_locals(move(locals))
+        , m_code(move(code))
         , m_arity(arity)
     {
     }
@@ -575,23 +598,29 @@ public:
     auto& module() const { return m_module; }
     auto& locals() const { return m_locals; }
     auto& locals() { return m_locals; }
-    auto& expression() const { return m_expression; }
+    auto& code() const { return *m_code; }
+    auto& expression() const { return m_code->expression(); }
     auto arity() const { return m_arity; }
 
 private:
     ModuleInstance const& m_module;
     Vector<Value> m_locals;
-    Expression const& m_expression;
+    NonnullRefPtr<CompiledExpression const> m_code;
     size_t m_arity { 0 };
 };
 
+// The operand stack; labels and frames are kept on their own stacks by the Configuration.
 class Stack {
 public:
-    using EntryType = Variant<Value, Label, Frame>;
     Stack() = default;
 
     [[nodiscard]] ALWAYS_INLINE bool is_empty() const { return m_data.is_empty(); }
-    ALWAYS_INLINE void push(EntryType entry) { m_data.append(move(entry)); }
+    ALWAYS_INLINE void push(Value value)
+    {
+        if (m_data.size() == m_data.capacity()) [[unlikely]]
+            m_data.ensure_capacity(m_data.size() + 1);
+        m_data.unchecked_append(move(value));
+    }
     ALWAYS_INLINE auto pop() { return m_data.take_last(); }
     ALWAYS_INLINE auto& peek() const { return m_data.last(); }
     ALWAYS_INLINE auto& peek() { return m_data.last(); }
@@ -601,7 +630,7 @@ public:
     ALWAYS_INLINE auto& entries() { return m_data; }
 
 private:
-    Vector<EntryType, 1024> m_data;
+    Vector<Value, 1024> m_data;
 };
 
 using InstantiationResult = AK::Result<NonnullOwnPtr<ModuleInstance>, InstantiationError>;
@@ -36,7 +36,8 @@ namespace Wasm {
         }                                                                                      \
     } while (false)
 
-void BytecodeInterpreter::interpret(Configuration& configuration)
+template<typename InterpretInstruction>
+ALWAYS_INLINE void BytecodeInterpreter::run(Configuration& configuration, InterpretInstruction interpret_instruction)
 {
     m_trap = Empty {};
     auto& instructions = configuration.frame().expression().instructions();
@@ -54,35 +55,45 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
         }
         auto& instruction = instructions[current_ip_value.value()];
         auto old_ip = current_ip_value;
-        interpret(configuration, current_ip_value, instruction);
-        if (did_trap())
+        interpret_instruction(configuration, current_ip_value, instruction);
+        if (!m_trap.has<Empty>())
             return;
         if (current_ip_value == old_ip) // If no jump occurred
             ++current_ip_value;
     }
 }
 
-void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
+void BytecodeInterpreter::interpret(Configuration& configuration)
 {
-    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
-    auto label = configuration.nth_label(index.value());
-    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label->continuation().value(), label->arity());
-    auto results = pop_values(configuration, label->arity());
+    // NOTE: Call the instruction handler non-virtually, this loop is hot enough for the indirection to show up.
+    run(configuration, [this](Configuration& configuration, InstructionPointer& ip, Instruction const& instruction) {
+        BytecodeInterpreter::interpret(configuration, ip, instruction);
+    });
+}
 
-    size_t drop_count = index.value() + 1;
-    for (; !configuration.stack().is_empty();) {
-        auto& entry = configuration.stack().peek();
-        if (entry.has<Label>()) {
-            if (--drop_count == 0)
-                break;
-        }
-        configuration.stack().pop();
-    }
+void BytecodeInterpreter::enter_block(Configuration& configuration, InstructionPointer continuation, size_t arity, size_t parameter_count)
+{
+    auto stack_height = configuration.stack().size() - parameter_count;
+    configuration.label_stack().append(Label(arity, continuation, stack_height));
+}
 
-    for (auto& result : results)
-        configuration.stack().push(move(result));
+void BytecodeInterpreter::branch_to(Configuration& configuration, CompiledExpression::BranchTarget const& target)
+{
+    auto& labels = configuration.label_stack();
+    auto& values = configuration.stack().entries();
+    auto stack_height = labels[labels.size() - target.label_depth - 1].stack_height();
+    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}, which is actually IP {}, and has {} result(s)", target.label_depth, target.continuation.value(), target.arity);
+
+    // Move the results down to where the label was entered, and drop everything that was pushed in between.
+    auto results_start = values.size() - target.arity;
+    if (results_start != stack_height) {
+        for (size_t i = 0; i < target.arity; ++i)
+            values[stack_height + i] = move(values[results_start + i]);
+        values.shrink(stack_height + target.arity, true);
+    }
 
-    configuration.ip() = label->continuation();
+    labels.shrink(labels.size() - target.label_depth - (target.keeps_label ? 0 : 1), true);
+    configuration.ip() = target.continuation;
 }
 
 template<typename ReadType, typename PushType>
@@ -96,7 +107,7 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
     }
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     auto& entry = configuration.stack().peek();
-    auto base = entry.get<Value>().to<i32>();
+    auto base = entry.to<i32>();
     if (!base.has_value()) {
         m_trap = Trap { "Memory access out of bounds" };
         return;
@@ -131,7 +142,7 @@ void BytecodeInterpreter::load_and_push_mxn(Configuration& configuration, Instru
     }
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     auto& entry = configuration.stack().peek();
-    auto base = entry.get<Value>().to<i32>();
+    auto base = entry.to<i32>();
     if (!base.has_value()) {
         m_trap = Trap { "Memory access out of bounds" };
         return;
@@ -169,7 +180,7 @@ void BytecodeInterpreter::load_and_push_m_splat(Configuration& configuration, In
     }
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     auto& entry = configuration.stack().peek();
-    auto base = entry.get<Value>().to<i32>();
+    auto base = entry.to<i32>();
     if (!base.has_value()) {
         m_trap = Trap { "Memory access out of bounds" };
         return;
@@ -222,7 +233,7 @@ void BytecodeInterpreter::pop_and_push_m_splat(Wasm::Configuration& configuratio
     using PopT = Conditional<M <= 32, NativeType<32>, NativeType<64>>;
     using ReadT = NativeType<M>;
     auto entry = configuration.stack().peek();
-    auto value = static_cast<ReadT>(*entry.get<Value>().to<PopT>());
+    auto value = static_cast<ReadT>(*entry.to<PopT>());
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> splat({})", value, M);
     set_top_m_splat<M, NativeType>(configuration, value);
 }
@@ -240,7 +251,7 @@ template<typename M, template<typename> typename SetSign, typename VectorType>
 Optional<VectorType> BytecodeInterpreter::peek_vector(Configuration& configuration)
 {
     auto& entry = configuration.stack().peek();
-    auto value = entry.get<Value>().value().get_pointer<u128>();
+    auto value = entry.value().get_pointer<u128>();
     if (!value)
         return {};
     auto vector = bit_cast<VectorType>(*value);
@@ -248,12 +259,26 @@ Optional<VectorType> BytecodeInterpreter::peek_vector(Configuration& configurati
     return vector;
 }
 
-template<typename VectorType>
-static u128 shuffle_vector(VectorType values, VectorType indices)
+template<typename VectorType, typename PushType>
+void BytecodeInterpreter::pop_vector_and_push_lane(Configuration& configuration, Instruction const& instruction)
+{
+    auto lane = instruction.arguments().get<Instruction::LaneIndex>().lane;
+    auto vector = peek_vector<Operators::VectorElementType<VectorType>, MakeUnsigned, VectorType>(configuration);
+    TRAP_IF_NOT(vector.has_value());
+    configuration.stack().peek() = Value(static_cast<PushType>((*vector)[lane]));
+}
+
+template<typename VectorType, typename PopType>
+void BytecodeInterpreter::pop_and_replace_lane(Configuration& configuration, Instruction const& instruction)
 {
-    auto vector = bit_cast<VectorType>(values);
-    auto indices_vector = bit_cast<VectorType>(indices);
-    return bit_cast<u128>(shuffle(vector, indices_vector));
+    auto lane = instruction.arguments().get<Instruction::LaneIndex>().lane;
+    auto entry = configuration.stack().pop();
+    auto value = entry.to<PopType>();
+    TRAP_IF_NOT(value.has_value());
+    auto vector = peek_vector<Operators::VectorElementType<VectorType>, MakeUnsigned, VectorType>(configuration);
+    TRAP_IF_NOT(vector.has_value());
+    (*vector)[lane] = static_cast<Operators::VectorElementType<VectorType>>(*value);
+    configuration.stack().peek() = Value(bit_cast<u128>(*vector));
 }
 
 void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAddress address)
@@ -263,17 +288,14 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
     auto instance = configuration.store().get(address);
     FunctionType const* type { nullptr };
     instance->visit([&](auto const& function) { type = &function.type(); });
-    TRAP_IF_NOT(configuration.stack().entries().size() > type->parameters().size());
+    TRAP_IF_NOT(configuration.stack().size() >= type->parameters().size());
     Vector<Value> args;
     args.ensure_capacity(type->parameters().size());
     auto span = configuration.stack().entries().span().slice_from_end(type->parameters().size());
-    for (auto& entry : span) {
-        auto* call_argument = entry.get_pointer<Value>();
-        TRAP_IF_NOT(call_argument);
-        args.unchecked_append(move(*call_argument));
-    }
+    for (auto& entry : span)
+        args.unchecked_append(move(entry));
 
-    configuration.stack().entries().remove(configuration.stack().size() - span.size(), span.size());
+    configuration.stack().entries().shrink(configuration.stack().size() - span.size(), true);
 
     Result result { Trap { ""sv } };
     {
@@ -301,10 +323,8 @@ void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration)
 {
     auto rhs_entry = configuration.stack().pop();
     auto& lhs_entry = configuration.stack().peek();
-    auto rhs_ptr = rhs_entry.get_pointer<Value>();
-    auto lhs_ptr = lhs_entry.get_pointer<Value>();
-    auto rhs = rhs_ptr->to<PopTypeRHS>();
-    auto lhs = lhs_ptr->to<PopTypeLHS>();
+    auto rhs = rhs_entry.to<PopTypeRHS>();
+    auto lhs = lhs_entry.to<PopTypeLHS>();
     PushType result;
     auto call_result = Operator {}(lhs.value(), rhs.value());
     if constexpr (IsSpecializationOf<decltype(call_result), AK::Result>) {
@@ -324,8 +344,7 @@ template<typename PopType, typename PushType, typename Operator>
 void BytecodeInterpreter::unary_operation(Configuration& configuration)
 {
     auto& entry = configuration.stack().peek();
-    auto entry_ptr = entry.get_pointer<Value>();
-    auto value = entry_ptr->to<PopType>();
+    auto value = entry.to<PopType>();
     auto call_result = Operator {}(*value);
     PushType result;
     if constexpr (IsSpecializationOf<decltype(call_result), AK::Result>) {
@@ -375,10 +394,10 @@ template<typename PopT, typename StoreT>
 void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instruction const& instruction)
 {
     auto entry = configuration.stack().pop();
-    auto value = ConvertToRaw<StoreT> {}(*entry.get<Value>().to<PopT>());
+    auto value = ConvertToRaw<StoreT> {}(*entry.to<PopT>());
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(StoreT));
     auto base_entry = configuration.stack().pop();
-    auto base = base_entry.get<Value>().to<i32>();
+    auto base = base_entry.to<i32>();
     store_to_memory(configuration, instruction, { &value, sizeof(StoreT) }, *base);
 }
 
@@ -478,21 +497,6 @@ MakeUnsigned<T> BytecodeInterpreter::checked_unsigned_truncate(V value)
     return true;
 }
 
-Vector<Value> BytecodeInterpreter::pop_values(Configuration& configuration, size_t count)
-{
-    Vector<Value> results;
-    results.resize(count);
-
-    for (size_t i = 0; i < count; ++i) {
-        auto top_of_stack = configuration.stack().pop();
-        if (auto value = top_of_stack.get_pointer<Value>())
-            results[i] = move(*value);
-        else
-            TRAP_IF_NOT_NORETURN(value);
-    }
-    return results;
-}
-
 void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Executing instruction {} at ip {}", instruction_name(instruction.opcode()), ip.value());
@@ -508,146 +512,74 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return;
     case Instructions::local_set.value(): {
         auto entry = configuration.stack().pop();
-        configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()] = move(entry.get<Value>());
+        configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()] = move(entry);
         return;
     }
     case Instructions::i32_const.value():
-        configuration.stack().push(Value(ValueType { ValueType::I32 }, static_cast<i64>(instruction.arguments().get<i32>())));
+        configuration.stack().push(Value(instruction.arguments().get<i32>()));
         return;
     case Instructions::i64_const.value():
-        configuration.stack().push(Value(ValueType { ValueType::I64 }, instruction.arguments().get<i64>()));
+        configuration.stack().push(Value(instruction.arguments().get<i64>()));
         return;
     case Instructions::f32_const.value():
-        configuration.stack().push(Value(ValueType { ValueType::F32 }, static_cast<double>(instruction.arguments().get<float>())));
+        configuration.stack().push(Value(instruction.arguments().get<float>()));
         return;
     case Instructions::f64_const.value():
-        configuration.stack().push(Value(ValueType { ValueType::F64 }, instruction.arguments().get<double>()));
+        configuration.stack().push(Value(instruction.arguments().get<double>()));
         return;
     case Instructions::block.value(): {
-        size_t arity = 0;
-        size_t parameter_count = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            parameter_count = type.parameters().size();
-        }
-        }
-
-        configuration.stack().entries().insert(configuration.stack().size() - parameter_count, Label(arity, args.end_ip));
+        auto& details = configuration.frame().code().control_details(ip);
+        enter_block(configuration, details.end_continuation, details.result_count, details.parameter_count);
         return;
     }
     case Instructions::loop.value(): {
-        size_t arity = 0;
-        size_t parameter_count = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            parameter_count = type.parameters().size();
-        }
-        }
-
-        configuration.stack().entries().insert(configuration.stack().size() - parameter_count, Label(arity, ip.value() + 1));
+        auto& details = configuration.frame().code().control_details(ip);
+        enter_block(configuration, ip.value() + 1, details.parameter_count, details.parameter_count);
         return;
     }
     case Instructions::if_.value(): {
-        size_t arity = 0;
-        size_t parameter_count = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            parameter_count = type.parameters().size();
-        }
-        }
-
-        auto entry = configuration.stack().pop();
-        auto value = entry.get<Value>().to<i32>();
-        auto end_label = Label(arity, args.end_ip.value());
-        if (value.value() == 0) {
-            if (args.else_ip.has_value()) {
-                configuration.ip() = args.else_ip.value();
-                configuration.stack().entries().insert(configuration.stack().size() - parameter_count, end_label);
-            } else {
-                configuration.ip() = args.end_ip.value() + 1;
-            }
-        } else {
-            configuration.stack().entries().insert(configuration.stack().size() - parameter_count, end_label);
+        auto& details = configuration.frame().code().control_details(ip);
+        auto value = configuration.stack().pop().to<i32>();
+        if (value.value() != 0) {
+            enter_block(configuration, details.end_continuation, details.result_count, details.parameter_count);
+            return;
         }
+        // An `if` without an `else` is skipped entirely, including its `end`.
+        if (details.else_continuation != details.end_continuation)
+            enter_block(configuration, details.end_continuation, details.result_count, details.parameter_count);
+        configuration.ip() = details.else_continuation;
         return;
     }
     case Instructions::structured_end.value():
-    case Instructions::structured_else.value(): {
-        auto index = configuration.nth_label_index(0);
-        auto label = configuration.stack().entries()[*index].get<Label>();
-        configuration.stack().entries().remove(*index, 1);
-
-        if (instruction.opcode() == Instructions::structured_end)
-            return;
-
-        // Jump to the end label
-        configuration.ip() = label.continuation();
+        configuration.label_stack().take_last();
         return;
-    }
-    case Instructions::return_.value(): {
-        auto& frame = configuration.frame();
-        Checked checked_index { configuration.stack().size() };
-        checked_index -= frame.arity();
-        VERIFY(!checked_index.has_overflow());
-
-        auto index = checked_index.value();
-        size_t i = 1;
-        for (; i <= index; ++i) {
-            auto& entry = configuration.stack().entries()[index - i];
-            if (entry.has<Label>()) {
-                if (configuration.stack().entries()[index - i - 1].has<Frame>())
-                    break;
-            }
-        }
-
-        configuration.stack().entries().remove(index - i + 1, i - 1);
-
-        // Jump past the call/indirect instruction
-        configuration.ip() = configuration.frame().expression().instructions().size();
+    case Instructions::structured_else.value(): {
+        // Reaching the `else` means the `then` branch is done, so leave the block.
+        configuration.label_stack().take_last();
+        configuration.ip() = configuration.frame().code().control_details(ip).end_continuation;
         return;
     }
+    case Instructions::return_.value():
     case Instructions::br.value():
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
+        return branch_to(configuration, configuration.frame().code().control_details(ip).branch);
     case Instructions::br_if.value(): {
         auto entry = configuration.stack().pop();
-        if (entry.get<Value>().to<i32>().value_or(0) == 0)
+        if (entry.to<i32>().value_or(0) == 0)
             return;
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
+        return branch_to(configuration, configuration.frame().code().control_details(ip).branch);
     }
     case Instructions::br_table.value(): {
         auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
+        auto& code = configuration.frame().code();
+        auto& details = code.control_details(ip);
         auto entry = configuration.stack().pop();
-        auto maybe_i = entry.get<Value>().to<i32>();
+        auto maybe_i = entry.to<i32>();
         if (0 <= *maybe_i) {
             size_t i = *maybe_i;
             if (i < arguments.labels.size())
-                return branch_to_label(configuration, arguments.labels[i]);
+                return branch_to(configuration, code.branch_table_target(details, i));
         }
-        return branch_to_label(configuration, arguments.default_);
+        return branch_to(configuration, code.branch_table_target(details, arguments.labels.size()));
     }
     case Instructions::call.value(): {
         auto index = instruction.arguments().get<FunctionIndex>();
@@ -661,7 +593,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto table_address = configuration.frame().module().tables()[args.table.value()];
         auto table_instance = configuration.store().get(table_address);
         auto entry = configuration.stack().pop();
-        auto index = entry.get<Value>().to<i32>();
+        auto index = entry.to<i32>();
         TRAP_IF_NOT(index.value() >= 0);
         TRAP_IF_NOT(static_cast<size_t>(index.value()) < table_instance->elements().size());
         auto element = table_instance->elements()[index.value()];
@@ -720,7 +652,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return pop_and_store<i64, i32>(configuration, instruction);
     case Instructions::local_tee.value(): {
         auto& entry = configuration.stack().peek();
-        auto value = entry.get<Value>();
+        auto value = entry;
         auto local_index = instruction.arguments().get<LocalIndex>();
         dbgln_if(WASM_TRACE_DEBUG, "stack:peek -> locals({})", local_index.value());
         configuration.frame().locals()[local_index.value()] = move(value);
@@ -738,7 +670,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto global_index = instruction.arguments().get<GlobalIndex>();
         auto address = configuration.frame().module().globals()[global_index.value()];
         auto entry = configuration.stack().pop();
-        auto value = entry.get<Value>();
+        auto value = entry;
         dbgln_if(WASM_TRACE_DEBUG, "stack -> global({})", address.value());
         auto global = configuration.store().get(address);
         global->set_value(move(value));
@@ -757,7 +689,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto instance = configuration.store().get(address);
         i32 old_pages = instance->size() / Constants::page_size;
         auto& entry = configuration.stack().peek();
-        auto new_pages = entry.get<Value>().to<i32>();
+        auto new_pages = entry.to<i32>();
         dbgln_if(WASM_TRACE_DEBUG, "memory.grow({}), previously {} pages...", *new_pages, old_pages);
         if (instance->grow(new_pages.value() * Constants::page_size))
             configuration.stack().peek() = Value((i32)old_pages);
@@ -769,9 +701,9 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::memory_fill.value(): {
         auto address = configuration.frame().module().memories()[0];
         auto instance = configuration.store().get(address);
-        auto count = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto value = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
+        auto count = configuration.stack().pop().to<i32>().value();
+        auto value = configuration.stack().pop().to<i32>().value();
+        auto destination_offset = configuration.stack().pop().to<i32>().value();
 
         TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
 
@@ -792,9 +724,9 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::memory_copy.value(): {
         auto address = configuration.frame().module().memories()[0];
         auto instance = configuration.store().get(address);
-        auto count = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto source_offset = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
+        auto count = configuration.stack().pop().to<i32>().value();
+        auto source_offset = configuration.stack().pop().to<i32>().value();
+        auto destination_offset = configuration.stack().pop().to<i32>().value();
 
         TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= instance->data().size());
         TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
@@ -826,9 +758,9 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto data_index = instruction.arguments().get<DataIndex>();
         auto& data_address = configuration.frame().module().datas()[data_index.value()];
         auto& data = *configuration.store().get(data_address);
-        auto count = *configuration.stack().pop().get<Value>().to<i32>();
-        auto source_offset = *configuration.stack().pop().get<Value>().to<i32>();
-        auto destination_offset = *configuration.stack().pop().get<Value>().to<i32>();
+        auto count = *configuration.stack().pop().to<i32>();
+        auto source_offset = *configuration.stack().pop().to<i32>();
+        auto destination_offset = *configuration.stack().pop().to<i32>();
 
         TRAP_IF_NOT(count > 0);
         TRAP_IF_NOT(source_offset + count > 0);
@@ -868,7 +800,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return;
     }
     case Instructions::ref_is_null.value(): {
-        auto top = configuration.stack().peek().get_pointer<Value>();
+        auto top = &configuration.stack().peek();
         TRAP_IF_NOT(top->type().is_reference());
         auto is_null = top->to<Reference::Null>().has_value();
         configuration.stack().peek() = Value(ValueType(ValueType::I32), static_cast<u64>(is_null ? 1 : 0));
@@ -881,12 +813,12 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::select_typed.value(): {
         // Note: The type seems to only be used for validation.
         auto entry = configuration.stack().pop();
-        auto value = entry.get<Value>().to<i32>();
+        auto value = entry.to<i32>();
         dbgln_if(WASM_TRACE_DEBUG, "select({})", value.value());
         auto rhs_entry = configuration.stack().pop();
         auto& lhs_entry = configuration.stack().peek();
-        auto rhs = move(rhs_entry.get<Value>());
-        auto lhs = move(lhs_entry.get<Value>());
+        auto rhs = move(rhs_entry);
+        auto lhs = move(lhs_entry);
         configuration.stack().peek() = value.value() != 0 ? move(lhs) : move(rhs);
         return;
     }
@@ -1187,6 +1119,10 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return load_and_push_m_splat<32>(configuration, instruction);
     case Instructions::v128_load64_splat.value():
         return load_and_push_m_splat<64>(configuration, instruction);
+    case Instructions::v128_load32_zero.value():
+        return load_and_push<u32, u128>(configuration, instruction);
+    case Instructions::v128_load64_zero.value():
+        return load_and_push<u64, u128>(configuration, instruction);
     case Instructions::i8x16_splat.value():
         return pop_and_push_m_splat<8, NativeIntegralType>(configuration, instruction);
     case Instructions::i16x8_splat.value():
@@ -1200,12 +1136,53 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::f64x2_splat.value():
         return pop_and_push_m_splat<64, NativeFloatingType>(configuration, instruction);
     case Instructions::i8x16_shuffle.value(): {
-        auto indices = pop_vector<u8, MakeSigned>(configuration);
-        TRAP_IF_NOT(indices.has_value());
-        auto vector = peek_vector<u8, MakeSigned>(configuration);
-        TRAP_IF_NOT(vector.has_value());
-        auto result = shuffle_vector(vector.value(), indices.value());
-        configuration.stack().peek() = Value(result);
+        auto& arg = instruction.arguments().get<Instruction::ShuffleArgument>();
+        auto high = pop_vector<u8, MakeUnsigned>(configuration);
+        TRAP_IF_NOT(high.has_value());
+        auto low = peek_vector<u8, MakeUnsigned>(configuration);
+        TRAP_IF_NOT(low.has_value());
+        u8x16 result;
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = arg.lanes[i] < 16 ? (*low)[arg.lanes[i]] : (*high)[arg.lanes[i] - 16];
+        configuration.stack().peek() = Value(bit_cast<u128>(result));
+        return;
+    }
+    case Instructions::i8x16_extract_lane_s.value():
+        return pop_vector_and_push_lane<i8x16, i32>(configuration, instruction);
+    case Instructions::i8x16_extract_lane_u.value():
+        return pop_vector_and_push_lane<u8x16, i32>(configuration, instruction);
+    case Instructions::i8x16_replace_lane.value():
+        return pop_and_replace_lane<u8x16, i32>(configuration, instruction);
+    case Instructions::i16x8_extract_lane_s.value():
+        return pop_vector_and_push_lane<i16x8, i32>(configuration, instruction);
+    case Instructions::i16x8_extract_lane_u.value():
+        return pop_vector_and_push_lane<u16x8, i32>(configuration, instruction);
+    case Instructions::i16x8_replace_lane.value():
+        return pop_and_replace_lane<u16x8, i32>(configuration, instruction);
+    case Instructions::i32x4_extract_lane.value():
+        return pop_vector_and_push_lane<i32x4, i32>(configuration, instruction);
+    case Instructions::i32x4_replace_lane.value():
+        return pop_and_replace_lane<i32x4, i32>(configuration, instruction);
+    case Instructions::i64x2_extract_lane.value():
+        return pop_vector_and_push_lane<i64x2, i64>(configuration, instruction);
+    case Instructions::i64x2_replace_lane.value():
+        return pop_and_replace_lane<i64x2, i64>(configuration, instruction);
+    case Instructions::f32x4_extract_lane.value():
+        return pop_vector_and_push_lane<f32x4, float>(configuration, instruction);
+    case Instructions::f32x4_replace_lane.value():
+        return pop_and_replace_lane<f32x4, float>(configuration, instruction);
+    case Instructions::f64x2_extract_lane.value():
+        return pop_vector_and_push_lane<f64x2, double>(configuration, instruction);
+    case Instructions::f64x2_replace_lane.value():
+        return pop_and_replace_lane<f64x2, double>(configuration, instruction);
+    case Instructions::v128_bitselect.value(): {
+        auto mask = pop_vector<u64, MakeUnsigned>(configuration);
+        TRAP_IF_NOT(mask.has_value());
+        auto false_vector = pop_vector<u64, MakeUnsigned>(configuration);
+        TRAP_IF_NOT(false_vector.has_value());
+        auto true_vector = peek_vector<u64, MakeUnsigned>(configuration);
+        TRAP_IF_NOT(true_vector.has_value());
+        configuration.stack().peek() = Value(bit_cast<u128>((*true_vector & *mask) | (*false_vector & ~*mask)));
         return;
     }
     case Instructions::v128_store.value():
@@ -1234,6 +1211,364 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<2, MakeUnsigned>, i32>(configuration);
     case Instructions::i64x2_shr_s.value():
         return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<2, MakeSigned>, i32>(configuration);
+    case Instructions::i8x16_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::Equals>>(configuration);
+    case Instructions::i8x16_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::NotEquals>>(configuration);
+    case Instructions::i8x16_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::LessThan>>(configuration);
+    case Instructions::i8x16_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::LessThan>>(configuration);
+    case Instructions::i8x16_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::GreaterThan>>(configuration);
+    case Instructions::i8x16_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::GreaterThan>>(configuration);
+    case Instructions::i8x16_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i8x16_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i8x16_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i8x16_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i16x8_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::Equals>>(configuration);
+    case Instructions::i16x8_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::NotEquals>>(configuration);
+    case Instructions::i16x8_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::LessThan>>(configuration);
+    case Instructions::i16x8_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::LessThan>>(configuration);
+    case Instructions::i16x8_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::GreaterThan>>(configuration);
+    case Instructions::i16x8_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::GreaterThan>>(configuration);
+    case Instructions::i16x8_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i16x8_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i16x8_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i16x8_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i32x4_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::Equals>>(configuration);
+    case Instructions::i32x4_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::NotEquals>>(configuration);
+    case Instructions::i32x4_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::LessThan>>(configuration);
+    case Instructions::i32x4_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::LessThan>>(configuration);
+    case Instructions::i32x4_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::GreaterThan>>(configuration);
+    case Instructions::i32x4_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::GreaterThan>>(configuration);
+    case Instructions::i32x4_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i32x4_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i32x4_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i32x4_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i64x2_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::Equals>>(configuration);
+    case Instructions::i64x2_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::NotEquals>>(configuration);
+    case Instructions::i64x2_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::LessThan>>(configuration);
+    case Instructions::i64x2_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::GreaterThan>>(configuration);
+    case Instructions::i64x2_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i64x2_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::f32x4_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Equals>>(configuration);
+    case Instructions::f32x4_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::NotEquals>>(configuration);
+    case Instructions::f32x4_lt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LessThan>>(configuration);
+    case Instructions::f32x4_gt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::GreaterThan>>(configuration);
+    case Instructions::f32x4_le.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::f32x4_ge.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::f64x2_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Equals>>(configuration);
+    case Instructions::f64x2_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::NotEquals>>(configuration);
+    case Instructions::f64x2_lt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LessThan>>(configuration);
+    case Instructions::f64x2_gt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::GreaterThan>>(configuration);
+    case Instructions::f64x2_le.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::f64x2_ge.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::v128_not.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitNot>>(configuration);
+    case Instructions::v128_and.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitAnd>>(configuration);
+    case Instructions::v128_andnot.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitAndNot>>(configuration);
+    case Instructions::v128_or.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitOr>>(configuration);
+    case Instructions::v128_xor.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::BitXor>>(configuration);
+    case Instructions::v128_any_true.value():
+        return unary_operation<u128, i32, Operators::VectorOperation<u64x2, Operators::VectorAnyTrue>>(configuration);
+    case Instructions::i8x16_abs.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::VectorAbsolute>>(configuration);
+    case Instructions::i8x16_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::Negate>>(configuration);
+    case Instructions::i8x16_popcnt.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::VectorPopCount>>(configuration);
+    case Instructions::i8x16_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorOperation<u8x16, Operators::VectorAllTrue>>(configuration);
+    case Instructions::i8x16_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorOperation<i8x16, Operators::VectorBitmask>>(configuration);
+    case Instructions::i8x16_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::Add>>(configuration);
+    case Instructions::i8x16_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::Subtract>>(configuration);
+    case Instructions::i8x16_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::SaturatingOperation<Operators::Add>>>(configuration);
+    case Instructions::i8x16_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::SaturatingOperation<Operators::Add>>>(configuration);
+    case Instructions::i8x16_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::SaturatingOperation<Operators::Subtract>>>(configuration);
+    case Instructions::i8x16_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::SaturatingOperation<Operators::Subtract>>>(configuration);
+    case Instructions::i8x16_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::AverageRounded>>(configuration);
+    case Instructions::i8x16_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::VectorMinimum>>(configuration);
+    case Instructions::i8x16_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::VectorMinimum>>(configuration);
+    case Instructions::i8x16_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::VectorMaximum>>(configuration);
+    case Instructions::i8x16_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::VectorMaximum>>(configuration);
+    case Instructions::i8x16_narrow_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::SaturatingNarrow<i8x16>>>(configuration);
+    case Instructions::i8x16_narrow_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::SaturatingNarrow<u8x16>>>(configuration);
+    case Instructions::i8x16_swizzle.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::VectorSwizzle>>(configuration);
+    case Instructions::i16x8_abs.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::VectorAbsolute>>(configuration);
+    case Instructions::i16x8_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::Negate>>(configuration);
+    case Instructions::i16x8_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorOperation<u16x8, Operators::VectorAllTrue>>(configuration);
+    case Instructions::i16x8_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorOperation<i16x8, Operators::VectorBitmask>>(configuration);
+    case Instructions::i16x8_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::Add>>(configuration);
+    case Instructions::i16x8_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::Subtract>>(configuration);
+    case Instructions::i16x8_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::SaturatingOperation<Operators::Add>>>(configuration);
+    case Instructions::i16x8_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::SaturatingOperation<Operators::Add>>>(configuration);
+    case Instructions::i16x8_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::SaturatingOperation<Operators::Subtract>>>(configuration);
+    case Instructions::i16x8_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::SaturatingOperation<Operators::Subtract>>>(configuration);
+    case Instructions::i16x8_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::AverageRounded>>(configuration);
+    case Instructions::i16x8_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::Multiply>>(configuration);
+    case Instructions::i16x8_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::VectorMinimum>>(configuration);
+    case Instructions::i16x8_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::VectorMinimum>>(configuration);
+    case Instructions::i16x8_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::VectorMaximum>>(configuration);
+    case Instructions::i16x8_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::VectorMaximum>>(configuration);
+    case Instructions::i16x8_q15mulr_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::Q15MultiplyRoundSaturating>>(configuration);
+    case Instructions::i16x8_narrow_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::SaturatingNarrow<i16x8>>>(configuration);
+    case Instructions::i16x8_narrow_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::SaturatingNarrow<u16x8>>>(configuration);
+    case Instructions::i16x8_extend_low_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::ExtendHalf<i16x8, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i16x8_extend_low_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::ExtendHalf<u16x8, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i16x8_extend_high_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::ExtendHalf<i16x8, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i16x8_extend_high_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::ExtendHalf<u16x8, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i16x8_extmul_low_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::ExtendMultiply<i16x8, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i16x8_extmul_low_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::ExtendMultiply<u16x8, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i16x8_extmul_high_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::ExtendMultiply<i16x8, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i16x8_extmul_high_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::ExtendMultiply<u16x8, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i16x8_extadd_pairwise_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i8x16, Operators::ExtendAddPairwise<i16x8>>>(configuration);
+    case Instructions::i16x8_extadd_pairwise_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u8x16, Operators::ExtendAddPairwise<u16x8>>>(configuration);
+    case Instructions::i32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::VectorAbsolute>>(configuration);
+    case Instructions::i32x4_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::Negate>>(configuration);
+    case Instructions::i32x4_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorOperation<u32x4, Operators::VectorAllTrue>>(configuration);
+    case Instructions::i32x4_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorOperation<i32x4, Operators::VectorBitmask>>(configuration);
+    case Instructions::i32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::Add>>(configuration);
+    case Instructions::i32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::Subtract>>(configuration);
+    case Instructions::i32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::Multiply>>(configuration);
+    case Instructions::i32x4_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::VectorMinimum>>(configuration);
+    case Instructions::i32x4_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::VectorMinimum>>(configuration);
+    case Instructions::i32x4_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::VectorMaximum>>(configuration);
+    case Instructions::i32x4_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::VectorMaximum>>(configuration);
+    case Instructions::i32x4_dot_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::DotProduct>>(configuration);
+    case Instructions::i32x4_extend_low_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::ExtendHalf<i32x4, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i32x4_extend_low_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::ExtendHalf<u32x4, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i32x4_extend_high_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::ExtendHalf<i32x4, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i32x4_extend_high_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::ExtendHalf<u32x4, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i32x4_extmul_low_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::ExtendMultiply<i32x4, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i32x4_extmul_low_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::ExtendMultiply<u32x4, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i32x4_extmul_high_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::ExtendMultiply<i32x4, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i32x4_extmul_high_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::ExtendMultiply<u32x4, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i32x4_extadd_pairwise_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i16x8, Operators::ExtendAddPairwise<i32x4>>>(configuration);
+    case Instructions::i32x4_extadd_pairwise_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u16x8, Operators::ExtendAddPairwise<u32x4>>>(configuration);
+    case Instructions::i64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i64x2, Operators::VectorAbsolute>>(configuration);
+    case Instructions::i64x2_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::Negate>>(configuration);
+    case Instructions::i64x2_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorOperation<u64x2, Operators::VectorAllTrue>>(configuration);
+    case Instructions::i64x2_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorOperation<i64x2, Operators::VectorBitmask>>(configuration);
+    case Instructions::i64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::Add>>(configuration);
+    case Instructions::i64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::Subtract>>(configuration);
+    case Instructions::i64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64x2, Operators::Multiply>>(configuration);
+    case Instructions::i64x2_extend_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::ExtendHalf<i64x2, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i64x2_extend_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::ExtendHalf<u64x2, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i64x2_extend_high_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::ExtendHalf<i64x2, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i64x2_extend_high_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::ExtendHalf<u64x2, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i64x2_extmul_low_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::ExtendMultiply<i64x2, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i64x2_extmul_low_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::ExtendMultiply<u64x2, Operators::VectorHalf::Low>>>(configuration);
+    case Instructions::i64x2_extmul_high_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::ExtendMultiply<i64x2, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::i64x2_extmul_high_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::ExtendMultiply<u64x2, Operators::VectorHalf::High>>>(configuration);
+    case Instructions::f32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::VectorAbsolute>>(configuration);
+    case Instructions::f32x4_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Negate>>(configuration);
+    case Instructions::f32x4_sqrt.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LaneWise<Operators::SquareRoot>>>(configuration);
+    case Instructions::f32x4_ceil.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LaneWise<Operators::Ceil>>>(configuration);
+    case Instructions::f32x4_floor.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LaneWise<Operators::Floor>>>(configuration);
+    case Instructions::f32x4_trunc.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LaneWise<Operators::Truncate>>>(configuration);
+    case Instructions::f32x4_nearest.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LaneWise<Operators::NearbyIntegral>>>(configuration);
+    case Instructions::f32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Add>>(configuration);
+    case Instructions::f32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Subtract>>(configuration);
+    case Instructions::f32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::Multiply>>(configuration);
+    case Instructions::f32x4_div.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::VectorDivide>>(configuration);
+    case Instructions::f32x4_min.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LaneWise<Operators::Minimum>>>(configuration);
+    case Instructions::f32x4_max.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LaneWise<Operators::Maximum>>>(configuration);
+    case Instructions::f32x4_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::PseudoMinimum>>(configuration);
+    case Instructions::f32x4_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::PseudoMaximum>>(configuration);
+    case Instructions::f64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::VectorAbsolute>>(configuration);
+    case Instructions::f64x2_neg.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Negate>>(configuration);
+    case Instructions::f64x2_sqrt.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LaneWise<Operators::SquareRoot>>>(configuration);
+    case Instructions::f64x2_ceil.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LaneWise<Operators::Ceil>>>(configuration);
+    case Instructions::f64x2_floor.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LaneWise<Operators::Floor>>>(configuration);
+    case Instructions::f64x2_trunc.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LaneWise<Operators::Truncate>>>(configuration);
+    case Instructions::f64x2_nearest.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LaneWise<Operators::NearbyIntegral>>>(configuration);
+    case Instructions::f64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Add>>(configuration);
+    case Instructions::f64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Subtract>>(configuration);
+    case Instructions::f64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::Multiply>>(configuration);
+    case Instructions::f64x2_div.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::VectorDivide>>(configuration);
+    case Instructions::f64x2_min.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LaneWise<Operators::Minimum>>>(configuration);
+    case Instructions::f64x2_max.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LaneWise<Operators::Maximum>>>(configuration);
+    case Instructions::f64x2_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::PseudoMinimum>>(configuration);
+    case Instructions::f64x2_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::PseudoMaximum>>(configuration);
+    case Instructions::i32x4_trunc_sat_f32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LaneWise<Operators::SaturatingTruncate<i32>, i32x4>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::LaneWise<Operators::SaturatingTruncate<u32>, u32x4>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f64x2_s_zero.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LaneWise<Operators::SaturatingTruncate<i32>, i32x4>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f64x2_u_zero.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::LaneWise<Operators::SaturatingTruncate<u32>, u32x4>>>(configuration);
+    case Instructions::f32x4_convert_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::VectorConvert<f32x4>>>(configuration);
+    case Instructions::f32x4_convert_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::VectorConvert<f32x4>>>(configuration);
+    case Instructions::f64x2_convert_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<i32x4, Operators::VectorConvert<f64x2>>>(configuration);
+    case Instructions::f64x2_convert_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<u32x4, Operators::VectorConvert<f64x2>>>(configuration);
+    case Instructions::f32x4_demote_f64x2_zero.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f64x2, Operators::VectorConvert<f32x4>>>(configuration);
+    case Instructions::f64x2_promote_low_f32x4.value():
+        return unary_operation<u128, u128, Operators::VectorOperation<f32x4, Operators::VectorConvert<f64x2>>>(configuration);
     case Instructions::table_init.value():
     case Instructions::elem_drop.value():
     case Instructions::table_copy.value():
@@ -1248,6 +1583,13 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     }
 }
 
+void DebuggerBytecodeInterpreter::interpret(Configuration& configuration)
+{
+    run(configuration, [this](Configuration& configuration, InstructionPointer& ip, Instruction const& instruction) {
+        interpret(configuration, ip, instruction);
+    });
+}
+
 void DebuggerBytecodeInterpreter::interpret(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     if (pre_interpret_hook) {
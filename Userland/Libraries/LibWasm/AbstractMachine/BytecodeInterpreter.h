@@ -44,8 +44,11 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    template<typename InterpretInstruction>
+    void run(Configuration&, InterpretInstruction);
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&);
-    void branch_to_label(Configuration&, LabelIndex);
+    void enter_block(Configuration&, InstructionPointer continuation, size_t arity, size_t parameter_count);
+    void branch_to(Configuration&, CompiledExpression::BranchTarget const&);
     template<typename ReadT, typename PushT>
     void load_and_push(Configuration&, Instruction const&);
     template<typename PopT, typename StoreT>
@@ -62,6 +65,10 @@ protected:
     Optional<VectorType> pop_vector(Configuration&);
     template<typename M, template<typename> typename SetSign, typename VectorType = Native128ByteVectorOf<M, SetSign>>
     Optional<VectorType> peek_vector(Configuration&);
+    template<typename VectorType, typename PushType>
+    void pop_vector_and_push_lane(Configuration&, Instruction const&);
+    template<typename VectorType, typename PopType>
+    void pop_and_replace_lane(Configuration&, Instruction const&);
     void store_to_memory(Configuration&, Instruction const&, ReadonlyBytes data, i32 base);
     void call_address(Configuration&, FunctionAddress);
 
@@ -80,7 +87,6 @@ protected:
     template<typename T>
     T read_value(ReadonlyBytes data);
 
-    Vector<Value> pop_values(Configuration& configuration, size_t count);
     ALWAYS_INLINE bool trap_if_not(bool value, StringView reason)
     {
         if (!value)
@@ -102,6 +108,8 @@ struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
     Function<bool(Configuration&, InstructionPointer&, Instruction const&)> pre_interpret_hook;
     Function<bool(Configuration&, InstructionPointer&, Instruction const&, Interpreter const&)> post_interpret_hook;
 
+    virtual void interpret(Configuration&) override;
+
 private:
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&) override;
 };
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWasm/AbstractMachine/CompiledExpression.h>
+#include <LibWasm/Opcode.h>
+
+namespace Wasm {
+
+NonnullRefPtr<CompiledExpression> CompiledExpression::compile(Expression const& expression, Vector<FunctionType> const& types, size_t arity)
+{
+    auto compiled_expression = adopt_ref(*new CompiledExpression(expression));
+    compiled_expression->resolve_structured_instructions(types);
+    compiled_expression->resolve_branches(arity);
+    return compiled_expression;
+}
+
+void CompiledExpression::resolve_structured_instructions(Vector<FunctionType> const& types)
+{
+    auto& instructions = m_expression.instructions();
+    m_control_details_index.resize(instructions.size());
+    // NOTE: Instructions that have nothing to resolve all share the first entry.
+    m_control_details.append({});
+
+    struct OpenBlock {
+        size_t details_index { 0 };
+        Optional<size_t> else_details_index;
+    };
+    Vector<OpenBlock, 8> open_blocks;
+
+    for (size_t ip = 0; ip < instructions.size(); ++ip) {
+        auto& instruction = instructions[ip];
+        switch (instruction.opcode().value()) {
+        case Instructions::block.value():
+        case Instructions::loop.value():
+        case Instructions::if_.value(): {
+            ControlDetails details;
+            auto& block_type = instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type;
+            switch (block_type.kind()) {
+            case BlockType::Empty:
+                break;
+            case BlockType::Type:
+                details.result_count = 1;
+                break;
+            case BlockType::Index: {
+                auto& type = types[block_type.type_index().value()];
+                details.parameter_count = type.parameters().size();
+                details.result_count = type.results().size();
+                break;
+            }
+            }
+            m_control_details_index[ip] = m_control_details.size();
+            open_blocks.append({ m_control_details.size(), {} });
+            m_control_details.append(details);
+            break;
+        }
+        case Instructions::structured_else.value(): {
+            VERIFY(!open_blocks.is_empty());
+            auto& block = open_blocks.last();
+            m_control_details[block.details_index].else_continuation = InstructionPointer { ip + 1 };
+            block.else_details_index = m_control_details.size();
+            m_control_details_index[ip] = m_control_details.size();
+            m_control_details.append({});
+            break;
+        }
+        case Instructions::structured_end.value(): {
+            VERIFY(!open_blocks.is_empty());
+            auto block = open_blocks.take_last();
+            auto& details = m_control_details[block.details_index];
+            details.end_continuation = InstructionPointer { ip + 1 };
+            // An `if` without an `else` skips its `end` entirely when the condition is false, as it never entered the block.
+            if (block.else_details_index.has_value())
+                m_control_details[*block.else_details_index].end_continuation = details.end_continuation;
+            else
+                details.else_continuation = details.end_continuation;
+            break;
+        }
+        case Instructions::br.value():
+        case Instructions::br_if.value():
+        case Instructions::br_table.value():
+        case Instructions::return_.value():
+            m_control_details_index[ip] = m_control_details.size();
+            m_control_details.append({});
+            break;
+        default:
+            break;
+        }
+    }
+    VERIFY(open_blocks.is_empty());
+}
+
+void CompiledExpression::resolve_branches(size_t arity)
+{
+    auto& instructions = m_expression.instructions();
+
+    struct EnclosingBlock {
+        size_t ip { 0 };
+        bool is_loop { false };
+    };
+    Vector<EnclosingBlock, 8> enclosing_blocks;
+
+    auto resolve = [&](size_t label_depth) -> BranchTarget {
+        // The outermost label belongs to the expression itself, branching to it returns from the function.
+        if (label_depth == enclosing_blocks.size())
+            return { InstructionPointer { instructions.size() }, static_cast<u32>(arity), static_cast<u32>(label_depth), true };
+
+        VERIFY(label_depth < enclosing_blocks.size());
+        auto& block = enclosing_blocks[enclosing_blocks.size() - label_depth - 1];
+        auto& details = control_details(InstructionPointer { block.ip });
+        if (block.is_loop)
+            return { InstructionPointer { block.ip + 1 }, details.parameter_count, static_cast<u32>(label_depth), true };
+        return { details.end_continuation, details.result_count, static_cast<u32>(label_depth), false };
+    };
+
+    for (size_t ip = 0; ip < instructions.size(); ++ip) {
+        auto& instruction = instructions[ip];
+        auto& details = m_control_details[m_control_details_index[ip]];
+        switch (instruction.opcode().value()) {
+        case Instructions::block.value():
+        case Instructions::if_.value():
+            enclosing_blocks.append({ ip, false });
+            break;
+        case Instructions::loop.value():
+            enclosing_blocks.append({ ip, true });
+            break;
+        case Instructions::structured_end.value():
+            enclosing_blocks.take_last();
+            break;
+        case Instructions::br.value():
+        case Instructions::br_if.value():
+            details.branch = resolve(instruction.arguments().get<LabelIndex>().value());
+            break;
+        case Instructions::br_table.value(): {
+            auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
+            details.first_branch_table_target = m_branch_table_targets.size();
+            m_branch_table_targets.ensure_capacity(m_branch_table_targets.size() + arguments.labels.size() + 1);
+            for (auto& label : arguments.labels)
+                m_branch_table_targets.unchecked_append(resolve(label.value()));
+            m_branch_table_targets.unchecked_append(resolve(arguments.default_.value()));
+            break;
+        }
+        case Instructions::return_.value():
+            details.branch = resolve(enclosing_blocks.size());
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// An expression lowered ahead of execution.
+// Every structured instruction knows how many values it takes and where it continues, and every branch knows where it
+// goes and how many values it carries along, so the interpreter never has to search the stack or the code for a label.
+class CompiledExpression : public RefCounted<CompiledExpression> {
+public:
+    struct BranchTarget {
+        InstructionPointer continuation { 0 };
+        u32 arity { 0 };
+        // The index of the target label, counted from the innermost label.
+        u32 label_depth { 0 };
+        // Branching to a loop (or to the function body itself) leaves its label in place.
+        bool keeps_label { false };
+    };
+
+    struct ControlDetails {
+        // block, loop, if: the number of values taken from and left on the stack.
+        u32 parameter_count { 0 };
+        u32 result_count { 0 };
+        // block, loop, if, else: where execution continues after the matching `end`.
+        InstructionPointer end_continuation { 0 };
+        // if: where execution continues when the condition is false.
+        InstructionPointer else_continuation { 0 };
+        // br, br_if, return: where the branch goes.
+        BranchTarget branch;
+        // br_table: the index of the first of its targets in branch_table_targets(), the default target comes last.
+        size_t first_branch_table_target { 0 };
+    };
+
+    static NonnullRefPtr<CompiledExpression> compile(Expression const&, Vector<FunctionType> const& types, size_t arity);
+
+    auto& expression() const { return m_expression; }
+    auto& instructions() const { return m_expression.instructions(); }
+
+    ALWAYS_INLINE ControlDetails const& control_details(InstructionPointer ip) const { return m_control_details[m_control_details_index[ip.value()]]; }
+    ALWAYS_INLINE BranchTarget const& branch_table_target(ControlDetails const& details, size_t index) const { return m_branch_table_targets[details.first_branch_table_target + index]; }
+
+private:
+    explicit CompiledExpression(Expression const& expression)
+        : m_expression(expression)
+    {
+    }
+
+    void resolve_structured_instructions(Vector<FunctionType> const& types);
+    void resolve_branches(size_t arity);
+
+    Expression const& m_expression;
+    Vector<u32> m_control_details_index;
+    Vector<ControlDetails> m_control_details;
+    Vector<BranchTarget> m_branch_table_targets;
+};
+
+}
@@ -11,30 +11,17 @@
 
 namespace Wasm {
 
-Optional<size_t> Configuration::nth_label_index(size_t i)
-{
-    for (size_t index = m_stack.size(); index > 0; --index) {
-        auto& entry = m_stack.entries()[index - 1];
-        if (entry.has<Label>()) {
-            if (i == 0)
-                return index - 1;
-            --i;
-        }
-    }
-    return {};
-}
-
 void Configuration::unwind(Badge<CallFrameHandle>, CallFrameHandle const& frame_handle)
 {
-    if (m_stack.size() == frame_handle.stack_size && frame_handle.frame_index == m_current_frame_index)
-        return;
-
-    VERIFY(m_stack.size() > frame_handle.stack_size);
-    m_stack.entries().remove(frame_handle.stack_size, m_stack.size() - frame_handle.stack_size);
-    m_current_frame_index = frame_handle.frame_index;
     m_depth--;
     m_ip = frame_handle.ip;
-    VERIFY(m_stack.size() == frame_handle.stack_size);
+
+    VERIFY(m_stack.size() >= frame_handle.stack_size);
+    VERIFY(m_label_stack.size() >= frame_handle.label_stack_size);
+    VERIFY(m_frame_stack.size() >= frame_handle.frame_stack_size);
+    m_stack.entries().shrink(frame_handle.stack_size, true);
+    m_label_stack.shrink(frame_handle.label_stack_size, true);
+    m_frame_stack.shrink(frame_handle.frame_stack_size, true);
 }
 
 Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Vector<Value> arguments)
@@ -51,7 +38,7 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
         set_frame(Frame {
             wasm_function->module(),
             move(locals),
-            wasm_function->code().body(),
+            wasm_function->compiled_body(),
             wasm_function->type().results().size(),
         });
         m_ip = 0;
@@ -69,17 +56,15 @@ Result Configuration::execute(Interpreter& interpreter)
     if (interpreter.did_trap())
         return Trap { interpreter.trap_reason() };
 
-    if (stack().size() <= frame().arity() + 1)
+    // ASSERT: The only label left is the one belonging to the current frame.
+    auto label = m_label_stack.take_last();
+    if (stack().size() < label.stack_height() + frame().arity())
         return Trap { "Not enough values to return from call" };
 
     Vector<Value> results;
     results.ensure_capacity(frame().arity());
     for (size_t i = 0; i < frame().arity(); ++i)
-        results.append(move(stack().pop().get<Value>()));
-    auto label = stack().pop();
-    // ASSERT: label == current frame
-    if (!label.has<Label>())
-        return Trap { "Invalid stack configuration" };
+        results.append(stack().pop());
     return Result { move(results) };
 }
 
@@ -92,21 +77,27 @@ void Configuration::dump_stack()
         memory_stream.read_until_filled(buffer).release_value_but_fixme_should_propagate_errors();
         dbgln(format.view(), StringView(buffer).trim_whitespace());
     };
-    for (auto const& entry : stack().entries()) {
-        entry.visit(
-            [&](Value const& v) {
-                print_value("    {}", v);
-            },
-            [&](Frame const& f) {
-                dbgln("    frame({})", f.arity());
-                for (auto& local : f.locals()) {
+    // Frames, labels and values live on separate stacks, interleave them again by the stack heights they were entered at.
+    size_t label_index = 0;
+    size_t frame_index = 0;
+    auto print_labels_and_frames_up_to = [&](size_t stack_height) {
+        for (; label_index < m_label_stack.size() && m_label_stack[label_index].stack_height() <= stack_height; ++label_index) {
+            auto& label = m_label_stack[label_index];
+            // Each frame is entered together with its own label, which is the one that ends at the end of its expression.
+            if (frame_index < m_frame_stack.size() && label.continuation() == m_frame_stack[frame_index].expression().instructions().size() && label.arity() == m_frame_stack[frame_index].arity()) {
+                auto& frame = m_frame_stack[frame_index++];
+                dbgln("    frame({})", frame.arity());
+                for (auto& local : frame.locals())
                     print_value("        {}", local);
-                }
-            },
-            [](Label const& l) {
-                dbgln("    label({}) -> {}", l.arity(), l.continuation());
-            });
+            }
+            dbgln("    label({}) -> {}", label.arity(), label.continuation());
+        }
+    };
+    for (size_t i = 0; i < stack().size(); ++i) {
+        print_labels_and_frames_up_to(i);
+        print_value("    {}", stack().entries()[i]);
     }
+    print_labels_and_frames_up_to(stack().size());
 }
 
 }
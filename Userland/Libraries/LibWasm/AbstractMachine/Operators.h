@@ -10,6 +10,7 @@
 #include <AK/BuiltinWrappers.h>
 #include <AK/Result.h>
 #include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <limits.h>
@@ -153,7 +154,7 @@ struct VectorShiftRight {
     auto operator()(u128 lhs, i32 rhs) const
     {
         auto shift_value = rhs % (sizeof(lhs) * 8 / VectorSize);
-        return bit_cast<u128>(bit_cast<Native128ByteVectorOf<NativeIntegralType<128 / VectorSize>, SetSign>>(lhs) >> shift_value);
+        return bit_cast<u128>(bit_cast<Native128ByteVectorOf<SetSign<NativeIntegralType<128 / VectorSize>>, SetSign>>(lhs) >> shift_value);
     }
     static StringView name()
     {
@@ -522,4 +523,362 @@ struct SaturatingTruncate {
     static StringView name() { return "truncate.saturating"sv; }
 };
 
+// Vector
+// These work on whole v128 values reinterpreted as AK::SIMD vector types, so that each of them compiles down to a
+// handful of host vector instructions. Lane-wise comparisons yield lanes with either all or none of their bits set,
+// which is exactly what the Wasm comparison instructions produce.
+
+template<typename VectorType>
+using VectorElementType = RemoveCVReference<decltype(declval<VectorType>()[0])>;
+
+template<typename VectorType>
+constexpr unsigned vector_lane_count = sizeof(VectorType) / sizeof(VectorElementType<VectorType>);
+
+// A vector with as many lanes as VectorType, each of them twice as wide.
+template<typename VectorType, template<typename> typename SetSign = MakeSigned>
+using WidenedVectorOf = NativeVectorType<sizeof(VectorElementType<VectorType>) * 16, vector_lane_count<VectorType>, SetSign>;
+
+// The Count lanes of `vector` starting at lane Offset, Stride lanes apart.
+template<unsigned Offset, unsigned Count, unsigned Stride = 1, typename VectorType>
+ALWAYS_INLINE static auto vector_lanes(VectorType vector)
+{
+    return [&]<unsigned... Indices>(IntegerSequence<unsigned, Indices...>) {
+        return __builtin_shufflevector(vector, vector, (Offset + Indices * Stride)...);
+    }(MakeIndexSequence<Count>());
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static auto vector_concat(VectorType low, VectorType high)
+{
+    return [&]<unsigned... Indices>(IntegerSequence<unsigned, Indices...>) {
+        return __builtin_shufflevector(low, high, Indices...);
+    }(MakeIndexSequence<vector_lane_count<VectorType> * 2>());
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static VectorType vector_splat(VectorElementType<VectorType> value)
+{
+    return VectorType {} + value;
+}
+
+// Clamps every lane of `vector` to the range of the lanes of ResultVectorType, then narrows it to that type.
+template<typename ResultVectorType, typename VectorType>
+ALWAYS_INLINE static ResultVectorType saturating_narrow(VectorType vector)
+{
+    using ResultElementType = VectorElementType<ResultVectorType>;
+    auto const min_value = vector_splat<VectorType>(NumericLimits<ResultElementType>::min());
+    auto const max_value = vector_splat<VectorType>(NumericLimits<ResultElementType>::max());
+    vector = vector < min_value ? min_value : vector;
+    vector = vector > max_value ? max_value : vector;
+    return __builtin_convertvector(vector, ResultVectorType);
+}
+
+// Applies Operator to v128 operands reinterpreted as VectorType.
+template<typename VectorType, typename Operator>
+struct VectorOperation {
+    auto operator()(u128 value) const { return to_result(Operator {}(bit_cast<VectorType>(value))); }
+    auto operator()(u128 lhs, u128 rhs) const { return to_result(Operator {}(bit_cast<VectorType>(lhs), bit_cast<VectorType>(rhs))); }
+
+    static StringView name() { return Operator::name(); }
+
+private:
+    template<typename T>
+    static auto to_result(T value)
+    {
+        if constexpr (sizeof(T) == sizeof(u128))
+            return bit_cast<u128>(value);
+        else
+            return value;
+    }
+};
+
+// Applies a scalar Operator to each lane, for operations that have no direct vector equivalent.
+// Lanes of the result that have no corresponding input lane are zero.
+template<typename Operator, typename ResultVectorType = void>
+struct LaneWise {
+    template<typename VectorType>
+    auto operator()(VectorType value) const
+    {
+        using ResultType = Conditional<IsVoid<ResultVectorType>, VectorType, ResultVectorType>;
+        ResultType result {};
+        for (unsigned i = 0; i < vector_lane_count<VectorType>; ++i)
+            result[i] = unwrap(Operator {}(value[i]));
+        return result;
+    }
+
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        VectorType result {};
+        for (unsigned i = 0; i < vector_lane_count<VectorType>; ++i)
+            result[i] = unwrap(Operator {}(lhs[i], rhs[i]));
+        return result;
+    }
+
+    static StringView name() { return Operator::name(); }
+
+private:
+    template<typename T>
+    static auto unwrap(T value)
+    {
+        if constexpr (IsSpecializationOf<T, AK::Result>)
+            return value.release_value();
+        else
+            return value;
+    }
+};
+
+struct VectorDivide {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs / rhs; }
+
+    static StringView name() { return "/"sv; }
+};
+
+struct BitNot {
+    template<typename Lhs>
+    auto operator()(Lhs lhs) const { return ~lhs; }
+
+    static StringView name() { return "~"sv; }
+};
+
+struct BitAndNot {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs & ~rhs; }
+
+    static StringView name() { return "&~"sv; }
+};
+
+struct VectorAbsolute {
+    template<typename VectorType>
+    VectorType operator()(VectorType value) const
+    {
+        using ElementType = VectorElementType<VectorType>;
+        using BitsType = NativeVectorType<sizeof(ElementType) * 8, vector_lane_count<VectorType>, MakeUnsigned>;
+        if constexpr (IsFloatingPoint<ElementType>) {
+            // Clearing the sign bit also gives NaNs and negative zero a positive sign, like the scalar instructions.
+            auto const sign_bit = vector_splat<BitsType>(static_cast<MakeUnsigned<NativeIntegralType<sizeof(ElementType) * 8>>>(1) << (sizeof(ElementType) * 8 - 1));
+            return bit_cast<VectorType>(bit_cast<BitsType>(value) & ~sign_bit);
+        } else {
+            auto negated = bit_cast<VectorType>(-bit_cast<BitsType>(value));
+            return value < 0 ? negated : value;
+        }
+    }
+
+    static StringView name() { return "abs"sv; }
+};
+
+struct VectorMinimum {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const { return lhs < rhs ? lhs : rhs; }
+
+    static StringView name() { return "minimum"sv; }
+};
+
+struct VectorMaximum {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const { return lhs > rhs ? lhs : rhs; }
+
+    static StringView name() { return "maximum"sv; }
+};
+
+struct PseudoMinimum {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const { return rhs < lhs ? rhs : lhs; }
+
+    static StringView name() { return "pseudo-minimum"sv; }
+};
+
+struct PseudoMaximum {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const { return lhs < rhs ? rhs : lhs; }
+
+    static StringView name() { return "pseudo-maximum"sv; }
+};
+
+template<typename Operator>
+struct SaturatingOperation {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        using WidenedType = WidenedVectorOf<VectorType>;
+        auto result = Operator {}(__builtin_convertvector(lhs, WidenedType), __builtin_convertvector(rhs, WidenedType));
+        return saturating_narrow<VectorType>(result);
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
+struct AverageRounded {
+    template<typename VectorType>
+    VectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        // (lhs + rhs + 1) / 2, without overflowing the lanes.
+        return (lhs | rhs) - ((lhs ^ rhs) >> 1);
+    }
+
+    static StringView name() { return "avgr"sv; }
+};
+
+struct Q15MultiplyRoundSaturating {
+    i16x8 operator()(i16x8 lhs, i16x8 rhs) const
+    {
+        using WidenedType = WidenedVectorOf<i16x8>;
+        auto product = __builtin_convertvector(lhs, WidenedType) * __builtin_convertvector(rhs, WidenedType);
+        return saturating_narrow<i16x8>((product + 0x4000) >> 15);
+    }
+
+    static StringView name() { return "q15mulr"sv; }
+};
+
+template<typename ResultVectorType>
+struct SaturatingNarrow {
+    template<typename VectorType>
+    ResultVectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        return saturating_narrow<ResultVectorType>(vector_concat(lhs, rhs));
+    }
+
+    static StringView name() { return "narrow"sv; }
+};
+
+enum class VectorHalf {
+    Low,
+    High,
+};
+
+template<typename ResultVectorType, VectorHalf half>
+struct ExtendHalf {
+    template<typename VectorType>
+    ResultVectorType operator()(VectorType value) const
+    {
+        constexpr auto lane_count = vector_lane_count<VectorType> / 2;
+        constexpr auto offset = half == VectorHalf::Low ? 0 : lane_count;
+        return __builtin_convertvector(vector_lanes<offset, lane_count>(value), ResultVectorType);
+    }
+
+    static StringView name() { return "extend"sv; }
+};
+
+template<typename ResultVectorType, VectorHalf half>
+struct ExtendMultiply {
+    template<typename VectorType>
+    ResultVectorType operator()(VectorType lhs, VectorType rhs) const
+    {
+        // Products of extended lanes always fit into the wider lanes.
+        ExtendHalf<ResultVectorType, half> extend;
+        return extend(lhs) * extend(rhs);
+    }
+
+    static StringView name() { return "extmul"sv; }
+};
+
+template<typename ResultVectorType>
+struct ExtendAddPairwise {
+    template<typename VectorType>
+    ResultVectorType operator()(VectorType value) const
+    {
+        constexpr auto lane_count = vector_lane_count<VectorType> / 2;
+        auto even = __builtin_convertvector(vector_lanes<0, lane_count, 2>(value), ResultVectorType);
+        auto odd = __builtin_convertvector(vector_lanes<1, lane_count, 2>(value), ResultVectorType);
+        return even + odd;
+    }
+
+    static StringView name() { return "extadd_pairwise"sv; }
+};
+
+struct DotProduct {
+    i32x4 operator()(i16x8 lhs, i16x8 rhs) const
+    {
+        auto products = ExtendHalf<i32x4, VectorHalf::Low> {}(lhs) * ExtendHalf<i32x4, VectorHalf::Low> {}(rhs);
+        auto high_products = ExtendHalf<i32x4, VectorHalf::High> {}(lhs) * ExtendHalf<i32x4, VectorHalf::High> {}(rhs);
+        auto all_products = vector_concat(products, high_products);
+        // The sum of two products of -32768 does not fit into an i32 lane, so add them as unsigned and let them wrap.
+        auto even = bit_cast<u32x4>(vector_lanes<0, 4, 2>(all_products));
+        auto odd = bit_cast<u32x4>(vector_lanes<1, 4, 2>(all_products));
+        return bit_cast<i32x4>(even + odd);
+    }
+
+    static StringView name() { return "dot"sv; }
+};
+
+struct VectorPopCount {
+    u8x16 operator()(u8x16 value) const
+    {
+        value = value - ((value >> 1) & 0x55);
+        value = (value & 0x33) + ((value >> 2) & 0x33);
+        return (value + (value >> 4)) & 0x0f;
+    }
+
+    static StringView name() { return "popcnt"sv; }
+};
+
+struct VectorSwizzle {
+    u8x16 operator()(u8x16 values, u8x16 indices) const
+    {
+        // Out of range indices select zero.
+        return shuffle(values, indices) & bit_cast<u8x16>(indices < 16);
+    }
+
+    static StringView name() { return "swizzle"sv; }
+};
+
+template<typename ResultVectorType>
+struct VectorConvert {
+    template<typename VectorType>
+    ResultVectorType operator()(VectorType value) const
+    {
+        constexpr auto lane_count = vector_lane_count<VectorType>;
+        constexpr auto result_lane_count = vector_lane_count<ResultVectorType>;
+        if constexpr (lane_count == result_lane_count) {
+            return __builtin_convertvector(value, ResultVectorType);
+        } else if constexpr (lane_count > result_lane_count) {
+            // Only the low lanes are converted.
+            return __builtin_convertvector(vector_lanes<0, result_lane_count>(value), ResultVectorType);
+        } else {
+            // The high lanes of the result are zero.
+            using HalfResultType = decltype(vector_lanes<0, lane_count>(declval<ResultVectorType>()));
+            return vector_concat(__builtin_convertvector(value, HalfResultType), HalfResultType {});
+        }
+    }
+
+    static StringView name() { return "convert"sv; }
+};
+
+struct VectorAllTrue {
+    template<typename VectorType>
+    i32 operator()(VectorType value) const
+    {
+        auto zero_lanes = bit_cast<u64x2>(value == 0);
+        return (zero_lanes[0] | zero_lanes[1]) == 0;
+    }
+
+    static StringView name() { return "all_true"sv; }
+};
+
+struct VectorAnyTrue {
+    template<typename VectorType>
+    i32 operator()(VectorType value) const
+    {
+        auto bits = bit_cast<u64x2>(value);
+        return (bits[0] | bits[1]) != 0;
+    }
+
+    static StringView name() { return "any_true"sv; }
+};
+
+struct VectorBitmask {
+    template<typename VectorType>
+    i32 operator()(VectorType value) const
+    {
+        auto negative = value < 0;
+        i32 result = 0;
+        for (unsigned i = 0; i < vector_lane_count<VectorType>; ++i)
+            result |= (negative[i] & 1) << i;
+        return result;
+    }
+
+    static StringView name() { return "bitmask"sv; }
+};
+
 }
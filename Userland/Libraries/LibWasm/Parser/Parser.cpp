@@ -273,7 +273,7 @@ ParseResult<BlockType> BlockType::parse(Stream& stream)
     ReconsumableStream new_stream { stream };
     new_stream.unread({ &kind, 1 });
 
-    auto index_value_or_error = stream.read_value<LEB128<ssize_t>>();
+    auto index_value_or_error = new_stream.read_value<LEB128<ssize_t>>();
     if (index_value_or_error.is_error())
         return with_eof_check(stream, ParseError::ExpectedIndex);
     ssize_t index_value = index_value_or_error.release_value();
@@ -792,6 +792,8 @@ ParseResult<Vector<Instruction>> Instruction::parse(Stream& stream, InstructionP
             case Instructions::v128_load16_splat.value():
             case Instructions::v128_load32_splat.value():
             case Instructions::v128_load64_splat.value():
+            case Instructions::v128_load32_zero.value():
+            case Instructions::v128_load64_zero.value():
             case Instructions::v128_store.value(): {
                 // op (align offset)
                 auto align_or_error = stream.read_value<LEB128<size_t>>();
@@ -930,8 +932,6 @@ ParseResult<Vector<Instruction>> Instruction::parse(Stream& stream, InstructionP
             case Instructions::v128_xor.value():
             case Instructions::v128_bitselect.value():
             case Instructions::v128_any_true.value():
-            case Instructions::v128_load32_zero.value():
-            case Instructions::v128_load64_zero.value():
             case Instructions::f32x4_demote_f64x2_zero.value():
             case Instructions::f64x2_promote_low_f32x4.value():
             case Instructions::i8x16_abs.value():
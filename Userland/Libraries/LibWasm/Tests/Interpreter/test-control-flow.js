@@ -0,0 +1,32 @@
+// control-flow.wasm exports a few small kernels that exercise calls, nested blocks, loops, `if`/`else`,
+// `br`, `br_if`, `br_table` and `return`; block-type-index.wasm has the same kernel as `branch_out_of_if_else`,
+// except that its block takes a parameter. Both are generated by Meta/generate-libwasm-control-flow-kernels.py.
+
+test("recursive calls", () => {
+    const module = parseWebAssemblyModule(readBinaryWasmFile("Fixtures/Modules/control-flow.wasm"));
+    expect(module.invoke(module.getExport("fib"), 15)).toBe(610);
+});
+
+test("loops with br and br_if", () => {
+    const module = parseWebAssemblyModule(readBinaryWasmFile("Fixtures/Modules/control-flow.wasm"));
+    expect(module.invoke(module.getExport("loop_sum"), 1000)).toBe(332865464);
+    expect(module.invoke(module.getExport("sieve"), 1000)).toBe(168);
+    expect(module.invoke(module.getExport("harmonic"), 1000)).toBe(7485);
+});
+
+test("br_table out of nested blocks", () => {
+    const module = parseWebAssemblyModule(readBinaryWasmFile("Fixtures/Modules/control-flow.wasm"));
+    expect(module.invoke(module.getExport("dispatch"), 1000)).toBe(-1859774460);
+});
+
+test("branching out of if/else and returning from inside a loop", () => {
+    const module = parseWebAssemblyModule(readBinaryWasmFile("Fixtures/Modules/control-flow.wasm"));
+    expect(module.invoke(module.getExport("branch_out_of_if_else"), 500)).toBe(1222622559);
+    expect(module.invoke(module.getExport("branch_out_of_if_else"), 2000)).toBe(275343735);
+});
+
+test("blocks with parameters", () => {
+    const module = parseWebAssemblyModule(readBinaryWasmFile("Fixtures/Modules/block-type-index.wasm"));
+    expect(module.invoke(module.getExport("block_params"), 500)).toBe(1222622559);
+    expect(module.invoke(module.getExport("block_params"), 2000)).toBe(275343735);
+});
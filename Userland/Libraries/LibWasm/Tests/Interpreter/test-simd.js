@@ -0,0 +1,237 @@
+// simd-operators.wasm exports one function per v128 operator (named after the opcode) that applies
+// it to constant operands; vector results are stored at address 0 and read back through `byte`.
+// simd-benchmark.wasm exports small kernels in both vector and scalar form, which must agree.
+// Both, and the expectations below, are generated by Meta/generate-libwasm-simd-kernels.py.
+
+// Expected results; arrays are the 16 result bytes of a v128, numbers are scalar (i32) results.
+const expectations = {
+    i8x16_eq: [255, 0, 0, 0, 0, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0, 255],
+    i8x16_ne: [0, 255, 255, 255, 255, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 0],
+    i8x16_lt_s: [0, 0, 255, 0, 255, 0, 0, 0, 255, 255, 255, 0, 255, 0, 0, 0],
+    i8x16_lt_u: [0, 255, 0, 0, 255, 0, 0, 255, 255, 0, 255, 255, 0, 0, 255, 0],
+    i8x16_gt_s: [0, 255, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 255, 255, 0],
+    i8x16_gt_u: [0, 0, 255, 255, 0, 0, 0, 0, 0, 255, 0, 0, 255, 255, 0, 0],
+    i8x16_le_s: [255, 0, 255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 0, 0, 255],
+    i8x16_le_u: [255, 255, 0, 0, 255, 255, 255, 255, 255, 0, 255, 255, 0, 0, 255, 255],
+    i8x16_ge_s: [255, 255, 0, 255, 0, 255, 255, 255, 0, 0, 0, 255, 0, 255, 255, 255],
+    i8x16_ge_u: [255, 0, 255, 255, 0, 255, 255, 0, 0, 255, 0, 0, 255, 255, 0, 255],
+    i16x8_eq: [255, 255, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 255, 255],
+    i16x8_ne: [0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0],
+    i16x8_lt_s: [0, 0, 0, 0, 255, 255, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0],
+    i16x8_lt_u: [0, 0, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0],
+    i16x8_gt_s: [0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 0, 0, 255, 255, 0, 0],
+    i16x8_gt_u: [0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0, 255, 255, 0, 0],
+    i16x8_le_s: [255, 255, 0, 0, 255, 255, 0, 0, 255, 255, 255, 255, 0, 0, 255, 255],
+    i16x8_le_u: [255, 255, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 255, 255],
+    i16x8_ge_s: [255, 255, 255, 255, 0, 0, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255],
+    i16x8_ge_u: [255, 255, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255],
+    i32x4_eq: [0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0],
+    i32x4_ne: [255, 255, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255],
+    i32x4_lt_s: [255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255],
+    i32x4_lt_u: [255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255],
+    i32x4_gt_s: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0],
+    i32x4_gt_u: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0],
+    i32x4_le_s: [255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255],
+    i32x4_le_u: [255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255],
+    i32x4_ge_s: [0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0],
+    i32x4_ge_u: [0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0],
+    i64x2_eq: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+    i64x2_ne: [255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255],
+    i64x2_lt_s: [255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0],
+    i64x2_gt_s: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255],
+    i64x2_le_s: [255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0],
+    i64x2_ge_s: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255],
+    f32x4_eq: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+    f32x4_ne: [255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255],
+    f32x4_lt: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255],
+    f32x4_gt: [0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0],
+    f32x4_le: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255],
+    f32x4_ge: [0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0],
+    f64x2_eq: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+    f64x2_ne: [255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255],
+    f64x2_lt: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255],
+    f64x2_gt: [255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0],
+    f64x2_le: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255],
+    f64x2_ge: [255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0],
+    i8x16_add: [0, 0, 0, 128, 127, 200, 56, 0, 18, 13, 34, 8, 197, 10, 0, 60],
+    i8x16_sub: [0, 2, 254, 126, 129, 0, 0, 100, 242, 239, 228, 120, 187, 10, 40, 0],
+    i8x16_add_sat_s: [0, 0, 0, 127, 128, 127, 128, 0, 18, 13, 34, 8, 197, 10, 0, 60],
+    i8x16_add_sat_u: [0, 255, 255, 128, 255, 200, 255, 255, 18, 255, 34, 255, 197, 10, 255, 60],
+    i8x16_sub_sat_s: [0, 2, 254, 126, 129, 0, 0, 100, 242, 239, 228, 120, 187, 10, 40, 0],
+    i8x16_sub_sat_u: [0, 0, 254, 126, 0, 0, 0, 0, 0, 239, 0, 0, 187, 10, 0, 0],
+    i8x16_avgr_u: [0, 128, 128, 64, 192, 100, 156, 128, 9, 135, 17, 132, 99, 5, 128, 30],
+    i8x16_min_s: [0, 255, 255, 1, 128, 100, 156, 206, 2, 254, 3, 200, 192, 0, 236, 30],
+    i8x16_min_u: [0, 1, 1, 1, 128, 100, 156, 50, 2, 15, 3, 64, 5, 0, 20, 30],
+    i8x16_max_s: [0, 1, 1, 127, 255, 100, 156, 50, 16, 15, 31, 64, 5, 10, 20, 30],
+    i8x16_max_u: [0, 255, 255, 127, 255, 100, 156, 206, 16, 254, 31, 200, 192, 10, 236, 30],
+    i16x8_add: [0, 0, 0, 0, 0, 0, 0, 128, 255, 127, 24, 121, 232, 134, 64, 156],
+    i16x8_sub: [0, 0, 2, 0, 254, 255, 254, 127, 1, 128, 184, 142, 72, 113, 0, 0],
+    i16x8_mul: [0, 0, 255, 255, 255, 255, 255, 127, 0, 128, 128, 195, 128, 195, 0, 132],
+    i16x8_add_sat_s: [0, 0, 0, 0, 0, 0, 255, 127, 0, 128, 24, 121, 232, 134, 255, 127],
+    i16x8_add_sat_u: [0, 0, 255, 255, 255, 255, 0, 128, 255, 255, 24, 121, 255, 255, 64, 156],
+    i16x8_sub_sat_s: [0, 0, 2, 0, 254, 255, 254, 127, 1, 128, 184, 142, 72, 113, 0, 0],
+    i16x8_sub_sat_u: [0, 0, 0, 0, 254, 255, 254, 127, 0, 0, 0, 0, 72, 113, 0, 0],
+    i16x8_avgr_u: [0, 0, 0, 128, 0, 128, 0, 64, 0, 192, 140, 60, 116, 195, 32, 78],
+    i16x8_min_s: [0, 0, 255, 255, 255, 255, 1, 0, 0, 128, 232, 3, 208, 138, 32, 78],
+    i16x8_min_u: [0, 0, 1, 0, 1, 0, 1, 0, 0, 128, 232, 3, 208, 138, 32, 78],
+    i16x8_max_s: [0, 0, 1, 0, 1, 0, 255, 127, 255, 255, 48, 117, 24, 252, 32, 78],
+    i16x8_max_u: [0, 0, 255, 255, 255, 255, 255, 127, 255, 255, 48, 117, 24, 252, 32, 78],
+    i32x4_add: [5, 0, 0, 0, 254, 255, 255, 255, 0, 0, 0, 128, 255, 255, 255, 127],
+    i32x4_sub: [251, 255, 255, 255, 0, 0, 0, 0, 254, 255, 255, 127, 1, 0, 0, 128],
+    i32x4_mul: [0, 0, 0, 0, 1, 0, 0, 0, 255, 255, 255, 127, 0, 0, 0, 128],
+    i32x4_min_s: [0, 0, 0, 0, 255, 255, 255, 255, 1, 0, 0, 0, 0, 0, 0, 128],
+    i32x4_min_u: [0, 0, 0, 0, 255, 255, 255, 255, 1, 0, 0, 0, 0, 0, 0, 128],
+    i32x4_max_s: [5, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 127, 255, 255, 255, 255],
+    i32x4_max_u: [5, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 127, 255, 255, 255, 255],
+    i64x2_add: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 192],
+    i64x2_sub: [254, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 192],
+    i64x2_mul: [255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0],
+    v128_and: [0, 1, 1, 1, 128, 100, 156, 2, 0, 14, 3, 64, 0, 0, 4, 30],
+    v128_andnot: [0, 0, 254, 126, 0, 0, 0, 48, 2, 240, 0, 0, 192, 10, 16, 0],
+    v128_or: [0, 255, 255, 127, 255, 100, 156, 254, 18, 255, 31, 200, 197, 10, 252, 30],
+    v128_xor: [0, 254, 254, 126, 127, 0, 0, 252, 18, 241, 28, 136, 197, 10, 248, 0],
+    i8x16_narrow_i16x8_s: [0, 1, 255, 127, 128, 127, 128, 127, 0, 255, 1, 1, 255, 127, 128, 127],
+    i8x16_narrow_i16x8_u: [0, 1, 0, 255, 0, 255, 0, 255, 0, 0, 1, 1, 0, 255, 0, 255],
+    i16x8_narrow_i32x4_s: [0, 0, 255, 255, 255, 127, 0, 128, 5, 0, 255, 255, 1, 0, 255, 255],
+    i16x8_narrow_i32x4_u: [0, 0, 0, 0, 255, 255, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0],
+    i16x8_q15mulr_sat_s: [0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 148, 3, 148, 3, 175, 47],
+    i32x4_dot_i16x8_s: [255, 255, 255, 255, 254, 127, 0, 0, 128, 67, 202, 1, 128, 71, 161, 25],
+    i32x4_dot_i16x8_s_2: [0, 0, 0, 128, 0, 0, 0, 128, 0, 0, 0, 128, 0, 0, 0, 128],
+    i16x8_extmul_low_i8x16_s: [0, 0, 255, 255, 255, 255, 127, 0, 128, 0, 16, 39, 16, 39, 60, 246],
+    i16x8_extmul_low_i8x16_u: [0, 0, 255, 0, 255, 0, 127, 0, 128, 127, 16, 39, 16, 95, 60, 40],
+    i16x8_extmul_high_i8x16_s: [32, 0, 226, 255, 93, 0, 0, 242, 192, 254, 0, 0, 112, 254, 132, 3],
+    i16x8_extmul_high_i8x16_u: [32, 0, 226, 14, 93, 0, 0, 50, 192, 3, 0, 0, 112, 18, 132, 3],
+    i32x4_extmul_low_i16x8_s: [0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 127, 0, 0],
+    i32x4_extmul_low_i16x8_u: [0, 0, 0, 0, 255, 255, 0, 0, 255, 255, 0, 0, 255, 127, 0, 0],
+    i32x4_extmul_high_i16x8_s: [0, 128, 0, 0, 128, 195, 201, 1, 128, 195, 201, 1, 0, 132, 215, 23],
+    i32x4_extmul_high_i16x8_u: [
+        0, 128, 255, 127, 128, 195, 201, 1, 128, 195, 177, 136, 0, 132, 215, 23,
+    ],
+    i64x2_extmul_low_i32x4_s: [0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0],
+    i64x2_extmul_low_i32x4_u: [0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 254, 255, 255, 255],
+    i64x2_extmul_high_i32x4_s: [255, 255, 255, 127, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0],
+    i64x2_extmul_high_i32x4_u: [255, 255, 255, 127, 0, 0, 0, 0, 0, 0, 0, 128, 255, 255, 255, 127],
+    i8x16_swizzle: [30, 0, 0, 0, 127, 127, 50, 1, 0, 20, 255, 100, 0, 254, 3, 128],
+    f32x4_add: [0, 0, 96, 64, 0, 0, 48, 192, 0, 0, 96, 64, 0, 0, 0, 0],
+    f32x4_sub: [0, 0, 0, 191, 0, 0, 16, 192, 0, 0, 32, 192, 0, 0, 0, 66],
+    f32x4_mul: [0, 0, 64, 64, 0, 0, 32, 63, 0, 0, 192, 63, 0, 0, 128, 195],
+    f32x4_div: [0, 0, 64, 63, 0, 0, 32, 65, 171, 170, 42, 62, 0, 0, 128, 191],
+    f32x4_min: [0, 0, 192, 63, 0, 0, 32, 192, 0, 0, 0, 63, 0, 0, 128, 193],
+    f32x4_max: [0, 0, 0, 64, 0, 0, 128, 190, 0, 0, 64, 64, 0, 0, 128, 65],
+    f32x4_pmin: [0, 0, 192, 63, 0, 0, 32, 192, 0, 0, 0, 63, 0, 0, 128, 193],
+    f32x4_pmax: [0, 0, 0, 64, 0, 0, 128, 190, 0, 0, 64, 64, 0, 0, 128, 65],
+    f64x2_add: [0, 0, 0, 0, 0, 0, 4, 64, 0, 0, 0, 0, 0, 0, 248, 63],
+    f64x2_sub: [0, 0, 0, 0, 0, 0, 0, 64, 0, 0, 0, 0, 0, 0, 26, 192],
+    f64x2_mul: [0, 0, 0, 0, 0, 0, 226, 63, 0, 0, 0, 0, 0, 0, 36, 192],
+    f64x2_div: [0, 0, 0, 0, 0, 0, 34, 64, 0, 0, 0, 0, 0, 0, 228, 191],
+    f64x2_min: [0, 0, 0, 0, 0, 0, 208, 63, 0, 0, 0, 0, 0, 0, 4, 192],
+    f64x2_max: [0, 0, 0, 0, 0, 0, 2, 64, 0, 0, 0, 0, 0, 0, 16, 64],
+    f64x2_pmin: [0, 0, 0, 0, 0, 0, 208, 63, 0, 0, 0, 0, 0, 0, 4, 192],
+    f64x2_pmax: [0, 0, 0, 0, 0, 0, 2, 64, 0, 0, 0, 0, 0, 0, 16, 64],
+    i8x16_abs: [0, 1, 1, 127, 128, 100, 100, 50, 2, 2, 3, 64, 64, 10, 20, 30],
+    i8x16_neg: [0, 255, 1, 129, 128, 156, 100, 206, 254, 2, 253, 192, 64, 246, 236, 226],
+    i16x8_abs: [0, 0, 1, 0, 1, 0, 255, 127, 0, 128, 232, 3, 232, 3, 32, 78],
+    i16x8_neg: [0, 0, 255, 255, 1, 0, 1, 128, 0, 128, 24, 252, 232, 3, 224, 177],
+    i32x4_abs: [0, 0, 0, 0, 1, 0, 0, 0, 255, 255, 255, 127, 0, 0, 0, 128],
+    i32x4_neg: [0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 128, 0, 0, 0, 128],
+    i64x2_abs: [1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 64],
+    i64x2_neg: [1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 192],
+    i8x16_popcnt: [0, 1, 8, 7, 1, 3, 4, 3, 1, 7, 2, 1, 2, 2, 2, 4],
+    v128_not: [255, 254, 0, 128, 127, 155, 99, 205, 253, 1, 252, 191, 63, 245, 235, 225],
+    i16x8_extend_low_i8x16_s: [0, 0, 1, 0, 255, 255, 127, 0, 128, 255, 100, 0, 156, 255, 50, 0],
+    i16x8_extend_low_i8x16_u: [0, 0, 1, 0, 255, 0, 127, 0, 128, 0, 100, 0, 156, 0, 50, 0],
+    i16x8_extend_high_i8x16_s: [2, 0, 254, 255, 3, 0, 64, 0, 192, 255, 10, 0, 20, 0, 30, 0],
+    i16x8_extend_high_i8x16_u: [2, 0, 254, 0, 3, 0, 64, 0, 192, 0, 10, 0, 20, 0, 30, 0],
+    i16x8_extadd_pairwise_i8x16_s: [1, 0, 126, 0, 228, 255, 206, 255, 0, 0, 67, 0, 202, 255, 50, 0],
+    i16x8_extadd_pairwise_i8x16_u: [1, 0, 126, 1, 228, 0, 206, 0, 0, 1, 67, 0, 202, 0, 50, 0],
+    i32x4_extend_low_i16x8_s: [0, 0, 0, 0, 1, 0, 0, 0, 255, 255, 255, 255, 255, 127, 0, 0],
+    i32x4_extend_low_i16x8_u: [0, 0, 0, 0, 1, 0, 0, 0, 255, 255, 0, 0, 255, 127, 0, 0],
+    i32x4_extend_high_i16x8_s: [0, 128, 255, 255, 232, 3, 0, 0, 24, 252, 255, 255, 32, 78, 0, 0],
+    i32x4_extend_high_i16x8_u: [0, 128, 0, 0, 232, 3, 0, 0, 24, 252, 0, 0, 32, 78, 0, 0],
+    i32x4_extadd_pairwise_i16x8_s: [1, 0, 0, 0, 254, 127, 0, 0, 232, 131, 255, 255, 56, 74, 0, 0],
+    i32x4_extadd_pairwise_i16x8_u: [1, 0, 0, 0, 254, 127, 1, 0, 232, 131, 0, 0, 56, 74, 1, 0],
+    i64x2_extend_low_i32x4_s: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255],
+    i64x2_extend_low_i32x4_u: [0, 0, 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0],
+    i64x2_extend_high_i32x4_s: [255, 255, 255, 127, 0, 0, 0, 0, 0, 0, 0, 128, 255, 255, 255, 255],
+    i64x2_extend_high_i32x4_u: [255, 255, 255, 127, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0],
+    f32x4_abs: [0, 0, 0, 64, 0, 0, 128, 62, 0, 0, 64, 64, 0, 0, 128, 65],
+    f32x4_neg: [0, 0, 0, 192, 0, 0, 128, 62, 0, 0, 64, 192, 0, 0, 128, 65],
+    f32x4_sqrt: [243, 4, 181, 63, 0, 0, 0, 63, 215, 179, 221, 63, 0, 0, 128, 64],
+    f32x4_ceil: [0, 0, 64, 64, 0, 0, 0, 192, 0, 0, 128, 63, 0, 0, 128, 191],
+    f32x4_floor: [0, 0, 0, 64, 0, 0, 64, 192, 0, 0, 0, 0, 0, 0, 0, 192],
+    f32x4_trunc: [0, 0, 0, 64, 0, 0, 0, 192, 0, 0, 0, 0, 0, 0, 128, 191],
+    f32x4_nearest: [0, 0, 0, 64, 0, 0, 0, 192, 0, 0, 0, 0, 0, 0, 0, 192],
+    f64x2_abs: [0, 0, 0, 0, 0, 0, 2, 64, 0, 0, 0, 0, 0, 0, 4, 64],
+    f64x2_neg: [0, 0, 0, 0, 0, 0, 2, 192, 0, 0, 0, 0, 0, 0, 4, 64],
+    f64x2_sqrt: [0, 0, 0, 0, 0, 0, 248, 63, 83, 91, 218, 58, 88, 76, 249, 63],
+    f64x2_ceil: [0, 0, 0, 0, 0, 0, 8, 64, 0, 0, 0, 0, 0, 0, 240, 191],
+    f64x2_floor: [0, 0, 0, 0, 0, 0, 0, 64, 0, 0, 0, 0, 0, 0, 0, 192],
+    f64x2_trunc: [0, 0, 0, 0, 0, 0, 0, 64, 0, 0, 0, 0, 0, 0, 240, 191],
+    f64x2_nearest: [0, 0, 0, 0, 0, 0, 0, 64, 0, 0, 0, 0, 0, 0, 0, 192],
+    i32x4_trunc_sat_f32x4_s: [0, 0, 0, 0, 255, 255, 255, 127, 0, 0, 0, 128, 255, 255, 255, 255],
+    i32x4_trunc_sat_f32x4_u: [0, 0, 0, 0, 0, 94, 208, 178, 0, 0, 0, 0, 0, 0, 0, 0],
+    i32x4_trunc_sat_f64x2_s_zero: [255, 255, 255, 127, 249, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0],
+    i32x4_trunc_sat_f64x2_u_zero: [255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+    f32x4_convert_i32x4_s: [0, 0, 0, 0, 0, 0, 128, 191, 0, 0, 0, 79, 0, 0, 0, 207],
+    f32x4_convert_i32x4_u: [0, 0, 0, 0, 0, 0, 128, 79, 0, 0, 0, 79, 0, 0, 0, 79],
+    f64x2_convert_low_i32x4_s: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 240, 191],
+    f64x2_convert_low_i32x4_u: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 224, 255, 255, 255, 239, 65],
+    f32x4_demote_f64x2_zero: [0, 0, 16, 64, 0, 0, 32, 192, 0, 0, 0, 0, 0, 0, 0, 0],
+    f64x2_promote_low_f32x4: [0, 0, 0, 0, 0, 0, 248, 63, 0, 0, 0, 0, 0, 0, 4, 192],
+    i8x16_shuffle: [0, 0, 1, 255, 30, 30, 2, 16, 255, 255, 255, 255, 236, 0, 5, 200],
+    v128_bitselect: [0, 1, 1, 127, 255, 100, 156, 50, 18, 14, 19, 192, 0, 10, 228, 30],
+    i8x16_replace_lane: [0, 1, 255, 127, 128, 52, 156, 50, 2, 254, 3, 64, 192, 10, 20, 30],
+    i64x2_replace_lane: [
+        255, 255, 255, 255, 255, 255, 255, 255, 251, 255, 255, 255, 255, 255, 255, 255,
+    ],
+    i16x8_splat: [69, 35, 69, 35, 69, 35, 69, 35, 69, 35, 69, 35, 69, 35, 69, 35],
+    i8x16_shr_s: [0, 0, 255, 63, 192, 50, 206, 25, 1, 255, 1, 32, 224, 5, 10, 15],
+    i8x16_bitmask: 4692,
+    i8x16_all_true: 0,
+    i8x16_all_true_2: 1,
+    i16x8_bitmask: 84,
+    i16x8_all_true: 0,
+    i16x8_all_true_2: 1,
+    i32x4_bitmask: 10,
+    i32x4_all_true: 0,
+    i32x4_all_true_2: 1,
+    i64x2_bitmask: 1,
+    i64x2_all_true: 1,
+    i64x2_all_true_2: 1,
+    v128_any_true: 0,
+    v128_any_true_2: 1,
+    i8x16_extract_lane_s: -128,
+    i8x16_extract_lane_u: 128,
+    i16x8_extract_lane_s: -32768,
+    i16x8_extract_lane_u: 32768,
+    i32x4_extract_lane: -2147483648,
+};
+
+test("v128 operators", () => {
+    const bytes = readBinaryWasmFile("Fixtures/Modules/simd-operators.wasm");
+    const module = parseWebAssemblyModule(bytes);
+    const byte = module.getExport("byte");
+    for (const [name, expected] of Object.entries(expectations)) {
+        const result = module.invoke(module.getExport(name));
+        if (typeof expected === "number") {
+            expect([name, result]).toEqual([name, expected]);
+            continue;
+        }
+        const lanes = [];
+        for (let i = 0; i < 16; ++i) lanes.push(module.invoke(byte, i));
+        expect([name, lanes]).toEqual([name, expected]);
+    }
+});
+
+test("vector kernels match their scalar equivalents", () => {
+    const bytes = readBinaryWasmFile("Fixtures/Modules/simd-benchmark.wasm");
+    const module = parseWebAssemblyModule(bytes);
+    for (const iterations of [1, 10]) {
+        const blend = module.invoke(module.getExport("blend"), iterations);
+        expect(blend).toBe(module.invoke(module.getExport("blend_scalar"), iterations));
+        const sumSquares = module.invoke(module.getExport("sum_squares"), iterations);
+        expect(sumSquares).toBe(module.invoke(module.getExport("sum_squares_scalar"), iterations));
+    }
+    expect(module.invoke(module.getExport("blend"), 10)).toBe(1722844);
+    expect(module.invoke(module.getExport("sum_squares"), 10)).toBe(14025);
+});
@@ -19,7 +19,7 @@ public:
     virtual ~CSSNamespaceRule() = default;
 
     void set_namespace_uri(DeprecatedString value) { m_namespace_uri = move(value); }
-    DeprecatedString namespace_uri() const { return m_namespace_uri; }
+    DeprecatedString const& namespace_uri() const { return m_namespace_uri; }
     void set_prefix(DeprecatedString value) { m_prefix = move(value); }
     DeprecatedString prefix() const { return m_prefix; }
     virtual Type type() const override { return Type::Namespace; }
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/NumericLimits.h>
+#include <AK/Types.h>
+
+namespace Web::CSS {
+
+// A Bloom filter with a small counter per bucket instead of a single bit, so that keys can be removed again.
+// Each key is mapped to two buckets, using the low and the high bits of its hash respectively.
+// Counters that saturate are never decremented again, which keeps the filter conservative:
+// may_contain() can return false positives, but never false negatives.
+template<typename CounterType, size_t key_bits>
+class CountingBloomFilter {
+    static_assert(key_bits <= 16);
+
+public:
+    void increment(u32 key)
+    {
+        increment_bucket(m_buckets[first_bucket_index(key)]);
+        increment_bucket(m_buckets[second_bucket_index(key)]);
+    }
+
+    void decrement(u32 key)
+    {
+        decrement_bucket(m_buckets[first_bucket_index(key)]);
+        decrement_bucket(m_buckets[second_bucket_index(key)]);
+    }
+
+    [[nodiscard]] bool may_contain(u32 key) const
+    {
+        return m_buckets[first_bucket_index(key)] != 0 && m_buckets[second_bucket_index(key)] != 0;
+    }
+
+    void clear() { m_buckets.fill(0); }
+
+private:
+    static constexpr size_t bucket_count = 1 << key_bits;
+    static constexpr u32 key_mask = bucket_count - 1;
+
+    static constexpr size_t first_bucket_index(u32 key) { return key & key_mask; }
+    static constexpr size_t second_bucket_index(u32 key) { return (key >> 16) & key_mask; }
+
+    static void increment_bucket(CounterType& bucket)
+    {
+        if (bucket != NumericLimits<CounterType>::max())
+            ++bucket;
+    }
+
+    static void decrement_bucket(CounterType& bucket)
+    {
+        if (bucket != 0 && bucket != NumericLimits<CounterType>::max())
+            --bucket;
+    }
+
+    Array<CounterType, bucket_count> m_buckets {};
+};
+
+}
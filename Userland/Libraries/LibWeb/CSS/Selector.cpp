@@ -6,10 +6,60 @@
  */
 
 #include "Selector.h"
+#include <AK/AllOf.h>
+#include <AK/StringHash.h>
 #include <LibWeb/CSS/Serialize.h>
 
 namespace Web::CSS {
 
+static bool simple_selector_can_be_matched_in_parallel(Selector::SimpleSelector const& simple_selector)
+{
+    if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+        return true;
+
+    auto const& pseudo_class = simple_selector.pseudo_class();
+    switch (pseudo_class.type) {
+    case PseudoClass::Is:
+    case PseudoClass::Where:
+    case PseudoClass::Not:
+    case PseudoClass::NthChild:
+    case PseudoClass::NthLastChild:
+        return all_of(pseudo_class.argument_selector_list, [](auto const& argument) { return argument->can_be_matched_in_parallel(); });
+    case PseudoClass::Active:
+    case PseudoClass::AnyLink:
+    case PseudoClass::Checked:
+    case PseudoClass::Closed:
+    case PseudoClass::Defined:
+    case PseudoClass::Empty:
+    case PseudoClass::FirstChild:
+    case PseudoClass::FirstOfType:
+    case PseudoClass::Focus:
+    case PseudoClass::FocusVisible:
+    case PseudoClass::FocusWithin:
+    case PseudoClass::Host:
+    case PseudoClass::Hover:
+    case PseudoClass::Indeterminate:
+    case PseudoClass::LastChild:
+    case PseudoClass::LastOfType:
+    case PseudoClass::Link:
+    case PseudoClass::NthLastOfType:
+    case PseudoClass::NthOfType:
+    case PseudoClass::OnlyChild:
+    case PseudoClass::OnlyOfType:
+    case PseudoClass::Open:
+    case PseudoClass::Root:
+    case PseudoClass::Scope:
+    case PseudoClass::Target:
+    case PseudoClass::TargetWithin:
+    case PseudoClass::Visited:
+        return true;
+    default:
+        // NOTE: The others either copy strings (e.g. :lang() and :local-link) or ask the element about state that
+        //       hasn't been audited for concurrent access yet (e.g. :dir() and :disabled).
+        return false;
+    }
+}
+
 Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     : m_compound_selectors(move(compound_selectors))
 {
@@ -23,6 +73,57 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
             }
         }
     }
+
+    collect_ancestor_hashes();
+
+    m_can_be_matched_in_parallel = all_of(m_compound_selectors, [](auto const& compound_selector) {
+        return all_of(compound_selector.simple_selectors, [](auto const& simple_selector) { return simple_selector_can_be_matched_in_parallel(simple_selector); });
+    });
+}
+
+void Selector::collect_ancestor_hashes()
+{
+    size_t hash_count = 0;
+    auto append_hash = [&](u32 hash) {
+        if (hash == 0)
+            return true;
+        for (size_t i = 0; i < hash_count; ++i) {
+            if (m_ancestor_hashes[i] == hash)
+                return true;
+        }
+        m_ancestor_hashes[hash_count++] = hash;
+        return hash_count < max_ancestor_hashes;
+    };
+
+    // NOTE: The combinator of a compound selector describes its relation to the compound selector on its left.
+    //       Compounds that are reached through a sibling combinator must match a sibling of the subject (or of
+    //       one of its ancestors), so we skip those. Anything further to the left is still an ancestor though.
+    for (ssize_t i = static_cast<ssize_t>(m_compound_selectors.size()) - 2; i >= 0; --i) {
+        auto relation_to_the_right = m_compound_selectors[i + 1].combinator;
+        if (relation_to_the_right == Combinator::Column)
+            return;
+        if (relation_to_the_right == Combinator::NextSibling || relation_to_the_right == Combinator::SubsequentSibling)
+            continue;
+
+        for (auto const& simple_selector : m_compound_selectors[i].simple_selectors) {
+            u32 hash = 0;
+            switch (simple_selector.type) {
+            case SimpleSelector::Type::TagName:
+                hash = ancestor_filter_hash(AncestorFilterHashType::TagName, simple_selector.qualified_name().name.lowercase_name.bytes_as_string_view());
+                break;
+            case SimpleSelector::Type::Id:
+                hash = ancestor_filter_hash(AncestorFilterHashType::Id, simple_selector.name().bytes_as_string_view());
+                break;
+            case SimpleSelector::Type::Class:
+                hash = ancestor_filter_hash(AncestorFilterHashType::Class, simple_selector.name().bytes_as_string_view());
+                break;
+            default:
+                continue;
+            }
+            if (!append_hash(hash))
+                return;
+        }
+    }
 }
 
 // https://www.w3.org/TR/selectors-4/#specificity-rules
@@ -385,4 +486,9 @@ Optional<Selector::PseudoElement> pseudo_element_from_string(StringView name)
     return {};
 }
 
+u32 ancestor_filter_hash(AncestorFilterHashType type, StringView name)
+{
+    return AK::case_insensitive_string_hash(name.characters_without_null_termination(), name.length(), to_underlying(type) + 1);
+}
+
 }
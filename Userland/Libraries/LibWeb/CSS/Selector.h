@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/FlyString.h>
 #include <AK/RefCounted.h>
 #include <AK/String.h>
@@ -196,12 +197,25 @@ public:
     u32 specificity() const;
     String serialize() const;
 
+    // Hashes of the tag names, ids and classes that the ancestors of a matching element must have.
+    // Unused slots are zero. This is used to quickly reject selectors with an ancestor Bloom filter.
+    static constexpr size_t max_ancestor_hashes = 4;
+    Array<u32, max_ancestor_hashes> const& ancestor_hashes() const { return m_ancestor_hashes; }
+
+    // Whether matching this selector only reads state that stays put during a style update, without touching any
+    // ref-counts or caches. Such selectors can be matched on several threads at once.
+    bool can_be_matched_in_parallel() const { return m_can_be_matched_in_parallel; }
+
 private:
     explicit Selector(Vector<CompoundSelector>&&);
 
     Vector<CompoundSelector> m_compound_selectors;
     mutable Optional<u32> m_specificity;
     Optional<Selector::PseudoElement> m_pseudo_element;
+    Array<u32, max_ancestor_hashes> m_ancestor_hashes {};
+    bool m_can_be_matched_in_parallel { false };
+
+    void collect_ancestor_hashes();
 };
 
 constexpr StringView pseudo_element_name(Selector::PseudoElement pseudo_element)
@@ -233,6 +247,16 @@ constexpr StringView pseudo_element_name(Selector::PseudoElement pseudo_element)
 
 Optional<Selector::PseudoElement> pseudo_element_from_string(StringView);
 
+enum class AncestorFilterHashType : u8 {
+    TagName,
+    Id,
+    Class,
+};
+
+// NOTE: These hashes are ASCII case-insensitive, since tag names, ids and classes aren't always matched case-sensitively.
+//       This can only cause false positives in the ancestor filter, which are harmless.
+u32 ancestor_filter_hash(AncestorFilterHashType, StringView);
+
 String serialize_a_group_of_selectors(Vector<NonnullRefPtr<Selector>> const& selectors);
 
 }
@@ -9,8 +9,10 @@
 #include <LibWeb/CSS/SelectorEngine.h>
 #include <LibWeb/CSS/StyleProperties.h>
 #include <LibWeb/CSS/ValueID.h>
+#include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/Text.h>
 #include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/HTML/HTMLAnchorElement.h>
@@ -125,11 +127,21 @@ static inline bool matches_indeterminate_pseudo_class(DOM::Element const& elemen
     return false;
 }
 
+// NOTE: This returns a view of the attribute's value rather than a copy, so that selector matching doesn't touch any
+//       ref-counts. That's what lets StyleComputer match selectors on several threads at once.
+static inline StringView attribute_value(DOM::Element const& element, StringView name)
+{
+    auto const* attribute = element.attributes()->get_attribute(name);
+    if (!attribute)
+        return {};
+    return attribute->value().bytes_as_string_view();
+}
+
 static inline bool matches_attribute(CSS::Selector::SimpleSelector::Attribute const& attribute, [[maybe_unused]] Optional<CSS::CSSStyleSheet const&> style_sheet_for_rule, DOM::Element const& element)
 {
     // FIXME: Check the attribute's namespace, once we support that in DOM::Element!
 
-    auto attribute_name = attribute.qualified_name.name.name.to_deprecated_fly_string();
+    auto attribute_name = attribute.qualified_name.name.name.bytes_as_string_view();
 
     if (attribute.match_type == CSS::Selector::SimpleSelector::Attribute::MatchType::HasAttribute) {
         // Early way out in case of an attribute existence selector.
@@ -141,23 +153,26 @@ static inline bool matches_attribute(CSS::Selector::SimpleSelector::Attribute co
         ? CaseSensitivity::CaseInsensitive
         : CaseSensitivity::CaseSensitive;
 
+    auto const element_attr_value = attribute_value(element, attribute_name);
+    auto const match_value = attribute.value.bytes_as_string_view();
+
     switch (attribute.match_type) {
     case CSS::Selector::SimpleSelector::Attribute::MatchType::ExactValueMatch:
         return case_insensitive_match
-            ? Infra::is_ascii_case_insensitive_match(element.deprecated_attribute(attribute_name), attribute.value)
-            : element.deprecated_attribute(attribute_name) == attribute.value.to_deprecated_string();
+            ? Infra::is_ascii_case_insensitive_match(element_attr_value, match_value)
+            : element_attr_value == match_value;
     case CSS::Selector::SimpleSelector::Attribute::MatchType::ContainsWord: {
         if (attribute.value.is_empty()) {
             // This selector is always false is match value is empty.
             return false;
         }
-        auto const view = element.deprecated_attribute(attribute_name).split_view(' ');
+        auto const view = element_attr_value.split_view(' ');
         auto const size = view.size();
         for (size_t i = 0; i < size; ++i) {
             auto const value = view.at(i);
             if (case_insensitive_match
-                    ? Infra::is_ascii_case_insensitive_match(value, attribute.value)
-                    : value == attribute.value) {
+                    ? Infra::is_ascii_case_insensitive_match(value, match_value)
+                    : value == match_value) {
                 return true;
             }
         }
@@ -165,9 +180,8 @@ static inline bool matches_attribute(CSS::Selector::SimpleSelector::Attribute co
     }
     case CSS::Selector::SimpleSelector::Attribute::MatchType::ContainsString:
         return !attribute.value.is_empty()
-            && element.deprecated_attribute(attribute_name).contains(attribute.value, case_sensitivity);
+            && element_attr_value.contains(match_value, case_sensitivity);
     case CSS::Selector::SimpleSelector::Attribute::MatchType::StartsWithSegment: {
-        auto const element_attr_value = element.deprecated_attribute(attribute_name);
         if (element_attr_value.is_empty()) {
             // If the attribute value on element is empty, the selector is true
             // if the match value is also empty and false otherwise.
@@ -178,15 +192,15 @@ static inline bool matches_attribute(CSS::Selector::SimpleSelector::Attribute co
         }
         auto segments = element_attr_value.split_view('-');
         return case_insensitive_match
-            ? Infra::is_ascii_case_insensitive_match(segments.first(), attribute.value)
-            : segments.first() == attribute.value;
+            ? Infra::is_ascii_case_insensitive_match(segments.first(), match_value)
+            : segments.first() == match_value;
     }
     case CSS::Selector::SimpleSelector::Attribute::MatchType::StartsWithString:
         return !attribute.value.is_empty()
-            && element.deprecated_attribute(attribute_name).starts_with(attribute.value, case_sensitivity);
+            && element_attr_value.starts_with(match_value, case_sensitivity);
     case CSS::Selector::SimpleSelector::Attribute::MatchType::EndsWithString:
         return !attribute.value.is_empty()
-            && element.deprecated_attribute(attribute_name).ends_with(attribute.value, case_sensitivity);
+            && element_attr_value.ends_with(match_value, case_sensitivity);
     default:
         break;
     }
@@ -194,6 +208,12 @@ static inline bool matches_attribute(CSS::Selector::SimpleSelector::Attribute co
     return false;
 }
 
+static inline StringView element_namespace(DOM::Element const& element)
+{
+    auto const& namespace_ = element.namespace_uri();
+    return namespace_.has_value() ? namespace_->bytes_as_string_view() : StringView {};
+}
+
 static inline DOM::Element const* previous_sibling_with_same_tag_name(DOM::Element const& element)
 {
     for (auto const* sibling = element.previous_element_sibling(); sibling; sibling = sibling->previous_element_sibling()) {
@@ -542,7 +562,7 @@ static inline bool matches(CSS::Selector::SimpleSelector const& component, Optio
     switch (component.type) {
     case CSS::Selector::SimpleSelector::Type::Universal:
     case CSS::Selector::SimpleSelector::Type::TagName: {
-        auto qualified_name = component.qualified_name();
+        auto const& qualified_name = component.qualified_name();
 
         // Reject if the tag name doesn't match
         if (component.type == CSS::Selector::SimpleSelector::Type::TagName) {
@@ -562,10 +582,10 @@ static inline bool matches(CSS::Selector::SimpleSelector const& component, Optio
             if (!style_sheet_for_rule.has_value() || !style_sheet_for_rule->default_namespace().has_value())
                 return true;
             // "Otherwise it is equivalent to ns|E where ns is the default namespace."
-            return element.namespace_() == style_sheet_for_rule->default_namespace();
+            return element_namespace(element) == style_sheet_for_rule->default_namespace();
         case CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::None:
             // "elements with name E without a namespace"
-            return element.namespace_().is_empty();
+            return element_namespace(element).is_empty();
         case CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Any:
             // "elements with name E in any namespace, including those without a namespace"
             return true;
@@ -578,12 +598,12 @@ static inline bool matches(CSS::Selector::SimpleSelector const& component, Optio
                 return false;
 
             auto selector_namespace = style_sheet_for_rule->namespace_uri(qualified_name.namespace_);
-            return selector_namespace.has_value() && selector_namespace.value() == element.namespace_();
+            return selector_namespace.has_value() && selector_namespace.value() == element_namespace(element);
         }
         VERIFY_NOT_REACHED();
     }
     case CSS::Selector::SimpleSelector::Type::Id:
-        return component.name() == element.deprecated_attribute(HTML::AttributeNames::id).view();
+        return component.name() == attribute_value(element, HTML::AttributeNames::id);
     case CSS::Selector::SimpleSelector::Type::Class:
         return element.has_class(component.name());
     case CSS::Selector::SimpleSelector::Type::Attribute:
@@ -9,6 +9,7 @@
 #include <AK/BinarySearch.h>
 #include <AK/Debug.h>
 #include <AK/Error.h>
+#include <AK/Atomic.h>
 #include <AK/Find.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
@@ -22,6 +23,7 @@
 #include <LibGfx/Font/VectorFont.h>
 #include <LibGfx/Font/WOFF/Font.h>
 #include <LibGfx/Font/WOFF2/Font.h>
+#include <LibThreading/WorkerThread.h>
 #include <LibWeb/CSS/CSSFontFaceRule.h>
 #include <LibWeb/CSS/CSSImportRule.h>
 #include <LibWeb/CSS/CSSStyleRule.h>
@@ -53,8 +55,10 @@
 #include <LibWeb/CSS/StyleValues/TransformationStyleValue.h>
 #include <LibWeb/CSS/StyleValues/UnresolvedStyleValue.h>
 #include <LibWeb/CSS/StyleValues/UnsetStyleValue.h>
+#include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/FontCache.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
@@ -276,74 +280,291 @@ StyleComputer::RuleCache const& StyleComputer::rule_cache_for_cascade_origin(Cas
     }
 }
 
+// NOTE: Like the rest of the rule matching code, this only looks at the element's id and namespace without copying them.
+//       Copying would touch their ref-counts, which isn't safe while matching rules on several threads.
+static StringView element_id(DOM::Element const& element)
+{
+    auto const* id = element.attributes()->get_attribute(HTML::AttributeNames::id);
+    return id ? id->value().bytes_as_string_view() : StringView {};
+}
+
 [[nodiscard]] static bool filter_namespace_rule(DOM::Element const& element, MatchingRule const& rule)
 {
     // FIXME: Filter out non-default namespace using prefixes
     auto namespace_uri = rule.sheet->default_namespace();
-    if (namespace_uri.has_value() && namespace_uri.value() != element.namespace_()) {
-        return false;
+    if (namespace_uri.has_value()) {
+        auto const& element_namespace = element.namespace_uri();
+        if (namespace_uri.value() != (element_namespace.has_value() ? element_namespace->bytes_as_string_view() : StringView {}))
+            return false;
     }
     return true;
 }
 
 Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::Selector::PseudoElement> pseudo_element) const
+{
+    return collect_matching_rules(element, cascade_origin, pseudo_element, m_ancestor_filter, m_statistics, RuleSubset::All);
+}
+
+Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::Selector::PseudoElement> pseudo_element, AncestorFilter const& ancestor_filter, Statistics& statistics, RuleSubset rule_subset) const
 {
     auto const& rule_cache = rule_cache_for_cascade_origin(cascade_origin);
 
     Vector<MatchingRule> rules_to_run;
     auto add_rules_to_run = [&](Vector<MatchingRule> const& rules) {
         rules_to_run.grow_capacity(rules_to_run.size() + rules.size());
-        if (pseudo_element.has_value()) {
-            for (auto const& rule : rules) {
-                if (rule.contains_pseudo_element && filter_namespace_rule(element, rule))
-                    rules_to_run.append(rule);
-            }
-        } else {
-            for (auto const& rule : rules) {
-                if (filter_namespace_rule(element, rule))
-                    rules_to_run.append(rule);
-            }
+        for (auto const& rule : rules) {
+            if (pseudo_element.has_value() && !rule.contains_pseudo_element)
+                continue;
+            if (rule_subset == RuleSubset::MatchableInParallel && !rule.can_be_matched_in_parallel)
+                continue;
+            if (rule_subset == RuleSubset::NotMatchableInParallel && rule.can_be_matched_in_parallel)
+                continue;
+            if (filter_namespace_rule(element, rule))
+                rules_to_run.append(rule);
         }
     };
 
+    // NOTE: The buckets are looked up by string view, since hashing a FlyString caches the hash in its shared data.
     for (auto const& class_name : element.class_names()) {
-        if (auto it = rule_cache.rules_by_class.find(class_name); it != rule_cache.rules_by_class.end())
+        if (auto it = rule_cache.rules_by_class.find(class_name.bytes_as_string_view()); it != rule_cache.rules_by_class.end())
             add_rules_to_run(it->value);
     }
-    if (auto id = element.get_attribute(HTML::AttributeNames::id); id.has_value()) {
-        if (auto it = rule_cache.rules_by_id.find(id.value()); it != rule_cache.rules_by_id.end())
+    if (auto id = element_id(element); !id.is_empty()) {
+        if (auto it = rule_cache.rules_by_id.find(id); it != rule_cache.rules_by_id.end())
             add_rules_to_run(it->value);
     }
-    if (auto it = rule_cache.rules_by_tag_name.find(element.local_name()); it != rule_cache.rules_by_tag_name.end())
+    if (auto it = rule_cache.rules_by_tag_name.find(element.local_name().bytes_as_string_view()); it != rule_cache.rules_by_tag_name.end())
         add_rules_to_run(it->value);
     add_rules_to_run(rule_cache.other_rules);
 
+    statistics.candidate_rules += rules_to_run.size();
+
+    bool const can_use_ancestor_filter = ancestor_filter.applies_to(element);
+
     Vector<MatchingRule> matching_rules;
     matching_rules.ensure_capacity(rules_to_run.size());
     for (auto const& rule_to_run : rules_to_run) {
         auto const& selector = rule_to_run.rule->selectors()[rule_to_run.selector_index];
+        if (can_use_ancestor_filter && ancestor_filter.should_reject(*selector)) {
+            ++statistics.rules_rejected_by_ancestor_filter;
+            continue;
+        }
         if (SelectorEngine::matches(selector, *rule_to_run.sheet, element, pseudo_element))
             matching_rules.append(rule_to_run);
     }
+    statistics.matched_rules += matching_rules.size();
     return matching_rules;
 }
 
+static void for_each_ancestor_filter_hash(DOM::Element const& element, auto callback)
+{
+    callback(ancestor_filter_hash(AncestorFilterHashType::TagName, element.local_name().bytes_as_string_view()));
+    if (auto id = element_id(element); !id.is_empty())
+        callback(ancestor_filter_hash(AncestorFilterHashType::Id, id));
+    for (auto const& class_name : element.class_names())
+        callback(ancestor_filter_hash(AncestorFilterHashType::Class, class_name.bytes_as_string_view()));
+}
+
+void StyleComputer::AncestorFilter::push(DOM::Element const& element)
+{
+    m_ancestors.append(&element);
+    for_each_ancestor_filter_hash(element, [&](u32 hash) { m_filter.increment(hash); });
+}
+
+void StyleComputer::AncestorFilter::pop()
+{
+    auto const* element = m_ancestors.take_last();
+    for_each_ancestor_filter_hash(*element, [&](u32 hash) { m_filter.decrement(hash); });
+}
+
+bool StyleComputer::AncestorFilter::applies_to(DOM::Element const& element) const
+{
+    // NOTE: The filter contains every element on the path from the root to the last pushed ancestor.
+    //       If that's our parent, it's a superset of the ancestors that selector matching can look at.
+    return !m_ancestors.is_empty() && m_ancestors.last() == element.parent();
+}
+
+bool StyleComputer::AncestorFilter::should_reject(Selector const& selector) const
+{
+    for (u32 hash : selector.ancestor_hashes()) {
+        if (hash == 0)
+            break;
+        if (!m_filter.may_contain(hash))
+            return true;
+    }
+    return false;
+}
+
+void StyleComputer::push_ancestor(DOM::Element const& element)
+{
+    m_ancestor_filter.push(element);
+}
+
+void StyleComputer::pop_ancestor(DOM::Element const& element)
+{
+    VERIFY(m_ancestor_filter.innermost_ancestor() == &element);
+    m_ancestor_filter.pop();
+}
+
 static void sort_matching_rules(Vector<MatchingRule>& matching_rules)
 {
     quick_sort(matching_rules, [&](MatchingRule& a, MatchingRule& b) {
-        auto const& a_selector = a.rule->selectors()[a.selector_index];
-        auto const& b_selector = b.rule->selectors()[b.selector_index];
-        auto a_specificity = a_selector->specificity();
-        auto b_specificity = b_selector->specificity();
-        if (a_selector->specificity() == b_selector->specificity()) {
+        if (a.specificity == b.specificity) {
             if (a.style_sheet_index == b.style_sheet_index)
                 return a.rule_index < b.rule_index;
             return a.style_sheet_index < b.style_sheet_index;
         }
-        return a_specificity < b_specificity;
+        return a.specificity < b.specificity;
     });
 }
 
+static Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>>& style_recalc_workers()
+{
+    static Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> workers;
+    return workers;
+}
+
+ErrorOr<void> StyleComputer::set_style_recalc_thread_count(size_t thread_count)
+{
+    auto& workers = style_recalc_workers();
+    workers.clear();
+    if (thread_count <= 1)
+        return {};
+
+    TRY(workers.try_ensure_capacity(thread_count - 1));
+    for (size_t i = 1; i < thread_count; ++i)
+        workers.unchecked_append(TRY(Threading::WorkerThread<Error>::create("Style Worker"sv)));
+    return {};
+}
+
+size_t StyleComputer::style_recalc_thread_count()
+{
+    return style_recalc_workers().size() + 1;
+}
+
+void StyleComputer::match_rules_for_elements(ReadonlySpan<DOM::Element const*> elements, Span<MatchingRuleSet> results, Statistics& statistics) const
+{
+    AncestorFilter ancestor_filter;
+    for (size_t i = 0; i < elements.size(); ++i) {
+        auto const& element = *elements[i];
+
+        // Keep the filter on the path to the element's parent. Since the elements are in tree order, that's usually
+        // just a matter of popping the previous element's subtree. Otherwise, we start over from the root.
+        while (ancestor_filter.innermost_ancestor() && ancestor_filter.innermost_ancestor() != element.parent())
+            ancestor_filter.pop();
+        if (!ancestor_filter.innermost_ancestor()) {
+            Vector<DOM::Element const*, 32> ancestors;
+            for (auto const* ancestor = element.parent_element(); ancestor; ancestor = ancestor->parent_element())
+                ancestors.append(ancestor);
+            for (size_t j = ancestors.size(); j > 0; --j)
+                ancestor_filter.push(*ancestors[j - 1]);
+        }
+
+        auto& result = results[i];
+        result.user_agent_rules = collect_matching_rules(element, CascadeOrigin::UserAgent, {}, ancestor_filter, statistics, RuleSubset::MatchableInParallel);
+        sort_matching_rules(result.user_agent_rules);
+        result.user_rules = collect_matching_rules(element, CascadeOrigin::User, {}, ancestor_filter, statistics, RuleSubset::MatchableInParallel);
+        sort_matching_rules(result.user_rules);
+        result.author_rules = collect_matching_rules(element, CascadeOrigin::Author, {}, ancestor_filter, statistics, RuleSubset::MatchableInParallel);
+        sort_matching_rules(result.author_rules);
+
+        ancestor_filter.push(element);
+    }
+}
+
+void StyleComputer::match_rules_in_parallel(ReadonlySpan<DOM::Element const*> elements) const
+{
+    // Below this, starting the threads takes longer than matching the rules.
+    static constexpr size_t minimum_element_count = 256;
+    static constexpr size_t minimum_elements_per_task = 32;
+    static constexpr size_t tasks_per_thread = 8;
+
+    discard_rules_matched_in_parallel();
+
+    auto& workers = style_recalc_workers();
+    if (workers.is_empty() || elements.size() < minimum_element_count)
+        return;
+
+    build_rule_cache_if_needed();
+
+    m_rules_matched_in_parallel.resize(elements.size());
+    MUST(m_indices_of_rules_matched_in_parallel.try_ensure_capacity(elements.size()));
+    for (size_t i = 0; i < elements.size(); ++i)
+        m_indices_of_rules_matched_in_parallel.set(elements[i], i);
+
+    // The elements are split into runs of consecutive elements, which are mostly whole subtrees, so that each run only
+    // has to set up its ancestor filter once. Threads that run out of work take the next unclaimed run, so threads that
+    // got cheap subtrees keep helping out with the expensive ones.
+    auto thread_count = workers.size() + 1;
+    auto elements_per_task = max(minimum_elements_per_task, ceil_div(elements.size(), thread_count * tasks_per_thread));
+    auto task_count = ceil_div(elements.size(), elements_per_task);
+
+    Atomic<size_t> next_task { 0 };
+    Vector<Statistics> statistics_per_thread;
+    statistics_per_thread.resize(thread_count);
+    auto match_rules = [&](Statistics& statistics) -> ErrorOr<void> {
+        while (true) {
+            auto task = next_task.fetch_add(1);
+            if (task >= task_count)
+                break;
+            auto start = task * elements_per_task;
+            auto count = min(elements_per_task, elements.size() - start);
+            match_rules_for_elements(elements.slice(start, count), m_rules_matched_in_parallel.span().slice(start, count), statistics);
+        }
+        return {};
+    };
+
+    size_t started_workers = 0;
+    for (auto& worker : workers) {
+        if (started_workers + 1 >= task_count)
+            break;
+        auto& statistics = statistics_per_thread[started_workers + 1];
+        auto started = worker->start_task([&] { return match_rules(statistics); });
+        VERIFY(started);
+        ++started_workers;
+    }
+
+    MUST(match_rules(statistics_per_thread[0]));
+    for (size_t i = 0; i < started_workers; ++i)
+        MUST(workers[i]->wait_until_task_is_finished());
+
+    for (auto const& statistics : statistics_per_thread) {
+        m_statistics.candidate_rules += statistics.candidate_rules;
+        m_statistics.rules_rejected_by_ancestor_filter += statistics.rules_rejected_by_ancestor_filter;
+        m_statistics.matched_rules += statistics.matched_rules;
+    }
+    m_statistics.elements_matched_in_parallel += elements.size();
+}
+
+void StyleComputer::discard_rules_matched_in_parallel() const
+{
+    m_indices_of_rules_matched_in_parallel.clear();
+    m_rules_matched_in_parallel.clear();
+}
+
+Optional<StyleComputer::MatchingRuleSet> StyleComputer::take_rules_matched_in_parallel(DOM::Element const& element) const
+{
+    auto index = m_indices_of_rules_matched_in_parallel.take(&element);
+    if (!index.has_value())
+        return {};
+    auto matching_rule_set = move(m_rules_matched_in_parallel[*index]);
+
+    // The rules that couldn't be matched in parallel are left for us to match here.
+    auto add_rules_not_matchable_in_parallel = [&](Vector<MatchingRule>& matching_rules, CascadeOrigin cascade_origin) {
+        if (!rule_cache_for_cascade_origin(cascade_origin).has_rules_not_matchable_in_parallel)
+            return;
+        auto more_matching_rules = collect_matching_rules(element, cascade_origin, {}, m_ancestor_filter, m_statistics, RuleSubset::NotMatchableInParallel);
+        if (more_matching_rules.is_empty())
+            return;
+        matching_rules.extend(move(more_matching_rules));
+        sort_matching_rules(matching_rules);
+    };
+    add_rules_not_matchable_in_parallel(matching_rule_set.user_agent_rules, CascadeOrigin::UserAgent);
+    add_rules_not_matchable_in_parallel(matching_rule_set.user_rules, CascadeOrigin::User);
+    add_rules_not_matchable_in_parallel(matching_rule_set.author_rules, CascadeOrigin::Author);
+    return matching_rule_set;
+}
+
 static void set_property_expanding_shorthands(StyleProperties& style, CSS::PropertyID property_id, StyleValue const& value, DOM::Document& document, CSS::CSSStyleDeclaration const* declaration, StyleProperties::PropertyValues const& properties_for_revert)
 {
     auto set_longhand_property = [&](CSS::PropertyID property_id, StyleValue const& value) {
@@ -1213,12 +1434,16 @@ ErrorOr<void> StyleComputer::compute_cascaded_values(StyleProperties& style, DOM
 {
     // First, we collect all the CSS rules whose selectors match `element`:
     MatchingRuleSet matching_rule_set;
-    matching_rule_set.user_agent_rules = collect_matching_rules(element, CascadeOrigin::UserAgent, pseudo_element);
-    sort_matching_rules(matching_rule_set.user_agent_rules);
-    matching_rule_set.user_rules = collect_matching_rules(element, CascadeOrigin::User, pseudo_element);
-    sort_matching_rules(matching_rule_set.user_rules);
-    matching_rule_set.author_rules = collect_matching_rules(element, CascadeOrigin::Author, pseudo_element);
-    sort_matching_rules(matching_rule_set.author_rules);
+    if (auto rules_matched_in_parallel = pseudo_element.has_value() ? Optional<MatchingRuleSet> {} : take_rules_matched_in_parallel(element); rules_matched_in_parallel.has_value()) {
+        matching_rule_set = rules_matched_in_parallel.release_value();
+    } else {
+        matching_rule_set.user_agent_rules = collect_matching_rules(element, CascadeOrigin::UserAgent, pseudo_element);
+        sort_matching_rules(matching_rule_set.user_agent_rules);
+        matching_rule_set.user_rules = collect_matching_rules(element, CascadeOrigin::User, pseudo_element);
+        sort_matching_rules(matching_rule_set.user_rules);
+        matching_rule_set.author_rules = collect_matching_rules(element, CascadeOrigin::Author, pseudo_element);
+        sort_matching_rules(matching_rule_set.author_rules);
+    }
 
     if (mode == ComputeStyleMode::CreatePseudoElementStyleIfNeeded) {
         VERIFY(pseudo_element.has_value());
@@ -2114,6 +2339,15 @@ ErrorOr<RefPtr<StyleProperties>> StyleComputer::compute_style_impl(DOM::Element&
 {
     build_rule_cache_if_needed();
 
+    ++m_statistics.computed_styles;
+
+    if (mode == ComputeStyleMode::Normal && !pseudo_element.has_value()) {
+        if (auto shared_style = find_style_shareable_with_a_sibling(element)) {
+            ++m_statistics.shared_styles;
+            return shared_style;
+        }
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
@@ -2140,6 +2374,96 @@ ErrorOr<RefPtr<StyleProperties>> StyleComputer::compute_style_impl(DOM::Element&
     return style;
 }
 
+static bool element_is_eligible_for_style_sharing(DOM::Element const& element)
+{
+    // NOTE: Inline style declarations and shadow trees aren't covered by the attribute comparison below,
+    //       so we keep things simple and never share style for those elements.
+    return element.is_html_element() && !element.inline_style() && !element.shadow_root_internal();
+}
+
+static bool elements_have_identical_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.local_name() != b.local_name() || a.namespace_uri() != b.namespace_uri())
+        return false;
+    if (a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    bool identical = true;
+    a.for_each_attribute([&](auto const& name, auto const& value) {
+        if (identical && (!b.has_attribute(name.bytes_as_string_view()) || b.deprecated_get_attribute(name.bytes_as_string_view()) != value))
+            identical = false;
+    });
+    return identical;
+}
+
+bool StyleComputer::style_sharing_is_prevented_by_rules(DOM::Element const& element) const
+{
+    auto any_rule_matches = [&](RuleCache const& rule_cache) {
+        for (auto const& rule : rule_cache.rules_preventing_style_sharing) {
+            auto const& selector = rule.rule->selectors()[rule.selector_index];
+            if (SelectorEngine::matches(selector, *rule.sheet, element))
+                return true;
+        }
+        return false;
+    };
+    return any_rule_matches(*m_user_agent_rule_cache)
+        || any_rule_matches(*m_user_rule_cache)
+        || any_rule_matches(*m_author_rule_cache);
+}
+
+RefPtr<StyleProperties> StyleComputer::find_style_shareable_with_a_sibling(DOM::Element& element) const
+{
+    // NOTE: Siblings are only considered while styling the tree in order (see push_ancestor()),
+    //       since that guarantees that the styles of the previous siblings are up to date.
+    if (!m_ancestor_filter.applies_to(element))
+        return nullptr;
+    if (!element_is_eligible_for_style_sharing(element) || !element.previous_element_sibling())
+        return nullptr;
+
+    // Matching the rules that prevent sharing is the expensive part, so only do it once we've found a candidate.
+    Optional<bool> prevented_by_rules;
+
+    constexpr size_t max_siblings_to_consider = 4;
+    size_t siblings_considered = 0;
+    for (auto* sibling = element.previous_element_sibling(); sibling && siblings_considered < max_siblings_to_consider; sibling = sibling->previous_element_sibling(), ++siblings_considered) {
+        auto const* sibling_style = sibling->computed_css_values();
+        if (!sibling_style || sibling->needs_style_update())
+            continue;
+        if (!element_is_eligible_for_style_sharing(*sibling) || !elements_have_identical_attributes(element, *sibling))
+            continue;
+        if (!prevented_by_rules.has_value())
+            prevented_by_rules = style_sharing_is_prevented_by_rules(element);
+        if (*prevented_by_rules)
+            return nullptr;
+        if (style_sharing_is_prevented_by_rules(*sibling))
+            continue;
+
+        // Animations are tracked per element, so we can't share a style that's being animated.
+        if (auto animation_name = sibling_style->maybe_null_property(PropertyID::AnimationName); animation_name && !(animation_name->is_identifier() && animation_name->to_identifier() == ValueID::None))
+            continue;
+
+        element.set_custom_properties({}, sibling->custom_properties({}));
+        return sibling_style->clone();
+    }
+    return nullptr;
+}
+
+void StyleComputer::did_update_style(Duration elapsed) const
+{
+    ++m_statistics.style_updates;
+    m_statistics.time_spent_in_style_updates += elapsed;
+}
+
+void StyleComputer::dump_statistics() const
+{
+    dbgln("Style update statistics for {}:", m_document->url());
+    dbgln("  Style updates: {} ({} ms)", m_statistics.style_updates, m_statistics.time_spent_in_style_updates.to_milliseconds());
+    dbgln("  Computed styles: {} ({} shared with a sibling)", m_statistics.computed_styles, m_statistics.shared_styles);
+    dbgln("  Elements matched in parallel: {} (on {} threads)", m_statistics.elements_matched_in_parallel, style_recalc_thread_count());
+    dbgln("  Candidate rules: {}", m_statistics.candidate_rules);
+    dbgln("  Rejected by ancestor filter: {}", m_statistics.rules_rejected_by_ancestor_filter);
+    dbgln("  Matched rules: {}", m_statistics.matched_rules);
+}
+
 void StyleComputer::build_rule_cache_if_needed() const
 {
     if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache)
@@ -2147,6 +2471,49 @@ void StyleComputer::build_rule_cache_if_needed() const
     const_cast<StyleComputer&>(*this).build_rule_cache();
 }
 
+// Whether a selector can match one of two siblings with identical attributes but not the other.
+static bool selector_prevents_style_sharing(Selector const& selector)
+{
+    for (auto const& compound_selector : selector.compound_selectors()) {
+        switch (compound_selector.combinator) {
+        case Selector::Combinator::NextSibling:
+        case Selector::Combinator::SubsequentSibling:
+        case Selector::Combinator::Column:
+            return true;
+        default:
+            break;
+        }
+    }
+
+    // NOTE: Pseudo-classes in the other compound selectors apply to ancestors, which the siblings have in common.
+    for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
+        if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+            continue;
+        auto const& pseudo_class = simple_selector.pseudo_class();
+        switch (pseudo_class.type) {
+        case PseudoClass::AnyLink:
+        case PseudoClass::Lang:
+        case PseudoClass::Link:
+        case PseudoClass::LocalLink:
+        case PseudoClass::Root:
+        case PseudoClass::Visited:
+            // These only depend on the element's attributes and ancestors.
+            continue;
+        case PseudoClass::Is:
+        case PseudoClass::Not:
+        case PseudoClass::Where:
+            for (auto const& argument_selector : pseudo_class.argument_selector_list) {
+                if (selector_prevents_style_sharing(*argument_selector))
+                    return true;
+            }
+            continue;
+        default:
+            return true;
+        }
+    }
+    return false;
+}
+
 NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin)
 {
     auto rule_cache = make<RuleCache>();
@@ -2172,6 +2539,10 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                     selector.specificity()
                 };
 
+                matching_rule.can_be_matched_in_parallel = selector.can_be_matched_in_parallel();
+                if (!matching_rule.can_be_matched_in_parallel)
+                    rule_cache->has_rules_not_matchable_in_parallel = true;
+
                 for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
                     if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoElement) {
                         matching_rule.contains_pseudo_element = true;
@@ -2180,6 +2551,10 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                     }
                 }
 
+                // NOTE: Rules for pseudo-elements don't affect the style of the element itself.
+                if (!matching_rule.contains_pseudo_element && selector_prevents_style_sharing(selector))
+                    rule_cache->rules_preventing_style_sharing.append(matching_rule);
+
                 bool added_to_bucket = false;
                 for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
                     if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Id) {
@@ -11,9 +11,11 @@
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/RedBlackTree.h>
+#include <AK/Time.h>
 #include <LibWeb/CSS/CSSFontFaceRule.h>
 #include <LibWeb/CSS/CSSKeyframesRule.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
+#include <LibWeb/CSS/CountingBloomFilter.h>
 #include <LibWeb/CSS/Selector.h>
 #include <LibWeb/CSS/StyleProperties.h>
 #include <LibWeb/FontCache.h>
@@ -29,6 +31,7 @@ struct MatchingRule {
     size_t selector_index { 0 };
     u32 specificity { 0 };
     bool contains_pseudo_element { false };
+    bool can_be_matched_in_parallel { false };
 };
 
 struct FontFaceKey {
@@ -66,6 +69,38 @@ public:
 
     Vector<MatchingRule> collect_matching_rules(DOM::Element const&, CascadeOrigin, Optional<CSS::Selector::PseudoElement>) const;
 
+    // While styling a tree, each element whose descendants are about to be styled is pushed here.
+    // This maintains a Bloom filter of the ancestors' tag names, ids and classes, which lets us reject
+    // selectors that require an ancestor we don't have without walking up the tree.
+    void push_ancestor(DOM::Element const&);
+    void pop_ancestor(DOM::Element const&);
+
+    // Style updates can match rules on several threads before the elements are styled one by one.
+    // A thread count of 0 or 1 turns that off. The worker threads are shared by all documents.
+    static ErrorOr<void> set_style_recalc_thread_count(size_t);
+    static size_t style_recalc_thread_count();
+
+    // Matches the rules for the given elements, which must be in tree order, on the style recalc threads.
+    // compute_style() picks the results up, until discard_rules_matched_in_parallel() is called.
+    // Nothing may change the DOM or the style sheets in the meantime.
+    void match_rules_in_parallel(ReadonlySpan<DOM::Element const*>) const;
+    void discard_rules_matched_in_parallel() const;
+
+    struct Statistics {
+        size_t style_updates { 0 };
+        Duration time_spent_in_style_updates;
+        size_t computed_styles { 0 };
+        size_t shared_styles { 0 };
+        size_t elements_matched_in_parallel { 0 };
+        size_t candidate_rules { 0 };
+        size_t rules_rejected_by_ancestor_filter { 0 };
+        size_t matched_rules { 0 };
+    };
+
+    void did_update_style(Duration elapsed) const;
+    void dump_statistics() const;
+    void reset_statistics() const { m_statistics = {}; }
+
     void invalidate_rule_cache();
 
     Gfx::Font const& initial_font() const;
@@ -149,11 +184,39 @@ private:
         Vector<MatchingRule> author_rules;
     };
 
+    class AncestorFilter {
+    public:
+        void push(DOM::Element const&);
+        void pop();
+
+        DOM::Element const* innermost_ancestor() const { return m_ancestors.is_empty() ? nullptr : m_ancestors.last(); }
+
+        bool applies_to(DOM::Element const&) const;
+        bool should_reject(Selector const&) const;
+
+    private:
+        CountingBloomFilter<u8, 12> m_filter;
+        Vector<DOM::Element const*> m_ancestors;
+    };
+
+    enum class RuleSubset {
+        All,
+        MatchableInParallel,
+        NotMatchableInParallel,
+    };
+
+    Vector<MatchingRule> collect_matching_rules(DOM::Element const&, CascadeOrigin, Optional<CSS::Selector::PseudoElement>, AncestorFilter const&, Statistics&, RuleSubset) const;
+    void match_rules_for_elements(ReadonlySpan<DOM::Element const*>, Span<MatchingRuleSet>, Statistics&) const;
+    Optional<MatchingRuleSet> take_rules_matched_in_parallel(DOM::Element const&) const;
+
     void cascade_declarations(StyleProperties&, DOM::Element&, Optional<CSS::Selector::PseudoElement>, Vector<MatchingRule> const&, CascadeOrigin, Important) const;
 
     void build_rule_cache();
     void build_rule_cache_if_needed() const;
 
+    RefPtr<StyleProperties> find_style_shareable_with_a_sibling(DOM::Element&) const;
+    bool style_sharing_is_prevented_by_rules(DOM::Element const&) const;
+
     JS::NonnullGCPtr<DOM::Document> m_document;
 
     struct AnimationKeyFrameSet {
@@ -170,6 +233,14 @@ private:
         HashMap<FlyString, Vector<MatchingRule>> rules_by_tag_name;
         Vector<MatchingRule> other_rules;
 
+        // Whether any of the rules above has to be matched on the main thread, after the others were matched in parallel.
+        bool has_rules_not_matchable_in_parallel { false };
+
+        // Rules from the buckets above that can match one of two siblings with identical attributes but not the other,
+        // e.g. because they use a sibling combinator, :nth-child() or :hover. Two siblings can only share their style
+        // if none of these rules match either of them.
+        Vector<MatchingRule> rules_preventing_style_sharing;
+
         HashMap<FlyString, NonnullOwnPtr<AnimationKeyFrameSet>> rules_by_animation_keyframes;
     };
 
@@ -182,6 +253,13 @@ private:
     OwnPtr<RuleCache> m_author_rule_cache;
     OwnPtr<RuleCache> m_user_rule_cache;
     OwnPtr<RuleCache> m_user_agent_rule_cache;
+
+    AncestorFilter m_ancestor_filter;
+
+    mutable HashMap<DOM::Element const*, size_t> m_indices_of_rules_matched_in_parallel;
+    mutable Vector<MatchingRuleSet> m_rules_matched_in_parallel;
+
+    mutable Statistics m_statistics;
     JS::Handle<CSSStyleSheet> m_user_style_sheet;
 
     mutable FontCache m_font_cache;
@@ -11,6 +11,7 @@
 #include <AK/Debug.h>
 #include <AK/GenericLexer.h>
 #include <AK/StringBuilder.h>
+#include <AK/Time.h>
 #include <AK/Utf8View.h>
 #include <LibCore/Timer.h>
 #include <LibJS/Runtime/Array.h>
@@ -317,10 +318,13 @@ JS::NonnullGCPtr<Document> Document::create(JS::Realm& realm, AK::URL const& url
     return realm.heap().allocate<Document>(realm, realm, url);
 }
 
+static bool s_incremental_relayout_enabled_by_default = false;
+
 Document::Document(JS::Realm& realm, const AK::URL& url)
     : ParentNode(realm, *this, NodeType::DOCUMENT_NODE)
     , m_style_computer(make<CSS::StyleComputer>(*this))
     , m_url(url)
+    , m_incremental_relayout_enabled(s_incremental_relayout_enabled_by_default)
 {
     HTML::main_thread_event_loop().register_document({}, *this);
 
@@ -905,6 +909,11 @@ AK::URL Document::parse_url(StringView url) const
     return base_url().complete_url(url);
 }
 
+void Document::set_incremental_relayout_enabled_by_default(bool enabled)
+{
+    s_incremental_relayout_enabled_by_default = enabled;
+}
+
 void Document::set_needs_layout()
 {
     if (m_needs_layout)
@@ -957,6 +966,108 @@ static void propagate_overflow_to_viewport(Element& root_element, Layout::Viewpo
     overflow_origin_computed_values.set_overflow_y(CSS::Overflow::Visible);
 }
 
+static bool collect_dirty_relayout_boundaries(Layout::Node& node, Vector<Layout::BlockContainer&>& boundaries)
+{
+    if (node.needs_layout()) {
+        if (!is<Layout::BlockContainer>(node))
+            return false;
+        auto& box = static_cast<Layout::BlockContainer&>(node);
+        if (!box.is_relayout_boundary() || !box.paintable_box())
+            return false;
+        boundaries.append(box);
+        return true;
+    }
+
+    if (!node.child_needs_layout())
+        return true;
+    node.reset_needs_layout();
+
+    for (auto* child = node.first_child(); child; child = child->next_sibling()) {
+        if (!collect_dirty_relayout_boundaries(*child, boundaries))
+            return false;
+    }
+    return true;
+}
+
+static bool relayout_boundary_contains_all_its_descendants(Layout::Box const& boundary)
+{
+    // NOTE: An absolutely positioned descendant whose containing block is outside the boundary would be laid out
+    //       by a formatting context we're not going to run, so we can't relayout the boundary on its own.
+    bool contains_all_descendants = true;
+    boundary.for_each_in_inclusive_subtree_of_type<Layout::Box>([&](Layout::Box const& box) {
+        if (&box == &boundary || !box.is_absolutely_positioned())
+            return IterationDecision::Continue;
+        if (!boundary.is_ancestor_of(*box.containing_block()) && box.containing_block() != &boundary) {
+            contains_all_descendants = false;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return contains_all_descendants;
+}
+
+static void relayout_boundary(Layout::BlockContainer& boundary)
+{
+    Layout::LayoutState layout_state;
+
+    // The boundary itself keeps the geometry from the previous layout, so we seed its used values from there.
+    auto const& paintable_box = *boundary.paintable_box();
+    auto const& box_model = boundary.box_model();
+    auto& box_state = layout_state.get_mutable(boundary);
+    box_state.margin_top = box_model.margin.top;
+    box_state.margin_right = box_model.margin.right;
+    box_state.margin_bottom = box_model.margin.bottom;
+    box_state.margin_left = box_model.margin.left;
+    box_state.border_top = box_model.border.top;
+    box_state.border_right = box_model.border.right;
+    box_state.border_bottom = box_model.border.bottom;
+    box_state.border_left = box_model.border.left;
+    box_state.padding_top = box_model.padding.top;
+    box_state.padding_right = box_model.padding.right;
+    box_state.padding_bottom = box_model.padding.bottom;
+    box_state.padding_left = box_model.padding.left;
+    box_state.inset_top = box_model.inset.top;
+    box_state.inset_right = box_model.inset.right;
+    box_state.inset_bottom = box_model.inset.bottom;
+    box_state.inset_left = box_model.inset.left;
+    box_state.set_content_width(paintable_box.content_width());
+    box_state.set_content_height(paintable_box.content_height());
+
+    {
+        Layout::BlockFormattingContext formatting_context(layout_state, boundary, nullptr);
+        formatting_context.run(
+            boundary,
+            Layout::LayoutMode::Normal,
+            Layout::AvailableSpace(
+                Layout::AvailableSize::make_definite(paintable_box.content_width()),
+                Layout::AvailableSize::make_definite(paintable_box.content_height())));
+    }
+
+    layout_state.commit_relayout_boundary(boundary);
+}
+
+bool Document::relayout_dirty_relayout_boundaries()
+{
+    Vector<Layout::BlockContainer&> boundaries;
+    if (!collect_dirty_relayout_boundaries(*m_layout_root, boundaries))
+        return false;
+
+    for (auto& boundary : boundaries) {
+        if (!relayout_boundary_contains_all_its_descendants(boundary))
+            return false;
+    }
+
+    for (auto& boundary : boundaries) {
+        relayout_boundary(boundary);
+        boundary.for_each_in_inclusive_subtree([](auto& node) {
+            node.reset_needs_layout();
+            return IterationDecision::Continue;
+        });
+    }
+
+    return true;
+}
+
 void Document::update_layout()
 {
     if (!is_active())
@@ -969,7 +1080,7 @@ void Document::update_layout()
 
     update_style();
 
-    if (!m_needs_layout && m_layout_root)
+    if (!m_needs_layout && m_layout_root && !m_layout_root->child_needs_layout())
         return;
 
     // NOTE: If this is a document hosting <template> contents, layout is unnecessary.
@@ -979,6 +1090,12 @@ void Document::update_layout()
     if (!navigable())
         return;
 
+    if (!m_needs_layout && m_layout_root && relayout_dirty_relayout_boundaries()) {
+        invalidate_stacking_context_tree();
+        did_update_layout();
+        return;
+    }
+
     auto viewport_rect = this->viewport_rect();
 
     if (!m_layout_root) {
@@ -1016,6 +1133,16 @@ void Document::update_layout()
 
     layout_state.commit(*m_layout_root);
 
+    m_layout_root->for_each_in_inclusive_subtree([](auto& node) {
+        node.reset_needs_layout();
+        return IterationDecision::Continue;
+    });
+
+    did_update_layout();
+}
+
+void Document::did_update_layout()
+{
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
 
@@ -1039,11 +1166,25 @@ void Document::update_layout()
     Element::RequiredInvalidationAfterStyleChange invalidation;
 
     if (is<Element>(node)) {
-        invalidation |= static_cast<Element&>(node).recompute_style();
+        auto element_invalidation = static_cast<Element&>(node).recompute_style();
+
+        // NOTE: If we're keeping the layout tree, we can mark just this element's layout node as needing layout.
+        //       That lets Document::update_layout() limit the relayout to the nearest relayout boundary.
+        if (element_invalidation.relayout && !element_invalidation.rebuild_layout_tree) {
+            if (auto* layout_node = node.layout_node()) {
+                layout_node->set_needs_layout();
+                element_invalidation.relayout = false;
+            }
+        }
+        invalidation |= element_invalidation;
     }
     node.set_needs_style_update(false);
 
     if (needs_full_style_update || node.child_needs_style_update()) {
+        auto& style_computer = node.document().style_computer();
+        if (node.is_element())
+            style_computer.push_ancestor(static_cast<DOM::Element&>(node));
+
         if (node.is_element()) {
             if (auto* shadow_root = static_cast<DOM::Element&>(node).shadow_root_internal()) {
                 if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update())
@@ -1055,12 +1196,39 @@ void Document::update_layout()
                 invalidation |= update_style_recursively(child);
             return IterationDecision::Continue;
         });
+
+        if (node.is_element())
+            style_computer.pop_ancestor(static_cast<DOM::Element&>(node));
     }
 
     node.set_child_needs_style_update(false);
     return invalidation;
 }
 
+// Collects the elements that update_style_recursively() is going to restyle, in the same order.
+static void collect_elements_needing_style_update(DOM::Node& node, Vector<DOM::Element const*>& elements)
+{
+    bool const needs_full_style_update = node.document().needs_full_style_update();
+
+    if (is<Element>(node))
+        elements.append(static_cast<Element const*>(&node));
+
+    if (!needs_full_style_update && !node.child_needs_style_update())
+        return;
+
+    if (node.is_element()) {
+        if (auto* shadow_root = static_cast<DOM::Element&>(node).shadow_root_internal()) {
+            if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update())
+                collect_elements_needing_style_update(*shadow_root, elements);
+        }
+    }
+    node.for_each_child([&](auto& child) {
+        if (needs_full_style_update || child.needs_style_update() || child.child_needs_style_update())
+            collect_elements_needing_style_update(child, elements);
+        return IterationDecision::Continue;
+    });
+}
+
 void Document::update_style()
 {
     if (!browsing_context())
@@ -1074,7 +1242,15 @@ void Document::update_style()
 
     evaluate_media_rules();
 
+    auto start_time = MonotonicTime::now();
+    if (CSS::StyleComputer::style_recalc_thread_count() > 1) {
+        Vector<DOM::Element const*> elements;
+        collect_elements_needing_style_update(*this, elements);
+        style_computer().match_rules_in_parallel(elements);
+    }
     auto invalidation = update_style_recursively(*this);
+    style_computer().discard_rules_matched_in_parallel();
+    style_computer().did_update_style(MonotonicTime::now() - start_time);
     if (invalidation.rebuild_layout_tree) {
         invalidate_layout();
     } else {
@@ -201,6 +201,12 @@ public:
 
     void set_needs_layout();
 
+    // Relaying out only the dirty relayout boundaries instead of the whole document is still experimental, so it's
+    // off unless asked for. Documents start out with the process-wide default.
+    static void set_incremental_relayout_enabled_by_default(bool);
+    bool incremental_relayout_enabled() const { return m_incremental_relayout_enabled; }
+    void set_incremental_relayout_enabled(bool enabled) { m_incremental_relayout_enabled = enabled; }
+
     void invalidate_layout();
     void invalidate_stacking_context_tree();
 
@@ -546,6 +552,9 @@ private:
 
     void tear_down_layout_tree();
 
+    bool relayout_dirty_relayout_boundaries();
+    void did_update_layout();
+
     void run_unloading_cleanup_steps();
 
     void evaluate_media_rules();
@@ -654,6 +663,7 @@ private:
     Vector<WeakPtr<CSS::MediaQueryList>> m_media_query_lists;
 
     bool m_needs_layout { false };
+    bool m_incremental_relayout_enabled { false };
 
     bool m_needs_full_style_update { false };
 
@@ -13,6 +13,7 @@
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/DocumentLoading.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/Navigable.h>
 #include <LibWeb/HTML/NavigationParams.h>
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
@@ -198,12 +199,48 @@ static bool build_audio_document(DOM::Document& document)
     return true;
 }
 
+// Documents larger than this are handed to the parser one chunk at a time, with a task for every chunk, so that the event
+// loop gets to run (and to render what has been parsed so far) while the rest of the document is still being parsed.
+static constexpr size_t incremental_html_parsing_chunk_size = 256 * KiB;
+
+static void parse_html_document_incrementally(JS::NonnullGCPtr<DOM::Document> document, JS::NonnullGCPtr<HTML::HTMLParser> parser, String input, size_t offset)
+{
+    auto input_bytes = input.bytes();
+    auto chunk_end = min(offset + incremental_html_parsing_chunk_size, input_bytes.size());
+    // Don't split up UTF-8 sequences.
+    while (chunk_end < input_bytes.size() && (input_bytes[chunk_end] & 0xC0) == 0x80)
+        ++chunk_end;
+
+    parser->append_input_and_run(input.bytes_as_string_view().substring_view(offset, chunk_end - offset));
+    if (parser->aborted())
+        return;
+
+    if (chunk_end == input_bytes.size()) {
+        parser->close_input_and_finish();
+        return;
+    }
+
+    HTML::queue_global_task(HTML::Task::Source::Networking, *document, [document, parser, input = move(input), chunk_end]() mutable {
+        parse_html_document_incrementally(document, parser, move(input), chunk_end);
+    });
+}
+
 bool parse_document(DOM::Document& document, ByteBuffer const& data)
 {
     auto& mime_type = document.content_type();
     if (mime_type == "text/html") {
-        auto parser = HTML::HTMLParser::create_with_uncertain_encoding(document, data);
-        parser->run(document.url());
+        if (data.size() <= incremental_html_parsing_chunk_size) {
+            auto parser = HTML::HTMLParser::create_with_uncertain_encoding(document, data);
+            parser->run(document.url());
+            return true;
+        }
+
+        // FIXME: Fetch hands us the whole response body at once. Start parsing as soon as the first chunk of it arrives.
+        auto encoding = document.has_encoding() ? document.encoding()->to_deprecated_string() : HTML::run_encoding_sniffing_algorithm(document, data);
+        auto decoder = TextCodec::decoder_for(encoding);
+        VERIFY(decoder.has_value());
+        auto input = decoder->to_utf8(data).release_value_but_fixme_should_propagate_errors();
+        parse_html_document_incrementally(document, HTML::HTMLParser::create_for_incremental_input(document, encoding), move(input), 0);
         return true;
     }
     if (mime_type.ends_with_bytes("+xml"sv) || mime_type.is_one_of("text/xml", "application/xml"))
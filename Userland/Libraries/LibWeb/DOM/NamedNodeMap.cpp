@@ -157,7 +157,9 @@ Attr const* NamedNodeMap::get_attribute(StringView qualified_name, size_t* item_
 
     // 1. If element is in the HTML namespace and its node document is an HTML document, then set qualifiedName to qualifiedName in ASCII lowercase.
     // FIXME: Handle the second condition, assume it is an HTML document for now.
-    bool compare_as_lowercase = associated_element().namespace_() == Namespace::HTML;
+    // NOTE: This compares the namespace without copying it, which keeps attribute lookups safe for parallel selector matching.
+    auto const& namespace_ = associated_element().namespace_uri();
+    bool compare_as_lowercase = namespace_.has_value() && namespace_->bytes_as_string_view() == Namespace::HTML.view();
 
     // 2. Return the first attribute in element’s attribute list whose qualified name is qualifiedName; otherwise null.
     for (auto const& attribute : m_attributes) {
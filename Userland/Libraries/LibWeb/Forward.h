@@ -530,6 +530,7 @@ class PaintableBox;
 class PaintableWithLines;
 class StackingContext;
 class TextPaintable;
+class TiledCommandExecutor;
 class VideoPaintable;
 class ViewportPaintable;
 
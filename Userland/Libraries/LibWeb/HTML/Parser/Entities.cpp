@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/StdLibExtras.h>
 #include <AK/StringView.h>
 #include <LibWeb/HTML/Parser/Entities.h>
 
@@ -2255,21 +2256,41 @@ Optional<EntityMatch> code_points_from_entity(StringView entity)
         { "vsupne;"sv, 0x0228B, 0x0FE00 },
     };
 
+    if (entity.is_empty())
+        return {};
+
+    // NOTE: Both tables are ordered by the first character of the entity names, and only the entities that start with
+    //       the same character as the input can be a prefix of it, so find those with a binary search.
+    auto for_each_candidate = [&](auto const& entities, auto callback) {
+        auto first_character = entity[0];
+        size_t start = 0;
+        size_t end = array_size(entities);
+        while (start < end) {
+            auto middle = start + (end - start) / 2;
+            if (entities[middle].entity[0] < first_character)
+                start = middle + 1;
+            else
+                end = middle;
+        }
+        for (size_t i = start; i < array_size(entities) && entities[i].entity[0] == first_character; ++i)
+            callback(entities[i]);
+    };
+
     EntityMatch match;
 
-    for (auto& single_code_point_entity : single_code_point_entities) {
+    for_each_candidate(single_code_point_entities, [&](auto const& single_code_point_entity) {
         if (entity.starts_with(single_code_point_entity.entity)) {
             if (match.entity.is_null() || single_code_point_entity.entity.length() > match.entity.length())
                 match = { { single_code_point_entity.code_point }, single_code_point_entity.entity };
         }
-    }
+    });
 
-    for (auto& double_code_point_entity : double_code_point_entities) {
+    for_each_candidate(double_code_point_entities, [&](auto const& double_code_point_entity) {
         if (entity.starts_with(double_code_point_entity.entity)) {
             if (match.entity.is_null() || double_code_point_entity.entity.length() > match.entity.length())
                 match = EntityMatch { { double_code_point_entity.code_point1, double_code_point_entity.code_point2 }, StringView(double_code_point_entity.entity) };
         }
-    }
+    });
 
     if (match.entity.is_empty())
         return {};
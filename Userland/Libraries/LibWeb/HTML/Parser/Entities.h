@@ -18,4 +18,7 @@ struct EntityMatch {
 
 Optional<EntityMatch> code_points_from_entity(StringView);
 
+// The length of "CounterClockwiseContourIntegral;", the longest entity name code_points_from_entity() knows about.
+constexpr size_t longest_entity_name_length = 32;
+
 }
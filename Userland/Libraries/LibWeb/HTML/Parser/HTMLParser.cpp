@@ -220,6 +220,24 @@ void HTMLParser::run(const AK::URL& url)
     m_document->detach_parser({});
 }
 
+void HTMLParser::append_input_and_run(StringView input)
+{
+    if (m_aborted || m_stop_parsing)
+        return;
+    m_tokenizer.append_to_input_stream(input);
+    run();
+}
+
+void HTMLParser::close_input_and_finish()
+{
+    m_tokenizer.close_input_stream();
+    m_document->set_source(m_tokenizer.source());
+    if (!m_aborted && !m_stop_parsing)
+        run();
+    the_end();
+    m_document->detach_parser({});
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#the-end
 void HTMLParser::the_end()
 {
@@ -3830,6 +3848,13 @@ JS::NonnullGCPtr<HTMLParser> HTMLParser::create(DOM::Document& document, StringV
     return document.heap().allocate_without_realm<HTMLParser>(document, input, encoding);
 }
 
+JS::NonnullGCPtr<HTMLParser> HTMLParser::create_for_incremental_input(DOM::Document& document, DeprecatedString const& encoding)
+{
+    auto parser = document.heap().allocate_without_realm<HTMLParser>(document, ""sv, encoding);
+    parser->m_tokenizer.open_input_stream();
+    return parser;
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#html-fragment-serialisation-algorithm
 DeprecatedString HTMLParser::serialize_html_fragment(DOM::Node const& node)
 {
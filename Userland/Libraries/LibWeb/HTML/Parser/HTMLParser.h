@@ -51,10 +51,16 @@ public:
     static JS::NonnullGCPtr<HTMLParser> create_for_scripting(DOM::Document&);
     static JS::NonnullGCPtr<HTMLParser> create_with_uncertain_encoding(DOM::Document&, ByteBuffer const& input);
     static JS::NonnullGCPtr<HTMLParser> create(DOM::Document&, StringView input, DeprecatedString const& encoding);
+    static JS::NonnullGCPtr<HTMLParser> create_for_incremental_input(DOM::Document&, DeprecatedString const& encoding);
 
     void run();
     void run(const AK::URL&);
 
+    // For parsers created with create_for_incremental_input(), whose input (decoded to UTF-8) arrives in chunks.
+    // Every chunk is parsed as far as possible as soon as it's appended, and "the end" runs once the last one is in.
+    void append_input_and_run(StringView);
+    void close_input_and_finish();
+
     DOM::Document& document();
 
     static Vector<JS::Handle<DOM::Node>> parse_html_fragment(DOM::Element& context_element, StringView);
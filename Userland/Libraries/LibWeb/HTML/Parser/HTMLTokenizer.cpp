@@ -5,9 +5,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/GenericShorthands.h>
+#include <AK/SIMD.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
@@ -21,8 +23,15 @@ namespace Web::HTML {
 
 #pragma GCC diagnostic ignored "-Wunused-label"
 
-#define CONSUME_NEXT_INPUT_CHARACTER \
-    current_input_character = next_code_point();
+#define RETURN_IF_OUT_OF_INPUT                 \
+    do {                                       \
+        if (m_ran_out_of_input) [[unlikely]]   \
+            return rewind_to_start_of_token(); \
+    } while (0)
+
+#define CONSUME_NEXT_INPUT_CHARACTER             \
+    current_input_character = next_code_point(); \
+    RETURN_IF_OUT_OF_INPUT
 
 #define SWITCH_TO(new_state)                       \
     do {                                           \
@@ -49,7 +58,7 @@ namespace Web::HTML {
     do {                                \
         will_switch_to(m_return_state); \
         m_state = m_return_state;       \
-        goto _StartOfFunction;          \
+        goto _StartOfStateMachine;      \
     } while (0)
 
 #define RECONSUME_IN_RETURN_STATE                \
@@ -58,7 +67,7 @@ namespace Web::HTML {
         m_state = m_return_state;                \
         if (current_input_character.has_value()) \
             restore_to(m_prev_utf8_iterator);    \
-        goto _StartOfFunction;                   \
+        goto _StartOfStateMachine;               \
     } while (0)
 
 #define SWITCH_TO_AND_EMIT_CURRENT_TOKEN(new_state)     \
@@ -156,6 +165,26 @@ namespace Web::HTML {
 #define EMIT_CURRENT_CHARACTER \
     EMIT_CHARACTER(current_input_character.value());
 
+// Emits the current input character, along with the run of input characters after it that the current state would
+// emit one by one as well, i.e. everything up to the next of the given stop characters.
+#define EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL(...)                                               \
+    do {                                                                                        \
+        create_new_token(HTMLToken::Type::Character);                                           \
+        m_current_token.set_code_point(current_input_character.value());                        \
+        m_queued_tokens.enqueue(move(m_current_token));                                         \
+        auto position_before_run = m_source_positions.last();                                   \
+        queue_character_tokens(consume_run_of_characters_until(__VA_ARGS__), position_before_run); \
+        return m_queued_tokens.dequeue();                                                       \
+    } while (0)
+
+// Appends the current input character to the current builder, along with the run of input characters after it that
+// the current state would append one by one as well, i.e. everything up to the next of the given stop characters.
+#define APPEND_CURRENT_CHARACTER_AND_RUN_UNTIL(...)                                  \
+    do {                                                                             \
+        m_current_builder.append_code_point(current_input_character.value());        \
+        m_current_builder.append(consume_run_of_characters_until(__VA_ARGS__));      \
+    } while (0)
+
 #define SWITCH_TO_AND_EMIT_CHARACTER(code_point, new_state) \
     do {                                                    \
         will_switch_to(State::new_state);                   \
@@ -186,9 +215,20 @@ static inline void log_parse_error(SourceLocation const& location = SourceLocati
 
 Optional<u32> HTMLTokenizer::next_code_point()
 {
+    if (needs_more_input(1)) {
+        m_ran_out_of_input = true;
+        return {};
+    }
+
     if (m_utf8_iterator == m_utf8_view.end())
         return {};
 
+    // A CR at the end of the available input might be followed by an LF that hasn't arrived yet.
+    if (*m_utf8_iterator == '\r' && needs_more_input(2)) {
+        m_ran_out_of_input = true;
+        return {};
+    }
+
     u32 code_point;
     // https://html.spec.whatwg.org/multipage/parsing.html#preprocessing-the-input-stream:tokenization
     // https://infra.spec.whatwg.org/#normalize-newlines
@@ -255,15 +295,19 @@ Optional<HTMLToken> HTMLTokenizer::next_token()
         m_source_positions.clear_with_capacity();
         m_source_positions.append(move(last_position));
     }
-_StartOfFunction:
     if (!m_queued_tokens.is_empty())
         return m_queued_tokens.dequeue();
 
     if (m_aborted)
         return {};
 
+    if (!m_input_stream_closed)
+        save_start_of_token();
+
+_StartOfStateMachine:
     for (;;) {
         auto current_input_character = next_code_point();
+        RETURN_IF_OUT_OF_INPUT;
         switch (m_state) {
             // 13.2.5.1 Data state, https://html.spec.whatwg.org/multipage/parsing.html#data-state
             BEGIN_STATE(Data)
@@ -288,7 +332,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL('&', '<', '\0', '\r');
                 }
             }
             END_STATE
@@ -429,6 +473,7 @@ _StartOfFunction:
                         SWITCH_TO_WITH_UNCLEAN_BUILDER(BogusComment);
                     }
                 }
+                RETURN_IF_OUT_OF_INPUT;
                 ANYTHING_ELSE
                 {
                     log_parse_error();
@@ -604,6 +649,7 @@ _StartOfFunction:
                     if (to_ascii_uppercase(current_input_character.value()) == 'S' && consume_next_if_match("YSTEM"sv, CaseSensitivity::CaseInsensitive)) {
                         SWITCH_TO(AfterDOCTYPESystemKeyword);
                     }
+                    RETURN_IF_OUT_OF_INPUT;
                     log_parse_error();
                     m_current_token.ensure_doctype_data().force_quirks = true;
                     RECONSUME_IN(BogusDOCTYPE);
@@ -1259,7 +1305,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_RUN_UNTIL('"', '&', '\0', '\r');
                     continue;
                 }
             }
@@ -1291,7 +1337,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_RUN_UNTIL('\'', '&', '\0', '\r');
                     continue;
                 }
             }
@@ -1642,7 +1688,14 @@ _StartOfFunction:
             {
                 size_t byte_offset = m_utf8_view.byte_offset_of(m_prev_utf8_iterator);
 
-                auto match = HTML::code_points_from_entity(m_decoded_input.substring_view(byte_offset, m_decoded_input.length() - byte_offset));
+                // Make sure that the longest entity name that could match has arrived, as well as the character after it.
+                // (The first character of the name has already been consumed.)
+                if (needs_more_input(longest_entity_name_length)) {
+                    m_ran_out_of_input = true;
+                    return rewind_to_start_of_token();
+                }
+
+                auto match = HTML::code_points_from_entity(m_decoded_input.string_view().substring_view(byte_offset));
 
                 if (match.has_value()) {
                     skip(match->entity.length() - 1);
@@ -1898,7 +1951,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL('&', '<', '\0', '\r');
                 }
             }
             END_STATE
@@ -2017,7 +2070,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL('<', '\0', '\r');
                 }
             }
             END_STATE
@@ -2136,7 +2189,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL('<', '\0', '\r');
                 }
             }
             END_STATE
@@ -2155,7 +2208,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_RUN_UNTIL('\0', '\r');
                 }
             }
             END_STATE
@@ -2754,8 +2807,12 @@ bool HTMLTokenizer::consume_next_if_match(StringView string, CaseSensitivity cas
 {
     for (size_t i = 0; i < string.length(); ++i) {
         auto code_point = peek_code_point(i);
-        if (!code_point.has_value())
+        if (!code_point.has_value()) {
+            // The rest of the string might still arrive.
+            if (!m_input_stream_closed)
+                m_ran_out_of_input = true;
             return false;
+        }
         // FIXME: This should be more Unicode-aware.
         if (case_sensitivity == CaseSensitivity::CaseInsensitive) {
             if (code_point.value() < 0x80) {
@@ -2781,8 +2838,7 @@ void HTMLTokenizer::create_new_token(HTMLToken::Type type)
 
 HTMLTokenizer::HTMLTokenizer()
 {
-    m_decoded_input = "";
-    m_utf8_view = Utf8View(m_decoded_input);
+    m_utf8_view = Utf8View(m_decoded_input.string_view());
     m_utf8_iterator = m_utf8_view.begin();
     m_prev_utf8_iterator = m_utf8_view.begin();
     m_source_positions.empend(0u, 0u);
@@ -2792,26 +2848,174 @@ HTMLTokenizer::HTMLTokenizer(StringView input, DeprecatedString const& encoding)
 {
     auto decoder = TextCodec::decoder_for(encoding);
     VERIFY(decoder.has_value());
-    m_decoded_input = decoder->to_utf8(input).release_value_but_fixme_should_propagate_errors().to_deprecated_string();
-    m_utf8_view = Utf8View(m_decoded_input);
+    m_decoded_input.append(decoder->to_utf8(input).release_value_but_fixme_should_propagate_errors());
+    m_utf8_view = Utf8View(m_decoded_input.string_view());
     m_utf8_iterator = m_utf8_view.begin();
     m_prev_utf8_iterator = m_utf8_view.begin();
     m_source_positions.empend(0u, 0u);
 }
 
+void HTMLTokenizer::did_change_input(size_t iterator_byte_offset, size_t previous_iterator_byte_offset)
+{
+    m_utf8_view = Utf8View(m_decoded_input.string_view());
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(iterator_byte_offset);
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(previous_iterator_byte_offset);
+}
+
+void HTMLTokenizer::append_to_input_stream(StringView input)
+{
+    VERIFY(!m_input_stream_closed);
+    if (m_aborted)
+        return;
+
+    auto iterator_byte_offset = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto previous_iterator_byte_offset = m_utf8_view.byte_offset_of(m_prev_utf8_iterator);
+    m_decoded_input.append(input);
+    did_change_input(iterator_byte_offset, previous_iterator_byte_offset);
+    m_ran_out_of_input = false;
+}
+
+void HTMLTokenizer::close_input_stream()
+{
+    m_input_stream_closed = true;
+    m_ran_out_of_input = false;
+}
+
+bool HTMLTokenizer::needs_more_input(size_t byte_count) const
+{
+    if (m_input_stream_closed)
+        return false;
+    return m_utf8_view.byte_length() - m_utf8_view.byte_offset_of(m_utf8_iterator) < byte_count;
+}
+
+void HTMLTokenizer::save_start_of_token()
+{
+    VERIFY(m_queued_tokens.is_empty());
+    m_start_of_token = {
+        .state = m_state,
+        .return_state = m_return_state,
+        .byte_offset = m_utf8_view.byte_offset_of(m_utf8_iterator),
+        .previous_byte_offset = m_utf8_view.byte_offset_of(m_prev_utf8_iterator),
+        .position = m_source_positions.last(),
+    };
+    m_ran_out_of_input = false;
+}
+
+// NOTE: No token is ever halfway done when next_token() returns, so going back to where the current call started
+//       tokenizing undoes everything that was done on the way to the token that couldn't be completed.
+Optional<HTMLToken> HTMLTokenizer::rewind_to_start_of_token()
+{
+    VERIFY(m_ran_out_of_input);
+    dbgln_if(TOKENIZER_TRACE_DEBUG, "[{}] Ran out of input, rewinding to the start of the token", state_name(m_state));
+
+    m_state = m_start_of_token.state;
+    m_return_state = m_start_of_token.return_state;
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(m_start_of_token.byte_offset);
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(m_start_of_token.previous_byte_offset);
+    m_source_positions.clear_with_capacity();
+    m_source_positions.append(m_start_of_token.position);
+
+    m_queued_tokens.clear();
+    m_current_token = {};
+    m_current_builder.clear();
+    return {};
+}
+
+static void advance_position(HTMLToken::Position& position, Utf8CodePointIterator const& it)
+{
+    if (*it == '\n') {
+        position.column = 0;
+        position.line++;
+    } else {
+        position.column++;
+    }
+    position.byte_offset += it.underlying_code_point_length_in_bytes();
+}
+
+// Returns the number of bytes at the start of the input that aren't any of the given (ASCII) stop characters,
+// comparing 16 bytes at a time.
+template<typename... StopCharacters>
+static size_t length_of_run_until(ReadonlyBytes input, StopCharacters... stop_characters)
+{
+    using AK::SIMD::u8x16;
+
+    size_t offset = 0;
+    for (; offset + sizeof(u8x16) <= input.size(); offset += sizeof(u8x16)) {
+        u8x16 bytes;
+        __builtin_memcpy(&bytes, input.offset(offset), sizeof(bytes));
+        auto matches = ((bytes == static_cast<u8>(stop_characters)) | ...);
+        auto matches_as_words = bit_cast<AK::SIMD::u64x2>(matches);
+        if ((matches_as_words[0] | matches_as_words[1]) != 0)
+            break;
+    }
+    for (; offset < input.size(); ++offset) {
+        if (((input[offset] == static_cast<u8>(stop_characters)) || ...))
+            break;
+    }
+    return offset;
+}
+
+// Consumes the input characters up to (but not including) the next one of the given stop characters, for states that
+// would otherwise consume them one by one and treat them all the same. CR always has to be one of the stop characters,
+// so that newlines still get normalized. Since the stop characters are ASCII, they can't appear in the middle of a
+// multi-byte UTF-8 sequence, and the input can be searched for them byte by byte.
+template<typename... StopCharacters>
+StringView HTMLTokenizer::consume_run_of_characters_until(StopCharacters... stop_characters)
+{
+    // NOTE: Input inserted by document.write() has to stop being tokenized at the insertion point, so just don't bother.
+    if (m_insertion_point.defined)
+        return {};
+
+    auto byte_offset = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto input = m_decoded_input.string_view().bytes().slice(byte_offset);
+    auto run_length = length_of_run_until(input, stop_characters...);
+    if (run_length == 0)
+        return {};
+    auto run = StringView { input.trim(run_length) };
+
+    // Keep track of the position before the last character in the run as well as the one after it, which is what
+    // consuming the characters one by one would have left at the end of m_source_positions.
+    auto position = m_source_positions.last();
+    auto position_before_last_character = position;
+    size_t byte_offset_of_last_character = 0;
+    Utf8View run_view { run };
+    for (auto it = run_view.begin(); it != run_view.end(); ++it) {
+        position_before_last_character = position;
+        byte_offset_of_last_character = run_view.byte_offset_of(it);
+        advance_position(position, it);
+    }
+    m_source_positions.append(position_before_last_character);
+    m_source_positions.append(position);
+
+    did_change_input(byte_offset + run_length, byte_offset + byte_offset_of_last_character);
+    return run;
+}
+
+void HTMLTokenizer::queue_character_tokens(StringView run, HTMLToken::Position position)
+{
+    Utf8View run_view { run };
+    for (auto it = run_view.begin(); it != run_view.end(); ++it) {
+        advance_position(position, it);
+        auto token = HTMLToken::make_character(*it);
+        token.set_start_position({}, position);
+        m_queued_tokens.enqueue(move(token));
+    }
+}
+
 void HTMLTokenizer::insert_input_at_insertion_point(StringView input)
 {
     auto utf8_iterator_byte_offset = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto previous_utf8_iterator_byte_offset = m_utf8_view.byte_offset_of(m_prev_utf8_iterator);
 
     // FIXME: Implement a InputStream to handle insertion_point and iterators.
+    auto old_input = m_decoded_input.string_view();
     StringBuilder builder {};
-    builder.append(m_decoded_input.substring(0, m_insertion_point.position));
+    builder.append(old_input.substring_view(0, m_insertion_point.position));
     builder.append(input);
-    builder.append(m_decoded_input.substring(m_insertion_point.position));
-    m_decoded_input = builder.to_deprecated_string();
+    builder.append(old_input.substring_view(m_insertion_point.position));
+    m_decoded_input = move(builder);
 
-    m_utf8_view = Utf8View(m_decoded_input);
-    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset(utf8_iterator_byte_offset);
+    did_change_input(utf8_iterator_byte_offset, previous_utf8_iterator_byte_offset);
 
     m_insertion_point.position += input.length();
 }
@@ -124,7 +124,15 @@ public:
     void set_blocked(bool b) { m_blocked = b; }
     bool is_blocked() const { return m_blocked; }
 
-    DeprecatedString source() const { return m_decoded_input; }
+    DeprecatedString source() const { return m_decoded_input.to_deprecated_string(); }
+
+    // While the input stream is open, more input can be appended to it. Running out of input then makes next_token()
+    // return nothing instead of an end-of-file token, and tokenization picks up where it left off once more input
+    // has been appended. The input stream of a tokenizer that was created with its input is closed from the start.
+    void open_input_stream() { m_input_stream_closed = false; }
+    void append_to_input_stream(StringView input);
+    void close_input_stream();
+    bool is_input_stream_closed() const { return m_input_stream_closed; }
 
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
@@ -152,6 +160,9 @@ private:
     Optional<u32> next_code_point();
     Optional<u32> peek_code_point(size_t offset) const;
     bool consume_next_if_match(StringView, CaseSensitivity = CaseSensitivity::CaseSensitive);
+    template<typename... StopCharacters>
+    StringView consume_run_of_characters_until(StopCharacters...);
+    void queue_character_tokens(StringView run, HTMLToken::Position position_before_run);
     void create_new_token(HTMLToken::Type);
     bool current_end_tag_token_is_appropriate() const;
     DeprecatedString consume_current_builder();
@@ -175,6 +186,11 @@ private:
     bool consumed_as_part_of_an_attribute() const;
 
     void restore_to(Utf8CodePointIterator const& new_iterator);
+    void did_change_input(size_t iterator_byte_offset, size_t previous_iterator_byte_offset);
+
+    bool needs_more_input(size_t byte_count) const;
+    void save_start_of_token();
+    Optional<HTMLToken> rewind_to_start_of_token();
     HTMLToken::Position nth_last_position(size_t n = 0);
 
     JS::GCPtr<HTMLParser> m_parser;
@@ -184,7 +200,7 @@ private:
 
     Vector<u32> m_temporary_buffer;
 
-    DeprecatedString m_decoded_input;
+    StringBuilder m_decoded_input;
 
     struct InsertionPoint {
         size_t position { 0 };
@@ -203,6 +219,18 @@ private:
     Optional<DeprecatedString> m_last_emitted_start_tag_name;
 
     bool m_explicit_eof_inserted { false };
+    bool m_input_stream_closed { true };
+    bool m_ran_out_of_input { false };
+
+    // Where tokenization of the current token started, to go back to when the input runs out before the token is complete.
+    struct StartOfToken {
+        State state { State::Data };
+        State return_state { State::Data };
+        size_t byte_offset { 0 };
+        size_t previous_byte_offset { 0 };
+        HTMLToken::Position position;
+    };
+    StartOfToken m_start_of_token;
     bool m_has_emitted_eof { false };
 
     Queue<HTMLToken> m_queued_tokens;
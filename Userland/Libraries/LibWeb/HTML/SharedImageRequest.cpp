@@ -133,24 +133,16 @@ void SharedImageRequest::handle_successful_fetch(AK::URL const& url_string, Stri
 
     bool const is_svg_image = mime_type == "image/svg+xml"sv || url_string.basename().ends_with(".svg"sv);
 
-    RefPtr<DecodedImageData> image_data;
-
-    auto handle_failed_decode = [&] {
-        m_state = State::Failed;
-        for (auto& callback : m_callbacks) {
-            if (callback.on_fail)
-                callback.on_fail->function()();
-        }
-    };
-
     if (is_svg_image) {
         auto result = SVG::SVGDecodedImageData::create(m_page, url_string, data);
         if (result.is_error())
             return handle_failed_decode();
 
-        image_data = result.release_value();
-    } else {
-        auto result = Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes());
+        return handle_successful_decode(result.release_value());
+    }
+
+    // Bitmap images may be decoded in the background, so keep ourselves alive until that's done.
+    Web::Platform::ImageCodecPlugin::the().start_decoding_image(data.bytes(), [this, strong_this = JS::make_handle(*this)](auto result) {
         if (!result.has_value())
             return handle_failed_decode();
 
@@ -161,9 +153,12 @@ void SharedImageRequest::handle_successful_fetch(AK::URL const& url_string, Stri
                 .duration = static_cast<int>(frame.duration),
             });
         }
-        image_data = AnimatedBitmapDecodedImageData::create(move(frames), result.value().loop_count, result.value().is_animated).release_value_but_fixme_should_propagate_errors();
-    }
+        handle_successful_decode(AnimatedBitmapDecodedImageData::create(move(frames), result.value().loop_count, result.value().is_animated).release_value_but_fixme_should_propagate_errors());
+    });
+}
 
+void SharedImageRequest::handle_successful_decode(NonnullRefPtr<DecodedImageData> image_data)
+{
     m_image_data = move(image_data);
 
     m_state = State::Finished;
@@ -175,6 +170,15 @@ void SharedImageRequest::handle_successful_fetch(AK::URL const& url_string, Stri
     m_callbacks.clear();
 }
 
+void SharedImageRequest::handle_failed_decode()
+{
+    m_state = State::Failed;
+    for (auto& callback : m_callbacks) {
+        if (callback.on_fail)
+            callback.on_fail->function()();
+    }
+}
+
 void SharedImageRequest::handle_failed_fetch()
 {
     m_state = State::Failed;
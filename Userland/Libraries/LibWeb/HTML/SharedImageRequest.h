@@ -46,6 +46,8 @@ private:
 
     void handle_successful_fetch(AK::URL const&, StringView mime_type, ByteBuffer data);
     void handle_failed_fetch();
+    void handle_successful_decode(NonnullRefPtr<DecodedImageData>);
+    void handle_failed_decode();
 
     enum class State {
         New,
@@ -45,6 +45,7 @@ private:
     virtual JS::ThrowCompletionOr<Optional<JS::PropertyDescriptor>> internal_get_own_property(JS::PropertyKey const& property_name) const override;
 
     virtual bool may_interfere_with_indexed_property_access() const final { return true; }
+    virtual bool has_exotic_internal_methods() const final { return true; }
 
     JS::MarkedVector<JS::NonnullGCPtr<VideoTrack>> m_video_tracks;
 };
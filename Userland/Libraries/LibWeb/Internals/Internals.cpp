@@ -7,6 +7,7 @@
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/Window.h>
@@ -58,4 +59,16 @@ JS::Object* Internals::hit_test(double x, double y)
     return nullptr;
 }
 
+void Internals::set_incremental_relayout_enabled(bool enabled)
+{
+    global_object().associated_document().set_incremental_relayout_enabled(enabled);
+}
+
+WebIDL::ExceptionOr<void> Internals::set_style_recalc_thread_count(u32 count)
+{
+    if (auto result = CSS::StyleComputer::set_style_recalc_thread_count(count); result.is_error())
+        return vm().throw_completion<JS::InternalError>(MUST(String::formatted("Unable to start style recalc threads: {}", result.error())));
+    return {};
+}
+
 }
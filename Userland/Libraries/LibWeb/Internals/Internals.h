@@ -7,6 +7,7 @@
 #pragma once
 
 #include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/WebIDL/ExceptionOr.h>
 
 namespace Web::Internals {
 
@@ -21,6 +22,9 @@ public:
     void gc();
     JS::Object* hit_test(double x, double y);
 
+    void set_incremental_relayout_enabled(bool);
+    WebIDL::ExceptionOr<void> set_style_recalc_thread_count(u32);
+
 private:
     explicit Internals(JS::Realm&);
     virtual void initialize(JS::Realm&) override;
@@ -60,6 +60,32 @@ bool Box::is_user_scrollable() const
     return computed_values().overflow_y() == CSS::Overflow::Scroll || computed_values().overflow_y() == CSS::Overflow::Auto;
 }
 
+static bool size_is_independent_of_layout(CSS::Size const& size)
+{
+    return size.is_auto() || size.is_length() || size.is_none();
+}
+
+bool Box::is_relayout_boundary() const
+{
+    // NOTE: We only consider block-level block containers that establish an independent BFC, have a fixed size in
+    //       both axes and clip their overflow. Such a box can be laid out on its own, and nothing inside it
+    //       can change its size or leak out into the layout of its ancestors.
+    if (is_viewport() || is_root_element() || !is_block_container() || is_replaced_box())
+        return false;
+    if (!display().is_block_outside() || is_flex_item() || is_grid_item())
+        return false;
+    if (FormattingContext::formatting_context_type_created_by_box(*this) != FormattingContext::Type::Block)
+        return false;
+    if (computed_values().overflow_x() == CSS::Overflow::Visible || computed_values().overflow_y() == CSS::Overflow::Visible)
+        return false;
+    if (!computed_values().width().is_length() || !computed_values().height().is_length())
+        return false;
+    return size_is_independent_of_layout(computed_values().min_width())
+        && size_is_independent_of_layout(computed_values().max_width())
+        && size_is_independent_of_layout(computed_values().min_height())
+        && size_is_independent_of_layout(computed_values().max_height());
+}
+
 void Box::set_needs_display()
 {
     if (!navigable())
@@ -56,6 +56,10 @@ public:
 
     bool is_user_scrollable() const;
 
+    // A relayout boundary is a box whose size and position can't be affected by anything inside it,
+    // which lets us lay out its contents again without touching the rest of the tree.
+    bool is_relayout_boundary() const;
+
 protected:
     Box(DOM::Document&, DOM::Node*, NonnullRefPtr<CSS::StyleProperties>);
     Box(DOM::Document&, DOM::Node*, CSS::ComputedValues);
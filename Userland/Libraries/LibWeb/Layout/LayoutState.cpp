@@ -214,6 +214,14 @@ static void build_paint_tree(Node& node, Painting::Paintable* parent_paintable =
     }
 }
 
+static void detach_text_paintables(Box& root)
+{
+    root.for_each_in_inclusive_subtree_of_type<Layout::TextNode>([&](Layout::TextNode& text_node) {
+        text_node.set_paintable(nullptr);
+        return IterationDecision::Continue;
+    });
+}
+
 void LayoutState::commit(Box& root)
 {
     // Only the top-level LayoutState should ever be committed.
@@ -222,15 +230,52 @@ void LayoutState::commit(Box& root)
     // NOTE: In case this is a relayout of an existing tree, we start by detaching the old paint tree
     //       from the layout tree. This is done to ensure that we don't end up with any old-tree pointers
     //       when text paintables shift around in the tree.
-    root.for_each_in_inclusive_subtree_of_type<Layout::TextNode>([&](Layout::TextNode& text_node) {
-        text_node.set_paintable(nullptr);
-        return IterationDecision::Continue;
-    });
+    detach_text_paintables(root);
 
-    HashTable<Layout::TextNode*> text_nodes;
+    Vector<Painting::PaintableWithLines&> paintables_with_lines;
+    transfer_used_values_to_paintables(paintables_with_lines);
+    build_paintables_for_text_and_measure_overflow(root, paintables_with_lines);
+}
+
+void LayoutState::commit_relayout_boundary(Box& boundary)
+{
+    // Only the top-level LayoutState should ever be committed.
+    VERIFY(!m_parent);
+
+    auto& boundary_paintable = *boundary.paintable_box();
+
+    // NOTE: Laying out the boundary's insides also creates used values for its ancestors (e.g. to resolve
+    //       the containing block of the boundary). Those are placeholders, and everything outside the boundary
+    //       keeps the paintables and metrics from the previous layout, so we throw them away here.
+    Vector<Layout::Node const*> nodes_outside_boundary;
+    for (auto& it : used_values_per_layout_node) {
+        if (!boundary.is_ancestor_of(*it.key))
+            nodes_outside_boundary.append(it.key);
+    }
+    auto boundary_used_values = used_values_per_layout_node.take(&boundary);
+    for (auto const* node : nodes_outside_boundary)
+        used_values_per_layout_node.remove(node);
+
+    detach_text_paintables(boundary);
+
+    while (auto* child = boundary_paintable.first_child())
+        boundary_paintable.remove_child(*child);
+    boundary_paintable.reset_overflow_data();
 
     Vector<Painting::PaintableWithLines&> paintables_with_lines;
+    if (is<Painting::PaintableWithLines>(boundary_paintable) && boundary_used_values.has_value()) {
+        auto& paintable_with_lines = static_cast<Painting::PaintableWithLines&>(boundary_paintable);
+        paintable_with_lines.set_line_boxes(move(boundary_used_values.value()->line_boxes));
+        paintables_with_lines.append(paintable_with_lines);
+    }
+
+    transfer_used_values_to_paintables(paintables_with_lines);
+    build_paintables_for_text_and_measure_overflow(boundary, paintables_with_lines);
+    measure_scrollable_overflow(boundary);
+}
 
+void LayoutState::transfer_used_values_to_paintables(Vector<Painting::PaintableWithLines&>& paintables_with_lines)
+{
     for (auto& it : used_values_per_layout_node) {
         auto& used_values = *it.value;
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
@@ -267,6 +312,11 @@ void LayoutState::commit(Box& root)
             }
         }
     }
+}
+
+void LayoutState::build_paintables_for_text_and_measure_overflow(Box& root, Vector<Painting::PaintableWithLines&> const& paintables_with_lines)
+{
+    HashTable<Layout::TextNode*> text_nodes;
 
     resolve_relative_positions(paintables_with_lines);
 
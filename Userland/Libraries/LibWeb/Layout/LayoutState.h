@@ -151,6 +151,10 @@ struct LayoutState {
     // Commits the used values produced by layout and builds a paintable tree.
     void commit(Box& root);
 
+    // Commits the used values produced by laying out the insides of a relayout boundary.
+    // The boundary keeps its paintable, while everything inside it gets a fresh paintable subtree.
+    void commit_relayout_boundary(Box& boundary);
+
     // NOTE: get_mutable() will CoW the UsedValues if it's inherited from an ancestor state;
     UsedValues& get_mutable(NodeWithStyle const&);
 
@@ -175,7 +179,9 @@ struct LayoutState {
     LayoutState const& m_root;
 
 private:
+    void transfer_used_values_to_paintables(Vector<Painting::PaintableWithLines&>&);
     void resolve_relative_positions(Vector<Painting::PaintableWithLines&> const&);
+    void build_paintables_for_text_and_measure_overflow(Box& root, Vector<Painting::PaintableWithLines&> const&);
 };
 
 }
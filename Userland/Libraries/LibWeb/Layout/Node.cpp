@@ -243,6 +243,31 @@ void Node::set_needs_display()
     });
 }
 
+void Node::set_needs_layout()
+{
+    if (!document().incremental_relayout_enabled()) {
+        document().set_needs_layout();
+        return;
+    }
+
+    m_needs_layout = true;
+
+    // NOTE: A change to this node can only affect the layout of its containing block chain.
+    //       We walk up that chain until we hit a box whose size can't change as a result, and remember
+    //       the path to it in the child_needs_layout bits so Document::update_layout() can find it.
+    for (auto* ancestor = containing_block(); ancestor; ancestor = ancestor->containing_block()) {
+        ancestor->m_needs_layout = true;
+        if (!ancestor->is_relayout_boundary())
+            continue;
+        for (auto* node = ancestor->parent(); node && !node->m_child_needs_layout; node = node->parent())
+            node->m_child_needs_layout = true;
+        document().schedule_layout_update();
+        return;
+    }
+
+    document().set_needs_layout();
+}
+
 CSSPixelPoint Node::box_type_agnostic_position() const
 {
     if (is<Box>(*this))
@@ -159,6 +159,17 @@ public:
 
     virtual void set_needs_display();
 
+    // Marks this node as needing layout, along with its containing block chain up to the nearest relayout boundary.
+    // If there is no relayout boundary in the chain, the whole document is scheduled for layout.
+    void set_needs_layout();
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+    void reset_needs_layout()
+    {
+        m_needs_layout = false;
+        m_child_needs_layout = false;
+    }
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -196,6 +207,8 @@ private:
     bool m_anonymous { false };
     bool m_has_style { false };
     bool m_children_are_inline { false };
+    bool m_needs_layout { false };
+    bool m_child_needs_layout { false };
     SelectionState m_selection_state { SelectionState::None };
 
     bool m_is_flex_item { false };
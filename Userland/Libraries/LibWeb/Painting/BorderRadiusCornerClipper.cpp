@@ -56,6 +56,20 @@ ErrorOr<NonnullRefPtr<BorderRadiusCornerClipper>> BorderRadiusCornerClipper::cre
     return try_make_ref_counted<BorderRadiusCornerClipper>(corner_data, corner_bitmap.release_nonnull(), corner_clip);
 }
 
+ErrorOr<NonnullRefPtr<BorderRadiusCornerClipper>> BorderRadiusCornerClipper::clone_with_own_bitmap() const
+{
+    auto corner_bitmap = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, m_data.corner_bitmap_size.to_type<int>()));
+    return try_make_ref_counted<BorderRadiusCornerClipper>(m_data, move(corner_bitmap), m_corner_clip);
+}
+
+DevicePixelRect BorderRadiusCornerClipper::border_rect() const
+{
+    auto const& top_left = m_data.page_locations.top_left;
+    auto const& bottom_right_radius = m_data.corner_radii.bottom_right;
+    auto bottom_right = m_data.page_locations.bottom_right.translated(bottom_right_radius.horizontal_radius, bottom_right_radius.vertical_radius);
+    return { top_left, DevicePixelSize { bottom_right.x() - top_left.x(), bottom_right.y() - top_left.y() } };
+}
+
 void BorderRadiusCornerClipper::sample_under_corners(Gfx::Painter& page_painter)
 {
     // Generate a mask for the corners:
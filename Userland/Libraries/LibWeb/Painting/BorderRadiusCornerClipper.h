@@ -28,6 +28,11 @@ public:
     void sample_under_corners(Gfx::Painter& page_painter);
     void blit_corner_clipping(Gfx::Painter& page_painter);
 
+    // Makes a clipper for the same corners that samples into a bitmap of its own, rather than the cached one.
+    ErrorOr<NonnullRefPtr<BorderRadiusCornerClipper>> clone_with_own_bitmap() const;
+
+    DevicePixelRect border_rect() const;
+
     struct CornerData {
         CornerRadii corner_radii;
         struct CornerLocations {
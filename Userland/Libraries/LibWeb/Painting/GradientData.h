@@ -19,20 +19,28 @@ using ColorStopList = Vector<Gfx::ColorStop, 4>;
 struct ColorStopData {
     ColorStopList list;
     Optional<float> repeat_length;
+
+    bool operator==(ColorStopData const&) const = default;
 };
 
 struct LinearGradientData {
     float gradient_angle;
     ColorStopData color_stops;
+
+    bool operator==(LinearGradientData const&) const = default;
 };
 
 struct ConicGradientData {
     float start_angle;
     ColorStopData color_stops;
+
+    bool operator==(ConicGradientData const&) const = default;
 };
 
 struct RadialGradientData {
     ColorStopData color_stops;
+
+    bool operator==(RadialGradientData const&) const = default;
 };
 
 }
@@ -121,6 +121,7 @@ public:
     Optional<CSSPixelRect> calculate_overflow_clipped_rect() const;
 
     void set_overflow_data(OverflowData data) { m_overflow_data = move(data); }
+    void reset_overflow_data() { m_overflow_data = {}; }
 
     StackingContext* stacking_context() { return m_stacking_context; }
     StackingContext const* stacking_context() const { return m_stacking_context; }
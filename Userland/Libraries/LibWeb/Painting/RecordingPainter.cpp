@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
+#include <AK/HashMap.h>
 #include <LibGfx/Filters/StackBlurFilter.h>
 #include <LibGfx/StylePainter.h>
+#include <LibThreading/WorkerThread.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/FilterPainting.h>
 #include <LibWeb/Painting/RecordingPainter.h>
@@ -18,6 +21,8 @@ struct CommandExecutionState {
         Gfx::Painter painter;
         Gfx::IntRect destination;
         float opacity;
+        // The translation that fixed position stacking contexts are painted with.
+        Gfx::IntPoint base_translation {};
     };
 
     [[nodiscard]] Gfx::Painter const& painter() const { return stacking_contexts.last().painter; }
@@ -29,23 +34,97 @@ struct CommandExecutionState {
     }
 
     Vector<StackingContext> stacking_contexts;
+
+    // Corner clippers sample into a bitmap they own. When several tiles are painted at once, each of them samples
+    // into a copy of its own instead.
+    bool needs_own_corner_clippers { false };
+    HashMap<BorderRadiusCornerClipper const*, NonnullRefPtr<BorderRadiusCornerClipper>> own_corner_clippers;
 };
 
-CommandResult ClearRect::execute(CommandExecutionState& state) const
+Gfx::IntRect DrawTextRun::bounding_rect() const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
+    // Glyphs may extend past the fragment they belong to, e.g. for italic text.
+    return rect.inflated(rect.height() * 2, rect.height() * 2);
+}
+
+Gfx::IntRect DrawText::bounding_rect() const
+{
+    return rect.inflated(rect.height() * 2, rect.height() * 2);
+}
+
+Gfx::IntRect PaintOuterBoxShadow::bounding_rect() const
+{
+    auto const& params = outer_box_shadow_params;
+    auto extent = (clamp(params.blur_radius, 0, 255) * 4 + max(params.spread_distance, 0) + 1).value();
+    return params.device_content_rect.translated(params.offset_x, params.offset_y).to_type<int>().inflated(extent, extent, extent, extent);
+}
+
+Gfx::IntRect PaintInnerBoxShadow::bounding_rect() const
+{
+    return outer_box_shadow_params.device_content_rect.to_type<int>();
+}
+
+Gfx::IntRect PaintTextShadow::bounding_rect() const
+{
+    return { draw_location.to_type<int>(), shadow_bounding_rect.size().to_type<int>() };
+}
+
+Gfx::IntRect FillRectWithRoundedCorners::bounding_rect() const
+{
+    return Gfx::enclosing_int_rect(rect.to_type<float>().translated(aa_translation.value_or({}))).inflated(2, 2);
+}
+
+static Gfx::IntRect path_bounding_rect(Gfx::Path const& path, Optional<Gfx::FloatPoint> const& aa_translation, float thickness)
+{
+    auto extent = static_cast<int>(ceilf(thickness)) + 1;
+    return Gfx::enclosing_int_rect(path.bounding_box().translated(aa_translation.value_or({}))).inflated(extent, extent, extent, extent);
+}
+
+Gfx::IntRect FillPathUsingColor::bounding_rect() const
+{
+    return path_bounding_rect(path, aa_translation, 0);
+}
 
+Gfx::IntRect FillPathUsingPaintStyle::bounding_rect() const
+{
+    return path_bounding_rect(path, aa_translation, 0);
+}
+
+Gfx::IntRect StrokePathUsingColor::bounding_rect() const
+{
+    return path_bounding_rect(path, aa_translation, thickness);
+}
+
+Gfx::IntRect StrokePathUsingPaintStyle::bounding_rect() const
+{
+    return path_bounding_rect(path, aa_translation, thickness);
+}
+
+Gfx::IntRect DrawLine::bounding_rect() const
+{
+    auto extent = max(thickness, 1);
+    return Gfx::IntRect::from_two_points(from, to).inflated(extent, extent, extent, extent);
+}
+
+Gfx::IntRect PaintProgressbar::bounding_rect() const
+{
+    return frame_rect.united(progress_rect);
+}
+
+Gfx::IntRect DrawTriangleWave::bounding_rect() const
+{
+    auto extent = amplitude + max(thickness, 1);
+    return Gfx::IntRect::from_two_points(p1, p2).inflated(extent, extent, extent, extent);
+}
+
+CommandResult ClearRect::execute(CommandExecutionState& state) const
+{
     state.painter().clear_rect(rect, color);
     return CommandResult::Continue;
 }
 
 CommandResult FillRectWithRoundedCorners::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
-    ;
-
     auto& painter = state.painter();
 
     Gfx::AntiAliasingPainter aa_painter(painter);
@@ -63,9 +142,6 @@ CommandResult FillRectWithRoundedCorners::execute(CommandExecutionState& state)
 
 CommandResult DrawText::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
-    ;
     auto& painter = state.painter();
     if (font.has_value()) {
         painter.draw_text(rect, raw_text, *font, alignment, color, elision, wrapping);
@@ -77,9 +153,6 @@ CommandResult DrawText::execute(CommandExecutionState& state) const
 
 CommandResult DrawTextRun::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
-    ;
     auto& painter = state.painter();
     painter.draw_text_run(baseline_start, Utf8View(string), font, color);
     return CommandResult::Continue;
@@ -127,8 +200,6 @@ CommandResult StrokePathUsingPaintStyle::execute(CommandExecutionState& state) c
 
 CommandResult FillRect::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
     auto& painter = state.painter();
     painter.fill_rect(rect, color);
     return CommandResult::Continue;
@@ -136,8 +207,6 @@ CommandResult FillRect::execute(CommandExecutionState& state) const
 
 CommandResult DrawScaledBitmap::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(dst_rect))
-        return CommandResult::Continue;
     auto& painter = state.painter();
     painter.draw_scaled_bitmap(dst_rect, bitmap, src_rect, opacity, scaling_mode);
     return CommandResult::Continue;
@@ -189,7 +258,7 @@ CommandResult PushStackingContext::execute(CommandExecutionState& state) const
 {
     auto& painter = state.painter();
     if (has_fixed_position) {
-        painter.translate(-painter.translation());
+        painter.translate(-painter.translation() + state.stacking_contexts.last().base_translation);
     }
     if (semitransparent_or_has_non_identity_transform) {
         auto destination_rect = transformed_destination_rect.to_rounded<int>();
@@ -295,8 +364,6 @@ CommandResult PopStackingContextWithMask::execute(CommandExecutionState& state)
 
 CommandResult PaintLinearGradient::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(gradient_rect))
-        return CommandResult::Continue;
     auto const& data = linear_gradient_data;
     state.painter().fill_rect_with_linear_gradient(
         gradient_rect, data.color_stops.list,
@@ -306,9 +373,6 @@ CommandResult PaintLinearGradient::execute(CommandExecutionState& state) const
 
 CommandResult PaintRadialGradient::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
-    ;
     auto& painter = state.painter();
     painter.fill_rect_with_radial_gradient(rect, radial_gradient_data.color_stops.list, center, size, radial_gradient_data.color_stops.repeat_length);
     return CommandResult::Continue;
@@ -316,9 +380,6 @@ CommandResult PaintRadialGradient::execute(CommandExecutionState& state) const
 
 CommandResult PaintConicGradient::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
-    ;
     auto& painter = state.painter();
     painter.fill_rect_with_conic_gradient(rect, conic_gradient_data.color_stops.list, position, conic_gradient_data.start_angle, conic_gradient_data.color_stops.repeat_length);
     return CommandResult::Continue;
@@ -340,14 +401,11 @@ CommandResult PaintInnerBoxShadow::execute(CommandExecutionState& state) const
 
 CommandResult PaintTextShadow::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(text_rect.to_type<int>()))
-        return CommandResult::Continue;
-    ;
 
     // FIXME: Figure out the maximum bitmap size for all shadows and then allocate it once and reuse it?
-    auto maybe_shadow_bitmap = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, bounding_rect.size().to_type<int>());
+    auto maybe_shadow_bitmap = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, shadow_bounding_rect.size().to_type<int>());
     if (maybe_shadow_bitmap.is_error()) {
-        dbgln("Unable to allocate temporary bitmap {} for text-shadow rendering: {}", bounding_rect.size(), maybe_shadow_bitmap.error());
+        dbgln("Unable to allocate temporary bitmap {} for text-shadow rendering: {}", shadow_bounding_rect.size(), maybe_shadow_bitmap.error());
         return CommandResult::Continue;
         ;
     }
@@ -363,15 +421,12 @@ CommandResult PaintTextShadow::execute(CommandExecutionState& state) const
     filter.process_rgba(blur_radius.value(), color);
 
     auto& painter = state.painter();
-    painter.blit(draw_location.to_type<int>(), *shadow_bitmap, bounding_rect.to_type<int>());
+    painter.blit(draw_location.to_type<int>(), *shadow_bitmap, shadow_bounding_rect.to_type<int>());
     return CommandResult::Continue;
 }
 
 CommandResult DrawEllipse::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
-    ;
     auto& painter = state.painter();
     Gfx::AntiAliasingPainter aa_painter(painter);
     aa_painter.draw_ellipse(rect, color, thickness);
@@ -380,9 +435,6 @@ CommandResult DrawEllipse::execute(CommandExecutionState& state) const
 
 CommandResult FillElipse::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
-    ;
     auto& painter = state.painter();
     Gfx::AntiAliasingPainter aa_painter(painter);
     aa_painter.fill_ellipse(rect, color, blend_mode);
@@ -402,9 +454,6 @@ CommandResult DrawLine::execute(CommandExecutionState& state) const
 
 CommandResult DrawSignedDistanceField::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
-    ;
     auto& painter = state.painter();
     painter.draw_signed_distance_field(rect, color, sdf, smoothing);
     return CommandResult::Continue;
@@ -465,9 +514,6 @@ CommandResult ApplyBackdropFilter::execute(CommandExecutionState& state) const
 
 CommandResult DrawRect::execute(CommandExecutionState& state) const
 {
-    if (state.would_be_fully_clipped_by_painter(rect))
-        return CommandResult::Continue;
-    ;
     auto& painter = state.painter();
     painter.draw_rect(rect, color, rough);
     return CommandResult::Continue;
@@ -483,14 +529,31 @@ CommandResult DrawTriangleWave::execute(CommandExecutionState& state) const
 CommandResult SampleUnderCorners::execute(CommandExecutionState& state) const
 {
     auto& painter = state.painter();
-    corner_clipper->sample_under_corners(painter);
+    if (!state.needs_own_corner_clippers) {
+        corner_clipper->sample_under_corners(painter);
+        return CommandResult::Continue;
+    }
+
+    auto own_corner_clipper_or_error = corner_clipper->clone_with_own_bitmap();
+    if (own_corner_clipper_or_error.is_error())
+        return CommandResult::Continue;
+    auto own_corner_clipper = own_corner_clipper_or_error.release_value();
+    own_corner_clipper->sample_under_corners(painter);
+    state.own_corner_clippers.set(corner_clipper.ptr(), move(own_corner_clipper));
     return CommandResult::Continue;
 }
 
 CommandResult BlitCornerClipping::execute(CommandExecutionState& state) const
 {
     auto& painter = state.painter();
-    corner_clipper->blit_corner_clipping(painter);
+    if (!state.needs_own_corner_clippers) {
+        corner_clipper->blit_corner_clipping(painter);
+        return CommandResult::Continue;
+    }
+
+    auto own_corner_clipper = state.own_corner_clippers.take(corner_clipper.ptr());
+    if (own_corner_clipper.has_value())
+        (*own_corner_clipper)->blit_corner_clipping(painter);
     return CommandResult::Continue;
 }
 
@@ -787,7 +850,7 @@ void RecordingPainter::paint_text_shadow(DevicePixels blur_radius, DevicePixelRe
 {
     push_command(PaintTextShadow {
         .blur_radius = blur_radius,
-        .bounding_rect = bounding_rect,
+        .shadow_bounding_rect = bounding_rect,
         .text_rect = text_rect,
         .text = String::from_utf8(text.as_string()).release_value_but_fixme_should_propagate_errors(),
         .font = font,
@@ -846,26 +909,25 @@ void RecordingPainter::draw_triangle_wave(Gfx::IntPoint a_p1, Gfx::IntPoint a_p2
         .thickness = thickness });
 }
 
-void RecordingPainter::execute(Gfx::Bitmap& bitmap)
+static void execute_commands(CommandExecutionState& state, ReadonlySpan<PaintingCommand> commands)
 {
-    CommandExecutionState state;
-    state.stacking_contexts.append(CommandExecutionState::StackingContext {
-        .painter = Gfx::Painter(bitmap),
-        .destination = Gfx::IntRect { 0, 0, 0, 0 },
-        .opacity = 1,
-    });
-
     size_t next_command_index = 0;
-    while (next_command_index < m_painting_commands.size()) {
-        auto& command = m_painting_commands[next_command_index++];
-        auto result = command.visit([&](auto const& command) { return command.execute(state); });
+    while (next_command_index < commands.size()) {
+        auto& command = commands[next_command_index++];
+        auto result = command.visit([&](auto const& command) {
+            if constexpr (requires { command.bounding_rect(); }) {
+                if (state.would_be_fully_clipped_by_painter(command.bounding_rect()))
+                    return CommandResult::Continue;
+            }
+            return command.execute(state);
+        });
 
         if (result == CommandResult::SkipStackingContext) {
             auto stacking_context_nesting_level = 1;
-            while (next_command_index < m_painting_commands.size()) {
-                if (m_painting_commands[next_command_index].has<PushStackingContext>()) {
+            while (next_command_index < commands.size()) {
+                if (commands[next_command_index].has<PushStackingContext>()) {
                     stacking_context_nesting_level++;
-                } else if (m_painting_commands[next_command_index].has<PopStackingContext>()) {
+                } else if (commands[next_command_index].has<PopStackingContext>()) {
                     stacking_context_nesting_level--;
                 }
 
@@ -876,8 +938,364 @@ void RecordingPainter::execute(Gfx::Bitmap& bitmap)
             }
         }
     }
+}
+
+static void execute_commands(Gfx::Bitmap& bitmap, ReadonlySpan<PaintingCommand> commands)
+{
+    CommandExecutionState state;
+    state.stacking_contexts.append(CommandExecutionState::StackingContext {
+        .painter = Gfx::Painter(bitmap),
+        .destination = Gfx::IntRect { 0, 0, 0, 0 },
+        .opacity = 1,
+    });
+
+    execute_commands(state, commands);
 
     VERIFY(state.stacking_contexts.size() == 1);
 }
 
+void RecordingPainter::execute(Gfx::Bitmap& bitmap)
+{
+    execute_commands(bitmap, m_painting_commands);
+}
+
+void RecordingPainter::execute_tiled(Gfx::Bitmap& bitmap, TiledCommandExecutor& executor)
+{
+    executor.execute(bitmap, move(m_painting_commands));
+}
+
+// Returns whether the command paints the same thing when it's executed separately for each tile, and makes sure that
+// executing it won't lazily compute anything that another thread could be reading at the same time.
+static bool prepare_for_tiled_execution(PaintingCommand const& command)
+{
+    return command.visit(
+        [](FillPathUsingColor const& command) {
+            (void)command.path.split_lines();
+            return true;
+        },
+        [](FillPathUsingPaintStyle const& command) {
+            (void)command.path.split_lines();
+            return true;
+        },
+        [](StrokePathUsingColor const& command) {
+            (void)command.path.split_lines();
+            return true;
+        },
+        [](StrokePathUsingPaintStyle const& command) {
+            (void)command.path.split_lines();
+            return true;
+        },
+        [](PushStackingContext const& command) {
+            // A scaled stacking context would be resampled separately for each tile, which leaves seams between them.
+            if (!command.semitransparent_or_has_non_identity_transform)
+                return true;
+            return command.source_rect.size() == command.transformed_destination_rect.size();
+        },
+        [](DrawText const& command) {
+            // Without a font of its own, the text is painted with the default font, which is loaded lazily.
+            return command.font.has_value();
+        },
+        // These go through the global StylePainter.
+        [](PaintProgressbar const&) { return false; },
+        [](PaintFrame const&) { return false; },
+        // The filter is applied to whatever is painted underneath, so it can't be split at tile boundaries.
+        [](ApplyBackdropFilter const&) { return false; },
+        [](auto const&) { return true; });
+}
+
+static bool commands_are_equal(PaintingCommand const& a, PaintingCommand const& b)
+{
+    if (a.index() != b.index())
+        return false;
+    return a.visit([&](auto const& command) {
+        using CommandType = RemoveCVReference<decltype(command)>;
+        // Commands that refer to bitmaps, paint styles or corner clippers can't be compared, as those may have changed
+        // in place since the previous frame.
+        if constexpr (requires(CommandType const& other) { command == other; })
+            return command == b.template get<CommandType>();
+        else
+            return false;
+    });
+}
+
+ErrorOr<NonnullOwnPtr<TiledCommandExecutor>> TiledCommandExecutor::create(size_t thread_count)
+{
+    VERIFY(thread_count > 0);
+    auto executor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) TiledCommandExecutor));
+    TRY(executor->m_workers.try_ensure_capacity(thread_count - 1));
+    for (size_t i = 1; i < thread_count; ++i)
+        executor->m_workers.unchecked_append(TRY(Threading::WorkerThread<Error>::create("Paint Worker"sv)));
+    return executor;
+}
+
+TiledCommandExecutor::~TiledCommandExecutor() = default;
+
+void TiledCommandExecutor::reset_tiles(Gfx::Bitmap const& bitmap)
+{
+    m_target_size = bitmap.size();
+    m_target_format = bitmap.format();
+    m_tiles.clear();
+    m_commands.clear();
+    m_items.clear();
+
+    for (int y = 0; y < bitmap.height(); y += tile_size) {
+        for (int x = 0; x < bitmap.width(); x += tile_size)
+            m_tiles.append({ .rect = Gfx::IntRect { x, y, tile_size, tile_size }.intersected(bitmap.rect()), .bitmap = {}, .item_indices = {} });
+    }
+}
+
+Optional<Vector<TiledCommandExecutor::Item>> TiledCommandExecutor::collect_items(ReadonlySpan<PaintingCommand> commands, Gfx::IntRect const& target_rect)
+{
+    struct State {
+        Gfx::IntPoint translation;
+        Gfx::IntRect clip_rect;
+    };
+    State state { {}, target_rect };
+    Vector<State> saved_states;
+    Vector<Item> items;
+
+    // Returns the index of the command that ends the stacking context started at the given index.
+    auto find_end_of_stacking_context = [&](size_t start_index) -> Optional<size_t> {
+        auto is_push = [&](auto const& command) {
+            return commands[start_index].has<PushStackingContext>() ? command.template has<PushStackingContext>() : command.template has<PushStackingContextWithMask>();
+        };
+        auto is_pop = [&](auto const& command) {
+            return commands[start_index].has<PushStackingContext>() ? command.template has<PopStackingContext>() : command.template has<PopStackingContextWithMask>();
+        };
+        auto nesting_level = 0;
+        for (size_t index = start_index; index < commands.size(); ++index) {
+            if (!prepare_for_tiled_execution(commands[index]))
+                return {};
+            if (is_push(commands[index])) {
+                ++nesting_level;
+            } else if (is_pop(commands[index])) {
+                if (--nesting_level == 0)
+                    return index;
+            }
+        }
+        return {};
+    };
+
+    for (size_t index = 0; index < commands.size(); ++index) {
+        auto const& command = commands[index];
+        if (!prepare_for_tiled_execution(command))
+            return {};
+
+        if (auto const* translate = command.get_pointer<Translate>()) {
+            state.translation.translate_by(translate->translation_delta);
+        } else if (command.has<SaveState>()) {
+            saved_states.append(state);
+        } else if (command.has<RestoreState>()) {
+            if (saved_states.is_empty())
+                return {};
+            state = saved_states.take_last();
+        } else if (auto const* add_clip_rect = command.get_pointer<AddClipRect>()) {
+            state.clip_rect.intersect(add_clip_rect->rect.translated(state.translation));
+        } else if (command.has<ClearClipRect>()) {
+            state.clip_rect = target_rect;
+        } else if (command.has<SetFont>()) {
+            // Only DrawText without a font of its own uses the font of the painter, and that isn't painted in tiles.
+        } else if (auto const* push = command.get_pointer<PushStackingContext>()) {
+            if (push->has_fixed_position)
+                state.translation = {};
+            if (!push->semitransparent_or_has_non_identity_transform) {
+                saved_states.append(state);
+                continue;
+            }
+            auto end_index = find_end_of_stacking_context(index);
+            if (!end_index.has_value())
+                return {};
+            auto destination_rect = push->transformed_destination_rect.to_rounded<int>();
+            items.append({
+                .first_command_index = index,
+                .command_count = *end_index - index + 1,
+                .bounding_rect = destination_rect.translated(state.translation).intersected(state.clip_rect),
+                .translation = state.translation,
+                .clip_rect = state.clip_rect,
+            });
+            index = *end_index;
+        } else if (auto const* pop = command.get_pointer<PopStackingContext>()) {
+            if (pop->semitransparent_or_has_non_identity_transform || saved_states.is_empty())
+                return {};
+            state = saved_states.take_last();
+        } else if (auto const* push_with_mask = command.get_pointer<PushStackingContextWithMask>()) {
+            auto end_index = find_end_of_stacking_context(index);
+            if (!end_index.has_value())
+                return {};
+            items.append({
+                .first_command_index = index,
+                .command_count = *end_index - index + 1,
+                .bounding_rect = push_with_mask->paint_rect.to_type<int>().translated(state.translation).intersected(state.clip_rect),
+                .translation = state.translation,
+                .clip_rect = state.clip_rect,
+            });
+            index = *end_index;
+        } else if (command.has<PopStackingContextWithMask>()) {
+            return {};
+        } else {
+            // Corner clippers sample what's underneath them regardless of the clip rect.
+            auto bounding_rect = command.visit(
+                [&](SampleUnderCorners const& command) { return command.corner_clipper->border_rect().to_type<int>().translated(state.translation).intersected(target_rect); },
+                [&](BlitCornerClipping const& command) { return command.corner_clipper->border_rect().to_type<int>().translated(state.translation).intersected(target_rect); },
+                [&](auto const& command) {
+                    if constexpr (requires { command.bounding_rect(); })
+                        return command.bounding_rect().translated(state.translation).intersected(state.clip_rect);
+                    else
+                        return state.clip_rect;
+                });
+            items.append({
+                .first_command_index = index,
+                .command_count = 1,
+                .bounding_rect = bounding_rect,
+                .translation = state.translation,
+                .clip_rect = state.clip_rect,
+            });
+        }
+    }
+    return items;
+}
+
+bool TiledCommandExecutor::tile_can_be_retained(Tile const& tile, ReadonlySpan<size_t> item_indices, ReadonlySpan<PaintingCommand> commands, ReadonlySpan<Item> items) const
+{
+    if (!tile.bitmap || tile.item_indices.size() != item_indices.size())
+        return false;
+
+    for (size_t i = 0; i < item_indices.size(); ++i) {
+        auto const& previous_item = m_items[tile.item_indices[i]];
+        auto const& item = items[item_indices[i]];
+        if (previous_item.translation != item.translation || previous_item.command_count != item.command_count)
+            return false;
+        if (previous_item.clip_rect.intersected(tile.rect) != item.clip_rect.intersected(tile.rect))
+            return false;
+        for (size_t j = 0; j < item.command_count; ++j) {
+            if (!commands_are_equal(m_commands[previous_item.first_command_index + j], commands[item.first_command_index + j]))
+                return false;
+        }
+    }
+    return true;
+}
+
+ErrorOr<void> TiledCommandExecutor::paint_tile(Tile& tile, ReadonlySpan<PaintingCommand> commands, ReadonlySpan<Item> items) const
+{
+    if (tile.bitmap)
+        tile.bitmap->fill(Color::Transparent);
+    else
+        tile.bitmap = TRY(Gfx::Bitmap::create(m_target_format, tile.rect.size()));
+
+    CommandExecutionState state;
+    state.needs_own_corner_clippers = true;
+    state.stacking_contexts.append(CommandExecutionState::StackingContext {
+        .painter = Gfx::Painter(*tile.bitmap),
+        .destination = Gfx::IntRect { 0, 0, 0, 0 },
+        .opacity = 1,
+        .base_translation = -tile.rect.location(),
+    });
+
+    for (auto item_index : tile.item_indices) {
+        auto const& item = items[item_index];
+        auto& painter = state.painter();
+        painter.clear_clip_rect();
+        painter.translate(-painter.translation() + item.translation - tile.rect.location());
+        painter.add_clip_rect(item.clip_rect.translated(-item.translation));
+        execute_commands(state, commands.slice(item.first_command_index, item.command_count));
+        VERIFY(state.stacking_contexts.size() == 1);
+    }
+    return {};
+}
+
+void TiledCommandExecutor::execute(Gfx::Bitmap& bitmap, Vector<PaintingCommand> commands)
+{
+    m_statistics = {};
+
+    auto paint_without_tiles = [&] {
+        m_statistics.painted_without_tiles = true;
+        m_target_size = {};
+        m_tiles.clear();
+        m_commands.clear();
+        m_items.clear();
+        execute_commands(bitmap, commands);
+    };
+
+    if (bitmap.scale() != 1)
+        return paint_without_tiles();
+
+    auto items = collect_items(commands, bitmap.rect());
+    if (!items.has_value())
+        return paint_without_tiles();
+
+    if (bitmap.size() != m_target_size || bitmap.format() != m_target_format)
+        reset_tiles(bitmap);
+
+    auto columns = ceil_div(bitmap.width(), tile_size);
+    Vector<Vector<size_t>> item_indices_per_tile;
+    item_indices_per_tile.resize(m_tiles.size());
+    for (size_t item_index = 0; item_index < items->size(); ++item_index) {
+        auto const& rect = items->at(item_index).bounding_rect;
+        if (rect.is_empty()) {
+            m_statistics.culled_commands += items->at(item_index).command_count;
+            continue;
+        }
+        for (auto row = rect.top() / tile_size; row <= (rect.bottom() - 1) / tile_size; ++row) {
+            for (auto column = rect.left() / tile_size; column <= (rect.right() - 1) / tile_size; ++column)
+                item_indices_per_tile[row * columns + column].append(item_index);
+        }
+    }
+
+    Vector<size_t> tiles_to_paint;
+    for (size_t tile_index = 0; tile_index < m_tiles.size(); ++tile_index) {
+        auto& tile = m_tiles[tile_index];
+        if (tile_can_be_retained(tile, item_indices_per_tile[tile_index], commands, *items))
+            ++m_statistics.retained_tiles;
+        else
+            tiles_to_paint.append(tile_index);
+        tile.item_indices = move(item_indices_per_tile[tile_index]);
+    }
+    m_statistics.painted_tiles = tiles_to_paint.size();
+
+    // Tiles are handed out one at a time, as some of them take much longer to paint than others.
+    Atomic<size_t> next_tile_to_paint { 0 };
+    Atomic<bool> failed { false };
+    auto paint_tiles = [&]() -> ErrorOr<void> {
+        while (!failed.load()) {
+            auto index = next_tile_to_paint.fetch_add(1);
+            if (index >= tiles_to_paint.size())
+                break;
+            if (auto result = paint_tile(m_tiles[tiles_to_paint[index]], commands, *items); result.is_error()) {
+                failed.store(true);
+                return result.release_error();
+            }
+        }
+        return {};
+    };
+
+    size_t started_workers = 0;
+    for (auto& worker : m_workers) {
+        if (started_workers + 1 >= tiles_to_paint.size())
+            break;
+        auto started = worker->start_task([&] { return paint_tiles(); });
+        VERIFY(started);
+        ++started_workers;
+    }
+
+    Optional<Error> error;
+    if (auto result = paint_tiles(); result.is_error())
+        error = result.release_error();
+    for (size_t i = 0; i < started_workers; ++i) {
+        auto result = m_workers[i]->wait_until_task_is_finished();
+        if (result.is_error() && !error.has_value())
+            error = result.release_error();
+    }
+    if (error.has_value()) {
+        dbgln("Failed to paint tiles, painting without them: {}", error.value());
+        return paint_without_tiles();
+    }
+
+    Gfx::Painter painter(bitmap);
+    for (auto const& tile : m_tiles)
+        painter.blit(tile.rect.location(), *tile.bitmap, tile.bitmap->rect(), 1.0f, false);
+
+    m_commands = move(commands);
+    m_items = items.release_value();
+}
+
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Utf8View.h>
 #include <AK/Vector.h>
@@ -26,6 +27,7 @@
 #include <LibGfx/TextDirection.h>
 #include <LibGfx/TextElision.h>
 #include <LibGfx/TextWrapping.h>
+#include <LibThreading/Forward.h>
 #include <LibWeb/Painting/BorderRadiiData.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/GradientData.h>
@@ -34,6 +36,7 @@
 namespace Web::Painting {
 
 struct CommandExecutionState;
+class TiledCommandExecutor;
 
 enum class CommandResult {
     Continue,
@@ -44,6 +47,8 @@ struct ClearRect {
     Gfx::IntRect rect;
     Color color;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
+    bool operator==(ClearRect const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -54,6 +59,8 @@ struct DrawTextRun {
     NonnullRefPtr<Gfx::Font> font;
     Gfx::IntRect rect;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
+    bool operator==(DrawTextRun const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -66,6 +73,8 @@ struct DrawText {
     Gfx::TextWrapping wrapping;
     Optional<NonnullRefPtr<Gfx::Font>> font {};
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
+    bool operator==(DrawText const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -73,6 +82,8 @@ struct FillRect {
     Gfx::IntRect rect;
     Color color;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
+    bool operator==(FillRect const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -83,36 +94,43 @@ struct DrawScaledBitmap {
     float opacity;
     Gfx::Painter::ScalingMode scaling_mode;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return dst_rect; }
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
 struct Translate {
     Gfx::IntPoint translation_delta;
 
+    bool operator==(Translate const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
 struct SaveState {
+    bool operator==(SaveState const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
 struct RestoreState {
+    bool operator==(RestoreState const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
 struct AddClipRect {
     Gfx::IntRect rect;
 
+    bool operator==(AddClipRect const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
 struct ClearClipRect {
+    bool operator==(ClearClipRect const&) const = default;
     CommandResult execute(CommandExecutionState&) const;
 };
 
 struct SetFont {
     NonnullRefPtr<Gfx::Font> font;
 
+    bool operator==(SetFont const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -124,6 +142,7 @@ struct PushStackingContext {
     Gfx::FloatRect transformed_destination_rect;
     DevicePixelPoint painter_location;
 
+    bool operator==(PushStackingContext const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -131,12 +150,14 @@ struct PopStackingContext {
     bool semitransparent_or_has_non_identity_transform;
     Gfx::Painter::ScalingMode scaling_mode;
 
+    bool operator==(PopStackingContext const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
 struct PushStackingContextWithMask {
     DevicePixelRect paint_rect;
 
+    bool operator==(PushStackingContextWithMask const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -153,24 +174,28 @@ struct PaintLinearGradient {
     Gfx::IntRect gradient_rect;
     LinearGradientData linear_gradient_data;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return gradient_rect; }
+    bool operator==(PaintLinearGradient const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
 struct PaintOuterBoxShadow {
     PaintOuterBoxShadowParams outer_box_shadow_params;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
 struct PaintInnerBoxShadow {
     PaintOuterBoxShadowParams outer_box_shadow_params;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
 struct PaintTextShadow {
     DevicePixels blur_radius;
-    DevicePixelRect bounding_rect;
+    DevicePixelRect shadow_bounding_rect;
     DevicePixelRect text_rect;
     String text;
     NonnullRefPtr<Gfx::Font> font;
@@ -178,6 +203,8 @@ struct PaintTextShadow {
     DevicePixels fragment_baseline;
     DevicePixelPoint draw_location;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
+    bool operator==(PaintTextShadow const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -190,6 +217,8 @@ struct FillRectWithRoundedCorners {
     Gfx::AntiAliasingPainter::CornerRadius bottom_right_radius;
     Optional<Gfx::FloatPoint> aa_translation {};
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
+    bool operator==(FillRectWithRoundedCorners const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -199,6 +228,7 @@ struct FillPathUsingColor {
     Gfx::Painter::WindingRule winding_rule;
     Optional<Gfx::FloatPoint> aa_translation {};
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -209,6 +239,7 @@ struct FillPathUsingPaintStyle {
     float opacity;
     Optional<Gfx::FloatPoint> aa_translation {};
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -218,6 +249,7 @@ struct StrokePathUsingColor {
     float thickness;
     Optional<Gfx::FloatPoint> aa_translation {};
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -228,6 +260,7 @@ struct StrokePathUsingPaintStyle {
     float opacity = 1.0f;
     Optional<Gfx::FloatPoint> aa_translation {};
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -236,6 +269,8 @@ struct DrawEllipse {
     Color color;
     int thickness;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
+    bool operator==(DrawEllipse const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -244,6 +279,8 @@ struct FillElipse {
     Color color;
     Gfx::AntiAliasingPainter::BlendMode blend_mode;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
+    bool operator==(FillElipse const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -255,6 +292,8 @@ struct DrawLine {
     Gfx::Painter::LineStyle style;
     Color alternate_color;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
+    bool operator==(DrawLine const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -264,6 +303,7 @@ struct DrawSignedDistanceField {
     Gfx::GrayscaleBitmap sdf;
     float smoothing;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -276,6 +316,7 @@ struct PaintProgressbar {
     int value;
     StringView text;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -284,6 +325,7 @@ struct PaintFrame {
     Palette palette;
     Gfx::FrameStyle style;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -292,6 +334,7 @@ struct ApplyBackdropFilter {
     BorderRadiiData border_radii_data;
     CSS::ResolvedBackdropFilter backdrop_filter;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return backdrop_region; }
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -300,6 +343,8 @@ struct DrawRect {
     Color color;
     bool rough;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
+    bool operator==(DrawRect const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -309,6 +354,8 @@ struct PaintRadialGradient {
     Gfx::IntPoint center;
     Gfx::IntSize size;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
+    bool operator==(PaintRadialGradient const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -317,6 +364,8 @@ struct PaintConicGradient {
     ConicGradientData conic_gradient_data;
     Gfx::IntPoint position;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
+    bool operator==(PaintConicGradient const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -327,6 +376,8 @@ struct DrawTriangleWave {
     int amplitude;
     int thickness;
 
+    [[nodiscard]] Gfx::IntRect bounding_rect() const;
+    bool operator==(DrawTriangleWave const&) const = default;
     [[nodiscard]] CommandResult execute(CommandExecutionState&) const;
 };
 
@@ -492,6 +543,11 @@ public:
 
     void execute(Gfx::Bitmap&);
 
+    // Paints the recorded commands tile by tile. Unlike execute(), this replaces the contents of the bitmap rather than
+    // painting over them, so the commands are expected to cover all of it. The commands are handed over to the executor,
+    // which compares the next frame against them to find the tiles that don't need to be painted again.
+    void execute_tiled(Gfx::Bitmap&, TiledCommandExecutor&);
+
 private:
     void push_command(PaintingCommand command)
     {
@@ -501,6 +557,69 @@ private:
     Vector<PaintingCommand> m_painting_commands;
 };
 
+// Executes painting commands on a pool of worker threads, one tile at a time. Each tile only executes the commands that
+// paint within it, and keeps its bitmap around so it can be reused if the next frame paints the same commands there.
+class TiledCommandExecutor {
+    AK_MAKE_NONCOPYABLE(TiledCommandExecutor);
+    AK_MAKE_NONMOVABLE(TiledCommandExecutor);
+
+public:
+    static constexpr int tile_size = 256;
+
+    static ErrorOr<NonnullOwnPtr<TiledCommandExecutor>> create(size_t thread_count);
+    ~TiledCommandExecutor();
+
+    // The number of threads that paint tiles, including the one calling execute_tiled().
+    size_t thread_count() const { return m_workers.size() + 1; }
+
+    struct Statistics {
+        size_t painted_tiles { 0 };
+        size_t retained_tiles { 0 };
+        size_t culled_commands { 0 };
+        bool painted_without_tiles { false };
+    };
+    Statistics const& statistics() const { return m_statistics; }
+
+private:
+    friend class RecordingPainter;
+
+    // A command that paints something, or a whole isolated stacking context, along with the state of the painter at
+    // the top level when it's executed. Tiles are painted by setting up that state and executing the commands.
+    struct Item {
+        size_t first_command_index { 0 };
+        size_t command_count { 0 };
+        Gfx::IntRect bounding_rect;
+        Gfx::IntPoint translation;
+        Gfx::IntRect clip_rect;
+    };
+
+    struct Tile {
+        Gfx::IntRect rect;
+        RefPtr<Gfx::Bitmap> bitmap;
+        Vector<size_t> item_indices;
+    };
+
+    TiledCommandExecutor() = default;
+
+    void execute(Gfx::Bitmap&, Vector<PaintingCommand>);
+    static Optional<Vector<Item>> collect_items(ReadonlySpan<PaintingCommand>, Gfx::IntRect const& target_rect);
+    bool tile_can_be_retained(Tile const&, ReadonlySpan<size_t> item_indices, ReadonlySpan<PaintingCommand>, ReadonlySpan<Item>) const;
+    ErrorOr<void> paint_tile(Tile&, ReadonlySpan<PaintingCommand>, ReadonlySpan<Item>) const;
+    void reset_tiles(Gfx::Bitmap const&);
+
+    Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> m_workers;
+
+    Gfx::IntSize m_target_size;
+    Gfx::BitmapFormat m_target_format { Gfx::BitmapFormat::Invalid };
+    Vector<Tile> m_tiles;
+
+    // The commands of the previous frame, which the tiles were painted with.
+    Vector<PaintingCommand> m_commands;
+    Vector<Item> m_items;
+
+    Statistics m_statistics;
+};
+
 class RecordingPainterStateSaver {
 public:
     explicit RecordingPainterStateSaver(RecordingPainter& painter)
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibGfx/Bitmap.h>
 #include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace Web::Platform {
@@ -19,6 +20,11 @@ ImageCodecPlugin& ImageCodecPlugin::the()
     return *s_the;
 }
 
+void ImageCodecPlugin::start_decoding_image(ReadonlyBytes bytes, Function<void(Optional<DecodedImage>)> on_complete)
+{
+    on_complete(decode_image(bytes));
+}
+
 void ImageCodecPlugin::install(ImageCodecPlugin& plugin)
 {
     VERIFY(!s_the);
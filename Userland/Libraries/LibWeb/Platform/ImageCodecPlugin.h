@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibGfx/Forward.h>
@@ -32,6 +33,9 @@ public:
     virtual ~ImageCodecPlugin();
 
     virtual Optional<DecodedImage> decode_image(ReadonlyBytes) = 0;
+
+    // Decodes the image without blocking where the platform supports it, and calls on_complete once it's done.
+    virtual void start_decoding_image(ReadonlyBytes, Function<void(Optional<DecodedImage>)> on_complete);
 };
 
 }
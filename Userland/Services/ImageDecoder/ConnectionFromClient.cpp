@@ -7,13 +7,21 @@
 #include <AK/Debug.h>
 #include <ImageDecoder/ConnectionFromClient.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
+#include <LibCore/EventLoop.h>
 #include <LibGfx/Bitmap.h>
-#include <LibGfx/ImageFormats/ImageDecoder.h>
 
 namespace ImageDecoder {
 
-ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket)
+ErrorOr<NonnullRefPtr<ConnectionFromClient>> ConnectionFromClient::try_create(NonnullOwnPtr<Core::LocalSocket> socket)
+{
+    auto decoder_pool = TRY(Threading::ThreadPool::create("ImageDecoder"sv));
+    return adopt_nonnull_ref_or_enomem(new (nothrow) ConnectionFromClient(move(socket), move(decoder_pool)));
+}
+
+ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket, NonnullOwnPtr<Threading::ThreadPool> decoder_pool)
     : IPC::ConnectionFromClient<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>(*this, move(socket), 1)
+    , m_event_loop(Core::EventLoop::current())
+    , m_decoder_pool(move(decoder_pool))
 {
 }
 
@@ -22,54 +30,171 @@ void ConnectionFromClient::die()
     Core::EventLoop::current().quit(0);
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
+void ConnectionFromClient::invoke_on_main_thread(Function<void()> callback)
 {
-    for (size_t i = 0; i < decoder.frame_count(); ++i) {
-        auto frame_or_error = decoder.frame(i);
-        if (frame_or_error.is_error()) {
-            bitmaps.append(Gfx::ShareableBitmap {});
-            durations.append(0);
-        } else {
-            auto frame = frame_or_error.release_value();
-            bitmaps.append(frame.image->to_shareable_bitmap());
-            durations.append(frame.duration);
+    m_event_loop.deferred_invoke(move(callback));
+    m_event_loop.wake();
+}
+
+static ErrorOr<NonnullRefPtr<CachedImage>> find_or_create_image(ImageCache& cache, ReadonlyBytes encoded_data, Optional<DeprecatedString> const& mime_type)
+{
+    auto content_hash = CachedImage::hash_content(encoded_data);
+    if (auto image = cache.find(content_hash))
+        return image.release_nonnull();
+
+    auto image = TRY(CachedImage::create(move(content_hash), TRY(ByteBuffer::copy(encoded_data)), mime_type));
+    return cache.add(move(image));
+}
+
+Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<DeprecatedString> const& mime_type)
+{
+    if (!encoded_buffer.is_valid()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
+        return nullptr;
+    }
+
+    auto image_or_error = find_or_create_image(m_cache, ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, mime_type);
+    if (image_or_error.is_error()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "{}", image_or_error.error());
+        return { false, 0, {}, {} };
+    }
+    auto image = image_or_error.release_value();
+
+    Vector<Gfx::ShareableBitmap> bitmaps;
+    Vector<u32> durations;
+    for (u32 i = 0; i < image->frame_count(); ++i) {
+        if (!image->frame(i).has_value())
+            m_cache.set_frame(*image, i, image->decode_frame(i));
+
+        // Callers of this own the bitmaps they get back and may modify them, so they can't share the cached ones.
+        auto const& frame = image->frame(i).value();
+        Gfx::ShareableBitmap bitmap;
+        if (frame.bitmap.is_valid()) {
+            if (auto bitmap_or_error = copy_to_shareable_bitmap(*frame.bitmap.bitmap()); !bitmap_or_error.is_error())
+                bitmap = bitmap_or_error.release_value();
         }
+
+        bitmaps.append(move(bitmap));
+        durations.append(frame.duration);
     }
+    return { image->is_animated(), image->loop_count(), bitmaps, durations };
 }
 
-static void decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<DeprecatedString> const& known_mime_type, bool& is_animated, u32& loop_count, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
+void ConnectionFromClient::start_decoding_image(i64 image_id, Core::AnonymousBuffer const& encoded_buffer, Optional<DeprecatedString> const& mime_type)
 {
-    VERIFY(bitmaps.size() == 0);
-    VERIFY(durations.size() == 0);
+    if (!encoded_buffer.is_valid()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
+        async_did_fail_to_decode_image(image_id);
+        return;
+    }
+
+    ReadonlyBytes encoded_bytes { encoded_buffer.data<u8>(), encoded_buffer.size() };
+    auto content_hash = CachedImage::hash_content(encoded_bytes);
+
+    if (auto image = m_cache.find(content_hash)) {
+        m_images.set(image_id, *image);
+        async_did_decode_image(image_id, image->is_animated(), image->loop_count(), image->frame_count());
+        send_frames(image_id, image.release_nonnull(), 0, 1);
+        return;
+    }
 
-    auto decoder = Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type);
-    if (!decoder) {
-        dbgln_if(IMAGE_DECODER_DEBUG, "Could not find suitable image decoder plugin for data");
+    if (auto waiting_image_ids = m_images_being_created.get(content_hash); waiting_image_ids.has_value()) {
+        waiting_image_ids->append(image_id);
         return;
     }
 
-    if (!decoder->frame_count()) {
-        dbgln_if(IMAGE_DECODER_DEBUG, "Could not decode image from encoded data");
+    auto encoded_data_or_error = ByteBuffer::copy(encoded_bytes);
+    if (encoded_data_or_error.is_error()) {
+        async_did_fail_to_decode_image(image_id);
         return;
     }
-    is_animated = decoder->is_animated();
-    loop_count = decoder->loop_count();
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, bitmaps, durations);
+
+    // Strings aren't safe to share between threads, so the worker gets its own copy of the MIME type.
+    Optional<DeprecatedString> worker_mime_type;
+    if (mime_type.has_value() && !mime_type->is_empty())
+        worker_mime_type = DeprecatedString { mime_type->view() };
+
+    m_images_being_created.set(content_hash, { image_id });
+    m_decoder_pool->submit([this, content_hash = MUST(ByteBuffer::copy(content_hash)), encoded_data = encoded_data_or_error.release_value(), mime_type = move(worker_mime_type)]() mutable {
+        auto image_or_error = CachedImage::create(MUST(ByteBuffer::copy(content_hash)), move(encoded_data), mime_type);
+        invoke_on_main_thread([this, content_hash = move(content_hash), image_or_error = move(image_or_error)]() mutable {
+            did_create_image(content_hash, move(image_or_error));
+        });
+    });
 }
 
-Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<DeprecatedString> const& mime_type)
+void ConnectionFromClient::did_create_image(ByteBuffer const& content_hash, ErrorOr<NonnullRefPtr<CachedImage>> image_or_error)
 {
-    if (!encoded_buffer.is_valid()) {
-        dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
-        return nullptr;
+    auto image_ids = m_images_being_created.take(content_hash).release_value();
+
+    if (image_or_error.is_error()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "{}", image_or_error.error());
+        for (auto image_id : image_ids)
+            async_did_fail_to_decode_image(image_id);
+        return;
     }
 
-    bool is_animated = false;
-    u32 loop_count = 0;
-    Vector<Gfx::ShareableBitmap> bitmaps;
-    Vector<u32> durations;
-    decode_image_to_details(encoded_buffer, mime_type, is_animated, loop_count, bitmaps, durations);
-    return { is_animated, loop_count, bitmaps, durations };
+    auto image = m_cache.add(image_or_error.release_value());
+    for (auto image_id : image_ids) {
+        m_images.set(image_id, image);
+        async_did_decode_image(image_id, image->is_animated(), image->loop_count(), image->frame_count());
+        send_frames(image_id, image, 0, 1);
+    }
+}
+
+void ConnectionFromClient::decode_frames(i64 image_id, u32 first_frame_index, u32 frame_count)
+{
+    auto image = m_images.get(image_id);
+    if (!image.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Frames requested for unknown image {}", image_id);
+        return;
+    }
+    send_frames(image_id, *image.value(), first_frame_index, frame_count);
+}
+
+void ConnectionFromClient::send_frames(i64 image_id, NonnullRefPtr<CachedImage> image, u32 first_frame_index, u32 frame_count)
+{
+    auto end_frame_index = min(static_cast<u64>(first_frame_index) + frame_count, image->frame_count());
+
+    Vector<u32> frames_to_decode;
+    for (u32 i = first_frame_index; i < end_frame_index; ++i) {
+        if (auto const& frame = image->frame(i); frame.has_value())
+            async_did_decode_frame(image_id, i, frame->bitmap, frame->duration);
+        else
+            frames_to_decode.append(i);
+    }
+
+    if (frames_to_decode.is_empty())
+        return;
+
+    // Frames are decoded in order by a single job, since animation frames usually build on the previous one.
+    m_decoder_pool->submit([this, image_id, image = move(image), frames_to_decode = move(frames_to_decode)] {
+        for (auto frame_index : frames_to_decode) {
+            invoke_on_main_thread([this, image_id, image, frame_index, frame = image->decode_frame(frame_index)]() mutable {
+                did_decode_frame(move(image), image_id, frame_index, move(frame));
+            });
+        }
+    });
+}
+
+void ConnectionFromClient::did_decode_frame(NonnullRefPtr<CachedImage> image, i64 image_id, u32 frame_index, DecodedFrame frame)
+{
+    m_cache.set_frame(*image, frame_index, move(frame));
+
+    // The client may have released the image while the frame was being decoded.
+    if (!m_images.contains(image_id))
+        return;
+
+    auto const& cached_frame = image->frame(frame_index).value();
+    async_did_decode_frame(image_id, frame_index, cached_frame.bitmap, cached_frame.duration);
+}
+
+void ConnectionFromClient::release_image(i64 image_id)
+{
+    m_images.remove(image_id);
+
+    for (auto& it : m_images_being_created)
+        it.value.remove_all_matching([&](auto waiting_image_id) { return waiting_image_id == image_id; });
 }
 
 }
@@ -8,25 +8,48 @@
 
 #include <AK/HashMap.h>
 #include <ImageDecoder/Forward.h>
+#include <ImageDecoder/ImageCache.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibIPC/ConnectionFromClient.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace ImageDecoder {
 
 class ConnectionFromClient final
     : public IPC::ConnectionFromClient<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint> {
-    C_OBJECT(ConnectionFromClient);
+    C_OBJECT_ABSTRACT(ConnectionFromClient);
 
 public:
+    static ErrorOr<NonnullRefPtr<ConnectionFromClient>> try_create(NonnullOwnPtr<Core::LocalSocket>);
+
     ~ConnectionFromClient() override = default;
 
     virtual void die() override;
 
 private:
-    explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
+    ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>, NonnullOwnPtr<Threading::ThreadPool> decoder_pool);
 
     virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<DeprecatedString> const& mime_type) override;
+    virtual void start_decoding_image(i64 image_id, Core::AnonymousBuffer const&, Optional<DeprecatedString> const& mime_type) override;
+    virtual void decode_frames(i64 image_id, u32 first_frame_index, u32 frame_count) override;
+    virtual void release_image(i64 image_id) override;
+
+    void did_create_image(ByteBuffer const& content_hash, ErrorOr<NonnullRefPtr<CachedImage>>);
+    void send_frames(i64 image_id, NonnullRefPtr<CachedImage>, u32 first_frame_index, u32 frame_count);
+    void did_decode_frame(NonnullRefPtr<CachedImage>, i64 image_id, u32 frame_index, DecodedFrame);
+    void invoke_on_main_thread(Function<void()>);
+
+    Core::EventLoop& m_event_loop;
+    ImageCache m_cache;
+
+    // Images the client has started decoding and not released yet.
+    HashMap<i64, NonnullRefPtr<CachedImage>> m_images;
+    // The images that are waiting for a worker to create their decoder, keyed by the hash of their content.
+    HashMap<ByteBuffer, Vector<i64>> m_images_being_created;
+
+    // Declared last, so that the workers have finished before anything they use is destroyed.
+    NonnullOwnPtr<Threading::ThreadPool> m_decoder_pool;
 };
 
 }
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <ImageDecoder/ImageCache.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGfx/Bitmap.h>
+
+namespace ImageDecoder {
+
+ErrorOr<Gfx::ShareableBitmap> copy_to_shareable_bitmap(Gfx::Bitmap const& bitmap)
+{
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(round_up_to_power_of_two(bitmap.size_in_bytes(), PAGE_SIZE)));
+    auto copy = TRY(Gfx::Bitmap::create_with_anonymous_buffer(bitmap.format(), move(buffer), bitmap.size(), bitmap.scale()));
+    memcpy(copy->scanline(0), bitmap.scanline(0), bitmap.size_in_bytes());
+    return Gfx::ShareableBitmap { move(copy), Gfx::ShareableBitmap::ConstructWithKnownGoodBitmap };
+}
+
+static size_t frame_size_in_bytes(DecodedFrame const& frame)
+{
+    return frame.bitmap.is_valid() ? frame.bitmap.bitmap()->size_in_bytes() : 0;
+}
+
+ErrorOr<NonnullRefPtr<CachedImage>> CachedImage::create(ByteBuffer content_hash, ByteBuffer encoded_data, Optional<DeprecatedString> const& mime_type)
+{
+    auto image = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) CachedImage(move(content_hash), move(encoded_data))));
+
+    // NOTE: Decoders keep referring to the data they were created with, so they have to be created with the data the
+    //       image owns. Small buffers keep their data inline, so the data would move along with the ByteBuffer.
+    auto decoder = Gfx::ImageDecoder::try_create_for_raw_bytes(image->m_encoded_data, mime_type);
+    if (!decoder)
+        return Error::from_string_literal("Could not find suitable image decoder plugin for data");
+    if (!decoder->frame_count())
+        return Error::from_string_literal("Could not decode image from encoded data");
+
+    image->m_decoder = decoder.release_nonnull();
+    image->m_is_animated = image->m_decoder->is_animated();
+    image->m_loop_count = image->m_decoder->loop_count();
+    TRY(image->m_frames.try_resize(image->m_decoder->frame_count()));
+    return image;
+}
+
+CachedImage::CachedImage(ByteBuffer content_hash, ByteBuffer encoded_data)
+    : m_content_hash(move(content_hash))
+    , m_encoded_data(move(encoded_data))
+    , m_size_in_bytes(m_encoded_data.size())
+{
+}
+
+ByteBuffer CachedImage::hash_content(ReadonlyBytes encoded_data)
+{
+    auto digest = Crypto::Hash::SHA256::hash(encoded_data.data(), encoded_data.size());
+    return MUST(ByteBuffer::copy(digest.bytes()));
+}
+
+DecodedFrame CachedImage::decode_frame(u32 index)
+{
+    Threading::MutexLocker locker(m_decoder_mutex);
+
+    auto frame_or_error = m_decoder->frame(index);
+    if (frame_or_error.is_error()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Could not decode frame {}: {}", index, frame_or_error.error());
+        return {};
+    }
+
+    // Decoders may hold on to the bitmaps they return, so always make a copy that nothing else references.
+    auto frame = frame_or_error.release_value();
+    auto bitmap_or_error = copy_to_shareable_bitmap(*frame.image);
+    if (bitmap_or_error.is_error()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Could not copy frame {}: {}", index, bitmap_or_error.error());
+        return {};
+    }
+    return { bitmap_or_error.release_value(), static_cast<u32>(frame.duration) };
+}
+
+void CachedImage::set_frame(u32 index, DecodedFrame frame)
+{
+    // Another request may have decoded the same frame in the meantime.
+    if (m_frames[index].has_value())
+        return;
+
+    m_size_in_bytes += frame_size_in_bytes(frame);
+    m_frames[index] = move(frame);
+}
+
+RefPtr<CachedImage> ImageCache::find(ByteBuffer const& content_hash)
+{
+    auto image = m_images.get(content_hash);
+    if (!image.has_value())
+        return nullptr;
+
+    image.value()->set_last_use(++m_use_counter);
+    return image.value();
+}
+
+NonnullRefPtr<CachedImage> ImageCache::add(NonnullRefPtr<CachedImage> image)
+{
+    if (auto existing_image = find(image->content_hash()))
+        return existing_image.release_nonnull();
+
+    image->set_last_use(++m_use_counter);
+    m_size_in_bytes += image->size_in_bytes();
+    m_images.set(image->content_hash(), image);
+    evict_images_over_budget(image);
+    return image;
+}
+
+void ImageCache::set_frame(CachedImage& image, u32 index, DecodedFrame frame)
+{
+    auto previous_size = image.size_in_bytes();
+    image.set_frame(index, move(frame));
+
+    // Evicted images may still be in use by clients, but no longer count against the budget.
+    auto cached_image = m_images.get(image.content_hash());
+    if (!cached_image.has_value() || cached_image.value() != &image)
+        return;
+
+    m_size_in_bytes += image.size_in_bytes() - previous_size;
+    evict_images_over_budget(image);
+}
+
+void ImageCache::evict_images_over_budget(CachedImage const& image_to_keep)
+{
+    while (m_size_in_bytes > m_memory_budget && m_images.size() > 1) {
+        CachedImage const* least_recently_used_image = nullptr;
+        for (auto const& it : m_images) {
+            if (it.value.ptr() == &image_to_keep)
+                continue;
+            if (!least_recently_used_image || it.value->last_use() < least_recently_used_image->last_use())
+                least_recently_used_image = it.value;
+        }
+
+        dbgln_if(IMAGE_DECODER_DEBUG, "Evicting {} byte image from cache", least_recently_used_image->size_in_bytes());
+        m_size_in_bytes -= least_recently_used_image->size_in_bytes();
+        auto content_hash = least_recently_used_image->content_hash();
+        m_images.remove(content_hash);
+    }
+}
+
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
+#include <AK/DeprecatedString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
+#include <LibGfx/ShareableBitmap.h>
+#include <LibThreading/Mutex.h>
+
+namespace ImageDecoder {
+
+struct DecodedFrame {
+    // Invalid if the frame could not be decoded.
+    Gfx::ShareableBitmap bitmap;
+    u32 duration { 0 };
+};
+
+// Copies the bitmap into a new anonymous buffer, so the copy isn't shared with anyone.
+ErrorOr<Gfx::ShareableBitmap> copy_to_shareable_bitmap(Gfx::Bitmap const&);
+
+// An encoded image together with its decoder, so that frames can be decoded when they are first needed.
+// decode_frame() may be called from any thread, everything else is only used on the main thread.
+class CachedImage : public AtomicRefCounted<CachedImage> {
+public:
+    static ErrorOr<NonnullRefPtr<CachedImage>> create(ByteBuffer content_hash, ByteBuffer encoded_data, Optional<DeprecatedString> const& mime_type);
+
+    static ByteBuffer hash_content(ReadonlyBytes encoded_data);
+
+    ByteBuffer const& content_hash() const { return m_content_hash; }
+    bool is_animated() const { return m_is_animated; }
+    u32 loop_count() const { return m_loop_count; }
+    u32 frame_count() const { return m_frames.size(); }
+
+    // The returned bitmap isn't referenced by anything else, so it can be handed over to another thread.
+    DecodedFrame decode_frame(u32 index);
+
+    Optional<DecodedFrame> const& frame(u32 index) const { return m_frames[index]; }
+    void set_frame(u32 index, DecodedFrame);
+
+    // The encoded data plus all frames decoded so far.
+    size_t size_in_bytes() const { return m_size_in_bytes; }
+
+    u64 last_use() const { return m_last_use; }
+    void set_last_use(u64 last_use) { m_last_use = last_use; }
+
+private:
+    CachedImage(ByteBuffer content_hash, ByteBuffer encoded_data);
+
+    ByteBuffer m_content_hash;
+    ByteBuffer m_encoded_data;
+
+    Threading::Mutex m_decoder_mutex;
+    RefPtr<Gfx::ImageDecoder> m_decoder;
+
+    bool m_is_animated { false };
+    u32 m_loop_count { 0 };
+    Vector<Optional<DecodedFrame>> m_frames;
+    size_t m_size_in_bytes { 0 };
+    u64 m_last_use { 0 };
+};
+
+// Decoded images keyed by a hash of their encoded data. Once they take up more memory than the budget
+// allows, the least recently used images are evicted. Only used on the main thread.
+class ImageCache {
+public:
+    static constexpr size_t default_memory_budget = 64 * MiB;
+
+    explicit ImageCache(size_t memory_budget = default_memory_budget)
+        : m_memory_budget(memory_budget)
+    {
+    }
+
+    RefPtr<CachedImage> find(ByteBuffer const& content_hash);
+
+    // Returns the image that was already cached for the same content, if there is one.
+    NonnullRefPtr<CachedImage> add(NonnullRefPtr<CachedImage>);
+
+    void set_frame(CachedImage&, u32 index, DecodedFrame);
+
+private:
+    void evict_images_over_budget(CachedImage const& image_to_keep);
+
+    HashMap<ByteBuffer, NonnullRefPtr<CachedImage>> m_images;
+    size_t m_memory_budget { 0 };
+    size_t m_size_in_bytes { 0 };
+    u64 m_use_counter { 0 };
+};
+
+}
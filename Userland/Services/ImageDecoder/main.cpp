@@ -7,17 +7,18 @@
 #include <ImageDecoder/ConnectionFromClient.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/System.h>
-#include <LibIPC/SingleServer.h>
+#include <LibCore/SystemServerTakeover.h>
 #include <LibMain/Main.h>
 
 ErrorOr<int> serenity_main(Main::Arguments)
 {
     Core::EventLoop event_loop;
-    TRY(Core::System::pledge("stdio recvfd sendfd unix"));
+    TRY(Core::System::pledge("stdio recvfd sendfd unix thread"));
     TRY(Core::System::unveil(nullptr, nullptr));
 
-    auto client = TRY(IPC::take_over_accepted_client_from_system_server<ImageDecoder::ConnectionFromClient>());
+    auto socket = TRY(Core::take_over_socket_from_system_server());
+    auto client = TRY(ImageDecoder::ConnectionFromClient::try_create(move(socket)));
 
-    TRY(Core::System::pledge("stdio recvfd sendfd"));
+    TRY(Core::System::pledge("stdio recvfd sendfd thread"));
     return event_loop.exec();
 }
@@ -5,6 +5,7 @@
  */
 
 #include <AK/LexicalPath.h>
+#include <LibCore/EventLoop.h>
 #include <SQLServer/DatabaseConnection.h>
 #include <SQLServer/SQLStatement.h>
 
@@ -12,6 +13,7 @@ namespace SQLServer {
 
 static HashMap<SQL::ConnectionID, NonnullRefPtr<DatabaseConnection>> s_connections;
 static SQL::ConnectionID s_next_connection_id = 0;
+static HashMap<SQL::Database*, Vector<Function<void(ErrorOr<void>)>>> s_waiting_for_sync;
 
 static ErrorOr<NonnullRefPtr<SQL::Database>> find_or_create_database(StringView database_path, StringView database_name)
 {
@@ -43,6 +45,7 @@ ErrorOr<NonnullRefPtr<DatabaseConnection>> DatabaseConnection::create(StringView
             warnln("Could not open database: {}", result.error().error_string());
             return Error::from_string_view("Could not open database"sv);
         }
+        database->set_group_commit(true);
     }
 
     return adopt_nonnull_ref_or_enomem(new (nothrow) DatabaseConnection(move(database), move(database_name), client_id));
@@ -64,6 +67,22 @@ void DatabaseConnection::disconnect()
     s_connections.remove(connection_id());
 }
 
+void DatabaseConnection::when_synced(Function<void(ErrorOr<void>)> callback)
+{
+    auto& callbacks = s_waiting_for_sync.ensure(m_database.ptr());
+    callbacks.append(move(callback));
+    if (callbacks.size() > 1)
+        return;
+
+    // Statements that are already queued up get to run and commit before the sync happens.
+    Core::deferred_invoke([database = m_database]() {
+        auto callbacks = s_waiting_for_sync.take(database.ptr()).release_value();
+        auto result = database->sync();
+        for (auto& callback : callbacks)
+            callback(result.is_error() ? ErrorOr<void> { Error::copy(result.error()) } : ErrorOr<void> {});
+    });
+}
+
 SQL::ResultOr<SQL::StatementID> DatabaseConnection::prepare_statement(StringView sql)
 {
     dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::prepare_statement(connection_id {}, database '{}', sql '{}'", connection_id(), m_database_name, sql);
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <LibSQL/Database.h>
@@ -27,6 +28,10 @@ public:
     void disconnect();
     SQL::ResultOr<SQL::StatementID> prepare_statement(StringView sql);
 
+    // Calls the callback once everything committed to the database so far has been synced to disk.
+    // All commits made during the same event loop iteration share a single sync (group commit).
+    void when_synced(Function<void(ErrorOr<void>)>);
+
 private:
     DatabaseConnection(NonnullRefPtr<SQL::Database> database, DeprecatedString database_name, int client_id);
 
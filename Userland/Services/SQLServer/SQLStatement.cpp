@@ -79,34 +79,48 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
             return;
         }
 
-        auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
-        if (!client_connection) {
-            warnln("Cannot return statement execution results. Client disconnected");
+        // Don't report success before the changes made by the statement are on disk.
+        if (connection().database()->has_unsynced_commits()) {
+            connection().when_synced([this, strong_this = NonnullRefPtr(*this), execution_id, result = execution_result.release_value()](ErrorOr<void> sync_result) mutable {
+                if (sync_result.is_error())
+                    report_error(sync_result.release_error(), execution_id);
+                else
+                    send_execution_result(execution_id, move(result));
+            });
             return;
         }
 
-        auto result = execution_result.release_value();
-
-        if (should_send_result_rows(result)) {
-            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
-
-            auto result_size = result.size();
-            next(execution_id, move(result), result_size);
-        } else {
-            if (result.command() == SQL::SQLCommand::Insert)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result.size(), 0, 0);
-            else if (result.command() == SQL::SQLCommand::Update)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result.size(), 0);
-            else if (result.command() == SQL::SQLCommand::Delete)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result.size());
-            else
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
-        }
+        send_execution_result(execution_id, execution_result.release_value());
     });
 
     return execution_id;
 }
 
+void SQLStatement::send_execution_result(SQL::ExecutionID execution_id, SQL::ResultSet result)
+{
+    auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
+    if (!client_connection) {
+        warnln("Cannot return statement execution results. Client disconnected");
+        return;
+    }
+
+    if (should_send_result_rows(result)) {
+        client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
+
+        auto result_size = result.size();
+        next(execution_id, move(result), result_size);
+    } else {
+        if (result.command() == SQL::SQLCommand::Insert)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result.size(), 0, 0);
+        else if (result.command() == SQL::SQLCommand::Update)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result.size(), 0);
+        else if (result.command() == SQL::SQLCommand::Delete)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result.size());
+        else
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
+    }
+}
+
 bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
 {
     if (result.is_empty())
@@ -30,6 +30,7 @@ public:
 private:
     SQLStatement(DatabaseConnection&, NonnullRefPtr<SQL::AST::Statement> statement);
 
+    void send_execution_result(SQL::ExecutionID execution_id, SQL::ResultSet result);
     bool should_send_result_rows(SQL::ResultSet const& result) const;
     void next(SQL::ExecutionID execution_id, SQL::ResultSet result, size_t result_size);
     void report_error(SQL::Result, SQL::ExecutionID execution_id);
@@ -11,6 +11,7 @@
 #include <AK/Debug.h>
 #include <AK/JsonObject.h>
 #include <AK/QuickSort.h>
+#include <AK/Time.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/SystemTheme.h>
@@ -358,6 +359,47 @@ void ConnectionFromClient::report_finished_handling_input_event(bool event_was_h
     async_did_finish_handling_input_event(event_was_handled);
 }
 
+// Restyles the whole document a number of times with 1, 2, 4, ... up to the given number of style recalc threads.
+static void run_style_recalc_benchmark(Web::DOM::Document& document, size_t max_thread_count)
+{
+    static constexpr size_t iterations = 10;
+
+    auto previous_thread_count = Web::CSS::StyleComputer::style_recalc_thread_count();
+
+    Vector<size_t> thread_counts;
+    for (size_t thread_count = 1; thread_count < max_thread_count; thread_count *= 2)
+        thread_counts.append(thread_count);
+    thread_counts.append(max_thread_count);
+
+    dbgln("Style recalc benchmark for {}:", document.url());
+    Optional<i64> single_threaded_microseconds;
+    for (auto thread_count : thread_counts) {
+        if (auto result = Web::CSS::StyleComputer::set_style_recalc_thread_count(thread_count); result.is_error()) {
+            dbgln("Unable to start {} style recalc threads: {}", thread_count, result.error());
+            break;
+        }
+
+        i64 min_microseconds = NumericLimits<i64>::max();
+        i64 total_microseconds = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            document.set_needs_full_style_update(true);
+            auto start_time = MonotonicTime::now();
+            document.update_style();
+            auto elapsed = (MonotonicTime::now() - start_time).to_microseconds();
+            min_microseconds = min(min_microseconds, elapsed);
+            total_microseconds += elapsed;
+        }
+
+        if (!single_threaded_microseconds.has_value())
+            single_threaded_microseconds = min_microseconds;
+        auto speedup = static_cast<double>(*single_threaded_microseconds) / static_cast<double>(max<i64>(min_microseconds, 1));
+        dbgln("  {:>2} threads: min {:>8}us, avg {:>8}us, {:.2}x", thread_count, min_microseconds, total_microseconds / static_cast<i64>(iterations), speedup);
+    }
+
+    if (auto result = Web::CSS::StyleComputer::set_style_recalc_thread_count(previous_thread_count); result.is_error())
+        dbgln("Unable to restore {} style recalc threads: {}", previous_thread_count, result.error());
+}
+
 void ConnectionFromClient::debug_request(DeprecatedString const& request, DeprecatedString const& argument)
 {
     if (request == "dump-session-history") {
@@ -428,6 +470,14 @@ void ConnectionFromClient::debug_request(DeprecatedString const& request, Deprec
         return;
     }
 
+    if (request == "dump-style-recalc-statistics") {
+        if (auto* doc = page().top_level_browsing_context().active_document()) {
+            doc->style_computer().dump_statistics();
+            doc->style_computer().reset_statistics();
+        }
+        return;
+    }
+
     if (request == "collect-garbage") {
         Web::Bindings::main_thread_vm().heap().collect_garbage(JS::Heap::CollectionType::CollectGarbage, true);
         return;
@@ -445,6 +495,35 @@ void ConnectionFromClient::debug_request(DeprecatedString const& request, Deprec
         return;
     }
 
+    if (request == "tiled-painting") {
+        // Either "off", or the number of threads to paint tiles with.
+        m_page_host->set_tiled_painting_thread_count(argument.to_uint<size_t>().value_or(0));
+        page().top_level_traversable()->set_needs_display(page().top_level_traversable()->viewport_rect());
+        return;
+    }
+
+    if (request == "incremental-relayout") {
+        bool enabled = argument == "on";
+        Web::DOM::Document::set_incremental_relayout_enabled_by_default(enabled);
+        if (auto* doc = page().top_level_browsing_context().active_document())
+            doc->set_incremental_relayout_enabled(enabled);
+        return;
+    }
+
+    if (request == "parallel-style-recalc") {
+        // Either "off", or the number of threads to match style rules with.
+        if (auto result = Web::CSS::StyleComputer::set_style_recalc_thread_count(argument.to_uint<size_t>().value_or(0)); result.is_error())
+            dbgln("Unable to start style recalc threads: {}", result.error());
+        return;
+    }
+
+    if (request == "style-recalc-benchmark") {
+        // The argument is the largest number of threads to measure with.
+        if (auto* doc = page().top_level_browsing_context().active_document())
+            run_style_recalc_benchmark(*doc, max<size_t>(argument.to_uint<size_t>().value_or(4), 1));
+        return;
+    }
+
     if (request == "clear-cache") {
         Web::ResourceLoader::the().clear_cache();
         return;
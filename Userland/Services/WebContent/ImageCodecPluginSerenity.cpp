@@ -13,7 +13,7 @@ namespace WebContent {
 ImageCodecPluginSerenity::ImageCodecPluginSerenity() = default;
 ImageCodecPluginSerenity::~ImageCodecPluginSerenity() = default;
 
-Optional<Web::Platform::DecodedImage> ImageCodecPluginSerenity::decode_image(ReadonlyBytes bytes)
+ImageDecoderClient::Client& ImageCodecPluginSerenity::client()
 {
     if (!m_client) {
         m_client = ImageDecoderClient::Client::try_create().release_value_but_fixme_should_propagate_errors();
@@ -21,8 +21,12 @@ Optional<Web::Platform::DecodedImage> ImageCodecPluginSerenity::decode_image(Rea
             m_client = nullptr;
         };
     }
+    return *m_client;
+}
 
-    auto result_or_empty = m_client->decode_image(bytes);
+Optional<Web::Platform::DecodedImage> ImageCodecPluginSerenity::decode_image(ReadonlyBytes bytes)
+{
+    auto result_or_empty = client().decode_image(bytes);
     if (!result_or_empty.has_value())
         return {};
     auto result = result_or_empty.release_value();
@@ -37,4 +41,55 @@ Optional<Web::Platform::DecodedImage> ImageCodecPluginSerenity::decode_image(Rea
     return decoded_image;
 }
 
+void ImageCodecPluginSerenity::start_decoding_image(ReadonlyBytes bytes, Function<void(Optional<Web::Platform::DecodedImage>)> on_complete)
+{
+    struct PendingImage : public RefCounted<PendingImage> {
+        i64 image_id { 0 };
+        Web::Platform::DecodedImage decoded_image;
+        u32 remaining_frame_count { 0 };
+        Function<void(Optional<Web::Platform::DecodedImage>)> on_complete;
+    };
+
+    auto pending_image = make_ref_counted<PendingImage>();
+    pending_image->on_complete = move(on_complete);
+
+    auto& client = this->client();
+    ImageDecoderClient::ImageCallbacks callbacks;
+
+    // LibWeb wants all frames up front, so the rest of them are requested as soon as the frame count is known.
+    callbacks.on_decoded = [&client, pending_image](ImageDecoderClient::ImageInfo const& info) {
+        pending_image->decoded_image.is_animated = info.is_animated;
+        pending_image->decoded_image.loop_count = info.loop_count;
+        pending_image->decoded_image.frames.resize(info.frame_count);
+        pending_image->remaining_frame_count = info.frame_count;
+        if (info.frame_count > 1)
+            client.decode_frames(pending_image->image_id, 1, info.frame_count - 1);
+    };
+
+    callbacks.on_frame_decoded = [&client, pending_image](u32 frame_index, ImageDecoderClient::Frame const& frame) {
+        auto& frames = pending_image->decoded_image.frames;
+        if (frame_index >= frames.size() || frames[frame_index].bitmap)
+            return;
+
+        frames[frame_index] = { frame.bitmap, frame.duration };
+        if (--pending_image->remaining_frame_count > 0)
+            return;
+
+        client.release_image(pending_image->image_id);
+        pending_image->on_complete(move(pending_image->decoded_image));
+    };
+
+    callbacks.on_error = [pending_image] {
+        pending_image->on_complete({});
+    };
+
+    auto image_id_or_error = client.start_decoding_image(bytes, {}, move(callbacks));
+    if (image_id_or_error.is_error()) {
+        dbgln("Could not start decoding image: {}", image_id_or_error.error());
+        pending_image->on_complete({});
+        return;
+    }
+    pending_image->image_id = image_id_or_error.release_value();
+}
+
 }
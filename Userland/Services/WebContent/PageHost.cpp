@@ -7,6 +7,7 @@
 
 #include "PageHost.h"
 #include "ConnectionFromClient.h"
+#include <AK/Debug.h>
 #include <LibGfx/ShareableBitmap.h>
 #include <LibGfx/SystemTheme.h>
 #include <LibWeb/CSS/SystemColor.h>
@@ -144,7 +145,29 @@ void PageHost::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& targ
     context.set_has_focus(m_has_focus);
     document->paintable()->paint_all_phases(context);
 
-    recording_painter.execute(target);
+    if (m_tiled_command_executor) {
+        recording_painter.execute_tiled(target, *m_tiled_command_executor);
+        auto const& statistics = m_tiled_command_executor->statistics();
+        dbgln_if(TILED_PAINTING_DEBUG, "Painted {} tiles, retained {}, culled {} commands{}", statistics.painted_tiles, statistics.retained_tiles, statistics.culled_commands, statistics.painted_without_tiles ? " (painted without tiles)"sv : ""sv);
+    } else {
+        recording_painter.execute(target);
+    }
+}
+
+void PageHost::set_tiled_painting_thread_count(size_t thread_count)
+{
+    if (thread_count == 0) {
+        m_tiled_command_executor = nullptr;
+        return;
+    }
+
+    auto executor_or_error = Web::Painting::TiledCommandExecutor::create(thread_count);
+    if (executor_or_error.is_error()) {
+        dbgln("Unable to start {} threads for tiled painting: {}", thread_count, executor_or_error.error());
+        m_tiled_command_executor = nullptr;
+        return;
+    }
+    m_tiled_command_executor = executor_or_error.release_value();
 }
 
 void PageHost::set_viewport_rect(Web::DevicePixelRect const& rect)
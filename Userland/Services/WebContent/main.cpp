@@ -6,12 +6,15 @@
 
 #include "ImageCodecPluginSerenity.h"
 #include <LibAudio/Loader.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/Directory.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibMain/Main.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Loader/ResourceLoader.h>
@@ -24,10 +27,19 @@
 #include <LibWebView/WebSocketClientAdapter.h>
 #include <WebContent/ConnectionFromClient.h>
 
-ErrorOr<int> serenity_main(Main::Arguments)
+ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
+    StringView bytecode_cache_directory;
+
+    Core::ArgsParser args_parser;
+    args_parser.add_option(bytecode_cache_directory, "Cache generated JavaScript bytecode in this directory", "bytecode-cache", 0, "directory");
+    args_parser.parse(arguments);
+
     Core::EventLoop event_loop;
-    TRY(Core::System::pledge("stdio recvfd sendfd accept unix rpath thread proc"));
+    if (bytecode_cache_directory.is_empty())
+        TRY(Core::System::pledge("stdio recvfd sendfd accept unix rpath thread proc"));
+    else
+        TRY(Core::System::pledge("stdio recvfd sendfd accept unix rpath wpath cpath thread proc"));
 
     // This must be first; we can't check if /tmp/webdriver exists once we've unveiled other paths.
     auto webdriver_socket_path = DeprecatedString::formatted("{}/webdriver", TRY(Core::StandardPaths::runtime_directory()));
@@ -41,6 +53,11 @@ ErrorOr<int> serenity_main(Main::Arguments)
     TRY(Core::System::unveil("/tmp/session/%sid/portal/request", "rw"));
     TRY(Core::System::unveil("/tmp/session/%sid/portal/image", "rw"));
     TRY(Core::System::unveil("/tmp/session/%sid/portal/websocket", "rw"));
+    if (!bytecode_cache_directory.is_empty()) {
+        (void)TRY(Core::Directory::create(bytecode_cache_directory, Core::Directory::CreateDirectories::Yes));
+        TRY(Core::System::unveil(bytecode_cache_directory, "rwc"sv));
+        JS::Bytecode::ExecutableCache::set_directory(bytecode_cache_directory);
+    }
     TRY(Core::System::unveil(nullptr, nullptr));
 
     Web::Platform::EventLoopPlugin::install(*new Web::Platform::EventLoopPluginSerenity);
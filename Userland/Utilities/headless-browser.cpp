@@ -15,12 +15,14 @@
 #include <AK/LexicalPath.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/String.h>
 #include <AK/URL.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/Directory.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
 #include <LibCore/ResourceImplementationFile.h>
@@ -60,7 +62,7 @@ public:
         (void)is_layout_test_mode;
 #else
         auto candidate_web_content_paths = TRY(get_paths_for_helper_process("WebContent"sv));
-        view->m_client_state.client = TRY(launch_web_content_process(*view, candidate_web_content_paths, WebView::EnableCallgrindProfiling::No, is_layout_test_mode, Ladybird::UseLagomNetworking::No));
+        view->m_client_state.client = TRY(launch_web_content_process(*view, candidate_web_content_paths, WebView::EnableCallgrindProfiling::No, is_layout_test_mode, Ladybird::UseLagomNetworking::No, {}));
 #endif
 
         view->client().async_update_system_theme(move(theme));
@@ -96,6 +98,11 @@ public:
         return String::from_deprecated_string(client().dump_text());
     }
 
+    void set_tiled_painting_thread_count(size_t thread_count)
+    {
+        debug_request("tiled-painting", thread_count == 0 ? "off" : DeprecatedString::number(thread_count));
+    }
+
     void clear_content_filters()
     {
         client().async_set_content_filters({});
@@ -398,6 +405,121 @@ static ErrorOr<int> run_tests(HeadlessWebContentView& view, StringView test_root
     return 1;
 }
 
+static ErrorOr<bool> load_page_and_wait(HeadlessWebContentView& view, URL const& url, int timeout_in_milliseconds = 15000)
+{
+    Core::EventLoop loop;
+    bool did_timeout = false;
+
+    auto timeout_timer = TRY(Core::Timer::create_single_shot(timeout_in_milliseconds, [&] {
+        did_timeout = true;
+        loop.quit(0);
+    }));
+
+    view.on_load_finish = [&](auto const&) {
+        loop.quit(0);
+    };
+
+    view.load(url);
+    timeout_timer->start();
+    loop.exec();
+
+    view.on_load_finish = {};
+    return !did_timeout;
+}
+
+struct PaintTimes {
+    i64 min_microseconds { NumericLimits<i64>::max() };
+    i64 total_microseconds { 0 };
+    size_t iterations { 0 };
+
+    i64 average_microseconds() const { return iterations ? total_microseconds / static_cast<i64>(iterations) : 0; }
+};
+
+// Returns the given page, or every HTML page in the given directory.
+static ErrorOr<Vector<String>> collect_benchmark_pages(StringView pages_path)
+{
+    Vector<String> pages;
+    if (FileSystem::is_directory(pages_path)) {
+        TRY(Core::Directory::for_each_entry(pages_path, Core::DirIterator::SkipDots, [&](Core::DirectoryEntry const& entry, Core::Directory const&) -> ErrorOr<IterationDecision> {
+            if (entry.type != Core::DirectoryEntry::Type::Directory && entry.name.ends_with(".html"sv))
+                pages.append(TRY(FileSystem::real_path(TRY(String::formatted("{}/{}", pages_path, entry.name)))));
+            return IterationDecision::Continue;
+        }));
+        quick_sort(pages, [](auto const& a, auto const& b) { return a.bytes_as_string_view() < b.bytes_as_string_view(); });
+    } else {
+        pages.append(TRY(FileSystem::real_path(pages_path)));
+    }
+    return pages;
+}
+
+// Paints each page a number of times in full, first serially, then with tiled painting on the given number of threads.
+// Every paint is measured from the client side, so it includes sending the screenshot back.
+static ErrorOr<int> run_paint_benchmark(HeadlessWebContentView& view, StringView pages_path, size_t iterations, size_t thread_count)
+{
+    auto pages = TRY(collect_benchmark_pages(pages_path));
+
+    auto measure = [&](size_t tiled_painting_thread_count) {
+        view.set_tiled_painting_thread_count(tiled_painting_thread_count);
+
+        // The first paint may have to lay out the page and decode images, so it's left out.
+        (void)view.take_screenshot();
+
+        PaintTimes times;
+        for (size_t i = 0; i < iterations; ++i) {
+            auto timer = Core::ElapsedTimer::start_new();
+            (void)view.take_screenshot();
+            auto elapsed = timer.elapsed_time().to_microseconds();
+            times.min_microseconds = min(times.min_microseconds, elapsed);
+            times.total_microseconds += elapsed;
+            ++times.iterations;
+        }
+        return times;
+    };
+
+    outln("{:<40} {:>12} {:>12} {:>12} {:>12}", "Page", "Serial min", "Serial avg", "Tiled min", "Tiled avg");
+
+    i64 serial_total_microseconds = 0;
+    i64 tiled_total_microseconds = 0;
+    for (auto const& page : pages) {
+        if (!TRY(load_page_and_wait(view, URL::create_with_file_scheme(page.to_deprecated_string())))) {
+            warnln("Timed out loading {}", page);
+            continue;
+        }
+
+        auto serial = measure(0);
+        auto tiled = measure(thread_count);
+        view.set_tiled_painting_thread_count(0);
+
+        outln("{:<40} {:>10}us {:>10}us {:>10}us {:>10}us", LexicalPath::basename(page.to_deprecated_string()), serial.min_microseconds, serial.average_microseconds(), tiled.min_microseconds, tiled.average_microseconds());
+
+        serial_total_microseconds += serial.min_microseconds;
+        tiled_total_microseconds += tiled.min_microseconds;
+    }
+
+    outln("Sum of the fastest paints: {}us serially, {}us with {} threads", serial_total_microseconds, tiled_total_microseconds, thread_count);
+    return 0;
+}
+
+// Restyles each page in full with 1, 2, 4, ... up to the given number of threads. WebContent measures the style updates
+// itself and logs the results, since the time it takes to send anything back would drown them out.
+static ErrorOr<int> run_style_benchmark(HeadlessWebContentView& view, StringView pages_path, size_t thread_count)
+{
+    auto pages = TRY(collect_benchmark_pages(pages_path));
+
+    for (auto const& page : pages) {
+        if (!TRY(load_page_and_wait(view, URL::create_with_file_scheme(page.to_deprecated_string())))) {
+            warnln("Timed out loading {}", page);
+            continue;
+        }
+
+        view.debug_request("style-recalc-benchmark", DeprecatedString::number(thread_count));
+
+        // Wait for the benchmark to finish before loading the next page.
+        (void)view.dump_text();
+    }
+    return 0;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     Core::EventLoop event_loop;
@@ -410,6 +532,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool dump_text = false;
     bool is_layout_test_mode = false;
     StringView test_root_path;
+    StringView paint_benchmark_path;
+    size_t paint_benchmark_iterations = 10;
+    size_t paint_benchmark_threads = 4;
+    StringView style_benchmark_path;
+    size_t style_benchmark_threads = 4;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("This utility runs the Browser in headless mode.");
@@ -417,6 +544,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(dump_layout_tree, "Dump layout tree and exit", "dump-layout-tree", 'd');
     args_parser.add_option(dump_text, "Dump text and exit", "dump-text", 'T');
     args_parser.add_option(test_root_path, "Run tests in path", "run-tests", 'R', "test-root-path");
+    args_parser.add_option(paint_benchmark_path, "Measure how long it takes to paint the page, or every page in the directory", "paint-benchmark", 0, "path");
+    args_parser.add_option(paint_benchmark_iterations, "Number of paints to measure per page (default: 10)", "paint-benchmark-iterations", 0, "n");
+    args_parser.add_option(paint_benchmark_threads, "Number of threads to paint tiles with (default: 4)", "paint-benchmark-threads", 0, "n");
+    args_parser.add_option(style_benchmark_path, "Measure how long a full style update of the page, or of every page in the directory, takes with more and more threads", "style-benchmark", 0, "path");
+    args_parser.add_option(style_benchmark_threads, "Largest number of threads to update style with (default: 4)", "style-benchmark-threads", 0, "n");
     args_parser.add_option(resources_folder, "Path of the base resources folder (defaults to /res)", "resources", 'r', "resources-root-path");
     args_parser.add_option(web_driver_ipc_path, "Path to the WebDriver IPC socket", "webdriver-ipc-path", 0, "path");
     args_parser.add_option(is_layout_test_mode, "Enable layout test mode", "layout-test-mode", 0);
@@ -447,6 +579,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return run_tests(*view, test_root_path);
     }
 
+    if (!paint_benchmark_path.is_empty()) {
+        return run_paint_benchmark(*view, paint_benchmark_path, paint_benchmark_iterations, paint_benchmark_threads);
+    }
+
+    if (!style_benchmark_path.is_empty()) {
+        return run_style_benchmark(*view, style_benchmark_path, style_benchmark_threads);
+    }
+
     if (dump_layout_tree) {
         view->on_load_finish = [&](auto const&) {
             (void)view->take_screenshot();
@@ -10,11 +10,14 @@
 #include <AK/StringBuilder.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
+#include <LibCore/Directory.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibJS/Console.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
 #include <LibJS/Parser.h>
@@ -564,13 +567,19 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
+    bool disable_bytecode_optimizations = false;
     StringView evaluate_script;
+    StringView bytecode_cache_directory;
     Vector<StringView> script_paths;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_jit_enabled, "Compile hot bytecode to native code", "jit", {});
+    args_parser.add_option(disable_bytecode_optimizations, "Disable bytecode optimizations", "disable-bytecode-optimizations", {});
+    args_parser.add_option(JS::Bytecode::g_dump_bytecode_passes, "Dump the bytecode before and after each optimization pass", "dump-bytecode-passes", {});
+    args_parser.add_option(bytecode_cache_directory, "Cache generated bytecode in this directory", "bytecode-cache", {}, "directory");
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
@@ -585,6 +594,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     bool syntax_highlight = !disable_syntax_highlight;
 
+    JS::Bytecode::g_optimize_bytecode = !disable_bytecode_optimizations;
+
+    if (!bytecode_cache_directory.is_empty()) {
+        (void)TRY(Core::Directory::create(bytecode_cache_directory, Core::Directory::CreateDirectories::Yes));
+        JS::Bytecode::ExecutableCache::set_directory(bytecode_cache_directory);
+    }
+
     AK::set_debug_enabled(!disable_debug_printing);
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
 
@@ -877,6 +893,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         if (!TRY(parse_and_run(realm, builder.string_view(), source_name)))
             return 1;
+
+        if (JS::Bytecode::g_dump_bytecode_passes)
+            JS::Bytecode::optimization_pipeline().dump_statistics();
     }
 
     return 0;
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <AK/Time.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibMain/Main.h>
+#include <LibVideo/Containers/Matroska/MatroskaDemuxer.h>
+#include <LibVideo/VP9/Decoder.h>
+
+struct DecodeStatistics {
+    size_t frame_count { 0 };
+    Duration decode_time;
+    Duration video_time;
+};
+
+static Video::DecoderErrorOr<DecodeStatistics> decode_video(StringView path, size_t maximum_frame_count)
+{
+    auto demuxer = TRY(Video::Matroska::MatroskaDemuxer::from_file(path));
+    auto video_tracks = TRY(demuxer->get_tracks_for_type(Video::TrackType::Video));
+    if (video_tracks.is_empty())
+        return Video::DecoderError::with_description(Video::DecoderErrorCategory::Invalid, "No video track is present"sv);
+    auto track = video_tracks[0];
+
+    Video::VP9::Decoder decoder;
+    DecodeStatistics statistics;
+
+    while (statistics.frame_count < maximum_frame_count) {
+        auto sample_or_error = demuxer->get_next_video_sample_for_track(track);
+        if (sample_or_error.is_error()) {
+            if (sample_or_error.error().category() == Video::DecoderErrorCategory::EndOfStream)
+                break;
+            return sample_or_error.release_error();
+        }
+        auto sample = sample_or_error.release_value();
+
+        // Only the decoder is timed, demuxing and color conversion are not part of the measurement.
+        auto sample_timer = Core::ElapsedTimer::start_new();
+        TRY(decoder.receive_sample(sample->data()));
+        while (true) {
+            auto frame_or_error = decoder.get_decoded_frame();
+            if (frame_or_error.is_error()) {
+                if (frame_or_error.error().category() == Video::DecoderErrorCategory::NeedsMoreInput)
+                    break;
+                return frame_or_error.release_error();
+            }
+            statistics.frame_count++;
+        }
+        statistics.decode_time += sample_timer.elapsed_time();
+        statistics.video_time = sample->timestamp();
+    }
+
+    return statistics;
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    Vector<StringView> paths;
+    int frame_count = -1;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Benchmark video decoding");
+    args_parser.add_positional_argument(paths, "Paths to video files", "paths");
+    args_parser.add_option(frame_count, "How many frames to decode at maximum from each file", "frame-count", 'f', "frames");
+    args_parser.parse(arguments);
+
+    for (auto path : paths)
+        TRY(Core::System::unveil(TRY(FileSystem::absolute_path(path)), "r"sv));
+    TRY(Core::System::unveil(nullptr, nullptr));
+    TRY(Core::System::pledge("stdio rpath thread"));
+
+    auto maximum_frame_count = frame_count > 0 ? static_cast<size_t>(frame_count) : NumericLimits<size_t>::max();
+    bool had_error = false;
+
+    for (auto path : paths) {
+        auto statistics_or_error = decode_video(path, maximum_frame_count);
+        if (statistics_or_error.is_error()) {
+            warnln("{}: Failed to decode video: {}", path, statistics_or_error.error().description());
+            had_error = true;
+            continue;
+        }
+        auto statistics = statistics_or_error.release_value();
+
+        auto decode_seconds = static_cast<double>(statistics.decode_time.to_microseconds()) / 1'000'000;
+        auto frames_per_second = decode_seconds > 0 ? statistics.frame_count / decode_seconds : 0;
+        out("{}: {} frames in {} ms, {:.1} fps", path, statistics.frame_count, statistics.decode_time.to_milliseconds(), frames_per_second);
+
+        // The timestamp of the last frame is close enough to the length of the decoded video for this purpose.
+        if (decode_seconds > 0 && statistics.video_time > Duration::zero()) {
+            auto video_seconds = static_cast<double>(statistics.video_time.to_microseconds()) / 1'000'000;
+            out(", {:.1}% realtime speed", video_seconds / decode_seconds * 100);
+        }
+        outln();
+    }
+
+    return had_error ? 1 : 0;
+}